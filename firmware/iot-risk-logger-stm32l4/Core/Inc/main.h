@@ -36,6 +36,8 @@ extern "C" {
 #include "SEGGER_RTT.h"
 
 #include "actor.h"
+#include "actor_timer.h"
+#include "trace_log.h"
 #include "event_manager.h"
 #include "power_mode_manager.h"
 #include "gpio_ext_interrupts.h"
@@ -44,6 +46,7 @@ extern "C" {
 #include "temperature_humidity_sensor.h"
 #include "light_sensor.h"
 #include "imu.h"
+#include "acquisition.h"
 #include "cron.h"
 #include "info_led.h"
 #include "sensors_bus.h"
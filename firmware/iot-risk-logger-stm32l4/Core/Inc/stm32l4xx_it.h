@@ -59,7 +59,8 @@ void EXTI9_5_IRQHandler(void);
 void TIM6_IRQHandler(void);
 void USB_IRQHandler(void);
 /* USER CODE BEGIN EFP */
-
+void I2C1_EV_IRQHandler(void);
+void I2C1_ER_IRQHandler(void);
 /* USER CODE END EFP */
 
 #ifdef __cplusplus
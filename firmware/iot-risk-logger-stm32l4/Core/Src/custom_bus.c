@@ -581,7 +581,11 @@ static void I2C1_MspInit(I2C_HandleTypeDef* i2cHandle)
     /* Peripheral clock enable */
     __HAL_RCC_I2C1_CLK_ENABLE();
   /* USER CODE BEGIN I2C1_MspInit 1 */
-
+    /* I2C1 interrupts, the sensors bus transactions are interrupt driven */
+    HAL_NVIC_SetPriority(I2C1_EV_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(I2C1_EV_IRQn);
+    HAL_NVIC_SetPriority(I2C1_ER_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(I2C1_ER_IRQn);
   /* USER CODE END I2C1_MspInit 1 */
 }
 
@@ -602,7 +606,8 @@ static void I2C1_MspDeInit(I2C_HandleTypeDef* i2cHandle)
     HAL_GPIO_DeInit(BUS_I2C1_SDA_GPIO_PORT, BUS_I2C1_SDA_GPIO_PIN);
 
   /* USER CODE BEGIN I2C1_MspDeInit 1 */
-
+    HAL_NVIC_DisableIRQ(I2C1_EV_IRQn);
+    HAL_NVIC_DisableIRQ(I2C1_ER_IRQn);
   /* USER CODE END I2C1_MspDeInit 1 */
 }
 
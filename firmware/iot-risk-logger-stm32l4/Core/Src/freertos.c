@@ -25,7 +25,8 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
-
+/* not in main.h: the USB stack configuration includes main.h, usb_stream.h includes the USB stack */
+#include "usb_stream.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -45,7 +46,6 @@ typedef StaticTask_t osStaticThreadDef_t;
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN Variables */
-osMutexId_t i2c1MutexHandle;
 /* USER CODE END Variables */
 /* Definitions for defaultTask */
 osThreadId_t defaultTaskHandle;
@@ -77,7 +77,6 @@ void MX_FREERTOS_Init(void) {
 
   /* USER CODE BEGIN RTOS_MUTEX */
   /* add mutexes, ... */
-  i2c1MutexHandle = osMutexNew(&(osMutexAttr_t){ .name = "i2cMutex" });
   /* USER CODE END RTOS_MUTEX */
 
   /* USER CODE BEGIN RTOS_SEMAPHORES */
@@ -86,6 +85,7 @@ void MX_FREERTOS_Init(void) {
 
   /* USER CODE BEGIN RTOS_TIMERS */
   /* start timers, add new ones, ... */
+  ACTOR_TIMER_Init(); // single kernel timer for all actors timeouts, should be created before actors
   /* USER CODE END RTOS_TIMERS */
 
   /* USER CODE BEGIN RTOS_QUEUES */
@@ -113,8 +113,10 @@ void MX_FREERTOS_Init(void) {
   ACTORS_LOOKUP_SystemRegistry[TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID]  = TH_SENS_TaskInit();
   ACTORS_LOOKUP_SystemRegistry[LIGHT_SENSOR_ACTOR_ID]                 = LIGHT_SENS_TaskInit();
   ACTORS_LOOKUP_SystemRegistry[IMU_ACTOR_ID]                          = IMU_TaskInit();
+  ACTORS_LOOKUP_SystemRegistry[ACQUISITION_ACTOR_ID]                  = ACQUISITION_TaskInit();
   ACTORS_LOOKUP_SystemRegistry[MEMORY_ACTOR_ID]                       = MEMORY_TaskInit();
   ACTORS_LOOKUP_SystemRegistry[NFC_ACTOR_ID]                          = NFC_TaskInit();
+  ACTORS_LOOKUP_SystemRegistry[USB_STREAM_ACTOR_ID]                   = USB_STREAM_TaskInit();
   ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]                   = EV_MANAGER_ActorInit(defaultTaskHandle); // should be initialized last
 
   /* USER CODE END RTOS_THREADS */
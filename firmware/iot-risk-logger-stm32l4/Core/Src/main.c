@@ -102,6 +102,7 @@ int main(void)
 
 //  RETARGET_Init(); // init stdio, debug
   SEGGER_RTT_Init();
+  TRACE_LOG_Init();
   INFO_LED_Init();
 
   #ifdef DEBUG
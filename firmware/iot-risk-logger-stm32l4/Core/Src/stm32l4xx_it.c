@@ -60,7 +60,7 @@ extern RTC_HandleTypeDef hrtc;
 extern TIM_HandleTypeDef htim6;
 
 /* USER CODE BEGIN EV */
-
+extern I2C_HandleTypeDef hi2c1;
 /* USER CODE END EV */
 
 /******************************************************************************/
@@ -249,5 +249,23 @@ void USB_IRQHandler(void)
 }
 
 /* USER CODE BEGIN 1 */
+/**
+  * @brief This function handles I2C1 event interrupt.
+  */
+void I2C1_EV_IRQHandler(void)
+{
+  SEGGER_SYSVIEW_RecordEnterISR();
+  HAL_I2C_EV_IRQHandler(&hi2c1);
+  SEGGER_SYSVIEW_RecordExitISR();
+}
 
+/**
+  * @brief This function handles I2C1 error interrupt.
+  */
+void I2C1_ER_IRQHandler(void)
+{
+  SEGGER_SYSVIEW_RecordEnterISR();
+  HAL_I2C_ER_IRQHandler(&hi2c1);
+  SEGGER_SYSVIEW_RecordExitISR();
+}
 /* USER CODE END 1 */
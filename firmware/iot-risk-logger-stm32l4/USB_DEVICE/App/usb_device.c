@@ -27,6 +27,7 @@
 #include "usbd_storage_if.h"
 
 /* USER CODE BEGIN Includes */
+#include "usbd_msc_cdc.h"
 
 /* USER CODE END Includes */
 
@@ -86,6 +87,28 @@ void MX_USB_DEVICE_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN USB_DEVICE_Init_PostTreatment */
+  /* The MSC + CDC composite replaces the generated MSC class, the device is restarted with it before the host
+   * can enumerate the MSC one, see app/middlewares/usb_msc_cdc */
+  if (USBD_DeInit(&hUsbDeviceFS) != USBD_OK)
+  {
+    Error_Handler();
+  }
+  if (USBD_Init(&hUsbDeviceFS, USBD_MSC_CDC_Descriptors(&FS_Desc), DEVICE_FS) != USBD_OK)
+  {
+    Error_Handler();
+  }
+  if (USBD_RegisterClass(&hUsbDeviceFS, &USBD_MSC_CDC) != USBD_OK)
+  {
+    Error_Handler();
+  }
+  if (USBD_MSC_RegisterStorage(&hUsbDeviceFS, &USBD_Storage_Interface_fops_FS) != USBD_OK)
+  {
+    Error_Handler();
+  }
+  if (USBD_Start(&hUsbDeviceFS) != USBD_OK)
+  {
+    Error_Handler();
+  }
 
   /* USER CODE END USB_DEVICE_Init_PostTreatment */
 }
@@ -34,4 +34,6 @@ actor_t* ACTORS_LOOKUP_SystemRegistry[MAX_ACTORS] = {
   [LIGHT_SENSOR_ACTOR_ID] = NULL,
   [MEMORY_ACTOR_ID] = NULL,
   [INFO_LED_ACTOR_ID] = NULL,
+  [ACQUISITION_ACTOR_ID] = NULL,
+  [USB_STREAM_ACTOR_ID] = NULL,
 };
@@ -30,6 +30,8 @@ typedef enum {
   LIGHT_SENSOR_ACTOR_ID,
   MEMORY_ACTOR_ID,
   INFO_LED_ACTOR_ID,
+  ACQUISITION_ACTOR_ID,
+  USB_STREAM_ACTOR_ID,
   MAX_ACTORS
 } ACTOR_ID;
 
@@ -32,7 +32,11 @@ typedef enum {
   GLOBAL_CMD_STOP_LOGGING     = 0xC1, ///< Stop logging measurements
   GLOBAL_CMD_WRITE_SETTINGS   = 0xC2, ///< Write settings to the device
   GLOBAL_CMD_READ_SETTINGS    = 0xC3, ///< Read settings from the device
-  GLOBAL_CMD_READ_LOG_CHUNK   = 0xC4, ///< Read log chunk from the device
+  GLOBAL_CMD_READ_LOG_CHUNK   = 0xC4, ///< Stream the log entries range in mailbox chunks, payload is NFC_LogExportRange_t; sent by NFC and USB stream directly to MEMORY the payload pointer is the MEMORY_LogReadRequest_t
+  GLOBAL_CMD_EXPORT_LOG       = 0xC5, ///< Stream the log entries range over the NFC Fast Transfer Mode or the USB CDC, payload is NFC_LogExportRange_t
+  GLOBAL_CMD_QUERY_LOG        = 0xC6, ///< Evaluate the aggregates of a channel over a time range, payload is LOG_QUERY_Request_t; sent by NFC directly to MEMORY the payload pointer is the LOG_QUERY_t
+  GLOBAL_CMD_SET_WAKE_UP_PERIOD = 0xC7, ///< Pin the wake up period, payload is uint16_t seconds, little-endian
+  GLOBAL_CMD_SET_WAKE_UP_PERIOD_BOUNDS = 0xC8, ///< Set the adaptive wake up period bounds, payload is NFC_WakeUpPeriodBounds_t
   GLOBAL_CMD_MAX,
   /**
    * @brief Global Events in the system
@@ -41,51 +45,87 @@ typedef enum {
   GLOBAL_CMD_INITIALIZE,
   GLOBAL_INITIALIZE_SUCCESS,
   GLOBAL_WAKE_N_READ, ///> RTC wakes up event, mostly leads to the sensor measurements read
-  GLOBAL_TEMPERATURE_HUMIDITY_MEASUREMENTS_READY, ///< Temperature and humidity measurements are ready
-  GLOBAL_LIGHT_MEASUREMENTS_READY, ///< Light measurements are ready
-  GLOBAL_IMU_MEASUREMENTS_READY, ///< IMU measurements are ready
+  GLOBAL_MEASUREMENTS_FRAME_READY, ///< All sensors are read in one batch, payload pointer is the ACQUISITION_Frame_t
   GLOBAL_MEASUREMENTS_WRITE_SUCCESS, ///< Sensors measurements are successfully written to the NOR memory
-  GLOBAL_LOG_CHUNK_READ_SUCCESS, ///< Log chunk is successfully read from the NOR memory
-  GLOBAL_SETTINGS_WRITE_SUCCESS, ///< Settings are successfully written to the NOR memory
-  GLOBAL_SETTINGS_READ_SUCCESS, ///< Settings are successfully read from the NOR memory
+  GLOBAL_LOG_CHUNK_READ_SUCCESS, ///< MEMORY served the MEMORY_LogReadRequest_t, sent directly to the requester, payload value is the IO status
+  GLOBAL_LOG_QUERY_SUCCESS, ///< MEMORY evaluated the LOG_QUERY_t, sent directly to NFC, payload value is the IO status
+  GLOBAL_SETTINGS_WRITE_SUCCESS, ///< Settings write to the NOR memory is done, payload value is the IO status
+  GLOBAL_SETTINGS_READ_SUCCESS, ///< Settings read from the NOR memory is done, payload value is the IO status
   GLOBAL_CMD_INFO_LED_ON,
   GLOBAL_CMD_INFO_LED_OFF,
   GLOBAL_CMD_SET_TIME_DATE, ///< Set time and date from int32 UNIX timestamp
-  GLOBAL_CMD_SET_WAKE_UP_PERIOD, ///< Set wake up period in seconds
+  GLOBAL_WAKE_UP_PERIOD_CHANGED, ///< Cron changed the RTC wake up period, payload pointer is the CRON_PeriodDecision_t slot of the cron ring
   GLOBAL_CMD_START_CONTINUOUS_SENSING, ///< Start continuous sensors measurement
   GLOBAL_CMD_TURN_OFF, ///< Turn off to power saving mode
   GLOBAL_CMD_NFC_MAILBOX_WRITE, ///< NFC mailbox write data event
-  GLOBAL_ERROR,
+  GLOBAL_ERROR, ///< Actor failed to handle the message, payload value is the actor ID
+  GLOBAL_CMD_RESTART, ///< Restart the actor from the ERROR state, sent by the supervisor directly to the failed actor
   GLOBAL_EVENTS_MAX,
   /**
    * @brief Local Events for the system modules
    */
+  // EVENT MANAGER
+  EV_MANAGER_RESTART_TIMEOUT, ///< Supervisor backoff elapsed, the failed actor should be restarted
   // INFO_LED
   INFO_LED_FLASH,
   // NFC
   NFC_GPO_INTERRUPT,
+  NFC_TAG_STATUS_POLL, ///< Actor timer timeout, the GPO pulses are debounced or the status read was refused by the busy tag
+  NFC_FIELD_OFF, ///< Tag status has the RF field off, the phone session is over
   NEW_MAILBOX_RF_CMD,
   NFC_CRC_ERROR,
+  NFC_CMD_ACCEPTED, ///< Pipelined command is dispatched, the next one can be received
+  NFC_CMD_REJECTED, ///< Command code is unknown, answered with NACK
+  NFC_CMD_BUSY, ///< In-flight commands table is full, answered with NACK BUSY
+  NFC_MAILBOX_RESPONSE_READ, ///< Phone read the response, the next ready one can be written
+  NFC_LOG_EXPORT_POLL, ///< Actor timer tick, runs the Fast Transfer Mode state machine
+  NFC_LOG_CHUNKS_RETRY, ///< Actor timer timeout, the chunk write was refused by the busy tag
+  NFC_LOG_CHUNKS_TIMEOUT, ///< Actor timer timeout, the phone didn't read the chunk
+  NFC_LOG_CHUNKS_INTERRUPTED, ///< Phone wrote a command instead of reading the next chunk
+  NFC_LOG_TRANSFER_REJECTED, ///< Requested range or query is empty or malformed, answered with NACK
+  NFC_LOG_TRANSFER_DONE, ///< Log export or chunks stream is over, payload value is the status
+  NFC_LOG_EXPORT_FIELD_LOST, ///< Actor timer timeout, the RF field stayed off during the log export
   // TEMPERATURE_HUMIDITY_SENSOR
   TH_SENS_START_SINGLE_SHOT_READ,
   TH_SENS_TURN_OFF,
+  TH_SENS_TIMEOUT, ///< Actor timer timeout, e.g. sensor reset or command execution time elapsed
   TH_SENS_ERROR,
   // LIGHT_SENSOR
   LIGHT_SENS_SINGLE_SHOT_READ,
   LIGHT_SENS_MEASURE_CONTINUOUSLY,
   LIGHT_SENS_SET_LIMIT,
+  LIGHT_SENS_CONVERSION_TIMEOUT, ///< Single-shot end-of-conversion interrupt did not arrive in time
   LIGHT_SENS_TURN_OFF,
-  LIGHT_SENS_LIMIT_INT,
+  LIGHT_SENS_INT, ///< INT pin asserted: end of conversion in single-shot, limit crossed while measuring
   LIGHT_SENS_RECOVER,
   LIGHT_SENS_ERROR,
   // IMU Accelerometer
-  IMU_FIFO_WTM, ///< FIFO full watermark interrupt event
-  IMU_FREE_FALL_DETECTED, ///< Free-fall event detected by the IMU
+  IMU_FIFO_WTM, ///< FIFO threshold interrupt event (INT2)
+  IMU_SHOCK_DETECTED, ///< Wake-up (shock) or free-fall interrupt event (INT1)
+  IMU_WINDOW_FEATURES_REQUEST, ///< Extract the vibration features of the latest ring samples, payload pointer is the VIBRATION_Features_t
+  IMU_CAPTURE_COMPLETE, ///< Post-trigger samples are in the ring
+  IMU_SHOCK_CAPTURE_STORED, ///< MEMORY stored the capture and released the ring, payload value is the status
+  // ACQUISITION
+  ACQUISITION_FIFO_LEVEL_READ, ///< LIS2DW12 FIFO level is read, the FIFO burst read can be queued
+  ACQUISITION_TH_READ_DONE, ///< SHT3x measurements are read, payload value is the bus status
+  ACQUISITION_LUX_READ_DONE, ///< OPT3001 result is read, payload value is the bus status
+  ACQUISITION_FIFO_READ_DONE, ///< LIS2DW12 FIFO is drained, payload value is the bus status
+  ACQUISITION_BATCH_COMPLETE, ///< All batch transactions are completed
+  ACQUISITION_BATCH_TIMEOUT, ///< Batch transactions didn't complete in time
+  ACQUISITION_WINDOW_FEATURES_READY, ///< IMU extracted the ring window features, payload value is the number of samples
   // MEMORY
-  MEMORY_MEASUREMENTS_WRITE,
+  MEMORY_EVENT_RECORDS_SPILL, ///< Event recorder page is ready to be written to the reserved NOR Flash area
+  MEMORY_MEASUREMENTS_WRITE, ///< Frame passed the logging policy, payload pointer is the ACQUISITION_Frame_t, payload size is the number of frames suppressed before it
+  MEMORY_SHOCK_CAPTURE_WRITE, ///< Shock capture is frozen, payload pointer is the IMU_ShockCapture_t
   // USB
   USB_CONNECTED,
   USB_DISCONNECTED,
+  USB_STREAM_PORT_OPENED, ///< Host set the CDC DTR, e.g. opened the serial port
+  USB_STREAM_PORT_CLOSED, ///< Host cleared the DTR or the USB is disconnected, the export is aborted
+  USB_STREAM_CMD_RECEIVED, ///< Command frame is received, payload value is its length
+  USB_STREAM_TX_DONE, ///< IN transfer of the export is acknowledged by the host, its block buffer is free
+  USB_STREAM_EXPORT_REJECTED, ///< Requested range is empty or malformed, answered with NACK
+  USB_STREAM_EXPORT_DONE, ///< Log export data is sent, payload value is the status
   //
   MAX_EVENTS
 } event_t;
@@ -17,8 +17,10 @@ extern "C" {
 #endif
 
 #include <stdio.h>
+#include <inttypes.h>
 
 #include "cmsis_os2.h"
+#include "trace_log.h"
 #include "../../config/events_list/events_list.h"
 #include "../../config/actors_lookup/actors_lookup.h"
 
@@ -47,7 +49,7 @@ extern "C" {
 #define TO_STATE(actorPointer, stateEnum)                                     \
   do {                                                                        \
     (actorPointer)->state = (stateEnum);                                      \
-    fprintf(stdout, "%lu: %s\n", (actorPointer)->super.actorId, #stateEnum);  \
+    TRACE_LOG("%" PRIu32 ": " #stateEnum "\n", (actorPointer)->super.actorId); \
   } while (0);
 
 /**
@@ -0,0 +1,205 @@
+/*!
+ * @file actor_timer.c
+ * @brief implementation of the actor timers service
+ *
+ * The list is modified from the actors threads and from the timer service (daemon) task,
+ * it's guarded by the scheduler lock, no timer API is called from ISRs.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#include "actor_timer.h"
+
+static void handleKernelTimerExpired(void *argument);
+static void insertTimer(ACTOR_Timer_t *timer);
+static void removeTimer(ACTOR_Timer_t *timer);
+static osStatus_t rearmKernelTimer(void);
+static osStatus_t startTimer(ACTOR_Timer_t *timer, ACTOR_ID actorId, event_t event, uint32_t timeoutTicks, uint32_t periodTicks);
+
+extern actor_t* ACTORS_LOOKUP_SystemRegistry[MAX_ACTORS];
+
+static ACTOR_Timer_t *armedTimersHead = NULL; ///< armed timers sorted by the deadline, nearest first
+static osTimerId_t kernelTimer = NULL;
+
+static StaticTimer_t actorKernelTimerControlBlock;
+static const osTimerAttr_t actorKernelTimerDescription = {
+        .name = "actorTimer",
+        .cb_mem = &actorKernelTimerControlBlock,
+        .cb_size = sizeof(actorKernelTimerControlBlock),
+};
+
+/**
+ * @brief Creates the kernel timer, should be called before any actor starts its timers
+ */
+osStatus_t ACTOR_TIMER_Init(void) {
+  kernelTimer = osTimerNew(handleKernelTimerExpired, osTimerOnce, NULL, &actorKernelTimerDescription);
+
+  return (kernelTimer == NULL) ? osError : osOK;
+}
+
+/**
+ * @brief Posts the event to the actor once after the timeout, restarts the timer if it's already armed
+ */
+osStatus_t ACTOR_TIMER_StartOneShot(ACTOR_Timer_t *timer, ACTOR_ID actorId, event_t event, uint32_t timeoutMs) {
+  return startTimer(timer, actorId, event, ACTOR_TIMER_MS_TO_TICKS(timeoutMs), 0);
+}
+
+/**
+ * @brief Posts the event to the actor every period, restarts the timer if it's already armed
+ */
+osStatus_t ACTOR_TIMER_StartPeriodic(ACTOR_Timer_t *timer, ACTOR_ID actorId, event_t event, uint32_t periodMs) {
+  uint32_t periodTicks = ACTOR_TIMER_MS_TO_TICKS(periodMs);
+
+  return startTimer(timer, actorId, event, periodTicks, periodTicks);
+}
+
+osStatus_t ACTOR_TIMER_Stop(ACTOR_Timer_t *timer) {
+  if (timer == NULL) return osErrorParameter;
+
+  osStatus_t status = osOK;
+  int32_t lock = osKernelLock();
+
+  timer->staleExpiries = timer->queuedExpiries;
+
+  if (timer->isArmed) {
+    bool isNearest = (timer == armedTimersHead);
+
+    removeTimer(timer);
+
+    if (isNearest) status = rearmKernelTimer();
+  }
+
+  osKernelRestoreLock(lock);
+
+  return status;
+}
+
+bool ACTOR_TIMER_IsArmed(const ACTOR_Timer_t *timer) {
+  return timer->isArmed;
+}
+
+/**
+ * @brief Takes the timer's timeout event out of the accounting, true if it was posted before the last start or stop
+ *
+ * Should be called once for every message of the actor before the dispatch: the expiries are identified by the timer
+ * in the payload, the queue keeps them in order, so the first queued ones are the stale ones.
+ */
+bool ACTOR_TIMER_IsStaleExpiry(ACTOR_Timer_t *timer, const message_t *message) {
+  if (timer == NULL || message->payload.ptr != timer) return false;
+
+  int32_t lock = osKernelLock();
+
+  bool isStale = (timer->staleExpiries > 0);
+
+  if (timer->queuedExpiries > 0) timer->queuedExpiries--;
+  if (isStale) timer->staleExpiries--;
+
+  osKernelRestoreLock(lock);
+
+  return isStale;
+}
+
+static osStatus_t startTimer(ACTOR_Timer_t *timer, ACTOR_ID actorId, event_t event, uint32_t timeoutTicks, uint32_t periodTicks) {
+  if (timer == NULL || kernelTimer == NULL || actorId >= MAX_ACTORS) return osErrorParameter;
+
+  osStatus_t status = osOK;
+  int32_t lock = osKernelLock();
+
+  if (timer->isArmed) removeTimer(timer);
+  timer->staleExpiries = timer->queuedExpiries;
+
+  timer->actorId = actorId;
+  timer->event = event;
+  timer->period = periodTicks;
+  timer->deadline = osKernelGetTickCount() + ((timeoutTicks == 0) ? 1 : timeoutTicks);
+
+  insertTimer(timer);
+
+  if (timer == armedTimersHead) status = rearmKernelTimer();
+
+  osKernelRestoreLock(lock);
+
+  return status;
+}
+
+/**
+ * @brief Kernel timer callback, runs in the timer service task
+ *
+ * Posts timeout events of all expired timers, reloads periodic ones and rearms the kernel timer for the nearest deadline.
+ */
+static void handleKernelTimerExpired(void *argument) {
+  (void) argument;
+
+  int32_t lock = osKernelLock();
+  uint32_t now = osKernelGetTickCount();
+
+  // deadlines are compared as signed difference to survive the tick counter overflow
+  while (armedTimersHead != NULL && (int32_t)(now - armedTimersHead->deadline) >= 0) {
+    ACTOR_Timer_t *expired = armedTimersHead;
+    removeTimer(expired);
+
+    actor_t *actor = ACTORS_LOOKUP_SystemRegistry[expired->actorId];
+    if (actor != NULL && actor->osMessageQueueId != NULL
+        && osMessageQueuePut(actor->osMessageQueueId, &(message_t){expired->event, .payload.ptr = expired}, 0, 0) == osOK) {
+      expired->queuedExpiries++;
+    }
+
+    if (expired->period != 0) {
+      expired->deadline += expired->period;
+      insertTimer(expired);
+    }
+  }
+
+  // no caller to return the status to, the timers stay in the list and are served by the next start or stop
+  if (rearmKernelTimer() != osOK) {
+    TRACE_LOG("actor timer: kernel timer rearm failed\n");
+  }
+
+  osKernelRestoreLock(lock);
+}
+
+static void insertTimer(ACTOR_Timer_t *timer) {
+  ACTOR_Timer_t **link = &armedTimersHead;
+
+  // timers with equal deadlines fire in the arming order
+  while (*link != NULL && (int32_t)((*link)->deadline - timer->deadline) <= 0) {
+    link = &(*link)->next;
+  }
+
+  timer->next = *link;
+  *link = timer;
+  timer->isArmed = true;
+}
+
+static void removeTimer(ACTOR_Timer_t *timer) {
+  ACTOR_Timer_t **link = &armedTimersHead;
+
+  while (*link != NULL && *link != timer) {
+    link = &(*link)->next;
+  }
+
+  if (*link != NULL) *link = timer->next;
+
+  timer->next = NULL;
+  timer->isArmed = false;
+}
+
+/**
+ * @brief Arms the kernel timer for the nearest deadline or stops it if there are no armed timers
+ *
+ * @note called with the scheduler locked, timer commands are sent with zero timeout,
+ * so they fail with the full timer commands queue
+ */
+static osStatus_t rearmKernelTimer(void) {
+  if (armedTimersHead == NULL) {
+    osStatus_t status = osTimerStop(kernelTimer);
+
+    // osErrorResource: the kernel timer isn't running, e.g. it has just expired
+    return (status == osErrorResource) ? osOK : status;
+  }
+
+  int32_t ticksLeft = (int32_t)(armedTimersHead->deadline - osKernelGetTickCount());
+
+  return osTimerStart(kernelTimer, (ticksLeft > 0) ? (uint32_t) ticksLeft : 1U);
+}
@@ -0,0 +1,61 @@
+/*!
+ * @file actor_timer.h
+ * @brief Non-blocking one-shot and periodic timeouts for actors
+ *
+ * Instead of blocking the actor thread with osDelay() inside the FSM action, the action arms a timer and returns.
+ * When the timer expires the timeout event is posted to the actor's queue and handled as any other event,
+ * so the actor stays responsive (e.g. to TURN_OFF) while waiting.
+ *
+ * All armed timers are kept in a single list sorted by the deadline, backed by one FreeRTOS software timer
+ * which is always armed for the nearest deadline: any number of pending timeouts costs one kernel timer.
+ *
+ * @note The timeout event may already be in the actor's queue when the timer is stopped or restarted,
+ * the actor drops such stale expiries with ACTOR_TIMER_IsStaleExpiry() before the FSM dispatch.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#ifndef ACTOR_TIMER_H
+#define ACTOR_TIMER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cmsis_os2.h"
+#include "FreeRTOS.h"
+#include "actor.h"
+
+/**
+ * @brief Actor timer, owned (statically allocated) by the actor
+ */
+typedef struct ACTOR_Timer_t {
+  struct ACTOR_Timer_t *next; ///< Next armed timer in the deadline sorted list
+  ACTOR_ID actorId;           ///< Actor to post the timeout event to
+  event_t event;              ///< Timeout event
+  uint32_t deadline;          ///< Kernel tick the timer expires at
+  uint32_t period;            ///< Reload period in ticks, 0 for one-shot timers
+  uint16_t queuedExpiries;    ///< Timeout events posted to the actor and not yet taken by ACTOR_TIMER_IsStaleExpiry()
+  uint16_t staleExpiries;     ///< Queued ones posted before the last start or stop
+  bool isArmed;
+} ACTOR_Timer_t;
+
+#define ACTOR_TIMER_MS_TO_TICKS(ms) (((ms) * configTICK_RATE_HZ + 999U) / 1000U)
+
+osStatus_t ACTOR_TIMER_Init(void);
+osStatus_t ACTOR_TIMER_StartOneShot(ACTOR_Timer_t *timer, ACTOR_ID actorId, event_t event, uint32_t timeoutMs);
+osStatus_t ACTOR_TIMER_StartPeriodic(ACTOR_Timer_t *timer, ACTOR_ID actorId, event_t event, uint32_t periodMs);
+osStatus_t ACTOR_TIMER_Stop(ACTOR_Timer_t *timer);
+bool ACTOR_TIMER_IsArmed(const ACTOR_Timer_t *timer);
+bool ACTOR_TIMER_IsStaleExpiry(ACTOR_Timer_t *timer, const message_t *message);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ACTOR_TIMER_H
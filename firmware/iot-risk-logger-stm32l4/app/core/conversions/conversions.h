@@ -0,0 +1,159 @@
+/*!
+ * @file conversions.h
+ * @brief Integer conversions of the SHT3x, OPT3001 and LIS2DW12 raw data to the fixed-point units
+ *
+ * Header only, every consumer (drivers, CRON, the logging policy, the tests) converts with the same formulas:
+ * - SHT3x temperature: 0.01°C, `T = -45 + 175 × raw / 65535`, rounded to the nearest
+ * - SHT3x humidity: 0.01%RH, `RH = 100 × raw / 65535`, rounded to the nearest
+ * - OPT3001 illuminance: 0.01lux, `lux = 0.01 × 2^E × M`, exact
+ * - LIS2DW12 acceleration: mg, `a = raw × FS / 32768` of the left-aligned sample, rounded to the nearest
+ *
+ * The division by 65535 is `(n + (n >> 16) + 32768) >> 16`, which is the exact rounded quotient for every
+ * 16 bit raw value (checked exhaustively by the host tests), so there are no branches, tables or 64 bit products.
+ * The batch variants are plain loops the host compiler vectorizes, the acceleration batch converts two samples
+ * per word with __SMUAD/__SMUADX on the Cortex-M4.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#ifndef CONVERSIONS_H
+#define CONVERSIONS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "cmsis_compiler.h"
+#define CONVERT_DSP_ENABLED 1
+#endif
+
+#define CONVERT_SHT3x_TEMPERATURE_SPAN_CENTI  (17500) // 175°C
+#define CONVERT_SHT3x_TEMPERATURE_OFFSET_CENTI (4500) // -45°C
+#define CONVERT_SHT3x_HUMIDITY_SPAN_CENTI     (10000) // 100%RH
+#define CONVERT_SHT3x_RAW_SPAN                (65535)
+#define CONVERT_OPT3001_EXPONENT_SHIFT        (12)
+#define CONVERT_OPT3001_MANTISSA_MASK         (0x0FFF)
+#define CONVERT_LIS2DW12_MG_PER_G             (1000)
+#define CONVERT_LIS2DW12_SHIFT                (15)    // left-aligned sample, full scale is 2^15
+
+/**
+ * @brief Compile-time conversions of the units to the raw values, for the limits and the deadbands
+ * @note Rounded to the nearest, the arguments should be integer constants
+ */
+#define CONVERT_CENTI_CELSIUS_TO_SHT3x_RAW(centiCelsius) \
+  ((uint16_t) ((((int32_t) (centiCelsius) + CONVERT_SHT3x_TEMPERATURE_OFFSET_CENTI) * CONVERT_SHT3x_RAW_SPAN \
+                + CONVERT_SHT3x_TEMPERATURE_SPAN_CENTI / 2) / CONVERT_SHT3x_TEMPERATURE_SPAN_CENTI))
+#define CONVERT_CENTI_CELSIUS_DELTA_TO_SHT3x_RAW(centiCelsius) \
+  ((uint16_t) (((uint32_t) (centiCelsius) * CONVERT_SHT3x_RAW_SPAN + CONVERT_SHT3x_TEMPERATURE_SPAN_CENTI / 2) \
+               / CONVERT_SHT3x_TEMPERATURE_SPAN_CENTI))
+#define CONVERT_CENTI_RH_DELTA_TO_SHT3x_RAW(centiRH) \
+  ((uint16_t) (((uint32_t) (centiRH) * CONVERT_SHT3x_RAW_SPAN + CONVERT_SHT3x_HUMIDITY_SPAN_CENTI / 2) \
+               / CONVERT_SHT3x_HUMIDITY_SPAN_CENTI))
+#define CONVERT_MILLI_G_DELTA_TO_LIS2DW12_RAW(milliG, fullScaleG) \
+  ((uint16_t) ((((uint32_t) (milliG) << CONVERT_LIS2DW12_SHIFT) + (fullScaleG) * CONVERT_LIS2DW12_MG_PER_G / 2) \
+               / ((fullScaleG) * CONVERT_LIS2DW12_MG_PER_G)))
+
+/**
+ * @brief Rounded `numerator / 65535` for the numerators below 2^31
+ */
+static inline uint32_t CONVERT_DivideBySHT3xSpan(uint32_t numerator) {
+  return (numerator + (numerator >> 16) + 32768UL) >> 16;
+}
+
+/**
+ * @brief SHT3x raw temperature to 0.01°C, -4500..13000
+ */
+static inline int16_t CONVERT_SHT3xRawToCentiCelsius(uint16_t rawTemperature) {
+  uint32_t scaled = CONVERT_DivideBySHT3xSpan((uint32_t) rawTemperature * CONVERT_SHT3x_TEMPERATURE_SPAN_CENTI);
+
+  return (int16_t) ((int32_t) scaled - CONVERT_SHT3x_TEMPERATURE_OFFSET_CENTI);
+}
+
+/**
+ * @brief SHT3x raw humidity to 0.01%RH, 0..10000
+ */
+static inline uint16_t CONVERT_SHT3xRawToCentiRH(uint16_t rawHumidity) {
+  return (uint16_t) CONVERT_DivideBySHT3xSpan((uint32_t) rawHumidity * CONVERT_SHT3x_HUMIDITY_SPAN_CENTI);
+}
+
+/**
+ * @brief OPT3001 result register to 0.01lux, below 2^27 (the exponent is the 4 high bits)
+ * @note The same units as OPT3001_RawToCentiLux() returns
+ */
+static inline uint32_t CONVERT_OPT3001RawToCentiLux(uint16_t rawLux) {
+  return (uint32_t) (rawLux & CONVERT_OPT3001_MANTISSA_MASK) << (rawLux >> CONVERT_OPT3001_EXPONENT_SHIFT);
+}
+
+/**
+ * @brief LIS2DW12 left-aligned raw sample to mg
+ * @param[in] fullScaleG 2, 4, 8 or 16
+ */
+static inline int16_t CONVERT_LIS2DW12RawToMilliG(int16_t rawAcceleration, uint8_t fullScaleG) {
+  int32_t scale = (int32_t) fullScaleG * CONVERT_LIS2DW12_MG_PER_G;
+
+  return (int16_t) ((rawAcceleration * scale + (1L << (CONVERT_LIS2DW12_SHIFT - 1))) >> CONVERT_LIS2DW12_SHIFT);
+}
+
+static inline void CONVERT_SHT3xRawToCentiCelsiusBatch(const uint16_t *restrict rawTemperatures,
+                                                       int16_t *restrict centiCelsius, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) {
+    centiCelsius[i] = CONVERT_SHT3xRawToCentiCelsius(rawTemperatures[i]);
+  }
+}
+
+static inline void CONVERT_SHT3xRawToCentiRHBatch(const uint16_t *restrict rawHumidities,
+                                                  uint16_t *restrict centiRH, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) {
+    centiRH[i] = CONVERT_SHT3xRawToCentiRH(rawHumidities[i]);
+  }
+}
+
+static inline void CONVERT_OPT3001RawToCentiLuxBatch(const uint16_t *restrict rawLuxes,
+                                                     uint32_t *restrict centiLux, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) {
+    centiLux[i] = CONVERT_OPT3001RawToCentiLux(rawLuxes[i]);
+  }
+}
+
+/**
+ * @brief Converts the samples, e.g. the interleaved X, Y, Z FIFO window, to mg
+ *
+ * On the Cortex-M4 two samples are loaded with one LDR, the scale sits in the low half of the multiplier word, so
+ * __SMUAD multiplies the low sample and __SMUADX the high one. The results are packed back with __PKHBT and
+ * stored with one STR.
+ */
+static inline void CONVERT_LIS2DW12RawToMilliGBatch(const int16_t *restrict rawAccelerations,
+                                                    int16_t *restrict milliG, uint16_t count, uint8_t fullScaleG) {
+  uint16_t i = 0;
+
+#ifdef CONVERT_DSP_ENABLED
+  const uint32_t scale = (uint32_t) fullScaleG * CONVERT_LIS2DW12_MG_PER_G; // high half is zero
+  const int32_t half = 1L << (CONVERT_LIS2DW12_SHIFT - 1);
+
+  for (; i + 1 < count; i += 2) {
+    uint32_t pair;
+    memcpy(&pair, &rawAccelerations[i], sizeof(pair));
+
+    int32_t low = ((int32_t) __SMUAD(pair, scale) + half) >> CONVERT_LIS2DW12_SHIFT;
+    int32_t high = ((int32_t) __SMUADX(pair, scale) + half) >> CONVERT_LIS2DW12_SHIFT;
+
+    pair = __PKHBT(low, high, 16);
+    memcpy(&milliG[i], &pair, sizeof(pair));
+  }
+#endif
+
+  for (; i < count; i++) {
+    milliG[i] = CONVERT_LIS2DW12RawToMilliG(rawAccelerations[i], fullScaleG);
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //CONVERSIONS_H
@@ -0,0 +1,222 @@
+/*!
+ * @file crc_service.c
+ * @brief implementation of the CRC service
+ *
+ * The STM32 CRC unit takes the polynomial size, the init value and the bit reversal of the input bytes and of the
+ * output, so all the algorithms run on it: only the final XOR of CRC-32 is applied by the software. HAL_CRC_Calculate()
+ * feeds the bytes four per DR write.
+ *
+ * CRC-32 is resumed from the previous result by loading the unit's INIT with the register value it ended with,
+ * which is the bit reversed result before the final XOR.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#include "crc_service.h"
+
+#ifndef UNIT_TEST
+#include "crc.h"
+#include "cmsis_os2.h"
+#endif
+
+const CRC_SERVICE_Config_t CRC_SERVICE_Configs[CRC_SERVICE_ALGORITHMS_COUNT] = {
+  [CRC_SERVICE_CRC8] = {
+    .polynomial = CRC_SERVICE_CRC8_POLYNOMIAL,
+    .init = CRC_SERVICE_CRC8_INIT,
+    .finalXor = 0x00,
+    .width = 8,
+    .isReflected = false,
+  },
+  [CRC_SERVICE_CRC32] = {
+    .polynomial = CRC_SERVICE_CRC32_POLYNOMIAL,
+    .init = CRC_SERVICE_CRC32_INIT,
+    .finalXor = CRC_SERVICE_CRC32_FINAL_XOR,
+    .width = 32,
+    .isReflected = true,
+  },
+  [CRC_SERVICE_CRC32_MPEG2] = {
+    .polynomial = CRC_SERVICE_CRC32_POLYNOMIAL,
+    .init = CRC_SERVICE_CRC32_INIT,
+    .finalXor = 0x00000000,
+    .width = 32,
+    .isReflected = false,
+  },
+};
+
+static uint32_t calculate(CRC_SERVICE_Algorithm_t algorithm, uint32_t init, const uint8_t *data, uint32_t length);
+static uint32_t reflect32(uint32_t value);
+
+/**
+ * @brief CRC-8/NRSC-5 of the data, e.g. SHT3x word or the NFC mailbox frame
+ */
+uint8_t CRC_SERVICE_Crc8(const uint8_t *data, uint32_t length) {
+  return (uint8_t) calculate(CRC_SERVICE_CRC8, CRC_SERVICE_CRC8_INIT, data, length);
+}
+
+/**
+ * @brief CRC-32/ISO-HDLC of the data, equals zlib crc32(0, data, length)
+ */
+uint32_t CRC_SERVICE_Crc32(const uint8_t *data, uint32_t length) {
+  return CRC_SERVICE_Crc32Update(0, data, length);
+}
+
+/**
+ * @brief Continues the CRC-32 with the next part of the data, e.g. the second part of the wrapped ring
+ *
+ * @param[in] crc Result of the previous part, 0 to start
+ * @return CRC-32 of all the parts
+ */
+uint32_t CRC_SERVICE_Crc32Update(uint32_t crc, const uint8_t *data, uint32_t length) {
+  const uint32_t registerValue = reflect32(crc ^ CRC_SERVICE_CRC32_FINAL_XOR);
+
+  return calculate(CRC_SERVICE_CRC32, registerValue, data, length) ^ CRC_SERVICE_CRC32_FINAL_XOR;
+}
+
+/**
+ * @brief Continues the CRC-32/MPEG-2 with the next part of the data
+ * @note Neither reflected nor XORed, the result is the unit's register value and resumes as is
+ *
+ * @param[in] crc Result of the previous part, CRC_SERVICE_CRC32_INIT to start
+ * @return CRC-32/MPEG-2 of all the parts
+ */
+uint32_t CRC_SERVICE_Crc32Mpeg2Update(uint32_t crc, const uint8_t *data, uint32_t length) {
+  return calculate(CRC_SERVICE_CRC32_MPEG2, crc, data, length);
+}
+
+#ifndef UNIT_TEST
+
+static void configureUnit(CRC_SERVICE_Algorithm_t algorithm);
+
+// the first calculation configures the unit whatever MX_CRC_Init() left in it (e.g. the input data format)
+static CRC_SERVICE_Algorithm_t activeAlgorithm = CRC_SERVICE_ALGORITHMS_COUNT;
+
+/**
+ * @param[in] init Value of the unit's register before the first byte, not reflected
+ * @return Unit's result, reflected for the reflected algorithms, without the final XOR
+ */
+static uint32_t calculate(CRC_SERVICE_Algorithm_t algorithm, uint32_t init, const uint8_t *data, uint32_t length) {
+  const int32_t lock = osKernelLock();
+
+  if (algorithm != activeAlgorithm) {
+    configureUnit(algorithm);
+    activeAlgorithm = algorithm;
+  }
+
+  __HAL_CRC_INITIALCRCVALUE_CONFIG(&hcrc, init);
+  uint32_t crc = HAL_CRC_Calculate(&hcrc, (uint32_t *) data, length); // input format is bytes, data isn't read as words
+
+  if (lock >= 0) osKernelRestoreLock(lock);
+
+  return crc;
+}
+
+static void configureUnit(CRC_SERVICE_Algorithm_t algorithm) {
+  const CRC_SERVICE_Config_t *config = &CRC_SERVICE_Configs[algorithm];
+
+  hcrc.Init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_DISABLE;
+  hcrc.Init.GeneratingPolynomial = config->polynomial;
+  hcrc.Init.CRCLength = (config->width == 8) ? CRC_POLYLENGTH_8B : CRC_POLYLENGTH_32B;
+  hcrc.Init.DefaultInitValueUse = DEFAULT_INIT_VALUE_DISABLE;
+  hcrc.Init.InitValue = config->init;
+  hcrc.Init.InputDataInversionMode = config->isReflected ? CRC_INPUTDATA_INVERSION_BYTE : CRC_INPUTDATA_INVERSION_NONE;
+  hcrc.Init.OutputDataInversionMode = config->isReflected ? CRC_OUTPUTDATA_INVERSION_ENABLE : CRC_OUTPUTDATA_INVERSION_DISABLE;
+  hcrc.InputDataFormat = CRC_INPUTDATA_FORMAT_BYTES;
+
+  HAL_CRC_Init(&hcrc); // @warning: status check is omitted, the configs are constant and valid
+}
+
+static uint32_t reflect32(uint32_t value) {
+  return __RBIT(value);
+}
+
+#else
+
+#define CRC_SERVICE_SLICES (4)
+
+static void buildTables(void);
+
+static bool isTablesBuilt = false;
+static uint8_t crc8Table[256];
+static uint32_t crc32Tables[CRC_SERVICE_SLICES][256];
+static uint32_t crc32Mpeg2Table[256];
+
+/**
+ * @brief Software fallback of the unit: byte table CRC-8 and CRC-32/MPEG-2, slice-by-4 CRC-32
+ */
+static uint32_t calculate(CRC_SERVICE_Algorithm_t algorithm, uint32_t init, const uint8_t *data, uint32_t length) {
+  if (!isTablesBuilt) buildTables();
+
+  if (algorithm == CRC_SERVICE_CRC8) {
+    uint8_t crc = (uint8_t) init;
+
+    while (length--) crc = crc8Table[crc ^ *data++];
+
+    return crc;
+  }
+
+  if (algorithm == CRC_SERVICE_CRC32_MPEG2) {
+    uint32_t crc = init;
+
+    while (length--) crc = (crc << 8) ^ crc32Mpeg2Table[(crc >> 24) ^ *data++];
+
+    return crc;
+  }
+
+  // the reflected register is the bit reversed register of the unit
+  uint32_t crc = reflect32(init);
+
+  for (; length >= CRC_SERVICE_SLICES; length -= CRC_SERVICE_SLICES, data += CRC_SERVICE_SLICES) {
+    crc ^= (uint32_t) data[0] | ((uint32_t) data[1] << 8) | ((uint32_t) data[2] << 16) | ((uint32_t) data[3] << 24);
+    crc = crc32Tables[3][crc & 0xFF] ^ crc32Tables[2][(crc >> 8) & 0xFF] ^
+          crc32Tables[1][(crc >> 16) & 0xFF] ^ crc32Tables[0][crc >> 24];
+  }
+
+  while (length--) crc = (crc >> 8) ^ crc32Tables[0][(crc ^ *data++) & 0xFF];
+
+  return crc;
+}
+
+static void buildTables(void) {
+  const uint8_t crc8Polynomial = (uint8_t) CRC_SERVICE_Configs[CRC_SERVICE_CRC8].polynomial;
+  const uint32_t crc32Polynomial = reflect32(CRC_SERVICE_Configs[CRC_SERVICE_CRC32].polynomial);
+  const uint32_t crc32Mpeg2Polynomial = CRC_SERVICE_Configs[CRC_SERVICE_CRC32_MPEG2].polynomial;
+
+  for (uint16_t i = 0; i < 256; i++) {
+    uint8_t crc8 = (uint8_t) i;
+    uint32_t crc32 = i;
+    uint32_t crc32Mpeg2 = (uint32_t) i << 24;
+
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc8 = (crc8 & 0x80) ? (uint8_t) ((crc8 << 1) ^ crc8Polynomial) : (uint8_t) (crc8 << 1);
+      crc32 = (crc32 & 1) ? ((crc32 >> 1) ^ crc32Polynomial) : (crc32 >> 1);
+      crc32Mpeg2 = (crc32Mpeg2 & 0x80000000UL) ? ((crc32Mpeg2 << 1) ^ crc32Mpeg2Polynomial) : (crc32Mpeg2 << 1);
+    }
+
+    crc8Table[i] = crc8;
+    crc32Tables[0][i] = crc32;
+    crc32Mpeg2Table[i] = crc32Mpeg2;
+  }
+
+  for (uint16_t i = 0; i < 256; i++) {
+    for (uint8_t slice = 1; slice < CRC_SERVICE_SLICES; slice++) {
+      const uint32_t previous = crc32Tables[slice - 1][i];
+
+      crc32Tables[slice][i] = (previous >> 8) ^ crc32Tables[0][previous & 0xFF];
+    }
+  }
+
+  isTablesBuilt = true;
+}
+
+static uint32_t reflect32(uint32_t value) {
+  uint32_t reflected = 0;
+
+  for (uint8_t bit = 0; bit < 32; bit++) {
+    reflected = (reflected << 1) | ((value >> bit) & 1);
+  }
+
+  return reflected;
+}
+
+#endif
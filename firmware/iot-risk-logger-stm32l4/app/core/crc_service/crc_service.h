@@ -0,0 +1,68 @@
+/*!
+ * @file crc_service.h
+ * @brief CRC calculation on the STM32 CRC unit, shared by the sensors, the NFC mailbox and the NOR Flash records
+ *
+ * Algorithms:
+ * - CRC-8/NRSC-5 (polynomial 0x31, init 0xFF, no reflection): SHT3x words and the NFC mailbox frames
+ * - CRC-32/ISO-HDLC (polynomial 0x04C11DB7, reflected, init and final XOR 0xFFFFFFFF, as zlib crc32()):
+ *   NOR Flash blocks, so the host tools check them with any standard CRC-32 implementation
+ * - CRC-32/MPEG-2 (polynomial 0x04C11DB7, init 0xFFFFFFFF, no reflection, no final XOR): the unit's reset
+ *   configuration, used by the ST25 Fast Transfer Mode segments
+ *
+ * The CRC unit is reconfigured (polynomial size, init value, reflection) only when the algorithm changes.
+ * Calculations are serialized with the scheduler lock, so the unit is never shared mid-calculation
+ * between the tasks; a 4KB block takes ~1k cycles. Not callable from the interrupts.
+ *
+ * Host builds (UNIT_TEST) use the software fallback: byte table CRC-8 and CRC-32/MPEG-2, slice-by-4 CRC-32,
+ * bit-exact with the unit.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#ifndef CRC_SERVICE_H
+#define CRC_SERVICE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CRC_SERVICE_CRC8_POLYNOMIAL     (0x31)
+#define CRC_SERVICE_CRC8_INIT           (0xFF)
+#define CRC_SERVICE_CRC32_POLYNOMIAL    (0x04C11DB7UL)
+#define CRC_SERVICE_CRC32_INIT          (0xFFFFFFFFUL)
+#define CRC_SERVICE_CRC32_FINAL_XOR     (0xFFFFFFFFUL)
+
+typedef enum {
+  CRC_SERVICE_CRC8 = 0, ///< CRC-8/NRSC-5
+  CRC_SERVICE_CRC32, ///< CRC-32/ISO-HDLC
+  CRC_SERVICE_CRC32_MPEG2, ///< CRC-32/MPEG-2
+  CRC_SERVICE_ALGORITHMS_COUNT
+} CRC_SERVICE_Algorithm_t;
+
+/**
+ * @brief Parameters of the algorithm, in the Rocksoft model terms
+ */
+typedef struct {
+  uint32_t polynomial; ///< Normal (not reflected) form
+  uint32_t init;
+  uint32_t finalXor;
+  uint8_t width; ///< 8 or 32 bits
+  bool isReflected; ///< Input bytes and the output are bit reversed
+} CRC_SERVICE_Config_t;
+
+extern const CRC_SERVICE_Config_t CRC_SERVICE_Configs[CRC_SERVICE_ALGORITHMS_COUNT];
+
+uint8_t CRC_SERVICE_Crc8(const uint8_t *data, uint32_t length);
+uint32_t CRC_SERVICE_Crc32(const uint8_t *data, uint32_t length);
+uint32_t CRC_SERVICE_Crc32Update(uint32_t crc, const uint8_t *data, uint32_t length);
+uint32_t CRC_SERVICE_Crc32Mpeg2Update(uint32_t crc, const uint8_t *data, uint32_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //CRC_SERVICE_H
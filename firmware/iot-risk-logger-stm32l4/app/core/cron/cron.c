@@ -14,6 +14,13 @@ static osStatus_t handleCronMessage(CRON_Actor_t *this, message_t *message);
 static uint8_t monthStrToNumber(const char* monthStr);
 static osStatus_t setTimeFromUnixTimestamp(int32_t timestamp);
 static osStatus_t setWakeUpPeriod(uint32_t periodSeconds);
+static osStatus_t adaptWakeUpPeriod(CRON_Actor_t *this, const ACQUISITION_Frame_t *frame);
+static osStatus_t setWakeUpPeriodFromCommand(CRON_Actor_t *this, const message_t *message);
+static osStatus_t setWakeUpPeriodBoundsFromCommand(CRON_Actor_t *this, const message_t *message);
+static osStatus_t setWakeUpPeriodBounds(CRON_Actor_t *this, uint16_t minPeriodSeconds, uint16_t maxPeriodSeconds);
+static osStatus_t changeWakeUpPeriod(CRON_Actor_t *this, uint16_t periodSeconds, CRON_PeriodReason_t reason, int32_t timestamp);
+static CRON_PeriodReason_t classifyFrame(CRON_Actor_t *this, const ACQUISITION_Frame_t *frame);
+static void setReference(CRON_Actor_t *this, const ACQUISITION_Frame_t *frame);
 
 static HAL_StatusTypeDef setCurrentTime(void);
 static HAL_StatusTypeDef setCurrentDate(void);
@@ -25,6 +32,11 @@ CRON_Actor_t CRON_Actor = {
     .osMessageQueueId = NULL,
     .osThreadId = NULL,
   },
+  .periodSeconds = CRON_MIN_WAKE_UP_PERIOD_S,
+  .minPeriodSeconds = CRON_MIN_WAKE_UP_PERIOD_S,
+  .maxPeriodSeconds = CRON_MAX_WAKE_UP_PERIOD_S,
+  .stableWakeUps = 0,
+  .hasReference = false,
 };
 
 actor_t* CRON_ActorInit(void) {
@@ -34,8 +46,8 @@ actor_t* CRON_ActorInit(void) {
   // set date to current (compilation date)
   status |= setCurrentDate();
 
-  // TODO remove after debugging
-  status |= setWakeUpPeriod(30); // every 30 seconds
+  // start fast, the period adapts to the measurements
+  status |= setWakeUpPeriod(CRON_Actor.periodSeconds);
 
   #ifdef DEBUG
     fprintf(stdout, "Cron initialized: %d\n", status);
@@ -55,11 +67,174 @@ static osStatus_t handleCronMessage(CRON_Actor_t *this, message_t *message) {
     case GLOBAL_CMD_SET_TIME_DATE:
       return setTimeFromUnixTimestamp((int32_t)message->payload.value);
     case GLOBAL_CMD_SET_WAKE_UP_PERIOD:
-      return setWakeUpPeriod(message->payload.value);
+      return setWakeUpPeriodFromCommand(this, message);
+    case GLOBAL_CMD_SET_WAKE_UP_PERIOD_BOUNDS:
+      return setWakeUpPeriodBoundsFromCommand(this, message);
+    case GLOBAL_MEASUREMENTS_FRAME_READY:
+      return adaptWakeUpPeriod(this, (const ACQUISITION_Frame_t *) message->payload.ptr);
   }
   return osOK;
 }
 
+/**
+ * @brief Adapts the wake up period to the frame, runs in the event manager context on every frame
+ */
+static osStatus_t adaptWakeUpPeriod(CRON_Actor_t *this, const ACQUISITION_Frame_t *frame) {
+  if (!this->hasReference) {
+    setReference(this, frame);
+
+    return changeWakeUpPeriod(this, this->periodSeconds, CRON_PERIOD_REASON_INITIAL, frame->timestamp);
+  }
+
+  CRON_PeriodReason_t reason = classifyFrame(this, frame);
+
+  if (frame->validMask & ACQUISITION_TEMPERATURE_HUMIDITY_VALID) {
+    this->previousTemperature = (uint16_t) frame->rawTemperature;
+    this->previousTimestamp = frame->triggerTimestamp;
+  }
+
+  if (reason != CRON_PERIOD_REASON_STABLE) {
+    // re-center the deadband, stay fast until the measurements settle
+    setReference(this, frame);
+    this->stableWakeUps = 0;
+
+    if (this->periodSeconds == this->minPeriodSeconds) return osOK;
+
+    return changeWakeUpPeriod(this, this->minPeriodSeconds, reason, frame->timestamp);
+  }
+
+  if (++this->stableWakeUps < CRON_STABLE_WAKE_UPS_TO_LENGTHEN) return osOK;
+
+  this->stableWakeUps = 0;
+
+  uint32_t period = (uint32_t) this->periodSeconds * 2;
+  if (period > this->maxPeriodSeconds) period = this->maxPeriodSeconds;
+
+  if (period == this->periodSeconds) return osOK;
+
+  return changeWakeUpPeriod(this, (uint16_t) period, reason, frame->timestamp);
+}
+
+/**
+ * @brief Checks the valid measurements of the frame against the limits, the deadband and the rate limit
+ *
+ * The deadband is centered on the reference, not on the previous frame, so a slow drift leaves it as well.
+ */
+static CRON_PeriodReason_t classifyFrame(CRON_Actor_t *this, const ACQUISITION_Frame_t *frame) {
+  if (frame->validMask & ACQUISITION_TEMPERATURE_HUMIDITY_VALID) {
+    // SHT3x raw temperature is unsigned, the frame keeps it in int16_t
+    const uint16_t temperature = (uint16_t) frame->rawTemperature;
+    // pipelined single-shot, the rate is over the measurement instants, not the wake ups
+    const int32_t elapsedSeconds = frame->triggerTimestamp - this->previousTimestamp;
+
+    if (temperature < CRON_TEMPERATURE_LOW_LIMIT_RAW || temperature > CRON_TEMPERATURE_HIGH_LIMIT_RAW) return CRON_PERIOD_REASON_BREACH;
+
+    if (abs(temperature - this->referenceTemperature) > CRON_TEMPERATURE_DEADBAND_RAW) return CRON_PERIOD_REASON_CHANGE;
+    if (abs(frame->rawHumidity - this->referenceHumidity) > CRON_HUMIDITY_DEADBAND_RAW) return CRON_PERIOD_REASON_CHANGE;
+
+    if (elapsedSeconds > 0 && abs(temperature - this->previousTemperature) * 60 / elapsedSeconds > CRON_TEMPERATURE_RATE_LIMIT_RAW_PER_MIN) {
+      return CRON_PERIOD_REASON_CHANGE;
+    }
+  }
+
+  if (frame->validMask & ACQUISITION_LUX_VALID) {
+    const uint32_t lux = CONVERT_OPT3001RawToCentiLux(frame->rawLux);
+    const uint32_t luxDifference = (lux > this->referenceLux) ? (lux - this->referenceLux) : (this->referenceLux - lux);
+    uint32_t luxDeadband = this->referenceLux / 100 * CRON_LUX_DEADBAND_PERCENT;
+
+    if (luxDeadband < CRON_LUX_DEADBAND_MIN) luxDeadband = CRON_LUX_DEADBAND_MIN;
+
+    if (luxDifference > luxDeadband) return CRON_PERIOD_REASON_CHANGE;
+  }
+
+  return CRON_PERIOD_REASON_STABLE;
+}
+
+/**
+ * @brief Re-centers the deadband on the valid measurements of the frame, the failed channel keeps its reference
+ *
+ * A channel missing from the first frame is referenced on its first valid measurement, which leaves the deadband.
+ */
+static void setReference(CRON_Actor_t *this, const ACQUISITION_Frame_t *frame) {
+  if (frame->validMask & ACQUISITION_TEMPERATURE_HUMIDITY_VALID) {
+    this->referenceTemperature = (uint16_t) frame->rawTemperature;
+    this->referenceHumidity = frame->rawHumidity;
+    this->previousTemperature = (uint16_t) frame->rawTemperature;
+    this->previousTimestamp = frame->triggerTimestamp;
+  }
+
+  if (frame->validMask & ACQUISITION_LUX_VALID) {
+    this->referenceLux = CONVERT_OPT3001RawToCentiLux(frame->rawLux);
+  }
+
+  this->hasReference = true;
+}
+
+/**
+ * @brief Pins the period, the fixed period is the adaptive one with equal bounds
+ * @note The payload pointer is the command frame payload of NFC or USB stream, it's read at once
+ */
+static osStatus_t setWakeUpPeriodFromCommand(CRON_Actor_t *this, const message_t *message) {
+  uint16_t periodSeconds = 0;
+
+  if (message->payload.ptr == NULL || message->payload_size != sizeof(periodSeconds)) return osErrorParameter;
+
+  memcpy(&periodSeconds, message->payload.ptr, sizeof(periodSeconds));
+
+  return setWakeUpPeriodBounds(this, periodSeconds, periodSeconds);
+}
+
+/**
+ * @brief Sets the adaptive period bounds from the NFC_WakeUpPeriodBounds_t payload
+ */
+static osStatus_t setWakeUpPeriodBoundsFromCommand(CRON_Actor_t *this, const message_t *message) {
+  NFC_WakeUpPeriodBounds_t bounds = {0};
+
+  if (message->payload.ptr == NULL || message->payload_size != sizeof(bounds)) return osErrorParameter;
+
+  memcpy(&bounds, message->payload.ptr, sizeof(bounds));
+
+  return setWakeUpPeriodBounds(this, bounds.minPeriodSeconds, bounds.maxPeriodSeconds);
+}
+
+static osStatus_t setWakeUpPeriodBounds(CRON_Actor_t *this, uint16_t minPeriodSeconds, uint16_t maxPeriodSeconds) {
+  if (minPeriodSeconds == 0 || maxPeriodSeconds < minPeriodSeconds) return osErrorParameter;
+
+  this->minPeriodSeconds = minPeriodSeconds;
+  this->maxPeriodSeconds = maxPeriodSeconds;
+  this->stableWakeUps = 0;
+
+  return changeWakeUpPeriod(this, minPeriodSeconds, CRON_PERIOD_REASON_COMMAND, CRON_GetCurrentUnixTimestamp());
+}
+
+/**
+ * @brief Restarts the RTC wake up timer with the new period and publishes the decision to the log
+ */
+static osStatus_t changeWakeUpPeriod(CRON_Actor_t *this, uint16_t periodSeconds, CRON_PeriodReason_t reason, int32_t timestamp) {
+  if (periodSeconds != this->periodSeconds) {
+    osStatus_t status = setWakeUpPeriod(periodSeconds);
+    if (status != osOK) return status;
+  }
+
+  // every published change has its own slot, MEMORY may still hold the previous ones in its queue
+  CRON_PeriodDecision_t *decision = &this->decisions[this->decisionIndex];
+  this->decisionIndex = (this->decisionIndex + 1) % CRON_DECISIONS_COUNT;
+
+  *decision = (CRON_PeriodDecision_t) {
+    .timestamp = timestamp,
+    .periodSeconds = periodSeconds,
+    .previousPeriodSeconds = this->periodSeconds,
+    .reason = reason,
+  };
+  this->periodSeconds = periodSeconds;
+
+  TRACE_LOG("CRON: wake up period %u -> %u s, reason %u\n", decision->previousPeriodSeconds, periodSeconds, reason);
+
+  osMessageQueuePut(EV_MANAGER_Actor.super.osMessageQueueId, &(message_t){GLOBAL_WAKE_UP_PERIOD_CHANGED, .payload.ptr = decision, .payload_size = sizeof(CRON_PeriodDecision_t)}, 0, 0);
+
+  return osOK;
+}
+
 static osStatus_t setTimeFromUnixTimestamp(int32_t timestamp) {
   // Convert Unix timestamp to broken-down time structure
   time_t rawTime = timestamp;
@@ -1,8 +1,10 @@
 /*!
  * @file cron.h
- * @brief Brief description of the file.
+ * @brief RTC time keeping and the adaptive RTC wake up period.
  *
- * Detailed description of the file.
+ * The wake up period adapts to the measurements: it's doubled after CRON_STABLE_WAKE_UPS_TO_LENGTHEN wake ups
+ * within the deadband up to the max period, and drops to the min period when the measurements leave the deadband,
+ * the temperature changes too fast or breaches the limits. Every change is published to the MEMORY log.
  *
  * @date 09/08/2024
  * @author artempolisskyi
@@ -19,15 +21,59 @@ extern "C" {
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <stdbool.h>
 
 #include "main.h"
 #include "rtc.h"
+#include "conversions.h"
 
 #define YEARS_FROM_1900_TO_2000 100
 #define WAKE_UP_AUTO_CLEAR 1 ///< Auto-clear the wake-up event, especially useful in low-power modes.
 
+#define CRON_MIN_WAKE_UP_PERIOD_S                 (30)    // default, used while the measurements change
+#define CRON_MAX_WAKE_UP_PERIOD_S                 (600)   // default, reached after ~20min of stable measurements
+#define CRON_STABLE_WAKE_UPS_TO_LENGTHEN          (4)     // stable wake ups before the period is doubled
+#define CRON_TEMPERATURE_DEADBAND_RAW             CONVERT_CENTI_CELSIUS_DELTA_TO_SHT3x_RAW(50)  // 0.5°C
+#define CRON_TEMPERATURE_RATE_LIMIT_RAW_PER_MIN   CONVERT_CENTI_CELSIUS_DELTA_TO_SHT3x_RAW(20)  // 0.2°C/min
+#define CRON_HUMIDITY_DEADBAND_RAW                CONVERT_CENTI_RH_DELTA_TO_SHT3x_RAW(200)      // 2%RH
+#define CRON_LUX_DEADBAND_PERCENT                 (25)
+#define CRON_LUX_DEADBAND_MIN                     (1000)  // 10lux, CONVERT_OPT3001RawToCentiLux() units
+#define CRON_TEMPERATURE_LOW_LIMIT_RAW            CONVERT_CENTI_CELSIUS_TO_SHT3x_RAW(200)  // cold chain 2..8°C
+#define CRON_TEMPERATURE_HIGH_LIMIT_RAW           CONVERT_CENTI_CELSIUS_TO_SHT3x_RAW(800)
+#define CRON_DECISIONS_COUNT                      (4)     // published changes in flight, a slot is reused 4 changes later
+
+typedef enum {
+  CRON_PERIOD_REASON_INITIAL = 0, ///< First frame of the sensing, the period isn't changed
+  CRON_PERIOD_REASON_STABLE, ///< Measurements stayed within the deadband, the period is doubled
+  CRON_PERIOD_REASON_CHANGE, ///< Measurements left the deadband or the temperature changes too fast
+  CRON_PERIOD_REASON_BREACH, ///< Temperature is out of the limits
+  CRON_PERIOD_REASON_COMMAND, ///< Set by GLOBAL_CMD_SET_WAKE_UP_PERIOD or GLOBAL_CMD_SET_WAKE_UP_PERIOD_BOUNDS
+} CRON_PeriodReason_t;
+
+/**
+ * @brief Wake up period change, published as GLOBAL_WAKE_UP_PERIOD_CHANGED
+ */
+typedef struct {
+  int32_t timestamp; ///< UNIX timestamp the new period starts from
+  uint16_t periodSeconds;
+  uint16_t previousPeriodSeconds;
+  uint8_t reason; ///< CRON_PeriodReason_t
+} CRON_PeriodDecision_t;
+
 typedef struct {
   actor_t super;
+  uint16_t periodSeconds; ///< Current RTC wake up period
+  uint16_t minPeriodSeconds;
+  uint16_t maxPeriodSeconds;
+  uint8_t stableWakeUps; ///< Consecutive wake ups within the deadband
+  bool hasReference;
+  uint16_t referenceTemperature; ///< Raw measurements the deadband is centered on
+  uint16_t referenceHumidity;
+  uint32_t referenceLux;
+  uint16_t previousTemperature; ///< Raw temperature of the previous frame, for the rate of change
+  int32_t previousTimestamp;
+  CRON_PeriodDecision_t decisions[CRON_DECISIONS_COUNT]; ///< Ring of the published changes, the payloads of the queued events
+  uint8_t decisionIndex; ///< Slot of the next change
 } CRON_Actor_t;
 
 actor_t* CRON_ActorInit(void);
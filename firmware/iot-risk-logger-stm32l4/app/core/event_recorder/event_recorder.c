@@ -0,0 +1,109 @@
+/*!
+ * @file event_recorder.c
+ * @brief implementation of the event stream recorder
+ *
+ * Records are written from the Event Manager publish path and from the actors threads on the direct deliveries,
+ * the record slot and the spill are taken with the scheduler locked. Pages are released by the MEMORY actor
+ * after the spill.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#include "event_recorder.h"
+#include "event_manager.h"
+
+extern actor_t* ACTORS_LOOKUP_SystemRegistry[MAX_ACTORS];
+
+static void recordMessage(uint8_t receiver, const message_t *message);
+static void spillCurrentPage(void);
+
+static EVENT_RECORDER_Record_t recorderPages[EVENT_RECORDER_PAGES][EVENT_RECORDER_RECORDS_PER_PAGE];
+static volatile bool isPageSpilling[EVENT_RECORDER_PAGES] = {false};
+static uint8_t currentPage = 0;
+static uint8_t currentPageRecords = 0;
+static uint32_t recordsSequence = 0;
+
+/**
+ * @brief Captures the message published by the Event Manager
+ */
+void EVENT_RECORDER_Record(const message_t *message) {
+  recordMessage(EVENT_RECORDER_PUBLISHED, message);
+}
+
+/**
+ * @brief Captures the message delivered to the actor, unless it came from the actor's subscription
+ */
+void EVENT_RECORDER_RecordDelivery(ACTOR_ID receiver, const message_t *message) {
+  if (EV_MANAGER_IsSubscribed(receiver, message->event)) return;
+
+  recordMessage((uint8_t) receiver, message);
+}
+
+/**
+ * @brief Spills the page on full page and on the RTC wake up
+ *
+ * @note The record is dropped (sequence gap) if both pages are still being spilled
+ */
+static void recordMessage(uint8_t receiver, const message_t *message) {
+  const int32_t lock = osKernelLock();
+  uint32_t sequence = recordsSequence++;
+
+  if (isPageSpilling[currentPage]) {
+    osKernelRestoreLock(lock);
+    return;
+  }
+
+  EVENT_RECORDER_Record_t *record = &recorderPages[currentPage][currentPageRecords++];
+  bool hasPayload = (message->payload_size > 0) && (message->payload.ptr != NULL);
+  size_t payloadCopySize = hasPayload
+    ? ((message->payload_size < EVENT_RECORDER_PAYLOAD_COPY_SIZE) ? (size_t) message->payload_size : EVENT_RECORDER_PAYLOAD_COPY_SIZE)
+    : 0;
+
+  *record = (EVENT_RECORDER_Record_t) {
+    .sequence = sequence,
+    .tick = osKernelGetTickCount(),
+    .event = message->event,
+    .payloadSize = (int16_t) message->payload_size,
+    .value = message->payload.value,
+    .receiver = receiver,
+  };
+  memset(record->payload, 0xFF, sizeof(record->payload));
+  if (payloadCopySize > 0) memcpy(record->payload, message->payload.ptr, payloadCopySize);
+
+  if (currentPageRecords == EVENT_RECORDER_RECORDS_PER_PAGE || message->event == GLOBAL_WAKE_N_READ) {
+    spillCurrentPage();
+  }
+
+  osKernelRestoreLock(lock);
+}
+
+/**
+ * @brief Called by the MEMORY actor when the page is written to the NOR Flash
+ */
+void EVENT_RECORDER_ReleasePage(const void *page) {
+  for (uint8_t i = 0; i < EVENT_RECORDER_PAGES; i++) {
+    if (page == recorderPages[i]) isPageSpilling[i] = false;
+  }
+}
+
+static void spillCurrentPage(void) {
+  osMessageQueueId_t memoryQueue = ACTORS_LOOKUP_SystemRegistry[MEMORY_ACTOR_ID]->osMessageQueueId;
+
+  isPageSpilling[currentPage] = true;
+
+  osStatus_t status = osMessageQueuePut(memoryQueue, &(message_t){MEMORY_EVENT_RECORDS_SPILL,
+                                                                    .payload.ptr = recorderPages[currentPage],
+                                                                    .payload_size = currentPageRecords * EVENT_RECORDER_RECORD_SIZE}, 0, 0);
+
+  // memory queue is full, keep the page to retry on the next spill
+  if (status != osOK) {
+    isPageSpilling[currentPage] = false;
+    if (currentPageRecords < EVENT_RECORDER_RECORDS_PER_PAGE) return;
+    currentPageRecords = 0; // full page is lost, visible as a sequence gap
+    return;
+  }
+
+  currentPage = (currentPage + 1) % EVENT_RECORDER_PAGES;
+  currentPageRecords = 0;
+}
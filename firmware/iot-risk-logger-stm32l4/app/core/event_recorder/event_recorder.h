@@ -0,0 +1,71 @@
+/*!
+ * @file event_recorder.h
+ * @brief Event stream recorder, captures every message published by the Event Manager and the messages sent
+ * directly to the FSM actors
+ *
+ * The direct messages (e.g. MEMORY results, sensors bus completions, actor timers expiries, GLOBAL_CMD_RESTART)
+ * bypass the Event Manager, they are recorded on the delivery by FSM_Dispatch() with the receiving actor ID.
+ * The publishes reaching the actor through its subscription are recorded once, on the publish.
+ *
+ * Records are collected in a double-buffered RAM page and spilled by the MEMORY actor to the reserved
+ * NOR Flash area (EVENT_RECORDER_AREA_ADDR) when the page is full and on every RTC wake up.
+ * The area is a circular log: the sector after the tail is always erased, so the tail is found after reboot
+ * as the first erased record following a written one.
+ *
+ * `scripts/replay_event_stream.py` orders the dumped area and replays it through the NFC host harness in virtual time.
+ *
+ * @note Enabled by the EVENT_RECORDER_ENABLED build flag.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#ifndef EVENT_RECORDER_H
+#define EVENT_RECORDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "cmsis_os2.h"
+#include "actor.h"
+#include "fs_static.h"
+
+#define EVENT_RECORDER_PAYLOAD_COPY_SIZE  (15)
+#define EVENT_RECORDER_RECORD_SIZE        (32)
+#define EVENT_RECORDER_RECORDS_PER_PAGE   (8)     // 256B, NOR Flash page
+#define EVENT_RECORDER_PAGES              (2)     // one is filled while the other is spilled
+#define EVENT_RECORDER_ERASED_SEQUENCE    (0xFFFFFFFF)
+#define EVENT_RECORDER_PUBLISHED          (0xFF)  // receiver of the messages published by the Event Manager
+
+/**
+ * @brief Recorded message
+ *
+ * @note Sequence restarts from 0 on every boot, the host splits the stream into sessions by it.
+ */
+typedef struct __attribute__((packed)) {
+  uint32_t sequence;                                  ///< Record number since boot, gaps mean dropped records
+  uint32_t tick;                                      ///< Kernel tick of the publish
+  uint16_t event;                                     ///< Published event
+  int16_t payloadSize;                                ///< Original payload size
+  uint32_t value;                                     ///< Payload value or pointer
+  uint8_t receiver;                                   ///< Actor ID of the direct message, EVENT_RECORDER_PUBLISHED otherwise
+  uint8_t payload[EVENT_RECORDER_PAYLOAD_COPY_SIZE];  ///< First bytes of the pointed payload, if any
+} EVENT_RECORDER_Record_t;
+
+_Static_assert(sizeof(EVENT_RECORDER_Record_t) == EVENT_RECORDER_RECORD_SIZE, "Event record should be 32 bytes");
+
+void EVENT_RECORDER_Record(const message_t *message);
+void EVENT_RECORDER_RecordDelivery(ACTOR_ID receiver, const message_t *message);
+void EVENT_RECORDER_ReleasePage(const void *page);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //EVENT_RECORDER_H
@@ -31,6 +31,19 @@ extern "C" {
 
 // Log file
 #define INITIAL_LOG_START_ADDR  (FAT12_BOOT_SECTOR_SIZE + SETTINGS_FILE_SIZE + 1)
+#define LOG_END_ADDR            (SHOCK_CAPTURES_AREA_ADDR)
+// the log isn't circular, an entry is appended only if it ends before the shock captures area
+#define LOG_HAS_SPACE_FOR(tailAddress, size) ((uint32_t) (tailAddress) + (uint32_t) (size) <= LOG_END_ADDR)
+
+// Shock captures area, one sector per capture, circular, precedes the event recorder area
+#define SHOCK_CAPTURES_SLOT_SIZE  (0x1000)  // 4KB - 1 erasable sector, header and 512 XYZ samples
+#define SHOCK_CAPTURES_SLOTS      (64)
+#define SHOCK_CAPTURES_AREA_SIZE  (SHOCK_CAPTURES_SLOT_SIZE * SHOCK_CAPTURES_SLOTS) // 256KB
+#define SHOCK_CAPTURES_AREA_ADDR  (EVENT_RECORDER_AREA_ADDR - SHOCK_CAPTURES_AREA_SIZE)
+
+// Event recorder area, reserved at the end of the 8MB NOR Flash
+#define EVENT_RECORDER_AREA_SIZE  (0x10000) // 64KB - 16 erasable sectors
+#define EVENT_RECORDER_AREA_ADDR  (0x800000 - EVENT_RECORDER_AREA_SIZE)
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,79 @@
+/*!
+ * @file fsm.c
+ * @brief implementation of the table-driven FSM engine
+ *
+ * Tables are small (a handful of rows per state) and grouped by state, so the lookup is a linear scan over
+ * const Flash data. A dense state × event matrix over the whole event_t space would cost kilobytes of Flash
+ * per actor on the 128K part for no measurable gain.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#include <inttypes.h>
+
+#include "fsm.h"
+#ifdef EVENT_RECORDER_ENABLED
+#include "event_recorder.h"
+#endif
+
+/**
+ * @brief Finds the transition for the given state and event.
+ *
+ * @param[in] table Actor's transition table
+ * @param[in] state Current state of the actor
+ * @param[in] event Incoming event
+ * @return Pointer to the table row or NULL if the event is not handled in the state
+ */
+const FSM_Transition_t* FSM_FindTransition(const FSM_Table_t *table, uint8_t state, event_t event) {
+  for (uint16_t i = 0; i < table->transitionsCount; i++) {
+    const FSM_Transition_t *transition = &table->transitions[i];
+
+    if (transition->state == state && transition->event == event)
+      return transition;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Dispatches the message to the actor's FSM.
+ *
+ * Runs the transition action and switches `state` to the transition's next state if the action succeeded.
+ * Events without transition in the current state are passed to the table's `onUnhandled` handler or ignored.
+ *
+ * @param[in] table Actor's transition table
+ * @param[in] actor Actor owning the FSM
+ * @param[in] message Incoming message
+ * @param[in,out] state Current state, updated with the next state on success
+ * @return Status of the action, osOK for ignored events
+ */
+osStatus_t FSM_Dispatch(const FSM_Table_t *table, actor_t *actor, message_t *message, uint8_t *state) {
+  #ifdef EVENT_RECORDER_ENABLED
+  // the messages sent directly to the actor never pass the Event Manager, they are recorded here
+  EVENT_RECORDER_RecordDelivery((ACTOR_ID) actor->actorId, message);
+  #endif
+
+  const FSM_Transition_t *transition = FSM_FindTransition(table, *state, message->event);
+
+  if (transition == NULL) {
+    return (table->onUnhandled == NULL)
+      ? osOK
+      : table->onUnhandled(actor, message);
+  }
+
+  osStatus_t status = (transition->action == FSM_NO_ACTION)
+    ? osOK
+    : transition->action(actor, message);
+
+  if (status != osOK)
+    return status;
+
+  if (transition->nextState != *state) {
+    TRACE_LOG("%" PRIu32 ": %u -> %u\n", actor->actorId, (unsigned) *state, (unsigned) transition->nextState);
+  }
+
+  *state = transition->nextState;
+
+  return osOK;
+}
@@ -0,0 +1,87 @@
+/*!
+ * @file fsm.h
+ * @brief Table-driven finite state machine engine for actors
+ *
+ * Every actor describes its behaviour as a const transition table (state × event → action, next state)
+ * placed in Flash. The actor's message handler calls FSM_Dispatch() which finds the transition for the
+ * current state and the incoming event, runs the action and switches to the next state on success.
+ *
+ * Tables are the single source of truth for the actors' state diagrams:
+ * `scripts/generate_state_machine_diagrams.py` parses the FSM_TRANSITION() rows and regenerates
+ * the PlantUML blocks in the tasks READMEs.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#ifndef FSM_H
+#define FSM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "actor.h"
+
+/**
+ * @brief Action executed on a transition.
+ *
+ * @param actor Pointer to the actor owning the FSM (cast to the inherited actor type in the action).
+ * @param message Message which triggered the transition.
+ * @return osOK to commit the transition, any other status leaves the state untouched.
+ */
+typedef osStatus_t (*FSM_Action_t)(struct actor_t *actor, message_t *message);
+
+/**
+ * @brief Single row of the transition table.
+ */
+typedef struct {
+  uint8_t state;        ///< State the transition starts from
+  uint8_t nextState;    ///< State to switch to after the action succeeded
+  uint16_t event;       ///< Event triggering the transition
+  FSM_Action_t action;  ///< Action to execute, NULL for a pure state change
+} FSM_Transition_t;
+
+/**
+ * @brief Transition table of an actor.
+ */
+typedef struct {
+  const FSM_Transition_t *transitions;  ///< Table rows, grouped by the source state
+  uint16_t transitionsCount;            ///< Number of rows in the table
+  FSM_Action_t onUnhandled;             ///< Called for events without transition, NULL to silently ignore them
+} FSM_Table_t;
+
+/**
+ * @brief Declares a transition table row.
+ *
+ * @warning Keep every row on a single line, the diagrams generator parses them with a regular expression.
+ *
+ * @example
+ * static const FSM_Transition_t myActorTransitions[] = {
+ *   FSM_TRANSITION(MY_ACTOR_NO_STATE,   GLOBAL_CMD_INITIALIZE,  initialize,   MY_ACTOR_IDLE_STATE),
+ *   FSM_TRANSITION(MY_ACTOR_IDLE_STATE, GLOBAL_WAKE_N_READ,     readSensor,   MY_ACTOR_IDLE_STATE),
+ * };
+ */
+#define FSM_TRANSITION(fromState, triggerEvent, actionHandler, toState) \
+  { .state = (fromState), .nextState = (toState), .event = (triggerEvent), .action = (FSM_Action_t) (actionHandler) }
+
+/**
+ * @brief Declares a transition table from the rows array.
+ */
+#define FSM_TABLE(transitionsArray, unhandledHandler) \
+  { .transitions = (transitionsArray), .transitionsCount = sizeof(transitionsArray) / sizeof((transitionsArray)[0]), .onUnhandled = (FSM_Action_t) (unhandledHandler) }
+
+#define FSM_NO_ACTION (NULL)
+
+const FSM_Transition_t* FSM_FindTransition(const FSM_Table_t *table, uint8_t state, event_t event);
+osStatus_t FSM_Dispatch(const FSM_Table_t *table, actor_t *actor, message_t *message, uint8_t *state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //FSM_H
@@ -38,15 +38,21 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
     osMessageQueuePut(NFC_Actor.super.osMessageQueueId, &(message_t){NFC_GPO_INTERRUPT}, 0, 0);
   }
 
+  if (GPIO_Pin == LIGHT_INT_N_Pin) {
+    // end of the single-shot conversion or the limit crossing, depends on the light sensor state
+    message_t msg = {.event = LIGHT_SENS_INT};
+    osMessageQueuePut(ACTORS_LOOKUP_SystemRegistry[LIGHT_SENSOR_ACTOR_ID]->osMessageQueueId, &msg, 0, 0);
+  }
+
   if (GPIO_Pin == IMU_INT1_Pin) {
-    // e.g. FIFO watermark (or free-fall, depending on routing)
-    message_t msg = {.event = IMU_FIFO_WTM};
+    // wake-up (shock) or free-fall, the LIS2DW12 can route them to INT1 only
+    message_t msg = {.event = IMU_SHOCK_DETECTED};
     osMessageQueuePut(ACTORS_LOOKUP_SystemRegistry[IMU_ACTOR_ID]->osMessageQueueId, &msg, 0, 0);
   }
 
   if (GPIO_Pin == IMU_INT2_Pin) {
-    // e.g. free-fall
-    message_t msg = {.event = IMU_FREE_FALL_DETECTED};
+    // FIFO threshold
+    message_t msg = {.event = IMU_FIFO_WTM};
     osMessageQueuePut(ACTORS_LOOKUP_SystemRegistry[IMU_ACTOR_ID]->osMessageQueueId, &msg, 0, 0);
   }
 }
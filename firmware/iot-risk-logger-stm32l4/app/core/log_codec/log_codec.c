@@ -0,0 +1,209 @@
+/*!
+ * @file log_codec.c
+ * @brief implementation of the log entries codec
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#include "log_codec.h"
+
+#define LOG_CODEC_RECORD_TOKEN    (0x80U)
+#define LOG_CODEC_RUN_TOKEN_MAX   (LOG_CODEC_MAX_RUN - 1U)
+#define LOG_CODEC_MASK_HIGH_BITS  (0x03U)
+#define LOG_CODEC_VARINT_MORE     (0x80U)
+
+static uint8_t encodeRecord(const LOG_CODEC_State_t *state, const uint16_t *words, uint8_t *token);
+static void updateState(LOG_CODEC_State_t *state, const uint16_t *words);
+static uint32_t predictTimestamp(const LOG_CODEC_State_t *state);
+static uint8_t writeVarint(uint32_t value, uint8_t *output);
+static int32_t readVarint(const uint8_t *input, uint32_t inputLength, uint32_t *position, uint8_t maxBytes, uint32_t *value);
+
+/**
+ * @brief Resets the prediction to the zero entry, the stream starts over
+ */
+void LOG_CODEC_Init(LOG_CODEC_State_t *state) {
+  for (uint8_t i = 0; i < LOG_CODEC_WORDS_COUNT; i++) state->previous[i] = 0;
+  state->timestampDelta = 0;
+}
+
+/**
+ * @brief Encodes the entries while they fit the output, e.g. one mailbox frame payload
+ *
+ * @param[in,out] state Prediction state, advanced by the encoded entries only
+ * @param[in] records Raw log entries
+ * @param[out] output Encoded stream
+ * @param[out] outputLength Bytes written to the output
+ * @return Number of the encoded entries, less than recordsCount if the output is full
+ */
+uint32_t LOG_CODEC_Encode(LOG_CODEC_State_t *state, const uint8_t *records, uint32_t recordsCount,
+                          uint8_t *output, uint32_t outputSize, uint32_t *outputLength) {
+  uint8_t token[LOG_CODEC_MAX_RECORD_SIZE];
+  uint16_t words[LOG_CODEC_WORDS_COUNT];
+  uint32_t length = 0;
+  uint32_t encodedCount = 0;
+  bool isRunOpen = false; // the last output byte is a run token which can be extended
+
+  for (; encodedCount < recordsCount; encodedCount++) {
+    const uint8_t *record = &records[encodedCount * LOG_CODEC_RECORD_SIZE];
+
+    for (uint8_t i = 0; i < LOG_CODEC_WORDS_COUNT; i++) {
+      words[i] = (uint16_t) (record[2 * i] | (record[2 * i + 1] << 8));
+    }
+
+    const uint8_t tokenLength = encodeRecord(state, words, token);
+
+    if (tokenLength == 0 && isRunOpen) {
+      output[length - 1]++;
+      isRunOpen = output[length - 1] < LOG_CODEC_RUN_TOKEN_MAX;
+    } else if (tokenLength == 0) {
+      if (length + 1 > outputSize) break;
+
+      output[length++] = 0;
+      isRunOpen = true;
+    } else {
+      if (length + tokenLength > outputSize) break;
+
+      for (uint8_t i = 0; i < tokenLength; i++) output[length++] = token[i];
+      isRunOpen = false;
+    }
+
+    updateState(state, words);
+  }
+
+  *outputLength = length;
+
+  return encodedCount;
+}
+
+/**
+ * @brief Decodes the chunk of the stream, the entries are passed to the sink one by one
+ *
+ * @param[in,out] state Prediction state, continues from the previous chunk
+ * @return Number of the decoded entries, LOG_CODEC_ERROR if the chunk is malformed (the state is undefined then)
+ */
+int32_t LOG_CODEC_Decode(LOG_CODEC_State_t *state, const uint8_t *input, uint32_t inputLength,
+                         LOG_CODEC_RecordSink_t sink, void *context) {
+  uint8_t record[LOG_CODEC_RECORD_SIZE];
+  uint16_t words[LOG_CODEC_WORDS_COUNT];
+  uint32_t position = 0;
+  int32_t decodedCount = 0;
+
+  while (position < inputLength) {
+    const uint8_t token = input[position++];
+    uint32_t residuals[LOG_CODEC_FIELDS_COUNT] = {0};
+    uint16_t recordsCount = 1;
+
+    if (token < LOG_CODEC_RECORD_TOKEN) {
+      recordsCount = (uint16_t) (token + 1U);
+    } else {
+      if (token > (LOG_CODEC_RECORD_TOKEN | LOG_CODEC_MASK_HIGH_BITS) || position >= inputLength) return LOG_CODEC_ERROR;
+
+      const uint16_t mask = (uint16_t) (((token & LOG_CODEC_MASK_HIGH_BITS) << 8) | input[position++]);
+      if (mask == 0) return LOG_CODEC_ERROR;
+
+      for (uint8_t field = 0; field < LOG_CODEC_FIELDS_COUNT; field++) {
+        if ((mask & (1U << field)) == 0) continue;
+
+        if (readVarint(input, inputLength, &position, (field == 0) ? 5 : 3, &residuals[field]) != 0) return LOG_CODEC_ERROR;
+      }
+    }
+
+    while (recordsCount--) {
+      // zigzag residuals back to the signed differences, added modulo the field width
+      const uint32_t timestampResidual = (residuals[0] >> 1) ^ (0U - (residuals[0] & 1U));
+      const uint32_t timestamp = predictTimestamp(state) + timestampResidual;
+
+      words[0] = (uint16_t) timestamp;
+      words[1] = (uint16_t) (timestamp >> 16);
+
+      for (uint8_t field = 1; field < LOG_CODEC_FIELDS_COUNT; field++) {
+        const uint16_t residual = (uint16_t) ((residuals[field] >> 1) ^ (0U - (residuals[field] & 1U)));
+
+        words[field + 1] = (uint16_t) (state->previous[field + 1] + residual);
+      }
+
+      updateState(state, words);
+
+      for (uint8_t i = 0; i < LOG_CODEC_WORDS_COUNT; i++) {
+        record[2 * i] = (uint8_t) words[i];
+        record[2 * i + 1] = (uint8_t) (words[i] >> 8);
+      }
+
+      sink(record, context);
+      decodedCount++;
+    }
+  }
+
+  return decodedCount;
+}
+
+/**
+ * @return Token length, 0 if all the residuals are zero (the entry extends the run)
+ */
+static uint8_t encodeRecord(const LOG_CODEC_State_t *state, const uint16_t *words, uint8_t *token) {
+  const uint32_t timestamp = (uint32_t) words[0] | ((uint32_t) words[1] << 16);
+  const int32_t timestampResidual = (int32_t) (timestamp - predictTimestamp(state));
+  uint16_t mask = 0;
+  uint8_t length = 2; // token and the mask low byte
+
+  if (timestampResidual != 0) {
+    mask |= 1U;
+    length += writeVarint(((uint32_t) timestampResidual << 1) ^ (uint32_t) (timestampResidual >> 31), &token[length]);
+  }
+
+  for (uint8_t field = 1; field < LOG_CODEC_FIELDS_COUNT; field++) {
+    const int16_t residual = (int16_t) (words[field + 1] - state->previous[field + 1]);
+
+    if (residual == 0) continue;
+
+    mask |= (uint16_t) (1U << field);
+    length += writeVarint((uint16_t) (((uint16_t) residual << 1) ^ (uint16_t) (residual >> 15)), &token[length]);
+  }
+
+  if (mask == 0) return 0;
+
+  token[0] = (uint8_t) (LOG_CODEC_RECORD_TOKEN | (mask >> 8));
+  token[1] = (uint8_t) mask;
+
+  return length;
+}
+
+static void updateState(LOG_CODEC_State_t *state, const uint16_t *words) {
+  const uint32_t previousTimestamp = (uint32_t) state->previous[0] | ((uint32_t) state->previous[1] << 16);
+  const uint32_t timestamp = (uint32_t) words[0] | ((uint32_t) words[1] << 16);
+
+  state->timestampDelta = timestamp - previousTimestamp;
+
+  for (uint8_t i = 0; i < LOG_CODEC_WORDS_COUNT; i++) state->previous[i] = words[i];
+}
+
+static uint32_t predictTimestamp(const LOG_CODEC_State_t *state) {
+  return ((uint32_t) state->previous[0] | ((uint32_t) state->previous[1] << 16)) + state->timestampDelta;
+}
+
+static uint8_t writeVarint(uint32_t value, uint8_t *output) {
+  uint8_t length = 0;
+
+  while (value >= LOG_CODEC_VARINT_MORE) {
+    output[length++] = (uint8_t) (value | LOG_CODEC_VARINT_MORE);
+    value >>= 7;
+  }
+  output[length++] = (uint8_t) value;
+
+  return length;
+}
+
+static int32_t readVarint(const uint8_t *input, uint32_t inputLength, uint32_t *position, uint8_t maxBytes, uint32_t *value) {
+  *value = 0;
+
+  for (uint8_t i = 0; i < maxBytes && *position < inputLength; i++) {
+    const uint8_t byte = input[(*position)++];
+
+    *value |= (uint32_t) (byte & ~LOG_CODEC_VARINT_MORE) << (7 * i);
+
+    if ((byte & LOG_CODEC_VARINT_MORE) == 0) return 0;
+  }
+
+  return LOG_CODEC_ERROR;
+}
@@ -0,0 +1,65 @@
+/*!
+ * @file log_codec.h
+ * @brief Streaming delta + run-length codec of the 22 bytes log entries, used by the NFC log chunks stream
+ *
+ * An entry is taken as 11 little-endian 16-bit words. The timestamp (words 0-1) is predicted with the previous
+ * timestamp plus the previous interval, every other word with the same word of the previous entry. Only the
+ * non-zero prediction residuals are stored, so the entry of the periodic log costs a few bytes.
+ *
+ * Stream tokens:
+ * - 0x00...0x7F: run of (token + 1) entries with all residuals zero
+ * - 0x80...0x83: one entry, the token's low 2 bits and the next byte are the 10 bits mask of the non-zero residuals
+ *   (bit 0 is the timestamp, bit k is the word k + 1), followed by the residuals as zigzag LEB128 varints
+ *   (timestamp residual is 32-bit, the words residuals are 16-bit)
+ * - 0x84...0xFF: reserved
+ *
+ * The prediction state (previous entry and interval, 24 bytes) is carried across the calls: the chunks must be
+ * decoded in order, starting from LOG_CODEC_Init(). Any chunk decodes to whole entries.
+ *
+ * The decoder is the reference for the phone application and `scripts/decode_log_stream.py`.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#ifndef LOG_CODEC_H
+#define LOG_CODEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define LOG_CODEC_RECORD_SIZE       (22U)
+#define LOG_CODEC_WORDS_COUNT       (LOG_CODEC_RECORD_SIZE / 2U)
+#define LOG_CODEC_FIELDS_COUNT      (LOG_CODEC_WORDS_COUNT - 1U) ///< Timestamp and the 9 words after it
+#define LOG_CODEC_MAX_RECORD_SIZE   (2U + 5U + (LOG_CODEC_FIELDS_COUNT - 1U) * 3U) ///< Worst case encoded entry, 34 bytes
+#define LOG_CODEC_MAX_RUN           (128U)
+#define LOG_CODEC_ERROR             (-1)
+
+/**
+ * @brief Prediction state, the same on the encoder and the decoder side
+ */
+typedef struct {
+  uint16_t previous[LOG_CODEC_WORDS_COUNT]; ///< Previous entry
+  uint32_t timestampDelta; ///< Previous timestamps interval
+} LOG_CODEC_State_t;
+
+/**
+ * @brief Decoded entry callback
+ */
+typedef void (*LOG_CODEC_RecordSink_t)(const uint8_t record[LOG_CODEC_RECORD_SIZE], void *context);
+
+void LOG_CODEC_Init(LOG_CODEC_State_t *state);
+uint32_t LOG_CODEC_Encode(LOG_CODEC_State_t *state, const uint8_t *records, uint32_t recordsCount,
+                          uint8_t *output, uint32_t outputSize, uint32_t *outputLength);
+int32_t LOG_CODEC_Decode(LOG_CODEC_State_t *state, const uint8_t *input, uint32_t inputLength,
+                         LOG_CODEC_RecordSink_t sink, void *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //LOG_CODEC_H
@@ -0,0 +1,91 @@
+/*!
+ * @file log_policy.c
+ * @brief implementation of the deadband logging policy
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#include "log_policy.h"
+
+static bool isOutOfDeadband(const LOG_POLICY_t *policy, const LOG_POLICY_Sample_t *sample);
+static uint32_t difference(int32_t a, int32_t b);
+
+void LOG_POLICY_Init(LOG_POLICY_t *policy, const LOG_POLICY_Config_t *config) {
+  policy->config = *config;
+  policy->hasStored = false;
+  policy->suppressedCount = 0;
+}
+
+/**
+ * @brief Decides whether the sample should be stored
+ *
+ * @param[in,out] policy Policy state, the stored sample becomes the new deadbands center
+ * @param[in] sample Sample to check
+ * @param[out] suppressedCount Samples suppressed before this one, valid if it should be stored
+ * @return true if the sample should be stored
+ */
+bool LOG_POLICY_Filter(LOG_POLICY_t *policy, const LOG_POLICY_Sample_t *sample, uint16_t *suppressedCount) {
+  const bool isHeartbeat = policy->hasStored
+                           && difference(sample->timestamp, policy->stored.timestamp) >= policy->config.heartbeatSeconds;
+
+  const bool shouldStore = !policy->config.isEnabled
+                           || !policy->hasStored
+                           || isHeartbeat
+                           || isOutOfDeadband(policy, sample);
+
+  if (!shouldStore) {
+    if (policy->suppressedCount < UINT16_MAX) policy->suppressedCount++;
+
+    return false;
+  }
+
+  *suppressedCount = policy->suppressedCount;
+
+  policy->stored = *sample;
+  policy->hasStored = true;
+  policy->suppressedCount = 0;
+
+  return true;
+}
+
+/**
+ * @brief Drops the stored sample which failed to be written, the next sample is stored against no reference
+ *
+ * @param[in,out] policy Policy state
+ * @param[in] suppressedCount Samples suppressed before the failed one, as returned by LOG_POLICY_Filter()
+ * @note The failed sample counts as suppressed, with the ones suppressed after it
+ */
+void LOG_POLICY_Revert(LOG_POLICY_t *policy, uint16_t suppressedCount) {
+  const uint32_t total = (uint32_t) suppressedCount + 1 + policy->suppressedCount;
+
+  policy->hasStored = false;
+  policy->suppressedCount = (total < UINT16_MAX) ? (uint16_t) total : UINT16_MAX;
+}
+
+static bool isOutOfDeadband(const LOG_POLICY_t *policy, const LOG_POLICY_Sample_t *sample) {
+  const LOG_POLICY_Config_t *config = &policy->config;
+  const LOG_POLICY_Sample_t *stored = &policy->stored;
+
+  if (difference(sample->temperature, stored->temperature) > config->temperatureDeadband) return true;
+  if (difference(sample->humidity, stored->humidity) > config->humidityDeadband) return true;
+
+  uint32_t luxDeadband = stored->lux / 100 * config->luxDeadbandPercent;
+  if (luxDeadband < config->luxDeadbandMin) luxDeadband = config->luxDeadbandMin;
+
+  const uint32_t luxDifference = (sample->lux > stored->lux) ? (sample->lux - stored->lux) : (stored->lux - sample->lux);
+  if (luxDifference > luxDeadband) return true;
+
+  for (uint8_t axis = 0; axis < LOG_POLICY_AXES_COUNT; axis++) {
+    if (difference(sample->acceleration[axis], stored->acceleration[axis]) > config->accelerationDeadband) return true;
+  }
+
+  if (difference(sample->vibrationRms, stored->vibrationRms) > config->vibrationDeadband) return true;
+  if (difference(sample->vibrationMagnitude, stored->vibrationMagnitude) > config->vibrationDeadband) return true;
+
+  return false;
+}
+
+static uint32_t difference(int32_t a, int32_t b) {
+  return (a > b) ? (uint32_t) (a - b) : (uint32_t) (b - a);
+}
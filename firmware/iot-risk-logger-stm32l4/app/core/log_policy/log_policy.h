@@ -0,0 +1,81 @@
+/*!
+ * @file log_policy.h
+ * @brief Deadband (exception based) logging policy in front of the NOR Flash log
+ *
+ * A sample is stored only when any channel leaves its deadband around the last stored sample, or when the
+ * heartbeat interval since the last stored sample elapsed. The number of suppressed samples is reported with
+ * the next stored one, so the log keeps the sampling density while the stable stretches cost one entry per
+ * heartbeat.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#ifndef LOG_POLICY_H
+#define LOG_POLICY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "conversions.h"
+
+#define LOG_POLICY_AXES_COUNT (3)
+
+/**
+ * @brief Defaults: 0.2°C, 1%RH, 25% lux, 125mg per axis at ±2g, ~64mg of vibration, 15min heartbeat
+ */
+#define LOG_POLICY_DEFAULT_CONFIG {                                         \
+  .isEnabled = true,                                                        \
+  .temperatureDeadband = CONVERT_CENTI_CELSIUS_DELTA_TO_SHT3x_RAW(20),      \
+  .humidityDeadband = CONVERT_CENTI_RH_DELTA_TO_SHT3x_RAW(100),             \
+  .luxDeadbandPercent = 25,                                                 \
+  .luxDeadbandMin = 1000,                                                   \
+  .accelerationDeadband = CONVERT_MILLI_G_DELTA_TO_LIS2DW12_RAW(125, 2),    \
+  .vibrationDeadband = 4,                                                   \
+  .heartbeatSeconds = 900,                                                  \
+}
+
+typedef struct {
+  bool isEnabled; ///< Disabled policy stores every sample
+  uint16_t temperatureDeadband; ///< SHT3x raw, 175°C / 65536 per LSB
+  uint16_t humidityDeadband; ///< SHT3x raw, 100%RH / 65536 per LSB
+  uint8_t luxDeadbandPercent; ///< Of the stored lux
+  uint32_t luxDeadbandMin; ///< CONVERT_OPT3001RawToCentiLux() units, the relative deadband doesn't go below it in the dark
+  uint16_t accelerationDeadband; ///< LIS2DW12 raw, per axis
+  uint8_t vibrationDeadband; ///< VIBRATION_Summary_t units, for the RMS and the max magnitude
+  uint32_t heartbeatSeconds; ///< Max interval between the stored samples
+} LOG_POLICY_Config_t;
+
+/**
+ * @brief Channels of a log entry the deadbands are applied to
+ */
+typedef struct {
+  int32_t timestamp; ///< UNIX timestamp
+  uint16_t temperature; ///< SHT3x raw
+  uint16_t humidity; ///< SHT3x raw
+  uint32_t lux; ///< CONVERT_OPT3001RawToCentiLux() units
+  int16_t acceleration[LOG_POLICY_AXES_COUNT]; ///< LIS2DW12 raw
+  uint8_t vibrationRms; ///< VIBRATION_Summary_t
+  uint8_t vibrationMagnitude; ///< VIBRATION_Summary_t
+} LOG_POLICY_Sample_t;
+
+typedef struct {
+  LOG_POLICY_Config_t config;
+  LOG_POLICY_Sample_t stored; ///< The last stored sample, the deadbands are centered on it
+  bool hasStored;
+  uint16_t suppressedCount; ///< Samples suppressed since the last stored one
+} LOG_POLICY_t;
+
+void LOG_POLICY_Init(LOG_POLICY_t *policy, const LOG_POLICY_Config_t *config);
+bool LOG_POLICY_Filter(LOG_POLICY_t *policy, const LOG_POLICY_Sample_t *sample, uint16_t *suppressedCount);
+void LOG_POLICY_Revert(LOG_POLICY_t *policy, uint16_t suppressedCount);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //LOG_POLICY_H
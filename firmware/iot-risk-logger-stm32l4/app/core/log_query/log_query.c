@@ -0,0 +1,154 @@
+/*!
+ * @file log_query.c
+ * @brief implementation of the log aggregate queries
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#include "log_query.h"
+
+#define LOG_QUERY_TIMESTAMP_OFFSET    (0U)
+#define LOG_QUERY_TEMPERATURE_OFFSET  (4U) ///< Marker of the shock pointer and the wake up period entries as well
+#define LOG_QUERY_HUMIDITY_OFFSET     (6U)
+#define LOG_QUERY_LUX_OFFSET          (8U)
+
+static void closeHeldInterval(LOG_QUERY_t *query, int32_t end);
+static int32_t readChannel(const uint8_t *entry, uint8_t channel);
+static uint16_t readWord(const uint8_t *entry, uint8_t offset);
+static int32_t readTimestamp(const uint8_t *entry);
+
+/**
+ * @return false if the channel is unknown or the range is reversed
+ */
+bool LOG_QUERY_Init(LOG_QUERY_t *query, const LOG_QUERY_Request_t *request) {
+  *query = (LOG_QUERY_t) {.request = *request};
+
+  return request->channel < LOG_QUERY_CHANNELS_COUNT && request->from <= request->to;
+}
+
+/**
+ * @brief Binary searches the entry the range is evaluated from: the last one before the range start, which holds
+ * the value at the start, or the first entry of the log
+ * @note A marker entry there leaves the range start without the held value until the first entry within the range
+ *
+ * @param[out] entry Index of the entry
+ * @return 0 on success, LOG_QUERY_ERROR if a timestamp read failed
+ */
+int32_t LOG_QUERY_SeekRangeStart(const LOG_QUERY_t *query, uint32_t entriesCount, LOG_QUERY_ReadTimestamp_t readTimestamp,
+                                 void *context, uint32_t *entry) {
+  uint32_t low = 0;
+  uint32_t high = entriesCount;
+
+  // the first entry at or after the range start
+  while (low < high) {
+    const uint32_t middle = low + (high - low) / 2;
+    int32_t timestamp;
+
+    if (readTimestamp(middle, &timestamp, context) != 0) return LOG_QUERY_ERROR;
+
+    if (timestamp < query->request.from) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  *entry = (low > 0) ? low - 1 : 0;
+
+  return 0;
+}
+
+/**
+ * @brief Replays the consecutive log entries, starting from the LOG_QUERY_SeekRangeStart() one
+ * @return false once an entry after the range is seen, the rest of the log isn't needed
+ */
+bool LOG_QUERY_Accumulate(LOG_QUERY_t *query, const uint8_t *entries, uint32_t entriesCount) {
+  LOG_QUERY_Result_t *result = &query->result;
+
+  for (uint32_t i = 0; i < entriesCount && !query->isOver; i++) {
+    const uint8_t *entry = &entries[i * LOG_QUERY_ENTRY_SIZE];
+
+    if (readWord(entry, LOG_QUERY_TEMPERATURE_OFFSET) >= LOG_QUERY_MARKER_MIN) continue;
+
+    const int32_t timestamp = readTimestamp(entry);
+
+    if (timestamp > query->request.to) {
+      closeHeldInterval(query, query->request.to);
+      query->isOver = true;
+      break;
+    }
+
+    closeHeldInterval(query, timestamp);
+
+    const int32_t value = readChannel(entry, query->request.channel);
+
+    if (timestamp >= query->request.from) {
+      result->min = (result->count == 0 || value < result->min) ? value : result->min;
+      result->max = (result->count == 0 || value > result->max) ? value : result->max;
+      result->count++;
+      query->sum += value;
+    }
+
+    query->hasHeld = true;
+    query->heldTimestamp = timestamp;
+    query->isHeldAbove = value > query->request.threshold;
+  }
+
+  return !query->isOver;
+}
+
+/**
+ * @brief Closes the last held value at the end of the log and fills the mean
+ */
+void LOG_QUERY_Finish(LOG_QUERY_t *query) {
+  if (!query->isOver) {
+    closeHeldInterval(query, query->heldTimestamp);
+  }
+
+  if (query->result.count > 0) {
+    query->result.mean = (int32_t) (query->sum / (int64_t) query->result.count);
+  }
+}
+
+/**
+ * @brief Adds the part of the held value interval within the range, if the value is above the threshold
+ */
+static void closeHeldInterval(LOG_QUERY_t *query, int32_t end) {
+  LOG_QUERY_Result_t *result = &query->result;
+
+  if (!query->hasHeld || !query->isHeldAbove) return;
+
+  const int32_t intervalStart = (query->heldTimestamp > query->request.from) ? query->heldTimestamp : query->request.from;
+  const int32_t intervalEnd = (end < query->request.to) ? end : query->request.to;
+
+  if (intervalEnd < intervalStart) return;
+
+  // the excursion goes on across the consecutive entries above the threshold
+  if (!query->hasExcursion) {
+    result->firstExcursion = intervalStart;
+    query->hasExcursion = true;
+  }
+
+  result->lastExcursion = intervalEnd;
+  result->secondsAbove += (uint32_t) (intervalEnd - intervalStart);
+}
+
+static int32_t readChannel(const uint8_t *entry, uint8_t channel) {
+  switch (channel) {
+    case LOG_QUERY_TEMPERATURE:
+      return CONVERT_SHT3xRawToCentiCelsius(readWord(entry, LOG_QUERY_TEMPERATURE_OFFSET));
+    case LOG_QUERY_HUMIDITY:
+      return CONVERT_SHT3xRawToCentiRH(readWord(entry, LOG_QUERY_HUMIDITY_OFFSET));
+    default:
+      return (int32_t) CONVERT_OPT3001RawToCentiLux(readWord(entry, LOG_QUERY_LUX_OFFSET));
+  }
+}
+
+static uint16_t readWord(const uint8_t *entry, uint8_t offset) {
+  return (uint16_t) (entry[offset] | (entry[offset + 1] << 8));
+}
+
+static int32_t readTimestamp(const uint8_t *entry) {
+  return (int32_t) ((uint32_t) readWord(entry, LOG_QUERY_TIMESTAMP_OFFSET) | ((uint32_t) readWord(entry, LOG_QUERY_TIMESTAMP_OFFSET + 2) << 16));
+}
@@ -0,0 +1,91 @@
+/*!
+ * @file log_query.h
+ * @brief Aggregate queries over a time range of the NOR Flash log, evaluated on the device for the NFC reader
+ *
+ * The entries are replayed with sample and hold, as the deadband logging policy stores a sample on change only:
+ * the value of an entry lasts until the next entry, the last entry of the log lasts no time. A query answers with
+ * the count, min, max and mean of the entries logged within the range, the time the held value spent above the
+ * threshold and the bounds of the excursions above it. The values are in the conversions.h units.
+ *
+ * The log is time-ordered, so LOG_QUERY_SeekRangeStart() binary searches the range start: a query reads
+ * ~log2(N) timestamps and then the entries of the range only. The shock pointer and the wake up period entries
+ * are skipped.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#ifndef LOG_QUERY_H
+#define LOG_QUERY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "conversions.h"
+
+#define LOG_QUERY_ENTRY_SIZE            (22U)
+#define LOG_QUERY_MARKER_MIN            (0xFFFEU) ///< Raw temperatures from it on are the marker entries
+#define LOG_QUERY_ERROR                 (-1)
+
+typedef enum {
+  LOG_QUERY_TEMPERATURE = 0, ///< 0.01°C
+  LOG_QUERY_HUMIDITY, ///< 0.01%RH
+  LOG_QUERY_LUX, ///< 0.01lux
+  LOG_QUERY_CHANNELS_COUNT
+} LOG_QUERY_Channel_t;
+
+/**
+ * @brief Query of a channel over a time range, the GLOBAL_CMD_QUERY_LOG payload, little-endian
+ */
+typedef struct __attribute__((packed)) {
+  int32_t from; ///< UNIX timestamp, inclusive
+  int32_t to; ///< UNIX timestamp, inclusive
+  uint8_t channel; ///< LOG_QUERY_Channel_t
+  int32_t threshold; ///< Channel units, the excursions are above it
+} LOG_QUERY_Request_t;
+
+/**
+ * @brief Query response payload, little-endian
+ */
+typedef struct __attribute__((packed)) {
+  uint32_t count; ///< Entries logged within the range, the statistics are 0 without them
+  int32_t min;
+  int32_t max;
+  int32_t mean; ///< Of the logged entries, rounded toward zero
+  uint32_t secondsAbove; ///< Time the held value was above the threshold within the range
+  int32_t firstExcursion; ///< Start of the first excursion within the range, 0 if there are none
+  int32_t lastExcursion; ///< End of the last excursion within the range: the entry back below the threshold, the range end or the last entry
+} LOG_QUERY_Result_t;
+
+typedef struct {
+  LOG_QUERY_Request_t request;
+  LOG_QUERY_Result_t result;
+  int64_t sum;
+  int32_t heldTimestamp;
+  bool hasHeld;
+  bool isHeldAbove;
+  bool hasExcursion;
+  bool isOver; ///< An entry after the range is seen, the rest of the log isn't needed
+} LOG_QUERY_t;
+
+/**
+ * @brief Timestamp of the log entry by its index
+ * @return 0 on success
+ */
+typedef int32_t (*LOG_QUERY_ReadTimestamp_t)(uint32_t entry, int32_t *timestamp, void *context);
+
+bool LOG_QUERY_Init(LOG_QUERY_t *query, const LOG_QUERY_Request_t *request);
+int32_t LOG_QUERY_SeekRangeStart(const LOG_QUERY_t *query, uint32_t entriesCount, LOG_QUERY_ReadTimestamp_t readTimestamp,
+                                 void *context, uint32_t *entry);
+bool LOG_QUERY_Accumulate(LOG_QUERY_t *query, const uint8_t *entries, uint32_t entriesCount);
+void LOG_QUERY_Finish(LOG_QUERY_t *query);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //LOG_QUERY_H
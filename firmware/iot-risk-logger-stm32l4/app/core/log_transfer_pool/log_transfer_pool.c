@@ -0,0 +1,41 @@
+/*!
+ * @file log_transfer_pool.c
+ * @brief implementation of the log transfer buffers pool
+ *
+ * The owner is the only state shared between the exporters' threads, it's swapped atomically.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#include "log_transfer_pool.h"
+
+#define LOG_TRANSFER_POOL_NO_OWNER ((uint32_t) MAX_ACTORS)
+
+static LOG_TRANSFER_POOL_Buffer_t poolBuffers[LOG_TRANSFER_POOL_BUFFERS_COUNT];
+static uint32_t poolOwner = LOG_TRANSFER_POOL_NO_OWNER;
+
+/**
+ * @brief Claims the pool for the transfer of the owner
+ * @return The buffers, NULL if another exporter owns them. The owner's repeated claim gets them again.
+ */
+LOG_TRANSFER_POOL_Buffer_t* LOG_TRANSFER_POOL_Claim(ACTOR_ID owner) {
+  uint32_t expected = LOG_TRANSFER_POOL_NO_OWNER;
+
+  if (__atomic_compare_exchange_n(&poolOwner, &expected, (uint32_t) owner, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)
+      || expected == (uint32_t) owner) {
+    return poolBuffers;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Releases the pool, the call of the exporter which doesn't own it is ignored
+ * @note The owner shouldn't touch the buffers afterwards, a MEMORY read into them should be completed before
+ */
+void LOG_TRANSFER_POOL_Release(ACTOR_ID owner) {
+  uint32_t expected = (uint32_t) owner;
+
+  __atomic_compare_exchange_n(&poolOwner, &expected, LOG_TRANSFER_POOL_NO_OWNER, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+}
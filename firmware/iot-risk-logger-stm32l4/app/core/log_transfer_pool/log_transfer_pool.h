@@ -0,0 +1,38 @@
+/*!
+ * @file log_transfer_pool.h
+ * @brief Buffers of the log transfers, shared by the NFC and the USB stream exports
+ *
+ * MEMORY serves one log read at a time and the exports prefetch the blocks into two buffers, so a second export
+ * running at once would only halve the rate of both. The exporter claims the pool before its first block read and
+ * releases it when the transfer is over and no MEMORY read into the pool is pending. The other exporter's command
+ * is rejected meanwhile.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#ifndef LOG_TRANSFER_POOL_H
+#define LOG_TRANSFER_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "actor.h"
+
+#define LOG_TRANSFER_POOL_BUFFERS_COUNT (2U)    ///< Block being sent and the prefetched next one
+#define LOG_TRANSFER_POOL_BUFFER_SIZE   (1024U)
+
+typedef uint8_t LOG_TRANSFER_POOL_Buffer_t[LOG_TRANSFER_POOL_BUFFER_SIZE];
+
+LOG_TRANSFER_POOL_Buffer_t* LOG_TRANSFER_POOL_Claim(ACTOR_ID owner);
+void LOG_TRANSFER_POOL_Release(ACTOR_ID owner);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //LOG_TRANSFER_POOL_H
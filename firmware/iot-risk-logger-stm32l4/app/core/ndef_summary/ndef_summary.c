@@ -0,0 +1,287 @@
+/*!
+ * @file ndef_summary.c
+ * @brief implementation of the NDEF summary record
+ *
+ * @see NFC Forum Type 5 Tag Technical Specification, the Capability Container and the TLV blocks
+ * @see NFC Forum Text Record Type Definition
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#include <string.h>
+
+#include "ndef_summary.h"
+
+#define NDEF_SUMMARY_CC_MAGIC                   (0xE1U)
+#define NDEF_SUMMARY_CC_VERSION_ACCESS          (0x40U) ///< Version 1.0, read and write access granted
+#define NDEF_SUMMARY_NDEF_MESSAGE_TLV           (0x03U)
+#define NDEF_SUMMARY_TERMINATOR_TLV             (0xFEU)
+#define NDEF_SUMMARY_RECORD_HEADER              (0xD1U) ///< Message begin and end, short record, well-known type
+#define NDEF_SUMMARY_TEXT_STATUS                (NDEF_SUMMARY_LANGUAGE_LENGTH) ///< UTF-8, the language code length
+
+#define NDEF_SUMMARY_DECI_MAX                   (999)   ///< Temperatures are displayed within ±99.9°C
+#define NDEF_SUMMARY_SECONDS_PER_DAY            (86400)
+
+_Static_assert(NDEF_SUMMARY_RECORD_LENGTH < 0xFF, "NDEF message doesn't fit the TLV one byte length");
+_Static_assert(NDEF_SUMMARY_PAYLOAD_LENGTH <= 0xFF, "Text record doesn't fit the short record");
+_Static_assert(NDEF_SUMMARY_SIZE <= NDEF_SUMMARY_EEPROM_SIZE, "NDEF summary doesn't fit the EEPROM");
+
+typedef struct {
+  char *position;
+} NDEF_SUMMARY_Writer_t;
+
+static bool isMaterialChange(const NDEF_SUMMARY_Values_t *values, const NDEF_SUMMARY_Values_t *rendered);
+static void renderHeaders(uint8_t *image);
+static void renderText(const NDEF_SUMMARY_Values_t *values, char *text);
+static void writeText(NDEF_SUMMARY_Writer_t *writer, const char *text);
+static void writeDigits(NDEF_SUMMARY_Writer_t *writer, uint32_t value, uint8_t width);
+static void writeTemperature(NDEF_SUMMARY_Writer_t *writer, int16_t temperature, bool isKnown);
+static void writeDate(NDEF_SUMMARY_Writer_t *writer, int32_t timestamp);
+static int32_t toDeciCelsius(int16_t temperature);
+static uint32_t roundedDivide(uint32_t value, uint32_t divisor);
+static uint32_t absDifference(int32_t a, int32_t b);
+
+void NDEF_SUMMARY_Init(NDEF_SUMMARY_t *summary) {
+  memset(summary, 0, sizeof(*summary));
+}
+
+/**
+ * @brief Accumulates the sample, the EEPROM isn't touched
+ */
+void NDEF_SUMMARY_Update(NDEF_SUMMARY_t *summary, const NDEF_SUMMARY_Sample_t *sample) {
+  NDEF_SUMMARY_Values_t *values = &summary->values;
+
+  values->timestamp = sample->timestamp;
+  values->samplesCount++;
+
+  if (sample->isClimateValid) {
+    values->temperature = sample->temperature;
+    values->humidity = sample->humidity;
+    values->minTemperature = (!values->hasClimate || sample->temperature < values->minTemperature) ? sample->temperature : values->minTemperature;
+    values->maxTemperature = (!values->hasClimate || sample->temperature > values->maxTemperature) ? sample->temperature : values->maxTemperature;
+    values->hasClimate = true;
+
+    if (sample->temperature > NDEF_SUMMARY_TEMPERATURE_HIGH_LIMIT) values->alarms |= NDEF_SUMMARY_ALARM_HIGH_TEMPERATURE;
+    if (sample->temperature < NDEF_SUMMARY_TEMPERATURE_LOW_LIMIT) values->alarms |= NDEF_SUMMARY_ALARM_LOW_TEMPERATURE;
+  }
+
+  if (sample->isLuxValid) {
+    values->lux = sample->lux;
+  }
+
+  if (!sample->isComplete) {
+    values->alarms |= NDEF_SUMMARY_ALARM_SENSOR_FAULT;
+  }
+}
+
+/**
+ * @brief Renders the accumulated values to the image on a material change, the first call always renders
+ * @return true if the image is rendered again
+ */
+bool NDEF_SUMMARY_Render(NDEF_SUMMARY_t *summary) {
+  if (summary->isRendered && !isMaterialChange(&summary->values, &summary->rendered)) return false;
+
+  renderHeaders(summary->image);
+  renderText(&summary->values, (char *) &summary->image[NDEF_SUMMARY_TEXT_OFFSET]);
+
+  summary->rendered = summary->values;
+  summary->isRendered = true;
+
+  return true;
+}
+
+/**
+ * @brief Finds the first run of the consecutive EEPROM blocks the image differs from the EEPROM in,
+ * one I2C write for the run
+ *
+ * @param[out] offset Run offset within the area
+ * @param[out] length Run length, whole blocks
+ * @return false if the EEPROM is up to date
+ */
+bool NDEF_SUMMARY_NextChangedBlocks(const NDEF_SUMMARY_t *summary, uint16_t *offset, uint16_t *length) {
+  uint16_t block = 0;
+
+  while (block < NDEF_SUMMARY_SIZE && memcmp(&summary->image[block], &summary->eeprom[block], NDEF_SUMMARY_EEPROM_BLOCK_SIZE) == 0) {
+    block += NDEF_SUMMARY_EEPROM_BLOCK_SIZE;
+  }
+
+  if (block == NDEF_SUMMARY_SIZE) return false;
+
+  *offset = block;
+
+  while (block < NDEF_SUMMARY_SIZE && memcmp(&summary->image[block], &summary->eeprom[block], NDEF_SUMMARY_EEPROM_BLOCK_SIZE) != 0) {
+    block += NDEF_SUMMARY_EEPROM_BLOCK_SIZE;
+  }
+
+  *length = block - *offset;
+
+  return true;
+}
+
+/**
+ * @brief The run of the image is written to the EEPROM
+ */
+void NDEF_SUMMARY_MarkWritten(NDEF_SUMMARY_t *summary, uint16_t offset, uint16_t length) {
+  memcpy(&summary->eeprom[offset], &summary->image[offset], length);
+}
+
+static bool isMaterialChange(const NDEF_SUMMARY_Values_t *values, const NDEF_SUMMARY_Values_t *rendered) {
+  if (values->alarms != rendered->alarms || values->hasClimate != rendered->hasClimate) return true;
+
+  // min and max only widen, every displayed step of them is rendered
+  if (toDeciCelsius(values->minTemperature) != toDeciCelsius(rendered->minTemperature) ||
+      toDeciCelsius(values->maxTemperature) != toDeciCelsius(rendered->maxTemperature)) return true;
+
+  if (absDifference(values->temperature, rendered->temperature) >= NDEF_SUMMARY_TEMPERATURE_DEADBAND) return true;
+  if (absDifference(values->humidity, rendered->humidity) >= NDEF_SUMMARY_HUMIDITY_DEADBAND) return true;
+
+  uint32_t luxDeadband = rendered->lux / 100U * NDEF_SUMMARY_LUX_DEADBAND_PERCENT;
+  luxDeadband = (luxDeadband < NDEF_SUMMARY_LUX_DEADBAND_MIN) ? NDEF_SUMMARY_LUX_DEADBAND_MIN : luxDeadband;
+  if (absDifference((int32_t) values->lux, (int32_t) rendered->lux) >= luxDeadband) return true;
+
+  return values->samplesCount != rendered->samplesCount && values->timestamp - rendered->timestamp >= NDEF_SUMMARY_HEARTBEAT_S;
+}
+
+/**
+ * @brief Capability Container, NDEF message TLV with the Text record headers, terminator TLV
+ */
+static void renderHeaders(uint8_t *image) {
+  const uint8_t headers[NDEF_SUMMARY_TEXT_OFFSET] = {
+    NDEF_SUMMARY_CC_MAGIC, NDEF_SUMMARY_CC_VERSION_ACCESS, NDEF_SUMMARY_EEPROM_SIZE / 8U, 0x00,
+    NDEF_SUMMARY_NDEF_MESSAGE_TLV, NDEF_SUMMARY_RECORD_LENGTH,
+    NDEF_SUMMARY_RECORD_HEADER, 1U, NDEF_SUMMARY_PAYLOAD_LENGTH, 'T',
+    NDEF_SUMMARY_TEXT_STATUS, NDEF_SUMMARY_LANGUAGE[0], NDEF_SUMMARY_LANGUAGE[1],
+  };
+
+  memcpy(image, headers, sizeof(headers));
+  memset(&image[NDEF_SUMMARY_TEXT_OFFSET + NDEF_SUMMARY_TEXT_LENGTH], 0x00, NDEF_SUMMARY_SIZE - NDEF_SUMMARY_TEXT_OFFSET - NDEF_SUMMARY_TEXT_LENGTH);
+  image[NDEF_SUMMARY_USED_SIZE - 1U] = NDEF_SUMMARY_TERMINATOR_TLV;
+}
+
+/**
+ * @brief Fixed-width text, NDEF_SUMMARY_TEXT_LENGTH characters without the terminating zero
+ */
+static void renderText(const NDEF_SUMMARY_Values_t *values, char *text) {
+  NDEF_SUMMARY_Writer_t writer = {.position = text};
+  const uint8_t alarms = values->alarms;
+
+  writeText(&writer, "IoT Risk Logger: ");
+  writeText(&writer, (alarms != 0) ? "ALARM" : "OK   ");
+
+  writeText(&writer, "\nT ");
+  writeTemperature(&writer, values->temperature, values->hasClimate);
+  writeText(&writer, "C RH ");
+  writeDigits(&writer, roundedDivide(values->humidity, 100U), 3);
+  writeText(&writer, "% ");
+  writeDigits(&writer, roundedDivide(values->lux, 100U), 5);
+  writeText(&writer, "lx");
+
+  writeText(&writer, "\nTmin ");
+  writeTemperature(&writer, values->minTemperature, values->hasClimate);
+  writeText(&writer, "C Tmax ");
+  writeTemperature(&writer, values->maxTemperature, values->hasClimate);
+  writeText(&writer, "C");
+
+  writeText(&writer, "\nAlarms ");
+  *writer.position++ = (alarms & NDEF_SUMMARY_ALARM_HIGH_TEMPERATURE) ? 'H' : '-';
+  *writer.position++ = (alarms & NDEF_SUMMARY_ALARM_LOW_TEMPERATURE) ? 'L' : '-';
+  *writer.position++ = (alarms & NDEF_SUMMARY_ALARM_SENSOR_FAULT) ? 'S' : '-';
+  writeText(&writer, ", ");
+  writeDigits(&writer, values->samplesCount, 7);
+  writeText(&writer, " samples");
+
+  writeText(&writer, "\nUpdated ");
+  writeDate(&writer, values->timestamp);
+  writeText(&writer, " UTC");
+}
+
+static void writeText(NDEF_SUMMARY_Writer_t *writer, const char *text) {
+  const size_t length = strlen(text);
+
+  memcpy(writer->position, text, length);
+  writer->position += length;
+}
+
+/**
+ * @brief Zero padded decimal, saturated to the width
+ */
+static void writeDigits(NDEF_SUMMARY_Writer_t *writer, uint32_t value, uint8_t width) {
+  uint32_t max = 1;
+
+  for (uint8_t i = 0; i < width; i++) max *= 10U;
+  value = (value < max) ? value : max - 1U;
+
+  for (uint8_t i = width; i > 0; i--) {
+    writer->position[i - 1] = (char) ('0' + value % 10U);
+    value /= 10U;
+  }
+
+  writer->position += width;
+}
+
+/**
+ * @brief "+04.0", "-12.5" or " --.-" before the first climate reading
+ */
+static void writeTemperature(NDEF_SUMMARY_Writer_t *writer, int16_t temperature, bool isKnown) {
+  if (!isKnown) {
+    writeText(writer, " --.-");
+    return;
+  }
+
+  const int32_t deci = toDeciCelsius(temperature);
+  const uint32_t magnitude = (uint32_t) ((deci < 0) ? -deci : deci);
+
+  *writer->position++ = (deci < 0) ? '-' : '+';
+  writeDigits(writer, magnitude / 10U, 2);
+  *writer->position++ = '.';
+  writeDigits(writer, magnitude % 10U, 1);
+}
+
+/**
+ * @brief "YYYY-MM-DD hh:mm" of the UNIX timestamp
+ * @see http://howardhinnant.github.io/date_algorithms.html#civil_from_days
+ */
+static void writeDate(NDEF_SUMMARY_Writer_t *writer, int32_t timestamp) {
+  const uint32_t seconds = (uint32_t) ((timestamp > 0) ? timestamp : 0);
+  const uint32_t days = seconds / NDEF_SUMMARY_SECONDS_PER_DAY + 719468U; // days from 0000-03-01
+  const uint32_t secondsOfDay = seconds % NDEF_SUMMARY_SECONDS_PER_DAY;
+  const uint32_t era = days / 146097U;
+  const uint32_t dayOfEra = days - era * 146097U;
+  const uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460U + dayOfEra / 36524U - dayOfEra / 146096U) / 365U;
+  const uint32_t dayOfYear = dayOfEra - (365U * yearOfEra + yearOfEra / 4U - yearOfEra / 100U);
+  const uint32_t shiftedMonth = (5U * dayOfYear + 2U) / 153U; // from March
+  const uint32_t day = dayOfYear - (153U * shiftedMonth + 2U) / 5U + 1U;
+  const uint32_t month = (shiftedMonth < 10U) ? shiftedMonth + 3U : shiftedMonth - 9U;
+  const uint32_t year = yearOfEra + era * 400U + ((month <= 2U) ? 1U : 0U);
+
+  writeDigits(writer, year, 4);
+  *writer->position++ = '-';
+  writeDigits(writer, month, 2);
+  *writer->position++ = '-';
+  writeDigits(writer, day, 2);
+  *writer->position++ = ' ';
+  writeDigits(writer, secondsOfDay / 3600U, 2);
+  *writer->position++ = ':';
+  writeDigits(writer, secondsOfDay % 3600U / 60U, 2);
+}
+
+/**
+ * @brief Rounded half away from zero and clamped to the displayed range
+ */
+static int32_t toDeciCelsius(int16_t temperature) {
+  const int32_t deci = (temperature >= 0) ? (temperature + 5) / 10 : (temperature - 5) / 10;
+
+  if (deci > NDEF_SUMMARY_DECI_MAX) return NDEF_SUMMARY_DECI_MAX;
+  if (deci < -NDEF_SUMMARY_DECI_MAX) return -NDEF_SUMMARY_DECI_MAX;
+
+  return deci;
+}
+
+static uint32_t roundedDivide(uint32_t value, uint32_t divisor) {
+  return (value + divisor / 2U) / divisor;
+}
+
+static uint32_t absDifference(int32_t a, int32_t b) {
+  return (uint32_t) ((a > b) ? a - b : b - a);
+}
@@ -0,0 +1,114 @@
+/*!
+ * @file ndef_summary.h
+ * @brief Summary of the logging as an NDEF Text record in the ST25DV user EEPROM, read by any phone without the MCU
+ *
+ * The area starts at the EEPROM address 0: the NFC Forum Type 5 Capability Container, the NDEF message TLV with one
+ * well-known Text record and the terminator TLV. The text is fixed-width, so a refresh never moves the bytes around:
+ * a changed value rewrites the 4 bytes EEPROM blocks of its characters only, and the headers are written once.
+ *
+ *   IoT Risk Logger: ALARM
+ *   T +04.0C RH 082% 00012lx
+ *   Tmin +01.5C Tmax +09.2C
+ *   Alarms HL-, 0000240 samples
+ *   Updated 2026-10-18 09:42 UTC
+ *
+ * Every sample is accumulated, but the image is rendered again only on a material change: the alarms, the displayed
+ * min/max, the last reading beyond the deadbands or the heartbeat. The last reading and the samples count lag the
+ * device by up to the deadbands and the heartbeat period.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#ifndef NDEF_SUMMARY_H
+#define NDEF_SUMMARY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define NDEF_SUMMARY_EEPROM_ADDR                (0x0000U) ///< Capability Container has to be at the EEPROM start
+#define NDEF_SUMMARY_EEPROM_BLOCK_SIZE          (4U)      ///< Unit of the EEPROM write cycle
+#define NDEF_SUMMARY_EEPROM_SIZE                (512U)    ///< ST25DV04K user memory, declared in the Capability Container
+
+#define NDEF_SUMMARY_TEXT_LENGTH                (128U)
+#define NDEF_SUMMARY_LANGUAGE                   "en"
+#define NDEF_SUMMARY_LANGUAGE_LENGTH            (2U)
+#define NDEF_SUMMARY_PAYLOAD_LENGTH             (1U + NDEF_SUMMARY_LANGUAGE_LENGTH + NDEF_SUMMARY_TEXT_LENGTH)
+#define NDEF_SUMMARY_RECORD_LENGTH              (4U + NDEF_SUMMARY_PAYLOAD_LENGTH) ///< Short record header and the "T" type
+#define NDEF_SUMMARY_CC_SIZE                    (4U)
+#define NDEF_SUMMARY_TEXT_OFFSET                (NDEF_SUMMARY_CC_SIZE + 2U + 4U + 1U + NDEF_SUMMARY_LANGUAGE_LENGTH)
+#define NDEF_SUMMARY_USED_SIZE                  (NDEF_SUMMARY_CC_SIZE + 2U + NDEF_SUMMARY_RECORD_LENGTH + 1U)
+#define NDEF_SUMMARY_SIZE                       ((NDEF_SUMMARY_USED_SIZE + NDEF_SUMMARY_EEPROM_BLOCK_SIZE - 1U) / NDEF_SUMMARY_EEPROM_BLOCK_SIZE * NDEF_SUMMARY_EEPROM_BLOCK_SIZE)
+
+/**
+ * Material change of the last reading, as the cron deadbands
+ */
+#define NDEF_SUMMARY_TEMPERATURE_DEADBAND       (50)      ///< 0.5°C
+#define NDEF_SUMMARY_HUMIDITY_DEADBAND          (200U)    ///< 2%RH
+#define NDEF_SUMMARY_LUX_DEADBAND_PERCENT       (25U)
+#define NDEF_SUMMARY_LUX_DEADBAND_MIN           (1000U)   ///< 10lux, the dark readings don't flicker the summary
+#define NDEF_SUMMARY_HEARTBEAT_S                (3600)    ///< Samples count and the update time are refreshed at least this often
+
+/**
+ * Cold chain limits, as the cron ones
+ */
+#define NDEF_SUMMARY_TEMPERATURE_LOW_LIMIT      (200)     ///< 2°C
+#define NDEF_SUMMARY_TEMPERATURE_HIGH_LIMIT     (800)     ///< 8°C
+
+/**
+ * @brief Alarm flags, latched since the boot
+ */
+typedef enum {
+  NDEF_SUMMARY_ALARM_HIGH_TEMPERATURE = 0x01,
+  NDEF_SUMMARY_ALARM_LOW_TEMPERATURE = 0x02,
+  NDEF_SUMMARY_ALARM_SENSOR_FAULT = 0x04, ///< A sensor wasn't read
+} NDEF_SUMMARY_Alarm_t;
+
+/**
+ * @brief Measurement frame values, in the conversions.h units
+ */
+typedef struct {
+  int32_t timestamp;
+  int16_t temperature; ///< 0.01°C
+  uint16_t humidity; ///< 0.01%RH
+  uint32_t lux; ///< 0.01lux
+  bool isClimateValid; ///< Temperature and humidity are read
+  bool isLuxValid;
+  bool isComplete; ///< All the sensors are read
+} NDEF_SUMMARY_Sample_t;
+
+typedef struct {
+  int32_t timestamp; ///< Of the last sample, 0 before the first one
+  int16_t temperature;
+  uint16_t humidity;
+  uint32_t lux;
+  int16_t minTemperature;
+  int16_t maxTemperature;
+  uint8_t alarms; ///< NDEF_SUMMARY_Alarm_t flags
+  uint32_t samplesCount;
+  bool hasClimate;
+} NDEF_SUMMARY_Values_t;
+
+typedef struct {
+  NDEF_SUMMARY_Values_t values; ///< Up to the last sample
+  NDEF_SUMMARY_Values_t rendered; ///< In the image
+  bool isRendered;
+  uint8_t image[NDEF_SUMMARY_SIZE]; ///< Area to be written
+  uint8_t eeprom[NDEF_SUMMARY_SIZE]; ///< Area as written to the EEPROM
+} NDEF_SUMMARY_t;
+
+void NDEF_SUMMARY_Init(NDEF_SUMMARY_t *summary);
+void NDEF_SUMMARY_Update(NDEF_SUMMARY_t *summary, const NDEF_SUMMARY_Sample_t *sample);
+bool NDEF_SUMMARY_Render(NDEF_SUMMARY_t *summary);
+bool NDEF_SUMMARY_NextChangedBlocks(const NDEF_SUMMARY_t *summary, uint16_t *offset, uint16_t *length);
+void NDEF_SUMMARY_MarkWritten(NDEF_SUMMARY_t *summary, uint16_t offset, uint16_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //NDEF_SUMMARY_H
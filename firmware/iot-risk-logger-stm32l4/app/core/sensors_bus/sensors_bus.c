@@ -1,8 +1,14 @@
 /*!
  * @file sensors_bus.c
- * @brief Implementation of thread-safe I2C sensor bus access layer
+ * @brief Implementation of the asynchronous I2C sensor bus access layer
  *
- * Provides thread-safe access to I2C sensor devices using mutex protection.
+ * The queue is a bounded multi-producer/multi-consumer ring (per-slot sequence numbers, LDREX/STREX atomics):
+ * tasks enqueue and try to start the bus, the I2C1 completion interrupt starts the next transaction.
+ * The bus ownership is a single atomic state, whoever claims it dequeues and starts the transfer.
+ *
+ * A hung transfer (e.g. a slave holding SDA low) is recovered after SENSORS_BUS_TRANSACTION_TIMEOUT_MS by the waiting
+ * thread or SensorsBus_RecoverStalled(): the bus is taken over from the transfer, the slave is clocked out of its
+ * byte, the peripheral is re-initialized and the transaction fails with BSP_ERROR_BUS_FAILURE.
  *
  * @date 18/08/2024
  * @author artempolisskyi
@@ -10,82 +16,445 @@
 
 #include "sensors_bus.h"
 
-extern osMutexId_t i2c1MutexHandle;
+#define SENSORS_BUS_QUEUE_MASK (SENSORS_BUS_QUEUE_SIZE - 1)
+
+_Static_assert(SENSORS_BUS_QUEUE_SIZE == 8, "Update the queue slots initializer");
+
+/**
+ * @brief Bus ownership, the stall check acts on ACTIVE only: its tick is stored before the state is published
+ */
+typedef enum {
+  SENSORS_BUS_IDLE = 0,
+  SENSORS_BUS_CLAIMED,    ///< Claimed, the start tick isn't stored yet
+  SENSORS_BUS_ACTIVE,     ///< Transaction is on the bus since activeTransactionTick
+  SENSORS_BUS_RECOVERING, ///< Taken over from the stalled transfer, the late interrupts are ignored
+} SensorsBus_State_t;
+
+typedef struct {
+  volatile uint32_t sequence;             ///< Position the slot is free (== position) or filled (== position + 1) for
+  SensorsBus_Transaction_t transaction;
+} SensorsBus_QueueSlot_t;
+
+extern I2C_HandleTypeDef hi2c1;
+extern actor_t* ACTORS_LOOKUP_SystemRegistry[MAX_ACTORS];
+
+static bool enqueueTransaction(const SensorsBus_Transaction_t *transaction);
+static bool dequeueTransaction(SensorsBus_Transaction_t *transaction);
+static bool hasQueuedTransaction(void);
+static bool claimBus(void);
+static void releaseBus(void);
+static void startNextTransaction(void);
+static HAL_StatusTypeDef startTransfer(SensorsBus_Transaction_t *transaction);
+static void completeActiveTransaction(int32_t status);
+static void clearBus(void);
+static void delayHalfPeriod(void);
+static bool hasFreeSlot(void);
+static void waitForFreeSlot(void);
+static void notifySlotWaiters(void);
+static int32_t transact(SensorsBus_Operation_t operation, uint16_t devAddr, uint16_t reg, uint8_t *pData, uint16_t length);
+static int32_t transactPolling(SensorsBus_Operation_t operation, uint16_t devAddr, uint16_t reg, uint8_t *pData, uint16_t length);
+
+static SensorsBus_QueueSlot_t transactionsQueue[SENSORS_BUS_QUEUE_SIZE] = {
+  {.sequence = 0}, {.sequence = 1}, {.sequence = 2}, {.sequence = 3},
+  {.sequence = 4}, {.sequence = 5}, {.sequence = 6}, {.sequence = 7},
+};
+static volatile uint32_t enqueuePosition = 0;
+static volatile uint32_t dequeuePosition = 0;
+
+static volatile uint32_t busState = SENSORS_BUS_IDLE;
+static SensorsBus_Transaction_t activeTransaction;
+static volatile uint32_t activeTransactionTick = 0;
+
+static osThreadId_t slotWaiters[SENSORS_BUS_SLOT_WAITERS_COUNT];
+
+/**
+ * @brief Queues the transaction and starts it if the bus is idle
+ *
+ * @note Safe to call from tasks and interrupts
+ * @return BSP_ERROR_NONE or BSP_ERROR_BUSY if the queue is full
+ */
+int32_t SensorsBus_Submit(const SensorsBus_Transaction_t *transaction) {
+  if (transaction == NULL || transaction->pData == NULL) return BSP_ERROR_WRONG_PARAM;
+
+  if (!enqueueTransaction(transaction)) return BSP_ERROR_BUSY;
+
+  startNextTransaction();
+
+  return BSP_ERROR_NONE;
+}
 
 int32_t SensorsBus_WriteReg(uint16_t Addr, uint16_t Reg, uint8_t *pData, uint16_t Length) {
-  int32_t ret;
+  return transact(SENSORS_BUS_WRITE_REG, Addr, Reg, pData, Length);
+}
 
-  if (osMutexAcquire(i2c1MutexHandle, osWaitForever) == osOK) {
-    ret = BSP_I2C1_WriteReg(Addr, Reg, pData, Length);
-    osMutexRelease(i2c1MutexHandle);
-  } else {
-    ret = BSP_ERROR_BUSY; // or another appropriate error code
+int32_t SensorsBus_ReadReg(uint16_t Addr, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+  return transact(SENSORS_BUS_READ_REG, Addr, Reg, pData, Length);
+}
+
+int32_t SensorsBus_WriteReg16(uint16_t Addr, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+  return transact(SENSORS_BUS_WRITE_REG16, Addr, Reg, pData, Length);
+}
+
+int32_t SensorsBus_ReadReg16(uint16_t Addr, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+  return transact(SENSORS_BUS_READ_REG16, Addr, Reg, pData, Length);
+}
+
+int32_t SensorsBus_Send(uint16_t DevAddr, uint8_t *pData, uint16_t Length) {
+  return transact(SENSORS_BUS_SEND, DevAddr, 0, pData, Length);
+}
+
+int32_t SensorsBus_Recv(uint16_t DevAddr, uint8_t *pData, uint16_t Length) {
+  return transact(SENSORS_BUS_RECV, DevAddr, 0, pData, Length);
+}
+
+/**
+ * @brief Submits the transaction and sleeps until it's done
+ *
+ * Falls back to the polling transfer before the scheduler start. The full queue (e.g. an acquisition batch) is waited
+ * for a free slot. Every wait timeout recovers the stalled transaction at the queue head, so the wait ends after
+ * at most SENSORS_BUS_QUEUE_SIZE + 1 timeouts.
+ */
+static int32_t transact(SensorsBus_Operation_t operation, uint16_t devAddr, uint16_t reg, uint8_t *pData, uint16_t length) {
+  if (osKernelGetState() != osKernelRunning) return transactPolling(operation, devAddr, reg, pData, length);
+
+  volatile int32_t status = BSP_ERROR_BUSY;
+
+  osThreadFlagsClear(SENSORS_BUS_COMPLETION_THREAD_FLAG);
+
+  const SensorsBus_Transaction_t transaction = {
+    .operation = operation,
+    .devAddr = devAddr,
+    .reg = reg,
+    .pData = pData,
+    .length = length,
+    .actorId = NO_ACTOR_ID,
+    .threadId = osThreadGetId(),
+    .pStatus = &status,
+  };
+
+  int32_t submitStatus;
+
+  // every started transaction frees a slot, the stalled transaction is recovered meanwhile
+  while ((submitStatus = SensorsBus_Submit(&transaction)) == BSP_ERROR_BUSY) {
+    waitForFreeSlot();
   }
 
-  return ret;
+  if (submitStatus != BSP_ERROR_NONE) return submitStatus;
+
+  for (;;) {
+    uint32_t flags = osThreadFlagsWait(SENSORS_BUS_COMPLETION_THREAD_FLAG, osFlagsWaitAny, SENSORS_BUS_TRANSACTION_TIMEOUT_MS);
+
+    if ((flags & osFlagsError) == 0) return status;
+
+    SensorsBus_RecoverStalled();
+  }
 }
 
-int32_t SensorsBus_ReadReg(uint16_t Addr, uint16_t Reg, uint8_t *pData, uint16_t Length) {
-  int32_t ret;
+/**
+ * @brief Sleeps until a slot is freed or SENSORS_BUS_TRANSACTION_TIMEOUT_MS passes, the timeout recovers the stall
+ *
+ * The flag is cleared after the registration and the queue is re-checked after the clear, so the slot freed
+ * in between isn't missed. Without a free waiter entry the thread just sleeps for the timeout.
+ */
+static void waitForFreeSlot(void) {
+  osThreadId_t threadId = osThreadGetId();
+  osThreadId_t *entry = NULL;
 
-  if (osMutexAcquire(i2c1MutexHandle, osWaitForever) == osOK) {
-    ret = BSP_I2C1_ReadReg(Addr, Reg, pData, Length);
-    osMutexRelease(i2c1MutexHandle);
-  } else {
-    ret = BSP_ERROR_BUSY; // or another appropriate error code
+  for (uint8_t i = 0; i < SENSORS_BUS_SLOT_WAITERS_COUNT && entry == NULL; i++) {
+    osThreadId_t expected = NULL;
+
+    if (__atomic_compare_exchange_n(&slotWaiters[i], &expected, threadId, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+      entry = &slotWaiters[i];
+    }
   }
 
-  return ret;
+  osThreadFlagsClear(SENSORS_BUS_SLOT_FREE_THREAD_FLAG);
+
+  if (!hasFreeSlot()) {
+    uint32_t flags = osThreadFlagsWait(SENSORS_BUS_SLOT_FREE_THREAD_FLAG, osFlagsWaitAny, SENSORS_BUS_TRANSACTION_TIMEOUT_MS);
+
+    if (flags & osFlagsError) SensorsBus_RecoverStalled();
+  }
+
+  if (entry != NULL) __atomic_store_n(entry, NULL, __ATOMIC_RELEASE);
 }
 
-int32_t SensorsBus_WriteReg16(uint16_t Addr, uint16_t Reg, uint8_t *pData, uint16_t Length) {
-  int32_t ret;
+/**
+ * @brief Wakes up the blocking callers waiting for a slot, called when a transaction leaves the queue
+ */
+static void notifySlotWaiters(void) {
+  for (uint8_t i = 0; i < SENSORS_BUS_SLOT_WAITERS_COUNT; i++) {
+    osThreadId_t threadId = __atomic_load_n(&slotWaiters[i], __ATOMIC_ACQUIRE);
 
-  if (osMutexAcquire(i2c1MutexHandle, osWaitForever) == osOK) {
-    ret = BSP_I2C1_WriteReg16(Addr, Reg, pData, Length);
-    osMutexRelease(i2c1MutexHandle);
-  } else {
-    ret = BSP_ERROR_BUSY; // or another appropriate error code
+    if (threadId != NULL) osThreadFlagsSet(threadId, SENSORS_BUS_SLOT_FREE_THREAD_FLAG);
   }
+}
 
-  return ret;
+static int32_t transactPolling(SensorsBus_Operation_t operation, uint16_t devAddr, uint16_t reg, uint8_t *pData, uint16_t length) {
+  switch (operation) {
+    case SENSORS_BUS_WRITE_REG:   return BSP_I2C1_WriteReg(devAddr, reg, pData, length);
+    case SENSORS_BUS_READ_REG:    return BSP_I2C1_ReadReg(devAddr, reg, pData, length);
+    case SENSORS_BUS_WRITE_REG16: return BSP_I2C1_WriteReg16(devAddr, reg, pData, length);
+    case SENSORS_BUS_READ_REG16:  return BSP_I2C1_ReadReg16(devAddr, reg, pData, length);
+    case SENSORS_BUS_SEND:        return BSP_I2C1_Send(devAddr, pData, length);
+    case SENSORS_BUS_RECV:        return BSP_I2C1_Recv(devAddr, pData, length);
+    default:                      return BSP_ERROR_WRONG_PARAM;
+  }
 }
 
-int32_t SensorsBus_ReadReg16(uint16_t Addr, uint16_t Reg, uint8_t *pData, uint16_t Length) {
-  int32_t ret;
+static bool enqueueTransaction(const SensorsBus_Transaction_t *transaction) {
+  uint32_t position = __atomic_load_n(&enqueuePosition, __ATOMIC_RELAXED);
+
+  for (;;) {
+    SensorsBus_QueueSlot_t *slot = &transactionsQueue[position & SENSORS_BUS_QUEUE_MASK];
+    int32_t distance = (int32_t) (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) - position);
+
+    if (distance < 0) return false; // full
 
-  if (osMutexAcquire(i2c1MutexHandle, osWaitForever) == osOK) {
-    ret = BSP_I2C1_ReadReg16(Addr, Reg, pData, Length);
-    osMutexRelease(i2c1MutexHandle);
-  } else {
-    ret = BSP_ERROR_BUSY; // or another appropriate error code
+    if (distance > 0) {
+      position = __atomic_load_n(&enqueuePosition, __ATOMIC_RELAXED);
+      continue;
+    }
+
+    // on failure the position is reloaded, retry with it
+    if (__atomic_compare_exchange_n(&enqueuePosition, &position, position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+      slot->transaction = *transaction;
+      __atomic_store_n(&slot->sequence, position + 1, __ATOMIC_RELEASE);
+      return true;
+    }
   }
+}
+
+static bool dequeueTransaction(SensorsBus_Transaction_t *transaction) {
+  uint32_t position = __atomic_load_n(&dequeuePosition, __ATOMIC_RELAXED);
+
+  for (;;) {
+    SensorsBus_QueueSlot_t *slot = &transactionsQueue[position & SENSORS_BUS_QUEUE_MASK];
+    int32_t distance = (int32_t) (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) - (position + 1));
 
-  return ret;
+    if (distance < 0) return false; // empty or the slot is not published yet
+
+    if (distance > 0) {
+      position = __atomic_load_n(&dequeuePosition, __ATOMIC_RELAXED);
+      continue;
+    }
+
+    if (__atomic_compare_exchange_n(&dequeuePosition, &position, position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+      *transaction = slot->transaction;
+      __atomic_store_n(&slot->sequence, position + SENSORS_BUS_QUEUE_SIZE, __ATOMIC_RELEASE);
+      return true;
+    }
+  }
 }
 
-int32_t SensorsBus_Send(uint16_t DevAddr, uint8_t *pData, uint16_t Length) {
-  int32_t ret;
+static bool hasFreeSlot(void) {
+  uint32_t position = __atomic_load_n(&enqueuePosition, __ATOMIC_RELAXED);
 
-  if (osMutexAcquire(i2c1MutexHandle, osWaitForever) == osOK) {
-    ret = BSP_I2C1_Send(DevAddr, pData, Length);
-    osMutexRelease(i2c1MutexHandle);
-  } else {
-    ret = BSP_ERROR_BUSY; // or another appropriate error code
+  return (int32_t) (__atomic_load_n(&transactionsQueue[position & SENSORS_BUS_QUEUE_MASK].sequence, __ATOMIC_ACQUIRE) - position) >= 0;
+}
+
+static bool hasQueuedTransaction(void) {
+  uint32_t position = __atomic_load_n(&dequeuePosition, __ATOMIC_RELAXED);
+
+  return __atomic_load_n(&transactionsQueue[position & SENSORS_BUS_QUEUE_MASK].sequence, __ATOMIC_ACQUIRE) == position + 1;
+}
+
+/**
+ * @brief Claims the idle bus, stores the transaction start tick as a part of the claim
+ */
+static bool claimBus(void) {
+  uint32_t state = SENSORS_BUS_IDLE;
+
+  if (!__atomic_compare_exchange_n(&busState, &state, SENSORS_BUS_CLAIMED, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) return false;
+
+  activeTransactionTick = osKernelGetTickCount();
+  __atomic_store_n(&busState, SENSORS_BUS_ACTIVE, __ATOMIC_RELEASE);
+
+  return true;
+}
+
+static void releaseBus(void) {
+  __atomic_store_n(&busState, SENSORS_BUS_IDLE, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Starts the queued transaction if the bus is idle
+ *
+ * The queue is re-checked after the bus release, so a transaction published meanwhile by the other
+ * context is not left behind.
+ */
+static void startNextTransaction(void) {
+  while (claimBus()) {
+    if (!dequeueTransaction(&activeTransaction)) {
+      releaseBus();
+
+      if (!hasQueuedTransaction()) return;
+
+      continue;
+    }
+
+    notifySlotWaiters();
+
+    if (startTransfer(&activeTransaction) == HAL_OK) return;
+
+    completeActiveTransaction(BSP_ERROR_PERIPH_FAILURE);
   }
+}
 
-  return ret;
+static HAL_StatusTypeDef startTransfer(SensorsBus_Transaction_t *transaction) {
+  switch (transaction->operation) {
+    case SENSORS_BUS_WRITE_REG:
+      return HAL_I2C_Mem_Write_IT(&hi2c1, transaction->devAddr, transaction->reg, I2C_MEMADD_SIZE_8BIT, transaction->pData, transaction->length);
+    case SENSORS_BUS_READ_REG:
+      return HAL_I2C_Mem_Read_IT(&hi2c1, transaction->devAddr, transaction->reg, I2C_MEMADD_SIZE_8BIT, transaction->pData, transaction->length);
+    case SENSORS_BUS_WRITE_REG16:
+      return HAL_I2C_Mem_Write_IT(&hi2c1, transaction->devAddr, transaction->reg, I2C_MEMADD_SIZE_16BIT, transaction->pData, transaction->length);
+    case SENSORS_BUS_READ_REG16:
+      return HAL_I2C_Mem_Read_IT(&hi2c1, transaction->devAddr, transaction->reg, I2C_MEMADD_SIZE_16BIT, transaction->pData, transaction->length);
+    case SENSORS_BUS_SEND:
+      return HAL_I2C_Master_Transmit_IT(&hi2c1, transaction->devAddr, transaction->pData, transaction->length);
+    case SENSORS_BUS_RECV:
+      return HAL_I2C_Master_Receive_IT(&hi2c1, transaction->devAddr, transaction->pData, transaction->length);
+    default:
+      return HAL_ERROR;
+  }
 }
 
-int32_t SensorsBus_Recv(uint16_t DevAddr, uint8_t *pData, uint16_t Length) {
-  int32_t ret;
+/**
+ * @brief Releases the bus and notifies the requester of the active transaction
+ */
+static void completeActiveTransaction(int32_t status) {
+  SensorsBus_Transaction_t transaction = activeTransaction;
+
+  releaseBus();
+
+  if (transaction.actorId != NO_ACTOR_ID) {
+    actor_t *actor = ACTORS_LOOKUP_SystemRegistry[transaction.actorId];
+
+    if (actor != NULL && actor->osMessageQueueId != NULL) {
+      osMessageQueuePut(actor->osMessageQueueId, &(message_t){transaction.completionEvent, .payload.value = (uint32_t) status}, 0, 0);
+    }
+    return;
+  }
+
+  if (transaction.threadId != NULL) {
+    *transaction.pStatus = status;
+    osThreadFlagsSet(transaction.threadId, SENSORS_BUS_COMPLETION_THREAD_FLAG);
+  }
+}
+
+/**
+ * @brief Clears the bus, re-initializes the I2C peripheral and fails the active transaction if it takes too long
+ *
+ * Only the take over of the bus is in the critical section, the recovery runs with the bus claimed
+ * (RECOVERING): no transaction is started and the late completion interrupt is ignored meanwhile.
+ * The asynchronous submitters call it on their own timeout (e.g. the acquisition batch), the blocking callers
+ * on the wait timeout. No-op if the bus isn't stalled.
+ *
+ * @note Call from a thread. I2C1 interrupts priority is within configMAX_SYSCALL_INTERRUPT_PRIORITY,
+ * the critical section masks them
+ */
+void SensorsBus_RecoverStalled(void) {
+  taskENTER_CRITICAL();
+
+  bool isStalled = (__atomic_load_n(&busState, __ATOMIC_ACQUIRE) == SENSORS_BUS_ACTIVE)
+    && (osKernelGetTickCount() - activeTransactionTick) >= pdMS_TO_TICKS(SENSORS_BUS_TRANSACTION_TIMEOUT_MS);
+
+  if (isStalled) __atomic_store_n(&busState, SENSORS_BUS_RECOVERING, __ATOMIC_RELAXED);
+
+  taskEXIT_CRITICAL();
+
+  if (!isStalled) return;
+
+  HAL_I2C_DeInit(&hi2c1);
+  clearBus();
+  HAL_I2C_Init(&hi2c1);
+  HAL_I2CEx_ConfigAnalogFilter(&hi2c1, I2C_ANALOGFILTER_ENABLE);
+
+  completeActiveTransaction(BSP_ERROR_BUS_FAILURE);
+  startNextTransaction();
+}
 
-  if (osMutexAcquire(i2c1MutexHandle, osWaitForever) == osOK) {
-    ret = BSP_I2C1_Recv(DevAddr, pData, Length);
-    osMutexRelease(i2c1MutexHandle);
-  } else {
-    ret = BSP_ERROR_BUSY; // or another appropriate error code
+/**
+ * @brief Frees SDA held low by a slave stopped in the middle of a byte: the pulses clock the rest of the byte and
+ * its ACK out, then the STOP resets the slaves' bus logic. The peripheral reset alone doesn't touch the slave.
+ *
+ * The pins are driven as open-drain GPIOs and returned to I2C1 afterwards, the peripheral is disabled meanwhile.
+ */
+static void clearBus(void) {
+  GPIO_InitTypeDef gpioInit = {
+    .Mode = GPIO_MODE_OUTPUT_OD,
+    .Pull = GPIO_NOPULL,
+    .Speed = GPIO_SPEED_FREQ_VERY_HIGH,
+  };
+
+  HAL_GPIO_WritePin(BUS_I2C1_SCL_GPIO_PORT, BUS_I2C1_SCL_GPIO_PIN, GPIO_PIN_SET);
+  HAL_GPIO_WritePin(BUS_I2C1_SDA_GPIO_PORT, BUS_I2C1_SDA_GPIO_PIN, GPIO_PIN_SET);
+  gpioInit.Pin = BUS_I2C1_SCL_GPIO_PIN;
+  HAL_GPIO_Init(BUS_I2C1_SCL_GPIO_PORT, &gpioInit);
+  gpioInit.Pin = BUS_I2C1_SDA_GPIO_PIN;
+  HAL_GPIO_Init(BUS_I2C1_SDA_GPIO_PORT, &gpioInit);
+
+  for (uint8_t pulse = 0; pulse < SENSORS_BUS_CLEAR_PULSES; pulse++) {
+    HAL_GPIO_WritePin(BUS_I2C1_SCL_GPIO_PORT, BUS_I2C1_SCL_GPIO_PIN, GPIO_PIN_RESET);
+    delayHalfPeriod();
+    HAL_GPIO_WritePin(BUS_I2C1_SCL_GPIO_PORT, BUS_I2C1_SCL_GPIO_PIN, GPIO_PIN_SET);
+    delayHalfPeriod();
   }
 
-  return ret;
-}
\ No newline at end of file
+  // STOP: SDA rises while SCL is high
+  HAL_GPIO_WritePin(BUS_I2C1_SCL_GPIO_PORT, BUS_I2C1_SCL_GPIO_PIN, GPIO_PIN_RESET);
+  HAL_GPIO_WritePin(BUS_I2C1_SDA_GPIO_PORT, BUS_I2C1_SDA_GPIO_PIN, GPIO_PIN_RESET);
+  delayHalfPeriod();
+  HAL_GPIO_WritePin(BUS_I2C1_SCL_GPIO_PORT, BUS_I2C1_SCL_GPIO_PIN, GPIO_PIN_SET);
+  delayHalfPeriod();
+  HAL_GPIO_WritePin(BUS_I2C1_SDA_GPIO_PORT, BUS_I2C1_SDA_GPIO_PIN, GPIO_PIN_SET);
+  delayHalfPeriod();
+
+  gpioInit.Mode = GPIO_MODE_AF_OD;
+  gpioInit.Pin = BUS_I2C1_SCL_GPIO_PIN;
+  gpioInit.Alternate = BUS_I2C1_SCL_GPIO_AF;
+  HAL_GPIO_Init(BUS_I2C1_SCL_GPIO_PORT, &gpioInit);
+  gpioInit.Pin = BUS_I2C1_SDA_GPIO_PIN;
+  gpioInit.Alternate = BUS_I2C1_SDA_GPIO_AF;
+  HAL_GPIO_Init(BUS_I2C1_SDA_GPIO_PORT, &gpioInit);
+}
+
+/**
+ * @brief Busy wait of about SENSORS_BUS_CLEAR_HALF_PERIOD_US, the loop takes 4 cycles or more per iteration
+ */
+static void delayHalfPeriod(void) {
+  for (volatile uint32_t count = (SystemCoreClock / 4000000U) * SENSORS_BUS_CLEAR_HALF_PERIOD_US; count > 0; count--) {
+  }
+}
+
+static void completeFromInterrupt(I2C_HandleTypeDef *hi2c, int32_t status) {
+  if (hi2c != &hi2c1 || __atomic_load_n(&busState, __ATOMIC_ACQUIRE) != SENSORS_BUS_ACTIVE) return;
+
+  completeActiveTransaction(status);
+  startNextTransaction();
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+  completeFromInterrupt(hi2c, BSP_ERROR_NONE);
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+  completeFromInterrupt(hi2c, BSP_ERROR_NONE);
+}
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+  completeFromInterrupt(hi2c, BSP_ERROR_NONE);
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+  completeFromInterrupt(hi2c, BSP_ERROR_NONE);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+  int32_t status = (HAL_I2C_GetError(hi2c) & HAL_I2C_ERROR_AF)
+    ? BSP_ERROR_BUS_ACKNOWLEDGE_FAILURE
+    : BSP_ERROR_PERIPH_FAILURE;
+
+  completeFromInterrupt(hi2c, status);
+}
@@ -1,8 +1,19 @@
 /*!
  * @file sensors_bus.h
- * @brief Thread-safe I2C bus access layer for sensor communication.
+ * @brief Asynchronous I2C bus access layer for sensor communication.
  *
- * Detailed description of the file.
+ * Callers submit transaction descriptors to a lock-free queue. Transactions are executed one by one by the
+ * I2C1 interrupt driven transfers, the next transaction is started from the completion interrupt.
+ * Completion is posted to the requesting actor as its event with the BSP status in the payload value,
+ * so the actor's thread (and the CPU) is free while the bytes are on the bus.
+ *
+ * The blocking SensorsBus_* functions (drivers IO) are built on top of the queue: the caller thread sleeps
+ * on a thread flag until its transaction is done, on the full queue it sleeps on another flag until a slot is freed.
+ * There is no bus mutex, hence no priority inversion between the sensors and NFC tasks, transactions are served in
+ * the submission order.
+ *
+ * A transfer hung for SENSORS_BUS_TRANSACTION_TIMEOUT_MS is failed with BSP_ERROR_BUS_FAILURE and the bus is cleared:
+ * by the blocking callers on their wait timeouts, by the asynchronous submitters with SensorsBus_RecoverStalled().
  *
  * @date 18/08/2024
  * @author artempolisskyi
@@ -16,10 +27,51 @@ extern "C" {
 #endif
 
 #include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
 
 #include "custom_bus.h"
 #include "cmsis_os2.h"
 #include "FreeRTOS.h"
+#include "task.h"
+#include "actor.h"
+
+#define SENSORS_BUS_QUEUE_SIZE                (8)           // power of 2, a batch of 6 fits, the blocking callers wait for a free slot
+#define SENSORS_BUS_COMPLETION_THREAD_FLAG    (0x00010000U) // set on the blocking caller thread
+#define SENSORS_BUS_SLOT_FREE_THREAD_FLAG     (0x00020000U) // set on the blocking callers waiting for a queue slot
+#define SENSORS_BUS_SLOT_WAITERS_COUNT        (4)           // sensors and NFC tasks, the others wait for the timeout
+#define SENSORS_BUS_TRANSACTION_TIMEOUT_MS    (25)          // longest transfer is the 256B NFC mailbox at 400kHz, ~7ms
+#define SENSORS_BUS_CLEAR_PULSES              (9)           // a byte and its ACK, the slave holding SDA low lets it go
+#define SENSORS_BUS_CLEAR_HALF_PERIOD_US      (5)           // 100kHz, the slaves take any slower clock
+
+typedef enum {
+  SENSORS_BUS_WRITE_REG = 0,
+  SENSORS_BUS_READ_REG,
+  SENSORS_BUS_WRITE_REG16,
+  SENSORS_BUS_READ_REG16,
+  SENSORS_BUS_SEND,
+  SENSORS_BUS_RECV,
+} SensorsBus_Operation_t;
+
+/**
+ * @brief I2C transaction descriptor
+ *
+ * @note The descriptor is copied into the queue, the data buffer must stay valid until the completion.
+ */
+typedef struct {
+  SensorsBus_Operation_t operation;
+  uint16_t devAddr;           ///< 8-bit device address as for the BSP_I2C1_* functions
+  uint16_t reg;               ///< Register address, ignored by SEND/RECV
+  uint8_t *pData;             ///< Data to write or buffer to read into
+  uint16_t length;            ///< Data length
+  ACTOR_ID actorId;           ///< Actor to post the completion event to, NO_ACTOR_ID to notify the thread instead
+  event_t completionEvent;    ///< Event posted to the actor with the BSP status in the payload value
+  osThreadId_t threadId;      ///< Thread to set SENSORS_BUS_COMPLETION_THREAD_FLAG on, if no actor is set
+  volatile int32_t *pStatus;  ///< BSP status of the thread notified transaction
+} SensorsBus_Transaction_t;
+
+int32_t SensorsBus_Submit(const SensorsBus_Transaction_t *transaction);
+void SensorsBus_RecoverStalled(void);
 
 int32_t SensorsBus_WriteReg(uint16_t Addr, uint16_t Reg, uint8_t *pData, uint16_t Length);
 int32_t SensorsBus_ReadReg(uint16_t Addr, uint16_t Reg, uint8_t *pData, uint16_t Length);
@@ -32,4 +84,4 @@ int32_t SensorsBus_Recv(uint16_t DevAddr, uint8_t *pData, uint16_t Length);
 }
 #endif
 
-#endif //SENSORS_BUS_H
\ No newline at end of file
+#endif //SENSORS_BUS_H
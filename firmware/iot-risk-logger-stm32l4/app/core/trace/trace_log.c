@@ -0,0 +1,59 @@
+/*!
+ * @file trace_log.c
+ * @brief implementation of the deferred binary trace log
+ *
+ * The RTT up-buffer works in the non-blocking skip mode: a record which doesn't fit is dropped as a whole,
+ * so the ring always contains complete records. Dropped records are visible on the host as sequence gaps.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#include "trace_log.h"
+#include "stm32l4xx_hal.h"
+#include "SEGGER_RTT.h"
+
+#define TRACE_LOG_HEADER_WORDS (2)
+
+static uint8_t traceLogBuffer[TRACE_LOG_BUFFER_SIZE];
+static uint8_t traceLogSequence = 0;
+static uint32_t traceLogDroppedCount = 0;
+
+/**
+ * @brief Configures the trace RTT up-buffer, should be called after SEGGER_RTT_Init()
+ */
+void TRACE_LOG_Init(void) {
+  SEGGER_RTT_ConfigUpBuffer(TRACE_LOG_RTT_CHANNEL, "TraceLog", traceLogBuffer, sizeof(traceLogBuffer), SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+}
+
+/**
+ * @brief Writes the binary record, safe to call from tasks and ISRs
+ *
+ * @param[in] formatId Offset of the format string in the .trace_fmt section
+ * @param[in] args Arguments array
+ * @param[in] argsCount Arguments count, at most TRACE_LOG_MAX_ARGS
+ */
+void TRACE_LOG_Write(uint32_t formatId, const uint32_t *args, uint8_t argsCount) {
+  uint32_t record[TRACE_LOG_HEADER_WORDS + TRACE_LOG_MAX_ARGS];
+
+  for (uint8_t i = 0; i < argsCount; i++) {
+    record[TRACE_LOG_HEADER_WORDS + i] = args[i];
+  }
+  // HAL tick (ms) is valid in ISRs and before the scheduler start, unlike the kernel tick
+  record[1] = HAL_GetTick();
+
+  SEGGER_RTT_LOCK();
+
+  record[0] = (formatId & 0xFFFF) | ((uint32_t) argsCount << 16) | ((uint32_t) traceLogSequence++ << 24);
+
+  uint32_t recordSize = (TRACE_LOG_HEADER_WORDS + argsCount) * sizeof(uint32_t);
+  if (SEGGER_RTT_WriteNoLock(TRACE_LOG_RTT_CHANNEL, record, recordSize) != recordSize) {
+    traceLogDroppedCount++;
+  }
+
+  SEGGER_RTT_UNLOCK();
+}
+
+uint32_t TRACE_LOG_GetDroppedCount(void) {
+  return traceLogDroppedCount;
+}
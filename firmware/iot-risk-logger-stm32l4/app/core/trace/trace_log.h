@@ -0,0 +1,69 @@
+/*!
+ * @file trace_log.h
+ * @brief Deferred binary trace log
+ *
+ * TRACE_LOG() doesn't format anything on the target: it records the format string ID, the HAL tick and
+ * up to TRACE_LOG_MAX_ARGS 32-bit arguments as a compact binary record into a dedicated RTT up-buffer (RAM ring).
+ * Format strings are placed in the `.trace_fmt` section which is not loaded to Flash (see the linker script),
+ * the string offset in the section is the record's format ID.
+ * `scripts/decode_trace_log.py` rebuilds the text from the captured records and the firmware ELF.
+ *
+ * Record layout (little-endian):
+ * | format ID (u16) | args count (u8) | sequence (u8) | HAL tick, ms (u32) | args (u32 × args count) |
+ *
+ * @note Arguments are stored as uint32_t, so only integer conversions are supported (no %s, %f),
+ * string constants should be a part of the format, e.g. TO_STATE() stringifies the state into the format.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#ifndef TRACE_LOG_H
+#define TRACE_LOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define TRACE_LOG_RTT_CHANNEL   (2)     ///< 0 is stdout, 1 is SystemView
+#define TRACE_LOG_BUFFER_SIZE   (1024)
+#define TRACE_LOG_MAX_ARGS      (8)
+
+#define TRACE_LOG_FORMAT_SECTION __attribute__((section(".trace_fmt"), used))
+
+#define TRACE_LOG_ARGS_COUNT(...) TRACE_LOG_ARGS_COUNT_(_, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define TRACE_LOG_ARGS_COUNT_(_, a1, a2, a3, a4, a5, a6, a7, a8, count, ...) count
+
+#if defined(UNIT_TEST) && defined(TRACE_LOG_QUIET)
+/** @brief Host harnesses running millions of transitions, the arguments are still type checked */
+#define TRACE_LOG(format, ...) do { if (0) fprintf(stdout, format, ##__VA_ARGS__); } while (0)
+#elif defined(UNIT_TEST)
+/** @brief Host builds have no ELF decoding step, print the text directly */
+#define TRACE_LOG(format, ...) fprintf(stdout, format, ##__VA_ARGS__)
+#else
+/**
+ * @brief Records the trace with up to TRACE_LOG_MAX_ARGS integer arguments
+ *
+ * @example
+ * TRACE_LOG("IMU: FIFO WTM, %u samples pending\n", fifoLevel);
+ */
+#define TRACE_LOG(format, ...)                                                                                   \
+  do {                                                                                                           \
+    static const char traceLogFormat[] TRACE_LOG_FORMAT_SECTION = format;                                        \
+    const uint32_t traceLogArgs[TRACE_LOG_MAX_ARGS + 1] = {0, ##__VA_ARGS__};                                    \
+    TRACE_LOG_Write((uint32_t) (uintptr_t) traceLogFormat, &traceLogArgs[1], TRACE_LOG_ARGS_COUNT(__VA_ARGS__)); \
+  } while (0)
+#endif
+
+void TRACE_LOG_Init(void);
+void TRACE_LOG_Write(uint32_t formatId, const uint32_t *args, uint8_t argsCount);
+uint32_t TRACE_LOG_GetDroppedCount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TRACE_LOG_H
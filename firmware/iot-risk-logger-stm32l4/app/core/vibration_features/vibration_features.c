@@ -0,0 +1,203 @@
+/*!
+ * @file vibration_features.c
+ * @brief implementation of the fixed-point vibration features
+ *
+ * Samples are deinterleaved into per-axis arrays first (the magnitude is computed in the same pass), then
+ * every axis is reduced two samples per instruction: __SMLAD sums the pair, __QSUB16 removes the mean from
+ * both halves with saturation and __SMLALD accumulates both squares into a 64 bit sum (32 full scale squares
+ * overflow 32 bits).
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#include <string.h>
+
+#include "vibration_features.h"
+
+static inline int16_t saturateQ15(int32_t value);
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "cmsis_compiler.h"
+#else
+/** @brief Portable fallbacks, bit-exact with the Cortex-M4 instructions */
+static inline uint32_t __SMLAD(uint32_t op1, uint32_t op2, uint32_t op3) {
+  int64_t product = (int64_t) (int16_t) op1 * (int16_t) op2 + (int64_t) (int16_t) (op1 >> 16) * (int16_t) (op2 >> 16);
+
+  return op3 + (uint32_t) product;
+}
+
+static inline uint64_t __SMLALD(uint32_t op1, uint32_t op2, uint64_t acc) {
+  int64_t product = (int64_t) (int16_t) op1 * (int16_t) op2 + (int64_t) (int16_t) (op1 >> 16) * (int16_t) (op2 >> 16);
+
+  return acc + (uint64_t) product;
+}
+
+static inline uint32_t __QSUB16(uint32_t op1, uint32_t op2) {
+  uint16_t low = (uint16_t) saturateQ15((int16_t) op1 - (int16_t) op2);
+  uint16_t high = (uint16_t) saturateQ15((int16_t) (op1 >> 16) - (int16_t) (op2 >> 16));
+
+  return ((uint32_t) high << 16) | low;
+}
+
+#define __PKHBT(ARG1, ARG2, ARG3) ((((uint32_t) (ARG1)) & 0x0000FFFFUL) | ((((uint32_t) (ARG2)) << (ARG3)) & 0xFFFF0000UL))
+#endif
+
+#define VIBRATION_ONES_PAIR (0x00010001UL) // __SMLAD multiplier to sum a pair
+
+static void extractAxisFeatures(const int16_t *axis, uint8_t samplesCount, uint8_t axisIndex, VIBRATION_Features_t *features);
+static uint32_t readPair(const int16_t *samples);
+static uint16_t squareRoot(uint32_t value);
+
+// per-axis copies of the window, static to keep them off the caller's stack
+static int16_t axisSamples[VIBRATION_AXES_COUNT][VIBRATION_MAX_SAMPLES];
+
+/**
+ * @brief Extracts the features of the window
+ *
+ * @param[in] samples Interleaved X, Y, Z Q15 samples, as read from the LIS2DW12 FIFO
+ * @param[in] samplesCount Number of XYZ samples, clamped to VIBRATION_MAX_SAMPLES
+ * @param[out] features Window features, zeroed for the empty window
+ * @note Not reentrant, uses the static per-axis buffers
+ */
+void VIBRATION_ExtractFeatures(const int16_t *samples, uint8_t samplesCount, VIBRATION_Features_t *features) {
+  uint32_t magnitudeSquareMax = 0;
+
+  memset(features, 0, sizeof(*features));
+
+  if (samplesCount == 0) return;
+  if (samplesCount > VIBRATION_MAX_SAMPLES) samplesCount = VIBRATION_MAX_SAMPLES;
+
+  for (uint8_t i = 0; i < samplesCount; i++) {
+    const int16_t *sample = &samples[i * VIBRATION_AXES_COUNT];
+
+    axisSamples[0][i] = sample[0];
+    axisSamples[1][i] = sample[1];
+    axisSamples[2][i] = sample[2];
+
+    // x² + y² + z² is below 2^32, the modulo 2^32 accumulation of __SMLAD is exact for it
+    uint32_t xy = __PKHBT(sample[0], sample[1], 16);
+    uint32_t magnitudeSquare = __SMLAD(xy, xy, (uint32_t) (sample[2] * sample[2]));
+
+    if (magnitudeSquare > magnitudeSquareMax) magnitudeSquareMax = magnitudeSquare;
+  }
+
+  features->magnitudeMax = squareRoot(magnitudeSquareMax);
+
+  for (uint8_t axis = 0; axis < VIBRATION_AXES_COUNT; axis++) {
+    extractAxisFeatures(axisSamples[axis], samplesCount, axis, features);
+  }
+}
+
+/**
+ * @brief Reduces the features to the log entry summary, saturated to 8 bits
+ */
+void VIBRATION_Summarize(const VIBRATION_Features_t *features, VIBRATION_Summary_t *summary) {
+  uint16_t rmsMax = 0;
+  uint16_t peakToPeakMax = 0;
+  uint8_t dominantAxis = 0;
+
+  for (uint8_t axis = 0; axis < VIBRATION_AXES_COUNT; axis++) {
+    if (features->rms[axis] > rmsMax) {
+      rmsMax = features->rms[axis];
+      dominantAxis = axis;
+    }
+    if (features->peakToPeak[axis] > peakToPeakMax) peakToPeakMax = features->peakToPeak[axis];
+  }
+
+  uint16_t magnitude = features->magnitudeMax >> VIBRATION_SUMMARY_SHIFT;
+
+  summary->rms = (uint8_t) (rmsMax >> VIBRATION_SUMMARY_SHIFT);
+  summary->peakToPeak = (uint8_t) (peakToPeakMax >> VIBRATION_SUMMARY_SHIFT);
+  summary->magnitudeMax = (magnitude > UINT8_MAX) ? UINT8_MAX : (uint8_t) magnitude;
+  summary->zeroCrossings = features->zeroCrossings[dominantAxis];
+}
+
+static void extractAxisFeatures(const int16_t *axis, uint8_t samplesCount, uint8_t axisIndex, VIBRATION_Features_t *features) {
+  uint8_t i;
+
+  // 1) mean, two samples per __SMLAD
+  uint32_t sum = 0;
+  for (i = 0; i + 1 < samplesCount; i += 2) {
+    sum = __SMLAD(readPair(&axis[i]), VIBRATION_ONES_PAIR, sum);
+  }
+  if (i < samplesCount) sum += (uint32_t) (int32_t) axis[i];
+
+  int16_t mean = (int16_t) ((int32_t) sum / samplesCount);
+
+  // 2) squares of the saturated deviations from the mean
+  uint32_t meanPair = __PKHBT(mean, mean, 16);
+  uint64_t squaresSum = 0;
+  for (i = 0; i + 1 < samplesCount; i += 2) {
+    uint32_t deviation = __QSUB16(readPair(&axis[i]), meanPair);
+    squaresSum = __SMLALD(deviation, deviation, squaresSum);
+  }
+  if (i < samplesCount) {
+    int32_t deviation = saturateQ15(axis[i] - mean);
+    squaresSum += (uint64_t) (deviation * deviation);
+  }
+
+  // 3) range and mean crossings, the side changes only out of the hysteresis band
+  int16_t min = axis[0];
+  int16_t max = axis[0];
+  int8_t side = 0;
+  uint8_t crossings = 0;
+  for (i = 0; i < samplesCount; i++) {
+    int32_t deviation = axis[i] - mean;
+
+    if (axis[i] < min) min = axis[i];
+    if (axis[i] > max) max = axis[i];
+
+    if (deviation > VIBRATION_ZERO_CROSSING_HYSTERESIS) {
+      if (side < 0) crossings++;
+      side = 1;
+    } else if (deviation < -VIBRATION_ZERO_CROSSING_HYSTERESIS) {
+      if (side > 0) crossings++;
+      side = -1;
+    }
+  }
+
+  features->mean[axisIndex] = mean;
+  features->rms[axisIndex] = squareRoot((uint32_t) (squaresSum / samplesCount));
+  features->peakToPeak[axisIndex] = (uint16_t) (max - min);
+  features->zeroCrossings[axisIndex] = crossings;
+}
+
+/**
+ * @brief Loads two adjacent samples into one word, compiles to a single (unaligned) LDR on the target
+ */
+static uint32_t readPair(const int16_t *samples) {
+  uint32_t pair;
+  memcpy(&pair, samples, sizeof(pair));
+
+  return pair;
+}
+
+static inline int16_t saturateQ15(int32_t value) {
+  if (value > INT16_MAX) return INT16_MAX;
+  if (value < INT16_MIN) return INT16_MIN;
+
+  return (int16_t) value;
+}
+
+/**
+ * @brief Integer square root, rounded down, one result bit per iteration
+ */
+static uint16_t squareRoot(uint32_t value) {
+  uint32_t root = 0;
+  uint32_t bit = 1UL << 30;
+
+  while (bit > value) bit >>= 2;
+
+  while (bit != 0) {
+    if (value >= root + bit) {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+
+  return (uint16_t) root;
+}
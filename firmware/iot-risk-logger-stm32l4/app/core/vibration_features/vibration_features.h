@@ -0,0 +1,55 @@
+/*!
+ * @file vibration_features.h
+ * @brief Fixed-point vibration features of an accelerometer FIFO window
+ *
+ * LIS2DW12 raw samples are left-aligned 16 bit words, so they are used as Q15 fractions of the full scale as is.
+ * Per axis: mean, RMS around the mean, peak-to-peak and mean crossings (the dominant frequency estimate is
+ * `crossings × ODR / (2 × samples)`), for the whole window: the max vector magnitude.
+ *
+ * The kernels run on the Cortex-M4 DSP extension (__SMLAD, __SMLALD, __QSUB16, __PKHBT), the host builds
+ * (UNIT_TEST) use bit-exact portable fallbacks of the same intrinsics.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#ifndef VIBRATION_FEATURES_H
+#define VIBRATION_FEATURES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define VIBRATION_AXES_COUNT                  (3)
+#define VIBRATION_MAX_SAMPLES                 (32)  // LIS2DW12 FIFO depth
+#define VIBRATION_ZERO_CROSSING_HYSTERESIS    (256) // Q15, ~16mg at ±2g, noise around the mean is not a crossing
+#define VIBRATION_SUMMARY_SHIFT               (8)   // Q15 to the 8 bit log summary, ~16mg/LSB at ±2g
+
+typedef struct {
+  int16_t mean[VIBRATION_AXES_COUNT]; ///< Q15
+  uint16_t rms[VIBRATION_AXES_COUNT]; ///< RMS around the mean, Q15
+  uint16_t peakToPeak[VIBRATION_AXES_COUNT]; ///< Q15, up to twice the full scale
+  uint8_t zeroCrossings[VIBRATION_AXES_COUNT]; ///< Mean crossings with VIBRATION_ZERO_CROSSING_HYSTERESIS
+  uint16_t magnitudeMax; ///< Max vector magnitude over the window, Q15, up to √3 of the full scale
+} VIBRATION_Features_t;
+
+/**
+ * @brief 4 bytes summary of the window stored in the log entry
+ */
+typedef struct __attribute__((packed)) {
+  uint8_t rms; ///< Max axis RMS
+  uint8_t peakToPeak; ///< Max axis peak-to-peak
+  uint8_t magnitudeMax; ///< Max vector magnitude
+  uint8_t zeroCrossings; ///< Mean crossings of the axis with the max RMS
+} VIBRATION_Summary_t;
+
+void VIBRATION_ExtractFeatures(const int16_t *samples, uint8_t samplesCount, VIBRATION_Features_t *features);
+void VIBRATION_Summarize(const VIBRATION_Features_t *features, VIBRATION_Summary_t *summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //VIBRATION_FEATURES_H
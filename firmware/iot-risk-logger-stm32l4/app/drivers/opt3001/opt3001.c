@@ -9,6 +9,7 @@
  */
 
 #include "opt3001.h"
+#include "conversions.h"
 
 OPT3001_IO_t OPT3001_IO = {
     .i2cAddress = 0x00,
@@ -34,6 +35,9 @@ OPT3001_RESULT OPT3001_ReadDeviceID(uint16_t *id) {
     return OPT3001_OK;
 }
 
+/**
+ * @brief Reads the config register, releases the latched INT pin
+ */
 OPT3001_RESULT OPT3001_ReadConfig(uint16_t *config) {
     uint8_t configData[OPT3001_REGISTER_SIZE];
     int32_t transferResult = OPT3001_IO.readReg(OPT3001_IO.i2cAddress, OPT3001_CONFIG_REG, configData, OPT3001_REGISTER_SIZE);
@@ -60,6 +64,14 @@ OPT3001_RESULT OPT3001_WriteHighLimit(uint16_t highLimitRawLux) {
   return OPT3001_IO.writeReg(OPT3001_IO.i2cAddress, OPT3001_LIMIT_HIGH_REG, highLimitData, OPT3001_REGISTER_SIZE);
 }
 
+/**
+ * @brief Asserts the INT pin on every conversion end instead of the limits crossing
+ * @note Restore the low limit with OPT3001_WriteLowLimit() to get back to the limits interrupt
+ */
+OPT3001_RESULT OPT3001_EnableEndOfConversionInterrupt(void) {
+  return OPT3001_WriteLowLimit(OPT3001_LIMIT_LOW_END_OF_CONVERSION);
+}
+
 OPT3001_RESULT OPT3001_ReadResultRawLux(uint16_t *rawLux) {
     uint8_t rawLuxData[OPT3001_REGISTER_SIZE];
     int32_t transferResult = OPT3001_IO.readReg(OPT3001_IO.i2cAddress, OPT3001_RESULT_REG, rawLuxData, OPT3001_REGISTER_SIZE);
@@ -72,16 +84,14 @@ OPT3001_RESULT OPT3001_ReadResultRawLux(uint16_t *rawLux) {
 }
 
 /**
- * @brief Convert raw lux value to milli lux
+ * @brief Convert raw lux value to centi lux
  *
- * @note the formula is lux = (2^LE[3:0]) * TL[11:0] where LE is the exponent and TL is the mantissa
+ * @note the formula is lux = 0.01 * (2^LE[3:0]) * TL[11:0] where LE is the exponent and TL is the mantissa,
+ * the result is in the 0.01 lux units of the formula, see CONVERT_OPT3001RawToCentiLux()
  *
  * @param[in] rawLux raw data from sensor
- * @return milli lux
+ * @return centi lux
  */
-uint32_t OPT3001_RawToMilliLux(uint16_t rawLux) {
-  uint32_t exponent = OPT3001_REG_EXPONENT(rawLux) & 0x0F;
-  uint32_t mantissa = OPT3001_REG_MANTISSA(rawLux);
-
-  return ((1 << exponent) * mantissa);
+uint32_t OPT3001_RawToCentiLux(uint16_t rawLux) {
+  return CONVERT_OPT3001RawToCentiLux(rawLux);
 }
\ No newline at end of file
@@ -17,13 +17,15 @@ extern "C" {
 
 #include <stdio.h>
 
-#include "main.h"
+#include <stdint.h>
 
 #define OPT3001_I2C_ADDR_45 (0x45)
 
 /**
  * @brief Config Conversion time
+ * 100ms conversion trades resolution for 8 times shorter sensor on-time
  */
+#define OPT3001_CONFIG_CONVERSION_TIME_100_MS   (0x0000)
 #define OPT3001_CONFIG_CONVERSION_TIME_800_MS   (0x0800)
 
 /**
@@ -52,6 +54,13 @@ extern "C" {
 #define OPT3001_CONFIG_FAULT_COUNT_4            (0x0002)
 #define OPT3001_CONFIG_FAULT_COUNT_8            (0x0003)
 
+/**
+ * @brief Config read-only flags, reading the config register releases the latched INT pin
+ */
+#define OPT3001_CONFIG_CONVERSION_READY_FLAG    (0x0080)
+#define OPT3001_CONFIG_FLAG_HIGH                (0x0040)
+#define OPT3001_CONFIG_FLAG_LOW                 (0x0020)
+
 #define OPT3001_CONFIG_DEFAULT                  (OPT3001_CONFIG_RANGE_NUMBER_AUTO_SCALE | \
                                                  OPT3001_CONFIG_CONVERSION_TIME_800_MS  | \
                                                  OPT3001_CONFIG_MODE_SHUTDOWN           | \
@@ -61,6 +70,12 @@ extern "C" {
 #define OPT3001_CONFIG_LIMIT_MAX                (0xFFFF)
 #define OPT3001_CONFIG_LIMIT_MIN                (0x0000)
 
+/**
+ * @brief Low limit exponent LE[3:2] = 11b switches the INT pin to the end-of-conversion mode:
+ * the pin is asserted after every conversion, the latch should be enabled.
+ */
+#define OPT3001_LIMIT_LOW_END_OF_CONVERSION     (0xC000)
+
 /**
 * @brief  OPT3001 Light Sensor registers addresses.
 */
@@ -107,8 +122,9 @@ OPT3001_RESULT OPT3001_WriteConfig(uint16_t config);
 OPT3001_RESULT OPT3001_ReadConfig(uint16_t *config);
 OPT3001_RESULT OPT3001_WriteLowLimit(uint16_t lowLimitRawLux);
 OPT3001_RESULT OPT3001_WriteHighLimit(uint16_t highLimitRawLux);
+OPT3001_RESULT OPT3001_EnableEndOfConversionInterrupt(void);
 OPT3001_RESULT OPT3001_ReadResultRawLux(uint16_t *rawLux);
-uint32_t OPT3001_RawToMilliLux(uint16_t rawLux);
+uint32_t OPT3001_RawToCentiLux(uint16_t rawLux);
 
 #ifdef __cplusplus
 }
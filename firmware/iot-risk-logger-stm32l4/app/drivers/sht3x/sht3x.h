@@ -56,6 +56,13 @@ extern "C" {
 
 #define SHT3x_CMD_SIZE                                                          (2)
 #define SHT3x_SERIAL_NUMBER_SIZE                                                (6)
+#define SHT3x_MEASUREMENTS_SIZE                                                 (6)   ///< temperature and humidity words with their CRC
+
+#define SHT3x_IDLE_TIME_MS                                                      (1)   ///< tIDLE, time to respond to the read header after a command
+#define SHT3x_RESET_TIME_MS                                                     (10)  ///< time to be ready after the hard reset
+#define SHT3x_SINGLE_SHOT_LOW_REPEATABILITY_TIME_MS                             (5)   ///< max single-shot conversion time, 4.5ms
+#define SHT3x_SINGLE_SHOT_MEDIUM_REPEATABILITY_TIME_MS                          (7)   ///< max single-shot conversion time, 6.5ms
+#define SHT3x_SINGLE_SHOT_HIGH_REPEATABILITY_TIME_MS                            (16)  ///< max single-shot conversion time, 15.5ms
 
 /**
 * @brief  SHT3x Temperature & Humidity Sensor status enumerator definition.
@@ -84,11 +91,16 @@ typedef struct {
 
 SHT3x_RESULT SHT3x_InitIO(uint8_t i2cAddress, SHT3x_Write_Func write, SHT3x_Read_Func read, SHT3x_DelayMs_Func delayMs, SHT3x_CRC8_Func crc8);
 SHT3x_RESULT SHT3x_ReadDeviceID(uint32_t *id);
+SHT3x_RESULT SHT3x_RequestDeviceID(void);
+SHT3x_RESULT SHT3x_FetchDeviceID(uint32_t *id);
 SHT3x_RESULT SHT3x_ReadStatus(uint16_t *status);
 SHT3x_RESULT SHT3x_ClearStatus(void);
 SHT3x_RESULT SHT3x_SingleShotAcquisitionMode(uint16_t modeCondition);
+SHT3x_RESULT SHT3x_FetchSingleShotMeasurements(int16_t *rawTemperature, uint16_t *rawHumidity);
+SHT3x_RESULT SHT3x_ReadPipelinedMeasurements(uint16_t modeCondition, int16_t *rawTemperature, uint16_t *rawHumidity);
 SHT3x_RESULT SHT3x_PeriodicAcquisitionMode(uint16_t modeCondition);
 SHT3x_RESULT SHT3x_ReadMeasurements(int16_t *rawTemperature, uint16_t *rawHumidity);
+SHT3x_RESULT SHT3x_ParseMeasurements(const uint8_t *data, int16_t *rawTemperature, uint16_t *rawHumidity);
 SHT3x_RESULT SHT3x_WriteLimit(uint16_t limitType, uint16_t *limit);
 SHT3x_RESULT SHT3x_ReadLimit(uint16_t limitType, uint16_t *limit);
 SHT3x_RESULT SHT3x_HardReset(void);
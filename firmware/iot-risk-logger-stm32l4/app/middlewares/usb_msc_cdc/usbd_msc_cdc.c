@@ -0,0 +1,347 @@
+/*!
+ * @file usbd_msc_cdc.c
+ * @brief implementation of the MSC + CDC-ACM composite USB class
+ *
+ * @see USB Class Definitions for Communications Devices 1.2 and its PSTN subclass, the ACM model
+ * @see USB Interface Association Descriptor ECN
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#include <string.h>
+
+#include "usbd_msc_cdc.h"
+#include "usbd_ctlreq.h"
+
+#define CDC_SET_LINE_CODING                 (0x20U)
+#define CDC_GET_LINE_CODING                 (0x21U)
+#define CDC_SET_CONTROL_LINE_STATE          (0x22U)
+#define CDC_SEND_BREAK                      (0x23U)
+#define CDC_LINE_CODING_SIZE                (7U)
+#define CDC_CONTROL_LINE_DTR                (0x01U)
+
+static uint8_t init(USBD_HandleTypeDef *pdev, uint8_t cfgidx);
+static uint8_t deInit(USBD_HandleTypeDef *pdev, uint8_t cfgidx);
+static uint8_t setup(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req);
+static uint8_t ep0RxReady(USBD_HandleTypeDef *pdev);
+static uint8_t dataIn(USBD_HandleTypeDef *pdev, uint8_t epnum);
+static uint8_t dataOut(USBD_HandleTypeDef *pdev, uint8_t epnum);
+static uint8_t *getFSConfigDescriptor(uint16_t *length);
+static uint8_t *getDeviceQualifierDescriptor(uint16_t *length);
+static uint8_t *getDeviceDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t setupCDC(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req);
+static bool isMSCRequest(const USBD_SetupReqTypedef *req);
+
+/**
+ * @brief CDC function state, the MSC class keeps its own in the class data
+ */
+typedef struct {
+  const USBD_MSC_CDC_Callbacks_t *callbacks;
+  uint8_t lineCoding[CDC_LINE_CODING_SIZE]; ///< As set by the host, only echoed back
+  uint8_t pendingRequest; ///< Class request waiting for its EP0 data
+  volatile bool isTransmitting;
+  bool isPortOpen;
+  uint8_t rxPacket[USBD_MSC_CDC_DATA_PACKET_SIZE];
+} CDC_Function_t;
+
+static CDC_Function_t cdc = {
+  .lineCoding = {0x00, 0xC2, 0x01, 0x00, 0x00, 0x00, 0x08}, // 115200 8N1, for the terminals asking first
+};
+
+USBD_ClassTypeDef USBD_MSC_CDC = {
+  init,
+  deInit,
+  setup,
+  NULL, /* EP0_TxSent */
+  ep0RxReady,
+  dataIn,
+  dataOut,
+  NULL, /* SOF */
+  NULL,
+  NULL,
+  getFSConfigDescriptor, /* the FS descriptor for the HS and the other speed too, the device is FS only */
+  getFSConfigDescriptor,
+  getFSConfigDescriptor,
+  getDeviceQualifierDescriptor,
+};
+
+static USBD_DescriptorsTypeDef descriptors;
+
+__ALIGN_BEGIN static uint8_t deviceDescriptor[USB_LEN_DEV_DESC] __ALIGN_END;
+
+__ALIGN_BEGIN static uint8_t configDescriptor[USBD_MSC_CDC_CONFIG_DESC_SIZE] __ALIGN_END = {
+  0x09,                                   /* bLength */
+  USB_DESC_TYPE_CONFIGURATION,            /* bDescriptorType */
+  LOBYTE(USBD_MSC_CDC_CONFIG_DESC_SIZE),  /* wTotalLength */
+  HIBYTE(USBD_MSC_CDC_CONFIG_DESC_SIZE),
+  USBD_MSC_CDC_INTERFACES_COUNT,          /* bNumInterfaces */
+  0x01,                                   /* bConfigurationValue */
+  0x04,                                   /* iConfiguration */
+#if (USBD_SELF_POWERED == 1U)
+  0xC0,                                   /* bmAttributes: self powered */
+#else
+  0x80,                                   /* bmAttributes: bus powered */
+#endif /* USBD_SELF_POWERED */
+  USBD_MAX_POWER,                         /* bMaxPower */
+
+  /* MSC interface, the same as the ST MSC class descriptor */
+  0x09, USB_DESC_TYPE_INTERFACE,
+  USBD_MSC_CDC_MSC_INTERFACE,             /* bInterfaceNumber */
+  0x00,                                   /* bAlternateSetting */
+  0x02,                                   /* bNumEndpoints */
+  0x08, 0x06, 0x50,                       /* MSC, SCSI transparent, bulk only */
+  0x05,                                   /* iInterface */
+  0x07, USB_DESC_TYPE_ENDPOINT, MSC_EPIN_ADDR, USBD_EP_TYPE_BULK, LOBYTE(MSC_MAX_FS_PACKET), HIBYTE(MSC_MAX_FS_PACKET), 0x00,
+  0x07, USB_DESC_TYPE_ENDPOINT, MSC_EPOUT_ADDR, USBD_EP_TYPE_BULK, LOBYTE(MSC_MAX_FS_PACKET), HIBYTE(MSC_MAX_FS_PACKET), 0x00,
+
+  /* IAD of the CDC function */
+  0x08, 0x0B,                             /* bLength, bDescriptorType: interface association */
+  USBD_MSC_CDC_COMM_INTERFACE,            /* bFirstInterface */
+  0x02,                                   /* bInterfaceCount */
+  0x02, 0x02, 0x01,                       /* CDC, ACM, AT commands */
+  0x00,                                   /* iFunction */
+
+  /* CDC communication interface */
+  0x09, USB_DESC_TYPE_INTERFACE,
+  USBD_MSC_CDC_COMM_INTERFACE,            /* bInterfaceNumber */
+  0x00,                                   /* bAlternateSetting */
+  0x01,                                   /* bNumEndpoints */
+  0x02, 0x02, 0x01,                       /* CDC, ACM, AT commands */
+  0x00,                                   /* iInterface */
+  0x05, 0x24, 0x00, 0x10, 0x01,           /* header functional descriptor, CDC 1.10 */
+  0x05, 0x24, 0x01, 0x00, USBD_MSC_CDC_DATA_INTERFACE, /* call management: none, the data interface */
+  0x04, 0x24, 0x02, 0x02,                 /* ACM: line coding and serial state requests */
+  0x05, 0x24, 0x06, USBD_MSC_CDC_COMM_INTERFACE, USBD_MSC_CDC_DATA_INTERFACE, /* union */
+  0x07, USB_DESC_TYPE_ENDPOINT, USBD_MSC_CDC_CMD_EP, USBD_EP_TYPE_INTR, LOBYTE(USBD_MSC_CDC_CMD_PACKET_SIZE), HIBYTE(USBD_MSC_CDC_CMD_PACKET_SIZE), 0x10,
+
+  /* CDC data interface */
+  0x09, USB_DESC_TYPE_INTERFACE,
+  USBD_MSC_CDC_DATA_INTERFACE,            /* bInterfaceNumber */
+  0x00,                                   /* bAlternateSetting */
+  0x02,                                   /* bNumEndpoints */
+  0x0A, 0x00, 0x00,                       /* CDC data */
+  0x00,                                   /* iInterface */
+  0x07, USB_DESC_TYPE_ENDPOINT, USBD_MSC_CDC_OUT_EP, USBD_EP_TYPE_BULK, LOBYTE(USBD_MSC_CDC_DATA_PACKET_SIZE), HIBYTE(USBD_MSC_CDC_DATA_PACKET_SIZE), 0x00,
+  0x07, USB_DESC_TYPE_ENDPOINT, USBD_MSC_CDC_IN_EP, USBD_EP_TYPE_BULK, LOBYTE(USBD_MSC_CDC_DATA_PACKET_SIZE), HIBYTE(USBD_MSC_CDC_DATA_PACKET_SIZE), 0x00,
+};
+
+__ALIGN_BEGIN static uint8_t deviceQualifierDescriptor[USB_LEN_DEV_QUALIFIER_DESC] __ALIGN_END = {
+  USB_LEN_DEV_QUALIFIER_DESC,
+  USB_DESC_TYPE_DEVICE_QUALIFIER,
+  0x00, 0x02,                             /* bcdUSB */
+  0xEF, 0x02, 0x01,                       /* miscellaneous, IAD */
+  0x40,                                   /* bMaxPacketSize0 */
+  0x01,                                   /* bNumConfigurations */
+  0x00,
+};
+
+_Static_assert(sizeof(configDescriptor) == USBD_MSC_CDC_CONFIG_DESC_SIZE, "composite configuration descriptor size mismatch");
+
+/**
+ * @brief Descriptors of the composite device: the generated ones with the IAD class triple (0xEF/0x02/0x01) and
+ * USBD_MSC_CDC_BCD_DEVICE in the device descriptor, the VID/PID and the strings stay as configured in CubeMX
+ */
+USBD_DescriptorsTypeDef* USBD_MSC_CDC_Descriptors(USBD_DescriptorsTypeDef *generated) {
+  uint16_t length;
+
+  memcpy(deviceDescriptor, generated->GetDeviceDescriptor(USBD_SPEED_FULL, &length), sizeof(deviceDescriptor));
+  deviceDescriptor[4] = 0xEF; /* bDeviceClass: miscellaneous, the CDC function is grouped by the IAD */
+  deviceDescriptor[5] = 0x02; /* bDeviceSubClass */
+  deviceDescriptor[6] = 0x01; /* bDeviceProtocol */
+  deviceDescriptor[12] = LOBYTE(USBD_MSC_CDC_BCD_DEVICE);
+  deviceDescriptor[13] = HIBYTE(USBD_MSC_CDC_BCD_DEVICE);
+
+  descriptors = *generated;
+  descriptors.GetDeviceDescriptor = getDeviceDescriptor;
+
+  return &descriptors;
+}
+
+uint8_t USBD_MSC_CDC_RegisterCallbacks(USBD_HandleTypeDef *pdev, const USBD_MSC_CDC_Callbacks_t *callbacks) {
+  UNUSED(pdev);
+
+  if (callbacks == NULL)
+    return (uint8_t) USBD_FAIL;
+
+  cdc.callbacks = callbacks;
+
+  return (uint8_t) USBD_OK;
+}
+
+/**
+ * @brief Starts the IN transfer, split into the packets by the PCD driver
+ * @note Zero length sends the ZLP ending the data
+ */
+uint8_t USBD_MSC_CDC_Transmit(USBD_HandleTypeDef *pdev, uint8_t *buffer, uint32_t length) {
+  if (pdev->dev_state != USBD_STATE_CONFIGURED || cdc.isTransmitting)
+    return (uint8_t) USBD_BUSY;
+
+  cdc.isTransmitting = true;
+  pdev->ep_in[USBD_MSC_CDC_IN_EP & 0x0FU].total_length = length;
+
+  return (uint8_t) USBD_LL_Transmit(pdev, USBD_MSC_CDC_IN_EP, buffer, length);
+}
+
+bool USBD_MSC_CDC_IsTransmitting(void) {
+  return cdc.isTransmitting;
+}
+
+static uint8_t init(USBD_HandleTypeDef *pdev, uint8_t cfgidx) {
+  uint8_t status = USBD_MSC.Init(pdev, cfgidx);
+  if (status != (uint8_t) USBD_OK)
+    return status;
+
+  (void) USBD_LL_OpenEP(pdev, USBD_MSC_CDC_IN_EP, USBD_EP_TYPE_BULK, USBD_MSC_CDC_DATA_PACKET_SIZE);
+  pdev->ep_in[USBD_MSC_CDC_IN_EP & 0x0FU].is_used = 1U;
+  (void) USBD_LL_OpenEP(pdev, USBD_MSC_CDC_OUT_EP, USBD_EP_TYPE_BULK, USBD_MSC_CDC_DATA_PACKET_SIZE);
+  pdev->ep_out[USBD_MSC_CDC_OUT_EP & 0x0FU].is_used = 1U;
+  (void) USBD_LL_OpenEP(pdev, USBD_MSC_CDC_CMD_EP, USBD_EP_TYPE_INTR, USBD_MSC_CDC_CMD_PACKET_SIZE);
+  pdev->ep_in[USBD_MSC_CDC_CMD_EP & 0x0FU].is_used = 1U;
+
+  cdc.isTransmitting = false;
+  cdc.isPortOpen = false;
+
+  return (uint8_t) USBD_LL_PrepareReceive(pdev, USBD_MSC_CDC_OUT_EP, cdc.rxPacket, sizeof(cdc.rxPacket));
+}
+
+static uint8_t deInit(USBD_HandleTypeDef *pdev, uint8_t cfgidx) {
+  (void) USBD_LL_CloseEP(pdev, USBD_MSC_CDC_IN_EP);
+  pdev->ep_in[USBD_MSC_CDC_IN_EP & 0x0FU].is_used = 0U;
+  (void) USBD_LL_CloseEP(pdev, USBD_MSC_CDC_OUT_EP);
+  pdev->ep_out[USBD_MSC_CDC_OUT_EP & 0x0FU].is_used = 0U;
+  (void) USBD_LL_CloseEP(pdev, USBD_MSC_CDC_CMD_EP);
+  pdev->ep_in[USBD_MSC_CDC_CMD_EP & 0x0FU].is_used = 0U;
+
+  cdc.isTransmitting = false;
+
+  // the cable is pulled or the host reset the device, the stream stops as on the port close
+  if (cdc.isPortOpen && cdc.callbacks != NULL) {
+    cdc.isPortOpen = false;
+    cdc.callbacks->PortChanged(false);
+  }
+
+  return USBD_MSC.DeInit(pdev, cfgidx);
+}
+
+/**
+ * @brief Interface requests go to their function by the interface number, endpoint requests by the endpoint
+ */
+static uint8_t setup(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req) {
+  return isMSCRequest(req) ? USBD_MSC.Setup(pdev, req) : setupCDC(pdev, req);
+}
+
+static uint8_t setupCDC(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *req) {
+  static uint8_t alternateSetting = 0U;
+  uint16_t statusInfo = 0U;
+
+  switch (req->bmRequest & USB_REQ_TYPE_MASK) {
+    case USB_REQ_TYPE_CLASS:
+      switch (req->bRequest) {
+        case CDC_SET_LINE_CODING:
+          if (req->wLength != CDC_LINE_CODING_SIZE) break;
+
+          cdc.pendingRequest = req->bRequest;
+          return (uint8_t) USBD_CtlPrepareRx(pdev, cdc.lineCoding, CDC_LINE_CODING_SIZE);
+        case CDC_GET_LINE_CODING:
+          return (uint8_t) USBD_CtlSendData(pdev, cdc.lineCoding, MIN(req->wLength, CDC_LINE_CODING_SIZE));
+        case CDC_SET_CONTROL_LINE_STATE: {
+          const bool isOpen = (req->wValue & CDC_CONTROL_LINE_DTR) != 0U;
+
+          if (isOpen != cdc.isPortOpen) {
+            cdc.isPortOpen = isOpen;
+
+            // the transfer the host stopped reading won't complete
+            if (!isOpen) {
+              (void) USBD_LL_FlushEP(pdev, USBD_MSC_CDC_IN_EP);
+              cdc.isTransmitting = false;
+            }
+
+            if (cdc.callbacks != NULL) cdc.callbacks->PortChanged(isOpen);
+          }
+
+          return (uint8_t) USBD_OK;
+        }
+        case CDC_SEND_BREAK:
+          return (uint8_t) USBD_OK;
+        default:
+          break;
+      }
+      break;
+    case USB_REQ_TYPE_STANDARD:
+      switch (req->bRequest) {
+        case USB_REQ_GET_STATUS:
+          return (uint8_t) USBD_CtlSendData(pdev, (uint8_t *) &statusInfo, 2U);
+        case USB_REQ_GET_INTERFACE:
+          return (uint8_t) USBD_CtlSendData(pdev, &alternateSetting, 1U);
+        case USB_REQ_SET_INTERFACE:
+        case USB_REQ_CLEAR_FEATURE:
+          return (uint8_t) USBD_OK;
+        default:
+          break;
+      }
+      break;
+    default:
+      break;
+  }
+
+  USBD_CtlError(pdev, req);
+  return (uint8_t) USBD_FAIL;
+}
+
+static uint8_t ep0RxReady(USBD_HandleTypeDef *pdev) {
+  UNUSED(pdev);
+
+  // the line coding is already in place, nothing depends on it
+  cdc.pendingRequest = 0U;
+
+  return (uint8_t) USBD_OK;
+}
+
+static uint8_t dataIn(USBD_HandleTypeDef *pdev, uint8_t epnum) {
+  if (epnum == (MSC_EPIN_ADDR & 0x0FU))
+    return USBD_MSC.DataIn(pdev, epnum);
+
+  if (epnum != (USBD_MSC_CDC_IN_EP & 0x0FU))
+    return (uint8_t) USBD_OK;
+
+  cdc.isTransmitting = false;
+
+  if (cdc.callbacks != NULL) cdc.callbacks->TransmitDone();
+
+  return (uint8_t) USBD_OK;
+}
+
+static uint8_t dataOut(USBD_HandleTypeDef *pdev, uint8_t epnum) {
+  if (epnum == (MSC_EPOUT_ADDR & 0x0FU))
+    return USBD_MSC.DataOut(pdev, epnum);
+
+  const uint32_t length = USBD_LL_GetRxDataSize(pdev, epnum);
+
+  if (cdc.callbacks != NULL) cdc.callbacks->Received(cdc.rxPacket, length);
+
+  return (uint8_t) USBD_LL_PrepareReceive(pdev, USBD_MSC_CDC_OUT_EP, cdc.rxPacket, sizeof(cdc.rxPacket));
+}
+
+static uint8_t *getFSConfigDescriptor(uint16_t *length) {
+  *length = (uint16_t) sizeof(configDescriptor);
+  return configDescriptor;
+}
+
+static uint8_t *getDeviceQualifierDescriptor(uint16_t *length) {
+  *length = (uint16_t) sizeof(deviceQualifierDescriptor);
+  return deviceQualifierDescriptor;
+}
+
+static uint8_t *getDeviceDescriptor(USBD_SpeedTypeDef speed, uint16_t *length) {
+  UNUSED(speed);
+  *length = (uint16_t) sizeof(deviceDescriptor);
+  return deviceDescriptor;
+}
+
+static bool isMSCRequest(const USBD_SetupReqTypedef *req) {
+  if ((req->bmRequest & USB_REQ_RECIPIENT_MASK) == USB_REQ_RECIPIENT_ENDPOINT)
+    return (LOBYTE(req->wIndex) & 0x0FU) == (MSC_EPIN_ADDR & 0x0FU);
+
+  return LOBYTE(req->wIndex) == USBD_MSC_CDC_MSC_INTERFACE;
+}
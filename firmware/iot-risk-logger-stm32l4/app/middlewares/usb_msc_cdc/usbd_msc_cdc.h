@@ -0,0 +1,67 @@
+/*!
+ * @file usbd_msc_cdc.h
+ * @brief Composite USB class: the MSC disk of the NOR Flash and a CDC-ACM serial port for the USB stream
+ *
+ * Interface 0 is the ST MSC class as is (EP 0x81/0x01), its callbacks are forwarded unchanged. Interfaces 1-2 are a
+ * minimal CDC-ACM function grouped by the IAD: the notification EP 0x83 (never used) and the data EPs 0x82/0x02.
+ * The line coding is accepted and ignored, the bulk pipe runs at the USB FS speed whatever the baud rate.
+ *
+ * The data IN EP is double buffered in the PMA, so a multi-packet transfer goes out as back-to-back 64 bytes
+ * packets. No ZLP is added: the stream ends its data with USBD_MSC_CDC_Transmit() of zero length when the last
+ * transfer is a multiple of the packet size.
+ *
+ * The callbacks run in the USB interrupt.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#ifndef USBD_MSC_CDC_H
+#define USBD_MSC_CDC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "usbd_ioreq.h"
+#include "usbd_msc.h"
+
+#define USBD_MSC_CDC_MSC_INTERFACE          (0x00U)
+#define USBD_MSC_CDC_COMM_INTERFACE         (0x01U)
+#define USBD_MSC_CDC_DATA_INTERFACE         (0x02U)
+#define USBD_MSC_CDC_INTERFACES_COUNT       (3U)
+
+#define USBD_MSC_CDC_CMD_EP                 (0x83U)
+#define USBD_MSC_CDC_IN_EP                  (0x82U)
+#define USBD_MSC_CDC_OUT_EP                 (0x02U)
+#define USBD_MSC_CDC_CMD_PACKET_SIZE        (8U)
+#define USBD_MSC_CDC_DATA_PACKET_SIZE       (64U)  ///< USB FS bulk maximum
+
+#define USBD_MSC_CDC_CONFIG_DESC_SIZE       (98U)
+
+#define USBD_MSC_CDC_BCD_DEVICE             (0x0201U) ///< Above the MSC only 2.00, the hosts re-read the configuration
+
+/**
+ * @brief Stream side of the CDC function, called from the USB interrupt
+ */
+typedef struct {
+  void (*Received)(const uint8_t *data, uint32_t length); ///< OUT packet, the next one is received after the return
+  void (*TransmitDone)(void); ///< IN transfer is acknowledged by the host, the buffer can be reused
+  void (*PortChanged)(bool isOpen); ///< DTR set or cleared by the host, cleared on the disconnect
+} USBD_MSC_CDC_Callbacks_t;
+
+extern USBD_ClassTypeDef USBD_MSC_CDC;
+
+USBD_DescriptorsTypeDef* USBD_MSC_CDC_Descriptors(USBD_DescriptorsTypeDef *generated);
+uint8_t USBD_MSC_CDC_RegisterCallbacks(USBD_HandleTypeDef *pdev, const USBD_MSC_CDC_Callbacks_t *callbacks);
+uint8_t USBD_MSC_CDC_Transmit(USBD_HandleTypeDef *pdev, uint8_t *buffer, uint32_t length);
+bool USBD_MSC_CDC_IsTransmitting(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //USBD_MSC_CDC_H
@@ -0,0 +1,430 @@
+/*!
+ * @file acquisition.c
+ * @brief implementation of the sensors acquisition scheduler
+ *
+ * The whole batch is queued at once, so the bus goes from one transaction to the next one straight from
+ * the I2C interrupt, without waking the thread in between. The only data dependent transaction is the FIFO
+ * burst read, its length is known after the FIFO level read, which is queued first: the burst read is queued
+ * while the SHT3x and OPT3001 transactions are still on the bus.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#include <inttypes.h>
+
+#include "acquisition.h"
+
+static osStatus_t handleAcquisitionFSM(ACQUISITION_Actor_t *this, message_t *message);
+/** transitions actions */
+static osStatus_t startBatch(ACQUISITION_Actor_t *this, message_t *message);
+static osStatus_t skipWakeUp(ACQUISITION_Actor_t *this, message_t *message);
+static osStatus_t startFifoRead(ACQUISITION_Actor_t *this, message_t *message);
+static osStatus_t collectTemperatureHumidity(ACQUISITION_Actor_t *this, message_t *message);
+static osStatus_t collectLux(ACQUISITION_Actor_t *this, message_t *message);
+static osStatus_t collectAcceleration(ACQUISITION_Actor_t *this, message_t *message);
+static osStatus_t collectWindowFeatures(ACQUISITION_Actor_t *this, message_t *message);
+static osStatus_t publishFrame(ACQUISITION_Actor_t *this, message_t *message);
+static osStatus_t failBatch(ACQUISITION_Actor_t *this, message_t *message);
+static osStatus_t restart(ACQUISITION_Actor_t *this, message_t *message);
+
+static void submitTransaction(ACQUISITION_Actor_t *this, SensorsBus_Operation_t operation, uint16_t devAddr, uint16_t reg, uint8_t *pData, uint16_t length, event_t completionEvent);
+static void submitTrigger(ACQUISITION_Actor_t *this, const SensorsBus_Transaction_t *transaction, uint8_t validFlag);
+static void completeTransaction(ACQUISITION_Actor_t *this, uint8_t pendingFlag);
+static uint8_t toPendingFlag(event_t completionEvent);
+static bool isStaleCompletion(ACQUISITION_Actor_t *this, const message_t *message);
+
+extern actor_t* ACTORS_LOOKUP_SystemRegistry[MAX_ACTORS];
+
+/**
+ * @brief Acquisition scheduler FSM transitions table
+ * @note rendered to the README state diagram by scripts/generate_state_machine_diagrams.py
+ */
+static const FSM_Transition_t acquisitionTransitions[] = {
+  FSM_TRANSITION(ACQUISITION_NO_STATE,      GLOBAL_CMD_INITIALIZE,                FSM_NO_ACTION,              ACQUISITION_IDLE_STATE),
+  FSM_TRANSITION(ACQUISITION_IDLE_STATE,    GLOBAL_CMD_START_CONTINUOUS_SENSING,  FSM_NO_ACTION,              ACQUISITION_SLEEP_STATE),
+  FSM_TRANSITION(ACQUISITION_SLEEP_STATE,   GLOBAL_WAKE_N_READ,                   startBatch,                 ACQUISITION_BATCH_STATE),
+  FSM_TRANSITION(ACQUISITION_SLEEP_STATE,   GLOBAL_CMD_TURN_OFF,                  FSM_NO_ACTION,              ACQUISITION_IDLE_STATE),
+  FSM_TRANSITION(ACQUISITION_BATCH_STATE,   GLOBAL_WAKE_N_READ,                   skipWakeUp,                 ACQUISITION_BATCH_STATE),
+  FSM_TRANSITION(ACQUISITION_BATCH_STATE,   ACQUISITION_FIFO_LEVEL_READ,          startFifoRead,              ACQUISITION_BATCH_STATE),
+  FSM_TRANSITION(ACQUISITION_BATCH_STATE,   ACQUISITION_TH_READ_DONE,             collectTemperatureHumidity, ACQUISITION_BATCH_STATE),
+  FSM_TRANSITION(ACQUISITION_BATCH_STATE,   ACQUISITION_LUX_READ_DONE,            collectLux,                 ACQUISITION_BATCH_STATE),
+  FSM_TRANSITION(ACQUISITION_BATCH_STATE,   ACQUISITION_FIFO_READ_DONE,           collectAcceleration,        ACQUISITION_BATCH_STATE),
+  FSM_TRANSITION(ACQUISITION_BATCH_STATE,   ACQUISITION_WINDOW_FEATURES_READY,    collectWindowFeatures,      ACQUISITION_BATCH_STATE),
+  FSM_TRANSITION(ACQUISITION_BATCH_STATE,   ACQUISITION_BATCH_COMPLETE,           publishFrame,               ACQUISITION_SLEEP_STATE),
+  FSM_TRANSITION(ACQUISITION_BATCH_STATE,   ACQUISITION_BATCH_TIMEOUT,            failBatch,                  ACQUISITION_SLEEP_STATE),
+  FSM_TRANSITION(ACQUISITION_STATE_ERROR,   GLOBAL_CMD_RESTART,                   restart,                    ACQUISITION_SLEEP_STATE),
+};
+
+static const FSM_Table_t acquisitionFSMTable = FSM_TABLE(acquisitionTransitions, NULL);
+
+/**
+ * @brief Sensors acquisition scheduler actor struct
+ * @extends actor_t
+ */
+ACQUISITION_Actor_t ACQUISITION_Actor = {
+        .super = {
+                .actorId = ACQUISITION_ACTOR_ID,
+                .messageHandler = (messageHandler_t) handleAcquisitionFSM,
+                .osMessageQueueId = NULL,
+                .osThreadId = NULL,
+        },
+        .state = ACQUISITION_NO_STATE,
+        .frameIndex = 0,
+        .pendingMask = 0,
+        .staleMask = 0,
+        .triggeredMask = ACQUISITION_TEMPERATURE_HUMIDITY_VALID | ACQUISITION_LUX_VALID, // by the sensors tasks
+        .skippedWakeUps = 0,
+        .thCommand = {TH_SENS_SINGLE_SHOT_CMD_ID >> 8, TH_SENS_SINGLE_SHOT_CMD_ID & 0xFF},
+        .luxConfig = {LIGHT_SENS_SINGLE_SHOT_CONFIG >> 8, LIGHT_SENS_SINGLE_SHOT_CONFIG & 0xFF},
+};
+
+// task description required for static task creation
+uint32_t acquisitionTaskBuffer[DEFAULT_TASK_STACK_SIZE_WORDS];
+StaticTask_t acquisitionTaskControlBlock;
+const osThreadAttr_t acquisitionTaskDescription = {
+        .name = "acquisitionTask",
+        .cb_mem = &acquisitionTaskControlBlock,
+        .cb_size = sizeof(acquisitionTaskControlBlock),
+        .stack_mem = &acquisitionTaskBuffer[0],
+        .stack_size = sizeof(acquisitionTaskBuffer),
+        .priority = (osPriority_t) osPriorityNormal,
+};
+
+/**
+ * @brief Initializes the acquisition scheduler task.
+ * @return {actor_t*} - pointer to the actor base struct
+ */
+actor_t* ACQUISITION_TaskInit(void) {
+  ACQUISITION_Actor.super.osMessageQueueId = osMessageQueueNew(DEFAULT_QUEUE_SIZE, DEFAULT_QUEUE_MESSAGE_SIZE, &(osMessageQueueAttr_t){
+          .name = "acquisitionQueue"
+  });
+  ACQUISITION_Actor.super.osThreadId = osThreadNew(ACQUISITION_Task, NULL, &acquisitionTaskDescription);
+
+  return &ACQUISITION_Actor.super;
+}
+
+/**
+ * @brief Acquisition scheduler task
+ * Waits for message from the queue and proceed it in FSM
+ * Enters ERROR state if message handling failed
+ */
+void ACQUISITION_Task(void *argument) {
+  (void) argument; // Avoid unused parameter warning
+  message_t msg;
+
+  for (;;) {
+    // Wait for messages from the queue
+    if (osMessageQueueGet(ACQUISITION_Actor.super.osMessageQueueId, &msg, NULL, osWaitForever) == osOK) {
+      osStatus_t status = ACQUISITION_Actor.super.messageHandler((actor_t *) &ACQUISITION_Actor, &msg);
+
+      if (status != osOK) {
+        osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
+        osMessageQueuePut(evManagerQueue, &(message_t){GLOBAL_ERROR, .payload.value = ACQUISITION_ACTOR_ID}, 0, 0);
+        TO_STATE(&ACQUISITION_Actor, ACQUISITION_STATE_ERROR);
+      }
+    }
+  }
+}
+
+static osStatus_t handleAcquisitionFSM(ACQUISITION_Actor_t *this, message_t *message) {
+  if (ACTOR_TIMER_IsStaleExpiry(&this->timer, message)) return osOK;
+  if (isStaleCompletion(this, message)) return osOK;
+
+  uint8_t state = this->state;
+  osStatus_t status = FSM_Dispatch(&acquisitionFSMTable, &this->super, message, &state);
+  this->state = state;
+
+  return status;
+}
+
+/**
+ * @brief Queues the whole batch, the FIFO level goes first to queue the burst read behind the other sensors
+ *
+ * The frame starts as a copy of the previous one, so a failed sensor keeps its last value.
+ */
+static osStatus_t startBatch(ACQUISITION_Actor_t *this, message_t *message) {
+  ACQUISITION_Frame_t *frame = &this->frames[this->frameIndex];
+  const ACQUISITION_Frame_t *previousFrame = &this->frames[(this->frameIndex + 1) % ACQUISITION_FRAMES_COUNT];
+
+  *frame = *previousFrame;
+  frame->timestamp = (int32_t) message->payload.value;
+  frame->fifoLevel = 0;
+  frame->validMask = 0;
+
+  this->wakeTick = osKernelGetTickCount();
+  this->pendingMask = 0;
+
+  #ifdef IMU_SHOCK_CAPTURE_ENABLED
+  // the FIFO is drained to the shock capture ring by the IMU, it extracts the features of the latest samples
+  osMessageQueueId_t imuQueue = ACTORS_LOOKUP_SystemRegistry[IMU_ACTOR_ID]->osMessageQueueId;
+  if (osMessageQueuePut(imuQueue, &(message_t){IMU_WINDOW_FEATURES_REQUEST, .payload.ptr = &frame->vibration}, 0, 0) == osOK) {
+    this->pendingMask |= ACQUISITION_WINDOW_FEATURES_PENDING;
+  }
+  #else
+  submitTransaction(this, SENSORS_BUS_READ_REG, IMU_I2C_ADDRESS, LIS2DW12_FIFO_SAMPLES, (uint8_t *) &this->fifoSamples, sizeof(this->fifoSamples), ACQUISITION_FIFO_LEVEL_READ);
+  #endif
+
+  // pipelined single-shot: read the measurement triggered on the previous wake up, then trigger the next one,
+  // the trigger completion isn't needed, the trigger not queued leaves the next wake up read invalid
+  const uint8_t triggeredMask = this->triggeredMask;
+  this->triggeredMask = 0;
+  frame->triggerTimestamp = this->triggerTimestamp;
+  this->triggerTimestamp = frame->timestamp;
+
+  if (triggeredMask & ACQUISITION_TEMPERATURE_HUMIDITY_VALID) {
+    submitTransaction(this, SENSORS_BUS_RECV, TH_SENS_I2C_ADDRESS, 0, this->thData, SHT3x_MEASUREMENTS_SIZE, ACQUISITION_TH_READ_DONE);
+  }
+  submitTrigger(this, &(SensorsBus_Transaction_t) {
+    .operation = SENSORS_BUS_SEND,
+    .devAddr = TH_SENS_I2C_ADDRESS,
+    .pData = this->thCommand,
+    .length = SHT3x_CMD_SIZE,
+    .actorId = NO_ACTOR_ID,
+    .threadId = NULL,
+  }, ACQUISITION_TEMPERATURE_HUMIDITY_VALID);
+
+  // the same for the OPT3001: the 100ms single-shot converts right after the trigger, then the sensor shuts down,
+  // its result register would return the old conversion without the trigger
+  if (triggeredMask & ACQUISITION_LUX_VALID) {
+    submitTransaction(this, SENSORS_BUS_READ_REG, LIGHT_SENS_I2C_ADDRESS, OPT3001_RESULT_REG, this->luxData, OPT3001_REGISTER_SIZE, ACQUISITION_LUX_READ_DONE);
+  }
+  submitTrigger(this, &(SensorsBus_Transaction_t) {
+    .operation = SENSORS_BUS_WRITE_REG,
+    .devAddr = LIGHT_SENS_I2C_ADDRESS,
+    .reg = OPT3001_CONFIG_REG,
+    .pData = this->luxConfig,
+    .length = OPT3001_REGISTER_SIZE,
+    .actorId = NO_ACTOR_ID,
+    .threadId = NULL,
+  }, ACQUISITION_LUX_VALID);
+
+  if (this->pendingMask == 0) return osError;
+
+  return ACTOR_TIMER_StartOneShot(&this->timer, ACQUISITION_ACTOR_ID, ACQUISITION_BATCH_TIMEOUT, ACQUISITION_BATCH_TIMEOUT_MS);
+}
+
+/**
+ * @brief The previous batch is still on the bus, the wake up is dropped
+ */
+static osStatus_t skipWakeUp(ACQUISITION_Actor_t *this, message_t *message) {
+  this->skippedWakeUps++;
+
+  TRACE_LOG("ACQ: wake up skipped, %" PRIu32 " total\n", this->skippedWakeUps);
+
+  return osOK;
+}
+
+/**
+ * @brief Queues the burst read of all FIFO samples, OUT registers address rolls back from OUT_Z_H to OUT_X_L
+ */
+static osStatus_t startFifoRead(ACQUISITION_Actor_t *this, message_t *message) {
+  const uint8_t fifoLevel = this->fifoSamples.diff;
+
+  if ((int32_t) message->payload.value == BSP_ERROR_NONE && fifoLevel > 0) {
+    ACQUISITION_Frame_t *frame = &this->frames[this->frameIndex];
+
+    frame->fifoLevel = (fifoLevel > ACQUISITION_FIFO_DEPTH) ? ACQUISITION_FIFO_DEPTH : fifoLevel;
+
+    submitTransaction(this, SENSORS_BUS_READ_REG, IMU_I2C_ADDRESS, LIS2DW12_OUT_X_L, (uint8_t *) this->fifoData, frame->fifoLevel * ACQUISITION_FIFO_SAMPLE_SIZE, ACQUISITION_FIFO_READ_DONE);
+  }
+
+  completeTransaction(this, ACQUISITION_FIFO_LEVEL_PENDING);
+
+  return osOK;
+}
+
+static osStatus_t collectTemperatureHumidity(ACQUISITION_Actor_t *this, message_t *message) {
+  ACQUISITION_Frame_t *frame = &this->frames[this->frameIndex];
+  int16_t rawTemperature = 0;
+  uint16_t rawHumidity = 0;
+
+  if ((int32_t) message->payload.value == BSP_ERROR_NONE && SHT3x_ParseMeasurements(this->thData, &rawTemperature, &rawHumidity) == SHT3x_OK) {
+    frame->rawTemperature = rawTemperature;
+    frame->rawHumidity = rawHumidity;
+    frame->validMask |= ACQUISITION_TEMPERATURE_HUMIDITY_VALID;
+  }
+
+  completeTransaction(this, ACQUISITION_TH_READ_PENDING);
+
+  return osOK;
+}
+
+static osStatus_t collectLux(ACQUISITION_Actor_t *this, message_t *message) {
+  ACQUISITION_Frame_t *frame = &this->frames[this->frameIndex];
+
+  if ((int32_t) message->payload.value == BSP_ERROR_NONE) {
+    frame->rawLux = (this->luxData[0] << 8) | this->luxData[1];
+    frame->validMask |= ACQUISITION_LUX_VALID;
+  }
+
+  completeTransaction(this, ACQUISITION_LUX_READ_PENDING);
+
+  return osOK;
+}
+
+/**
+ * @brief Extracts the vibration features of the FIFO samples read in one burst, the acceleration is their mean
+ *
+ * The kernels cycles are traced from the DWT cycle counter (enabled by SystemView)
+ */
+static osStatus_t collectAcceleration(ACQUISITION_Actor_t *this, message_t *message) {
+  ACQUISITION_Frame_t *frame = &this->frames[this->frameIndex];
+
+  if ((int32_t) message->payload.value == BSP_ERROR_NONE) {
+    uint32_t startCycles = DWT->CYCCNT;
+    VIBRATION_ExtractFeatures(this->fifoData, frame->fifoLevel, &frame->vibration);
+    uint32_t featuresCycles = DWT->CYCCNT - startCycles;
+
+    for (uint8_t axis = 0; axis < ACQUISITION_AXES_COUNT; axis++) {
+      frame->acceleration[axis] = frame->vibration.mean[axis];
+    }
+    frame->validMask |= ACQUISITION_ACCELERATION_VALID;
+
+    TRACE_LOG("ACQ: vibration features of %u samples, %" PRIu32 " cycles\n", frame->fifoLevel, featuresCycles);
+  }
+
+  completeTransaction(this, ACQUISITION_FIFO_READ_PENDING);
+
+  return osOK;
+}
+
+/**
+ * @brief The IMU extracted the features of the latest shock capture ring samples into the frame
+ */
+static osStatus_t collectWindowFeatures(ACQUISITION_Actor_t *this, message_t *message) {
+  ACQUISITION_Frame_t *frame = &this->frames[this->frameIndex];
+
+  frame->fifoLevel = (uint8_t) message->payload.value;
+
+  if (frame->fifoLevel > 0) {
+    for (uint8_t axis = 0; axis < ACQUISITION_AXES_COUNT; axis++) {
+      frame->acceleration[axis] = frame->vibration.mean[axis];
+    }
+    frame->validMask |= ACQUISITION_ACCELERATION_VALID;
+  }
+
+  completeTransaction(this, ACQUISITION_WINDOW_FEATURES_PENDING);
+
+  return osOK;
+}
+
+/**
+ * @brief Publishes the frame to the MEMORY and switches to the second frame buffer
+ */
+static osStatus_t publishFrame(ACQUISITION_Actor_t *this, message_t *message) {
+  ACQUISITION_Frame_t *frame = &this->frames[this->frameIndex];
+
+  ACTOR_TIMER_Stop(&this->timer);
+
+  frame->awakeTicks = osKernelGetTickCount() - this->wakeTick;
+  this->frameIndex = (this->frameIndex + 1) % ACQUISITION_FRAMES_COUNT;
+
+  TRACE_LOG("ACQ: frame valid 0x%x, %u FIFO samples, awake %" PRIu32 " ticks\n", frame->validMask, frame->fifoLevel, frame->awakeTicks);
+
+  osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
+  osMessageQueuePut(evManagerQueue, &(message_t){GLOBAL_MEASUREMENTS_FRAME_READY, .payload.ptr = frame, .payload_size = sizeof(ACQUISITION_Frame_t)}, 0, 0);
+
+  return osOK;
+}
+
+/**
+ * @brief Publishes what was collected, the late completions of the batch are dropped when they arrive
+ *
+ * The batch transactions don't wait on the bus, so the hung one is recovered here: the timeout is longer than
+ * the bus stall timeout, its failed completion is dropped as stale.
+ */
+static osStatus_t failBatch(ACQUISITION_Actor_t *this, message_t *message) {
+  TRACE_LOG("ACQ: batch timeout, pending 0x%x\n", this->pendingMask);
+
+  this->staleMask |= this->pendingMask;
+  this->pendingMask = 0;
+
+  SensorsBus_RecoverStalled();
+
+  return publishFrame(this, message);
+}
+
+static osStatus_t restart(ACQUISITION_Actor_t *this, message_t *message) {
+  ACTOR_TIMER_Stop(&this->timer);
+  this->staleMask |= this->pendingMask;
+  this->pendingMask = 0;
+
+  return osOK;
+}
+
+/**
+ * @brief Queues the transaction completed to this actor, counts it as pending if queued
+ */
+static void submitTransaction(ACQUISITION_Actor_t *this, SensorsBus_Operation_t operation, uint16_t devAddr, uint16_t reg, uint8_t *pData, uint16_t length, event_t completionEvent) {
+  int32_t status = SensorsBus_Submit(&(SensorsBus_Transaction_t) {
+    .operation = operation,
+    .devAddr = devAddr,
+    .reg = reg,
+    .pData = pData,
+    .length = length,
+    .actorId = ACQUISITION_ACTOR_ID,
+    .completionEvent = completionEvent,
+  });
+
+  if (status == BSP_ERROR_NONE) {
+    this->pendingMask |= toPendingFlag(completionEvent);
+  } else {
+    TRACE_LOG("ACQ: event %u transaction not queued, status %" PRId32 "\n", completionEvent, status);
+  }
+}
+
+/**
+ * @brief Queues the single-shot trigger for the next batch, its read is skipped by the next batch if not queued
+ */
+static void submitTrigger(ACQUISITION_Actor_t *this, const SensorsBus_Transaction_t *transaction, uint8_t validFlag) {
+  int32_t status = SensorsBus_Submit(transaction);
+
+  if (status == BSP_ERROR_NONE) {
+    this->triggeredMask |= validFlag;
+  } else {
+    TRACE_LOG("ACQ: trigger 0x%x not queued, status %" PRId32 "\n", validFlag, status);
+  }
+}
+
+/**
+ * @brief Posts ACQUISITION_BATCH_COMPLETE on the last pending transaction
+ */
+static void completeTransaction(ACQUISITION_Actor_t *this, uint8_t pendingFlag) {
+  if (this->pendingMask == 0) return;
+
+  this->pendingMask &= (uint8_t) ~pendingFlag;
+
+  if (this->pendingMask == 0) {
+    osMessageQueuePut(this->super.osMessageQueueId, &(message_t){ACQUISITION_BATCH_COMPLETE}, 0, 0);
+  }
+}
+
+static uint8_t toPendingFlag(event_t completionEvent) {
+  switch (completionEvent) {
+    case ACQUISITION_FIFO_LEVEL_READ:       return ACQUISITION_FIFO_LEVEL_PENDING;
+    case ACQUISITION_TH_READ_DONE:          return ACQUISITION_TH_READ_PENDING;
+    case ACQUISITION_LUX_READ_DONE:         return ACQUISITION_LUX_READ_PENDING;
+    case ACQUISITION_FIFO_READ_DONE:        return ACQUISITION_FIFO_READ_PENDING;
+    case ACQUISITION_WINDOW_FEATURES_READY: return ACQUISITION_WINDOW_FEATURES_PENDING;
+    default:                                return 0;
+  }
+}
+
+/**
+ * @brief Drops the late completion of the timed out batch, before it's taken for the completion of the current one
+ *
+ * A batch has at most one transaction per completion event and the completions of one event arrive in the
+ * submission order, so the first completion of the event pending at the timeout is the stale one.
+ */
+static bool isStaleCompletion(ACQUISITION_Actor_t *this, const message_t *message) {
+  const uint8_t pendingFlag = toPendingFlag(message->event);
+
+  if ((this->staleMask & pendingFlag) == 0) return false;
+
+  this->staleMask &= (uint8_t) ~pendingFlag;
+
+  TRACE_LOG("ACQ: stale completion of event %u dropped\n", message->event);
+
+  return true;
+}
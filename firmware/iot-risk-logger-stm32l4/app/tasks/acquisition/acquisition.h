@@ -0,0 +1,119 @@
+/*!
+ * @file acquisition.h
+ * @brief Sensors acquisition scheduler, reads all sensors in a single bus batch per RTC wake up.
+ *
+ * On GLOBAL_WAKE_N_READ the scheduler queues one ordered batch of I2C transactions to the sensors bus:
+ * LIS2DW12 FIFO level, SHT3x and OPT3001 pipelined single-shot reads and re-triggers and the LIS2DW12 FIFO
+ * burst read.
+ * The transactions run back to back from the I2C interrupts while the thread sleeps, the completions are
+ * collected into one measurement frame published as GLOBAL_MEASUREMENTS_FRAME_READY to the MEMORY actor.
+ *
+ * The sensors actors keep the configuration (reset, modes, limits), the scheduler reads the results and
+ * re-triggers the SHT3x and OPT3001 single-shot measurements for the next wake up.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#ifndef ACQUISITION_H
+#define ACQUISITION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "main.h"
+#include "sensors_bus.h"
+#include "fsm.h"
+#include "actor_timer.h"
+#include "sht3x.h"
+#include "opt3001.h"
+#include "lis2dw12_reg.h"
+#include "vibration_features.h"
+
+#define ACQUISITION_FRAMES_COUNT        (2)   // published frame is written by MEMORY while the next one is acquired
+#define ACQUISITION_FIFO_DEPTH          (32)  // LIS2DW12 FIFO samples
+#define ACQUISITION_FIFO_SAMPLE_SIZE    (6)   // X, Y, Z little endian 16 bit words
+#define ACQUISITION_AXES_COUNT          (3)
+#define ACQUISITION_BATCH_TIMEOUT_MS    (100) // batch takes ~2ms at 400kHz, the rest is the margin for the NFC transactions
+
+typedef enum {
+  ACQUISITION_NO_STATE = 0,
+  ACQUISITION_IDLE_STATE, ///< Sensors are not measuring, wake ups are ignored
+  ACQUISITION_SLEEP_STATE, ///< Sensors are measuring, waiting for the RTC wake up
+  ACQUISITION_BATCH_STATE, ///< Batch transactions are on the bus
+  ACQUISITION_STATE_ERROR,
+  ACQUISITION_MAX_STATE
+} ACQUISITION_State_t;
+
+typedef enum {
+  ACQUISITION_TEMPERATURE_HUMIDITY_VALID = 0x01,
+  ACQUISITION_LUX_VALID = 0x02,
+  ACQUISITION_ACCELERATION_VALID = 0x04,
+  ACQUISITION_ALL_VALID = ACQUISITION_TEMPERATURE_HUMIDITY_VALID | ACQUISITION_LUX_VALID | ACQUISITION_ACCELERATION_VALID
+} ACQUISITION_FrameValidFlag_t;
+
+/**
+ * @brief Completions of the batch, each batch transaction has its own completion event
+ */
+typedef enum {
+  ACQUISITION_FIFO_LEVEL_PENDING = 0x01,
+  ACQUISITION_TH_READ_PENDING = 0x02,
+  ACQUISITION_LUX_READ_PENDING = 0x04,
+  ACQUISITION_FIFO_READ_PENDING = 0x08,
+  ACQUISITION_WINDOW_FEATURES_PENDING = 0x10,
+} ACQUISITION_PendingFlag_t;
+
+/**
+ * @brief Combined measurement frame of a single wake up
+ * @note Sensor which failed to be read keeps the value from the previous frame, its valid flag is cleared
+ * @note The SHT3x and OPT3001 single-shots are pipelined: their values are measured on the previous wake up trigger,
+ * at triggerTimestamp, the acceleration and the vibration are of this wake up
+ */
+typedef struct {
+  int32_t timestamp; ///< UNIX timestamp of the RTC wake up
+  int32_t triggerTimestamp; ///< UNIX timestamp of the wake up which triggered the temperature, humidity and lux read
+  int16_t rawTemperature;
+  uint16_t rawHumidity;
+  uint16_t rawLux;
+  int16_t acceleration[ACQUISITION_AXES_COUNT]; ///< Averaged FIFO samples
+  VIBRATION_Features_t vibration; ///< Features of the FIFO window
+  uint8_t fifoLevel; ///< Number of averaged FIFO samples
+  uint8_t validMask; ///< ACQUISITION_FrameValidFlag_t bits
+  uint32_t awakeTicks; ///< Ticks from the wake up to the frame publishing
+} ACQUISITION_Frame_t;
+
+typedef struct {
+  actor_t super;
+  ACQUISITION_State_t state;
+  ACQUISITION_Frame_t frames[ACQUISITION_FRAMES_COUNT];
+  uint8_t frameIndex; ///< Frame being acquired
+  uint8_t pendingMask; ///< ACQUISITION_PendingFlag_t of the batch transactions without completion yet
+  uint8_t staleMask; ///< ACQUISITION_PendingFlag_t of the late completions of the timed out batch, dropped on arrival
+  uint8_t triggeredMask; ///< ACQUISITION_FrameValidFlag_t of the single-shots triggered for the next batch
+  int32_t triggerTimestamp; ///< UNIX timestamp of the wake up the single-shots were triggered on
+  uint32_t wakeTick; ///< Kernel tick of the batch start
+  uint32_t skippedWakeUps; ///< Wake ups arrived while the previous batch was on the bus
+  ACTOR_Timer_t timer; ///< posts ACQUISITION_BATCH_TIMEOUT
+  // transactions buffers, should stay valid until the completion
+  uint8_t thCommand[SHT3x_CMD_SIZE];
+  uint8_t thData[SHT3x_MEASUREMENTS_SIZE];
+  uint8_t luxData[OPT3001_REGISTER_SIZE];
+  uint8_t luxConfig[OPT3001_REGISTER_SIZE];
+  lis2dw12_fifo_samples_t fifoSamples;
+  int16_t fifoData[ACQUISITION_FIFO_DEPTH * ACQUISITION_AXES_COUNT]; ///< Interleaved X, Y, Z samples, little endian as the MCU
+} ACQUISITION_Actor_t;
+
+extern ACQUISITION_Actor_t ACQUISITION_Actor;
+
+actor_t* ACQUISITION_TaskInit(void);
+void ACQUISITION_Task(void *argument);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ACQUISITION_H
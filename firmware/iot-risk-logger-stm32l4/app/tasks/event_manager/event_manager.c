@@ -9,6 +9,11 @@
  */
 
 #include "event_manager.h"
+#include "supervisor.h"
+
+#ifdef EVENT_RECORDER_ENABLED
+#include "event_recorder.h"
+#endif
 
 static osStatus_t handleEvManagerMessage(EV_MANAGER_Actor_t *this, message_t *message);
 static osStatus_t publishEventToSubscribers(message_t *message);
@@ -35,21 +40,24 @@ extern actor_t* ACTORS_LOOKUP_SystemRegistry[MAX_ACTORS];
 const ACTOR_ID EV_MANAGER_SubscribersIdsMatrix[GLOBAL_EVENTS_MAX][MAX_ACTORS] = {
   // TODO: uncomment the full list to initialize all actors
 //  [GLOBAL_CMD_INITIALIZE]                           = {CRON_ACTOR_ID, PWRM_MANAGER_ACTOR_ID, NFC_ACTOR_ID, IMU_ACTOR_ID, TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID, LIGHT_SENSOR_ACTOR_ID, MEMORY_ACTOR_ID},
-  [GLOBAL_CMD_INITIALIZE]                           = {CRON_ACTOR_ID, LIGHT_SENSOR_ACTOR_ID, TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID, IMU_ACTOR_ID, MEMORY_ACTOR_ID},
+  [GLOBAL_CMD_INITIALIZE]                           = {CRON_ACTOR_ID, LIGHT_SENSOR_ACTOR_ID, TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID, IMU_ACTOR_ID, MEMORY_ACTOR_ID, ACQUISITION_ACTOR_ID, USB_STREAM_ACTOR_ID},
   [GLOBAL_INITIALIZE_SUCCESS]                       = {},
-  [GLOBAL_WAKE_N_READ]                              = {LIGHT_SENSOR_ACTOR_ID, TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID},
-  [GLOBAL_TEMPERATURE_HUMIDITY_MEASUREMENTS_READY]  = {MEMORY_ACTOR_ID},
-  [GLOBAL_LIGHT_MEASUREMENTS_READY]                 = {MEMORY_ACTOR_ID},
-  [GLOBAL_IMU_MEASUREMENTS_READY]                   = {MEMORY_ACTOR_ID},
-  [GLOBAL_MEASUREMENTS_WRITE_SUCCESS]               = {MEMORY_ACTOR_ID, NFC_ACTOR_ID},
-  [GLOBAL_LOG_CHUNK_READ_SUCCESS]                   = { NFC_ACTOR_ID},
+  [GLOBAL_WAKE_N_READ]                              = {ACQUISITION_ACTOR_ID},
+  [GLOBAL_MEASUREMENTS_FRAME_READY]                 = {MEMORY_ACTOR_ID, CRON_ACTOR_ID, NFC_ACTOR_ID, USB_STREAM_ACTOR_ID},
+  [GLOBAL_MEASUREMENTS_WRITE_SUCCESS]               = {MEMORY_ACTOR_ID},
   [GLOBAL_SETTINGS_WRITE_SUCCESS]                   = {MEMORY_ACTOR_ID, NFC_ACTOR_ID},
   [GLOBAL_SETTINGS_READ_SUCCESS]                    = { NFC_ACTOR_ID},
   [GLOBAL_CMD_READ_SETTINGS]                        = { MEMORY_ACTOR_ID},
-  [GLOBAL_CMD_START_CONTINUOUS_SENSING]             = {TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID, LIGHT_SENSOR_ACTOR_ID},
+  [GLOBAL_CMD_WRITE_SETTINGS]                       = {MEMORY_ACTOR_ID},
+  [GLOBAL_CMD_READ_LOG_CHUNK]                       = {NFC_ACTOR_ID},
+  [GLOBAL_CMD_EXPORT_LOG]                           = {NFC_ACTOR_ID},
+  [GLOBAL_CMD_QUERY_LOG]                            = {NFC_ACTOR_ID},
+  [GLOBAL_CMD_START_CONTINUOUS_SENSING]             = {TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID, LIGHT_SENSOR_ACTOR_ID, IMU_ACTOR_ID, ACQUISITION_ACTOR_ID},
   [GLOBAL_CMD_SET_TIME_DATE]                        = {CRON_ACTOR_ID},
   [GLOBAL_CMD_SET_WAKE_UP_PERIOD]                   = {CRON_ACTOR_ID},
-  [GLOBAL_CMD_TURN_OFF]                             = {TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID, LIGHT_SENSOR_ACTOR_ID, PWRM_MANAGER_ACTOR_ID},
+  [GLOBAL_CMD_SET_WAKE_UP_PERIOD_BOUNDS]            = {CRON_ACTOR_ID},
+  [GLOBAL_WAKE_UP_PERIOD_CHANGED]                   = {MEMORY_ACTOR_ID},
+  [GLOBAL_CMD_TURN_OFF]                             = {TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID, LIGHT_SENSOR_ACTOR_ID, IMU_ACTOR_ID, ACQUISITION_ACTOR_ID, PWRM_MANAGER_ACTOR_ID},
 };
 
 // TODO simplify it from the task [DFT-24](https://www.notion.so/recycle-refactor-Event-Manager-transform-from-task-to-plain-function-2ad109abe35680949db7d59a1498757d?source=copy_link)
@@ -72,23 +80,45 @@ actor_t* EV_MANAGER_ActorInit(osThreadId_t defaultTaskHandle) {
   fprintf(stdout, "Event Manager initialized\n");
 
   // TODO move to init manager
-  osMessageQueuePut(EV_MANAGER_Actor.super.osMessageQueueId, &(message_t){GLOBAL_CMD_INITIALIZE}, 0, 0);
+  osMessageQueuePut(EV_MANAGER_Actor.super.osMessageQueueId, &(message_t){.event = GLOBAL_CMD_INITIALIZE}, 0, 0);
 
   return &EV_MANAGER_Actor.super;
 }
 
+/**
+ * @return true if the actor gets the event through its subscription, false for the events sent to it directly
+ */
+bool EV_MANAGER_IsSubscribed(ACTOR_ID actorId, event_t event) {
+  if (event >= GLOBAL_EVENTS_MAX) return false;
+
+  for (int32_t i = 0; i < MAX_ACTORS; i++) {
+    if (EV_MANAGER_SubscribersIdsMatrix[event][i] == actorId) return true;
+  }
+
+  return false;
+}
+
 static osStatus_t handleEvManagerMessage(EV_MANAGER_Actor_t *this, message_t *message) {
+  UNUSED(this);
+
   switch (message->event) {
     case GLOBAL_CMD_INITIALIZE:
       publishEventToSubscribers(message);
       // TODO handle initialize event
       // TODO remove from here
-      osMessageQueuePut(EV_MANAGER_Actor.super.osMessageQueueId, &(message_t){GLOBAL_INITIALIZE_SUCCESS}, 0, 0);
+      osMessageQueuePut(EV_MANAGER_Actor.super.osMessageQueueId, &(message_t){.event = GLOBAL_INITIALIZE_SUCCESS}, 0, 0);
       return osOK;
     case GLOBAL_INITIALIZE_SUCCESS:
       publishEventToSubscribers(message);
       // TODO remove from here, emit only in NFC
-      osMessageQueuePut(EV_MANAGER_Actor.super.osMessageQueueId, &(message_t){GLOBAL_CMD_START_CONTINUOUS_SENSING}, 0, 0);
+      osMessageQueuePut(EV_MANAGER_Actor.super.osMessageQueueId, &(message_t){.event = GLOBAL_CMD_START_CONTINUOUS_SENSING}, 0, 0);
+      return osOK;
+    case GLOBAL_ERROR:
+      publishEventToSubscribers(message);
+      SUPERVISOR_HandleActorError((ACTOR_ID) message->payload.value);
+      return osOK;
+    case EV_MANAGER_RESTART_TIMEOUT:
+      SUPERVISOR_HandleRestartTimeout(message);
       return osOK;
     // all not specially dedicated to evManager events are published to subscribers
     default:
@@ -121,6 +151,10 @@ static osStatus_t handleEvManagerMessage(EV_MANAGER_Actor_t *this, message_t *me
 static osStatus_t publishEventToSubscribers(message_t *message) {
   const ACTOR_ID* subscribersIds = EV_MANAGER_SubscribersIdsMatrix[message->event];
 
+  #ifdef EVENT_RECORDER_ENABLED
+  EVENT_RECORDER_Record(message);
+  #endif
+
   // traverse all subscribers IDs and put message to their queues/handlers, subscribers are [NO_ACTOR, SOME_ACTOR, NO_ACTOR, ..., MAX_ACTORS]
   for (int32_t i = 0; i < MAX_ACTORS; i++) {
     if (subscribersIds[i] == NO_ACTOR_ID)
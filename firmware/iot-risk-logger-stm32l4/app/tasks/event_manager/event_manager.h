@@ -29,6 +29,7 @@ typedef struct {
 extern EV_MANAGER_Actor_t EV_MANAGER_Actor;
 
 actor_t* EV_MANAGER_ActorInit(osThreadId_t defaultTaskHandle);
+bool EV_MANAGER_IsSubscribed(ACTOR_ID actorId, event_t event);
 
 #ifdef __cplusplus
 }
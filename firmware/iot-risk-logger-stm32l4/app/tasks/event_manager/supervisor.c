@@ -0,0 +1,72 @@
+/*!
+ * @file supervisor.c
+ * @brief implementation of the actors supervisor
+ *
+ * Runs in the Event Manager context only, hence the records are not guarded.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#include "supervisor.h"
+
+extern actor_t* ACTORS_LOOKUP_SystemRegistry[MAX_ACTORS];
+
+static SUPERVISOR_ActorRecord_t supervisedActors[MAX_ACTORS] = {0};
+
+/**
+ * @brief Schedules the restart of the failed actor after the backoff
+ *
+ * @note Repeated errors while the restart is pending are ignored, the actor is already in the ERROR state.
+ */
+void SUPERVISOR_HandleActorError(ACTOR_ID actorId) {
+  if (actorId <= EV_MANAGER_ACTOR_ID || actorId >= MAX_ACTORS) return;
+
+  actor_t *actor = ACTORS_LOOKUP_SystemRegistry[actorId];
+  SUPERVISOR_ActorRecord_t *record = &supervisedActors[actorId];
+
+  // actors without a task don't park in the ERROR state
+  if (actor == NULL || actor->osMessageQueueId == NULL) return;
+  if (ACTOR_TIMER_IsArmed(&record->restartTimer)) return;
+
+  uint32_t now = osKernelGetTickCount();
+
+  if ((now - record->lastErrorTick) > ACTOR_TIMER_MS_TO_TICKS(SUPERVISOR_BACKOFF_RESET_MS)) {
+    record->consecutiveErrors = 0;
+  }
+
+  uint32_t backoffShift = (record->consecutiveErrors < SUPERVISOR_BACKOFF_MAX_SHIFT)
+    ? record->consecutiveErrors
+    : SUPERVISOR_BACKOFF_MAX_SHIFT;
+  uint32_t backoffMs = SUPERVISOR_BACKOFF_BASE_MS << backoffShift;
+
+  record->consecutiveErrors++;
+  record->lastErrorTick = now;
+
+  TRACE_LOG("supervisor: actor %" PRIu32 " failed, restart in %" PRIu32 " ms\n", (uint32_t) actorId, backoffMs);
+
+  ACTOR_TIMER_StartOneShot(&record->restartTimer, EV_MANAGER_ACTOR_ID, EV_MANAGER_RESTART_TIMEOUT, backoffMs);
+}
+
+/**
+ * @brief Sends GLOBAL_CMD_RESTART directly to the actor whose backoff has elapsed
+ */
+void SUPERVISOR_HandleRestartTimeout(message_t *message) {
+  SUPERVISOR_ActorRecord_t *record = (SUPERVISOR_ActorRecord_t *) message->payload.ptr;
+  ACTOR_ID actorId = (ACTOR_ID) (record - supervisedActors);
+
+  if (ACTOR_TIMER_IsStaleExpiry(&record->restartTimer, message)) return;
+  if (actorId <= EV_MANAGER_ACTOR_ID || actorId >= MAX_ACTORS) return;
+
+  record->restartsCount++;
+
+  TRACE_LOG("supervisor: actor %" PRIu32 " restart #%" PRIu32 "\n", (uint32_t) actorId, record->restartsCount);
+
+  osMessageQueuePut(ACTORS_LOOKUP_SystemRegistry[actorId]->osMessageQueueId, &(message_t){.event = GLOBAL_CMD_RESTART}, 0, 0);
+}
+
+uint32_t SUPERVISOR_GetRestartsCount(ACTOR_ID actorId) {
+  if (actorId >= MAX_ACTORS) return 0;
+
+  return supervisedActors[actorId].restartsCount;
+}
@@ -0,0 +1,50 @@
+/*!
+ * @file supervisor.h
+ * @brief Actors supervisor, restarts actors failed into the ERROR state
+ *
+ * Actors publish GLOBAL_ERROR with their ID on a failed message handling and park in the ERROR state.
+ * The Event Manager passes the error to the supervisor, which sends GLOBAL_CMD_RESTART directly to the
+ * failed actor after the exponential backoff. Actors handle it in the ERROR state by re-running the driver
+ * init sequence, so a single bus glitch doesn't stop the sensor for the rest of the shipment and
+ * the MCU reset (followed by the slow NOR Flash log tail re-scan) is avoided.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "actor.h"
+#include "actor_timer.h"
+
+#define SUPERVISOR_BACKOFF_BASE_MS        (1000)    // first restart delay
+#define SUPERVISOR_BACKOFF_MAX_SHIFT      (8)       // delay is doubled up to 256 * base, ~4 min
+#define SUPERVISOR_BACKOFF_RESET_MS       (600000)  // 10 min without errors restarts the backoff from the base
+
+/**
+ * @brief Supervision record of the actor
+ */
+typedef struct {
+  ACTOR_Timer_t restartTimer;     ///< Backoff timer, the first member to get the record from the timeout message
+  uint32_t restartsCount;         ///< Total restarts since boot
+  uint32_t consecutiveErrors;     ///< Errors within SUPERVISOR_BACKOFF_RESET_MS from each other, backoff exponent
+  uint32_t lastErrorTick;         ///< Kernel tick of the last error
+} SUPERVISOR_ActorRecord_t;
+
+void SUPERVISOR_HandleActorError(ACTOR_ID actorId);
+void SUPERVISOR_HandleRestartTimeout(message_t *message);
+uint32_t SUPERVISOR_GetRestartsCount(ACTOR_ID actorId);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SUPERVISOR_H
@@ -10,24 +10,80 @@
  */
 
 #include "imu.h"
+#include "cron.h"
 
 #include "../../../Middlewares/Third_Party/FreeRTOS/Source/CMSIS_RTOS_V2/cmsis_os2.h"
 
 
 static osStatus_t handleImuFSM(IMU_Actor_t *this, message_t *message);
 
-/** states handlers */
-static osStatus_t handleInit(IMU_Actor_t *this, message_t *message);
-static osStatus_t handleIdle(IMU_Actor_t *this, message_t *message);
+/** transitions actions */
+static osStatus_t initialize(IMU_Actor_t *this, message_t *message);
+static osStatus_t restart(IMU_Actor_t *this, message_t *message);
+static osStatus_t readFifoAndLog(IMU_Actor_t *this, message_t *message);
+#ifdef IMU_SHOCK_CAPTURE_ENABLED
+static osStatus_t armCapture(IMU_Actor_t *this, message_t *message);
+static osStatus_t disarmCapture(IMU_Actor_t *this, message_t *message);
+static osStatus_t drainToRing(IMU_Actor_t *this, message_t *message);
+static osStatus_t startCapture(IMU_Actor_t *this, message_t *message);
+static osStatus_t drainPostTrigger(IMU_Actor_t *this, message_t *message);
+static osStatus_t freezeCapture(IMU_Actor_t *this, message_t *message);
+static osStatus_t clearShockSource(IMU_Actor_t *this, message_t *message);
+static osStatus_t skipShock(IMU_Actor_t *this, message_t *message);
+static osStatus_t rearmCapture(IMU_Actor_t *this, message_t *message);
+static osStatus_t extractWindowFeatures(IMU_Actor_t *this, message_t *message);
+static osStatus_t skipWindowFeatures(IMU_Actor_t *this, message_t *message);
+#endif
 
 static int32_t lis2dwCommonConfig(void);
 static int32_t lis2dwConfigLowPower(void);
+static int32_t readFifoBurst(IMU_Actor_t *this, uint8_t *fifoLevel, bool *isOverrun);
+#ifdef IMU_SHOCK_CAPTURE_ENABLED
+static int32_t lis2dwConfigShockCapture(void);
+static int32_t lis2dwFlushFifo(void);
+static int32_t drainFifoToRing(IMU_Actor_t *this, uint16_t samplesLimit, uint16_t *storedCount);
+static int32_t readShockSource(IMU_Actor_t *this, bool *isFreeFall);
+#endif
 // TODO DFT-28 completely OFF configuration for transportation mode
-static int32_t readFifoAndLog(IMU_Actor_t *this);
-static int32_t handleFreeFall(IMU_Actor_t *this);
 
 extern actor_t *ACTORS_LOOKUP_SystemRegistry[MAX_ACTORS];
 
+// FIFO burst read buffer, static to keep the full FIFO (192 bytes) off the task stack
+static uint8_t fifoBurstBuffer[IMU_FIFO_DEPTH * IMU_FIFO_SAMPLE_SIZE];
+#ifdef IMU_SHOCK_CAPTURE_ENABLED
+// the latest ring samples in order, for the vibration features
+static int16_t featuresWindow[VIBRATION_MAX_SAMPLES * IMU_AXES_COUNT];
+#endif
+
+/**
+ * @brief IMU FSM transitions table
+ * @note rendered to the README state diagram by scripts/generate_state_machine_diagrams.py
+ */
+static const FSM_Transition_t imuTransitions[] = {
+  FSM_TRANSITION(IMU_NO_STATE,        GLOBAL_CMD_INITIALIZE,                initialize,             IMU_STATE_IDLE),
+  FSM_TRANSITION(IMU_STATE_IDLE,      IMU_FIFO_WTM,                         readFifoAndLog,         IMU_STATE_IDLE),
+#ifdef IMU_SHOCK_CAPTURE_ENABLED
+  FSM_TRANSITION(IMU_STATE_IDLE,      GLOBAL_CMD_START_CONTINUOUS_SENSING,  armCapture,             IMU_STATE_ARMED),
+  FSM_TRANSITION(IMU_STATE_IDLE,      IMU_WINDOW_FEATURES_REQUEST,          skipWindowFeatures,     IMU_STATE_IDLE),
+  FSM_TRANSITION(IMU_STATE_ARMED,     IMU_FIFO_WTM,                         drainToRing,            IMU_STATE_ARMED),
+  FSM_TRANSITION(IMU_STATE_ARMED,     IMU_SHOCK_DETECTED,                   startCapture,           IMU_STATE_CAPTURING),
+  FSM_TRANSITION(IMU_STATE_ARMED,     IMU_WINDOW_FEATURES_REQUEST,          extractWindowFeatures,  IMU_STATE_ARMED),
+  FSM_TRANSITION(IMU_STATE_ARMED,     GLOBAL_CMD_TURN_OFF,                  disarmCapture,          IMU_STATE_IDLE),
+  FSM_TRANSITION(IMU_STATE_CAPTURING, IMU_FIFO_WTM,                         drainPostTrigger,       IMU_STATE_CAPTURING),
+  FSM_TRANSITION(IMU_STATE_CAPTURING, IMU_SHOCK_DETECTED,                   clearShockSource,       IMU_STATE_CAPTURING),
+  FSM_TRANSITION(IMU_STATE_CAPTURING, IMU_WINDOW_FEATURES_REQUEST,          extractWindowFeatures,  IMU_STATE_CAPTURING),
+  FSM_TRANSITION(IMU_STATE_CAPTURING, IMU_CAPTURE_COMPLETE,                 freezeCapture,          IMU_STATE_FROZEN),
+  FSM_TRANSITION(IMU_STATE_CAPTURING, GLOBAL_CMD_TURN_OFF,                  disarmCapture,          IMU_STATE_IDLE),
+  FSM_TRANSITION(IMU_STATE_FROZEN,    IMU_SHOCK_DETECTED,                   skipShock,              IMU_STATE_FROZEN),
+  FSM_TRANSITION(IMU_STATE_FROZEN,    IMU_WINDOW_FEATURES_REQUEST,          extractWindowFeatures,  IMU_STATE_FROZEN),
+  FSM_TRANSITION(IMU_STATE_FROZEN,    IMU_SHOCK_CAPTURE_STORED,             rearmCapture,           IMU_STATE_ARMED),
+  FSM_TRANSITION(IMU_STATE_ERROR,     IMU_WINDOW_FEATURES_REQUEST,          skipWindowFeatures,     IMU_STATE_ERROR),
+#endif
+  FSM_TRANSITION(IMU_STATE_ERROR,     GLOBAL_CMD_RESTART,                   restart,                IMU_STATE_IDLE),
+};
+
+static const FSM_Table_t imuFSMTable = FSM_TABLE(imuTransitions, NULL);
+
 
 /**
  * @brief IMU Accelerometer actor struct
@@ -62,7 +118,7 @@ const osThreadAttr_t imuTaskDescription = {
         .cb_size = sizeof(imuTaskControlBlock),
         .stack_mem = &imuTaskBuffer[0],
         .stack_size = sizeof(imuTaskBuffer),
-        .priority = (osPriority_t) osPriorityNormal,
+        .priority = (osPriority_t) osPriorityAboveNormal, // 400Hz capture drains the FIFO every 40ms, before the flash writes
 };
 
 /**
@@ -105,86 +161,83 @@ void IMU_Task(void *argument) {
 }
 
 static osStatus_t handleImuFSM(IMU_Actor_t *this, message_t *message) {
-  switch (this->state) {
-    case IMU_NO_STATE:
-      return handleInit(this, message);
-    case IMU_STATE_IDLE:
-      return handleIdle(this, message);
-    case IMU_STATE_ERROR:
-      // TODO implement other states
-      return osOK;
-    default:
-      fprintf(stderr, "%s: Unknown IMU state %lu\n", imuTaskDescription.name, (unsigned long)this->state);
-      return osError;
-  }
+  uint8_t state = this->state;
+  osStatus_t status = FSM_Dispatch(&imuFSMTable, &this->super, message, &state);
+  this->state = state;
+
+  return status;
 }
 
 /**
- * @brief Initializes the sensor, configures I2C, writes default settings, and transitions to the TURNED_OFF state
+ * @brief Initializes the sensor, configures I2C, writes default settings, and transitions to the IDLE state
  */
-static osStatus_t handleInit(IMU_Actor_t *this, message_t *message) {
-  if (GLOBAL_CMD_INITIALIZE == message->event) {
-
-    LIS2DW12_IO_t pIO = {
-      .Init = BSP_I2C1_Init,
-      .DeInit = BSP_I2C1_DeInit, // TODO verify should we use it at all
-      .BusType = LIS2DW12_I2C_BUS,
-      .Address = IMU_I2C_ADDRESS,
-      .WriteReg = SensorsBus_WriteReg,
-      .ReadReg = SensorsBus_ReadReg,
-      .GetTick = BSP_GetTick,
-      .Delay = (void(*)(uint32_t))osDelay // TODO verify should it be in ticks as osDelay or in ms
-    };
-
-    // init the driver (io)
-    osStatus_t ioStatus = LIS2DW12_ERROR;
-    ioStatus = LIS2DW12_RegisterBusIO(&IMU_Actor.lis2dw12, &pIO);
-    if (ioStatus != osOK) return osError;
-
-    // init the sensor itself
-    ioStatus = LIS2DW12_Init(&IMU_Actor.lis2dw12);
-    if (ioStatus != osOK) return osError;
-
-    // smoke test: read device id, should be 0x44 (LIS2DW12_ID)
-    uint8_t lis2dw_id = 0;
-    ioStatus = LIS2DW12_ReadID(&IMU_Actor.lis2dw12, &lis2dw_id);
-
-    if (ioStatus != osOK || lis2dw_id != LIS2DW12_ID) {
-      #ifdef DEBUG
-            fprintf(stdout, "LIS2DW ID: %x does not match 0x44\n", lis2dw_id);
-      #endif
-
-      return ioStatus;
-    }
+static osStatus_t initialize(IMU_Actor_t *this, message_t *message) {
+  LIS2DW12_IO_t pIO = {
+    .Init = BSP_I2C1_Init,
+    .DeInit = BSP_I2C1_DeInit, // TODO verify should we use it at all
+    .BusType = LIS2DW12_I2C_BUS,
+    .Address = IMU_I2C_ADDRESS,
+    .WriteReg = SensorsBus_WriteReg,
+    .ReadReg = SensorsBus_ReadReg,
+    .GetTick = BSP_GetTick,
+    .Delay = (void(*)(uint32_t))osDelay // TODO verify should it be in ticks as osDelay or in ms
+  };
+
+  // init the driver (io)
+  osStatus_t ioStatus = LIS2DW12_ERROR;
+  ioStatus = LIS2DW12_RegisterBusIO(&IMU_Actor.lis2dw12, &pIO);
+  if (ioStatus != osOK) return osError;
+
+  // init the sensor itself
+  ioStatus = LIS2DW12_Init(&IMU_Actor.lis2dw12);
+  if (ioStatus != osOK) return osError;
+
+  // smoke test: read device id, should be 0x44 (LIS2DW12_ID)
+  uint8_t lis2dw_id = 0;
+  ioStatus = LIS2DW12_ReadID(&IMU_Actor.lis2dw12, &lis2dw_id);
+
+  if (ioStatus != osOK || lis2dw_id != LIS2DW12_ID) {
+    #ifdef DEBUG
+          fprintf(stdout, "LIS2DW ID: %x does not match 0x44\n", lis2dw_id);
+    #endif
+
+    return ioStatus;
+  }
 
-    // common configuration
-    ioStatus = lis2dwCommonConfig();
-    if (ioStatus != osOK) return osError;
+  // common configuration
+  ioStatus = lis2dwCommonConfig();
+  if (ioStatus != osOK) return osError;
 
-    // low power 1.6Hz configuration, interrupts on INT1 pin.
-    ioStatus = lis2dwConfigLowPower();
-    if (ioStatus != osOK) return osError;
+  // low power 1.6Hz configuration, interrupts on INT1 pin.
+  ioStatus = lis2dwConfigLowPower();
+  if (ioStatus != osOK) return osError;
 
-    // publish to the event manager that the IMU is initialized
-    osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
-    osMessageQueuePut(evManagerQueue, &(message_t){GLOBAL_INITIALIZE_SUCCESS, .payload.value = IMU_ACTOR_ID}, 0, 0);
+  // publish to the event manager that the IMU is initialized
+  osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
+  osMessageQueuePut(evManagerQueue, &(message_t){GLOBAL_INITIALIZE_SUCCESS, .payload.value = IMU_ACTOR_ID}, 0, 0);
 
-    fprintf(stdout, "IMU %u initialized\n", IMU_ACTOR_ID);
-    TO_STATE(this, IMU_STATE_IDLE);
-  }
+  fprintf(stdout, "IMU %u initialized\n", IMU_ACTOR_ID);
 
   return osOK;
 }
 
-static osStatus_t handleIdle(IMU_Actor_t *this, message_t *message) {
-  switch (message->event) {
-    case IMU_FIFO_WTM:
-      return readFifoAndLog(this);
-    case IMU_FREE_FALL_DETECTED:
-      return handleFreeFall(this);
-    default:
-      return osOK;
+/**
+ * @brief Re-initializes the sensor after the supervised restart
+ *
+ * The restart lands in IDLE, if the capture was armed before the error the start command is posted to itself
+ * so the IDLE row re-arms it.
+ */
+static osStatus_t restart(IMU_Actor_t *this, message_t *message) {
+  osStatus_t status = initialize(this, message);
+  if (status != osOK) return status;
+
+  #ifdef IMU_SHOCK_CAPTURE_ENABLED
+  if (this->isSensing) {
+    osMessageQueuePut(this->super.osMessageQueueId, &(message_t){.event = GLOBAL_CMD_START_CONTINUOUS_SENSING}, 0, 0);
   }
+  #endif
+
+  return osOK;
 }
 
 static int32_t lis2dwCommonConfig(void) {
@@ -230,16 +283,17 @@ static int32_t lis2dwConfigLowPower(void) {
   ret |= lis2dw12_fifo_mode_set(&IMU_Actor.lis2dw12.Ctx, LIS2DW12_STREAM_MODE);
   ret |= lis2dw12_fifo_watermark_set(&IMU_Actor.lis2dw12.Ctx, IMU_16_SAMPLES_BUFFER_SIZE);
 
-  // 3) Route FIFO_WTM interrupt to INT1
+  // 3) FIFO_WTM interrupt is not routed: the acquisition scheduler drains the FIFO on every RTC wake up,
+  //    so the MCU and the bus wake once per cycle. Stream mode keeps the latest 32 samples (20s at 1.6Hz).
   ret |= lis2dw12_pin_int1_route_get(&IMU_Actor.lis2dw12.Ctx, &int_route.ctrl4_int1_pad_ctrl);
 
-  int_route.ctrl4_int1_pad_ctrl.int1_fth = PROPERTY_ENABLE;        // FIFO threshold
+  int_route.ctrl4_int1_pad_ctrl.int1_fth = PROPERTY_DISABLE;       // FIFO threshold
   // int_route.ctrl4_int1_pad_ctrl.int1_drdy = PROPERTY_DISABLE;      // we use WTM instead of DRDY
 
   ret |= lis2dw12_pin_int1_route_set(&IMU_Actor.lis2dw12.Ctx, &int_route.ctrl4_int1_pad_ctrl);
 
 #if DEBUG
-  fprintf(stdout, "IMU: FIFO WTM -> INT1, PM=12b, ODR=1.6Hz, WTM=%d\n", IMU_16_SAMPLES_BUFFER_SIZE);
+  fprintf(stdout, "IMU: PM=12b, ODR=1.6Hz, FIFO stream, WTM=%d not routed\n", IMU_16_SAMPLES_BUFFER_SIZE);
 #endif
 
   return ret;
@@ -247,124 +301,338 @@ static int32_t lis2dwConfigLowPower(void) {
 
 // TODO refine this
 /**
- * @brief Drain LIS2DW12 FIFO and push samples into log storage.
+ * @brief Drain LIS2DW12 FIFO and average the samples.
  *
- * This runs in the IMU actor context (not in IRQ).
+ * This runs in the IMU actor context (not in IRQ), the logged acceleration is read by the acquisition scheduler.
  */
-static int32_t readFifoAndLog(IMU_Actor_t *this)
+static osStatus_t readFifoAndLog(IMU_Actor_t *this, message_t *message)
 {
   uint8_t fifo_level = IMU_EMPTY_FIFO_LEVEL;
-  int32_t ret = osOK;
+  bool isOverrun = false;
   int32_t accum[IMU_AXES_COUNT] = {0};
 
-  stmdev_ctx_t *ctx = &this->lis2dw12.Ctx;
-
-  // 1) Get number of samples currently in FIFO
-  ret = lis2dw12_fifo_data_level_get(ctx, &fifo_level);
+  // 1) Burst read all the samples currently in FIFO
+  int32_t ret = readFifoBurst(this, &fifo_level, &isOverrun);
   if (ret != osOK || fifo_level == IMU_EMPTY_FIFO_LEVEL) {
-#ifdef DEBUG
-    fprintf(stderr, "IMU: FIFO WTM but fifo_level=%u, ret=%ld\n", fifo_level, (long)ret);
-#endif
+    TRACE_LOG("IMU: FIFO WTM but fifo_level=%u, ret=%ld\n", fifo_level, ret);
     return ret;
   }
 
-#ifdef DEBUG
-  fprintf(stdout, "IMU: FIFO WTM, %u samples pending\n", fifo_level);
-#endif
+  TRACE_LOG("IMU: FIFO WTM, %u samples pending\n", fifo_level);
 
-  // 2) Read each sample from FIFO and accumulate to get average
-  uint8_t samples_read = 0;
+  // 2) Unpack and accumulate to get average
   for (uint8_t i = 0; i < fifo_level; i++) {
-    int16_t raw[IMU_AXES_COUNT] = {0};
-
-    ret = lis2dw12_acceleration_raw_get(ctx, raw);
-    if (ret != 0) {
-#ifdef DEBUG
-      fprintf(stderr, "IMU: error reading FIFO sample %u, ret=%ld\n", i, (long)ret);
-#endif
-      break;
-    }
+    const uint8_t *sample = &fifoBurstBuffer[i * IMU_FIFO_SAMPLE_SIZE];
 
     for (size_t axis = 0; axis < IMU_AXES_COUNT; axis++) {
-      accum[axis] += raw[axis];
+      accum[axis] += (int16_t) (sample[2 * axis + 1] << 8 | sample[2 * axis]);
     }
-    samples_read++;
   }
 
-  if (ret == 0 && samples_read > 0) {
-    for (size_t axis = 0; axis < IMU_AXES_COUNT; axis++) {
-      this->lastAcceleration[axis] = (int16_t)(accum[axis] / samples_read);
-    }
-    this->lastFifoLevel = samples_read;
-
-#ifdef DEBUG
-    fprintf(stdout, "IMU averaged raw: X=%d, Y=%d, Z=%d over %u samples\n",
-            this->lastAcceleration[0],
-            this->lastAcceleration[1],
-            this->lastAcceleration[2],
-            samples_read);
-#endif
-
-    // Notify system that IMU data is ready for logging
-    osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
-    osMessageQueuePut(evManagerQueue, &(message_t){GLOBAL_IMU_MEASUREMENTS_READY, .payload.value = samples_read}, 0, 0);
+  for (size_t axis = 0; axis < IMU_AXES_COUNT; axis++) {
+    this->lastAcceleration[axis] = (int16_t)(accum[axis] / fifo_level);
   }
+  this->lastFifoLevel = fifo_level;
 
-  return ret;
+  TRACE_LOG("IMU averaged raw: X=%d, Y=%d, Z=%d over %u samples\n",
+          this->lastAcceleration[0],
+          this->lastAcceleration[1],
+          this->lastAcceleration[2],
+          fifo_level);
+
+  return osOK;
 }
 
-// TODO refine this
 /**
- * @brief Handle free-fall event from LIS2DW12.
+ * @brief Reads all the FIFO samples in a single burst transaction to fifoBurstBuffer
  *
- * Called in IMU actor context after IRQ posted IMU_FREE_FALL_DETECTED.
+ * With the auto-increment the address rolls back from OUT_Z_H to OUT_X_L, so `fifo_level × 6` bytes from
+ * OUT_X_L are consecutive samples. One addressed transfer instead of one per sample holds the sensors bus
+ * mutex ~10 times shorter.
+ *
+ * @param[out] fifoLevel Number of read samples
+ * @param[out] isOverrun The FIFO was full and overwritten since the previous read
  */
-static int32_t handleFreeFall(IMU_Actor_t *this)
-{
+static int32_t readFifoBurst(IMU_Actor_t *this, uint8_t *fifoLevel, bool *isOverrun) {
   stmdev_ctx_t *ctx = &this->lis2dw12.Ctx;
+  lis2dw12_fifo_samples_t fifoSamples = {0};
+
+  int32_t ret = lis2dw12_read_reg(ctx, LIS2DW12_FIFO_SAMPLES, (uint8_t *) &fifoSamples, 1);
+  if (ret != 0) return ret;
+
+  *isOverrun = fifoSamples.fifo_ovr;
+  *fifoLevel = (fifoSamples.diff > IMU_FIFO_DEPTH) ? IMU_FIFO_DEPTH : fifoSamples.diff;
+
+  if (*fifoLevel == IMU_EMPTY_FIFO_LEVEL) return 0;
+
+  return lis2dw12_read_reg(ctx, LIS2DW12_OUT_X_L, fifoBurstBuffer, *fifoLevel * IMU_FIFO_SAMPLE_SIZE);
+}
+
+#ifdef IMU_SHOCK_CAPTURE_ENABLED
+/**
+ * @brief Switches to 400Hz and starts filling the pre-trigger ring
+ */
+static osStatus_t armCapture(IMU_Actor_t *this, message_t *message) {
+  this->isSensing = true;
+  this->ringWriteIndex = 0;
+  this->ringSamplesCount = 0;
+
+  int32_t ret = lis2dwConfigShockCapture()
+              | lis2dwFlushFifo();
+
+  return (ret == 0) ? osOK : osError;
+}
+
+/**
+ * @brief Back to the low power mode, the acquisition scheduler drains the FIFO again
+ */
+static osStatus_t disarmCapture(IMU_Actor_t *this, message_t *message) {
+  this->isSensing = false;
+
+  lis2dw12_reg_t int1Route = {0};
+  lis2dw12_reg_t int2Route = {0};
+  stmdev_ctx_t *ctx = &this->lis2dw12.Ctx;
+
+  int32_t ret = lis2dw12_pin_int1_route_get(ctx, &int1Route.ctrl4_int1_pad_ctrl);
+  int1Route.ctrl4_int1_pad_ctrl.int1_wu = PROPERTY_DISABLE;
+  int1Route.ctrl4_int1_pad_ctrl.int1_ff = PROPERTY_DISABLE;
+  ret |= lis2dw12_pin_int1_route_set(ctx, &int1Route.ctrl4_int1_pad_ctrl);
+
+  ret |= lis2dw12_pin_int2_route_get(ctx, &int2Route.ctrl5_int2_pad_ctrl);
+  int2Route.ctrl5_int2_pad_ctrl.int2_fth = PROPERTY_DISABLE;
+  ret |= lis2dw12_pin_int2_route_set(ctx, &int2Route.ctrl5_int2_pad_ctrl);
+
+  ret |= lis2dwConfigLowPower();
+
+  return (ret == 0) ? osOK : osError;
+}
+
+static osStatus_t drainToRing(IMU_Actor_t *this, message_t *message) {
+  uint16_t storedCount = 0;
+
+  return (drainFifoToRing(this, IMU_FIFO_DEPTH, &storedCount) == 0) ? osOK : osError;
+}
+
+/**
+ * @brief Shock or free-fall on INT1: the samples in the FIFO precede the trigger, the ring keeps the pre-trigger
+ * window and receives IMU_CAPTURE_POST_TRIGGER_SAMPLES more
+ */
+static osStatus_t startCapture(IMU_Actor_t *this, message_t *message) {
+  uint16_t storedCount = 0;
+  bool isFreeFall = false;
+
+  int32_t ret = drainFifoToRing(this, IMU_FIFO_DEPTH, &storedCount)
+              | readShockSource(this, &isFreeFall);
+  if (ret != 0) return osError;
+
+  this->capture.triggerIndex = (this->ringSamplesCount < IMU_CAPTURE_PRE_TRIGGER_SAMPLES)
+                               ? this->ringSamplesCount
+                               : IMU_CAPTURE_PRE_TRIGGER_SAMPLES;
+  this->capture.isFreeFall = isFreeFall;
+  this->capture.timestamp = CRON_GetCurrentUnixTimestamp();
+  this->capture.triggerTick = osKernelGetTickCount();
+  this->postTriggerRemaining = IMU_CAPTURE_POST_TRIGGER_SAMPLES;
+
+  TRACE_LOG("IMU: trigger, free-fall=%u, %u pre-trigger samples\n", isFreeFall, this->capture.triggerIndex);
+
+  return osOK;
+}
+
+/**
+ * @brief Stores the post-trigger samples, the overshoot of the last drain is dropped to keep the pre-trigger ones
+ */
+static osStatus_t drainPostTrigger(IMU_Actor_t *this, message_t *message) {
+  uint16_t storedCount = 0;
+
+  if (drainFifoToRing(this, this->postTriggerRemaining, &storedCount) != 0) return osError;
+
+  this->postTriggerRemaining -= storedCount;
+
+  if (this->postTriggerRemaining == 0) {
+    osMessageQueuePut(this->super.osMessageQueueId, &(message_t){IMU_CAPTURE_COMPLETE}, 0, 0);
+  }
+
+  return osOK;
+}
+
+/**
+ * @brief Freezes the ring and passes the capture to the MEMORY actor
+ */
+static osStatus_t freezeCapture(IMU_Actor_t *this, message_t *message) {
+  this->capture.ring = (const int16_t (*)[IMU_AXES_COUNT]) this->ring;
+  this->capture.samplesCount = this->capture.triggerIndex + IMU_CAPTURE_POST_TRIGGER_SAMPLES;
+  this->capture.startIndex = (this->ringWriteIndex + IMU_CAPTURE_RING_SAMPLES - this->capture.samplesCount) % IMU_CAPTURE_RING_SAMPLES;
+
+  TRACE_LOG("IMU: capture of %u samples frozen, %lu FIFO overruns\n", this->capture.samplesCount, this->fifoOverruns);
+
+  osMessageQueueId_t memoryQueue = ACTORS_LOOKUP_SystemRegistry[MEMORY_ACTOR_ID]->osMessageQueueId;
+  osStatus_t status = osMessageQueuePut(memoryQueue, &(message_t){MEMORY_SHOCK_CAPTURE_WRITE, .payload.ptr = &this->capture}, 0, 0);
+
+  // nobody would release the ring
+  if (status != osOK) osMessageQueuePut(this->super.osMessageQueueId, &(message_t){IMU_SHOCK_CAPTURE_STORED, .payload.value = osError}, 0, 0);
+
+  return osOK;
+}
+
+/**
+ * @brief Releases the latched INT1, the shock is inside the window being captured
+ */
+static osStatus_t clearShockSource(IMU_Actor_t *this, message_t *message) {
+  bool isFreeFall = false;
+
+  return (readShockSource(this, &isFreeFall) == 0) ? osOK : osError;
+}
+
+/**
+ * @brief The ring is still being stored, the shock is not captured
+ */
+static osStatus_t skipShock(IMU_Actor_t *this, message_t *message) {
+  this->missedShocks++;
+
+  TRACE_LOG("IMU: shock missed while storing, %lu total\n", this->missedShocks);
+
+  return clearShockSource(this, message);
+}
+
+/**
+ * @brief The capture is stored, the FIFO kept overwriting itself meanwhile: flush it to re-arm the INT2 edge
+ */
+static osStatus_t rearmCapture(IMU_Actor_t *this, message_t *message) {
+  TRACE_LOG("IMU: capture stored, status %ld\n", (int32_t) message->payload.value);
+
+  this->ringWriteIndex = 0;
+  this->ringSamplesCount = 0;
+
+  return (lis2dwFlushFifo() == 0) ? osOK : osError;
+}
+
+/**
+ * @brief The acquisition scheduler can't read the FIFO owned by the capture, the window features are computed
+ * from the latest ring samples instead
+ *
+ * @note VIBRATION_ExtractFeatures() isn't reentrant, it's called only from here while the capture is enabled
+ */
+static osStatus_t extractWindowFeatures(IMU_Actor_t *this, message_t *message) {
+  uint16_t samplesCount = (this->ringSamplesCount < VIBRATION_MAX_SAMPLES) ? this->ringSamplesCount : VIBRATION_MAX_SAMPLES;
+  uint16_t index = (this->ringWriteIndex + IMU_CAPTURE_RING_SAMPLES - samplesCount) % IMU_CAPTURE_RING_SAMPLES;
+
+  for (uint16_t i = 0; i < samplesCount; i++) {
+    memcpy(&featuresWindow[i * IMU_AXES_COUNT], this->ring[index], sizeof(this->ring[index]));
+    index = (index + 1) % IMU_CAPTURE_RING_SAMPLES;
+  }
+
+  VIBRATION_ExtractFeatures(featuresWindow, samplesCount, (VIBRATION_Features_t *) message->payload.ptr);
+
+  osMessageQueueId_t acquisitionQueue = ACTORS_LOOKUP_SystemRegistry[ACQUISITION_ACTOR_ID]->osMessageQueueId;
+  osMessageQueuePut(acquisitionQueue, &(message_t){ACQUISITION_WINDOW_FEATURES_READY, .payload.value = samplesCount}, 0, 0);
+
+  return osOK;
+}
+
+/**
+ * @brief No ring while disarmed or in the error backoff, answers with 0 samples so the acquisition batch doesn't
+ * wait for its timeout
+ */
+static osStatus_t skipWindowFeatures(IMU_Actor_t *this, message_t *message) {
+  memset(message->payload.ptr, 0, sizeof(VIBRATION_Features_t));
+
+  osMessageQueueId_t acquisitionQueue = ACTORS_LOOKUP_SystemRegistry[ACQUISITION_ACTOR_ID]->osMessageQueueId;
+  osMessageQueuePut(acquisitionQueue, &(message_t){ACQUISITION_WINDOW_FEATURES_READY, .payload.value = 0}, 0, 0);
+
+  return osOK;
+}
+
+/**
+ * @brief 400Hz high performance mode, shock (wake-up) and free-fall on INT1, FIFO threshold on INT2
+ *
+ * The wake-up and free-fall events can't be routed to INT2 on the LIS2DW12, so the FIFO threshold takes it.
+ */
+static int32_t lis2dwConfigShockCapture(void) {
   int32_t ret = 0;
+  lis2dw12_reg_t int1Route = {0};
+  lis2dw12_reg_t int2Route = {0};
+  stmdev_ctx_t *ctx = &IMU_Actor.lis2dw12.Ctx;
+
+  // 1) ODR above 200Hz is available in the high performance mode only
+  ret |= lis2dw12_power_mode_set(ctx, LIS2DW12_HIGH_PERFORMANCE);
+  ret |= lis2dw12_data_rate_set(ctx, LIS2DW12_XL_ODR_400Hz);
+
+  // 2) FIFO stream, drained on the watermark
+  ret |= lis2dw12_fifo_watermark_set(ctx, IMU_CAPTURE_FIFO_WATERMARK);
+
+  // 3) Triggers: shock over the high-pass filtered acceleration, drop as free-fall
+  ret |= lis2dw12_wkup_threshold_set(ctx, IMU_CAPTURE_WAKE_UP_THRESHOLD);
+  ret |= lis2dw12_wkup_dur_set(ctx, 0);
+  ret |= lis2dw12_ff_threshold_set(ctx, LIS2DW12_FF_TSH_10LSb_FS2g);
+  ret |= lis2dw12_ff_dur_set(ctx, IMU_CAPTURE_FREE_FALL_DURATION);
+
+  // 4) Interrupts routing
+  ret |= lis2dw12_pin_int1_route_get(ctx, &int1Route.ctrl4_int1_pad_ctrl);
+  int1Route.ctrl4_int1_pad_ctrl.int1_wu = PROPERTY_ENABLE;
+  int1Route.ctrl4_int1_pad_ctrl.int1_ff = PROPERTY_ENABLE;
+  int1Route.ctrl4_int1_pad_ctrl.int1_fth = PROPERTY_DISABLE;
+  ret |= lis2dw12_pin_int1_route_set(ctx, &int1Route.ctrl4_int1_pad_ctrl);
+
+  ret |= lis2dw12_pin_int2_route_get(ctx, &int2Route.ctrl5_int2_pad_ctrl);
+  int2Route.ctrl5_int2_pad_ctrl.int2_fth = PROPERTY_ENABLE;
+  ret |= lis2dw12_pin_int2_route_set(ctx, &int2Route.ctrl5_int2_pad_ctrl);
 
-#ifdef DEBUG
-  fprintf(stdout, "IMU: free-fall event received\n");
+#if DEBUG
+  fprintf(stdout, "IMU: PM=HP, ODR=%dHz, FIFO stream, WTM=%d on INT2, shock/free-fall on INT1\n", IMU_CAPTURE_ODR_HZ, IMU_CAPTURE_FIFO_WATERMARK);
 #endif
 
-  // 1) Read and clear free-fall source / all sources.
-  //    Exact function names depend on your driver version.
-  //    Typical pattern in ST libs:
-  //      lis2dw12_all_sources_t src;
-  //      lis2dw12_all_sources_get(ctx, &src);
-  //
-  // For now, leave as TODO so you can wire to your actual reg helpers.
+  return ret;
+}
 
-  // TODO: replace with actual source read that clears the FF interrupt
-  // lis2dw12_all_sources_t all_src;
-  // ret = lis2dw12_all_sources_get(ctx, &all_src);
+/**
+ * @brief Empties the FIFO through the bypass mode, the threshold level drops and INT2 can rise again
+ */
+static int32_t lis2dwFlushFifo(void) {
+  return lis2dw12_fifo_mode_set(&IMU_Actor.lis2dw12.Ctx, LIS2DW12_BYPASS_MODE)
+       | lis2dw12_fifo_mode_set(&IMU_Actor.lis2dw12.Ctx, LIS2DW12_STREAM_MODE);
+}
 
-  // (void)ctx;
-  // (void)ret;
+/**
+ * @brief Drains the FIFO and appends up to `samplesLimit` samples to the ring
+ */
+static int32_t drainFifoToRing(IMU_Actor_t *this, uint16_t samplesLimit, uint16_t *storedCount) {
+  uint8_t fifoLevel = IMU_EMPTY_FIFO_LEVEL;
+  bool isOverrun = false;
 
-  // 2) Notify Event Manager (or Logger Manager) that a free-fall happened.
-  //    This mirrors how you already publish GLOBAL_INITIALIZE_SUCCESS.
-  // osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
+  int32_t ret = readFifoBurst(this, &fifoLevel, &isOverrun);
+  if (ret != 0) return ret;
 
-  // message_t ev = {
-    // .event = IMU_FREE_FALL_DETECTED,
-    // .payload.value = 0  // you can encode severity, timestamp index, etc.
-  // };
+  if (isOverrun) {
+    this->fifoOverruns++;
+    TRACE_LOG("IMU: FIFO overrun, %lu total\n", this->fifoOverruns);
+  }
 
-  // osMessageQueuePut(evManagerQueue, &ev, 0, 0);
+  *storedCount = (fifoLevel < samplesLimit) ? fifoLevel : samplesLimit;
 
-#ifdef DEBUG
-  fprintf(stdout, "IMU: free-fall event forwarded to EV_MANAGER\n");
-#endif
+  for (uint16_t i = 0; i < *storedCount; i++) {
+    const uint8_t *sample = &fifoBurstBuffer[i * IMU_FIFO_SAMPLE_SIZE];
+    int16_t *ringSample = this->ring[this->ringWriteIndex];
 
-  // 3) Optional policy:
-  //    - you might want to force a FIFO dump here (pre/post impact data),
-  //      or temporarily switch IMU mode, or set some global "drop detected" flag.
-  //
-  // Example:
-  // readFifoAndLog(this);
+    for (uint8_t axis = 0; axis < IMU_AXES_COUNT; axis++) {
+      ringSample[axis] = (int16_t) (sample[2 * axis + 1] << 8 | sample[2 * axis]);
+    }
 
-  return ret;
+    this->ringWriteIndex = (this->ringWriteIndex + 1) % IMU_CAPTURE_RING_SAMPLES;
+    this->ringSamplesCount++;
+  }
+
+  return 0;
 }
 
+/**
+ * @brief Reads the event sources, releases the latched INT1
+ */
+static int32_t readShockSource(IMU_Actor_t *this, bool *isFreeFall) {
+  lis2dw12_all_sources_t sources = {0};
+
+  int32_t ret = lis2dw12_all_sources_get(&this->lis2dw12.Ctx, &sources);
+  *isFreeFall = sources.wake_up_src.ff_ia;
+
+  return ret;
+}
+#endif
@@ -26,29 +26,73 @@ extern "C" {
 
 #include <stdio.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
 
 #include "main.h"
 #include "lis2dw12.h"
+#include "fsm.h"
+#include "vibration_features.h"
 
 #define IMU_I2C_ADDRESS (LIS2DW12_I2C_ADD_H) // SA0 connected to VDD
 #define IMU_16_SAMPLES_BUFFER_SIZE (16) // number of samples to read from FIFO at once, note DO not set 32 because imu immediately overflows
 #define IMU_AXES_COUNT (3)
+#define IMU_FIFO_DEPTH (32) // LIS2DW12 FIFO samples
+#define IMU_FIFO_SAMPLE_SIZE (6) // X, Y, Z little endian 16 bit words from OUT_X_L
 
 #define IMU_EMPTY_FIFO_LEVEL (0)
 
+// Shock capture mode, enabled by the IMU_SHOCK_CAPTURE_ENABLED build flag
+#define IMU_CAPTURE_ODR_HZ                (400)
+#define IMU_CAPTURE_FULL_SCALE_G          (2)
+#define IMU_CAPTURE_PRE_TRIGGER_SAMPLES   (256) // 640ms at 400Hz
+#define IMU_CAPTURE_POST_TRIGGER_SAMPLES  (256) // 640ms at 400Hz
+#define IMU_CAPTURE_RING_SAMPLES          (IMU_CAPTURE_PRE_TRIGGER_SAMPLES + IMU_CAPTURE_POST_TRIGGER_SAMPLES)
+#define IMU_CAPTURE_FIFO_WATERMARK        (16)  // 40ms at 400Hz, the other half of the FIFO is the drain latency margin
+#define IMU_CAPTURE_WAKE_UP_THRESHOLD     (16)  // FS/64 per LSB, 500mg of the high-pass filtered acceleration at ±2g
+#define IMU_CAPTURE_FREE_FALL_DURATION    (12)  // 1/ODR per LSB, 30ms at 400Hz
+
 typedef enum {
   IMU_NO_STATE = 0,
-  IMU_STATE_IDLE,
+  IMU_STATE_IDLE, ///< Low power 1.6Hz, the FIFO is drained by the acquisition scheduler
+  IMU_STATE_ARMED, ///< 400Hz, the FIFO is drained to the pre-trigger ring, waiting for a shock or a free-fall
+  IMU_STATE_CAPTURING, ///< Triggered, draining the post-trigger samples
+  IMU_STATE_FROZEN, ///< The ring is frozen until the MEMORY stores the capture
   IMU_STATE_ERROR,
   IMU_MAX_STATE
 } IMU_State_t;
 
+/**
+ * @brief Frozen shock capture, passed to the MEMORY actor
+ * @note The ring is not written until IMU_SHOCK_CAPTURE_STORED
+ */
+typedef struct {
+  const int16_t (*ring)[IMU_AXES_COUNT]; ///< Ring of IMU_CAPTURE_RING_SAMPLES XYZ samples
+  uint16_t startIndex; ///< Oldest sample of the capture in the ring
+  uint16_t samplesCount;
+  uint16_t triggerIndex; ///< Samples before the trigger
+  uint8_t isFreeFall; ///< Free-fall trigger, wake-up (shock) otherwise
+  int32_t timestamp; ///< UNIX timestamp of the trigger
+  uint32_t triggerTick;
+} IMU_ShockCapture_t;
+
 typedef struct {
   actor_t super;
   IMU_State_t state;
   LIS2DW12_Object_t lis2dw12;
   int16_t lastAcceleration[IMU_AXES_COUNT]; ///< Averaged accelerometer sample from the last FIFO drain
   uint8_t lastFifoLevel; ///< Number of samples processed during the last FIFO drain
+  #ifdef IMU_SHOCK_CAPTURE_ENABLED
+  // shock capture, the 3KB ring isn't reserved without it
+  int16_t ring[IMU_CAPTURE_RING_SAMPLES][IMU_AXES_COUNT]; ///< Pre-trigger ring at the capture ODR
+  uint16_t ringWriteIndex;
+  uint32_t ringSamplesCount; ///< Samples written to the ring since arming
+  uint16_t postTriggerRemaining;
+  uint32_t fifoOverruns; ///< FIFO overruns while armed, i.e. dropped samples
+  uint32_t missedShocks; ///< Shocks arrived while the previous capture was being stored
+  IMU_ShockCapture_t capture;
+  bool isSensing; ///< The capture was armed by the continuous sensing, re-armed after the supervised restart
+  #endif
 } IMU_Actor_t;
 
 extern IMU_Actor_t IMU_Actor;
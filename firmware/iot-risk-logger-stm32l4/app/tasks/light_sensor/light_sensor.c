@@ -8,17 +8,46 @@
  * @author artempolisskyi
  */
 
+#include <inttypes.h>
+
 #include "light_sensor.h"
 
 static osStatus_t handleLightSensorFSM(LIGHT_SENS_Actor_t *this, message_t *message);
-/** states handlers */
-static osStatus_t handleInit(LIGHT_SENS_Actor_t *this, message_t *message);
-static osStatus_t handleTurnedOff(LIGHT_SENS_Actor_t *this, message_t *message);
-static osStatus_t handleContinuousMeasure(LIGHT_SENS_Actor_t *this, message_t *message);
-static osStatus_t handleOutOfRange(LIGHT_SENS_Actor_t *this, message_t *message);
+/** transitions actions */
+static osStatus_t initialize(LIGHT_SENS_Actor_t *this, message_t *message);
+static osStatus_t restart(LIGHT_SENS_Actor_t *this, message_t *message);
+static osStatus_t startSingleShot(LIGHT_SENS_Actor_t *this, message_t *message);
+static osStatus_t readSingleShotLux(LIGHT_SENS_Actor_t *this, message_t *message);
+static osStatus_t cancelSingleShot(LIGHT_SENS_Actor_t *this, message_t *message);
+static osStatus_t startPipelinedMeasure(LIGHT_SENS_Actor_t *this, message_t *message);
+static osStatus_t setHighLimit(LIGHT_SENS_Actor_t *this, message_t *message);
+static osStatus_t turnOff(LIGHT_SENS_Actor_t *this, message_t *message);
+static osStatus_t swapLimitsOnHighLimitExceed(LIGHT_SENS_Actor_t *this, message_t *message);
+static osStatus_t restoreLimitsOnLuxInRange(LIGHT_SENS_Actor_t *this, message_t *message);
 
 extern actor_t* ACTORS_LOOKUP_SystemRegistry[MAX_ACTORS];
 
+/**
+ * @brief Light Sensor FSM transitions table
+ * @note rendered to the README state diagram by scripts/generate_state_machine_diagrams.py
+ */
+static const FSM_Transition_t lightSensorTransitions[] = {
+  FSM_TRANSITION(LIGHT_SENS_NO_STATE,                 GLOBAL_CMD_INITIALIZE,                initialize,                   LIGHT_SENS_TURNED_OFF_STATE),
+  FSM_TRANSITION(LIGHT_SENS_TURNED_OFF_STATE,         LIGHT_SENS_SINGLE_SHOT_READ,          startSingleShot,              LIGHT_SENS_SINGLE_SHOT_STATE),
+  FSM_TRANSITION(LIGHT_SENS_TURNED_OFF_STATE,         LIGHT_SENS_SET_LIMIT,                 setHighLimit,                 LIGHT_SENS_TURNED_OFF_STATE),
+  FSM_TRANSITION(LIGHT_SENS_TURNED_OFF_STATE,         GLOBAL_CMD_START_CONTINUOUS_SENSING,  startPipelinedMeasure,       LIGHT_SENS_CONTINUOUS_MEASURE_STATE),
+  FSM_TRANSITION(LIGHT_SENS_SINGLE_SHOT_STATE,        LIGHT_SENS_INT,                       readSingleShotLux,            LIGHT_SENS_TURNED_OFF_STATE),
+  FSM_TRANSITION(LIGHT_SENS_SINGLE_SHOT_STATE,        LIGHT_SENS_CONVERSION_TIMEOUT,        readSingleShotLux,            LIGHT_SENS_TURNED_OFF_STATE),
+  FSM_TRANSITION(LIGHT_SENS_SINGLE_SHOT_STATE,        LIGHT_SENS_TURN_OFF,                  cancelSingleShot,             LIGHT_SENS_TURNED_OFF_STATE),
+  FSM_TRANSITION(LIGHT_SENS_CONTINUOUS_MEASURE_STATE, LIGHT_SENS_INT,                       swapLimitsOnHighLimitExceed,  LIGHT_SENS_OUT_OF_RANGE_STATE),
+  FSM_TRANSITION(LIGHT_SENS_CONTINUOUS_MEASURE_STATE, LIGHT_SENS_TURN_OFF,                  turnOff,                      LIGHT_SENS_TURNED_OFF_STATE),
+  FSM_TRANSITION(LIGHT_SENS_OUT_OF_RANGE_STATE,       LIGHT_SENS_INT,                       restoreLimitsOnLuxInRange,    LIGHT_SENS_CONTINUOUS_MEASURE_STATE),
+  FSM_TRANSITION(LIGHT_SENS_OUT_OF_RANGE_STATE,       LIGHT_SENS_TURN_OFF,                  turnOff,                      LIGHT_SENS_TURNED_OFF_STATE),
+  FSM_TRANSITION(LIGHT_SENS_STATE_ERROR,              GLOBAL_CMD_RESTART,                   restart,                      LIGHT_SENS_TURNED_OFF_STATE),
+};
+
+static const FSM_Table_t lightSensorFSMTable = FSM_TABLE(lightSensorTransitions, NULL);
+
 /**
  * @brief Light Sensor actor struct
  * @extends actor_t
@@ -32,7 +61,8 @@ LIGHT_SENS_Actor_t LIGHT_SENS_Actor = {
         },
         .state = LIGHT_SENS_NO_STATE,
         .rawLux = 0x0000,                       ///< raw light value
-        .highLimit = OPT3001_CONFIG_LIMIT_MAX   ///< high threshold limit for light sensor
+        .highLimit = OPT3001_CONFIG_LIMIT_MAX,  ///< high threshold limit for light sensor
+        .isSensing = false
 };
 
 // task description required for static task creation
@@ -87,209 +117,202 @@ void LIGHT_SENS_Task(void *argument) {
 }
 
 static osStatus_t handleLightSensorFSM(LIGHT_SENS_Actor_t *this, message_t *message) {
-  switch (this->state) {
-    case LIGHT_SENS_NO_STATE:
-      return handleInit(this, message);
-    case LIGHT_SENS_TURNED_OFF_STATE:
-      return handleTurnedOff(this, message);
-    case LIGHT_SENS_CONTINUOUS_MEASURE_STATE:
-      return handleContinuousMeasure(this, message);
-    case LIGHT_SENS_OUT_OF_RANGE_STATE:
-      return handleOutOfRange(this, message);
-  }
+  if (ACTOR_TIMER_IsStaleExpiry(&this->timer, message)) return osOK;
 
-  return osOK;
+  uint8_t state = this->state;
+  osStatus_t status = FSM_Dispatch(&lightSensorFSMTable, &this->super, message, &state);
+  this->state = state;
+
+  return status;
 }
 
 /**
  * @brief Initializes the sensor, configures I2C, writes default settings, and transitions to the TURNED_OFF state
  */
-static osStatus_t handleInit(LIGHT_SENS_Actor_t *this, message_t *message) {
-  if (GLOBAL_CMD_INITIALIZE == message->event) {
-    // init the driver (io)
-    osStatus_t ioStatus = OPT3001_InitIO(LIGHT_SENS_I2C_ADDRESS, SensorsBus_WriteReg, SensorsBus_ReadReg);
+static osStatus_t initialize(LIGHT_SENS_Actor_t *this, message_t *message) {
+  // init the driver (io)
+  osStatus_t ioStatus = OPT3001_InitIO(LIGHT_SENS_I2C_ADDRESS, SensorsBus_WriteReg, SensorsBus_ReadReg);
 
-    if (ioStatus != osOK) return osError;
+  if (ioStatus != osOK) return osError;
 
-    // test read device id
-    uint16_t opt3001Id = 0x0000;
-    ioStatus = OPT3001_ReadDeviceID(&opt3001Id);
+  // test read device id
+  uint16_t opt3001Id = 0x0000;
+  ioStatus = OPT3001_ReadDeviceID(&opt3001Id);
 
-    if (ioStatus != osOK) return osError;
+  if (ioStatus != osOK) return osError;
 
-    #ifdef DEBUG
-      fprintf(stdout, "OPT3001 ID: %x\n", opt3001Id);
-    #endif
+  #ifdef DEBUG
+    fprintf(stdout, "OPT3001 ID: %x\n", opt3001Id);
+  #endif
 
-    // write default config (OPT3001 remains in turned off state)
-    uint16_t opt3001Config = OPT3001_CONFIG_DEFAULT;
+  // write default config (OPT3001 remains in turned off state)
+  uint16_t opt3001Config = OPT3001_CONFIG_DEFAULT;
 
-    ioStatus = OPT3001_WriteConfig(opt3001Config);
+  ioStatus = OPT3001_WriteConfig(opt3001Config);
 
-    if (ioStatus != osOK) return osError;
+  if (ioStatus != osOK) return osError;
 
-    // TODO read it from NOR flash (implement settings manager)
-    // set high limit and minimal low limit so that the sensor never triggers the interrupt on low limit
-    ioStatus = OPT3001_WriteHighLimit(this->highLimit);
-    if (ioStatus != osOK) return osError;
+  // TODO read it from NOR flash (implement settings manager)
+  // set high limit and minimal low limit so that the sensor never triggers the interrupt on low limit
+  ioStatus = OPT3001_WriteHighLimit(this->highLimit);
+  if (ioStatus != osOK) return osError;
 
-    ioStatus = OPT3001_WriteLowLimit(OPT3001_CONFIG_LIMIT_MIN);
-    if (ioStatus != osOK) return osError;
+  ioStatus = OPT3001_WriteLowLimit(OPT3001_CONFIG_LIMIT_MIN);
+  if (ioStatus != osOK) return osError;
 
-    // publish to event manager that the sensor is initialized
-    osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
-    osMessageQueuePut(evManagerQueue, &(message_t){GLOBAL_INITIALIZE_SUCCESS, .payload.value = LIGHT_SENSOR_ACTOR_ID}, 0, 0);
+  // publish to event manager that the sensor is initialized
+  osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
+  osMessageQueuePut(evManagerQueue, &(message_t){GLOBAL_INITIALIZE_SUCCESS, .payload.value = LIGHT_SENSOR_ACTOR_ID}, 0, 0);
 
-    fprintf(stdout, "Light sensor %ul initialized\n", LIGHT_SENSOR_ACTOR_ID);
-    TO_STATE(this, LIGHT_SENS_TURNED_OFF_STATE);
-  }
+  fprintf(stdout, "Light sensor %ul initialized\n", LIGHT_SENSOR_ACTOR_ID);
 
   return osOK;
 }
 
 /**
- * @brief Perform single-shot measurements, set limits, or switch to continuous measurement mode.
+ * @brief Re-initialize the sensor after the supervised restart
+ *
+ * The restart lands in TURNED_OFF, if the continuous sensing was running before the error
+ * the start command is posted to itself so the TURNED_OFF row re-triggers the pipeline.
  */
-static osStatus_t handleTurnedOff(LIGHT_SENS_Actor_t *this, message_t *message) {
-  osStatus_t ioStatus;
-
-  switch (message->event) {
-    case LIGHT_SENS_SINGLE_SHOT_READ:
-      // set single shot mode
-      ioStatus = OPT3001_WriteConfig(OPT3001_CONFIG_RANGE_NUMBER_AUTO_SCALE | \
-                                    OPT3001_CONFIG_CONVERSION_TIME_800_MS | \
-                                    OPT3001_CONFIG_MODE_SINGLE_SHOT | \
-                                    OPT3001_CONFIG_LATCH_ENABLED);
-
-      if (ioStatus != osOK) return osError;
-
-      // wait for the sensor to finish the measurement
-      osDelay(1000); // TODO replace with 800ms
-
-      // read the measured rawLux
-      ioStatus = OPT3001_ReadResultRawLux(&this->rawLux);
-
-      if (ioStatus != osOK) return osError;
-
-      // convert rawLux to lux for debug
-      fprintf(stdout, "OPT3001 milli Lux: %ld\n", OPT3001_RawToMilliLux(this->rawLux));
-
-      // remains in turned off state after successful read, opt3001 turns off automatically after single shot read
-      TO_STATE(this, LIGHT_SENS_TURNED_OFF_STATE);
-      return osOK;
-    case GLOBAL_CMD_START_CONTINUOUS_SENSING:
-      // set continuous measurements mode
-      ioStatus = OPT3001_WriteConfig(OPT3001_CONFIG_RANGE_NUMBER_AUTO_SCALE | \
-                                    OPT3001_CONFIG_CONVERSION_TIME_800_MS | \
-                                    OPT3001_CONFIG_MODE_CONTINUOUS | \
-                                    OPT3001_CONFIG_FAULT_COUNT_4 | \
-                                    OPT3001_CONFIG_LATCH_ENABLED);
-
-      if (ioStatus != osOK) return osError;
-
-      TO_STATE(this, LIGHT_SENS_CONTINUOUS_MEASURE_STATE);
-      return osOK;
-    case LIGHT_SENS_SET_LIMIT:
-      // set high limit from message payload
-      this->highLimit = message->payload.value;
-      ioStatus = OPT3001_WriteHighLimit(this->highLimit);
-
-      if (ioStatus != osOK) return osError;
-
-      TO_STATE(this, LIGHT_SENS_TURNED_OFF_STATE);
-      return osOK;
+static osStatus_t restart(LIGHT_SENS_Actor_t *this, message_t *message) {
+  osStatus_t status = initialize(this, message);
+  if (status != osOK) return status;
+
+  if (this->isSensing) {
+    osMessageQueuePut(this->super.osMessageQueueId, &(message_t){.event = GLOBAL_CMD_START_CONTINUOUS_SENSING}, 0, 0);
   }
 
   return osOK;
-};
+}
 
 /**
- * @brief Cron read sensor data periodically, handle limit interrupts, or turn off the sensor.
+ * @brief Start 100ms single-shot measurement, the result is read on the end-of-conversion interrupt
  */
-static osStatus_t handleContinuousMeasure(LIGHT_SENS_Actor_t *this, message_t *message) {
-  osStatus_t ioStatus;
-
-  switch (message->event) {
-    case GLOBAL_WAKE_N_READ:
-      // read the measured rawLux on RTC cron
-      ioStatus = OPT3001_ReadResultRawLux(&this->rawLux);
-      if (ioStatus != osOK) return osError;
-
-      #ifdef DEBUG
-        fprintf(stdout, "milliLux %lu\n", OPT3001_RawToMilliLux(this->rawLux));
-      #endif
-
-      // publish to event manager that lux measurement is ready with the pointer to the LIGHT actor
-      osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
-      osMessageQueuePut(evManagerQueue, &(message_t){GLOBAL_LIGHT_MEASUREMENTS_READY, .payload.ptr = this /* LIGHT Actor */}, 0, 0);
-
-      TO_STATE(this, LIGHT_SENS_CONTINUOUS_MEASURE_STATE);
-      return osOK;
-    case LIGHT_SENS_TURN_OFF:
-      // turn off the sensor
-      ioStatus = OPT3001_WriteConfig(OPT3001_CONFIG_DEFAULT | OPT3001_CONFIG_MODE_SHUTDOWN);
-
-      if (ioStatus != osOK) return osError;
-
-      TO_STATE(this, LIGHT_SENS_TURNED_OFF_STATE);
-      return osOK;
-    case LIGHT_SENS_LIMIT_INT:
-      // read the measured rawLux overvalue
-      ioStatus = OPT3001_ReadResultRawLux(&this->rawLux);
-      if (ioStatus != osOK) return osError;
-
-      // TODO emit to event manager LIGHT_SENS_LIMIT_INT with this->rawLux payload
-
-      // swap limits to wait for lux returning below the high limit
-      ioStatus = OPT3001_WriteHighLimit(OPT3001_CONFIG_LIMIT_MAX)
-      | OPT3001_WriteLowLimit(this->highLimit);
-      if (ioStatus != osOK) return osError;
-
-      TO_STATE(this, LIGHT_SENS_OUT_OF_RANGE_STATE);
-      return osOK;
-  }
+static osStatus_t startSingleShot(LIGHT_SENS_Actor_t *this, message_t *message) {
+  uint16_t config = 0x0000;
+
+  // switch INT pin to the end-of-conversion mode, release the INT pin latched before
+  osStatus_t ioStatus = OPT3001_EnableEndOfConversionInterrupt()
+                      | OPT3001_ReadConfig(&config);
+  if (ioStatus != osOK) return osError;
+
+  ioStatus = OPT3001_WriteConfig(LIGHT_SENS_SINGLE_SHOT_CONFIG);
+  if (ioStatus != osOK) return osError;
+
+  // fallback if the interrupt is lost, the thread sleeps until one of them
+  return ACTOR_TIMER_StartOneShot(&this->timer, LIGHT_SENSOR_ACTOR_ID, LIGHT_SENS_CONVERSION_TIMEOUT, LIGHT_SENS_SINGLE_SHOT_TIMEOUT_MS);
+}
+
+/**
+ * @brief Read the single-shot result, opt3001 turns off automatically after single shot read
+ */
+static osStatus_t readSingleShotLux(LIGHT_SENS_Actor_t *this, message_t *message) {
+  uint16_t config = 0x0000;
+
+  ACTOR_TIMER_Stop(&this->timer);
+
+  // read the measured rawLux and release the INT pin
+  osStatus_t ioStatus = OPT3001_ReadResultRawLux(&this->rawLux)
+                      | OPT3001_ReadConfig(&config);
+  if (ioStatus != osOK) return osError;
+
+  // back to the limits interrupt mode
+  ioStatus = OPT3001_WriteLowLimit(OPT3001_CONFIG_LIMIT_MIN);
+  if (ioStatus != osOK) return osError;
+
+  // convert rawLux to lux for debug
+  fprintf(stdout, "OPT3001 centi Lux: %" PRIu32 "\n", OPT3001_RawToCentiLux(this->rawLux));
 
   return osOK;
 }
 
 /**
- * @brief Handle limit interrupts, or turn off the sensor.
- * Continuing proceed Cron read even if out of range
+ * @brief Abort the running single-shot conversion
  */
-static osStatus_t handleOutOfRange(LIGHT_SENS_Actor_t *this, message_t *message) {
-  osStatus_t ioStatus;
-
-  switch (message->event) {
-    case GLOBAL_WAKE_N_READ:
-      // still read the measured rawLux on RTC cron
-      ioStatus = OPT3001_ReadResultRawLux(&this->rawLux);
-      if (ioStatus != osOK) return osError;
-
-      TO_STATE(this, LIGHT_SENS_OUT_OF_RANGE_STATE);
-      return osOK;
-    case LIGHT_SENS_TURN_OFF:
-      // turn off the sensor
-      ioStatus = OPT3001_WriteConfig(OPT3001_CONFIG_DEFAULT | OPT3001_CONFIG_MODE_SHUTDOWN);
-
-      if (ioStatus != osOK) return osError;
-
-      TO_STATE(this, LIGHT_SENS_TURNED_OFF_STATE);
-      return osOK;
-    case LIGHT_SENS_LIMIT_INT:
-      // read the measured rawLux OK overvalue
-      ioStatus = OPT3001_ReadResultRawLux(&this->rawLux);
-      if (ioStatus != osOK) return osError;
-      // TODO emit to event manager LIGHT_SENS_LIMIT_INT with this->rawLux payload, handle that this is OK value
-
-      // swap limits back to normal
-      ioStatus = OPT3001_WriteHighLimit(this->highLimit)
-               | OPT3001_WriteLowLimit(OPT3001_CONFIG_LIMIT_MIN);
-      if (ioStatus != osOK) return osError;
-
-      // back to continuous measure state
-      TO_STATE(this, LIGHT_SENS_CONTINUOUS_MEASURE_STATE);
-      return osOK;
-  }
+static osStatus_t cancelSingleShot(LIGHT_SENS_Actor_t *this, message_t *message) {
+  ACTOR_TIMER_Stop(&this->timer);
+
+  return turnOff(this, message);
+}
+
+/**
+ * @brief Trigger the first single-shot conversion of the measurements pipeline
+ *
+ * The acquisition scheduler reads the result register on every wake up and re-triggers the next 100ms
+ * single-shot conversion, the sensor is in shutdown for the rest of the wake up period.
+ * Every conversion is compared against the limits, in and out of the limits range.
+ */
+static osStatus_t startPipelinedMeasure(LIGHT_SENS_Actor_t *this, message_t *message) {
+  this->isSensing = true;
+
+  osStatus_t ioStatus = OPT3001_WriteConfig(LIGHT_SENS_SINGLE_SHOT_CONFIG);
+
+  if (ioStatus != osOK) return osError;
+
+  return osOK;
+}
+
+/**
+ * @brief Set high limit from message payload
+ */
+static osStatus_t setHighLimit(LIGHT_SENS_Actor_t *this, message_t *message) {
+  this->highLimit = message->payload.value;
+  osStatus_t ioStatus = OPT3001_WriteHighLimit(this->highLimit);
+
+  if (ioStatus != osOK) return osError;
+
+  return osOK;
+}
+
+/**
+ * @brief Turn off the sensor
+ */
+static osStatus_t turnOff(LIGHT_SENS_Actor_t *this, message_t *message) {
+  this->isSensing = false;
+
+  osStatus_t ioStatus = OPT3001_WriteConfig(OPT3001_CONFIG_DEFAULT | OPT3001_CONFIG_MODE_SHUTDOWN);
+
+  if (ioStatus != osOK) return osError;
+
+  return osOK;
+}
+
+/**
+ * @brief Lux exceeded the high limit, swap limits to wait for lux returning below the high limit
+ */
+static osStatus_t swapLimitsOnHighLimitExceed(LIGHT_SENS_Actor_t *this, message_t *message) {
+  uint16_t config = 0x0000;
+
+  // read the measured rawLux overvalue and release the INT pin
+  osStatus_t ioStatus = OPT3001_ReadResultRawLux(&this->rawLux)
+                      | OPT3001_ReadConfig(&config);
+  if (ioStatus != osOK) return osError;
+
+  // TODO emit to event manager LIGHT_SENS_INT with this->rawLux payload
+
+  ioStatus = OPT3001_WriteHighLimit(OPT3001_CONFIG_LIMIT_MAX)
+           | OPT3001_WriteLowLimit(this->highLimit);
+  if (ioStatus != osOK) return osError;
+
+  return osOK;
+}
+
+/**
+ * @brief Lux returned below the high limit, swap limits back to normal
+ */
+static osStatus_t restoreLimitsOnLuxInRange(LIGHT_SENS_Actor_t *this, message_t *message) {
+  uint16_t config = 0x0000;
+
+  // read the measured rawLux OK overvalue and release the INT pin
+  osStatus_t ioStatus = OPT3001_ReadResultRawLux(&this->rawLux)
+                      | OPT3001_ReadConfig(&config);
+  if (ioStatus != osOK) return osError;
+  // TODO emit to event manager LIGHT_SENS_INT with this->rawLux payload, handle that this is OK value
+
+  ioStatus = OPT3001_WriteHighLimit(this->highLimit)
+           | OPT3001_WriteLowLimit(OPT3001_CONFIG_LIMIT_MIN);
+  if (ioStatus != osOK) return osError;
 
   return osOK;
 }
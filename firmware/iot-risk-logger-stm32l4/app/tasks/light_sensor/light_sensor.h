@@ -20,13 +20,28 @@ extern "C" {
 #include "main.h"
 #include "sensors_bus.h"
 #include "opt3001.h"
+#include "fsm.h"
+#include "actor_timer.h"
 
 #define LIGHT_SENS_I2C_ADDRESS (OPT3001_I2C_ADDR_45 << 1) // ADDR connected to VDD due to SHT3x address conflict
+#define LIGHT_SENS_SINGLE_SHOT_CONVERSION_TIME_MS (110) // 100ms conversion time, max value with the oscillator tolerance
+#define LIGHT_SENS_SINGLE_SHOT_TIMEOUT_MS (2 * LIGHT_SENS_SINGLE_SHOT_CONVERSION_TIME_MS) // end-of-conversion interrupt watchdog
+
+/**
+ * @brief Single-shot 100ms conversion config, also written by the acquisition scheduler to re-trigger the conversion
+ * after every result read, the sensor stays in shutdown between the conversions
+ */
+#define LIGHT_SENS_SINGLE_SHOT_CONFIG (OPT3001_CONFIG_RANGE_NUMBER_AUTO_SCALE | \
+                                       OPT3001_CONFIG_CONVERSION_TIME_100_MS | \
+                                       OPT3001_CONFIG_MODE_SINGLE_SHOT | \
+                                       OPT3001_CONFIG_LATCH_ENABLED | \
+                                       OPT3001_CONFIG_FAULT_COUNT_1)
 
 typedef enum {
   LIGHT_SENS_NO_STATE = 0,
   LIGHT_SENS_TURNED_OFF_STATE, ///< Initialized, turned off, ready for commands, low power mode
-  LIGHT_SENS_CONTINUOUS_MEASURE_STATE, ///< Device is measuring continuously, generates interrupt on threshold exceed
+  LIGHT_SENS_SINGLE_SHOT_STATE, ///< Single-shot conversion is running, result is read on the end-of-conversion interrupt
+  LIGHT_SENS_CONTINUOUS_MEASURE_STATE, ///< Single-shot conversion per wake up, generates interrupt on threshold exceed
   LIGHT_SENS_OUT_OF_RANGE_STATE, ///< Lux is out of range, limits are swapped, return to measurements after lux returns in limits
   LIGHT_SENS_STATE_ERROR, ///< Error state
   LIGHT_SENS_MAX_STATE
@@ -37,6 +52,8 @@ typedef struct {
   LIGHT_SENS_State_t state;
   uint16_t rawLux; ///< raw lux (exponent + mantissa)
   uint16_t highLimit; ///< high limit for lux (in raw) TODO verify if it ir's in raw
+  ACTOR_Timer_t timer; ///< posts LIGHT_SENS_CONVERSION_TIMEOUT if the end-of-conversion interrupt is lost
+  bool isSensing; ///< continuous sensing was started, resumed after the supervised restart
 } LIGHT_SENS_Actor_t;
 
 extern LIGHT_SENS_Actor_t LIGHT_SENS_Actor;
@@ -12,21 +12,74 @@
 #include "usbd_msc.h"
 
 static osStatus_t handleMemoryFSM(MEMORY_Actor_t *this, message_t *message);
-static osStatus_t handleInit(MEMORY_Actor_t *this, message_t *message);
-static osStatus_t handleSleep(MEMORY_Actor_t *this, message_t *message);
-static osStatus_t handleWrite(MEMORY_Actor_t *this, message_t *message);
+/** transitions actions */
+static osStatus_t initialize(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t reinitialize(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t filterMeasurements(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t writeMeasurements(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t appendMeasurements(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t writeSettings(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t readSettings(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t putFlashToSleep(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t spillEventRecords(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t writeEventRecords(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t storeShockCapture(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t writeShockCapture(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t storeWakeUpPeriod(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t writeWakeUpPeriod(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t loadLogChunk(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t readLogChunk(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t loadLogQuery(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t queryLog(MEMORY_Actor_t *this, message_t *message);
+static osStatus_t releaseUnhandledBuffers(MEMORY_Actor_t *this, message_t *message);
 
 static osStatus_t writeFAT12BootSector(MEMORY_Actor_t *this);
 static osStatus_t writeSettingsToMemory(MEMORY_Actor_t *this, uint8_t *settingsWriteBuff);
-static void publishMemoryWriteOnMeasurementsReady(MEMORY_Actor_t *this);
-static osStatus_t appendMeasurementsToNORFlashLogTail(MEMORY_Actor_t *this);
+static osStatus_t appendMeasurementsToNORFlashLogTail(MEMORY_Actor_t *this, const ACQUISITION_Frame_t *frame, uint16_t suppressedCount);
+static osStatus_t appendEventRecordsToNORFlash(MEMORY_Actor_t *this, const uint8_t *records, uint32_t recordsSize);
+static osStatus_t appendShockCaptureToNORFlash(MEMORY_Actor_t *this, const IMU_ShockCapture_t *capture);
+static osStatus_t appendWakeUpPeriodToNORFlashLogTail(MEMORY_Actor_t *this, const CRON_PeriodDecision_t *decision);
+static int32_t readLogEntryTimestamp(uint32_t entry, int32_t *timestamp, void *context);
 
 extern actor_t* ACTORS_LOOKUP_SystemRegistry[MAX_ACTORS];
+
+_Static_assert(sizeof(MEMORY_ShockCaptureHeader_t) + IMU_CAPTURE_RING_SAMPLES * IMU_AXES_COUNT * sizeof(int16_t) <= SHOCK_CAPTURES_SLOT_SIZE, "shock capture doesn't fit the slot");
 extern uint8_t FAT12_BootSector[FAT12_BOOT_SECTOR_SIZE];
 
 extern USBD_StorageTypeDef USBD_Storage_Interface_fops_FS;
 
-osEventFlagsId_t measurementsReadyEventFlags;
+static uint8_t logQueryBlock[MEMORY_LOG_QUERY_BLOCK_ENTRIES * MEMORY_LOG_ENTRY_SIZE];
+
+_Static_assert(LOG_QUERY_ENTRY_SIZE == MEMORY_LOG_ENTRY_SIZE, "log query entry size mismatch");
+
+/**
+ * @brief Memory FSM transitions table
+ * @note rendered to the README state diagram by scripts/generate_state_machine_diagrams.py
+ */
+static const FSM_Transition_t memoryTransitions[] = {
+  FSM_TRANSITION(MEMORY_NO_STATE,     GLOBAL_CMD_INITIALIZE,                           initialize,               MEMORY_SLEEP_STATE),
+  FSM_TRANSITION(MEMORY_SLEEP_STATE,  GLOBAL_CMD_READ_SETTINGS,                        readSettings,             MEMORY_SLEEP_STATE),
+  FSM_TRANSITION(MEMORY_SLEEP_STATE,  GLOBAL_CMD_WRITE_SETTINGS,                       writeSettings,            MEMORY_WRITE_STATE),
+  FSM_TRANSITION(MEMORY_SLEEP_STATE,  GLOBAL_MEASUREMENTS_FRAME_READY,                 filterMeasurements,       MEMORY_SLEEP_STATE),
+  FSM_TRANSITION(MEMORY_SLEEP_STATE,  MEMORY_MEASUREMENTS_WRITE,                       writeMeasurements,        MEMORY_WRITE_STATE),
+  FSM_TRANSITION(MEMORY_SLEEP_STATE,  MEMORY_EVENT_RECORDS_SPILL,                      spillEventRecords,        MEMORY_SLEEP_STATE),
+  FSM_TRANSITION(MEMORY_SLEEP_STATE,  MEMORY_SHOCK_CAPTURE_WRITE,                      storeShockCapture,        MEMORY_SLEEP_STATE),
+  FSM_TRANSITION(MEMORY_SLEEP_STATE,  GLOBAL_WAKE_UP_PERIOD_CHANGED,                   storeWakeUpPeriod,        MEMORY_SLEEP_STATE),
+  FSM_TRANSITION(MEMORY_SLEEP_STATE,  GLOBAL_CMD_READ_LOG_CHUNK,                       loadLogChunk,             MEMORY_SLEEP_STATE),
+  FSM_TRANSITION(MEMORY_SLEEP_STATE,  GLOBAL_CMD_QUERY_LOG,                            loadLogQuery,             MEMORY_SLEEP_STATE),
+  FSM_TRANSITION(MEMORY_WRITE_STATE,  GLOBAL_MEASUREMENTS_FRAME_READY,                 filterMeasurements,       MEMORY_WRITE_STATE),
+  FSM_TRANSITION(MEMORY_WRITE_STATE,  MEMORY_MEASUREMENTS_WRITE,                       appendMeasurements,       MEMORY_WRITE_STATE),
+  FSM_TRANSITION(MEMORY_WRITE_STATE,  MEMORY_EVENT_RECORDS_SPILL,                      writeEventRecords,        MEMORY_WRITE_STATE),
+  FSM_TRANSITION(MEMORY_WRITE_STATE,  MEMORY_SHOCK_CAPTURE_WRITE,                      writeShockCapture,        MEMORY_WRITE_STATE),
+  FSM_TRANSITION(MEMORY_WRITE_STATE,  GLOBAL_WAKE_UP_PERIOD_CHANGED,                   writeWakeUpPeriod,        MEMORY_WRITE_STATE),
+  FSM_TRANSITION(MEMORY_WRITE_STATE,  GLOBAL_CMD_READ_LOG_CHUNK,                       readLogChunk,             MEMORY_WRITE_STATE),
+  FSM_TRANSITION(MEMORY_WRITE_STATE,  GLOBAL_CMD_QUERY_LOG,                            queryLog,                 MEMORY_WRITE_STATE),
+  FSM_TRANSITION(MEMORY_WRITE_STATE,  GLOBAL_MEASUREMENTS_WRITE_SUCCESS,               putFlashToSleep,          MEMORY_SLEEP_STATE),
+  FSM_TRANSITION(MEMORY_WRITE_STATE,  GLOBAL_SETTINGS_WRITE_SUCCESS,                   putFlashToSleep,          MEMORY_SLEEP_STATE),
+  FSM_TRANSITION(MEMORY_STATE_ERROR,  GLOBAL_CMD_RESTART,                              reinitialize,             MEMORY_SLEEP_STATE),
+};
+
+static const FSM_Table_t memoryFSMTable = FSM_TABLE(memoryTransitions, releaseUnhandledBuffers);
 
 /**
  * @brief Memory actor struct representing NOR Flash storage
@@ -40,6 +93,9 @@ MEMORY_Actor_t MEMORY_Actor = {
                 .osThreadId = NULL,
         },
         .logFileTailAddress = FAT12_BOOT_SECTOR_SIZE + 1,
+        .eventRecorderTailAddress = EVENT_RECORDER_AREA_ADDR,
+        .shockCaptureSequence = 0,
+        .logPolicy = {.config = LOG_POLICY_DEFAULT_CONFIG},
         .state = MEMORY_NO_STATE
 };
 
@@ -79,8 +135,6 @@ actor_t* MEMORY_TaskInit(void) {
   });
   MEMORY_Actor.super.osThreadId = osThreadNew(MEMORY_Task, NULL, &memoryTaskDescription);
 
-  measurementsReadyEventFlags = osEventFlagsNew(NULL);
-
   return (actor_t*) &MEMORY_Actor;
 }
 
@@ -108,18 +162,11 @@ void MEMORY_Task(void *argument) {
 }
 
 static osStatus_t handleMemoryFSM(MEMORY_Actor_t *this, message_t *message) {
-  switch (this->state) {
-    case MEMORY_NO_STATE:
-      return handleInit(this, message);
-    case MEMORY_SLEEP_STATE:
-      return handleSleep(this, message);
-    case MEMORY_WRITE_STATE:
-      return handleWrite(this, message);
-    default:
-      return osOK;
-  }
+  uint8_t state = this->state;
+  osStatus_t status = FSM_Dispatch(&memoryFSMTable, &this->super, message, &state);
+  this->state = state;
 
-  return osOK;
+  return status;
 }
 
 uint32_t MEMORY_SeekFreeSpaceAddress(void) {
@@ -153,11 +200,64 @@ uint32_t MEMORY_SeekFreeSpaceAddress(void) {
 
     stepNumber++;
 
-  } while (addr < W25Q64JV_FLASH_SIZE);
+  } while (addr < LOG_END_ADDR);
 
   return addr;
 }
 
+/**
+ * @brief Seeks the first erased event record following a written one
+ *
+ * Only the sequence word of each record is read. If there is no such record (fresh or corrupted area),
+ * the first sector is erased and the area start is returned.
+ */
+uint32_t MEMORY_SeekEventRecorderTailAddress(void) {
+  const uint32_t recordsCount = EVENT_RECORDER_AREA_SIZE / EVENT_RECORDER_RECORD_SIZE;
+  uint32_t sequence = EVENT_RECORDER_ERASED_SEQUENCE;
+
+  // the area is circular, the last record precedes the first one
+  W25Q_ReadData(&MEMORY_W25QHandle, (uint8_t *) &sequence, EVENT_RECORDER_AREA_ADDR + (recordsCount - 1) * EVENT_RECORDER_RECORD_SIZE, sizeof(sequence));
+  bool isPreviousWritten = sequence != EVENT_RECORDER_ERASED_SEQUENCE;
+
+  for (uint32_t i = 0; i < recordsCount; i++) {
+    uint32_t addr = EVENT_RECORDER_AREA_ADDR + i * EVENT_RECORDER_RECORD_SIZE;
+
+    W25Q_ReadData(&MEMORY_W25QHandle, (uint8_t *) &sequence, addr, sizeof(sequence)); // @warning: io status check is omitted here
+    bool isWritten = sequence != EVENT_RECORDER_ERASED_SEQUENCE;
+
+    if (!isWritten && isPreviousWritten) return addr;
+
+    isPreviousWritten = isWritten;
+  }
+
+  #ifdef FLASH_WRITE_ENABLED
+  W25Q_EraseSector(&MEMORY_W25QHandle, EVENT_RECORDER_AREA_ADDR);
+  #endif
+
+  return EVENT_RECORDER_AREA_ADDR;
+}
+
+/**
+ * @brief Seeks the sequence following the latest stored shock capture
+ *
+ * Only the slot headers are read, the slots are written in the sequence order and overwrite the oldest one.
+ */
+uint32_t MEMORY_SeekShockCaptureSequence(void) {
+  uint32_t nextSequence = 0;
+
+  for (uint32_t slot = 0; slot < SHOCK_CAPTURES_SLOTS; slot++) {
+    MEMORY_ShockCaptureHeader_t header = {0};
+
+    W25Q_ReadData(&MEMORY_W25QHandle, (uint8_t *) &header, SHOCK_CAPTURES_AREA_ADDR + slot * SHOCK_CAPTURES_SLOT_SIZE, sizeof(header)); // @warning: io status check is omitted here
+
+    bool isWritten = header.magic == MEMORY_SHOCK_CAPTURE_MAGIC && header.sequence != MEMORY_SHOCK_CAPTURE_ERASED_SEQUENCE;
+
+    if (isWritten && header.sequence >= nextSequence) nextSequence = header.sequence + 1;
+  }
+
+  return nextSequence;
+}
+
 
 /**
  * @brief Writes FAT12 boot sector to the NOR Flash
@@ -189,162 +289,353 @@ static osStatus_t writeFAT12BootSector(MEMORY_Actor_t *this) {
   return status;
 }
 
-static osStatus_t handleInit(MEMORY_Actor_t *this, message_t *message) {
-  if (GLOBAL_CMD_INITIALIZE == message->event) {
-    uint8_t norFlashID[W25Q_ID_SIZE] = {0x00, 0x00};
+/**
+ * @brief Wakes up the NOR flash, reads its ID and seeks the log tail
+ */
+static osStatus_t initialize(MEMORY_Actor_t *this, message_t *message) {
+  uint8_t norFlashID[W25Q_ID_SIZE] = {0x00, 0x00};
 
-    // wake up the chip
-    osStatus_t ioStatus = W25Q_WakeUp(&MEMORY_W25QHandle);
-    if (ioStatus != osOK) return osError;
+  // wake up the chip
+  osStatus_t ioStatus = W25Q_WakeUp(&MEMORY_W25QHandle);
+  if (ioStatus != osOK) return osError;
 
-    // read ID
-    ioStatus = W25Q_ReadID(&MEMORY_W25QHandle, norFlashID);
-    if (ioStatus != osOK) return osError;
+  // read ID
+  ioStatus = W25Q_ReadID(&MEMORY_W25QHandle, norFlashID);
+  if (ioStatus != osOK) return osError;
 
-    #ifdef DEBUG
-        fprintf(stdout, "W25Q NOR MF ID: 0x%x, Device ID: 0x%x\n", norFlashID[0], norFlashID[1]);
-    #endif
+  #ifdef DEBUG
+      fprintf(stdout, "W25Q NOR MF ID: 0x%x, Device ID: 0x%x\n", norFlashID[0], norFlashID[1]);
+  #endif
 
-    #ifdef FLASH_ERASE_CHIP_AND_WRITE_FAT12_BOOT_SECTOR
-        writeFAT12BootSector(&MEMORY_Actor);
-    #endif
+  #ifdef FLASH_ERASE_CHIP_AND_WRITE_FAT12_BOOT_SECTOR
+      writeFAT12BootSector(&MEMORY_Actor);
+  #endif
 
-    // find the first free space address on NOR flash (to append log to)
-    uint32_t freeSpaceAddress = MEMORY_SeekFreeSpaceAddress();
-    MEMORY_Actor.logFileTailAddress = freeSpaceAddress;
+  // find the first free space address on NOR flash (to append log to)
+  uint32_t freeSpaceAddress = MEMORY_SeekFreeSpaceAddress();
+  MEMORY_Actor.logFileTailAddress = freeSpaceAddress;
 
-    // put memory to sleep
-    ioStatus = W25Q_Sleep(&MEMORY_W25QHandle);
-    if (ioStatus != osOK) return osError;
+  #ifdef EVENT_RECORDER_ENABLED
+  MEMORY_Actor.eventRecorderTailAddress = MEMORY_SeekEventRecorderTailAddress();
+  #endif
 
-    // publish to event manager that memory is initialized
-    osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
-    osMessageQueuePut(evManagerQueue, &(message_t){GLOBAL_INITIALIZE_SUCCESS, .payload.value = MEMORY_ACTOR_ID}, 0, 0);
+  #ifdef IMU_SHOCK_CAPTURE_ENABLED
+  MEMORY_Actor.shockCaptureSequence = MEMORY_SeekShockCaptureSequence();
+  #endif
 
-    #ifdef DEBUG
-        fprintf(stdout, "First free space address: %x\n", freeSpaceAddress);
-        fprintf(stdout, "Memory task initialized\n");
-    #endif
+  // put memory to sleep
+  ioStatus = W25Q_Sleep(&MEMORY_W25QHandle);
+  if (ioStatus != osOK) return osError;
+
+  // publish to event manager that memory is initialized
+  osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
+  osMessageQueuePut(evManagerQueue, &(message_t){GLOBAL_INITIALIZE_SUCCESS, .payload.value = MEMORY_ACTOR_ID}, 0, 0);
+
+  #ifdef DEBUG
+      fprintf(stdout, "First free space address: %x\n", freeSpaceAddress);
+      fprintf(stdout, "Memory task initialized\n");
+  #endif
+
+  return osOK;
+}
+
+/**
+ * @brief Restarts the NOR flash after an error, keeps the known log and event recorder tails
+ *
+ * Unlike the initialization, doesn't re-scan the NOR flash for the log tail.
+ */
+static osStatus_t reinitialize(MEMORY_Actor_t *this, message_t *message) {
+  uint8_t norFlashID[W25Q_ID_SIZE] = {0x00, 0x00};
+
+  osStatus_t ioStatus = W25Q_WakeUp(&MEMORY_W25QHandle);
+  if (ioStatus != osOK) return osError;
+
+  ioStatus = W25Q_ReadID(&MEMORY_W25QHandle, norFlashID);
+  if (ioStatus != osOK) return osError;
 
-    TO_STATE(this, MEMORY_SLEEP_STATE);
+  ioStatus = W25Q_Sleep(&MEMORY_W25QHandle);
+  if (ioStatus != osOK) return osError;
+
+  osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
+  osMessageQueuePut(evManagerQueue, &(message_t){GLOBAL_INITIALIZE_SUCCESS, .payload.value = MEMORY_ACTOR_ID}, 0, 0);
+
+  return osOK;
+}
+
+/**
+ * @brief Logging policy: the frame is written only out of the deadbands around the last written one or on
+ * the heartbeat, the suppressed frames don't wake the NOR flash up
+ */
+static osStatus_t filterMeasurements(MEMORY_Actor_t *this, message_t *message) {
+  const ACQUISITION_Frame_t *frame = (const ACQUISITION_Frame_t *) message->payload.ptr;
+  VIBRATION_Summary_t vibration;
+
+  VIBRATION_Summarize(&frame->vibration, &vibration);
+
+  const LOG_POLICY_Sample_t sample = {
+          .timestamp = frame->timestamp,
+          .temperature = (uint16_t) frame->rawTemperature,
+          .humidity = frame->rawHumidity,
+          .lux = CONVERT_OPT3001RawToCentiLux(frame->rawLux),
+          .acceleration = {frame->acceleration[0], frame->acceleration[1], frame->acceleration[2]},
+          .vibrationRms = vibration.rms,
+          .vibrationMagnitude = vibration.magnitudeMax,
+  };
+
+  uint16_t suppressedCount;
+
+  if (!LOG_POLICY_Filter(&this->logPolicy, &sample, &suppressedCount)) {
+    TRACE_LOG("Log entry suppressed, %u since the last one\n", this->logPolicy.suppressedCount);
     return osOK;
   }
-};
 
-static osStatus_t handleSleep(MEMORY_Actor_t *this, message_t *message) {
-  osStatus_t ioStatus = osOK;
-  uint8_t *measurementsLogReadBuff = NULL;
-  uint8_t *settingsWriteBuff = NULL;
-  uint8_t *settingsReadBuff = NULL;
+  // the count travels with the frame, the next frame may pass the policy before this one is written
+  return osMessageQueuePut(this->super.osMessageQueueId, &(message_t){MEMORY_MEASUREMENTS_WRITE, .payload.ptr = message->payload.ptr, .payload_size = suppressedCount}, 0, 0);
+}
+
+/**
+ * @brief Saves the acquired measurements frame to the memory, increments log tail address
+ */
+static osStatus_t writeMeasurements(MEMORY_Actor_t *this, message_t *message) {
+  osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
+
+  // wake up the chip
+  W25Q_WakeUp(&MEMORY_W25QHandle);
+
+  const uint16_t suppressedCount = (uint16_t) message->payload_size;
+  osStatus_t ioStatus = appendMeasurementsToNORFlashLogTail(this, (const ACQUISITION_Frame_t *) message->payload.ptr, suppressedCount);
+
+  // the policy reference moved to the frame which isn't in the log, the next frame is written instead
+  if (ioStatus != osOK) LOG_POLICY_Revert(&this->logPolicy, suppressedCount);
+
+  // the subscribers get the write status, osErrorNoMemory once the log is full
+  osMessageQueuePut(evManagerQueue, &(message_t) {GLOBAL_MEASUREMENTS_WRITE_SUCCESS, .payload.value = ioStatus}, 0, 0);
+
+  return ioStatus;
+}
+
+/**
+ * @brief Saves the frame passed the policy during another write to the already awake NOR flash, the running write
+ * puts the flash back to sleep
+ */
+static osStatus_t appendMeasurements(MEMORY_Actor_t *this, message_t *message) {
+  const uint16_t suppressedCount = (uint16_t) message->payload_size;
+  osStatus_t ioStatus = appendMeasurementsToNORFlashLogTail(this, (const ACQUISITION_Frame_t *) message->payload.ptr, suppressedCount);
+
+  if (ioStatus != osOK) LOG_POLICY_Revert(&this->logPolicy, suppressedCount);
+
+  return ioStatus;
+}
 
+static osStatus_t writeSettings(MEMORY_Actor_t *this, message_t *message) {
   osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
 
-  switch (message->event) {
-    case GLOBAL_TEMPERATURE_HUMIDITY_MEASUREMENTS_READY:
-      // set appropriate event flag
-      osEventFlagsSet(measurementsReadyEventFlags, TEMPERATURE_HUMIDITY_MEASUREMENTS_READY_EVENT_FLAG);
+  // wake up the chip
+  W25Q_WakeUp(&MEMORY_W25QHandle);
 
-      // if both measurements are ready, emit write to the memory message
-      publishMemoryWriteOnMeasurementsReady(this);
+  uint8_t *settingsWriteBuff = (uint8_t *) message->payload.ptr;
 
-      TO_STATE(this, MEMORY_SLEEP_STATE);
-      return osOK;
+  // write settings to the memory
+  osStatus_t ioStatus = writeSettingsToMemory(this, settingsWriteBuff);
 
-    case GLOBAL_LIGHT_MEASUREMENTS_READY:
-      // set appropriate event flag
-      osEventFlagsSet(measurementsReadyEventFlags, LIGHT_MEASUREMENTS_READY_EVENT_FLAG);
+  osMessageQueuePut(evManagerQueue, &(message_t) {GLOBAL_SETTINGS_WRITE_SUCCESS, .payload.value = ioStatus}, 0, 0);
 
-      // if both measurements are ready, emit write to the memory message
-      publishMemoryWriteOnMeasurementsReady(this);
+  return ioStatus;
+}
 
-      TO_STATE(this, MEMORY_SLEEP_STATE);
-      return osOK;
+static osStatus_t readSettings(MEMORY_Actor_t *this, message_t *message) {
+  osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
 
-    case GLOBAL_IMU_MEASUREMENTS_READY:
-      // set appropriate event flag
-      osEventFlagsSet(measurementsReadyEventFlags, IMU_MEASUREMENTS_READY_EVENT_FLAG);
+  // wake up the chip
+  W25Q_WakeUp(&MEMORY_W25QHandle);
 
-      // if both measurements are ready, emit write to the memory message
-      publishMemoryWriteOnMeasurementsReady(this);
+  // other module is responsible to provide correct buffer address to write to
+  uint8_t *settingsReadBuff = (uint8_t *) message->payload.ptr;
 
-      TO_STATE(this, MEMORY_SLEEP_STATE);
-      return osOK;
+  // read settings from the memory
+  osStatus_t ioStatus = W25Q_ReadData(&MEMORY_W25QHandle, settingsReadBuff, SETTINGS_FILE_ADDR, SETTINGS_DATA_SIZE);
 
-    case MEMORY_MEASUREMENTS_WRITE:
-      // wake up the chip
-      W25Q_WakeUp(&MEMORY_W25QHandle);
+  osMessageQueuePut(evManagerQueue, &(message_t) {GLOBAL_SETTINGS_READ_SUCCESS, .payload.value = ioStatus}, 0, 0);
 
-      // save measurements to the memory, increment log tail address
-      ioStatus = appendMeasurementsToNORFlashLogTail(this);
+  return ioStatus;
+}
 
-      // TODO if ioStatus is not OK return it
+static osStatus_t putFlashToSleep(MEMORY_Actor_t *this, message_t *message) {
+  return W25Q_Sleep(&MEMORY_W25QHandle);
+}
 
-      osMessageQueuePut(evManagerQueue, &(message_t) {GLOBAL_MEASUREMENTS_WRITE_SUCCESS}, 0, 0);
+/**
+ * @brief Wakes up the NOR flash, writes the event recorder page and puts the flash back to sleep
+ */
+static osStatus_t spillEventRecords(MEMORY_Actor_t *this, message_t *message) {
+  W25Q_WakeUp(&MEMORY_W25QHandle);
 
-      TO_STATE(this, MEMORY_WRITE_STATE);
-      return ioStatus;
+  writeEventRecords(this, message);
 
-    case GLOBAL_CMD_READ_LOG_CHUNK:
-      // TODO implement settings and log chunk read/write
-      assert_param(false);
+  return W25Q_Sleep(&MEMORY_W25QHandle);
+}
 
-      osMessageQueuePut(evManagerQueue, &(message_t) {GLOBAL_LOG_CHUNK_READ_SUCCESS}, 0, 0);
+/**
+ * @brief Writes the event recorder page to the already awake NOR flash and releases the page
+ *
+ * @note The page is released even on IO error, otherwise the recorder would stall
+ */
+static osStatus_t writeEventRecords(MEMORY_Actor_t *this, message_t *message) {
+  osStatus_t ioStatus = appendEventRecordsToNORFlash(this, message->payload.ptr, (uint32_t) message->payload_size);
 
-      TO_STATE(this, MEMORY_SLEEP_STATE);
-      return osOK;
+  EVENT_RECORDER_ReleasePage(message->payload.ptr);
 
-    case GLOBAL_CMD_WRITE_SETTINGS:
-      // wake up the chip
-      W25Q_WakeUp(&MEMORY_W25QHandle);
+  return ioStatus;
+}
 
-      settingsWriteBuff = (uint8_t *) message->payload.ptr;
+/**
+ * @brief Wakes up the NOR flash, stores the shock capture and puts the flash back to sleep
+ */
+static osStatus_t storeShockCapture(MEMORY_Actor_t *this, message_t *message) {
+  W25Q_WakeUp(&MEMORY_W25QHandle);
 
-      // write settings to the memory
-      ioStatus = writeSettingsToMemory(this, settingsWriteBuff);
+  writeShockCapture(this, message);
 
-      // TODO if ioStatus is not OK return it
+  return W25Q_Sleep(&MEMORY_W25QHandle);
+}
 
-      osMessageQueuePut(evManagerQueue, &(message_t) {GLOBAL_SETTINGS_WRITE_SUCCESS}, 0, 0);
+/**
+ * @brief Stores the shock capture to the already awake NOR flash and releases the IMU ring
+ *
+ * @note The ring is released even on IO error, otherwise the capture would stall
+ */
+static osStatus_t writeShockCapture(MEMORY_Actor_t *this, message_t *message) {
+  osStatus_t ioStatus = appendShockCaptureToNORFlash(this, (const IMU_ShockCapture_t *) message->payload.ptr);
 
-      TO_STATE(this, MEMORY_WRITE_STATE);
-      return ioStatus;
+  osMessageQueueId_t imuQueue = ACTORS_LOOKUP_SystemRegistry[IMU_ACTOR_ID]->osMessageQueueId;
+  osMessageQueuePut(imuQueue, &(message_t){IMU_SHOCK_CAPTURE_STORED, .payload.value = ioStatus}, 0, 0);
 
-    case GLOBAL_CMD_READ_SETTINGS:
-      // wake up the chip
-      W25Q_WakeUp(&MEMORY_W25QHandle);
+  return ioStatus;
+}
 
-      // other module is responsible to provide correct buffer address to write to
-      measurementsLogReadBuff = (uint8_t *) message->payload.ptr;
+/**
+ * @brief Wakes up the NOR flash, logs the wake up period change and puts the flash back to sleep
+ */
+static osStatus_t storeWakeUpPeriod(MEMORY_Actor_t *this, message_t *message) {
+  W25Q_WakeUp(&MEMORY_W25QHandle);
 
-      // read settings from the memory
-      ioStatus = W25Q_ReadData(&MEMORY_W25QHandle, measurementsLogReadBuff, SETTINGS_FILE_ADDR, SETTINGS_DATA_SIZE);
+  writeWakeUpPeriod(this, message);
 
-      osMessageQueuePut(evManagerQueue, &(message_t) {GLOBAL_SETTINGS_READ_SUCCESS}, 0, 0);
+  return W25Q_Sleep(&MEMORY_W25QHandle);
+}
 
-      TO_STATE(this, MEMORY_SLEEP_STATE);
-      return ioStatus;
+static osStatus_t writeWakeUpPeriod(MEMORY_Actor_t *this, message_t *message) {
+  return appendWakeUpPeriodToNORFlashLogTail(this, (const CRON_PeriodDecision_t *) message->payload.ptr);
+}
 
-    default:
-      TO_STATE(this, MEMORY_SLEEP_STATE);
-      return osOK;
-  }
-};
+/**
+ * @brief Wakes up the NOR flash, serves the NFC log read and puts the flash back to sleep
+ */
+static osStatus_t loadLogChunk(MEMORY_Actor_t *this, message_t *message) {
+  W25Q_WakeUp(&MEMORY_W25QHandle);
+
+  readLogChunk(this, message);
+
+  return W25Q_Sleep(&MEMORY_W25QHandle);
+}
 
-static osStatus_t handleWrite(MEMORY_Actor_t *this, message_t *message) {
+/**
+ * @brief Reads the requested log bytes from the already awake NOR flash into the requester's buffer
+ *
+ * @note The requester is answered even on IO error, otherwise the log transfer would stall
+ */
+static osStatus_t readLogChunk(MEMORY_Actor_t *this, message_t *message) {
+  MEMORY_LogReadRequest_t *request = (MEMORY_LogReadRequest_t *) message->payload.ptr;
   osStatus_t ioStatus = osOK;
 
-  switch (message->event) {
-    case GLOBAL_MEASUREMENTS_WRITE_SUCCESS:
-    case GLOBAL_SETTINGS_WRITE_SUCCESS:
-      ioStatus = W25Q_Sleep(&MEMORY_W25QHandle);
+  request->logTailAddress = this->logFileTailAddress;
+
+  if (request->size > 0) {
+    ioStatus = W25Q_ReadData(&MEMORY_W25QHandle, request->buffer, request->address, request->size);
+  }
+
+  osMessageQueueId_t requesterQueue = ACTORS_LOOKUP_SystemRegistry[request->requesterId]->osMessageQueueId;
+  osMessageQueuePut(requesterQueue, &(message_t){GLOBAL_LOG_CHUNK_READ_SUCCESS, .payload.value = ioStatus}, 0, 0);
+
+  return ioStatus;
+}
+
+/**
+ * @brief Wakes up the NOR flash, evaluates the NFC log query and puts the flash back to sleep
+ */
+static osStatus_t loadLogQuery(MEMORY_Actor_t *this, message_t *message) {
+  W25Q_WakeUp(&MEMORY_W25QHandle);
+
+  queryLog(this, message);
+
+  return W25Q_Sleep(&MEMORY_W25QHandle);
+}
+
+/**
+ * @brief Evaluates the log query from the already awake NOR flash: binary searches the range start by the entries
+ * timestamps, then reads the range in blocks until an entry after it
+ *
+ * @note The NFC actor is answered even on IO error, otherwise it would wait for the result forever
+ */
+static osStatus_t queryLog(MEMORY_Actor_t *this, message_t *message) {
+  LOG_QUERY_t *query = (LOG_QUERY_t *) message->payload.ptr;
+  const uint32_t entriesCount = (this->logFileTailAddress - INITIAL_LOG_START_ADDR) / MEMORY_LOG_ENTRY_SIZE;
+  uint32_t entry = 0;
+
+  osStatus_t ioStatus = (LOG_QUERY_SeekRangeStart(query, entriesCount, readLogEntryTimestamp, NULL, &entry) == 0) ? osOK : osError;
 
-      TO_STATE(this, MEMORY_SLEEP_STATE);
-      return ioStatus;
+  while (ioStatus == osOK && entry < entriesCount) {
+    const uint32_t remainingEntries = entriesCount - entry;
+    const uint32_t blockEntries = (remainingEntries < MEMORY_LOG_QUERY_BLOCK_ENTRIES) ? remainingEntries : MEMORY_LOG_QUERY_BLOCK_ENTRIES;
 
-    default:
-      TO_STATE(this, MEMORY_WRITE_STATE);
-      return osOK;
+    ioStatus = W25Q_ReadData(&MEMORY_W25QHandle, logQueryBlock, INITIAL_LOG_START_ADDR + entry * MEMORY_LOG_ENTRY_SIZE, blockEntries * MEMORY_LOG_ENTRY_SIZE);
+
+    if (ioStatus != osOK || !LOG_QUERY_Accumulate(query, logQueryBlock, blockEntries))
+      break;
+
+    entry += blockEntries;
   }
+
+  LOG_QUERY_Finish(query);
+
+  osMessageQueueId_t nfcQueue = ACTORS_LOOKUP_SystemRegistry[NFC_ACTOR_ID]->osMessageQueueId;
+  osMessageQueuePut(nfcQueue, &(message_t){GLOBAL_LOG_QUERY_SUCCESS, .payload.value = ioStatus}, 0, 0);
+
+  return ioStatus;
+}
+
+/**
+ * @brief Releases the buffers arrived in states which can't write them (e.g. before initialization):
+ * the event recorder pages, the IMU shock capture ring, the log read buffer of NFC or USB stream, the NFC log query and
+ * the NFC settings command frames
+ */
+static osStatus_t releaseUnhandledBuffers(MEMORY_Actor_t *this, message_t *message) {
+  if (message->event == MEMORY_EVENT_RECORDS_SPILL) EVENT_RECORDER_ReleasePage(message->payload.ptr);
+
+  if (message->event == MEMORY_SHOCK_CAPTURE_WRITE) {
+    osMessageQueueId_t imuQueue = ACTORS_LOOKUP_SystemRegistry[IMU_ACTOR_ID]->osMessageQueueId;
+    osMessageQueuePut(imuQueue, &(message_t){IMU_SHOCK_CAPTURE_STORED, .payload.value = osError}, 0, 0);
+  }
+
+  if (message->event == GLOBAL_CMD_READ_LOG_CHUNK) {
+    const MEMORY_LogReadRequest_t *request = (const MEMORY_LogReadRequest_t *) message->payload.ptr;
+    osMessageQueueId_t requesterQueue = ACTORS_LOOKUP_SystemRegistry[request->requesterId]->osMessageQueueId;
+    osMessageQueuePut(requesterQueue, &(message_t){GLOBAL_LOG_CHUNK_READ_SUCCESS, .payload.value = osError}, 0, 0);
+  }
+
+  if (message->event == GLOBAL_CMD_QUERY_LOG) {
+    osMessageQueueId_t nfcQueue = ACTORS_LOOKUP_SystemRegistry[NFC_ACTOR_ID]->osMessageQueueId;
+    osMessageQueuePut(nfcQueue, &(message_t){GLOBAL_LOG_QUERY_SUCCESS, .payload.value = osError}, 0, 0);
+  }
+
+  // NFC keeps the settings commands in flight until they are answered, the failure goes to NFC only
+  if (message->event == GLOBAL_CMD_READ_SETTINGS || message->event == GLOBAL_CMD_WRITE_SETTINGS) {
+    osMessageQueueId_t nfcQueue = ACTORS_LOOKUP_SystemRegistry[NFC_ACTOR_ID]->osMessageQueueId;
+    const event_t result = (message->event == GLOBAL_CMD_READ_SETTINGS) ? GLOBAL_SETTINGS_READ_SUCCESS : GLOBAL_SETTINGS_WRITE_SUCCESS;
+    osMessageQueuePut(nfcQueue, &(message_t){result, .payload.value = osError}, 0, 0);
+  }
+
+  return osOK;
 }
 
 static osStatus_t writeSettingsToMemory(MEMORY_Actor_t *this, uint8_t *settingsWriteBuff) {
@@ -360,46 +651,31 @@ static osStatus_t writeSettingsToMemory(MEMORY_Actor_t *this, uint8_t *settingsW
 }
 
 /**
- * @brief Publishes MEMORY_MEASUREMENTS_WRITE message to the memory task on both measurements ready
+ * @return osErrorNoMemory if the log is full, the entry isn't written
  */
-static void publishMemoryWriteOnMeasurementsReady(MEMORY_Actor_t *this) {
-  const uint32_t readyMask = TEMPERATURE_HUMIDITY_MEASUREMENTS_READY_EVENT_FLAG |
-                             LIGHT_MEASUREMENTS_READY_EVENT_FLAG |
-                             IMU_MEASUREMENTS_READY_EVENT_FLAG;
-
-  const uint32_t currentFlags = osEventFlagsGet(measurementsReadyEventFlags);
-
-  if ((currentFlags & readyMask) == readyMask) {
-    osEventFlagsClear(measurementsReadyEventFlags, readyMask);
-    osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {MEMORY_MEASUREMENTS_WRITE}, 0, 0);
-  }
-}
-
-static osStatus_t appendMeasurementsToNORFlashLogTail(MEMORY_Actor_t *this) {
+static osStatus_t appendMeasurementsToNORFlashLogTail(MEMORY_Actor_t *this, const ACQUISITION_Frame_t *frame, uint16_t suppressedCount) {
   osStatus_t ioStatus = osOK;
 
-  // sensors actors pointers from the system registry
-  TH_SENS_Actor_t *thSensActor = (TH_SENS_Actor_t *)ACTORS_LOOKUP_SystemRegistry[TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID];
-  LIGHT_SENS_Actor_t *lightSensorActor = (LIGHT_SENS_Actor_t *)ACTORS_LOOKUP_SystemRegistry[LIGHT_SENSOR_ACTOR_ID];
-  IMU_Actor_t *imuActor = (IMU_Actor_t *)ACTORS_LOOKUP_SystemRegistry[IMU_ACTOR_ID];
-
-  // current timestamp in UNIX format
-  int32_t timestamp = CRON_GetCurrentUnixTimestamp();
+  if (!LOG_HAS_SPACE_FOR(this->logFileTailAddress, MEMORY_LOG_ENTRY_SIZE)) {
+    TRACE_LOG("Log is full, measurements entry dropped\n");
+    return osErrorNoMemory;
+  }
 
-  // create measurements log entry
+  // create measurements log entry, the timestamp is taken at the RTC wake up
   MEMORY_SensorsMeasurementEntry_t sensorsMeasurementEntry = {
-          .timestamp = timestamp,
-          .rawTemperature = thSensActor->rawTemperature,
-          .rawHumidity = thSensActor->rawHumidity,
-          .rawLux = lightSensorActor->rawLux,
-          .accelX = imuActor->lastAcceleration[0],
-          .accelY = imuActor->lastAcceleration[1],
-          .accelZ = imuActor->lastAcceleration[2],
-          .reserved = 0
+          .timestamp = frame->timestamp,
+          .rawTemperature = frame->rawTemperature,
+          .rawHumidity = frame->rawHumidity,
+          .rawLux = frame->rawLux,
+          .accelX = frame->acceleration[0],
+          .accelY = frame->acceleration[1],
+          .accelZ = frame->acceleration[2],
+          .suppressedCount = suppressedCount,
   };
 
-  #ifdef DEBUG
-  fprintf(stdout, "Log entry to write:\n timestamp: %ld\n rawTemperature: 0x%x\n rawHumidity: 0x%x\n rawLux: 0x%x\n accelX: 0x%x\n accelY: 0x%x\n accelZ: 0x%x\n lastFifoLevel: %d\n",
+  VIBRATION_Summarize(&frame->vibration, &sensorsMeasurementEntry.vibration);
+
+  TRACE_LOG("Log entry to write:\n timestamp: %ld\n rawTemperature: 0x%x\n rawHumidity: 0x%x\n rawLux: 0x%x\n accelX: 0x%x\n accelY: 0x%x\n accelZ: 0x%x\n fifoLevel: %d\n",
             sensorsMeasurementEntry.timestamp,
             sensorsMeasurementEntry.rawTemperature,
             sensorsMeasurementEntry.rawHumidity,
@@ -407,8 +683,7 @@ static osStatus_t appendMeasurementsToNORFlashLogTail(MEMORY_Actor_t *this) {
             sensorsMeasurementEntry.accelX,
             sensorsMeasurementEntry.accelY,
             sensorsMeasurementEntry.accelZ,
-            imuActor->lastFifoLevel & 0x000000FF);
-  #endif
+            frame->fifoLevel);
 
   // write measurements to the memory
   #ifdef FLASH_WRITE_ENABLED
@@ -420,3 +695,158 @@ static osStatus_t appendMeasurementsToNORFlashLogTail(MEMORY_Actor_t *this) {
 
   return ioStatus;
 }
+
+/**
+ * @brief Appends records to the circular event recorder area
+ *
+ * The sector after the one being written is erased in advance, so there is always an erased gap
+ * between the newest and the oldest records to find the tail after reboot.
+ */
+static osStatus_t appendEventRecordsToNORFlash(MEMORY_Actor_t *this, const uint8_t *records, uint32_t recordsSize) {
+  osStatus_t ioStatus = osOK;
+  const uint32_t offset = this->eventRecorderTailAddress - EVENT_RECORDER_AREA_ADDR;
+
+  #ifdef FLASH_WRITE_ENABLED
+  const uint32_t sectorsCount = EVENT_RECORDER_AREA_SIZE / W25Q64JV_SECTOR_SIZE;
+  const uint32_t startSector = offset / W25Q64JV_SECTOR_SIZE;
+  const uint32_t endSector = ((offset + recordsSize - 1) / W25Q64JV_SECTOR_SIZE) % sectorsCount;
+
+  // records may wrap around the area end
+  const uint32_t firstPartSize = (recordsSize < EVENT_RECORDER_AREA_SIZE - offset) ? recordsSize : (EVENT_RECORDER_AREA_SIZE - offset);
+
+  if ((offset % W25Q64JV_SECTOR_SIZE == 0) || (endSector != startSector)) {
+    ioStatus = W25Q_EraseSector(&MEMORY_W25QHandle, EVENT_RECORDER_AREA_ADDR + ((endSector + 1) % sectorsCount) * W25Q64JV_SECTOR_SIZE);
+  }
+
+  if (ioStatus == osOK) {
+    ioStatus = W25Q_WriteData(&MEMORY_W25QHandle, (uint8_t *) records, this->eventRecorderTailAddress, firstPartSize);
+  }
+
+  if (ioStatus == osOK && recordsSize > firstPartSize) {
+    ioStatus = W25Q_WriteData(&MEMORY_W25QHandle, (uint8_t *) records + firstPartSize, EVENT_RECORDER_AREA_ADDR, recordsSize - firstPartSize);
+  }
+  #endif
+
+  this->eventRecorderTailAddress = EVENT_RECORDER_AREA_ADDR + (offset + recordsSize) % EVENT_RECORDER_AREA_SIZE;
+
+  return ioStatus;
+}
+
+/**
+ * @brief Writes the capture to the next slot of the shock captures area and the pointer entry to the log tail
+ *
+ * The ring may wrap around, the samples are written in two parts straight from it.
+ *
+ * @return osErrorNoMemory if the log is full: the capture without its pointer entry isn't stored either
+ */
+static osStatus_t appendShockCaptureToNORFlash(MEMORY_Actor_t *this, const IMU_ShockCapture_t *capture) {
+  osStatus_t ioStatus = osOK;
+
+  if (!LOG_HAS_SPACE_FOR(this->logFileTailAddress, MEMORY_LOG_ENTRY_SIZE)) {
+    TRACE_LOG("Log is full, shock capture dropped\n");
+    return osErrorNoMemory;
+  }
+
+  const uint32_t slotAddress = SHOCK_CAPTURES_AREA_ADDR + (this->shockCaptureSequence % SHOCK_CAPTURES_SLOTS) * SHOCK_CAPTURES_SLOT_SIZE;
+  const uint16_t firstPartCount = (capture->samplesCount < IMU_CAPTURE_RING_SAMPLES - capture->startIndex)
+                                  ? capture->samplesCount
+                                  : (IMU_CAPTURE_RING_SAMPLES - capture->startIndex);
+
+  // the samples are written in the chronological order, the ring wraps after the first part
+  uint32_t samplesCRC32 = CRC_SERVICE_Crc32((const uint8_t *) capture->ring[capture->startIndex], firstPartCount * sizeof(capture->ring[0]));
+  samplesCRC32 = CRC_SERVICE_Crc32Update(samplesCRC32, (const uint8_t *) capture->ring[0], (capture->samplesCount - firstPartCount) * sizeof(capture->ring[0]));
+
+  MEMORY_ShockCaptureHeader_t header = {
+          .magic = MEMORY_SHOCK_CAPTURE_MAGIC,
+          .sequence = this->shockCaptureSequence,
+          .timestamp = capture->timestamp,
+          .triggerTick = capture->triggerTick,
+          .samplesCount = capture->samplesCount,
+          .triggerIndex = capture->triggerIndex,
+          .odrHz = IMU_CAPTURE_ODR_HZ,
+          .fullScaleG = IMU_CAPTURE_FULL_SCALE_G,
+          .isFreeFall = capture->isFreeFall,
+          .samplesCRC32 = samplesCRC32,
+  };
+
+  MEMORY_ShockPointerEntry_t pointerEntry = {
+          .timestamp = capture->timestamp,
+          .marker = MEMORY_SHOCK_POINTER_MARKER,
+          .samplesCount = capture->samplesCount,
+          .address = slotAddress,
+          .sequence = this->shockCaptureSequence,
+          .triggerTick = capture->triggerTick,
+  };
+
+  TRACE_LOG("Shock capture to write: sequence %lu, %u samples at 0x%lx\n", pointerEntry.sequence, header.samplesCount, pointerEntry.address);
+
+  #ifdef FLASH_WRITE_ENABLED
+  const uint32_t samplesAddress = slotAddress + sizeof(header);
+
+  ioStatus = W25Q_EraseSector(&MEMORY_W25QHandle, slotAddress);
+
+  if (ioStatus == osOK) {
+    ioStatus = W25Q_WriteData(&MEMORY_W25QHandle, (uint8_t *) &header, slotAddress, sizeof(header));
+  }
+
+  if (ioStatus == osOK) {
+    ioStatus = W25Q_WriteData(&MEMORY_W25QHandle, (uint8_t *) capture->ring[capture->startIndex], samplesAddress, firstPartCount * sizeof(capture->ring[0]));
+  }
+
+  if (ioStatus == osOK && capture->samplesCount > firstPartCount) {
+    ioStatus = W25Q_WriteData(&MEMORY_W25QHandle, (uint8_t *) capture->ring[0], samplesAddress + firstPartCount * sizeof(capture->ring[0]), (capture->samplesCount - firstPartCount) * sizeof(capture->ring[0]));
+  }
+
+  if (ioStatus == osOK) {
+    ioStatus = W25Q_WriteData(&MEMORY_W25QHandle, (uint8_t *) &pointerEntry, this->logFileTailAddress, MEMORY_LOG_ENTRY_SIZE);
+  }
+  #endif
+
+  // the pointer entry takes one log entry slot
+  this->logFileTailAddress += MEMORY_LOG_ENTRY_SIZE;
+  this->shockCaptureSequence++;
+
+  return ioStatus;
+}
+
+/**
+ * @brief Appends the wake up period change entry, keeps the timestamps of the following entries interpretable
+ *
+ * @return osErrorNoMemory if the log is full, the entry isn't written
+ */
+static osStatus_t appendWakeUpPeriodToNORFlashLogTail(MEMORY_Actor_t *this, const CRON_PeriodDecision_t *decision) {
+  osStatus_t ioStatus = osOK;
+
+  if (!LOG_HAS_SPACE_FOR(this->logFileTailAddress, MEMORY_LOG_ENTRY_SIZE)) {
+    TRACE_LOG("Log is full, wake up period entry dropped\n");
+    return osErrorNoMemory;
+  }
+
+  MEMORY_WakeUpPeriodEntry_t wakeUpPeriodEntry = {
+          .timestamp = decision->timestamp,
+          .marker = MEMORY_WAKE_UP_PERIOD_MARKER,
+          .periodSeconds = decision->periodSeconds,
+          .previousPeriodSeconds = decision->previousPeriodSeconds,
+          .reason = decision->reason,
+  };
+
+  TRACE_LOG("Wake up period entry to write: %u -> %u s, reason %u\n",
+            wakeUpPeriodEntry.previousPeriodSeconds,
+            wakeUpPeriodEntry.periodSeconds,
+            wakeUpPeriodEntry.reason);
+
+  #ifdef FLASH_WRITE_ENABLED
+  ioStatus = W25Q_WriteData(&MEMORY_W25QHandle, (uint8_t *) &wakeUpPeriodEntry, this->logFileTailAddress, MEMORY_LOG_ENTRY_SIZE);
+  #endif
+
+  this->logFileTailAddress += MEMORY_LOG_ENTRY_SIZE;
+
+  return ioStatus;
+}
+
+/**
+ * @brief LOG_QUERY_SeekRangeStart() timestamp reader, every log entry starts with its timestamp
+ */
+static int32_t readLogEntryTimestamp(uint32_t entry, int32_t *timestamp, void *context) {
+  return (int32_t) W25Q_ReadData(&MEMORY_W25QHandle, (uint8_t *) timestamp, INITIAL_LOG_START_ADDR + entry * MEMORY_LOG_ENTRY_SIZE, sizeof(*timestamp));
+}
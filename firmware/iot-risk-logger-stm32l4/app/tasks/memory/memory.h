@@ -22,6 +22,13 @@ extern "C" {
 #include "quadspi.h"
 #include "w25q.h"
 #include "fs_static.h"
+#include "fsm.h"
+#include "event_recorder.h"
+#include "acquisition.h"
+#include "vibration_features.h"
+#include "log_policy.h"
+#include "log_query.h"
+#include "crc_service.h"
 
 /* W25Q64JV Memory Specifications */
 #define W25Q64JV_FLASH_SIZE              (0x800000)  /* 8 MB (64 Mbit) */
@@ -35,18 +42,19 @@ extern "C" {
 #define MEMORY_TIMESTAMP_ENTRY_SIZE                   (0x04)      /* 4 bytes */
 #define MEMORY_LUX_ENTRY_SIZE                         (0x02)      /* 2 bytes */
 #define MEMORY_TEMPERATURE_ENTRY_SIZE                 (0x02)      /* 2 bytes */
-#define MEMORY_HUMIDITY_ENTRY_SIZE                    (0x04)      /* 2 bytes */
+#define MEMORY_HUMIDITY_ENTRY_SIZE                    (0x02)      /* 2 bytes */
 #define MEMORY_ACCEL_ENTRY_SIZE                       (0x06)      /* 3 * 2 bytes (X, Y, Z) */
-#define RESERVED_ENTRY_SIZE                           (0x04)      /* 4 bytes */
-#define MEMORY_LOG_ENTRY_SIZE                         (MEMORY_TIMESTAMP_ENTRY_SIZE + MEMORY_TEMPERATURE_ENTRY_SIZE + MEMORY_HUMIDITY_ENTRY_SIZE + MEMORY_LUX_ENTRY_SIZE + MEMORY_ACCEL_ENTRY_SIZE + RESERVED_ENTRY_SIZE)
+#define MEMORY_VIBRATION_ENTRY_SIZE                   (0x04)      /* 4 bytes, VIBRATION_Summary_t */
+#define MEMORY_SUPPRESSED_COUNT_ENTRY_SIZE            (0x02)      /* 2 bytes */
+#define MEMORY_LOG_ENTRY_SIZE                         (MEMORY_TIMESTAMP_ENTRY_SIZE + MEMORY_TEMPERATURE_ENTRY_SIZE + MEMORY_HUMIDITY_ENTRY_SIZE + MEMORY_LUX_ENTRY_SIZE + MEMORY_ACCEL_ENTRY_SIZE + MEMORY_VIBRATION_ENTRY_SIZE + MEMORY_SUPPRESSED_COUNT_ENTRY_SIZE)
 
 #define MEMORY_CHUNKS_ARE_EQUAL                       (0)
+#define MEMORY_LOG_QUERY_BLOCK_ENTRIES                (16)        /* 352 bytes read at once by the log query scan */
 
-typedef enum {
-  TEMPERATURE_HUMIDITY_MEASUREMENTS_READY_EVENT_FLAG = 0x01,
-  LIGHT_MEASUREMENTS_READY_EVENT_FLAG = 0x02,
-  IMU_MEASUREMENTS_READY_EVENT_FLAG = 0x04
-} MEMORY_MeasurementEventFlag_t;
+#define MEMORY_SHOCK_CAPTURE_MAGIC                    (0x4B434853) /* "SHCK" */
+#define MEMORY_SHOCK_CAPTURE_ERASED_SEQUENCE          (0xFFFFFFFF)
+#define MEMORY_SHOCK_POINTER_MARKER                   (0xFFFF)     /* in place of the raw temperature, 130°C is out of the SHT3x range */
+#define MEMORY_WAKE_UP_PERIOD_MARKER                  (0xFFFE)     /* in place of the raw temperature as well */
 
 typedef enum {
   MEMORY_NO_STATE = 0,
@@ -58,7 +66,10 @@ typedef enum {
 
 /**
  * @brief Sensors measurements log entry
- * Contains timestamp, raw temperature, raw humidity, raw lux and reserved fields
+ * Contains timestamp, raw temperature, raw humidity, raw lux, averaged acceleration, the vibration summary and
+ * the number of frames suppressed by the logging policy before this one
+ * @note The timestamp is of the RTC wake up, the pipelined temperature, humidity and lux are measured one wake up
+ * period earlier (ACQUISITION_Frame_t triggerTimestamp), the period is the one of the last wake up period entry
  */
 typedef struct __attribute__((packed)) {
   int32_t timestamp;
@@ -68,18 +79,82 @@ typedef struct __attribute__((packed)) {
   int16_t accelX;
   int16_t accelY;
   int16_t accelZ;
-  uint32_t reserved; // 4 bytes reserved, can be event type, extra info etc.
+  VIBRATION_Summary_t vibration; // 4 bytes, features of the FIFO window the acceleration is averaged over
+  uint16_t suppressedCount; // frames within the deadbands since the previous entry
 } MEMORY_SensorsMeasurementEntry_t;
 
+/**
+ * @brief Log entry pointing to the shock capture slot, the same size as the measurements entry
+ */
+typedef struct __attribute__((packed)) {
+  int32_t timestamp; ///< UNIX timestamp of the trigger
+  uint16_t marker; ///< MEMORY_SHOCK_POINTER_MARKER
+  uint16_t samplesCount;
+  uint32_t address; ///< Capture slot address
+  uint32_t sequence;
+  uint32_t triggerTick;
+  uint16_t reserved;
+} MEMORY_ShockPointerEntry_t;
+
+/**
+ * @brief Log entry recording the wake up period change, the following entries are this period apart
+ */
+typedef struct __attribute__((packed)) {
+  int32_t timestamp; ///< UNIX timestamp the new period starts from
+  uint16_t marker; ///< MEMORY_WAKE_UP_PERIOD_MARKER
+  uint16_t periodSeconds;
+  uint16_t previousPeriodSeconds;
+  uint8_t reason; ///< CRON_PeriodReason_t
+  uint8_t reserved[11];
+} MEMORY_WakeUpPeriodEntry_t;
+
+/**
+ * @brief Header of the shock capture slot, followed by the interleaved X, Y, Z samples
+ */
+typedef struct __attribute__((packed)) {
+  uint32_t magic; ///< MEMORY_SHOCK_CAPTURE_MAGIC
+  uint32_t sequence; ///< Increments with every capture, selects the slot
+  int32_t timestamp; ///< UNIX timestamp of the trigger
+  uint32_t triggerTick;
+  uint16_t samplesCount;
+  uint16_t triggerIndex; ///< Samples before the trigger
+  uint16_t odrHz;
+  uint8_t fullScaleG;
+  uint8_t isFreeFall;
+  uint32_t samplesCRC32; ///< CRC-32/ISO-HDLC of the samples
+} MEMORY_ShockCaptureHeader_t;
+
+_Static_assert(sizeof(MEMORY_SensorsMeasurementEntry_t) == MEMORY_LOG_ENTRY_SIZE, "log entry size mismatch");
+_Static_assert(sizeof(MEMORY_ShockPointerEntry_t) == MEMORY_LOG_ENTRY_SIZE, "shock pointer entry size mismatch");
+_Static_assert(sizeof(MEMORY_WakeUpPeriodEntry_t) == MEMORY_LOG_ENTRY_SIZE, "wake up period entry size mismatch");
+
+/**
+ * @brief Request to read the log bytes into the requester's buffer, posted by NFC and USB stream as
+ * GLOBAL_CMD_READ_LOG_CHUNK, answered to the requester with GLOBAL_LOG_CHUNK_READ_SUCCESS
+ * @note Zero size only reports the log tail address
+ */
+typedef struct {
+  ACTOR_ID requesterId; ///< Actor to answer, its buffer is filled
+  uint32_t address; ///< NOR Flash address to read from
+  uint32_t size;
+  uint8_t *buffer;
+  uint32_t logTailAddress; ///< Filled by MEMORY: end of the written log
+} MEMORY_LogReadRequest_t;
+
 typedef struct {
   actor_t super;
   MEMORY_State_t state;
   uint32_t logFileTailAddress; ///< Address of the last free space to append into the log file
+  uint32_t eventRecorderTailAddress; ///< Address to append the next event records to, in the event recorder area
+  uint32_t shockCaptureSequence; ///< Sequence of the next shock capture, selects its slot
+  LOG_POLICY_t logPolicy; ///< Deadband logging policy of the measurements frames
 } MEMORY_Actor_t;
 
 actor_t* MEMORY_TaskInit(void);
 void MEMORY_Task(void *argument);
 uint32_t MEMORY_SeekFreeSpaceAddress(void);
+uint32_t MEMORY_SeekEventRecorderTailAddress(void);
+uint32_t MEMORY_SeekShockCaptureSequence(void);
 
 #ifdef __cplusplus
 }
@@ -8,16 +8,220 @@
 
 #include "nfc.h"
 #include "nfc_handlers.h"
+#include "log_codec.h"
+#include "log_query.h"
+#include "ndef_summary.h"
+#include "conversions.h"
+
+typedef enum {
+  NFC_LOG_TRANSFER_OPENING = 0, ///< Waiting for the log tail from MEMORY
+  NFC_LOG_TRANSFER_SENDING,
+  NFC_LOG_TRANSFER_FINISHING, ///< Transfer is over, late events are ignored
+} NFC_LogTransferPhase_t;
+
+/**
+ * @brief Log transfer context, one transfer at a time: the FTM export or the mailbox chunks stream
+ *
+ * The range is read from MEMORY in blocks, block k is loaded into the buffer k % NFC_LOG_TRANSFER_BUFFERS_COUNT.
+ * The buffer is reused when its block is released: acknowledged by the phone (FTM) or consumed by the encoder of the
+ * compressed mailbox frames (chunks). The buffers are claimed from the log transfer pool, the USB export shares them.
+ */
+typedef struct {
+  NFC_LogTransferPhase_t phase;
+  NFC_LogExportRange_t range;
+  MEMORY_LogReadRequest_t read; ///< Pending MEMORY read, one at a time
+  bool isReadPending;
+  uint32_t startAddress;
+  uint32_t size;
+  uint32_t blockSize;
+  uint32_t blocksCount;
+  uint32_t loadedBlocks;
+  uint32_t releasedBlocks;
+  LOG_CODEC_State_t codec; ///< Chunks encoder, carried across the frames
+  uint32_t encodedSize; ///< Range bytes already in the frames
+  uint32_t frameEntries;
+  uint32_t frameCycles;
+  uint8_t framePayloadSize;
+  bool isFrameReady; ///< Next frame is encoded in the mailbox buffer, an empty one ends the stream
+  bool isEndWritten;
+  bool isMailboxBusy; ///< Frame is written, the phone didn't read it yet
+  uint32_t fieldSeenTick;
+  LOG_TRANSFER_POOL_Buffer_t *buffers; ///< Claimed for the transfer, released once it's over and no read is pending
+} NFC_LogTransfer_t;
+
+#define NFC_LOG_CHUNKS_BLOCK_SIZE ((NFC_LOG_EXPORT_SEGMENT_SIZE / MEMORY_LOG_ENTRY_SIZE) * MEMORY_LOG_ENTRY_SIZE)
+#define NFC_LOG_CHUNKS_PAYLOAD_SIZE (ST25DV_MAX_MAILBOX_LENGTH - NFC_MAILBOX_PROTOCOL_HEADER_SIZE)
+
+_Static_assert(LOG_CODEC_RECORD_SIZE == MEMORY_LOG_ENTRY_SIZE, "log codec entry size mismatch");
+_Static_assert(NFC_LOG_EXPORT_SEGMENT_SIZE <= LOG_TRANSFER_POOL_BUFFER_SIZE, "FTM segment doesn't fit the pool buffer");
+_Static_assert(NFC_LOG_CHUNKS_PAYLOAD_SIZE <= UINT8_MAX, "log chunk size doesn't fit the frame header");
+
+/**
+ * @brief Log query evaluated by MEMORY, one at a time
+ */
+typedef struct {
+  LOG_QUERY_t query;
+  bool isPending; ///< MEMORY evaluates the query, the context can't be reused yet
+} NFC_LogQuery_t;
+
+typedef enum {
+  NFC_COMMAND_FREE = 0,
+  NFC_COMMAND_EXECUTING, ///< Dispatched, waits for its result event
+  NFC_COMMAND_READY, ///< Response frame waits for the free mailbox
+} NFC_CommandPhase_t;
+
+/**
+ * @brief Pipelined command: its payload is kept in the frame while it's executed, the executor reads or fills it
+ * in place, and the response is built in the same frame
+ */
+typedef struct {
+  NFC_CommandPhase_t phase;
+  event_t command;
+  uint32_t order; ///< Dispatch order while executing, completion order when ready
+  uint8_t frame[ST25DV_MAX_MAILBOX_LENGTH];
+} NFC_Command_t;
+
+/**
+ * @brief In-flight commands table
+ *
+ * The executors answer in the order they are dispatched to, so the result event completes the oldest executing
+ * command it belongs to. The responses are written in the completion order, one at a time: the next one once
+ * the phone has read the previous one.
+ */
+typedef struct {
+  NFC_Command_t commands[NFC_COMMANDS_IN_FLIGHT];
+  NFC_Command_t *validated; ///< Command being received, NULL for the log transfers
+  uint32_t ordersCount;
+} NFC_CommandTable_t;
 
 static osStatus_t handleNFCFSM(NFC_Actor_t *this, message_t *message);
-static osStatus_t handleInit(NFC_Actor_t *this, message_t *message);
-static osStatus_t handleStandby(NFC_Actor_t *this, message_t *message);
-static osStatus_t handleMailboxReceiveCMD(NFC_Actor_t *this, message_t *message);
-static osStatus_t handleMailboxValidate(NFC_Actor_t *this, message_t *message);
-static osStatus_t handleMailboxWriteResponse(NFC_Actor_t *this, message_t *message);
+/** transitions actions */
+static osStatus_t initialize(NFC_Actor_t *this, message_t *message);
+static osStatus_t handleGPOInterrupt(NFC_Actor_t *this, message_t *message);
+static osStatus_t pollTagStatus(NFC_Actor_t *this, message_t *message);
+static osStatus_t receiveMailboxCMD(NFC_Actor_t *this, message_t *message);
+static osStatus_t prepareCRCErrorResponse(NFC_Actor_t *this, message_t *message);
+static osStatus_t prepareErrorResponse(NFC_Actor_t *this, message_t *message);
+static osStatus_t prepareBusyResponse(NFC_Actor_t *this, message_t *message);
+static osStatus_t completeCommand(NFC_Actor_t *this, message_t *message);
+static osStatus_t flushResponses(NFC_Actor_t *this, message_t *message);
+static osStatus_t writeMailboxResponse(NFC_Actor_t *this, message_t *message);
+static osStatus_t openLogTransfer(NFC_Actor_t *this, message_t *message);
+static osStatus_t handleLogExportRead(NFC_Actor_t *this, message_t *message);
+static osStatus_t handleLogExportGPOInterrupt(NFC_Actor_t *this, message_t *message);
+static osStatus_t pumpLogExport(NFC_Actor_t *this, message_t *message);
+static osStatus_t expireLogExport(NFC_Actor_t *this, message_t *message);
+static osStatus_t finishLogExport(NFC_Actor_t *this, message_t *message);
+static osStatus_t handleLogChunkRead(NFC_Actor_t *this, message_t *message);
+static osStatus_t pollLogChunks(NFC_Actor_t *this, message_t *message);
+static osStatus_t expireLogChunk(NFC_Actor_t *this, message_t *message);
+static osStatus_t interruptLogChunks(NFC_Actor_t *this, message_t *message);
+static osStatus_t finishLogChunks(NFC_Actor_t *this, message_t *message);
+static osStatus_t requestLogQuery(NFC_Actor_t *this, message_t *message);
+static osStatus_t refreshSummary(NFC_Actor_t *this, message_t *message);
+static osStatus_t closeSession(NFC_Actor_t *this, message_t *message);
+static osStatus_t handleUnhandledEvent(NFC_Actor_t *this, message_t *message);
+/** utils */
+static uint8_t calculateFrameCRC8(const uint8_t *frame);
+static NFC_Command_t *allocateCommand(void);
+static osStatus_t acceptCommand(NFC_Actor_t *this, NFC_Command_t *command);
+static void finishCommand(NFC_Command_t *command, uint8_t responseCode, uint8_t payloadSize);
+static void finishCommandByResult(message_t *message);
+static event_t resultEventOf(event_t command);
+static bool isValidPayloadSize(event_t command, uint8_t payloadSize);
+static osStatus_t writeReadyResponse(NFC_Actor_t *this);
+static bool clampLogRange(uint32_t blockSize);
+static osStatus_t startLogExport(NFC_Actor_t *this);
+static osStatus_t startLogChunks(NFC_Actor_t *this);
+static osStatus_t pumpLogChunks(NFC_Actor_t *this);
+static void prepareLogFrame(NFC_Actor_t *this);
+static osStatus_t writeLogFrame(NFC_Actor_t *this);
+static osStatus_t prefetchLogBlock(NFC_Actor_t *this);
+static osStatus_t requestLogRead(NFC_Actor_t *this, uint32_t address, uint8_t *buffer, uint32_t size);
+static osStatus_t postLogTransferDone(NFC_Actor_t *this, osStatus_t status);
+static void releaseLogTransferBuffers(void);
+static void supplyLogExportData(uint8_t *buffer, uint8_t *source, uint32_t length);
+static void accumulateSummary(const ACQUISITION_Frame_t *frame);
+static void writeSummary(NFC_Actor_t *this);
+static bool updateFieldState(NFC_Actor_t *this);
+
+/**
+ * @brief Response to the frame with the wrong CRC, its CRC is set on the write
+ */
+static const uint8_t crcErrorResponse[NFC_MAILBOX_PROTOCOL_HEADER_SIZE] = {
+  [NFC_MAILBOX_PROTOCOL_CMD_ADDR] = NFC_RESPONSE_NACK_CRC_ERROR,
+  [NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR] = 0x00,
+};
+
+/**
+ * @brief Response to the command which can't be processed, e.g. the empty log export range
+ */
+static const uint8_t errorResponse[NFC_MAILBOX_PROTOCOL_HEADER_SIZE] = {
+  [NFC_MAILBOX_PROTOCOL_CMD_ADDR] = NFC_RESPONSE_NACK_ERROR,
+  [NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR] = 0x00,
+};
+
+/**
+ * @brief Response to the command which doesn't fit the in-flight commands table
+ */
+static const uint8_t busyResponse[NFC_MAILBOX_PROTOCOL_HEADER_SIZE] = {
+  [NFC_MAILBOX_PROTOCOL_CMD_ADDR] = NFC_RESPONSE_NACK_BUSY,
+  [NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR] = 0x00,
+};
+
+static NFC_LogTransfer_t logTransferContext;
+static NFC_LogQuery_t logQueryContext;
+static NFC_CommandTable_t commandTable;
+static NDEF_SUMMARY_t summaryContext; ///< Kept across the restarts from ERROR, the EEPROM copy is read back
 
 extern actor_t* ACTORS_LOOKUP_SystemRegistry[MAX_ACTORS];
 
+/**
+ * @brief NFC FSM transitions table
+ * @note rendered to the README state diagram by scripts/generate_state_machine_diagrams.py
+ * @note The commands results (e.g. GLOBAL_SETTINGS_READ_SUCCESS) complete the in-flight commands in any state,
+ * the responses are written in standby
+ */
+static const FSM_Transition_t nfcTransitions[] = {
+  FSM_TRANSITION(NFC_NO_STATE,                      GLOBAL_CMD_INITIALIZE,              initialize,               NFC_STANDBY_STATE),
+  FSM_TRANSITION(NFC_STANDBY_STATE,                 NFC_GPO_INTERRUPT,                  handleGPOInterrupt,       NFC_MAILBOX_RECEIVE_CMD_STATE),
+  FSM_TRANSITION(NFC_STANDBY_STATE,                 GLOBAL_MEASUREMENTS_FRAME_READY,    refreshSummary,           NFC_STANDBY_STATE),
+  FSM_TRANSITION(NFC_STANDBY_STATE,                 NFC_FIELD_OFF,                      closeSession,             NFC_STANDBY_STATE),
+  FSM_TRANSITION(NFC_STANDBY_STATE,                 GLOBAL_SETTINGS_WRITE_SUCCESS,      completeCommand,          NFC_STANDBY_STATE),
+  FSM_TRANSITION(NFC_STANDBY_STATE,                 GLOBAL_SETTINGS_READ_SUCCESS,       completeCommand,          NFC_STANDBY_STATE),
+  FSM_TRANSITION(NFC_STANDBY_STATE,                 GLOBAL_LOG_QUERY_SUCCESS,           completeCommand,          NFC_STANDBY_STATE),
+  FSM_TRANSITION(NFC_MAILBOX_RECEIVE_CMD_STATE,     NFC_GPO_INTERRUPT,                  handleGPOInterrupt,       NFC_MAILBOX_RECEIVE_CMD_STATE),
+  FSM_TRANSITION(NFC_MAILBOX_RECEIVE_CMD_STATE,     NFC_TAG_STATUS_POLL,                pollTagStatus,            NFC_MAILBOX_RECEIVE_CMD_STATE),
+  FSM_TRANSITION(NFC_MAILBOX_RECEIVE_CMD_STATE,     NEW_MAILBOX_RF_CMD,                 receiveMailboxCMD,        NFC_VALIDATE_MAILBOX_STATE),
+  FSM_TRANSITION(NFC_MAILBOX_RECEIVE_CMD_STATE,     NFC_MAILBOX_RESPONSE_READ,          flushResponses,           NFC_STANDBY_STATE),
+  FSM_TRANSITION(NFC_MAILBOX_RECEIVE_CMD_STATE,     NFC_FIELD_OFF,                      closeSession,             NFC_STANDBY_STATE),
+  FSM_TRANSITION(NFC_VALIDATE_MAILBOX_STATE,        NEW_MAILBOX_RF_CMD,                 receiveMailboxCMD,        NFC_VALIDATE_MAILBOX_STATE),
+  FSM_TRANSITION(NFC_VALIDATE_MAILBOX_STATE,        NFC_CRC_ERROR,                      prepareCRCErrorResponse,  NFC_MAILBOX_WRITE_RESPONSE_STATE),
+  FSM_TRANSITION(NFC_VALIDATE_MAILBOX_STATE,        NFC_CMD_REJECTED,                   prepareErrorResponse,     NFC_MAILBOX_WRITE_RESPONSE_STATE),
+  FSM_TRANSITION(NFC_VALIDATE_MAILBOX_STATE,        NFC_CMD_BUSY,                       prepareBusyResponse,      NFC_MAILBOX_WRITE_RESPONSE_STATE),
+  FSM_TRANSITION(NFC_VALIDATE_MAILBOX_STATE,        NFC_CMD_ACCEPTED,                   flushResponses,           NFC_STANDBY_STATE),
+  FSM_TRANSITION(NFC_VALIDATE_MAILBOX_STATE,        GLOBAL_CMD_EXPORT_LOG,              openLogTransfer,          NFC_LOG_EXPORT_STATE),
+  FSM_TRANSITION(NFC_VALIDATE_MAILBOX_STATE,        GLOBAL_CMD_READ_LOG_CHUNK,          openLogTransfer,          NFC_LOG_CHUNKS_STATE),
+  FSM_TRANSITION(NFC_VALIDATE_MAILBOX_STATE,        GLOBAL_CMD_QUERY_LOG,               requestLogQuery,          NFC_VALIDATE_MAILBOX_STATE),
+  FSM_TRANSITION(NFC_MAILBOX_WRITE_RESPONSE_STATE,  GLOBAL_CMD_NFC_MAILBOX_WRITE,       writeMailboxResponse,     NFC_STANDBY_STATE),
+  FSM_TRANSITION(NFC_LOG_EXPORT_STATE,              GLOBAL_LOG_CHUNK_READ_SUCCESS,      handleLogExportRead,      NFC_LOG_EXPORT_STATE),
+  FSM_TRANSITION(NFC_LOG_EXPORT_STATE,              NFC_LOG_EXPORT_POLL,                pumpLogExport,            NFC_LOG_EXPORT_STATE),
+  FSM_TRANSITION(NFC_LOG_EXPORT_STATE,              NFC_GPO_INTERRUPT,                  handleLogExportGPOInterrupt, NFC_LOG_EXPORT_STATE),
+  FSM_TRANSITION(NFC_LOG_EXPORT_STATE,              NFC_LOG_EXPORT_FIELD_LOST,          expireLogExport,          NFC_LOG_EXPORT_STATE),
+  FSM_TRANSITION(NFC_LOG_EXPORT_STATE,              NFC_LOG_TRANSFER_REJECTED,          prepareErrorResponse,     NFC_MAILBOX_WRITE_RESPONSE_STATE),
+  FSM_TRANSITION(NFC_LOG_EXPORT_STATE,              NFC_LOG_TRANSFER_DONE,              finishLogExport,          NFC_STANDBY_STATE),
+  FSM_TRANSITION(NFC_LOG_CHUNKS_STATE,              GLOBAL_LOG_CHUNK_READ_SUCCESS,      handleLogChunkRead,       NFC_LOG_CHUNKS_STATE),
+  FSM_TRANSITION(NFC_LOG_CHUNKS_STATE,              NFC_GPO_INTERRUPT,                  pollLogChunks,            NFC_LOG_CHUNKS_STATE),
+  FSM_TRANSITION(NFC_LOG_CHUNKS_STATE,              NFC_LOG_CHUNKS_RETRY,               pollLogChunks,            NFC_LOG_CHUNKS_STATE),
+  FSM_TRANSITION(NFC_LOG_CHUNKS_STATE,              NFC_LOG_CHUNKS_TIMEOUT,             expireLogChunk,           NFC_LOG_CHUNKS_STATE),
+  FSM_TRANSITION(NFC_LOG_CHUNKS_STATE,              NFC_LOG_CHUNKS_INTERRUPTED,         interruptLogChunks,       NFC_MAILBOX_RECEIVE_CMD_STATE),
+  FSM_TRANSITION(NFC_LOG_CHUNKS_STATE,              NFC_LOG_TRANSFER_REJECTED,          prepareErrorResponse,     NFC_MAILBOX_WRITE_RESPONSE_STATE),
+  FSM_TRANSITION(NFC_LOG_CHUNKS_STATE,              NFC_LOG_TRANSFER_DONE,              finishLogChunks,          NFC_STANDBY_STATE),
+  FSM_TRANSITION(NFC_STATE_ERROR,                   GLOBAL_CMD_RESTART,                 initialize,               NFC_STANDBY_STATE),
+};
+
+static const FSM_Table_t nfcFSMTable = FSM_TABLE(nfcTransitions, handleUnhandledEvent);
+
 NFC_Actor_t NFC_Actor = {
         .super = {
                 .actorId = NFC_ACTOR_ID,
@@ -28,7 +232,7 @@ NFC_Actor_t NFC_Actor = {
         .state = NFC_NO_STATE
 };
 
-uint32_t nfcTaskBuffer[DEFAULT_TASK_STACK_SIZE_WORDS];
+uint32_t nfcTaskBuffer[NFC_TASK_STACK_SIZE_WORDS];
 StaticTask_t nfcTaskControlBlock;
 const osThreadAttr_t nfcTaskDescription = {
         .name = "nfcTask",
@@ -40,6 +244,8 @@ const osThreadAttr_t nfcTaskDescription = {
 };
 
 actor_t* NFC_TaskInit(void) {
+  NDEF_SUMMARY_Init(&summaryContext);
+
   NFC_Actor.super.osMessageQueueId = osMessageQueueNew(DEFAULT_QUEUE_SIZE, DEFAULT_QUEUE_MESSAGE_SIZE, &(osMessageQueueAttr_t){
     .name = "nfcQueue"
   });
@@ -70,155 +276,1006 @@ void NFC_Task(void *argument) {
 }
 
 static osStatus_t handleNFCFSM(NFC_Actor_t *this, message_t *message) {
-  switch (this->state) {
-    case NFC_NO_STATE:
-      return handleInit(this, message);
-    case NFC_STANDBY_STATE:
-      return handleStandby(this, message);
-    case NFC_MAILBOX_RECEIVE_CMD_STATE:
-      return handleMailboxReceiveCMD(this, message);
-    case NFC_VALIDATE_MAILBOX_STATE:
-      return handleMailboxValidate(this, message);
-    case NFC_MAILBOX_WRITE_RESPONSE_STATE:
-      return handleMailboxWriteResponse(this, message);
-    default:
-      return osOK;
-  }
+  if (ACTOR_TIMER_IsStaleExpiry(&this->logTransferTimer, message)) return osOK;
+
+  uint8_t state = this->state;
+  osStatus_t status = FSM_Dispatch(&nfcFSMTable, &this->super, message, &state);
+  this->state = state;
+
+  return status;
 }
 
-static osStatus_t handleInit(NFC_Actor_t *this, message_t *message) {
+static osStatus_t initialize(NFC_Actor_t *this, message_t *message) {
+  UNUSED(message);
   osStatus_t ioStatus;
   ST25DV_UID uid = {0x00000000, 0x00000000};
   const ST25DV_PASSWD i2cPwd = {0x00000000, 0x00000000};
 
-  switch (message->event) {
-    case GLOBAL_CMD_INITIALIZE:
-      ioStatus = NFC_ST25DVInit(&this->st25dv);
-      if (ioStatus != NFCTAG_OK)
-        return osError;
+  ioStatus = NFC_ST25DVInit(&this->st25dv);
+  if (ioStatus != NFCTAG_OK)
+    return osError;
 
-      ioStatus = ST25DV_PresentI2CPassword(&this->st25dv, i2cPwd);
-      if (ioStatus != NFCTAG_OK)
-        return osError;
+  ioStatus = ST25DV_PresentI2CPassword(&this->st25dv, i2cPwd);
+  if (ioStatus != NFCTAG_OK)
+    return osError;
 
-      ioStatus = ST25DV_ReadUID(&this->st25dv, &uid);
-      if (ioStatus != NFCTAG_OK)
-        return osError;
+  ioStatus = NFC_ConfigureMailboxGPO(&this->st25dv);
+  if (ioStatus != NFCTAG_OK)
+    return osError;
 
-      #ifdef DEBUG
-            fprintf(stdout, "NFC task initialized, UID: 0x%x %x\n", uid.MsbUid, uid.LsbUid);
-      #endif
+  ioStatus = ST25DV_ReadUID(&this->st25dv, &uid);
+  if (ioStatus != NFCTAG_OK)
+    return osError;
 
-      TO_STATE(this, NFC_STANDBY_STATE);
-      return osOK;
-    default:
-      return osOK;
+  // the summary refresh rewrites the blocks which differ from the EEPROM, e.g. nothing after a reboot with the same values
+  ioStatus = St25Dv_Drv.ReadData(&this->st25dv, summaryContext.eeprom, NDEF_SUMMARY_EEPROM_ADDR, NDEF_SUMMARY_SIZE);
+  if (ioStatus != NFCTAG_OK)
+    return osError;
+
+  ACTOR_TIMER_Stop(&this->logTransferTimer); // restarted from ERROR in the middle of the log transfer
+  logTransferContext.phase = NFC_LOG_TRANSFER_FINISHING;
+  releaseLogTransferBuffers();
+  ST25FTM_Init();
+  this->isFieldOn = false;
+
+  #ifdef DEBUG
+    fprintf(stdout, "NFC task initialized, UID: 0x%x %x\n", uid.MsbUid, uid.LsbUid);
+  #endif
+
+  // the command written while NFC was down has pulsed the GPO already, it's still in the mailbox
+  return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {.event = NFC_GPO_INTERRUPT}, 0, 0);
+}
+
+/**
+ * @brief In the session the tag status is read at once, the phone waits for the response. Out of it the I2C is
+ * deferred: the field rising, the first command and the field falling of a short tap (e.g. the NDEF summary read)
+ * pulse within the debounce and cost one status read, the sensors own the bus meanwhile.
+ */
+static osStatus_t handleGPOInterrupt(NFC_Actor_t *this, message_t *message) {
+  if (this->isFieldOn)
+    return pollTagStatus(this, message);
+
+  // the debounce or the retry is pending, it reads the latched interrupts of this pulse too
+  if (ACTOR_TIMER_IsArmed(&this->logTransferTimer))
+    return osOK;
+
+  return ACTOR_TIMER_StartOneShot(&this->logTransferTimer, NFC_ACTOR_ID, NFC_TAG_STATUS_POLL, NFC_FIELD_DEBOUNCE_MS);
+}
+
+/**
+ * @brief Receives the command or writes the ready response, the field falling ends the session
+ * @note The RF holding the tag NACKs the reads, the read is retried
+ */
+static osStatus_t pollTagStatus(NFC_Actor_t *this, message_t *message) {
+  UNUSED(message);
+  if (NFC_HandleGPOInterrupt(&this->st25dv, &this->tagStatus) != NFCTAG_OK)
+    return ACTOR_TIMER_StartOneShot(&this->logTransferTimer, NFC_ACTOR_ID, NFC_TAG_STATUS_POLL, NFC_MAILBOX_RETRY_PERIOD_MS);
+
+  if (!updateFieldState(this))
+    return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {.event = NFC_FIELD_OFF}, 0, 0);
+
+  return osOK;
+}
+
+static osStatus_t receiveMailboxCMD(NFC_Actor_t *this, message_t *message) {
+  UNUSED(message);
+  NFC_CommandTable_t *table = &commandTable;
+  osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
+
+  // the message stays in the mailbox until it's read, the phone can't write the next one meanwhile
+  if (NFC_ReadMailboxTo(&this->st25dv, &this->tagStatus, this->mailboxBuffer) != NFCTAG_OK)
+    return ACTOR_TIMER_StartOneShot(&this->logTransferTimer, NFC_ACTOR_ID, NEW_MAILBOX_RF_CMD, NFC_MAILBOX_RETRY_PERIOD_MS);
+
+  // only the message is read, the frame shouldn't run past it
+  const uint16_t messageLength = (uint16_t) this->tagStatus.mailboxLength + 1;
+  const bool isValidSize = messageLength >= NFC_MAILBOX_PROTOCOL_HEADER_SIZE
+    && NFC_MAILBOX_PROTOCOL_HEADER_SIZE + this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR] <= messageLength;
+  const bool isValidCRC8 = isValidSize && this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_CRC8_ADDR] == calculateFrameCRC8(this->mailboxBuffer);
+
+  this->commandSequence = this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_SEQ_ADDR];
+  table->validated = NULL;
+
+  if (!isValidCRC8)
+    return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {.event = NFC_CRC_ERROR}, 0, 0);
+
+  // get CMD from read mailbox
+  const event_t cmdEvent = this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_CMD_ADDR];
+  const uint8_t payloadSize = this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR];
+  uint8_t *payload = this->mailboxBuffer + NFC_MAILBOX_PROTOCOL_PAYLOAD_ADDR; // address where useful payload could be written by another module
+
+  if (cmdEvent < GLOBAL_CMD_START_LOGGING || cmdEvent >= GLOBAL_CMD_MAX)
+    return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {.event = NFC_CMD_REJECTED}, 0, 0);
+
+  #ifdef DEBUG
+    fprintf(stdout, "RF CMD: 0x%x, SEQ: %u\n", cmdEvent, this->commandSequence);
+  #endif
+
+  // the log transfers own the mailbox until they are over, the rest of the commands are pipelined
+  if (cmdEvent != GLOBAL_CMD_EXPORT_LOG && cmdEvent != GLOBAL_CMD_READ_LOG_CHUNK) {
+    NFC_Command_t *command = allocateCommand();
+
+    if (command == NULL)
+      return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {.event = NFC_CMD_BUSY}, 0, 0);
+
+    // the next command overwrites the mailbox buffer, the executor gets the command's own copy
+    memcpy(command->frame, this->mailboxBuffer, NFC_MAILBOX_PROTOCOL_HEADER_SIZE + payloadSize);
+    command->command = cmdEvent;
+    command->phase = NFC_COMMAND_EXECUTING;
+    command->order = table->ordersCount++;
+    payload = &command->frame[NFC_MAILBOX_PROTOCOL_PAYLOAD_ADDR];
+    table->validated = command;
+
+    if (!isValidPayloadSize(cmdEvent, payloadSize)) {
+      finishCommand(command, NFC_RESPONSE_NACK_ERROR, 0);
+      return acceptCommand(this, command);
+    }
   }
+
+  // dispatch received CMD to EV_MANAGER (globally)
+  osMessageQueuePut(evManagerQueue, &(message_t){.event = cmdEvent, .payload.ptr = payload, .payload_size = payloadSize}, 0, 0);
+
+  // the routed log commands are taken by NFC itself in the validate state
+  if (table->validated == NULL || cmdEvent == GLOBAL_CMD_QUERY_LOG)
+    return osOK;
+
+  return acceptCommand(this, table->validated);
 }
 
-static osStatus_t handleStandby(NFC_Actor_t *this, message_t *message) {
+static osStatus_t prepareCRCErrorResponse(NFC_Actor_t *this, message_t *message) {
+  UNUSED(message);
+  osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {
+    .event = GLOBAL_CMD_NFC_MAILBOX_WRITE,
+    .payload.ptr = (void *) crcErrorResponse,
+    .payload_size = sizeof(crcErrorResponse)
+  }, 0, 0);
+
+  return osOK;
+}
+
+static osStatus_t prepareErrorResponse(NFC_Actor_t *this, message_t *message) {
+  UNUSED(message);
+  osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {
+    .event = GLOBAL_CMD_NFC_MAILBOX_WRITE,
+    .payload.ptr = (void *) errorResponse,
+    .payload_size = sizeof(errorResponse)
+  }, 0, 0);
+
+  return osOK;
+}
+
+static osStatus_t prepareBusyResponse(NFC_Actor_t *this, message_t *message) {
+  UNUSED(message);
+  osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {
+    .event = GLOBAL_CMD_NFC_MAILBOX_WRITE,
+    .payload.ptr = (void *) busyResponse,
+    .payload_size = sizeof(busyResponse)
+  }, 0, 0);
+
+  return osOK;
+}
+
+/**
+ * @brief Result event completes its in-flight command, the response is written if the mailbox is free
+ */
+static osStatus_t completeCommand(NFC_Actor_t *this, message_t *message) {
+  finishCommandByResult(message);
+
+  return writeReadyResponse(this);
+}
+
+/**
+ * @brief Writes the oldest ready response, if any
+ */
+static osStatus_t flushResponses(NFC_Actor_t *this, message_t *message) {
+  UNUSED(message);
+  return writeReadyResponse(this);
+}
+
+/**
+ * @brief Writes the immediate response of the last received command, e.g. NACK, its SEQ and CRC are set here
+ */
+static osStatus_t writeMailboxResponse(NFC_Actor_t *this, message_t *message) {
+  uint8_t *payloadData = (uint8_t *) message->payload.ptr;
+
+  if (message->payload_size < NFC_MAILBOX_PROTOCOL_HEADER_SIZE || message->payload_size > ST25DV_MAX_MAILBOX_LENGTH)
+    return osErrorParameter;
+
+  memcpy(this->mailboxBuffer, payloadData, message->payload_size);
+
+  const uint16_t frameSize = NFC_MAILBOX_PROTOCOL_HEADER_SIZE + this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR];
+  this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_SEQ_ADDR] = this->commandSequence;
+  this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_CRC8_ADDR] = calculateFrameCRC8(this->mailboxBuffer);
+
+  return (osStatus_t) ST25DV_WriteMailboxData(&this->st25dv, this->mailboxBuffer, frameSize);
+}
+
+/**
+ * @brief CRC-8/NRSC-5 of the frame after the CRC byte: CMD, SEQ, payload size and payload
+ * @note The payload size should be validated by the caller to fit the mailbox
+ */
+static uint8_t calculateFrameCRC8(const uint8_t *frame) {
+  const uint16_t length = NFC_MAILBOX_PROTOCOL_HEADER_SIZE - NFC_MAILBOX_PROTOCOL_CRC8_SIZE + frame[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR];
+
+  return CRC_SERVICE_Crc8(&frame[NFC_MAILBOX_PROTOCOL_CMD_ADDR], length);
+}
+
+/**
+ * @brief Free entry of the in-flight commands table, the oldest undelivered response is dropped if there is none
+ * (e.g. the phone left before reading it). The executing commands are never dropped, their executors own the frames.
+ * @return NULL if all the commands are executing
+ */
+static NFC_Command_t *allocateCommand(void) {
+  NFC_Command_t *oldestReady = NULL;
+
+  for (uint8_t i = 0; i < NFC_COMMANDS_IN_FLIGHT; i++) {
+    NFC_Command_t *command = &commandTable.commands[i];
+
+    if (command->phase == NFC_COMMAND_FREE) return command;
+
+    if (command->phase == NFC_COMMAND_READY && (oldestReady == NULL || command->order < oldestReady->order)) {
+      oldestReady = command;
+    }
+  }
+
+  return oldestReady;
+}
+
+/**
+ * @brief The command is dispatched, the commands without the result event are answered right away
+ */
+static osStatus_t acceptCommand(NFC_Actor_t *this, NFC_Command_t *command) {
+  if (command->phase == NFC_COMMAND_EXECUTING && resultEventOf(command->command) == EVENT_NONE) {
+    finishCommand(command, NFC_RESPONSE_ACK_OK, 0);
+  }
+
+  return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {.event = NFC_CMD_ACCEPTED}, 0, 0);
+}
+
+/**
+ * @brief Builds the response in the command frame, the payload is already in place
+ */
+static void finishCommand(NFC_Command_t *command, uint8_t responseCode, uint8_t payloadSize) {
+  uint8_t *frame = command->frame;
+
+  frame[NFC_MAILBOX_PROTOCOL_CMD_ADDR] = responseCode;
+  frame[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR] = payloadSize;
+  frame[NFC_MAILBOX_PROTOCOL_CRC8_ADDR] = calculateFrameCRC8(frame); // SEQ is kept from the command
+
+  command->phase = NFC_COMMAND_READY;
+  command->order = commandTable.ordersCount++;
+}
+
+/**
+ * @brief Completes the oldest executing command of the result event with the result status and payload
+ */
+static void finishCommandByResult(message_t *message) {
+  NFC_Command_t *oldest = NULL;
+
+  for (uint8_t i = 0; i < NFC_COMMANDS_IN_FLIGHT; i++) {
+    NFC_Command_t *command = &commandTable.commands[i];
+
+    if (command->phase == NFC_COMMAND_EXECUTING && resultEventOf(command->command) == message->event
+        && (oldest == NULL || command->order < oldest->order)) {
+      oldest = command;
+    }
+  }
+
+  if (message->event == GLOBAL_LOG_QUERY_SUCCESS) {
+    logQueryContext.isPending = false;
+  }
+
+  if (oldest == NULL) return; // the result of a command rejected before dispatch, e.g. the query of the restarted NFC
+
+  if ((osStatus_t) message->payload.value != osOK) {
+    finishCommand(oldest, NFC_RESPONSE_NACK_ERROR, 0);
+    return;
+  }
+
   switch (message->event) {
-    case NFC_GPO_INTERRUPT:
-      NFC_HandleGPOInterrupt(&this->st25dv);
+    case GLOBAL_SETTINGS_READ_SUCCESS:
+      finishCommand(oldest, NFC_RESPONSE_ACK_OK, SETTINGS_DATA_SIZE); // MEMORY read the settings into the frame
+      break;
+    case GLOBAL_LOG_QUERY_SUCCESS:
+      memcpy(&oldest->frame[NFC_MAILBOX_PROTOCOL_PAYLOAD_ADDR], &logQueryContext.query.result, sizeof(LOG_QUERY_Result_t));
+      finishCommand(oldest, NFC_RESPONSE_ACK_OK, sizeof(LOG_QUERY_Result_t));
+      break;
+    default:
+      finishCommand(oldest, NFC_RESPONSE_ACK_OK, 0);
+      break;
+  }
+}
 
-      TO_STATE(this, NFC_MAILBOX_RECEIVE_CMD_STATE);
-      return osOK;
+/**
+ * @return Event completing the pipelined command, EVENT_NONE if it's done once dispatched
+ */
+static event_t resultEventOf(event_t command) {
+  switch (command) {
+    case GLOBAL_CMD_WRITE_SETTINGS:
+      return GLOBAL_SETTINGS_WRITE_SUCCESS;
+    case GLOBAL_CMD_READ_SETTINGS:
+      return GLOBAL_SETTINGS_READ_SUCCESS;
+    case GLOBAL_CMD_QUERY_LOG:
+      return GLOBAL_LOG_QUERY_SUCCESS;
     default:
-      return osOK;
+      return EVENT_NONE;
   }
 }
 
-static osStatus_t handleMailboxReceiveCMD(NFC_Actor_t *this, message_t *message) {
-  uint8_t *mailboxPayload   = NULL;
-  uint8_t mailboxSize       = 0;
-  osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
+/**
+ * @return False if the fixed size payload of the command has the wrong size, the command is answered with NACK
+ */
+static bool isValidPayloadSize(event_t command, uint8_t payloadSize) {
+  switch (command) {
+    case GLOBAL_CMD_WRITE_SETTINGS:
+      return payloadSize == SETTINGS_DATA_SIZE;
+    case GLOBAL_CMD_SET_WAKE_UP_PERIOD:
+      return payloadSize == sizeof(uint16_t);
+    case GLOBAL_CMD_SET_WAKE_UP_PERIOD_BOUNDS:
+      return payloadSize == sizeof(NFC_WakeUpPeriodBounds_t);
+    default:
+      return true;
+  }
+}
 
-  switch (message->event) {
-    case NEW_MAILBOX_RF_CMD:
-      NFC_ReadMailboxTo(&this->st25dv, this->mailboxBuffer);
+/**
+ * @brief Writes the oldest ready response to the mailbox
+ * @note The tag refuses the write while the phone didn't read the previous message or wrote a new command, the
+ * response stays ready and is written once the phone has read the mailbox or the command is received
+ */
+static osStatus_t writeReadyResponse(NFC_Actor_t *this) {
+  NFC_Command_t *oldest = NULL;
 
-      // TODO validate mailbox CRC8 this->mailboxBuffer
-      bool isValidCRC8 = true;
+  for (uint8_t i = 0; i < NFC_COMMANDS_IN_FLIGHT; i++) {
+    NFC_Command_t *command = &commandTable.commands[i];
 
-      if (isValidCRC8) {
-        // get CMD from read mailbox
-        event_t cmdEvent = this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_CMD_ADDR];
-        assert_param(cmdEvent >= GLOBAL_CMD_START_LOGGING && cmdEvent < GLOBAL_EVENTS_MAX);
+    if (command->phase == NFC_COMMAND_READY && (oldest == NULL || command->order < oldest->order)) {
+      oldest = command;
+    }
+  }
 
-        #ifdef DEBUG
-          fprintf(stdout, "RF CMD: 0x%x\n", cmdEvent);
-        #endif
+  if (oldest == NULL) return osOK;
 
-        // dispatch received CMD to EV_MANAGER (globally)
-        mailboxPayload = this->mailboxBuffer + NFC_MAILBOX_PROTOCOL_PAYLOAD_ADDR; // address where useful payload could be written by another module
-        mailboxSize = this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR];
+  const uint16_t frameSize = NFC_MAILBOX_PROTOCOL_HEADER_SIZE + oldest->frame[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR];
 
-        osMessageQueuePut(evManagerQueue,&(message_t){.event = cmdEvent, .payload.ptr = mailboxPayload, .payload_size = mailboxSize}, 0, 0);
-      }
+  if (ST25DV_WriteMailboxData(&this->st25dv, oldest->frame, frameSize) == NFCTAG_OK) {
+    oldest->phase = NFC_COMMAND_FREE;
+  }
 
-      if (!isValidCRC8) {
-        osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {NFC_CRC_ERROR}, 0, 0);
-      }
+  return osOK;
+}
 
-      TO_STATE(this, NFC_VALIDATE_MAILBOX_STATE);
-      return osOK;
-    default:
-      return osOK;
+/**
+ * @brief Starts the log transfer of the command's range: the FTM export or the mailbox chunks stream
+ * @note A zero size read asks MEMORY for the log tail to clamp the range to
+ */
+static osStatus_t openLogTransfer(NFC_Actor_t *this, message_t *message) {
+  NFC_LogTransfer_t *logTransfer = &logTransferContext;
+
+  // a read of the previous transfer may still be in MEMORY queue, its buffer can't be reused yet
+  if (message->payload_size != (ssize_t) sizeof(NFC_LogExportRange_t) || logTransfer->isReadPending) {
+    return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {.event = NFC_LOG_TRANSFER_REJECTED}, 0, 0);
+  }
+
+  memcpy(&logTransfer->range, message->payload.ptr, sizeof(logTransfer->range));
+
+  logTransfer->phase = NFC_LOG_TRANSFER_OPENING;
+  logTransfer->loadedBlocks = 0;
+  logTransfer->releasedBlocks = 0;
+  logTransfer->isMailboxBusy = false;
+
+  return requestLogRead(this, 0, NULL, 0);
+}
+
+static osStatus_t handleLogExportRead(NFC_Actor_t *this, message_t *message) {
+  NFC_LogTransfer_t *logTransfer = &logTransferContext;
+
+  logTransfer->isReadPending = false;
+
+  if (logTransfer->phase == NFC_LOG_TRANSFER_FINISHING) {
+    releaseLogTransferBuffers();
+    return osOK;
+  }
+
+  if (logTransfer->phase == NFC_LOG_TRANSFER_OPENING) {
+    return ((osStatus_t) message->payload.value == osOK)
+      ? startLogExport(this)
+      : osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {.event = NFC_LOG_TRANSFER_REJECTED}, 0, 0);
+  }
+
+  if ((osStatus_t) message->payload.value != osOK)
+    return postLogTransferDone(this, osError);
+
+  logTransfer->loadedBlocks++;
+
+  return pumpLogExport(this, message);
+}
+
+/**
+ * @brief The FTM isn't polled while the phone is away: the bus is released at once, the export resumes when the field
+ * is back before the timeout
+ * @note Reading releases the GPO, the mailbox events themselves are polled by the FTM. The read refused by the busy
+ * RF means the field is on. The FTM field state still times the export out when the pulses are missed.
+ */
+static osStatus_t handleLogExportGPOInterrupt(NFC_Actor_t *this, message_t *message) {
+  const bool wasFieldOn = this->isFieldOn;
+
+  if (NFC_ReadTagStatus(&this->st25dv, &this->tagStatus) == NFCTAG_OK) {
+    updateFieldState(this);
+  } else {
+    this->isFieldOn = true;
+  }
+
+  // the export started (or rejected) later picks its timer by the field state
+  if (this->isFieldOn == wasFieldOn || logTransferContext.phase != NFC_LOG_TRANSFER_SENDING)
+    return pumpLogExport(this, message);
+
+  if (!this->isFieldOn) {
+    return ACTOR_TIMER_StartOneShot(&this->logTransferTimer, NFC_ACTOR_ID, NFC_LOG_EXPORT_FIELD_LOST, NFC_LOG_EXPORT_FIELD_LOST_TIMEOUT_MS);
+  }
+
+  logTransferContext.fieldSeenTick = osKernelGetTickCount();
+
+  osStatus_t status = ACTOR_TIMER_StartPeriodic(&this->logTransferTimer, NFC_ACTOR_ID, NFC_LOG_EXPORT_POLL, NFC_LOG_EXPORT_POLL_PERIOD_MS);
+  if (status != osOK)
+    return status;
+
+  return pumpLogExport(this, message);
+}
+
+/**
+ * @brief Runs the FTM state machine and prefetches the next segment into the freed buffer
+ *
+ * One run writes at most one packet and moves at most to the next segment (after the phone acknowledged the
+ * current one), so the FTM is run only when the next segment is already loaded and the data callback never waits
+ * for the NOR Flash.
+ */
+static osStatus_t pumpLogExport(NFC_Actor_t *this, message_t *message) {
+  UNUSED(message);
+  NFC_LogTransfer_t *logTransfer = &logTransferContext;
+
+  if (logTransfer->phase != NFC_LOG_TRANSFER_SENDING)
+    return osOK;
+
+  // the phone is away, the segments are still prefetched
+  if (!this->isFieldOn)
+    return prefetchLogBlock(this);
+
+  const uint32_t windowEnd = logTransfer->releasedBlocks + NFC_LOG_TRANSFER_BUFFERS_COUNT;
+  const uint32_t neededSegments = (windowEnd < logTransfer->blocksCount) ? windowEnd : logTransfer->blocksCount;
+
+  if (logTransfer->loadedBlocks >= neededSegments) {
+    ST25FTM_Runner();
+  }
+
+  const uint32_t tick = osKernelGetTickCount();
+
+  if (ST25FTM_GetFieldState() == ST25FTM_FIELD_ON) {
+    logTransfer->fieldSeenTick = tick;
+  }
+
+  if (ST25FTM_IsTransmissionComplete())
+    return postLogTransferDone(this, osOK);
+
+  if (ST25FTM_CheckError())
+    return postLogTransferDone(this, osError);
+
+  if (tick - logTransfer->fieldSeenTick > ACTOR_TIMER_MS_TO_TICKS(NFC_LOG_EXPORT_FIELD_LOST_TIMEOUT_MS))
+    return postLogTransferDone(this, osErrorTimeout);
+
+  return prefetchLogBlock(this);
+}
+
+static osStatus_t expireLogExport(NFC_Actor_t *this, message_t *message) {
+  UNUSED(message);
+  if (logTransferContext.phase != NFC_LOG_TRANSFER_SENDING)
+    return osOK;
+
+  return postLogTransferDone(this, osErrorTimeout);
+}
+
+static osStatus_t finishLogExport(NFC_Actor_t *this, message_t *message) {
+  UNUSED(message);
+  ACTOR_TIMER_Stop(&this->logTransferTimer);
+  ST25FTM_Reset();
+  releaseLogTransferBuffers();
+
+  #ifdef DEBUG
+    fprintf(stdout, "Log export status: %" PRId32 ", resent bytes: %" PRIu32 "\n", (int32_t) message->payload.value, ST25FTM_GetRetryLength());
+  #endif
+
+  // the command the phone wrote instead of the FTM acknowledge is still in the mailbox, the pulse receives it or
+  // writes the responses of the pipelined commands completed during the export
+  return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {.event = NFC_GPO_INTERRUPT}, 0, 0);
+}
+
+static osStatus_t handleLogChunkRead(NFC_Actor_t *this, message_t *message) {
+  NFC_LogTransfer_t *logTransfer = &logTransferContext;
+
+  logTransfer->isReadPending = false;
+
+  if (logTransfer->phase == NFC_LOG_TRANSFER_FINISHING) {
+    releaseLogTransferBuffers();
+    return osOK;
+  }
+
+  if (logTransfer->phase == NFC_LOG_TRANSFER_OPENING) {
+    return ((osStatus_t) message->payload.value == osOK)
+      ? startLogChunks(this)
+      : osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {.event = NFC_LOG_TRANSFER_REJECTED}, 0, 0);
+  }
+
+  if ((osStatus_t) message->payload.value != osOK)
+    return postLogTransferDone(this, osError);
+
+  logTransfer->loadedBlocks++;
+
+  return pumpLogChunks(this);
+}
+
+/**
+ * @brief Reads the mailbox interrupts: the phone's read of the frame issues the write of the encoded next one
+ * @note Also run by the retry timer, the interrupt status is cleared on read so no RF event is handled twice
+ */
+static osStatus_t pollLogChunks(NFC_Actor_t *this, message_t *message) {
+  UNUSED(message);
+  NFC_LogTransfer_t *logTransfer = &logTransferContext;
+
+  if (logTransfer->phase != NFC_LOG_TRANSFER_SENDING)
+    return osOK;
+
+  // the I2C is NACKed while the RF is talking to the tag
+  if (NFC_ReadTagStatus(&this->st25dv, &this->tagStatus) != NFCTAG_OK)
+    return ACTOR_TIMER_StartOneShot(&this->logTransferTimer, NFC_ACTOR_ID, NFC_LOG_CHUNKS_RETRY, NFC_LOG_CHUNKS_RETRY_PERIOD_MS);
+
+  const uint8_t itStatus = this->tagStatus.itStatus;
+  updateFieldState(this); // the phone away doesn't read the chunk, the stream times out without the I2C polls
+
+  if (itStatus & ST25DV_ITSTS_DYN_RFPUTMSG_MASK) {
+    logTransfer->phase = NFC_LOG_TRANSFER_FINISHING;
+
+    return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {.event = NFC_LOG_CHUNKS_INTERRUPTED}, 0, 0);
+  }
+
+  if (itStatus & ST25DV_ITSTS_DYN_RFGETMSG_MASK) {
+    logTransfer->isMailboxBusy = false;
+  }
+
+  return pumpLogChunks(this);
+}
+
+/**
+ * @note The timeouts posted before the restart by a write or retry are dropped as stale before the dispatch
+ */
+static osStatus_t expireLogChunk(NFC_Actor_t *this, message_t *message) {
+  UNUSED(message);
+  if (logTransferContext.phase != NFC_LOG_TRANSFER_SENDING || !logTransferContext.isMailboxBusy || ACTOR_TIMER_IsArmed(&this->logTransferTimer))
+    return osOK;
+
+  return postLogTransferDone(this, osErrorTimeout);
+}
+
+/**
+ * @brief Phone sent a new command instead of reading the rest of the stream, it's received as usual
+ */
+static osStatus_t interruptLogChunks(NFC_Actor_t *this, message_t *message) {
+  UNUSED(message);
+  ACTOR_TIMER_Stop(&this->logTransferTimer);
+  releaseLogTransferBuffers();
+
+  return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {.event = NEW_MAILBOX_RF_CMD}, 0, 0);
+}
+
+/**
+ * @note The aborted stream may leave the unread chunk in the mailbox, it's dropped so the phone can write the next command
+ */
+static osStatus_t finishLogChunks(NFC_Actor_t *this, message_t *message) {
+  ACTOR_TIMER_Stop(&this->logTransferTimer);
+  releaseLogTransferBuffers();
+
+  #ifdef DEBUG
+    fprintf(stdout, "Log chunks status: %" PRId32 ", entries: %" PRIu32 "\n", (int32_t) message->payload.value, (uint32_t) (logTransferContext.encodedSize / MEMORY_LOG_ENTRY_SIZE));
+  #endif
+
+  if ((osStatus_t) message->payload.value != osOK && logTransferContext.isMailboxBusy) {
+    ST25DV_ResetMBEN_Dyn(&this->st25dv); // @warning: status check is omitted, the phone's next command fails and is resent anyway
+    ST25DV_SetMBEN_Dyn(&this->st25dv);
   }
+
+  return writeReadyResponse(this); // refused while the end of the stream isn't read, written on its RF read then
 }
 
-static osStatus_t handleMailboxValidate(NFC_Actor_t *this, message_t *message) {
-  if (NFC_CRC_ERROR == message->event) {
-    osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {GLOBAL_CMD_NFC_MAILBOX_WRITE}, 0, 0);
-    // TODO: handle CRC error, write e.g. NACK to mailbox
-    // TODO: maybe put this message as a static?
-    this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_CRC8_ADDR] = 0xF4; // CRC-8/NRSC-5 Standard from [0xFE, 0x00]
-    this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_CMD_ADDR] = NFC_RESPONSE_NACK_CRC_ERROR;
-    this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR] = 0x00;
+/**
+ * @brief Passes the query to MEMORY and accepts the next command, the response is written once MEMORY has evaluated it
+ */
+static osStatus_t requestLogQuery(NFC_Actor_t *this, message_t *message) {
+  NFC_LogQuery_t *logQuery = &logQueryContext;
+  NFC_Command_t *command = commandTable.validated;
+  osMessageQueueId_t memoryQueue = ACTORS_LOOKUP_SystemRegistry[MEMORY_ACTOR_ID]->osMessageQueueId;
 
-    TO_STATE(this, NFC_MAILBOX_WRITE_RESPONSE_STATE);
+  assert_param(command != NULL && command->command == GLOBAL_CMD_QUERY_LOG);
+
+  // one query at a time, the query before the NFC restart may still be in MEMORY queue as well
+  if (logQuery->isPending) {
+    finishCommand(command, NFC_RESPONSE_NACK_BUSY, 0);
+    return acceptCommand(this, command);
+  }
+
+  if (message->payload_size != (ssize_t) sizeof(LOG_QUERY_Request_t)
+      || !LOG_QUERY_Init(&logQuery->query, (const LOG_QUERY_Request_t *) message->payload.ptr)) {
+    finishCommand(command, NFC_RESPONSE_NACK_ERROR, 0);
+    return acceptCommand(this, command);
   }
 
-  // All Commands transmit NFC FSM to the write data to mailbox state e.g. GLOBAL_SETTINGS_READ_SUCCESS
-  if (message->event >= GLOBAL_CMD_START_LOGGING && message->event < GLOBAL_EVENTS_MAX) { // TODO verify should it be GLOBAL_EVENTS_MAX or GLOBAL_CMD_MAX
-    /**
-     * @note No events are published here
-     * NFC module will wait for GLOBAL_CMD_NFC_MAILBOX_WRITE from Event Manager
-     * as a result of the command processing
-     */
-    // TODO remove it, it's a temporary solution to send only ACK
-    osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {GLOBAL_CMD_NFC_MAILBOX_WRITE}, 0, 0);
+  logQuery->isPending = true;
+
+  osStatus_t status = osMessageQueuePut(memoryQueue, &(message_t) {GLOBAL_CMD_QUERY_LOG, .payload.ptr = &logQuery->query}, 0, 0);
+  if (status != osOK)
+    return status;
+
+  return acceptCommand(this, command);
+}
+
+/**
+ * @brief Refreshes the NDEF summary in the user EEPROM on a material change, only the changed blocks are written
+ * @note The writes are deferred to the end of the phone session, they would hold the tag against its RF commands.
+ * The session is checked again, the field falling pulse may have been missed, e.g. in a transient state.
+ */
+static osStatus_t refreshSummary(NFC_Actor_t *this, message_t *message) {
+  accumulateSummary((const ACQUISITION_Frame_t *) message->payload.ptr);
+  NDEF_SUMMARY_Render(&summaryContext);
 
-    TO_STATE(this, NFC_MAILBOX_WRITE_RESPONSE_STATE);
+  if (this->isFieldOn && (NFC_ReadTagStatus(&this->st25dv, &this->tagStatus) != NFCTAG_OK || updateFieldState(this))) {
+    TRACE_LOG("NFC: summary write deferred, phone session\n");
+    return osOK;
   }
 
+  writeSummary(this);
+
+  return osOK;
+}
+
+/**
+ * @brief The phone has left, the summary of the frames accumulated during the session is written
+ * @note The response read may have returned to standby before the field falling is handled
+ */
+static osStatus_t closeSession(NFC_Actor_t *this, message_t *message) {
+  UNUSED(message);
+  NDEF_SUMMARY_Render(&summaryContext);
+  writeSummary(this);
+
   return osOK;
 }
 
-static osStatus_t handleMailboxWriteResponse(NFC_Actor_t *this, message_t *message) {
-  osStatus_t ioStatus = osOK;
-  uint8_t *payloadData = NULL;
+/**
+ * @brief Writes the changed summary blocks
+ * @note The RF session holds the tag and NACKs the I2C writes, the rest of the blocks is written on the next frames
+ */
+static void writeSummary(NFC_Actor_t *this) {
+  uint16_t offset;
+  uint16_t length;
+  uint16_t writtenSize = 0;
 
-  switch (message->event) {
-    case GLOBAL_CMD_NFC_MAILBOX_WRITE:
-      // TODO enhance protocol with ACK and ERROR CODES, Error codes could follow HTTP status codes
+  while (NDEF_SUMMARY_NextChangedBlocks(&summaryContext, &offset, &length)) {
+    if (St25Dv_Drv.WriteData(&this->st25dv, &summaryContext.image[offset], NDEF_SUMMARY_EEPROM_ADDR + offset, length) != NFCTAG_OK) {
+      TRACE_LOG("NFC: summary write deferred, RF is busy\n");
+      break;
+    }
 
-      // TODO copy data from event to mailbox buf
-      // TODO check utilization of double buffer technique
-      payloadData = (uint8_t *) message->payload.ptr;
-      memcpy(this->mailboxBuffer, payloadData, message->payload_size);
+    NDEF_SUMMARY_MarkWritten(&summaryContext, offset, length);
+    writtenSize += length;
+  }
 
-      // TODO move to a separate "protocol" module
-      // ST25DV_WriteMailboxData(&this->st25dv, this->mailboxBuffer, ST25DV_MAX_MAILBOX_LENGTH);
+  if (writtenSize > 0) {
+    TRACE_LOG("NFC: summary refreshed, %u bytes written\n", writtenSize);
+  }
+}
 
-      // TODO it's a temporary debug solution to send only ACK
-      this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_CRC8_ADDR] = 0x81; // CRC-8/NRSC-5 Standard from [0x00, 0x00]
-      this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_CMD_ADDR] = NFC_RESPONSE_ACK_OK;
-      this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR] = 0x00;
+/**
+ * @brief Read of the aborted session has completed in another state, its context is free. The results of the
+ * in-flight commands and the frames arriving out of standby are kept, the response or the summary is written later
+ */
+static osStatus_t handleUnhandledEvent(NFC_Actor_t *this, message_t *message) {
+  UNUSED(this);
+  if (message->event == GLOBAL_MEASUREMENTS_FRAME_READY) {
+    accumulateSummary((const ACQUISITION_Frame_t *) message->payload.ptr);
+  }
 
-      ioStatus = ST25DV_WriteMailboxData(&this->st25dv, this->mailboxBuffer, NFC_MAILBOX_PROTOCOL_HEADER_SIZE);
+  if (message->event == GLOBAL_LOG_CHUNK_READ_SUCCESS) {
+    logTransferContext.isReadPending = false;
+    releaseLogTransferBuffers();
+  }
 
-      TO_STATE(this, NFC_STANDBY_STATE);
-      return ioStatus;
+  if (message->event == GLOBAL_SETTINGS_WRITE_SUCCESS || message->event == GLOBAL_SETTINGS_READ_SUCCESS
+      || message->event == GLOBAL_LOG_QUERY_SUCCESS) {
+    finishCommandByResult(message);
   }
-}
\ No newline at end of file
+
+  return osOK;
+}
+
+/**
+ * @brief Clamps the requested range to the written log and splits it into the blocks
+ * @return false if the range is empty
+ */
+static bool clampLogRange(uint32_t blockSize) {
+  NFC_LogTransfer_t *logTransfer = &logTransferContext;
+  const uint32_t writtenEntries = (logTransfer->read.logTailAddress - INITIAL_LOG_START_ADDR) / MEMORY_LOG_ENTRY_SIZE;
+  const NFC_LogExportRange_t *range = &logTransfer->range;
+
+  if (range->firstEntry >= writtenEntries)
+    return false;
+
+  const uint32_t availableEntries = writtenEntries - range->firstEntry;
+  const uint32_t entriesCount = (range->entriesCount == 0 || range->entriesCount > availableEntries) ? availableEntries : range->entriesCount;
+
+  logTransfer->startAddress = INITIAL_LOG_START_ADDR + range->firstEntry * MEMORY_LOG_ENTRY_SIZE;
+  logTransfer->size = entriesCount * MEMORY_LOG_ENTRY_SIZE;
+  logTransfer->blockSize = blockSize;
+  logTransfer->blocksCount = (logTransfer->size + blockSize - 1) / blockSize;
+
+  return true;
+}
+
+/**
+ * @brief Starts the FTM transfer of the clamped range
+ */
+static osStatus_t startLogExport(NFC_Actor_t *this) {
+  NFC_LogTransfer_t *logTransfer = &logTransferContext;
+
+  if (!clampLogRange(NFC_LOG_EXPORT_SEGMENT_SIZE)) {
+    return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {.event = NFC_LOG_TRANSFER_REJECTED}, 0, 0);
+  }
+
+  // the USB export owns the buffers
+  logTransfer->buffers = LOG_TRANSFER_POOL_Claim(NFC_ACTOR_ID);
+  if (logTransfer->buffers == NULL) {
+    return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {.event = NFC_LOG_TRANSFER_REJECTED}, 0, 0);
+  }
+
+  logTransfer->fieldSeenTick = osKernelGetTickCount();
+  logTransfer->phase = NFC_LOG_TRANSFER_SENDING;
+
+  // the segment data is the segment length without its CRC, so the FTM segments match the prefetched buffers
+  ST25FTM_SetTxSegmentMaxLength(NFC_LOG_EXPORT_SEGMENT_SIZE + sizeof(ST25FTM_Crc_t));
+  ST25FTM_SendCommand(NFC_LOG_EXPORT_STREAM_BASE + logTransfer->startAddress, logTransfer->size, ST25FTM_SEND_WITH_ACK, supplyLogExportData);
+
+  // the phone may have left right after the command
+  osStatus_t status = this->isFieldOn
+    ? ACTOR_TIMER_StartPeriodic(&this->logTransferTimer, NFC_ACTOR_ID, NFC_LOG_EXPORT_POLL, NFC_LOG_EXPORT_POLL_PERIOD_MS)
+    : ACTOR_TIMER_StartOneShot(&this->logTransferTimer, NFC_ACTOR_ID, NFC_LOG_EXPORT_FIELD_LOST, NFC_LOG_EXPORT_FIELD_LOST_TIMEOUT_MS);
+  if (status != osOK)
+    return status;
+
+  return prefetchLogBlock(this);
+}
+
+/**
+ * @brief Starts the chunks stream of the clamped range, the first frame is written as soon as its entries are loaded
+ */
+static osStatus_t startLogChunks(NFC_Actor_t *this) {
+  NFC_LogTransfer_t *logTransfer = &logTransferContext;
+
+  if (!clampLogRange(NFC_LOG_CHUNKS_BLOCK_SIZE)) {
+    return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {.event = NFC_LOG_TRANSFER_REJECTED}, 0, 0);
+  }
+
+  // the USB export owns the buffers
+  logTransfer->buffers = LOG_TRANSFER_POOL_Claim(NFC_ACTOR_ID);
+  if (logTransfer->buffers == NULL) {
+    return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {.event = NFC_LOG_TRANSFER_REJECTED}, 0, 0);
+  }
+
+  LOG_CODEC_Init(&logTransfer->codec);
+  logTransfer->encodedSize = 0;
+  logTransfer->frameEntries = 0;
+  logTransfer->frameCycles = 0;
+  logTransfer->framePayloadSize = 0;
+  logTransfer->isFrameReady = false;
+  logTransfer->isEndWritten = false;
+  logTransfer->phase = NFC_LOG_TRANSFER_SENDING;
+
+  return prefetchLogBlock(this);
+}
+
+/**
+ * @brief Writes the encoded frame once the phone has read the previous one, the next frame is encoded while the phone
+ * reads this one. The blocks consumed by the encoder are prefetched again.
+ */
+static osStatus_t pumpLogChunks(NFC_Actor_t *this) {
+  NFC_LogTransfer_t *logTransfer = &logTransferContext;
+
+  prepareLogFrame(this);
+
+  if (!logTransfer->isMailboxBusy) {
+    // the phone has read the end of stream frame
+    if (logTransfer->isEndWritten)
+      return postLogTransferDone(this, osOK);
+
+    if (logTransfer->isFrameReady) {
+      osStatus_t status = writeLogFrame(this);
+      if (status != osOK)
+        return status;
+
+      prepareLogFrame(this);
+    }
+  }
+
+  // the retry has replaced the read timeout
+  if (logTransfer->isMailboxBusy && !ACTOR_TIMER_IsArmed(&this->logTransferTimer)) {
+    osStatus_t status = ACTOR_TIMER_StartOneShot(&this->logTransferTimer, NFC_ACTOR_ID, NFC_LOG_CHUNKS_TIMEOUT, NFC_LOG_CHUNKS_READ_TIMEOUT_MS);
+    if (status != osOK)
+      return status;
+  }
+
+  return prefetchLogBlock(this);
+}
+
+/**
+ * @brief Encodes the loaded entries into the mailbox buffer until the frame payload is full or the range is over,
+ * waits for MEMORY when the next block isn't loaded yet
+ * @note The frame is encoded in the mailbox buffer: the written frame is already in the tag, the ready one is kept
+ * until its write succeeds
+ */
+static void prepareLogFrame(NFC_Actor_t *this) {
+  NFC_LogTransfer_t *logTransfer = &logTransferContext;
+  uint8_t *payload = &this->mailboxBuffer[NFC_MAILBOX_PROTOCOL_PAYLOAD_ADDR];
+
+  if (logTransfer->isFrameReady)
+    return;
+
+  const uint32_t startCycles = DWT->CYCCNT;
+
+  while (logTransfer->encodedSize < logTransfer->size) {
+    const uint32_t block = logTransfer->encodedSize / logTransfer->blockSize;
+    if (block >= logTransfer->loadedBlocks)
+      break;
+
+    const uint32_t blockEnd = (block + 1 < logTransfer->blocksCount) ? (block + 1) * logTransfer->blockSize : logTransfer->size;
+    const uint32_t entriesCount = (blockEnd - logTransfer->encodedSize) / MEMORY_LOG_ENTRY_SIZE;
+    const uint8_t *entries = &logTransfer->buffers[block % NFC_LOG_TRANSFER_BUFFERS_COUNT][logTransfer->encodedSize % logTransfer->blockSize];
+    uint32_t length;
+
+    const uint32_t encodedCount = LOG_CODEC_Encode(&logTransfer->codec, entries, entriesCount, &payload[logTransfer->framePayloadSize],
+                                                   NFC_LOG_CHUNKS_PAYLOAD_SIZE - logTransfer->framePayloadSize, &length);
+
+    logTransfer->framePayloadSize += (uint8_t) length;
+    logTransfer->frameEntries += encodedCount;
+    logTransfer->encodedSize += encodedCount * MEMORY_LOG_ENTRY_SIZE;
+
+    // the block is in the frames, its buffer is free for the prefetch
+    if (logTransfer->encodedSize == blockEnd) {
+      logTransfer->releasedBlocks = block + 1;
+    }
+
+    if (encodedCount < entriesCount) {
+      logTransfer->isFrameReady = true;
+      break;
+    }
+  }
+
+  // the last frame is partial, the one after it is empty
+  if (logTransfer->encodedSize == logTransfer->size) {
+    logTransfer->isFrameReady = true;
+  }
+
+  logTransfer->frameCycles += DWT->CYCCNT - startCycles;
+
+  if (logTransfer->isFrameReady && logTransfer->frameEntries > 0) {
+    TRACE_LOG("NFC: %" PRIu32 " entries encoded to %u bytes, %" PRIu32 " cycles\n", logTransfer->frameEntries, logTransfer->framePayloadSize, logTransfer->frameCycles);
+  }
+}
+
+/**
+ * @brief Frames the encoded chunk and writes it to the mailbox, the frame without payload ends the stream
+ * @note The tag refuses the write while the RF is talking to it, the write is retried
+ */
+static osStatus_t writeLogFrame(NFC_Actor_t *this) {
+  NFC_LogTransfer_t *logTransfer = &logTransferContext;
+  uint8_t *frame = this->mailboxBuffer;
+
+  frame[NFC_MAILBOX_PROTOCOL_CMD_ADDR] = NFC_RESPONSE_ACK_OK;
+  frame[NFC_MAILBOX_PROTOCOL_SEQ_ADDR] = this->commandSequence;
+  frame[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR] = logTransfer->framePayloadSize;
+  frame[NFC_MAILBOX_PROTOCOL_CRC8_ADDR] = calculateFrameCRC8(frame);
+
+  if (ST25DV_WriteMailboxData(&this->st25dv, frame, NFC_MAILBOX_PROTOCOL_HEADER_SIZE + logTransfer->framePayloadSize) != NFCTAG_OK)
+    return ACTOR_TIMER_StartOneShot(&this->logTransferTimer, NFC_ACTOR_ID, NFC_LOG_CHUNKS_RETRY, NFC_LOG_CHUNKS_RETRY_PERIOD_MS);
+
+  logTransfer->isEndWritten = (logTransfer->framePayloadSize == 0);
+  logTransfer->framePayloadSize = 0;
+  logTransfer->frameEntries = 0;
+  logTransfer->frameCycles = 0;
+  logTransfer->isFrameReady = false;
+  logTransfer->isMailboxBusy = true;
+
+  return ACTOR_TIMER_StartOneShot(&this->logTransferTimer, NFC_ACTOR_ID, NFC_LOG_CHUNKS_TIMEOUT, NFC_LOG_CHUNKS_READ_TIMEOUT_MS);
+}
+
+/**
+ * @brief Requests the next block while its buffer is free: the block two ahead reuses the buffer of the released one
+ */
+static osStatus_t prefetchLogBlock(NFC_Actor_t *this) {
+  NFC_LogTransfer_t *logTransfer = &logTransferContext;
+  const uint32_t block = logTransfer->loadedBlocks;
+
+  if (logTransfer->isReadPending || block >= logTransfer->blocksCount || block >= logTransfer->releasedBlocks + NFC_LOG_TRANSFER_BUFFERS_COUNT)
+    return osOK;
+
+  const uint32_t offset = block * logTransfer->blockSize;
+  const uint32_t remainingSize = logTransfer->size - offset;
+  const uint32_t size = (remainingSize < logTransfer->blockSize) ? remainingSize : logTransfer->blockSize;
+  uint8_t *buffer = logTransfer->buffers[block % NFC_LOG_TRANSFER_BUFFERS_COUNT];
+
+  return requestLogRead(this, logTransfer->startAddress + offset, buffer, size);
+}
+
+static osStatus_t requestLogRead(NFC_Actor_t *this, uint32_t address, uint8_t *buffer, uint32_t size) {
+  UNUSED(this);
+  NFC_LogTransfer_t *logTransfer = &logTransferContext;
+  osMessageQueueId_t memoryQueue = ACTORS_LOOKUP_SystemRegistry[MEMORY_ACTOR_ID]->osMessageQueueId;
+
+  logTransfer->read.requesterId = NFC_ACTOR_ID;
+  logTransfer->read.address = address;
+  logTransfer->read.buffer = buffer;
+  logTransfer->read.size = size;
+  logTransfer->isReadPending = true;
+
+  return osMessageQueuePut(memoryQueue, &(message_t) {GLOBAL_CMD_READ_LOG_CHUNK, .payload.ptr = &logTransfer->read}, 0, 0);
+}
+
+static osStatus_t postLogTransferDone(NFC_Actor_t *this, osStatus_t status) {
+  logTransferContext.phase = NFC_LOG_TRANSFER_FINISHING;
+
+  return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {NFC_LOG_TRANSFER_DONE, .payload.value = (uint32_t) status}, 0, 0);
+}
+
+/**
+ * @brief Returns the buffers to the pool once the transfer is over and MEMORY doesn't read into them anymore
+ */
+static void releaseLogTransferBuffers(void) {
+  if (logTransferContext.phase != NFC_LOG_TRANSFER_FINISHING || logTransferContext.isReadPending)
+    return;
+
+  LOG_TRANSFER_POOL_Release(NFC_ACTOR_ID);
+}
+
+/**
+ * @brief FTM data callback, serves the stream pointer from the prefetched segment
+ * @note Packets never cross the segments, a retransmitted segment is still in its buffer
+ */
+static void supplyLogExportData(uint8_t *buffer, uint8_t *source, uint32_t length) {
+  NFC_LogTransfer_t *logTransfer = &logTransferContext;
+  const uint32_t offset = (uint32_t) (source - (NFC_LOG_EXPORT_STREAM_BASE + logTransfer->startAddress));
+  const uint32_t segment = offset / NFC_LOG_EXPORT_SEGMENT_SIZE;
+  const uint32_t segmentOffset = offset % NFC_LOG_EXPORT_SEGMENT_SIZE;
+
+  assert_param(segment < logTransfer->loadedBlocks && segmentOffset + length <= NFC_LOG_EXPORT_SEGMENT_SIZE);
+
+  logTransfer->releasedBlocks = segment; // the previous segments are acknowledged
+  memcpy(buffer, &logTransfer->buffers[segment % NFC_LOG_TRANSFER_BUFFERS_COUNT][segmentOffset], length);
+}
+
+/**
+ * @brief Takes the phone session from the last read tag status
+ * @return true if the RF field is on
+ */
+static bool updateFieldState(NFC_Actor_t *this) {
+  this->isFieldOn = (this->tagStatus.energyHarvesting & ST25DV_EH_CTRL_DYN_FIELD_ON_MASK) != 0;
+
+  return this->isFieldOn;
+}
+
+/**
+ * @brief Copies the frame values to the summary at once, the frame is reused by ACQUISITION on the next wake up
+ */
+static void accumulateSummary(const ACQUISITION_Frame_t *frame) {
+  NDEF_SUMMARY_Update(&summaryContext, &(NDEF_SUMMARY_Sample_t) {
+    .timestamp = frame->timestamp,
+    .temperature = CONVERT_SHT3xRawToCentiCelsius((uint16_t) frame->rawTemperature),
+    .humidity = CONVERT_SHT3xRawToCentiRH(frame->rawHumidity),
+    .lux = CONVERT_OPT3001RawToCentiLux(frame->rawLux),
+    .isClimateValid = (frame->validMask & ACQUISITION_TEMPERATURE_HUMIDITY_VALID) != 0,
+    .isLuxValid = (frame->validMask & ACQUISITION_LUX_VALID) != 0,
+    .isComplete = frame->validMask == ACQUISITION_ALL_VALID,
+  });
+}
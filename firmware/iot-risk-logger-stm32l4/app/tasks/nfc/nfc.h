@@ -15,19 +15,30 @@ extern "C" {
 #include "st25dv.h"
 #include "custom_bus.h"
 #include "nfc_handlers.h"
+#include "fsm.h"
+#include "actor_timer.h"
+#include "crc_service.h"
+#include "log_transfer_pool.h"
+#include "st25ftm_protocol.h"
+#include "st25ftm_config.h"
+
+#define NFC_TASK_STACK_SIZE_WORDS (384) ///< ST25FTM keeps the 256 bytes acknowledge message on the stack
 
 /**
  * NFC exchange protocol description
- * | CRC8 | CMD | Payload Size | Payload |
+ * | CRC8 | CMD | SEQ | Payload Size | Payload |
+ * The response echoes the SEQ of its command, the pipelined commands are answered in the completion order
  */
 #define NFC_MAILBOX_PROTOCOL_CRC8_ADDR              0
 #define NFC_MAILBOX_PROTOCOL_CRC8_SIZE              1
 #define NFC_MAILBOX_PROTOCOL_CMD_ADDR               (NFC_MAILBOX_PROTOCOL_CRC8_ADDR + NFC_MAILBOX_PROTOCOL_CRC8_SIZE)
 #define NFC_MAILBOX_PROTOCOL_CMD_SIZE               1
-#define NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR      (NFC_MAILBOX_PROTOCOL_CMD_ADDR + NFC_MAILBOX_PROTOCOL_CMD_SIZE)
+#define NFC_MAILBOX_PROTOCOL_SEQ_ADDR               (NFC_MAILBOX_PROTOCOL_CMD_ADDR + NFC_MAILBOX_PROTOCOL_CMD_SIZE)
+#define NFC_MAILBOX_PROTOCOL_SEQ_SIZE               1
+#define NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR      (NFC_MAILBOX_PROTOCOL_SEQ_ADDR + NFC_MAILBOX_PROTOCOL_SEQ_SIZE)
 #define NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_SIZE      1
 #define NFC_MAILBOX_PROTOCOL_PAYLOAD_ADDR           (NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR + NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_SIZE)
-#define NFC_MAILBOX_PROTOCOL_HEADER_SIZE            (NFC_MAILBOX_PROTOCOL_CRC8_SIZE + NFC_MAILBOX_PROTOCOL_CMD_SIZE + NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_SIZE)
+#define NFC_MAILBOX_PROTOCOL_HEADER_SIZE            (NFC_MAILBOX_PROTOCOL_CRC8_SIZE + NFC_MAILBOX_PROTOCOL_CMD_SIZE + NFC_MAILBOX_PROTOCOL_SEQ_SIZE + NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_SIZE)
 
 /**
  * Exchange protocol response codes
@@ -35,6 +46,52 @@ extern "C" {
 #define NFC_RESPONSE_ACK_OK           0x00
 #define NFC_RESPONSE_NACK_ERROR       0xFF
 #define NFC_RESPONSE_NACK_CRC_ERROR   0xFE
+#define NFC_RESPONSE_NACK_BUSY        0xFD ///< In-flight commands table is full, the command should be resent later
+
+/**
+ * Pipelined commands: the next command is accepted while the previous ones are executed, e.g. MEMORY writes
+ * the settings or evaluates a log query. The log transfers own the mailbox and aren't pipelined.
+ */
+#define NFC_COMMANDS_IN_FLIGHT        (4U)
+#define NFC_MAILBOX_RETRY_PERIOD_MS   (5U) ///< Interrupt status and command read retry while the RF holds the tag
+
+/**
+ * Phone session: the RF field is on. Out of the session the GPO pulses of the phone approaching and writing its first
+ * command are merged into one tag status read, the field falling ends the session.
+ */
+#define NFC_FIELD_DEBOUNCE_MS         (20U)
+
+/**
+ * Log export over the ST25 Fast Transfer Mode (FTM)
+ */
+#define NFC_LOG_EXPORT_SEGMENT_SIZE           (1024U)   ///< FTM segment data, acknowledged by the phone as a whole
+#define NFC_LOG_TRANSFER_BUFFERS_COUNT        LOG_TRANSFER_POOL_BUFFERS_COUNT ///< Block being sent and the prefetched next one, shared with the chunks stream
+#define NFC_LOG_EXPORT_POLL_PERIOD_MS         (5U)
+#define NFC_LOG_EXPORT_FIELD_LOST_TIMEOUT_MS  (10000U)  ///< Export is aborted when the phone is away this long, not polled meanwhile
+#define NFC_LOG_EXPORT_STREAM_BASE            ((uint8_t *) QSPI_BASE) ///< FTM data pointers are the NOR Flash addresses in the QUADSPI window, never dereferenced
+
+/**
+ * Log chunks stream over the mailbox frames compressed with the log codec, RF read of a frame triggers the write
+ * of the encoded next one
+ */
+#define NFC_LOG_CHUNKS_RETRY_PERIOD_MS        (5U)      ///< Write retry while the RF holds the tag
+#define NFC_LOG_CHUNKS_READ_TIMEOUT_MS        (10000U)  ///< Stream is aborted when the phone doesn't read the chunk this long
+
+/**
+ * @brief GLOBAL_CMD_EXPORT_LOG and GLOBAL_CMD_READ_LOG_CHUNK payload, little-endian
+ */
+typedef struct __attribute__((packed)) {
+  uint32_t firstEntry;
+  uint32_t entriesCount; ///< 0 exports up to the log tail
+} NFC_LogExportRange_t;
+
+/**
+ * @brief GLOBAL_CMD_SET_WAKE_UP_PERIOD_BOUNDS payload, little-endian
+ */
+typedef struct __attribute__((packed)) {
+  uint16_t minPeriodSeconds;
+  uint16_t maxPeriodSeconds;
+} NFC_WakeUpPeriodBounds_t;
 
 typedef enum {
   NFC_NO_STATE = 0,
@@ -42,6 +99,8 @@ typedef enum {
   NFC_MAILBOX_RECEIVE_CMD_STATE,
   NFC_VALIDATE_MAILBOX_STATE,
   NFC_MAILBOX_WRITE_RESPONSE_STATE,
+  NFC_LOG_EXPORT_STATE,
+  NFC_LOG_CHUNKS_STATE,
   NFC_STATE_ERROR,
   NFC_MAX_STATE
 } NFC_State_t;
@@ -51,6 +110,10 @@ typedef struct {
   NFC_State_t state;
   ST25DV_Object_t st25dv;
   uint8_t mailboxBuffer[ST25DV_MAX_MAILBOX_LENGTH];
+  uint8_t commandSequence; ///< SEQ of the last received command, echoed by its immediate response and the log chunks
+  NFC_TagStatus_t tagStatus; ///< Last read, the length of the RF message to receive
+  bool isFieldOn; ///< Phone session, as of the last tag status read
+  ACTOR_Timer_t logTransferTimer; ///< Log transfer polls and timeouts, the mailbox retries while the RF holds the tag, the field debounce
 } NFC_Actor_t;
 
 extern NFC_Actor_t NFC_Actor;
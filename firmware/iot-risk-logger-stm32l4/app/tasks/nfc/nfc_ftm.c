@@ -0,0 +1,138 @@
+/*!
+ * @file nfc_ftm.c
+ * @brief ST25 Fast Transfer Mode (FTM) platform port on the ST25DV mailbox
+ *
+ * Implements the platform functions declared in ST25FTM/App/st25ftm_config.h. The middleware is run only by
+ * the NFC actor thread (ST25FTM_Runner() of the log export), so the ST25DV object is used without locking.
+ *
+ * The segment CRC is CRC-32/MPEG-2, the STM32 CRC unit reset configuration, over the segment data taken
+ * as 32-bit little-endian words (the unit's word input format): the bytes are fed most significant first within
+ * the word, the last partial word is padded with zeros.
+ *
+ * @see https://www.st.com/resource/en/application_note/an5512-st25-fast-transfer-mode-embedded-library-stmicroelectronics.pdf
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#include "nfc.h"
+#include "st25ftm_common.h"
+#include "crc_service.h"
+
+#define NFC_FTM_CRC_WORD_SIZE (4U)
+
+static void feedCrcWords(const uint8_t *data, uint32_t length);
+
+static uint32_t crc = CRC_SERVICE_CRC32_INIT;
+static uint8_t pendingBytes[NFC_FTM_CRC_WORD_SIZE]; ///< Bytes of the word split between the packets
+static uint8_t pendingBytesCount = 0;
+static uint8_t crcStream[ST25FTM_BUFFER_LENGTH + NFC_FTM_CRC_WORD_SIZE]; ///< Packet data in the unit's word bytes order
+
+ST25FTM_MessageOwner_t ST25FTM_GetMessageOwner(void) {
+  ST25DV_MB_CTRL_DYN_STATUS mailboxStatus;
+
+  if (ST25DV_ReadMBCtrl_Dyn(&NFC_Actor.st25dv, &mailboxStatus) != NFCTAG_OK)
+    return ST25FTM_MESSAGE_OWNER_ERROR;
+
+  if (mailboxStatus.HostPutMsg)
+    return ST25FTM_MESSAGE_ME;
+
+  if (mailboxStatus.RfPutMsg)
+    return ST25FTM_MESSAGE_PEER;
+
+  return ST25FTM_MESSAGE_EMPTY;
+}
+
+ST25FTM_MessageStatus_t ST25FTM_ReadMessage(uint8_t *msg, uint32_t *msg_len) {
+  uint8_t mailboxLength; // message length - 1
+
+  if (ST25DV_ReadMBLength_Dyn(&NFC_Actor.st25dv, &mailboxLength) != NFCTAG_OK)
+    return ST25FTM_MSG_ERROR;
+
+  *msg_len = (uint32_t) mailboxLength + 1;
+
+  if (ST25DV_ReadMailboxData(&NFC_Actor.st25dv, msg, MAILBOX_START_OFFSET, (uint16_t) *msg_len) != NFCTAG_OK)
+    return ST25FTM_MSG_ERROR;
+
+  return ST25FTM_MSG_OK;
+}
+
+ST25FTM_MessageStatus_t ST25FTM_WriteMessage(uint8_t *msg, uint32_t msg_len) {
+  const ST25FTM_MessageOwner_t owner = ST25FTM_GetMessageOwner();
+
+  if (owner == ST25FTM_MESSAGE_OWNER_ERROR)
+    return ST25FTM_MSG_ERROR;
+
+  if (owner != ST25FTM_MESSAGE_EMPTY)
+    return ST25FTM_MSG_BUSY;
+
+  if (ST25DV_WriteMailboxData(&NFC_Actor.st25dv, msg, (uint16_t) msg_len) != NFCTAG_OK)
+    return ST25FTM_MSG_ERROR;
+
+  return ST25FTM_MSG_OK;
+}
+
+/**
+ * @brief Enables the mailbox, the mailbox mode itself has to be enabled in the tag's static configuration
+ */
+void ST25FTM_DeviceInit(void) {
+  ST25DV_SetMBEN_Dyn(&NFC_Actor.st25dv); // @warning: status check is omitted, the next mailbox access fails anyway
+}
+
+/**
+ * @note The I2C is NACKed while the RF is talking to the tag, a failed read keeps the field on
+ */
+void ST25FTM_UpdateFieldStatus(void) {
+  ST25DV_FIELD_STATUS fieldStatus;
+
+  if (ST25DV_GetRFField_Dyn(&NFC_Actor.st25dv, &fieldStatus) != NFCTAG_OK) {
+    gFtmState.rfField = ST25FTM_FIELD_ON;
+    return;
+  }
+
+  gFtmState.rfField = (fieldStatus == ST25DV_FIELD_ON) ? ST25FTM_FIELD_ON : ST25FTM_FIELD_OFF;
+}
+
+void ST25FTM_CRC_Initialize(void) {
+  crc = CRC_SERVICE_CRC32_INIT;
+  pendingBytesCount = 0;
+}
+
+ST25FTM_Crc_t ST25FTM_GetCrc(uint8_t *data, uint32_t length, ST25FTM_crc_control_t control) {
+  if (control == ST25FTM_CRC_START || control == ST25FTM_CRC_ONESHOT) {
+    ST25FTM_CRC_Initialize();
+  }
+
+  feedCrcWords(data, length);
+
+  if ((control == ST25FTM_CRC_END || control == ST25FTM_CRC_ONESHOT) && pendingBytesCount > 0) {
+    const uint8_t padding[NFC_FTM_CRC_WORD_SIZE] = {0};
+
+    feedCrcWords(padding, NFC_FTM_CRC_WORD_SIZE - pendingBytesCount);
+  }
+
+  return crc;
+}
+
+/**
+ * @brief Feeds the complete words to the CRC service in one call, keeps the bytes of the incomplete one
+ */
+static void feedCrcWords(const uint8_t *data, uint32_t length) {
+  uint32_t streamLength = 0;
+
+  assert_param(length <= ST25FTM_BUFFER_LENGTH);
+
+  while (length--) {
+    pendingBytes[pendingBytesCount++] = *data++;
+
+    if (pendingBytesCount == NFC_FTM_CRC_WORD_SIZE) {
+      crcStream[streamLength++] = pendingBytes[3];
+      crcStream[streamLength++] = pendingBytes[2];
+      crcStream[streamLength++] = pendingBytes[1];
+      crcStream[streamLength++] = pendingBytes[0];
+      pendingBytesCount = 0;
+    }
+  }
+
+  crc = CRC_SERVICE_Crc32Mpeg2Update(crc, crcStream, streamLength);
+}
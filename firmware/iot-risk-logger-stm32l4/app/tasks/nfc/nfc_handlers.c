@@ -1,20 +1,23 @@
 #include <assert.h>
+#include <string.h>
 #include "nfc_handlers.h"
 
+_Static_assert(sizeof(NFC_TagStatus_t) == ST25DV_MBLEN_DYN_REG - ST25DV_EH_CTRL_DYN_REG + 1, "tag status block mismatch");
+
 int32_t NFC_ST25DVInit(ST25DV_Object_t *pObj) {
   ST25DV_IO_t IO;
 
   IO.Init = BSP_I2C1_Init;
   IO.DeInit = BSP_I2C1_DeInit;
   IO.IsReady = BSP_I2C1_IsReady;
-  IO.Read = BSP_I2C1_ReadReg16;
-  IO.Write = (ST25DV_Write_Func) BSP_I2C1_WriteReg16;
+  IO.Read = SensorsBus_ReadReg16;
+  IO.Write = (ST25DV_Write_Func) SensorsBus_WriteReg16;
   IO.GetTick = HAL_GetTick;
 
   int32_t status = ST25DV_RegisterBusIO(pObj, &IO);
   if (status != NFCTAG_OK) {
     #ifdef DEBUG
-      fprintf(stderr,  "ST25DV RegisterBusIO Error: %ld\n", status);
+      fprintf(stderr,  "ST25DV RegisterBusIO Error: %" PRId32 "\n", status);
     #endif
 
     return NFCTAG_ERROR;
@@ -23,7 +26,7 @@ int32_t NFC_ST25DVInit(ST25DV_Object_t *pObj) {
   status = St25Dv_Drv.Init(pObj);
   if (status != NFCTAG_OK) {
     #ifdef DEBUG
-      fprintf(stderr,  "ST25DV Driver Init Error: %ld\n", status);
+      fprintf(stderr,  "ST25DV Driver Init Error: %" PRId32 "\n", status);
     #endif
 
     return NFCTAG_ERROR;
@@ -32,35 +35,81 @@ int32_t NFC_ST25DVInit(ST25DV_Object_t *pObj) {
   return NFCTAG_OK;
 }
 
-void NFC_HandleGPOInterrupt(ST25DV_Object_t *pObj) {
-  uint8_t ITStatus;
-  ST25DV_ReadITSTStatus_Dyn(pObj, &ITStatus);
-  if (ITStatus & ST25DV_ITSTS_DYN_RFPUTMSG_MASK) {
-    osMessageQueuePut(NFC_Actor.super.osMessageQueueId, &(message_t){NEW_MAILBOX_RF_CMD}, 0, 0);
+/**
+ * @brief Enables the GPO on the RF field change and on the RF put and the RF get of the mailbox message, the log
+ * chunks stream is driven by the latter, the field change tells the phone has left
+ * @note The configuration is in EEPROM, it's written only when it differs
+ */
+int32_t NFC_ConfigureMailboxGPO(ST25DV_Object_t *pObj) {
+  const uint16_t gpoConfig = ST25DV_GPO_ENABLE_MASK | ST25DV_GPO_FIELDCHANGE_MASK | ST25DV_GPO_RFPUTMSG_MASK | ST25DV_GPO_RFGETMSG_MASK;
+  uint16_t currentConfig;
+
+  int32_t status = St25Dv_Drv.GetITStatus(pObj, &currentConfig);
+  if (status != NFCTAG_OK)
+    return NFCTAG_ERROR;
+
+  if (currentConfig == gpoConfig)
+    return NFCTAG_OK;
 
+  status = St25Dv_Drv.ConfigIT(pObj, gpoConfig);
+  if (status != NFCTAG_OK) {
     #ifdef DEBUG
-      fprintf(stdout, "NFC ITStatus: 0x%x\n", ITStatus);
+      fprintf(stderr,  "ST25DV GPO configuration Error: %" PRId32 "\n", status);
     #endif
+
+    return NFCTAG_ERROR;
   }
+
+  return NFCTAG_OK;
 }
 
-int32_t NFC_ReadMailboxTo(ST25DV_Object_t *pObj, uint8_t pMailboxBuffer[ST25DV_MAX_MAILBOX_LENGTH]) {
-  uint8_t mailboxLength;
-  int32_t status = ST25DV_ReadMBLength_Dyn(pObj, &mailboxLength);
+/**
+ * @brief One I2C transaction instead of the interrupt status, the mailbox control and the length reads
+ * @return NFCTAG_NACK while the RF holds the tag
+ */
+int32_t NFC_ReadTagStatus(ST25DV_Object_t *pObj, NFC_TagStatus_t *pStatus) {
+  return St25Dv_Drv.ReadData(pObj, (uint8_t *) pStatus, ST25DV_EH_CTRL_DYN_REG, sizeof(NFC_TagStatus_t));
+}
+
+/**
+ * @brief The phone wrote a command or read the response, the new command takes precedence: the ready responses
+ * are written once it's received
+ * @note The unread RF message is taken from the mailbox control, not from the latched interrupts: the pulse may be
+ * retried, debounced or posted by the restart after the interrupts were read, the command is neither lost nor
+ * received twice
+ * @return NFCTAG_NACK while the RF holds the tag
+ */
+int32_t NFC_HandleGPOInterrupt(ST25DV_Object_t *pObj, NFC_TagStatus_t *pStatus) {
+  int32_t status = NFC_ReadTagStatus(pObj, pStatus);
+  if (status != NFCTAG_OK)
+    return status;
+
+  if (pStatus->mailboxControl & ST25DV_MB_CTRL_DYN_RFPUTMSG_MASK) {
+    osMessageQueuePut(NFC_Actor.super.osMessageQueueId, &(message_t){.event = NEW_MAILBOX_RF_CMD}, 0, 0);
 
-  if (status != NFCTAG_OK) {
     #ifdef DEBUG
-        fprintf(stdout, "ST25DV ST25DV_ReadMBLength_Dyn Error\n");
+      fprintf(stdout, "NFC ITStatus: 0x%x\n", pStatus->itStatus);
     #endif
-
-    return NFCTAG_ERROR;
+  } else {
+    osMessageQueuePut(NFC_Actor.super.osMessageQueueId, &(message_t){.event = NFC_MAILBOX_RESPONSE_READ}, 0, 0);
   }
 
+  return NFCTAG_OK;
+}
+
+/**
+ * @brief Reads the RF message of the status read with the RF put message set, its length can't change until it's read
+ * @note The bytes past the message are left from the previous frames, but a message shorter than the header isn't
+ * mixed with them: the header rest is zeroed, e.g. the SEQ echoed by the CRC error response
+ */
+int32_t NFC_ReadMailboxTo(ST25DV_Object_t *pObj, const NFC_TagStatus_t *pStatus, uint8_t pMailboxBuffer[ST25DV_MAX_MAILBOX_LENGTH]) {
+  const uint16_t messageLength = (uint16_t) pStatus->mailboxLength + 1;
+
   #ifdef DEBUG
-    fprintf(stdout, "Mailbox length: %d\n", mailboxLength);
+    fprintf(stdout, "Mailbox length: %d\n", messageLength);
   #endif
 
-  status = ST25DV_ReadMailboxData(pObj, pMailboxBuffer, MAILBOX_START_OFFSET, ST25DV_MAX_MAILBOX_LENGTH);
+  int32_t status = ST25DV_ReadMailboxData(pObj, pMailboxBuffer, MAILBOX_START_OFFSET, messageLength);
 
   if (status != NFCTAG_OK) {
     #ifdef DEBUG
@@ -70,5 +119,9 @@ int32_t NFC_ReadMailboxTo(ST25DV_Object_t *pObj, uint8_t pMailboxBuffer[ST25DV_M
     return NFCTAG_ERROR;
   }
 
+  if (messageLength < NFC_MAILBOX_PROTOCOL_HEADER_SIZE) {
+    memset(&pMailboxBuffer[messageLength], 0, NFC_MAILBOX_PROTOCOL_HEADER_SIZE - messageLength);
+  }
+
   return NFCTAG_OK;
-}
\ No newline at end of file
+}
@@ -6,11 +6,28 @@ extern "C" {
 #endif
 
 #include <stdio.h>
+#include <stdint.h>
+
+/**
+ * @brief Dynamic registers from EH_CTRL_Dyn to MB_LEN_Dyn, read in one I2C transaction: the RF field, the latched
+ * interrupts and the mailbox state
+ * @note Defined before the includes, the actor in nfc.h keeps the last read status
+ */
+typedef struct {
+  uint8_t energyHarvesting; ///< EH_CTRL_Dyn, FIELD_ON
+  uint8_t rfManagement;
+  uint8_t i2cSecuritySession;
+  uint8_t itStatus; ///< Cleared on read, reading releases the GPO
+  uint8_t mailboxControl;
+  uint8_t mailboxLength; ///< Message length - 1
+} NFC_TagStatus_t;
 
 #include "main.h"
 #include "st25dv.h"
 #include "custom_bus.h"
+#include "sensors_bus.h"
 #include "cmsis_os2.h"
+
 #include "nfc.h"
 
 #ifdef __cplusplus
@@ -20,7 +37,9 @@ extern "C" {
 #define MAILBOX_START_OFFSET 0x00
 
 int32_t NFC_ST25DVInit(ST25DV_Object_t *pObj);
-void NFC_HandleGPOInterrupt(ST25DV_Object_t *pObj);
-int32_t NFC_ReadMailboxTo(ST25DV_Object_t *pObj, uint8_t pMailboxBuffer[ST25DV_MAX_MAILBOX_LENGTH]);
+int32_t NFC_ConfigureMailboxGPO(ST25DV_Object_t *pObj);
+int32_t NFC_ReadTagStatus(ST25DV_Object_t *pObj, NFC_TagStatus_t *pStatus);
+int32_t NFC_HandleGPOInterrupt(ST25DV_Object_t *pObj, NFC_TagStatus_t *pStatus);
+int32_t NFC_ReadMailboxTo(ST25DV_Object_t *pObj, const NFC_TagStatus_t *pStatus, uint8_t pMailboxBuffer[ST25DV_MAX_MAILBOX_LENGTH]);
 
 #endif //NFC_HANDLERS_H
@@ -11,16 +11,34 @@
 #include "temperature_humidity_sensor.h"
 
 static osStatus_t handleTHSensorFSM(TH_SENS_Actor_t *this, message_t *message);
-/** states handlers */
-static osStatus_t handleInit(TH_SENS_Actor_t *this, message_t *message);
-static osStatus_t handleIdle(TH_SENS_Actor_t *this, message_t *message);
-static osStatus_t handleContinuousMeasure(TH_SENS_Actor_t *this, message_t *message);
-static osStatus_t handleError(TH_SENS_Actor_t *this, message_t *message);
+/** transitions actions */
+static osStatus_t startReset(TH_SENS_Actor_t *this, message_t *message);
+static osStatus_t releaseReset(TH_SENS_Actor_t *this, message_t *message);
+static osStatus_t requestDeviceID(TH_SENS_Actor_t *this, message_t *message);
+static osStatus_t fetchDeviceID(TH_SENS_Actor_t *this, message_t *message);
+static osStatus_t startPipelinedAcquisition(TH_SENS_Actor_t *this, message_t *message);
 /** utils */
 static uint32_t delayMs(uint32_t ms);
+static uint8_t crc8(uint8_t *data, uint8_t len);
 
 extern actor_t* ACTORS_LOOKUP_SystemRegistry[MAX_ACTORS];
 
+/**
+ * @brief Temperature & Humidity Sensor FSM transitions table
+ * @note rendered to the README state diagram by scripts/generate_state_machine_diagrams.py
+ */
+static const FSM_Transition_t thSensorTransitions[] = {
+  FSM_TRANSITION(TH_SENS_NO_STATE,                  GLOBAL_CMD_INITIALIZE,                startReset,                 TH_SENS_RESET_STATE),
+  FSM_TRANSITION(TH_SENS_RESET_STATE,               TH_SENS_TIMEOUT,                      releaseReset,               TH_SENS_BOOT_STATE),
+  FSM_TRANSITION(TH_SENS_BOOT_STATE,                TH_SENS_TIMEOUT,                      requestDeviceID,            TH_SENS_READ_ID_STATE),
+  FSM_TRANSITION(TH_SENS_READ_ID_STATE,             TH_SENS_TIMEOUT,                      fetchDeviceID,              TH_SENS_IDLE_STATE),
+  FSM_TRANSITION(TH_SENS_IDLE_STATE,                TH_SENS_START_SINGLE_SHOT_READ,       FSM_NO_ACTION,              TH_SENS_IDLE_STATE), // TODO run single-shot measurement
+  FSM_TRANSITION(TH_SENS_IDLE_STATE,                GLOBAL_CMD_START_CONTINUOUS_SENSING,  startPipelinedAcquisition,  TH_SENS_CONTINUOUS_MEASURE_STATE),
+  FSM_TRANSITION(TH_SENS_STATE_ERROR,               GLOBAL_CMD_RESTART,                   startReset,                 TH_SENS_RESET_STATE),
+};
+
+static const FSM_Table_t thSensorFSMTable = FSM_TABLE(thSensorTransitions, NULL);
+
 /**
  * @brief Temperature & Humidity Sensor actor struct
  * @extends actor_t
@@ -33,8 +51,7 @@ TH_SENS_Actor_t TH_SENS_Actor = {
                 .osThreadId = NULL,
         },
         .state = TH_SENS_NO_STATE,
-        .rawTemperature = 0x0000,    ///< raw temperature value
-        .rawHumidity = 0x0000,       ///< raw humidity value
+        .isSensing = false,
 };
 
 // task description required for static task creation
@@ -94,112 +111,104 @@ void TH_SENS_Task(void *argument) {
 }
 
 static osStatus_t handleTHSensorFSM(TH_SENS_Actor_t *this, message_t *message) {
-  switch (this->state) {
-    case TH_SENS_NO_STATE:
-      return handleInit(this, message);
-    case TH_SENS_IDLE_STATE:
-      return handleIdle(this, message);
-    case TH_SENS_CONTINUOUS_MEASURE_STATE:
-      return handleContinuousMeasure(this, message);
-    case TH_SENS_STATE_ERROR:
-      // TODO implement error handling
-      return handleError(this, message);
-    default:
-      return osOK;
-  }
-}
+  if (ACTOR_TIMER_IsStaleExpiry(&this->timer, message)) return osOK;
 
-static osStatus_t handleInit(TH_SENS_Actor_t *this, message_t *message) {
-  if (GLOBAL_CMD_INITIALIZE == message->event) {
-    // provide IO functions to the sensor driver
-    osStatus_t ioStatus = SHT3x_InitIO(TH_SENS_I2C_ADDRESS, SensorsBus_Send, SensorsBus_Recv, delayMs, NULL);
+  uint8_t state = this->state;
+  osStatus_t status = FSM_Dispatch(&thSensorFSMTable, &this->super, message, &state);
+  this->state = state;
 
-    if (ioStatus != osOK) return osError;
+  return status;
+}
 
-    // reset the sensor by pulling down _TEMP_RESET, at least 1uS duration required
-    HAL_GPIO_WritePin(TEMP_RESET_N_GPIO_Port, TEMP_RESET_N_Pin, GPIO_PIN_RESET);
-    osDelay(1);
-    HAL_GPIO_WritePin(TEMP_RESET_N_GPIO_Port, TEMP_RESET_N_Pin, GPIO_PIN_SET);
-    osDelay(10); // wait for sensor to be ready after reset
+/**
+ * @brief Provides IO to the driver and starts the sensor reset
+ *
+ * The reset pulse, the sensor boot and the serial number read are timed by the actor timer,
+ * the thread is free to process other events meanwhile.
+ */
+static osStatus_t startReset(TH_SENS_Actor_t *this, message_t *message) {
+  // provide IO functions to the sensor driver
+  osStatus_t ioStatus = SHT3x_InitIO(TH_SENS_I2C_ADDRESS, SensorsBus_Send, SensorsBus_Recv, delayMs, crc8);
 
-    // read sensor ID
-    uint32_t sht3xId = 0x00000000;
-    ioStatus = SHT3x_ReadDeviceID(&sht3xId);
+  if (ioStatus != osOK) return osError;
 
-    if (ioStatus != osOK) return osError;
+  // reset the sensor by pulling down _TEMP_RESET, at least 1uS duration required
+  HAL_GPIO_WritePin(TEMP_RESET_N_GPIO_Port, TEMP_RESET_N_Pin, GPIO_PIN_RESET);
 
-    #ifdef DEBUG
-      fprintf(stdout, "SHT3x ID: %lu\n", sht3xId);
-    #endif
+  return ACTOR_TIMER_StartOneShot(&this->timer, TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID, TH_SENS_TIMEOUT, 1);
+}
 
-    // publish to event manager that the sensor is initialized
-    osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
-    osMessageQueuePut(evManagerQueue, &(message_t){GLOBAL_INITIALIZE_SUCCESS, .payload.value = TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID}, 0, 0);
+static osStatus_t releaseReset(TH_SENS_Actor_t *this, message_t *message) {
+  HAL_GPIO_WritePin(TEMP_RESET_N_GPIO_Port, TEMP_RESET_N_Pin, GPIO_PIN_SET);
 
-    #ifdef DEBUG
-      fprintf(stdout, "Temperature & Humidity sensor %u initialized\n", TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID);
-    #endif
+  // wait for sensor to be ready after reset
+  return ACTOR_TIMER_StartOneShot(&this->timer, TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID, TH_SENS_TIMEOUT, SHT3x_RESET_TIME_MS);
+}
 
-    TO_STATE(this, TH_SENS_IDLE_STATE);
-  }
+static osStatus_t requestDeviceID(TH_SENS_Actor_t *this, message_t *message) {
+  osStatus_t ioStatus = SHT3x_RequestDeviceID();
 
-  return osOK;
-}
+  if (ioStatus != osOK) return osError;
 
-static osStatus_t handleIdle(TH_SENS_Actor_t *this, message_t *message) {
-  osStatus_t  ioStatus = osOK;
-
-  switch (message->event) {
-    case GLOBAL_CMD_START_CONTINUOUS_SENSING:
-      ioStatus = SHT3x_PeriodicAcquisitionMode(SHT3x_START_MEASUREMENT_0_5_MPS_LOW_REPEATABILITY_CMD_ID);
-      if (ioStatus != osOK) return osError;
-
-      TO_STATE(this, TH_SENS_CONTINUOUS_MEASURE_STATE);
-      return osOK;
-    case TH_SENS_START_SINGLE_SHOT_READ:
-      // TODO run single-shot measurement
-//      #ifdef DEBUG
-//        fprintf(stdout, "Raw: temperature: %d humidity %d\n", this->rawTemperature, this->rawHumidity);
-//      #endif
-
-      TO_STATE(this, TH_SENS_IDLE_STATE);
-      return osOK;
-    default:
-      return osOK;
-  }
+  // the sensor ACKs the read header only after tIDLE
+  return ACTOR_TIMER_StartOneShot(&this->timer, TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID, TH_SENS_TIMEOUT, SHT3x_IDLE_TIME_MS);
 }
 
-static osStatus_t handleContinuousMeasure(TH_SENS_Actor_t *this, message_t *message) {
-  osStatus_t  ioStatus = osOK;
+/**
+ * @brief Reads the sensor ID and publishes the initialization success
+ *
+ * The supervised restart runs the same reset sequence, if the continuous sensing was running before
+ * the error the start command is posted to itself so the IDLE row re-triggers the pipeline.
+ */
+static osStatus_t fetchDeviceID(TH_SENS_Actor_t *this, message_t *message) {
+  uint32_t sht3xId = 0x00000000;
+  osStatus_t ioStatus = SHT3x_FetchDeviceID(&sht3xId);
 
-  switch (message->event) {
-    case GLOBAL_WAKE_N_READ:
-      ioStatus = SHT3x_ReadMeasurements(&this->rawTemperature, &this->rawHumidity);
-      if (ioStatus != osOK) return osError;
+  if (ioStatus != osOK) return osError;
 
-      uint16_t t = SHT3x_RawToTemperatureC(this->rawTemperature);
-      uint16_t rh = SHT3x_RawToHumidityRH(this->rawHumidity);
+  #ifdef DEBUG
+    fprintf(stdout, "SHT3x ID: %lu\n", sht3xId);
+  #endif
 
-      #ifdef DEBUG
-        fprintf(stdout, "Temperature: %d humidity %d\n", t, rh);
-      #endif
+  // publish to event manager that the sensor is initialized
+  osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
+  osMessageQueuePut(evManagerQueue, &(message_t){GLOBAL_INITIALIZE_SUCCESS, .payload.value = TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID}, 0, 0);
 
-      // publish to the event manager that temperature and humidity are ready with the pointer to the TH actor
-      osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
-      osMessageQueuePut(evManagerQueue, &(message_t){GLOBAL_TEMPERATURE_HUMIDITY_MEASUREMENTS_READY, .payload.ptr = this /* TH Actor */}, 0, 0);
+  #ifdef DEBUG
+    fprintf(stdout, "Temperature & Humidity sensor %u initialized\n", TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID);
+  #endif
 
-      TO_STATE(this, TH_SENS_CONTINUOUS_MEASURE_STATE);
-      return osOK;
-    default:
-      return osOK;
+  if (this->isSensing) {
+    osMessageQueuePut(this->super.osMessageQueueId, &(message_t){.event = GLOBAL_CMD_START_CONTINUOUS_SENSING}, 0, 0);
   }
+
+  return osOK;
 }
 
-static osStatus_t handleError(TH_SENS_Actor_t *this, message_t *message) {
+/**
+ * @brief Triggers the first single-shot measurement of the pipeline
+ *
+ * The acquisition scheduler reads the result on the next wake up and triggers the following measurement,
+ * so the conversion never runs on the wake up critical path. Unlike the periodic mode the sensor converts
+ * once per wake up and stays idle in between.
+ */
+static osStatus_t startPipelinedAcquisition(TH_SENS_Actor_t *this, message_t *message) {
+  this->isSensing = true;
+
+  osStatus_t ioStatus = SHT3x_SingleShotAcquisitionMode(TH_SENS_SINGLE_SHOT_CMD_ID);
+  if (ioStatus != osOK) return osError;
+
   return osOK;
 }
 
 static uint32_t delayMs(uint32_t ms) {
   uint32_t ticks = (ms * configTICK_RATE_HZ) / 1000;
   return osDelay(ticks);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief SHT3x words CRC on the CRC unit, the acquisition scheduler parses the measurements with it too
+ */
+static uint8_t crc8(uint8_t *data, uint8_t len) {
+  return CRC_SERVICE_Crc8(data, len);
+}
@@ -20,14 +20,21 @@ extern "C" {
 #include "main.h"
 #include "sensors_bus.h"
 #include "sht3x.h"
+#include "crc_service.h"
+#include "fsm.h"
+#include "actor_timer.h"
 
 #define TH_SENS_I2C_ADDRESS (SHT3x_I2C_ADDR_44 << 1) // ADDR connected to GND due to OPT3001 address conflict
+#define TH_SENS_SINGLE_SHOT_CMD_ID (SHT3x_MEASURE_SINGLE_SHOT_LOW_REPEATABILITY_CMD_ID) // pipelined measurement, triggered on every wake up
 
 typedef enum {
   TH_SENS_NO_STATE = 0,
+  TH_SENS_RESET_STATE, ///< Reset pin is pulled down
+  TH_SENS_BOOT_STATE, ///< Reset is released, waiting for the sensor to be ready
+  TH_SENS_READ_ID_STATE, ///< Serial number is requested, waiting for tIDLE
   TH_SENS_IDLE_STATE,
   TH_SENS_MEASURE_WAIT_STATE,
-  TH_SENS_CONTINUOUS_MEASURE_STATE,
+  TH_SENS_CONTINUOUS_MEASURE_STATE, ///< Pipelined single-shot measurements, read and re-triggered by the acquisition scheduler
   TH_SENS_STATE_ERROR,
   TH_SENS_STATE_MAX
 } TH_SENS_State_t;
@@ -35,8 +42,8 @@ typedef enum {
 typedef struct {
   actor_t super;
   TH_SENS_State_t state;
-  int16_t rawTemperature; ///< TODO units
-  uint16_t rawHumidity; ///< TODO units
+  ACTOR_Timer_t timer; ///< posts TH_SENS_TIMEOUT instead of blocking the thread
+  bool isSensing; ///< continuous sensing was started, resumed after the supervised restart
 } TH_SENS_Actor_t;
 
 extern TH_SENS_Actor_t TH_SENS_Actor;
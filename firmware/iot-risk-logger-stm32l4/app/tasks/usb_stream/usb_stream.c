@@ -0,0 +1,644 @@
+/*!
+ * @file usb_stream.c
+ * @brief implementation of the USB stream actor
+ *
+ * The log export is the NFC export pipeline with the USB in place of the FTM: the range is read from MEMORY in blocks
+ * into two buffers, block k into the buffer k % USB_STREAM_EXPORT_BUFFERS_COUNT. The completion interrupt of a block
+ * starts the next loaded one at once, so the IN endpoint never waits for the actor, the actor only refills the
+ * released buffer. The buffers are claimed from the log transfer pool, the NFC export shares them.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "usb_stream.h"
+
+typedef enum {
+  USB_STREAM_EXPORT_OPENING = 0, ///< Waiting for the log tail from MEMORY
+  USB_STREAM_EXPORT_SENDING,
+  USB_STREAM_EXPORT_FINISHING, ///< Export is over, late events are ignored
+} USB_STREAM_ExportPhase_t;
+
+/**
+ * @brief Log export context, shared with the USB interrupt
+ *
+ * The actor counts the loaded blocks, the interrupt counts the sent and released ones. The actor's side runs in
+ * the critical section whenever it starts a transfer.
+ */
+typedef struct {
+  USB_STREAM_ExportPhase_t phase;
+  NFC_LogExportRange_t range;
+  MEMORY_LogReadRequest_t read; ///< Pending MEMORY read, one at a time
+  bool isReadPending;
+  volatile bool isActive; ///< Blocks are transmitted by the interrupt
+  bool isZLPSent;
+  uint8_t sequence; ///< SEQ of the export command, echoed by its ACK or NACK
+  uint32_t startAddress;
+  uint32_t size;
+  uint32_t blocksCount;
+  volatile uint32_t loadedBlocks;
+  volatile uint32_t sentBlocks;
+  volatile uint32_t releasedBlocks;
+  LOG_TRANSFER_POOL_Buffer_t *buffers; ///< Claimed for the export, released once it's over and no read is pending
+} USB_STREAM_Export_t;
+
+/**
+ * @brief Frames exchanged with the host, one of each kind at a time
+ */
+typedef struct {
+  uint8_t command[USB_STREAM_FRAME_SIZE_MAX];
+  volatile bool isCommandPending; ///< Command is copied, the next one is dropped until it's handled
+  uint8_t response[USB_STREAM_FRAME_SIZE_MAX];
+  volatile bool isResponsePending; ///< Response waits for the IN endpoint, sent before anything else
+  uint8_t live[NFC_MAILBOX_PROTOCOL_HEADER_SIZE + MEMORY_LOG_ENTRY_SIZE];
+  uint8_t wakeUpPeriod[sizeof(NFC_WakeUpPeriodBounds_t)]; ///< Wake up period command payload, read by the cron after the command is released
+} USB_STREAM_Frames_t;
+
+_Static_assert(USB_STREAM_EXPORT_BLOCK_SIZE % USBD_MSC_CDC_DATA_PACKET_SIZE == 0, "export block isn't a multiple of the packet size");
+_Static_assert(sizeof(((USB_STREAM_Frames_t *) 0)->live) <= USB_STREAM_FRAME_SIZE_MAX, "live frame doesn't fit the packet");
+
+static osStatus_t handleUSBStreamFSM(USB_STREAM_Actor_t *this, message_t *message);
+/** transitions actions */
+static osStatus_t initialize(USB_STREAM_Actor_t *this, message_t *message);
+static osStatus_t openPort(USB_STREAM_Actor_t *this, message_t *message);
+static osStatus_t closePort(USB_STREAM_Actor_t *this, message_t *message);
+static osStatus_t receiveCommand(USB_STREAM_Actor_t *this, message_t *message);
+static osStatus_t sendLiveFrame(USB_STREAM_Actor_t *this, message_t *message);
+static osStatus_t openExport(USB_STREAM_Actor_t *this, message_t *message);
+static osStatus_t handleExportRead(USB_STREAM_Actor_t *this, message_t *message);
+static osStatus_t pumpExport(USB_STREAM_Actor_t *this, message_t *message);
+static osStatus_t rejectExport(USB_STREAM_Actor_t *this, message_t *message);
+static osStatus_t abortExport(USB_STREAM_Actor_t *this, message_t *message);
+static osStatus_t finishExport(USB_STREAM_Actor_t *this, message_t *message);
+static osStatus_t handleUnhandledEvent(USB_STREAM_Actor_t *this, message_t *message);
+/** utils */
+static osStatus_t startExport(USB_STREAM_Actor_t *this);
+static osStatus_t prefetchExportBlock(USB_STREAM_Actor_t *this);
+static osStatus_t requestLogRead(USB_STREAM_Actor_t *this, uint32_t address, uint8_t *buffer, uint32_t size);
+static osStatus_t postExportDone(USB_STREAM_Actor_t *this, osStatus_t status);
+static void releaseExportBuffers(void);
+static void sendResponse(uint8_t sequence, uint8_t responseCode, const void *payload, uint8_t payloadSize);
+static void buildFrame(uint8_t *frame, uint8_t command, uint8_t sequence, const void *payload, uint8_t payloadSize);
+static uint8_t calculateFrameCRC8(const uint8_t *frame);
+static void transmitNext(void);
+/** USB interrupt callbacks */
+static void handleReceived(const uint8_t *data, uint32_t length);
+static void handleTransmitDone(void);
+static void handlePortChanged(bool isOpen);
+
+static USB_STREAM_Export_t exportContext;
+static USB_STREAM_Frames_t framesContext;
+static volatile bool isPortOpen;
+
+static const USBD_MSC_CDC_Callbacks_t cdcCallbacks = {
+  .Received = handleReceived,
+  .TransmitDone = handleTransmitDone,
+  .PortChanged = handlePortChanged,
+};
+
+extern actor_t* ACTORS_LOOKUP_SystemRegistry[MAX_ACTORS];
+extern USBD_HandleTypeDef hUsbDeviceFS;
+
+/**
+ * @brief USB stream FSM transitions table
+ * @note rendered to the README state diagram by scripts/generate_state_machine_diagrams.py
+ * @note Commands arriving during the export are dropped, its data can't be interleaved with the responses
+ */
+static const FSM_Transition_t usbStreamTransitions[] = {
+  FSM_TRANSITION(USB_STREAM_NO_STATE,       GLOBAL_CMD_INITIALIZE,            initialize,         USB_STREAM_IDLE_STATE),
+  FSM_TRANSITION(USB_STREAM_IDLE_STATE,     USB_STREAM_PORT_OPENED,           openPort,           USB_STREAM_READY_STATE),
+  FSM_TRANSITION(USB_STREAM_READY_STATE,    USB_STREAM_PORT_CLOSED,           closePort,          USB_STREAM_IDLE_STATE),
+  FSM_TRANSITION(USB_STREAM_READY_STATE,    USB_STREAM_CMD_RECEIVED,          receiveCommand,     USB_STREAM_READY_STATE),
+  FSM_TRANSITION(USB_STREAM_READY_STATE,    GLOBAL_MEASUREMENTS_FRAME_READY,  sendLiveFrame,      USB_STREAM_READY_STATE),
+  FSM_TRANSITION(USB_STREAM_READY_STATE,    GLOBAL_CMD_EXPORT_LOG,            openExport,         USB_STREAM_EXPORT_STATE),
+  FSM_TRANSITION(USB_STREAM_EXPORT_STATE,   GLOBAL_LOG_CHUNK_READ_SUCCESS,    handleExportRead,   USB_STREAM_EXPORT_STATE),
+  FSM_TRANSITION(USB_STREAM_EXPORT_STATE,   USB_STREAM_TX_DONE,               pumpExport,         USB_STREAM_EXPORT_STATE),
+  FSM_TRANSITION(USB_STREAM_EXPORT_STATE,   USB_STREAM_EXPORT_REJECTED,       rejectExport,       USB_STREAM_READY_STATE),
+  FSM_TRANSITION(USB_STREAM_EXPORT_STATE,   USB_STREAM_EXPORT_DONE,           finishExport,       USB_STREAM_READY_STATE),
+  FSM_TRANSITION(USB_STREAM_EXPORT_STATE,   USB_STREAM_PORT_CLOSED,           abortExport,        USB_STREAM_IDLE_STATE),
+  FSM_TRANSITION(USB_STREAM_STATE_ERROR,    GLOBAL_CMD_RESTART,               initialize,         USB_STREAM_IDLE_STATE),
+};
+
+static const FSM_Table_t usbStreamFSMTable = FSM_TABLE(usbStreamTransitions, handleUnhandledEvent);
+
+USB_STREAM_Actor_t USB_STREAM_Actor = {
+        .super = {
+                .actorId = USB_STREAM_ACTOR_ID,
+                .messageHandler = (messageHandler_t) handleUSBStreamFSM,
+                .osMessageQueueId = NULL,
+                .osThreadId = NULL,
+        },
+        .state = USB_STREAM_NO_STATE
+};
+
+uint32_t usbStreamTaskBuffer[USB_STREAM_TASK_STACK_SIZE_WORDS];
+StaticTask_t usbStreamTaskControlBlock;
+const osThreadAttr_t usbStreamTaskDescription = {
+        .name = "usbStreamTask",
+        .cb_mem = &usbStreamTaskControlBlock,
+        .cb_size = sizeof(usbStreamTaskControlBlock),
+        .stack_mem = &usbStreamTaskBuffer[0],
+        .stack_size = sizeof(usbStreamTaskBuffer),
+        .priority = (osPriority_t) osPriorityNormal,
+};
+
+actor_t* USB_STREAM_TaskInit(void) {
+  USB_STREAM_Actor.super.osMessageQueueId = osMessageQueueNew(DEFAULT_QUEUE_SIZE, DEFAULT_QUEUE_MESSAGE_SIZE, &(osMessageQueueAttr_t){
+    .name = "usbStreamQueue"
+  });
+  USB_STREAM_Actor.super.osThreadId = osThreadNew(USB_STREAM_Task, NULL, &usbStreamTaskDescription);
+
+  // the queue is ready for the callbacks, the USB device is started later by the default task
+  USBD_MSC_CDC_RegisterCallbacks(&hUsbDeviceFS, &cdcCallbacks);
+
+  return (actor_t*) &USB_STREAM_Actor;
+}
+
+void USB_STREAM_Task(void *argument) {
+  (void) argument; // Avoid unused parameter warning
+  message_t msg;
+  osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
+
+  for (;;) {
+    // Wait for messages from the queue
+    if (osMessageQueueGet(USB_STREAM_Actor.super.osMessageQueueId, &msg, NULL, osWaitForever) == osOK) {
+      osStatus_t status = USB_STREAM_Actor.super.messageHandler((actor_t *) &USB_STREAM_Actor, &msg);
+
+      if (status != osOK) {
+        osMessageQueuePut(evManagerQueue, &(message_t){GLOBAL_ERROR, .payload.value = USB_STREAM_ACTOR_ID}, 0, 0);
+        TO_STATE(&USB_STREAM_Actor, USB_STREAM_STATE_ERROR);
+      }
+    }
+  }
+}
+
+static osStatus_t handleUSBStreamFSM(USB_STREAM_Actor_t *this, message_t *message) {
+  uint8_t state = this->state;
+  osStatus_t status = FSM_Dispatch(&usbStreamFSMTable, &this->super, message, &state);
+  this->state = state;
+
+  return status;
+}
+
+static osStatus_t initialize(USB_STREAM_Actor_t *this, message_t *message) {
+  UNUSED(message);
+
+  // restarted from ERROR in the middle of the export, the interrupt stops transmitting its blocks
+  taskENTER_CRITICAL();
+  exportContext.isActive = false;
+  framesContext.isResponsePending = false;
+  framesContext.isCommandPending = false;
+  taskEXIT_CRITICAL();
+
+  exportContext.phase = USB_STREAM_EXPORT_FINISHING;
+  releaseExportBuffers();
+
+  this->isLiveOn = false;
+
+  // the host opened the port before the actor was up, the callback found the actor out of IDLE
+  if (isPortOpen)
+    return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {USB_STREAM_PORT_OPENED}, 0, 0);
+
+  return osOK;
+}
+
+static osStatus_t openPort(USB_STREAM_Actor_t *this, message_t *message) {
+  UNUSED(message);
+
+  this->isLiveOn = false; // a new host session, it asks for the live frames itself
+
+  #ifdef DEBUG
+    fprintf(stdout, "USB stream port opened\n");
+  #endif
+
+  return osOK;
+}
+
+static osStatus_t closePort(USB_STREAM_Actor_t *this, message_t *message) {
+  UNUSED(this);
+  UNUSED(message);
+
+  framesContext.isResponsePending = false;
+
+  return osOK;
+}
+
+/**
+ * @brief Validates the command frame and executes it, the log export is opened by the posted GLOBAL_CMD_EXPORT_LOG
+ */
+static osStatus_t receiveCommand(USB_STREAM_Actor_t *this, message_t *message) {
+  USB_STREAM_Frames_t *frames = &framesContext;
+  const uint8_t *command = frames->command;
+  const uint32_t length = message->payload.value;
+  const uint8_t sequence = command[NFC_MAILBOX_PROTOCOL_SEQ_ADDR];
+  const uint8_t payloadSize = command[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR];
+  osStatus_t status = osOK;
+
+  if (length < NFC_MAILBOX_PROTOCOL_HEADER_SIZE || (uint32_t) (NFC_MAILBOX_PROTOCOL_HEADER_SIZE + payloadSize) > length
+      || calculateFrameCRC8(command) != command[NFC_MAILBOX_PROTOCOL_CRC8_ADDR]) {
+    sendResponse(sequence, NFC_RESPONSE_NACK_CRC_ERROR, NULL, 0);
+    frames->isCommandPending = false;
+    return osOK;
+  }
+
+  switch (command[NFC_MAILBOX_PROTOCOL_CMD_ADDR]) {
+    case GLOBAL_CMD_EXPORT_LOG:
+      // the range is kept by the export context, the command buffer is released below
+      memcpy(&exportContext.range, &command[NFC_MAILBOX_PROTOCOL_PAYLOAD_ADDR], MIN(payloadSize, sizeof(exportContext.range)));
+      status = osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {
+        GLOBAL_CMD_EXPORT_LOG,
+        .payload.value = sequence,
+        .payload_size = payloadSize
+      }, 0, 0);
+      break;
+    case GLOBAL_CMD_SET_WAKE_UP_PERIOD:
+    case GLOBAL_CMD_SET_WAKE_UP_PERIOD_BOUNDS: {
+      const event_t cmdEvent = command[NFC_MAILBOX_PROTOCOL_CMD_ADDR];
+      const uint8_t expectedSize = (cmdEvent == GLOBAL_CMD_SET_WAKE_UP_PERIOD) ? sizeof(uint16_t) : sizeof(NFC_WakeUpPeriodBounds_t);
+      osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
+
+      if (payloadSize != expectedSize) {
+        sendResponse(sequence, NFC_RESPONSE_NACK_ERROR, NULL, 0);
+        break;
+      }
+
+      memcpy(frames->wakeUpPeriod, &command[NFC_MAILBOX_PROTOCOL_PAYLOAD_ADDR], payloadSize);
+      const osStatus_t putStatus = osMessageQueuePut(evManagerQueue, &(message_t) {
+        .event = cmdEvent,
+        .payload.ptr = frames->wakeUpPeriod,
+        .payload_size = payloadSize
+      }, 0, 0);
+      sendResponse(sequence, (putStatus == osOK) ? NFC_RESPONSE_ACK_OK : NFC_RESPONSE_NACK_ERROR, NULL, 0);
+      break;
+    }
+    case USB_STREAM_CMD_SET_LIVE:
+      if (payloadSize != 1) {
+        sendResponse(sequence, NFC_RESPONSE_NACK_ERROR, NULL, 0);
+        break;
+      }
+
+      this->isLiveOn = command[NFC_MAILBOX_PROTOCOL_PAYLOAD_ADDR] != 0;
+      sendResponse(sequence, NFC_RESPONSE_ACK_OK, NULL, 0);
+      break;
+    default:
+      sendResponse(sequence, NFC_RESPONSE_NACK_ERROR, NULL, 0);
+      break;
+  }
+
+  frames->isCommandPending = false;
+
+  return status;
+}
+
+/**
+ * @brief Sends the frame as the log entry it would be written as, dropped while the previous one is transmitted
+ * @note The frame is reused by ACQUISITION on the next wake up, it's copied at once
+ */
+static osStatus_t sendLiveFrame(USB_STREAM_Actor_t *this, message_t *message) {
+  const ACQUISITION_Frame_t *frame = (const ACQUISITION_Frame_t *) message->payload.ptr;
+  const uint8_t sequence = this->liveSequence++;
+
+  if (!this->isLiveOn)
+    return osOK;
+
+  MEMORY_SensorsMeasurementEntry_t entry = {
+          .timestamp = frame->timestamp,
+          .rawTemperature = frame->rawTemperature,
+          .rawHumidity = frame->rawHumidity,
+          .rawLux = frame->rawLux,
+          .accelX = frame->acceleration[0],
+          .accelY = frame->acceleration[1],
+          .accelZ = frame->acceleration[2],
+          .suppressedCount = 0,
+  };
+
+  VIBRATION_Summarize(&frame->vibration, &entry.vibration);
+
+  taskENTER_CRITICAL();
+  if (!USBD_MSC_CDC_IsTransmitting() && !framesContext.isResponsePending) {
+    buildFrame(framesContext.live, USB_STREAM_LIVE_FRAME, sequence, &entry, sizeof(entry));
+    USBD_MSC_CDC_Transmit(&hUsbDeviceFS, framesContext.live, sizeof(framesContext.live));
+  }
+  taskEXIT_CRITICAL();
+
+  return osOK;
+}
+
+/**
+ * @brief Starts the export of the command's range, payload value is the command SEQ
+ * @note A zero size read asks MEMORY for the log tail to clamp the range to
+ */
+static osStatus_t openExport(USB_STREAM_Actor_t *this, message_t *message) {
+  USB_STREAM_Export_t *logExport = &exportContext;
+  const uint8_t sequence = (uint8_t) message->payload.value;
+
+  // a read of the aborted export may still be in MEMORY queue, its buffer can't be reused yet
+  if (message->payload_size != (ssize_t) sizeof(NFC_LogExportRange_t) || logExport->isReadPending) {
+    sendResponse(sequence, NFC_RESPONSE_NACK_ERROR, NULL, 0);
+    logExport->phase = USB_STREAM_EXPORT_FINISHING;
+    return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {USB_STREAM_EXPORT_REJECTED}, 0, 0);
+  }
+
+  logExport->phase = USB_STREAM_EXPORT_OPENING;
+  logExport->sequence = sequence;
+  logExport->loadedBlocks = 0;
+  logExport->sentBlocks = 0;
+  logExport->releasedBlocks = 0;
+  logExport->isZLPSent = false;
+
+  return requestLogRead(this, 0, NULL, 0);
+}
+
+static osStatus_t handleExportRead(USB_STREAM_Actor_t *this, message_t *message) {
+  USB_STREAM_Export_t *logExport = &exportContext;
+
+  logExport->isReadPending = false;
+
+  if (logExport->phase == USB_STREAM_EXPORT_FINISHING) {
+    releaseExportBuffers();
+    return osOK;
+  }
+
+  if ((osStatus_t) message->payload.value != osOK) {
+    if (logExport->phase == USB_STREAM_EXPORT_OPENING) {
+      sendResponse(logExport->sequence, NFC_RESPONSE_NACK_ERROR, NULL, 0);
+      logExport->phase = USB_STREAM_EXPORT_FINISHING;
+      return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {USB_STREAM_EXPORT_REJECTED}, 0, 0);
+    }
+
+    // the host gets less data than acknowledged and times out, there is no way to tell it in the raw stream
+    return postExportDone(this, osError);
+  }
+
+  if (logExport->phase == USB_STREAM_EXPORT_OPENING)
+    return startExport(this);
+
+  logExport->loadedBlocks++;
+
+  taskENTER_CRITICAL();
+  transmitNext();
+  taskEXIT_CRITICAL();
+
+  return prefetchExportBlock(this);
+}
+
+/**
+ * @brief The interrupt has released a block: its buffer is refilled, the end of the data is marked
+ */
+static osStatus_t pumpExport(USB_STREAM_Actor_t *this, message_t *message) {
+  UNUSED(message);
+
+  USB_STREAM_Export_t *logExport = &exportContext;
+
+  if (logExport->phase != USB_STREAM_EXPORT_SENDING)
+    return osOK;
+
+  if (logExport->releasedBlocks < logExport->blocksCount)
+    return prefetchExportBlock(this);
+
+  // the data ends with a full packet, the ZLP completes the host's read
+  if (logExport->size % USBD_MSC_CDC_DATA_PACKET_SIZE == 0 && !logExport->isZLPSent) {
+    logExport->isZLPSent = true;
+
+    taskENTER_CRITICAL();
+    uint8_t status = USBD_MSC_CDC_Transmit(&hUsbDeviceFS, NULL, 0);
+    taskEXIT_CRITICAL();
+
+    return (status == USBD_OK) ? osOK : postExportDone(this, osError);
+  }
+
+  return postExportDone(this, osOK);
+}
+
+static osStatus_t rejectExport(USB_STREAM_Actor_t *this, message_t *message) {
+  UNUSED(this);
+  UNUSED(message);
+
+  return osOK;
+}
+
+/**
+ * @brief The host closed the port, the interrupt has already stopped transmitting. The pending read is completed
+ * in READY or IDLE.
+ */
+static osStatus_t abortExport(USB_STREAM_Actor_t *this, message_t *message) {
+  exportContext.phase = USB_STREAM_EXPORT_FINISHING;
+  releaseExportBuffers();
+
+  return closePort(this, message);
+}
+
+static osStatus_t finishExport(USB_STREAM_Actor_t *this, message_t *message) {
+  UNUSED(this);
+  UNUSED(message);
+
+  exportContext.isActive = false;
+  releaseExportBuffers();
+
+  #ifdef DEBUG
+    fprintf(stdout, "USB log export %s, %" PRIu32 " bytes\n", ((osStatus_t) message->payload.value == osOK) ? "done" : "failed", exportContext.size);
+  #endif
+
+  return osOK;
+}
+
+/**
+ * @brief The frames are counted out of READY too, the host sees the dropped ones as the SEQ gap. The read of the
+ * aborted export completes here, its context is free.
+ */
+static osStatus_t handleUnhandledEvent(USB_STREAM_Actor_t *this, message_t *message) {
+  if (message->event == GLOBAL_MEASUREMENTS_FRAME_READY) {
+    this->liveSequence++;
+  }
+
+  if (message->event == GLOBAL_LOG_CHUNK_READ_SUCCESS) {
+    exportContext.isReadPending = false;
+    releaseExportBuffers();
+  }
+
+  if (message->event == USB_STREAM_CMD_RECEIVED) {
+    framesContext.isCommandPending = false;
+  }
+
+  return osOK;
+}
+
+/**
+ * @brief Clamps the requested range to the written log, acknowledges it and loads the first blocks
+ */
+static osStatus_t startExport(USB_STREAM_Actor_t *this) {
+  USB_STREAM_Export_t *logExport = &exportContext;
+  const uint32_t writtenEntries = (logExport->read.logTailAddress - INITIAL_LOG_START_ADDR) / MEMORY_LOG_ENTRY_SIZE;
+  NFC_LogExportRange_t *range = &logExport->range;
+
+  // the empty range, or the NFC export owning the buffers, is answered with NACK
+  logExport->buffers = (range->firstEntry < writtenEntries) ? LOG_TRANSFER_POOL_Claim(USB_STREAM_ACTOR_ID) : NULL;
+  if (logExport->buffers == NULL) {
+    sendResponse(logExport->sequence, NFC_RESPONSE_NACK_ERROR, NULL, 0);
+    logExport->phase = USB_STREAM_EXPORT_FINISHING;
+    return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {USB_STREAM_EXPORT_REJECTED}, 0, 0);
+  }
+
+  const uint32_t availableEntries = writtenEntries - range->firstEntry;
+  range->entriesCount = (range->entriesCount == 0 || range->entriesCount > availableEntries) ? availableEntries : range->entriesCount;
+
+  logExport->startAddress = INITIAL_LOG_START_ADDR + range->firstEntry * MEMORY_LOG_ENTRY_SIZE;
+  logExport->size = range->entriesCount * MEMORY_LOG_ENTRY_SIZE;
+  logExport->blocksCount = (logExport->size + USB_STREAM_EXPORT_BLOCK_SIZE - 1) / USB_STREAM_EXPORT_BLOCK_SIZE;
+  logExport->phase = USB_STREAM_EXPORT_SENDING;
+
+  // the ACK goes out first, the interrupt follows it with the blocks as they are loaded
+  logExport->isActive = true;
+  sendResponse(logExport->sequence, NFC_RESPONSE_ACK_OK, range, sizeof(*range));
+
+  return prefetchExportBlock(this);
+}
+
+/**
+ * @brief Requests the next block while its buffer is free: the block two ahead reuses the buffer of the released one
+ */
+static osStatus_t prefetchExportBlock(USB_STREAM_Actor_t *this) {
+  USB_STREAM_Export_t *logExport = &exportContext;
+  const uint32_t block = logExport->loadedBlocks;
+
+  if (logExport->isReadPending || block >= logExport->blocksCount || block >= logExport->releasedBlocks + USB_STREAM_EXPORT_BUFFERS_COUNT)
+    return osOK;
+
+  const uint32_t offset = block * USB_STREAM_EXPORT_BLOCK_SIZE;
+  const uint32_t remainingSize = logExport->size - offset;
+  const uint32_t size = (remainingSize < USB_STREAM_EXPORT_BLOCK_SIZE) ? remainingSize : USB_STREAM_EXPORT_BLOCK_SIZE;
+
+  return requestLogRead(this, logExport->startAddress + offset, logExport->buffers[block % USB_STREAM_EXPORT_BUFFERS_COUNT], size);
+}
+
+static osStatus_t requestLogRead(USB_STREAM_Actor_t *this, uint32_t address, uint8_t *buffer, uint32_t size) {
+  UNUSED(this);
+
+  USB_STREAM_Export_t *logExport = &exportContext;
+  osMessageQueueId_t memoryQueue = ACTORS_LOOKUP_SystemRegistry[MEMORY_ACTOR_ID]->osMessageQueueId;
+
+  logExport->read.requesterId = USB_STREAM_ACTOR_ID;
+  logExport->read.address = address;
+  logExport->read.buffer = buffer;
+  logExport->read.size = size;
+  logExport->isReadPending = true;
+
+  return osMessageQueuePut(memoryQueue, &(message_t) {GLOBAL_CMD_READ_LOG_CHUNK, .payload.ptr = &logExport->read}, 0, 0);
+}
+
+/**
+ * @brief Returns the buffers to the pool once the export is over and MEMORY doesn't read into them anymore
+ * @note The block in flight of the failed export may go out with the next exporter's data, the host has already
+ * lost the stream
+ */
+static void releaseExportBuffers(void) {
+  if (exportContext.phase != USB_STREAM_EXPORT_FINISHING || exportContext.isReadPending)
+    return;
+
+  LOG_TRANSFER_POOL_Release(USB_STREAM_ACTOR_ID);
+}
+
+static osStatus_t postExportDone(USB_STREAM_Actor_t *this, osStatus_t status) {
+  exportContext.phase = USB_STREAM_EXPORT_FINISHING;
+
+  return osMessageQueuePut(this->super.osMessageQueueId, &(message_t) {USB_STREAM_EXPORT_DONE, .payload.value = (uint32_t) status}, 0, 0);
+}
+
+/**
+ * @brief Queues the response, sent at once if the IN endpoint is free, after the live frame in flight otherwise
+ */
+static void sendResponse(uint8_t sequence, uint8_t responseCode, const void *payload, uint8_t payloadSize) {
+  taskENTER_CRITICAL();
+  buildFrame(framesContext.response, responseCode, sequence, payload, payloadSize);
+  framesContext.isResponsePending = true;
+  transmitNext();
+  taskEXIT_CRITICAL();
+}
+
+static void buildFrame(uint8_t *frame, uint8_t command, uint8_t sequence, const void *payload, uint8_t payloadSize) {
+  frame[NFC_MAILBOX_PROTOCOL_CMD_ADDR] = command;
+  frame[NFC_MAILBOX_PROTOCOL_SEQ_ADDR] = sequence;
+  frame[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR] = payloadSize;
+  if (payloadSize != 0) memcpy(&frame[NFC_MAILBOX_PROTOCOL_PAYLOAD_ADDR], payload, payloadSize);
+  frame[NFC_MAILBOX_PROTOCOL_CRC8_ADDR] = calculateFrameCRC8(frame);
+}
+
+/**
+ * @brief CRC-8/NRSC-5 of the frame after the CRC byte, the same as the NFC mailbox frames
+ * @note The payload size should be validated by the caller to fit the frame
+ */
+static uint8_t calculateFrameCRC8(const uint8_t *frame) {
+  const uint16_t length = NFC_MAILBOX_PROTOCOL_HEADER_SIZE - NFC_MAILBOX_PROTOCOL_CRC8_SIZE + frame[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR];
+
+  return CRC_SERVICE_Crc8(&frame[NFC_MAILBOX_PROTOCOL_CMD_ADDR], length);
+}
+
+/**
+ * @brief Starts the next transfer if the IN endpoint is free: the pending response, then the next loaded block
+ * @note Runs in the USB interrupt or in the critical section
+ */
+static void transmitNext(void) {
+  USB_STREAM_Export_t *logExport = &exportContext;
+
+  if (USBD_MSC_CDC_IsTransmitting())
+    return;
+
+  if (framesContext.isResponsePending) {
+    framesContext.isResponsePending = false;
+    USBD_MSC_CDC_Transmit(&hUsbDeviceFS, framesContext.response, NFC_MAILBOX_PROTOCOL_HEADER_SIZE + framesContext.response[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR]);
+    return;
+  }
+
+  if (!logExport->isActive || logExport->sentBlocks >= logExport->loadedBlocks)
+    return;
+
+  const uint32_t block = logExport->sentBlocks;
+  const uint32_t offset = block * USB_STREAM_EXPORT_BLOCK_SIZE;
+  const uint32_t remainingSize = logExport->size - offset;
+  const uint32_t size = (remainingSize < USB_STREAM_EXPORT_BLOCK_SIZE) ? remainingSize : USB_STREAM_EXPORT_BLOCK_SIZE;
+
+  logExport->sentBlocks++;
+  USBD_MSC_CDC_Transmit(&hUsbDeviceFS, logExport->buffers[block % USB_STREAM_EXPORT_BUFFERS_COUNT], size);
+}
+
+/**
+ * @brief The command is copied for the actor, the one arriving before it's handled is dropped: the host sends
+ * the next command after the response
+ */
+static void handleReceived(const uint8_t *data, uint32_t length) {
+  if (framesContext.isCommandPending || length == 0)
+    return;
+
+  memcpy(framesContext.command, data, MIN(length, sizeof(framesContext.command)));
+  framesContext.isCommandPending = true;
+
+  if (osMessageQueuePut(USB_STREAM_Actor.super.osMessageQueueId, &(message_t) {USB_STREAM_CMD_RECEIVED, .payload.value = length}, 0, 0) != osOK)
+    framesContext.isCommandPending = false;
+}
+
+/**
+ * @brief Keeps the IN endpoint busy: the next loaded block starts before the actor learns the previous one is sent
+ */
+static void handleTransmitDone(void) {
+  USB_STREAM_Export_t *logExport = &exportContext;
+
+  logExport->releasedBlocks = logExport->sentBlocks;
+  transmitNext();
+
+  if (logExport->isActive)
+    osMessageQueuePut(USB_STREAM_Actor.super.osMessageQueueId, &(message_t) {USB_STREAM_TX_DONE}, 0, 0);
+}
+
+static void handlePortChanged(bool isOpen) {
+  isPortOpen = isOpen;
+
+  if (!isOpen) {
+    exportContext.isActive = false;
+    framesContext.isResponsePending = false;
+  }
+
+  osMessageQueuePut(USB_STREAM_Actor.super.osMessageQueueId, &(message_t) {isOpen ? USB_STREAM_PORT_OPENED : USB_STREAM_PORT_CLOSED}, 0, 0);
+}
@@ -0,0 +1,76 @@
+/*!
+ * @file usb_stream.h
+ * @brief USB stream actor: the live measurements frames and the log export over the CDC-ACM port
+ *
+ * The frames share the NFC mailbox protocol header: | CRC8 | CMD | SEQ | Payload Size | Payload |.
+ * The log export answers with the ACK frame of the clamped range followed by the raw log entries, exactly
+ * entriesCount * MEMORY_LOG_ENTRY_SIZE bytes as they are in the NOR Flash, without any framing.
+ *
+ * @date 18/10/2026
+ * @author artempolisskyi
+ */
+
+#ifndef USB_STREAM_H
+#define USB_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+
+#include "cmsis_os2.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "main.h"
+#include "fsm.h"
+#include "crc_service.h"
+#include "memory.h"
+#include "nfc.h"
+#include "log_transfer_pool.h"
+#include "usbd_msc_cdc.h"
+
+#define USB_STREAM_TASK_STACK_SIZE_WORDS (256)
+
+/**
+ * USB stream commands and frames, besides GLOBAL_CMD_EXPORT_LOG. Out of the global commands range, the NFC rejects them.
+ */
+#define USB_STREAM_CMD_SET_LIVE       0xE0 ///< Payload is 1 byte, non-zero turns the live frames on, answered with ACK
+#define USB_STREAM_LIVE_FRAME         0xE1 ///< SEQ is the frames counter, payload is the MEMORY_SensorsMeasurementEntry_t layout
+
+#define USB_STREAM_FRAME_SIZE_MAX     USBD_MSC_CDC_DATA_PACKET_SIZE ///< Command or response in one packet
+
+/**
+ * Log export blocks, read by MEMORY straight into the buffers transmitted by the USB, claimed from the log transfer
+ * pool shared with the NFC export. The block is a multiple of the packet size: a block transfer goes out as
+ * back-to-back full packets.
+ */
+#define USB_STREAM_EXPORT_BLOCK_SIZE    LOG_TRANSFER_POOL_BUFFER_SIZE
+#define USB_STREAM_EXPORT_BUFFERS_COUNT LOG_TRANSFER_POOL_BUFFERS_COUNT ///< Block being transmitted and the prefetched next one
+
+typedef enum {
+  USB_STREAM_NO_STATE = 0,
+  USB_STREAM_IDLE_STATE, ///< Port is closed
+  USB_STREAM_READY_STATE,
+  USB_STREAM_EXPORT_STATE,
+  USB_STREAM_STATE_ERROR,
+  USB_STREAM_MAX_STATE
+} USB_STREAM_State_t;
+
+typedef struct {
+  actor_t super;
+  USB_STREAM_State_t state;
+  bool isLiveOn;
+  uint8_t liveSequence; ///< Counts the frames, the dropped ones too
+} USB_STREAM_Actor_t;
+
+extern USB_STREAM_Actor_t USB_STREAM_Actor;
+
+actor_t* USB_STREAM_TaskInit(void);
+void USB_STREAM_Task(void *argument);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //USB_STREAM_H
@@ -0,0 +1,333 @@
+/*!
+ * @file test_actor_timer.c
+ * @brief Unit tests for the actor timers: the deadline sorted list over the single kernel timer and the stale expiries
+ *
+ * The kernel is modelled here: the tick counter, the one-shot kernel timer fired by advancing the tick and the actors
+ * queues recording the posted timeouts.
+ *
+ * @date 18/10/2026
+ */
+
+#include <string.h>
+
+#include "unity.h"
+#include "actor_timer.h"
+
+#define TEST_QUEUE_SIZE  (16U)
+#define TEST_TIMERS_COUNT (3U)
+
+typedef struct {
+  message_t messages[TEST_QUEUE_SIZE];
+  uint32_t count;
+  uint32_t capacity;
+} TEST_Queue_t;
+
+typedef struct {
+  osTimerFunc_t callback;
+  bool isRunning;
+  uint32_t expiryTick;
+  uint32_t startsCount;
+} TEST_KernelTimer_t;
+
+actor_t* ACTORS_LOOKUP_SystemRegistry[MAX_ACTORS];
+
+static uint32_t tick;
+static TEST_KernelTimer_t kernelTimer;
+static TEST_Queue_t queues[MAX_ACTORS];
+static actor_t actors[MAX_ACTORS];
+static ACTOR_Timer_t timers[TEST_TIMERS_COUNT];
+
+/**
+ * @brief Passes the ticks one by one, the kernel timer fires on its expiry tick as the timer service task would
+ */
+static void advanceTicks(uint32_t ticks) {
+  for (uint32_t i = 0; i < ticks; i++) {
+    tick++;
+
+    if (kernelTimer.isRunning && tick == kernelTimer.expiryTick) {
+      kernelTimer.isRunning = false;
+      kernelTimer.callback(NULL);
+    }
+  }
+}
+
+static message_t takeMessage(ACTOR_ID actorId) {
+  TEST_Queue_t *queue = &queues[actorId];
+  message_t message = queue->messages[0];
+
+  TEST_ASSERT_TRUE(queue->count > 0);
+  memmove(&queue->messages[0], &queue->messages[1], (queue->count - 1) * sizeof(message_t));
+  queue->count--;
+
+  return message;
+}
+
+int32_t osKernelLock(void) {
+  return 0;
+}
+
+int32_t osKernelRestoreLock(int32_t lock) {
+  return lock;
+}
+
+uint32_t osKernelGetTickCount(void) {
+  return tick;
+}
+
+osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout) {
+  (void) msg_prio;
+  (void) timeout;
+  TEST_Queue_t *queue = (TEST_Queue_t *) mq_id;
+
+  if (queue->count == queue->capacity) return osErrorResource;
+
+  queue->messages[queue->count++] = *(const message_t *) msg_ptr;
+
+  return osOK;
+}
+
+osTimerId_t osTimerNew(osTimerFunc_t func, osTimerType_t type, void *argument, const osTimerAttr_t *attr) {
+  (void) type;
+  (void) argument;
+  (void) attr;
+  kernelTimer.callback = func;
+
+  return &kernelTimer;
+}
+
+osStatus_t osTimerStart(osTimerId_t timer_id, uint32_t ticks) {
+  (void) timer_id;
+  kernelTimer.isRunning = true;
+  kernelTimer.expiryTick = tick + ticks;
+  kernelTimer.startsCount++;
+
+  return osOK;
+}
+
+osStatus_t osTimerStop(osTimerId_t timer_id) {
+  (void) timer_id;
+
+  if (!kernelTimer.isRunning) return osErrorResource;
+
+  kernelTimer.isRunning = false;
+
+  return osOK;
+}
+
+void setUp(void) {
+  tick = 0;
+  kernelTimer = (TEST_KernelTimer_t) {0};
+  memset(queues, 0, sizeof(queues));
+
+  for (uint8_t id = 0; id < MAX_ACTORS; id++) {
+    queues[id].capacity = TEST_QUEUE_SIZE;
+    actors[id] = (actor_t) {.actorId = id, .osMessageQueueId = &queues[id]};
+    ACTORS_LOOKUP_SystemRegistry[id] = &actors[id];
+  }
+
+  memset(timers, 0, sizeof(timers));
+  TEST_ASSERT_EQUAL(osOK, ACTOR_TIMER_Init());
+}
+
+void tearDown(void) {
+  // the armed list outlives the test
+  for (uint8_t i = 0; i < TEST_TIMERS_COUNT; i++) ACTOR_TIMER_Stop(&timers[i]);
+}
+
+void test_ActorTimer_TimersArmedOutOfOrder_ExpireInDeadlineOrder(void) {
+  ACTOR_Timer_t *late = &timers[0];
+  ACTOR_Timer_t *early = &timers[1];
+  ACTOR_Timer_t *middle = &timers[2];
+
+  ACTOR_TIMER_StartOneShot(late, NFC_ACTOR_ID, NFC_TAG_STATUS_POLL, 30);
+  ACTOR_TIMER_StartOneShot(early, LIGHT_SENSOR_ACTOR_ID, LIGHT_SENS_CONVERSION_TIMEOUT, 10);
+  ACTOR_TIMER_StartOneShot(middle, TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID, TH_SENS_TIMEOUT, 20);
+
+  // the kernel timer follows the list head
+  TEST_ASSERT_EQUAL_UINT32(10, kernelTimer.expiryTick);
+
+  advanceTicks(10);
+  TEST_ASSERT_EQUAL_UINT32(1, queues[LIGHT_SENSOR_ACTOR_ID].count);
+  TEST_ASSERT_EQUAL_UINT32(0, queues[TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID].count);
+  TEST_ASSERT_EQUAL_UINT32(20, kernelTimer.expiryTick);
+
+  advanceTicks(10);
+  TEST_ASSERT_EQUAL_UINT32(1, queues[TEMPERATURE_HUMIDITY_SENSOR_ACTOR_ID].count);
+  TEST_ASSERT_EQUAL_UINT32(0, queues[NFC_ACTOR_ID].count);
+
+  advanceTicks(10);
+  message_t message = takeMessage(NFC_ACTOR_ID);
+  TEST_ASSERT_EQUAL(NFC_TAG_STATUS_POLL, message.event);
+  TEST_ASSERT_EQUAL_PTR(late, message.payload.ptr);
+  TEST_ASSERT_FALSE(kernelTimer.isRunning);
+  TEST_ASSERT_FALSE(ACTOR_TIMER_IsArmed(late));
+}
+
+void test_ActorTimer_EqualDeadlines_ExpireInArmingOrder(void) {
+  ACTOR_Timer_t *first = &timers[0];
+  ACTOR_Timer_t *second = &timers[1];
+  ACTOR_Timer_t *third = &timers[2];
+
+  ACTOR_TIMER_StartOneShot(first, NFC_ACTOR_ID, NFC_TAG_STATUS_POLL, 5);
+  ACTOR_TIMER_StartOneShot(second, NFC_ACTOR_ID, NFC_LOG_CHUNKS_RETRY, 5);
+  ACTOR_TIMER_StartOneShot(third, NFC_ACTOR_ID, NFC_LOG_CHUNKS_TIMEOUT, 5);
+
+  advanceTicks(5);
+
+  TEST_ASSERT_EQUAL_UINT32(3, queues[NFC_ACTOR_ID].count);
+  TEST_ASSERT_EQUAL(NFC_TAG_STATUS_POLL, takeMessage(NFC_ACTOR_ID).event);
+  TEST_ASSERT_EQUAL(NFC_LOG_CHUNKS_RETRY, takeMessage(NFC_ACTOR_ID).event);
+  TEST_ASSERT_EQUAL(NFC_LOG_CHUNKS_TIMEOUT, takeMessage(NFC_ACTOR_ID).event);
+}
+
+void test_ActorTimer_StopOfNearest_RearmsKernelTimerForNext(void) {
+  ACTOR_Timer_t *nearest = &timers[0];
+  ACTOR_Timer_t *next = &timers[1];
+
+  ACTOR_TIMER_StartOneShot(next, NFC_ACTOR_ID, NFC_LOG_CHUNKS_TIMEOUT, 50);
+  ACTOR_TIMER_StartOneShot(nearest, NFC_ACTOR_ID, NFC_TAG_STATUS_POLL, 10);
+  TEST_ASSERT_EQUAL_UINT32(10, kernelTimer.expiryTick);
+
+  TEST_ASSERT_EQUAL(osOK, ACTOR_TIMER_Stop(nearest));
+  TEST_ASSERT_EQUAL_UINT32(50, kernelTimer.expiryTick);
+
+  TEST_ASSERT_EQUAL(osOK, ACTOR_TIMER_Stop(next));
+  TEST_ASSERT_FALSE(kernelTimer.isRunning);
+
+  advanceTicks(100);
+  TEST_ASSERT_EQUAL_UINT32(0, queues[NFC_ACTOR_ID].count);
+}
+
+void test_ActorTimer_StopOfFartherTimer_KeepsKernelTimer(void) {
+  ACTOR_Timer_t *nearest = &timers[0];
+  ACTOR_Timer_t *farther = &timers[1];
+
+  ACTOR_TIMER_StartOneShot(nearest, NFC_ACTOR_ID, NFC_TAG_STATUS_POLL, 10);
+  ACTOR_TIMER_StartOneShot(farther, NFC_ACTOR_ID, NFC_LOG_CHUNKS_TIMEOUT, 50);
+  const uint32_t startsCount = kernelTimer.startsCount;
+
+  ACTOR_TIMER_Stop(farther);
+
+  TEST_ASSERT_EQUAL_UINT32(startsCount, kernelTimer.startsCount);
+  TEST_ASSERT_EQUAL_UINT32(10, kernelTimer.expiryTick);
+}
+
+void test_ActorTimer_Periodic_ReloadsFromDeadlineNotFromExpiry(void) {
+  ACTOR_Timer_t *periodic = &timers[0];
+
+  ACTOR_TIMER_StartPeriodic(periodic, NFC_ACTOR_ID, NFC_LOG_EXPORT_POLL, 10);
+  advanceTicks(35);
+
+  TEST_ASSERT_EQUAL_UINT32(3, queues[NFC_ACTOR_ID].count);
+  TEST_ASSERT_EQUAL_UINT32(40, periodic->deadline);
+  TEST_ASSERT_TRUE(ACTOR_TIMER_IsArmed(periodic));
+}
+
+void test_ActorTimer_RestartWithQueuedExpiry_ExpiryIsStale(void) {
+  ACTOR_Timer_t *timer = &timers[0];
+
+  ACTOR_TIMER_StartOneShot(timer, NFC_ACTOR_ID, NFC_TAG_STATUS_POLL, 10);
+  advanceTicks(10);
+
+  // the expiry is in the queue, the actor restarts the timer before taking it
+  ACTOR_TIMER_StartOneShot(timer, NFC_ACTOR_ID, NFC_TAG_STATUS_POLL, 10);
+  message_t stale = takeMessage(NFC_ACTOR_ID);
+  TEST_ASSERT_TRUE(ACTOR_TIMER_IsStaleExpiry(timer, &stale));
+
+  advanceTicks(10);
+  message_t fresh = takeMessage(NFC_ACTOR_ID);
+  TEST_ASSERT_FALSE(ACTOR_TIMER_IsStaleExpiry(timer, &fresh));
+}
+
+void test_ActorTimer_StopWithQueuedExpiry_ExpiryIsStale(void) {
+  ACTOR_Timer_t *timer = &timers[0];
+
+  ACTOR_TIMER_StartOneShot(timer, NFC_ACTOR_ID, NFC_TAG_STATUS_POLL, 1);
+  advanceTicks(1);
+  ACTOR_TIMER_Stop(timer);
+
+  message_t message = takeMessage(NFC_ACTOR_ID);
+  TEST_ASSERT_TRUE(ACTOR_TIMER_IsStaleExpiry(timer, &message));
+}
+
+void test_ActorTimer_OtherMessage_IsNotStaleExpiry(void) {
+  ACTOR_Timer_t *timer = &timers[0];
+  message_t message = {.event = NFC_TAG_STATUS_POLL, .payload.value = 0};
+
+  ACTOR_TIMER_StartOneShot(timer, NFC_ACTOR_ID, NFC_TAG_STATUS_POLL, 1);
+  ACTOR_TIMER_Stop(timer);
+
+  TEST_ASSERT_FALSE(ACTOR_TIMER_IsStaleExpiry(timer, &message));
+}
+
+void test_ActorTimer_FullActorQueue_ExpiryNotCounted(void) {
+  ACTOR_Timer_t *timer = &timers[0];
+  queues[NFC_ACTOR_ID].capacity = 0;
+
+  ACTOR_TIMER_StartOneShot(timer, NFC_ACTOR_ID, NFC_TAG_STATUS_POLL, 1);
+  advanceTicks(1);
+
+  TEST_ASSERT_EQUAL_UINT16(0, timer->queuedExpiries);
+
+  // nothing stale is left for the next start
+  queues[NFC_ACTOR_ID].capacity = TEST_QUEUE_SIZE;
+  ACTOR_TIMER_StartOneShot(timer, NFC_ACTOR_ID, NFC_TAG_STATUS_POLL, 1);
+  advanceTicks(1);
+
+  message_t message = takeMessage(NFC_ACTOR_ID);
+  TEST_ASSERT_FALSE(ACTOR_TIMER_IsStaleExpiry(timer, &message));
+}
+
+void test_ActorTimer_TickCounterOverflow_KeepsDeadlineOrder(void) {
+  ACTOR_Timer_t *beforeOverflow = &timers[0];
+  ACTOR_Timer_t *afterOverflow = &timers[1];
+  tick = UINT32_MAX - 5;
+
+  ACTOR_TIMER_StartOneShot(afterOverflow, NFC_ACTOR_ID, NFC_LOG_CHUNKS_TIMEOUT, 10);
+  ACTOR_TIMER_StartOneShot(beforeOverflow, NFC_ACTOR_ID, NFC_TAG_STATUS_POLL, 3);
+
+  advanceTicks(3);
+  TEST_ASSERT_EQUAL_UINT32(1, queues[NFC_ACTOR_ID].count);
+  TEST_ASSERT_EQUAL(NFC_TAG_STATUS_POLL, takeMessage(NFC_ACTOR_ID).event);
+
+  advanceTicks(7);
+  TEST_ASSERT_EQUAL(NFC_LOG_CHUNKS_TIMEOUT, takeMessage(NFC_ACTOR_ID).event);
+}
+
+void test_ActorTimer_ZeroTimeout_ExpiresOnNextTick(void) {
+  ACTOR_Timer_t *timer = &timers[0];
+
+  ACTOR_TIMER_StartOneShot(timer, NFC_ACTOR_ID, NFC_TAG_STATUS_POLL, 0);
+  TEST_ASSERT_EQUAL_UINT32(0, queues[NFC_ACTOR_ID].count);
+
+  advanceTicks(1);
+  TEST_ASSERT_EQUAL_UINT32(1, queues[NFC_ACTOR_ID].count);
+}
+
+void test_ActorTimer_InvalidParameters_Rejected(void) {
+  ACTOR_Timer_t *timer = &timers[0];
+
+  TEST_ASSERT_EQUAL(osErrorParameter, ACTOR_TIMER_StartOneShot(NULL, NFC_ACTOR_ID, NFC_TAG_STATUS_POLL, 1));
+  TEST_ASSERT_EQUAL(osErrorParameter, ACTOR_TIMER_StartOneShot(timer, MAX_ACTORS, NFC_TAG_STATUS_POLL, 1));
+  TEST_ASSERT_EQUAL(osErrorParameter, ACTOR_TIMER_Stop(NULL));
+  TEST_ASSERT_FALSE(ACTOR_TIMER_IsArmed(timer));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_ActorTimer_TimersArmedOutOfOrder_ExpireInDeadlineOrder);
+  RUN_TEST(test_ActorTimer_EqualDeadlines_ExpireInArmingOrder);
+  RUN_TEST(test_ActorTimer_StopOfNearest_RearmsKernelTimerForNext);
+  RUN_TEST(test_ActorTimer_StopOfFartherTimer_KeepsKernelTimer);
+  RUN_TEST(test_ActorTimer_Periodic_ReloadsFromDeadlineNotFromExpiry);
+  RUN_TEST(test_ActorTimer_RestartWithQueuedExpiry_ExpiryIsStale);
+  RUN_TEST(test_ActorTimer_StopWithQueuedExpiry_ExpiryIsStale);
+  RUN_TEST(test_ActorTimer_OtherMessage_IsNotStaleExpiry);
+  RUN_TEST(test_ActorTimer_FullActorQueue_ExpiryNotCounted);
+  RUN_TEST(test_ActorTimer_TickCounterOverflow_KeepsDeadlineOrder);
+  RUN_TEST(test_ActorTimer_ZeroTimeout_ExpiresOnNextTick);
+  RUN_TEST(test_ActorTimer_InvalidParameters_Rejected);
+
+  return UNITY_END();
+}
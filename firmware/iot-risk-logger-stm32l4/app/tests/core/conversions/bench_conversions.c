@@ -0,0 +1,62 @@
+/*!
+ * @file bench_conversions.c
+ * @brief Host benchmark of the batch conversions, built with -O3 to check they vectorize
+ *
+ * Prints the time per sample and, on x86, the TSC cycles per sample of every batch.
+ *
+ * @date 18/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "conversions.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYCLES() __rdtsc()
+#else
+#define BENCH_CYCLES() 0ULL
+#endif
+
+#define BENCH_SAMPLES (4096)
+#define BENCH_ITERATIONS (2000)
+
+static uint16_t raw[BENCH_SAMPLES];
+static int16_t centiCelsius[BENCH_SAMPLES];
+static uint16_t centiRH[BENCH_SAMPLES];
+static uint32_t centiLux[BENCH_SAMPLES];
+static int16_t milliG[BENCH_SAMPLES];
+
+#define BENCH_RUN(name, call, output) do {                                                          \
+    struct timespec start, end;                                                                     \
+    volatile uint32_t sink = 0;                                                                     \
+    clock_gettime(CLOCK_MONOTONIC, &start);                                                         \
+    unsigned long long startCycles = BENCH_CYCLES();                                                \
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {                                               \
+      call;                                                                                         \
+      sink += (uint32_t) output[i % BENCH_SAMPLES];                                                 \
+    }                                                                                               \
+    unsigned long long cycles = BENCH_CYCLES() - startCycles;                                       \
+    clock_gettime(CLOCK_MONOTONIC, &end);                                                           \
+    double nanoseconds = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);         \
+    printf("%-12s %.3f ns, %.3f cycles per sample\n", name,                                         \
+           nanoseconds / BENCH_ITERATIONS / BENCH_SAMPLES,                                          \
+           (double) cycles / BENCH_ITERATIONS / BENCH_SAMPLES);                                     \
+    (void) sink;                                                                                    \
+  } while (0)
+
+int main(void) {
+  srand(1);
+  for (uint16_t i = 0; i < BENCH_SAMPLES; i++) {
+    raw[i] = (uint16_t) rand();
+  }
+
+  BENCH_RUN("temperature", CONVERT_SHT3xRawToCentiCelsiusBatch(raw, centiCelsius, BENCH_SAMPLES), centiCelsius);
+  BENCH_RUN("humidity", CONVERT_SHT3xRawToCentiRHBatch(raw, centiRH, BENCH_SAMPLES), centiRH);
+  BENCH_RUN("lux", CONVERT_OPT3001RawToCentiLuxBatch(raw, centiLux, BENCH_SAMPLES), centiLux);
+  BENCH_RUN("acceleration", CONVERT_LIS2DW12RawToMilliGBatch((const int16_t *) raw, milliG, BENCH_SAMPLES, 2), milliG);
+
+  return 0;
+}
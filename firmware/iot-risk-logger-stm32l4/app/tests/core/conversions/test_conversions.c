@@ -0,0 +1,110 @@
+/*!
+ * @file test_conversions.c
+ * @brief Unit tests for the integer conversions, checked exhaustively against the floating-point datasheet formulas
+ *
+ * @date 18/10/2026
+ */
+
+#include <math.h>
+
+#include "unity.h"
+#include "conversions.h"
+
+#define TEST_RAW_VALUES (65536UL)
+#define TEST_BATCH_SIZE (97) // odd, exercises the scalar tail of the paired batch
+
+static const uint8_t fullScales[] = {2, 4, 8, 16};
+
+static uint16_t rawValues[TEST_BATCH_SIZE];
+static int16_t rawAccelerations[TEST_BATCH_SIZE];
+
+void setUp(void) {
+  for (uint16_t i = 0; i < TEST_BATCH_SIZE; i++) {
+    rawValues[i] = (uint16_t) (i * 677U + 13U);
+    rawAccelerations[i] = (int16_t) rawValues[i];
+  }
+}
+
+void tearDown(void) {}
+
+static int32_t roundHalfUp(double value) {
+  return (int32_t) floor(value + 0.5);
+}
+
+void test_Conversions_SHT3xTemperature_MatchesDatasheetFormula(void) {
+  for (uint32_t raw = 0; raw < TEST_RAW_VALUES; raw++) {
+    int32_t expected = roundHalfUp(100.0 * (-45.0 + 175.0 * raw / 65535.0));
+
+    TEST_ASSERT_EQUAL_INT16(expected, CONVERT_SHT3xRawToCentiCelsius((uint16_t) raw));
+  }
+  TEST_ASSERT_EQUAL_INT16(-4500, CONVERT_SHT3xRawToCentiCelsius(0));
+  TEST_ASSERT_EQUAL_INT16(13000, CONVERT_SHT3xRawToCentiCelsius(UINT16_MAX));
+}
+
+void test_Conversions_SHT3xHumidity_MatchesDatasheetFormula(void) {
+  for (uint32_t raw = 0; raw < TEST_RAW_VALUES; raw++) {
+    int32_t expected = roundHalfUp(100.0 * (100.0 * raw / 65535.0));
+
+    TEST_ASSERT_EQUAL_UINT16(expected, CONVERT_SHT3xRawToCentiRH((uint16_t) raw));
+  }
+  TEST_ASSERT_EQUAL_UINT16(10000, CONVERT_SHT3xRawToCentiRH(UINT16_MAX));
+}
+
+void test_Conversions_OPT3001Lux_MatchesDatasheetFormula(void) {
+  for (uint32_t raw = 0; raw < TEST_RAW_VALUES; raw++) {
+    double lux = 0.01 * ldexp(raw & 0x0FFF, (int) (raw >> 12));
+
+    TEST_ASSERT_EQUAL_UINT32((uint32_t) llround(lux * 100.0), CONVERT_OPT3001RawToCentiLux((uint16_t) raw));
+  }
+}
+
+void test_Conversions_LIS2DW12Acceleration_MatchesDatasheetFormula(void) {
+  for (uint8_t scale = 0; scale < sizeof(fullScales); scale++) {
+    for (int32_t raw = INT16_MIN; raw <= INT16_MAX; raw++) {
+      int32_t expected = roundHalfUp(raw * (fullScales[scale] * 1000.0) / 32768.0);
+
+      TEST_ASSERT_EQUAL_INT16(expected, CONVERT_LIS2DW12RawToMilliG((int16_t) raw, fullScales[scale]));
+    }
+  }
+}
+
+void test_Conversions_CompileTimeMacros_RoundTrip(void) {
+  TEST_ASSERT_EQUAL_INT16(200, CONVERT_SHT3xRawToCentiCelsius(CONVERT_CENTI_CELSIUS_TO_SHT3x_RAW(200)));
+  TEST_ASSERT_EQUAL_INT16(-4000, CONVERT_SHT3xRawToCentiCelsius(CONVERT_CENTI_CELSIUS_TO_SHT3x_RAW(-4000)));
+  TEST_ASSERT_EQUAL_UINT16(187, CONVERT_CENTI_CELSIUS_DELTA_TO_SHT3x_RAW(50));
+  TEST_ASSERT_EQUAL_UINT16(1311, CONVERT_CENTI_RH_DELTA_TO_SHT3x_RAW(200));
+  TEST_ASSERT_EQUAL_UINT16(2048, CONVERT_MILLI_G_DELTA_TO_LIS2DW12_RAW(125, 2));
+  TEST_ASSERT_EQUAL_INT16(125, CONVERT_LIS2DW12RawToMilliG(CONVERT_MILLI_G_DELTA_TO_LIS2DW12_RAW(125, 2), 2));
+}
+
+void test_Conversions_Batches_MatchScalar(void) {
+  int16_t centiCelsius[TEST_BATCH_SIZE];
+  uint16_t centiRH[TEST_BATCH_SIZE];
+  uint32_t centiLux[TEST_BATCH_SIZE];
+  int16_t milliG[TEST_BATCH_SIZE];
+
+  CONVERT_SHT3xRawToCentiCelsiusBatch(rawValues, centiCelsius, TEST_BATCH_SIZE);
+  CONVERT_SHT3xRawToCentiRHBatch(rawValues, centiRH, TEST_BATCH_SIZE);
+  CONVERT_OPT3001RawToCentiLuxBatch(rawValues, centiLux, TEST_BATCH_SIZE);
+  CONVERT_LIS2DW12RawToMilliGBatch(rawAccelerations, milliG, TEST_BATCH_SIZE, 4);
+
+  for (uint16_t i = 0; i < TEST_BATCH_SIZE; i++) {
+    TEST_ASSERT_EQUAL_INT16(CONVERT_SHT3xRawToCentiCelsius(rawValues[i]), centiCelsius[i]);
+    TEST_ASSERT_EQUAL_UINT16(CONVERT_SHT3xRawToCentiRH(rawValues[i]), centiRH[i]);
+    TEST_ASSERT_EQUAL_UINT32(CONVERT_OPT3001RawToCentiLux(rawValues[i]), centiLux[i]);
+    TEST_ASSERT_EQUAL_INT16(CONVERT_LIS2DW12RawToMilliG(rawAccelerations[i], 4), milliG[i]);
+  }
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_Conversions_SHT3xTemperature_MatchesDatasheetFormula);
+  RUN_TEST(test_Conversions_SHT3xHumidity_MatchesDatasheetFormula);
+  RUN_TEST(test_Conversions_OPT3001Lux_MatchesDatasheetFormula);
+  RUN_TEST(test_Conversions_LIS2DW12Acceleration_MatchesDatasheetFormula);
+  RUN_TEST(test_Conversions_CompileTimeMacros_RoundTrip);
+  RUN_TEST(test_Conversions_Batches_MatchScalar);
+
+  return UNITY_END();
+}
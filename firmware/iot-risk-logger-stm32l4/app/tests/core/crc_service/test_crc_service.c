@@ -0,0 +1,124 @@
+/*!
+ * @file test_crc_service.c
+ * @brief Unit tests for the software fallback of the CRC service, checked against the catalogue check values
+ *
+ * @date 18/10/2026
+ */
+
+#include <stdlib.h>
+
+#include "unity.h"
+#include "crc_service.h"
+
+#define TEST_BLOCK_SIZE (4096)
+
+static const uint8_t checkInput[] = "123456789";
+static uint8_t block[TEST_BLOCK_SIZE];
+
+void setUp(void) {
+  srand(7);
+  for (uint16_t i = 0; i < TEST_BLOCK_SIZE; i++) {
+    block[i] = (uint8_t) rand();
+  }
+}
+
+void tearDown(void) {}
+
+/** @brief Bitwise reference of CRC-32/ISO-HDLC */
+static uint32_t referenceCrc32(const uint8_t *data, uint32_t length) {
+  uint32_t crc = 0xFFFFFFFF;
+
+  while (length--) {
+    crc ^= *data++;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 1) ? ((crc >> 1) ^ 0xEDB88320UL) : (crc >> 1);
+    }
+  }
+
+  return crc ^ 0xFFFFFFFF;
+}
+
+void test_CrcService_Crc8_CheckValue(void) {
+  TEST_ASSERT_EQUAL_HEX8(0xF7, CRC_SERVICE_Crc8(checkInput, 9));
+}
+
+void test_CrcService_Crc8_SHT3xDatasheetExample(void) {
+  const uint8_t word[] = {0xBE, 0xEF};
+
+  TEST_ASSERT_EQUAL_HEX8(0x92, CRC_SERVICE_Crc8(word, sizeof(word)));
+}
+
+void test_CrcService_Crc8_MailboxResponses(void) {
+  const uint8_t ack[] = {0x00, 0x00};
+  const uint8_t crcNack[] = {0xFE, 0x00};
+
+  TEST_ASSERT_EQUAL_HEX8(0x81, CRC_SERVICE_Crc8(ack, sizeof(ack)));
+  TEST_ASSERT_EQUAL_HEX8(0xF4, CRC_SERVICE_Crc8(crcNack, sizeof(crcNack)));
+}
+
+void test_CrcService_Crc8_EmptyData_InitValue(void) {
+  TEST_ASSERT_EQUAL_HEX8(CRC_SERVICE_CRC8_INIT, CRC_SERVICE_Crc8(checkInput, 0));
+}
+
+void test_CrcService_Crc32_CheckValue(void) {
+  TEST_ASSERT_EQUAL_HEX32(0xCBF43926, CRC_SERVICE_Crc32(checkInput, 9));
+  TEST_ASSERT_EQUAL_HEX32(0, CRC_SERVICE_Crc32(checkInput, 0));
+}
+
+void test_CrcService_Crc32_Block_MatchesBitwiseReference(void) {
+  for (uint16_t length = 0; length < 16; length++) {
+    TEST_ASSERT_EQUAL_HEX32(referenceCrc32(block, length), CRC_SERVICE_Crc32(block, length));
+  }
+  TEST_ASSERT_EQUAL_HEX32(referenceCrc32(block, TEST_BLOCK_SIZE), CRC_SERVICE_Crc32(block, TEST_BLOCK_SIZE));
+}
+
+void test_CrcService_Crc32Update_SplitEqualsWhole(void) {
+  const uint32_t whole = CRC_SERVICE_Crc32(block, TEST_BLOCK_SIZE);
+
+  for (uint16_t split = 0; split <= TEST_BLOCK_SIZE; split += 1021) {
+    uint32_t crc = CRC_SERVICE_Crc32Update(0, block, split);
+    crc = CRC_SERVICE_Crc32Update(crc, block + split, TEST_BLOCK_SIZE - split);
+
+    TEST_ASSERT_EQUAL_HEX32(whole, crc);
+  }
+}
+
+void test_CrcService_Crc32Mpeg2_CheckValue(void) {
+  TEST_ASSERT_EQUAL_HEX32(0x0376E6E7, CRC_SERVICE_Crc32Mpeg2Update(CRC_SERVICE_CRC32_INIT, checkInput, 9));
+}
+
+void test_CrcService_Crc32Mpeg2Update_SplitEqualsWhole(void) {
+  const uint32_t whole = CRC_SERVICE_Crc32Mpeg2Update(CRC_SERVICE_CRC32_INIT, block, TEST_BLOCK_SIZE);
+
+  for (uint16_t split = 0; split <= TEST_BLOCK_SIZE; split += 1021) {
+    uint32_t crc = CRC_SERVICE_Crc32Mpeg2Update(CRC_SERVICE_CRC32_INIT, block, split);
+    crc = CRC_SERVICE_Crc32Mpeg2Update(crc, block + split, TEST_BLOCK_SIZE - split);
+
+    TEST_ASSERT_EQUAL_HEX32(whole, crc);
+  }
+}
+
+void test_CrcService_Crc32_DetectsSingleBitFlip(void) {
+  const uint32_t crc = CRC_SERVICE_Crc32(block, TEST_BLOCK_SIZE);
+
+  block[TEST_BLOCK_SIZE / 2] ^= 0x10;
+
+  TEST_ASSERT_NOT_EQUAL(crc, CRC_SERVICE_Crc32(block, TEST_BLOCK_SIZE));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_CrcService_Crc8_CheckValue);
+  RUN_TEST(test_CrcService_Crc8_SHT3xDatasheetExample);
+  RUN_TEST(test_CrcService_Crc8_MailboxResponses);
+  RUN_TEST(test_CrcService_Crc8_EmptyData_InitValue);
+  RUN_TEST(test_CrcService_Crc32_CheckValue);
+  RUN_TEST(test_CrcService_Crc32_Block_MatchesBitwiseReference);
+  RUN_TEST(test_CrcService_Crc32Update_SplitEqualsWhole);
+  RUN_TEST(test_CrcService_Crc32Mpeg2_CheckValue);
+  RUN_TEST(test_CrcService_Crc32Mpeg2Update_SplitEqualsWhole);
+  RUN_TEST(test_CrcService_Crc32_DetectsSingleBitFlip);
+
+  return UNITY_END();
+}
@@ -0,0 +1,66 @@
+/*!
+ * @file test_fs_static.c
+ * @brief Unit tests for the NOR Flash layout: the log file end bound checked by the MEMORY appends
+ *
+ * @date 18/10/2026
+ */
+
+#include "unity.h"
+#include "fs_static.h"
+
+#define TEST_LOG_ENTRY_SIZE (22) ///< MEMORY_LOG_ENTRY_SIZE, memory.h needs the HAL
+
+/** @brief Tail of the last entry which still fits, as the entries are appended from the log start */
+static uint32_t lastEntryAddress(void) {
+  return INITIAL_LOG_START_ADDR + ((LOG_END_ADDR - INITIAL_LOG_START_ADDR) / TEST_LOG_ENTRY_SIZE - 1) * TEST_LOG_ENTRY_SIZE;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_FsStatic_Layout_AreasDontOverlap(void) {
+  TEST_ASSERT_LESS_THAN_UINT32(LOG_END_ADDR, INITIAL_LOG_START_ADDR);
+  TEST_ASSERT_EQUAL_UINT32(SHOCK_CAPTURES_AREA_ADDR, LOG_END_ADDR);
+  TEST_ASSERT_EQUAL_UINT32(EVENT_RECORDER_AREA_ADDR, SHOCK_CAPTURES_AREA_ADDR + SHOCK_CAPTURES_AREA_SIZE);
+}
+
+void test_FsStatic_LogHasSpace_FirstEntry(void) {
+  TEST_ASSERT_TRUE(LOG_HAS_SPACE_FOR(INITIAL_LOG_START_ADDR, TEST_LOG_ENTRY_SIZE));
+}
+
+void test_FsStatic_LogHasSpace_LastEntryFits(void) {
+  TEST_ASSERT_TRUE(LOG_HAS_SPACE_FOR(lastEntryAddress(), TEST_LOG_ENTRY_SIZE));
+}
+
+void test_FsStatic_LogHasSpace_EntryAfterTheLastOneRejected(void) {
+  const uint32_t tail = lastEntryAddress() + TEST_LOG_ENTRY_SIZE;
+
+  TEST_ASSERT_GREATER_THAN_UINT32(LOG_END_ADDR, tail + TEST_LOG_ENTRY_SIZE);
+  TEST_ASSERT_FALSE(LOG_HAS_SPACE_FOR(tail, TEST_LOG_ENTRY_SIZE));
+}
+
+void test_FsStatic_LogHasSpace_EntryEndingAtTheLogEnd(void) {
+  TEST_ASSERT_TRUE(LOG_HAS_SPACE_FOR(LOG_END_ADDR - TEST_LOG_ENTRY_SIZE, TEST_LOG_ENTRY_SIZE));
+  TEST_ASSERT_FALSE(LOG_HAS_SPACE_FOR(LOG_END_ADDR - TEST_LOG_ENTRY_SIZE + 1, TEST_LOG_ENTRY_SIZE));
+}
+
+void test_FsStatic_LogHasSpace_TailInTheShockCapturesArea_Rejected(void) {
+  // the free space scan on boot stops past the log end when the log is full
+  TEST_ASSERT_FALSE(LOG_HAS_SPACE_FOR(LOG_END_ADDR, TEST_LOG_ENTRY_SIZE));
+  TEST_ASSERT_FALSE(LOG_HAS_SPACE_FOR(SHOCK_CAPTURES_AREA_ADDR + SHOCK_CAPTURES_SLOT_SIZE, TEST_LOG_ENTRY_SIZE));
+  TEST_ASSERT_FALSE(LOG_HAS_SPACE_FOR(EVENT_RECORDER_AREA_ADDR, TEST_LOG_ENTRY_SIZE));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_FsStatic_Layout_AreasDontOverlap);
+  RUN_TEST(test_FsStatic_LogHasSpace_FirstEntry);
+  RUN_TEST(test_FsStatic_LogHasSpace_LastEntryFits);
+  RUN_TEST(test_FsStatic_LogHasSpace_EntryAfterTheLastOneRejected);
+  RUN_TEST(test_FsStatic_LogHasSpace_EntryEndingAtTheLogEnd);
+  RUN_TEST(test_FsStatic_LogHasSpace_TailInTheShockCapturesArea_Rejected);
+
+  return UNITY_END();
+}
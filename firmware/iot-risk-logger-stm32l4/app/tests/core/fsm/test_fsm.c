@@ -0,0 +1,126 @@
+/*!
+ * @file test_fsm.c
+ * @brief Unit tests for the table-driven FSM engine
+ *
+ * @date 18/10/2026
+ */
+
+#include "unity.h"
+#include "fsm.h"
+
+typedef enum {
+  TEST_NO_STATE = 0,
+  TEST_IDLE_STATE,
+  TEST_RUN_STATE,
+} TEST_State_t;
+
+typedef struct {
+  actor_t super;
+  uint32_t actionsCalls;
+  uint32_t unhandledCalls;
+  osStatus_t actionResult;
+} TEST_Actor_t;
+
+static TEST_Actor_t testActor;
+
+static osStatus_t countingAction(TEST_Actor_t *this, message_t *message) {
+  (void) message;
+  this->actionsCalls++;
+
+  return this->actionResult;
+}
+
+static osStatus_t reportUnhandled(TEST_Actor_t *this, message_t *message) {
+  (void) message;
+  this->unhandledCalls++;
+
+  return osError;
+}
+
+static const FSM_Transition_t testTransitions[] = {
+  FSM_TRANSITION(TEST_NO_STATE,   GLOBAL_CMD_INITIALIZE,                countingAction, TEST_IDLE_STATE),
+  FSM_TRANSITION(TEST_IDLE_STATE, GLOBAL_CMD_START_CONTINUOUS_SENSING,  countingAction, TEST_RUN_STATE),
+  FSM_TRANSITION(TEST_RUN_STATE,  GLOBAL_WAKE_N_READ,                   countingAction, TEST_RUN_STATE),
+  FSM_TRANSITION(TEST_RUN_STATE,  GLOBAL_CMD_TURN_OFF,                  FSM_NO_ACTION,  TEST_IDLE_STATE),
+};
+
+static const FSM_Table_t testTable = FSM_TABLE(testTransitions, NULL);
+static const FSM_Table_t strictTestTable = FSM_TABLE(testTransitions, reportUnhandled);
+
+void setUp(void) {
+  testActor = (TEST_Actor_t) {.super = {.actorId = NO_ACTOR_ID}, .actionResult = osOK};
+}
+
+void tearDown(void) {}
+
+void test_FSM_FindTransition_ReturnsRowForStateAndEvent(void) {
+  const FSM_Transition_t *transition = FSM_FindTransition(&testTable, TEST_RUN_STATE, GLOBAL_CMD_TURN_OFF);
+
+  TEST_ASSERT_EQUAL_PTR(&testTransitions[3], transition);
+}
+
+void test_FSM_FindTransition_ReturnsNullForEventHandledInOtherState(void) {
+  TEST_ASSERT_NULL(FSM_FindTransition(&testTable, TEST_IDLE_STATE, GLOBAL_WAKE_N_READ));
+}
+
+void test_FSM_Dispatch_RunsActionAndSwitchesState(void) {
+  uint8_t state = TEST_NO_STATE;
+
+  osStatus_t status = FSM_Dispatch(&testTable, &testActor.super, &(message_t){.event = GLOBAL_CMD_INITIALIZE}, &state);
+
+  TEST_ASSERT_EQUAL(osOK, status);
+  TEST_ASSERT_EQUAL(TEST_IDLE_STATE, state);
+  TEST_ASSERT_EQUAL_UINT32(1, testActor.actionsCalls);
+}
+
+void test_FSM_Dispatch_KeepsStateOnActionError(void) {
+  uint8_t state = TEST_IDLE_STATE;
+  testActor.actionResult = osErrorTimeout;
+
+  osStatus_t status = FSM_Dispatch(&testTable, &testActor.super, &(message_t){.event = GLOBAL_CMD_START_CONTINUOUS_SENSING}, &state);
+
+  TEST_ASSERT_EQUAL(osErrorTimeout, status);
+  TEST_ASSERT_EQUAL(TEST_IDLE_STATE, state);
+}
+
+void test_FSM_Dispatch_SwitchesStateWithoutAction(void) {
+  uint8_t state = TEST_RUN_STATE;
+
+  osStatus_t status = FSM_Dispatch(&testTable, &testActor.super, &(message_t){.event = GLOBAL_CMD_TURN_OFF}, &state);
+
+  TEST_ASSERT_EQUAL(osOK, status);
+  TEST_ASSERT_EQUAL(TEST_IDLE_STATE, state);
+  TEST_ASSERT_EQUAL_UINT32(0, testActor.actionsCalls);
+}
+
+void test_FSM_Dispatch_IgnoresUnhandledEvent(void) {
+  uint8_t state = TEST_IDLE_STATE;
+
+  osStatus_t status = FSM_Dispatch(&testTable, &testActor.super, &(message_t){.event = GLOBAL_WAKE_N_READ}, &state);
+
+  TEST_ASSERT_EQUAL(osOK, status);
+  TEST_ASSERT_EQUAL(TEST_IDLE_STATE, state);
+  TEST_ASSERT_EQUAL_UINT32(0, testActor.actionsCalls);
+}
+
+void test_FSM_Dispatch_ReportsUnhandledEvent(void) {
+  uint8_t state = TEST_IDLE_STATE;
+
+  osStatus_t status = FSM_Dispatch(&strictTestTable, &testActor.super, &(message_t){.event = GLOBAL_WAKE_N_READ}, &state);
+
+  TEST_ASSERT_EQUAL(osError, status);
+  TEST_ASSERT_EQUAL(TEST_IDLE_STATE, state);
+  TEST_ASSERT_EQUAL_UINT32(1, testActor.unhandledCalls);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_FSM_FindTransition_ReturnsRowForStateAndEvent);
+  RUN_TEST(test_FSM_FindTransition_ReturnsNullForEventHandledInOtherState);
+  RUN_TEST(test_FSM_Dispatch_RunsActionAndSwitchesState);
+  RUN_TEST(test_FSM_Dispatch_KeepsStateOnActionError);
+  RUN_TEST(test_FSM_Dispatch_SwitchesStateWithoutAction);
+  RUN_TEST(test_FSM_Dispatch_IgnoresUnhandledEvent);
+  RUN_TEST(test_FSM_Dispatch_ReportsUnhandledEvent);
+  return UNITY_END();
+}
@@ -0,0 +1,131 @@
+/*!
+ * @file bench_log_codec.c
+ * @brief Host benchmark of the log codec over the reefer trace, encoded in mailbox frames as the NFC stream does
+ *
+ * Prints the compression ratio, the time and, on x86, the TSC cycles per raw byte, and the encoder budget: the RF
+ * time saved per raw byte in the 48MHz core cycles. The encoder pays off while it takes fewer cycles per byte than
+ * the budget. On the target the cycles of every frame are traced by the NFC actor (DWT cycle counter).
+ *
+ * RF time of a byte is taken at the ISO 15693 high data rate (26.48 kbit/s) the mailbox is read at.
+ *
+ * @date 18/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "log_codec.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYCLES() __rdtsc()
+#else
+#define BENCH_CYCLES() 0ULL
+#endif
+
+#ifndef LOG_CODEC_TRACES_DIR
+#define LOG_CODEC_TRACES_DIR "core/log_policy/traces"
+#endif
+
+#define BENCH_MAX_RECORDS (1024)
+#define BENCH_ITERATIONS (2000)
+#define BENCH_FRAME_PAYLOAD_SIZE (252)
+#define BENCH_RF_BITS_PER_SECOND (26480.0)
+#define BENCH_CORE_HZ (48e6)
+
+static uint8_t records[BENCH_MAX_RECORDS * LOG_CODEC_RECORD_SIZE];
+static uint8_t frame[BENCH_FRAME_PAYLOAD_SIZE];
+
+static uint32_t loadTrace(const char *name) {
+  char path[256];
+  char line[256];
+  uint32_t count = 0;
+
+  snprintf(path, sizeof(path), "%s/%s", LOG_CODEC_TRACES_DIR, name);
+  FILE *file = fopen(path, "r");
+  if (file == NULL) return 0;
+
+  while (fgets(line, sizeof(line), file) != NULL && count < BENCH_MAX_RECORDS) {
+    long timestamp;
+    unsigned temperature, humidity, lux, rms, magnitude;
+    int x, y, z;
+
+    if (line[0] == '#') continue;
+    if (sscanf(line, "%ld,%u,%u,%u,%d,%d,%d,%u,%u", &timestamp, &temperature, &humidity, &lux, &x, &y, &z, &rms, &magnitude) != 9) continue;
+
+    // MEMORY_SensorsMeasurementEntry_t, little-endian
+    const uint16_t words[LOG_CODEC_WORDS_COUNT] = {
+      (uint16_t) timestamp, (uint16_t) ((uint32_t) timestamp >> 16), (uint16_t) temperature, (uint16_t) humidity,
+      (uint16_t) lux, (uint16_t) x, (uint16_t) y, (uint16_t) z, (uint16_t) rms, (uint16_t) magnitude, 0
+    };
+    uint8_t *record = &records[count++ * LOG_CODEC_RECORD_SIZE];
+
+    for (uint8_t i = 0; i < LOG_CODEC_WORDS_COUNT; i++) {
+      record[2 * i] = (uint8_t) words[i];
+      record[2 * i + 1] = (uint8_t) (words[i] >> 8);
+    }
+  }
+
+  fclose(file);
+
+  return count;
+}
+
+/**
+ * @return Encoded stream size of the trace
+ */
+static uint32_t encodeInFrames(uint32_t recordsCount, volatile uint32_t *sink) {
+  LOG_CODEC_State_t state;
+  uint32_t encodedCount = 0;
+  uint32_t streamSize = 0;
+
+  LOG_CODEC_Init(&state);
+
+  while (encodedCount < recordsCount) {
+    uint32_t length;
+
+    encodedCount += LOG_CODEC_Encode(&state, &records[encodedCount * LOG_CODEC_RECORD_SIZE], recordsCount - encodedCount,
+                                     frame, sizeof(frame), &length);
+    streamSize += length;
+    *sink += frame[0];
+  }
+
+  return streamSize;
+}
+
+int main(void) {
+  volatile uint32_t sink = 0;
+  struct timespec start, end;
+  const uint32_t recordsCount = loadTrace("reefer_door_unloading.csv");
+
+  if (recordsCount == 0) {
+    fprintf(stderr, "trace not found in %s\n", LOG_CODEC_TRACES_DIR);
+    return 1;
+  }
+
+  const uint32_t rawSize = recordsCount * LOG_CODEC_RECORD_SIZE;
+  const uint32_t streamSize = encodeInFrames(recordsCount, &sink);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  unsigned long long startCycles = BENCH_CYCLES();
+
+  for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+    encodeInFrames(recordsCount, &sink);
+  }
+
+  unsigned long long cycles = BENCH_CYCLES() - startCycles;
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  const double nanoseconds = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+  const double rawBytes = (double) rawSize * BENCH_ITERATIONS;
+  const double ratio = (double) streamSize / rawSize;
+  const double savedRfSecondsPerByte = (1.0 - ratio) * 8.0 / BENCH_RF_BITS_PER_SECOND;
+
+  printf("log codec, %u entries: %u -> %u bytes (%.2f), %.2f ns, %.2f cycles per raw byte\n",
+         recordsCount, rawSize, streamSize, ratio, nanoseconds / rawBytes, cycles / rawBytes);
+  printf("RF time saved: %.1f ms per raw KB, encoder budget %.0f core cycles per raw byte\n",
+         savedRfSecondsPerByte * 1024.0 * 1e3, savedRfSecondsPerByte * BENCH_CORE_HZ);
+
+  return (sink == 0);
+}
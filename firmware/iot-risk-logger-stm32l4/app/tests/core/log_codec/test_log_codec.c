@@ -0,0 +1,199 @@
+/*!
+ * @file test_log_codec.c
+ * @brief Unit tests for the log entries codec: chunked round trips of the reefer trace, worst case and runs
+ *
+ * @date 18/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "log_codec.h"
+
+#ifndef LOG_CODEC_TRACES_DIR
+#define LOG_CODEC_TRACES_DIR "core/log_policy/traces"
+#endif
+
+#define TEST_MAX_RECORDS (1024)
+#define TEST_CHUNK_SIZE  (252) // mailbox frame payload
+
+/**
+ * @brief MEMORY_SensorsMeasurementEntry_t layout
+ */
+typedef struct __attribute__((packed)) {
+  int32_t timestamp;
+  uint16_t rawTemperature;
+  uint16_t rawHumidity;
+  uint16_t rawLux;
+  int16_t accel[3];
+  uint8_t vibration[4];
+  uint16_t suppressedCount;
+} TestEntry_t;
+
+_Static_assert(sizeof(TestEntry_t) == LOG_CODEC_RECORD_SIZE, "test entry size mismatch");
+
+typedef struct {
+  uint8_t *records;
+  uint32_t count;
+} TestSink_t;
+
+static TestEntry_t records[TEST_MAX_RECORDS];
+static uint8_t decoded[TEST_MAX_RECORDS * LOG_CODEC_RECORD_SIZE];
+static uint8_t stream[TEST_MAX_RECORDS * LOG_CODEC_MAX_RECORD_SIZE];
+static LOG_CODEC_State_t encoder;
+static LOG_CODEC_State_t decoder;
+static TestSink_t sink;
+
+void setUp(void) {
+  LOG_CODEC_Init(&encoder);
+  LOG_CODEC_Init(&decoder);
+  sink = (TestSink_t) {.records = decoded, .count = 0};
+  memset(decoded, 0, sizeof(decoded));
+}
+
+void tearDown(void) {}
+
+static void collectRecord(const uint8_t record[LOG_CODEC_RECORD_SIZE], void *context) {
+  TestSink_t *testSink = (TestSink_t *) context;
+
+  TEST_ASSERT_LESS_THAN_UINT32(TEST_MAX_RECORDS, testSink->count);
+  memcpy(&testSink->records[testSink->count++ * LOG_CODEC_RECORD_SIZE], record, LOG_CODEC_RECORD_SIZE);
+}
+
+static uint16_t loadTrace(const char *name) {
+  char path[256];
+  char line[256];
+  uint16_t count = 0;
+
+  snprintf(path, sizeof(path), "%s/%s", LOG_CODEC_TRACES_DIR, name);
+  FILE *file = fopen(path, "r");
+  TEST_ASSERT_NOT_NULL_MESSAGE(file, path);
+
+  while (fgets(line, sizeof(line), file) != NULL && count < TEST_MAX_RECORDS) {
+    long timestamp;
+    unsigned temperature, humidity, lux, rms, magnitude;
+    int x, y, z;
+
+    if (line[0] == '#') continue;
+    if (sscanf(line, "%ld,%u,%u,%u,%d,%d,%d,%u,%u", &timestamp, &temperature, &humidity, &lux, &x, &y, &z, &rms, &magnitude) != 9) continue;
+
+    records[count++] = (TestEntry_t) {
+      .timestamp = (int32_t) timestamp,
+      .rawTemperature = (uint16_t) temperature,
+      .rawHumidity = (uint16_t) humidity,
+      .rawLux = (uint16_t) lux,
+      .accel = {(int16_t) x, (int16_t) y, (int16_t) z},
+      .vibration = {(uint8_t) rms, 0, (uint8_t) magnitude, 0},
+    };
+  }
+
+  fclose(file);
+
+  return count;
+}
+
+/**
+ * @brief Encodes the records chunk by chunk as the NFC stream does, every chunk is decoded on its own
+ * @return Encoded stream size
+ */
+static uint32_t roundTripInChunks(uint32_t recordsCount, uint32_t chunkSize) {
+  const uint8_t *raw = (const uint8_t *) records;
+  uint32_t encodedCount = 0;
+  uint32_t streamSize = 0;
+
+  while (encodedCount < recordsCount) {
+    uint32_t chunkLength;
+    const uint32_t count = LOG_CODEC_Encode(&encoder, &raw[encodedCount * LOG_CODEC_RECORD_SIZE], recordsCount - encodedCount,
+                                            stream, chunkSize, &chunkLength);
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, count);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(chunkSize, chunkLength);
+    TEST_ASSERT_EQUAL_INT32((int32_t) count, LOG_CODEC_Decode(&decoder, stream, chunkLength, collectRecord, &sink));
+
+    encodedCount += count;
+    streamSize += chunkLength;
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(recordsCount, sink.count);
+  TEST_ASSERT_EQUAL_MEMORY(records, decoded, recordsCount * LOG_CODEC_RECORD_SIZE);
+
+  return streamSize;
+}
+
+void test_LogCodec_ReeferTrace_RoundTripInMailboxChunks(void) {
+  const uint16_t count = loadTrace("reefer_door_unloading.csv");
+  const uint32_t rawSize = count * LOG_CODEC_RECORD_SIZE;
+  const uint32_t streamSize = roundTripInChunks(count, TEST_CHUNK_SIZE);
+
+  printf("reefer trace: %lu bytes encoded to %lu bytes\n", (unsigned long) rawSize, (unsigned long) streamSize);
+
+  TEST_ASSERT_LESS_THAN_UINT32(rawSize / 2, streamSize);
+}
+
+void test_LogCodec_RandomRecords_WorstCaseBound(void) {
+  srand(3);
+  for (uint32_t i = 0; i < sizeof(records); i++) {
+    ((uint8_t *) records)[i] = (uint8_t) rand();
+  }
+
+  for (uint32_t i = 0; i < TEST_MAX_RECORDS; i++) {
+    uint32_t length;
+
+    TEST_ASSERT_EQUAL_UINT32(1, LOG_CODEC_Encode(&encoder, (const uint8_t *) &records[i], 1, stream, LOG_CODEC_MAX_RECORD_SIZE, &length));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LOG_CODEC_MAX_RECORD_SIZE, length);
+    TEST_ASSERT_EQUAL_INT32(1, LOG_CODEC_Decode(&decoder, stream, length, collectRecord, &sink));
+  }
+
+  TEST_ASSERT_EQUAL_MEMORY(records, decoded, sizeof(records));
+}
+
+void test_LogCodec_PeriodicRecords_EncodedAsRuns(void) {
+  for (uint32_t i = 0; i < 300; i++) {
+    records[i] = (TestEntry_t) {.timestamp = 1790000000 + (int32_t) i * 30, .rawTemperature = 18348, .rawHumidity = 55755, .accel = {0, 0, 16384}};
+  }
+
+  // the first record, the first interval, then the runs of 128 + 128 + 42 records
+  const uint32_t streamSize = roundTripInChunks(300, sizeof(stream));
+
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(2 * LOG_CODEC_MAX_RECORD_SIZE + 3, streamSize);
+}
+
+void test_LogCodec_FullOutput_StopsBeforeTheRecord(void) {
+  uint32_t length;
+
+  records[0] = (TestEntry_t) {.timestamp = -1, .rawTemperature = 0x8000, .suppressedCount = 0xFFFF};
+  records[1] = (TestEntry_t) {.timestamp = 0x7FFFFFFF};
+
+  TEST_ASSERT_EQUAL_UINT32(0, LOG_CODEC_Encode(&encoder, (const uint8_t *) records, 2, stream, 4, &length));
+  TEST_ASSERT_EQUAL_UINT32(0, length);
+
+  // the rejected record hasn't advanced the state, the stream restarts with it
+  roundTripInChunks(2, LOG_CODEC_MAX_RECORD_SIZE);
+}
+
+void test_LogCodec_MalformedChunks_Rejected(void) {
+  const uint8_t reservedToken[] = {0x84, 0x01, 0x00};
+  const uint8_t emptyMask[] = {0x80, 0x00};
+  const uint8_t truncatedVarint[] = {0x80, 0x02, 0x80};
+  const uint8_t missingMask[] = {0x81};
+
+  TEST_ASSERT_EQUAL_INT32(LOG_CODEC_ERROR, LOG_CODEC_Decode(&decoder, reservedToken, sizeof(reservedToken), collectRecord, &sink));
+  TEST_ASSERT_EQUAL_INT32(LOG_CODEC_ERROR, LOG_CODEC_Decode(&decoder, emptyMask, sizeof(emptyMask), collectRecord, &sink));
+  TEST_ASSERT_EQUAL_INT32(LOG_CODEC_ERROR, LOG_CODEC_Decode(&decoder, truncatedVarint, sizeof(truncatedVarint), collectRecord, &sink));
+  TEST_ASSERT_EQUAL_INT32(LOG_CODEC_ERROR, LOG_CODEC_Decode(&decoder, missingMask, sizeof(missingMask), collectRecord, &sink));
+  TEST_ASSERT_EQUAL_INT32(0, LOG_CODEC_Decode(&decoder, stream, 0, collectRecord, &sink));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_LogCodec_ReeferTrace_RoundTripInMailboxChunks);
+  RUN_TEST(test_LogCodec_RandomRecords_WorstCaseBound);
+  RUN_TEST(test_LogCodec_PeriodicRecords_EncodedAsRuns);
+  RUN_TEST(test_LogCodec_FullOutput_StopsBeforeTheRecord);
+  RUN_TEST(test_LogCodec_MalformedChunks_Rejected);
+
+  return UNITY_END();
+}
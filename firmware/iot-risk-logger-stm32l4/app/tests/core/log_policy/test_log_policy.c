@@ -0,0 +1,231 @@
+/*!
+ * @file test_log_policy.c
+ * @brief Unit tests for the deadband logging policy, fed from the traces in the log entry format
+ *
+ * The traces are CSV files in `traces/`, one log entry per line, raw sensors values as written by the MEMORY actor.
+ *
+ * @date 18/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "unity.h"
+#include "log_policy.h"
+#include "conversions.h"
+
+#ifndef LOG_POLICY_TRACES_DIR
+#define LOG_POLICY_TRACES_DIR "core/log_policy/traces"
+#endif
+
+#define TEST_TRACE_MAX_SAMPLES (1024)
+
+static LOG_POLICY_t policy;
+static const LOG_POLICY_Config_t defaultConfig = LOG_POLICY_DEFAULT_CONFIG;
+static LOG_POLICY_Sample_t trace[TEST_TRACE_MAX_SAMPLES];
+
+void setUp(void) {
+  LOG_POLICY_Init(&policy, &defaultConfig);
+}
+
+void tearDown(void) {}
+
+static uint16_t loadTrace(const char *name) {
+  char path[256];
+  char line[256];
+  uint16_t count = 0;
+
+  snprintf(path, sizeof(path), "%s/%s", LOG_POLICY_TRACES_DIR, name);
+  FILE *file = fopen(path, "r");
+  TEST_ASSERT_NOT_NULL_MESSAGE(file, path);
+
+  while (fgets(line, sizeof(line), file) != NULL && count < TEST_TRACE_MAX_SAMPLES) {
+    long timestamp;
+    unsigned temperature, humidity, lux, rms, magnitude;
+    int x, y, z;
+
+    if (line[0] == '#') continue;
+    if (sscanf(line, "%ld,%u,%u,%u,%d,%d,%d,%u,%u", &timestamp, &temperature, &humidity, &lux, &x, &y, &z, &rms, &magnitude) != 9) continue;
+
+    trace[count++] = (LOG_POLICY_Sample_t) {
+      .timestamp = (int32_t) timestamp,
+      .temperature = (uint16_t) temperature,
+      .humidity = (uint16_t) humidity,
+      .lux = CONVERT_OPT3001RawToCentiLux((uint16_t) lux),
+      .acceleration = {(int16_t) x, (int16_t) y, (int16_t) z},
+      .vibrationRms = (uint8_t) rms,
+      .vibrationMagnitude = (uint8_t) magnitude,
+    };
+  }
+
+  fclose(file);
+
+  return count;
+}
+
+static uint32_t difference(int32_t a, int32_t b) {
+  return (a > b) ? (uint32_t) (a - b) : (uint32_t) (b - a);
+}
+
+/**
+ * @brief Every sample of the trace is within the deadbands of the last stored one (sample and hold replay)
+ */
+static void assertWithinDeadbands(const LOG_POLICY_Sample_t *stored, const LOG_POLICY_Sample_t *sample) {
+  uint32_t luxDeadband = stored->lux / 100 * defaultConfig.luxDeadbandPercent;
+  if (luxDeadband < defaultConfig.luxDeadbandMin) luxDeadband = defaultConfig.luxDeadbandMin;
+
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(defaultConfig.temperatureDeadband, difference(sample->temperature, stored->temperature));
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(defaultConfig.humidityDeadband, difference(sample->humidity, stored->humidity));
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(luxDeadband, difference((int32_t) sample->lux, (int32_t) stored->lux));
+  for (uint8_t axis = 0; axis < LOG_POLICY_AXES_COUNT; axis++) {
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(defaultConfig.accelerationDeadband, difference(sample->acceleration[axis], stored->acceleration[axis]));
+  }
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(defaultConfig.vibrationDeadband, difference(sample->vibrationRms, stored->vibrationRms));
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(defaultConfig.vibrationDeadband, difference(sample->vibrationMagnitude, stored->vibrationMagnitude));
+}
+
+void test_LogPolicy_FirstSample_Stored(void) {
+  uint16_t suppressedCount = 0xFFFF;
+  LOG_POLICY_Sample_t sample = {.timestamp = 1000};
+
+  TEST_ASSERT_TRUE(LOG_POLICY_Filter(&policy, &sample, &suppressedCount));
+  TEST_ASSERT_EQUAL_UINT16(0, suppressedCount);
+}
+
+void test_LogPolicy_StableSamples_SuppressedUntilHeartbeat(void) {
+  uint16_t suppressedCount = 0;
+  LOG_POLICY_Sample_t sample = {.timestamp = 1000, .temperature = 18000, .lux = 5000};
+
+  LOG_POLICY_Filter(&policy, &sample, &suppressedCount);
+
+  for (uint32_t seconds = 30; seconds < defaultConfig.heartbeatSeconds; seconds += 30) {
+    sample.timestamp = 1000 + seconds;
+    sample.temperature = 18000 + (seconds % 60 ? 10 : -10); // noise within the deadband
+    TEST_ASSERT_FALSE(LOG_POLICY_Filter(&policy, &sample, &suppressedCount));
+  }
+
+  sample.timestamp = 1000 + defaultConfig.heartbeatSeconds;
+  TEST_ASSERT_TRUE(LOG_POLICY_Filter(&policy, &sample, &suppressedCount));
+  TEST_ASSERT_EQUAL_UINT16(defaultConfig.heartbeatSeconds / 30 - 1, suppressedCount);
+}
+
+void test_LogPolicy_EveryChannelExcursion_Stored(void) {
+  uint16_t suppressedCount = 0;
+  const LOG_POLICY_Sample_t base = {.timestamp = 1000, .temperature = 18000, .humidity = 50000, .lux = 5000, .acceleration = {0, 0, 16384}, .vibrationRms = 2, .vibrationMagnitude = 64};
+  LOG_POLICY_Sample_t excursions[7];
+
+  for (uint8_t i = 0; i < 7; i++) {
+    excursions[i] = base;
+    excursions[i].timestamp = base.timestamp + 30;
+  }
+  excursions[0].temperature += defaultConfig.temperatureDeadband + 1;
+  excursions[1].humidity -= defaultConfig.humidityDeadband + 1;
+  excursions[2].lux += base.lux / 100 * defaultConfig.luxDeadbandPercent + 1;
+  excursions[3].acceleration[0] -= defaultConfig.accelerationDeadband + 1;
+  excursions[4].acceleration[2] += defaultConfig.accelerationDeadband + 1;
+  excursions[5].vibrationRms += defaultConfig.vibrationDeadband + 1;
+  excursions[6].vibrationMagnitude += defaultConfig.vibrationDeadband + 1;
+
+  for (uint8_t i = 0; i < 7; i++) {
+    LOG_POLICY_Init(&policy, &defaultConfig);
+    LOG_POLICY_Filter(&policy, &base, &suppressedCount);
+
+    TEST_ASSERT_TRUE_MESSAGE(LOG_POLICY_Filter(&policy, &excursions[i], &suppressedCount), "excursion suppressed");
+  }
+}
+
+void test_LogPolicy_SlowDrift_StoredAgainstLastStored(void) {
+  uint16_t suppressedCount = 0;
+  LOG_POLICY_Sample_t sample = {.timestamp = 1000, .temperature = 18000};
+  uint8_t storedCount = 0;
+
+  // 10 raw per sample never exceeds the deadband between two samples, the drift from the stored one does
+  for (uint8_t i = 0; i < 20; i++) {
+    sample.timestamp += 30;
+    sample.temperature += 10;
+    storedCount += LOG_POLICY_Filter(&policy, &sample, &suppressedCount);
+  }
+
+  TEST_ASSERT_EQUAL_UINT8(3, storedCount);
+}
+
+void test_LogPolicy_Disabled_StoresEverySample(void) {
+  LOG_POLICY_Config_t config = defaultConfig;
+  uint16_t suppressedCount = 0;
+  LOG_POLICY_Sample_t sample = {.timestamp = 1000};
+
+  config.isEnabled = false;
+  LOG_POLICY_Init(&policy, &config);
+
+  for (uint8_t i = 0; i < 10; i++) {
+    sample.timestamp += 30;
+    TEST_ASSERT_TRUE(LOG_POLICY_Filter(&policy, &sample, &suppressedCount));
+    TEST_ASSERT_EQUAL_UINT16(0, suppressedCount);
+  }
+}
+
+void test_LogPolicy_Revert_NextSampleStoredWithFailedCounted(void) {
+  uint16_t suppressedCount = 0;
+  LOG_POLICY_Sample_t sample = {.timestamp = 1000, .temperature = 18000};
+
+  TEST_ASSERT_TRUE(LOG_POLICY_Filter(&policy, &sample, &suppressedCount));
+  sample.timestamp += 30;
+  TEST_ASSERT_FALSE(LOG_POLICY_Filter(&policy, &sample, &suppressedCount));
+
+  // the excursion is stored, but its write fails
+  sample.timestamp += 30;
+  sample.temperature += defaultConfig.temperatureDeadband + 1;
+  TEST_ASSERT_TRUE(LOG_POLICY_Filter(&policy, &sample, &suppressedCount));
+  TEST_ASSERT_EQUAL_UINT16(1, suppressedCount);
+  LOG_POLICY_Revert(&policy, suppressedCount);
+
+  // within the deadband of the failed sample, stored anyway
+  sample.timestamp += 30;
+  TEST_ASSERT_TRUE(LOG_POLICY_Filter(&policy, &sample, &suppressedCount));
+  TEST_ASSERT_EQUAL_UINT16(2, suppressedCount);
+}
+
+void test_LogPolicy_ReeferTrace_KeepsExcursionsWithFewerWrites(void) {
+  const uint16_t samplesCount = loadTrace("reefer_door_unloading.csv");
+  uint16_t storedCount = 0;
+  uint32_t suppressedTotal = 0;
+  uint16_t suppressedCount = 0;
+  LOG_POLICY_Sample_t stored = {0};
+
+  TEST_ASSERT_GREATER_THAN_UINT16(0, samplesCount);
+
+  for (uint16_t i = 0; i < samplesCount; i++) {
+    if (LOG_POLICY_Filter(&policy, &trace[i], &suppressedCount)) {
+      if (storedCount > 0) {
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(defaultConfig.heartbeatSeconds, trace[i].timestamp - stored.timestamp);
+      }
+      stored = trace[i];
+      storedCount++;
+      suppressedTotal += suppressedCount;
+    }
+
+    assertWithinDeadbands(&stored, &trace[i]);
+  }
+
+  // the pending suppressed samples go with the next stored one
+  suppressedTotal += policy.suppressedCount;
+
+  printf("reefer trace: %u of %u samples stored\n", storedCount, samplesCount);
+
+  TEST_ASSERT_EQUAL_UINT32(samplesCount, storedCount + suppressedTotal);
+  TEST_ASSERT_LESS_THAN_UINT16(samplesCount / 4, storedCount);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_LogPolicy_FirstSample_Stored);
+  RUN_TEST(test_LogPolicy_StableSamples_SuppressedUntilHeartbeat);
+  RUN_TEST(test_LogPolicy_EveryChannelExcursion_Stored);
+  RUN_TEST(test_LogPolicy_SlowDrift_StoredAgainstLastStored);
+  RUN_TEST(test_LogPolicy_Disabled_StoresEverySample);
+  RUN_TEST(test_LogPolicy_Revert_NextSampleStoredWithFailedCounted);
+  RUN_TEST(test_LogPolicy_ReeferTrace_KeepsExcursionsWithFewerWrites);
+
+  return UNITY_END();
+}
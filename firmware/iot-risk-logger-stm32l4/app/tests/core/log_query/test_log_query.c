@@ -0,0 +1,277 @@
+/*!
+ * @file test_log_query.c
+ * @brief Unit tests for the log aggregate queries: the reefer trace against a second by second replay, the range
+ * start search, the held values and the marker entries
+ *
+ * @date 18/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "log_query.h"
+
+#ifndef LOG_QUERY_TRACES_DIR
+#define LOG_QUERY_TRACES_DIR "core/log_policy/traces"
+#endif
+
+#define TEST_MAX_ENTRIES  (1024)
+#define TEST_BLOCK_ENTRIES (16) // entries read from the NOR Flash at once
+#define TEST_CELSIUS_8    (800)
+#define TEST_MARKER       (0xFFFF)
+
+/**
+ * @brief MEMORY_SensorsMeasurementEntry_t layout
+ */
+typedef struct __attribute__((packed)) {
+  int32_t timestamp;
+  uint16_t rawTemperature;
+  uint16_t rawHumidity;
+  uint16_t rawLux;
+  int16_t accel[3];
+  uint8_t vibration[4];
+  uint16_t suppressedCount;
+} TestEntry_t;
+
+_Static_assert(sizeof(TestEntry_t) == LOG_QUERY_ENTRY_SIZE, "test entry size mismatch");
+
+static TestEntry_t entries[TEST_MAX_ENTRIES];
+static uint32_t entriesCount;
+static uint32_t timestampReads;
+
+void setUp(void) {
+  entriesCount = 0;
+  timestampReads = 0;
+}
+
+void tearDown(void) {}
+
+static void loadTrace(const char *name, uint32_t decimation) {
+  char path[256];
+  char line[256];
+  uint32_t lineIndex = 0;
+
+  snprintf(path, sizeof(path), "%s/%s", LOG_QUERY_TRACES_DIR, name);
+  FILE *file = fopen(path, "r");
+  TEST_ASSERT_NOT_NULL_MESSAGE(file, path);
+
+  while (fgets(line, sizeof(line), file) != NULL && entriesCount < TEST_MAX_ENTRIES) {
+    long timestamp;
+    unsigned temperature, humidity, lux;
+
+    if (line[0] == '#') continue;
+    if (sscanf(line, "%ld,%u,%u,%u", &timestamp, &temperature, &humidity, &lux) != 4) continue;
+    if (lineIndex++ % decimation != 0) continue;
+
+    entries[entriesCount++] = (TestEntry_t) {
+      .timestamp = (int32_t) timestamp,
+      .rawTemperature = (uint16_t) temperature,
+      .rawHumidity = (uint16_t) humidity,
+      .rawLux = (uint16_t) lux,
+    };
+  }
+
+  fclose(file);
+}
+
+static int32_t readEntryTimestamp(uint32_t entry, int32_t *timestamp, void *context) {
+  (void) context;
+
+  TEST_ASSERT_LESS_THAN_UINT32(entriesCount, entry);
+  timestampReads++;
+  *timestamp = entries[entry].timestamp;
+
+  return 0;
+}
+
+/**
+ * @brief Evaluates the query as MEMORY does: seeks the range start, then reads the blocks until the range is over
+ */
+static LOG_QUERY_Result_t evaluate(int32_t from, int32_t to, uint8_t channel, int32_t threshold) {
+  const LOG_QUERY_Request_t request = {.from = from, .to = to, .channel = channel, .threshold = threshold};
+  LOG_QUERY_t query;
+  uint32_t entry;
+
+  TEST_ASSERT_TRUE(LOG_QUERY_Init(&query, &request));
+  TEST_ASSERT_EQUAL_INT32(0, LOG_QUERY_SeekRangeStart(&query, entriesCount, readEntryTimestamp, NULL, &entry));
+
+  for (; entry < entriesCount; entry += TEST_BLOCK_ENTRIES) {
+    const uint32_t count = (entriesCount - entry < TEST_BLOCK_ENTRIES) ? entriesCount - entry : TEST_BLOCK_ENTRIES;
+
+    if (!LOG_QUERY_Accumulate(&query, (const uint8_t *) &entries[entry], count)) break;
+  }
+
+  LOG_QUERY_Finish(&query);
+
+  return query.result;
+}
+
+static int32_t temperatureOf(const TestEntry_t *entry) {
+  return CONVERT_SHT3xRawToCentiCelsius(entry->rawTemperature);
+}
+
+/**
+ * @brief Reference: the statistics of the entries within the range and the held temperature replayed second by second
+ */
+static void assertReplayMatches(int32_t from, int32_t to, int32_t threshold) {
+  const LOG_QUERY_Result_t result = evaluate(from, to, LOG_QUERY_TEMPERATURE, threshold);
+  LOG_QUERY_Result_t expected = {0};
+  int64_t sum = 0;
+  const TestEntry_t *held = NULL;
+  uint32_t next = 0;
+
+  for (uint32_t i = 0; i < entriesCount; i++) {
+    const int32_t value = temperatureOf(&entries[i]);
+
+    if (entries[i].rawTemperature == TEST_MARKER || entries[i].timestamp < from || entries[i].timestamp > to) continue;
+
+    expected.min = (expected.count == 0 || value < expected.min) ? value : expected.min;
+    expected.max = (expected.count == 0 || value > expected.max) ? value : expected.max;
+    expected.count++;
+    sum += value;
+  }
+
+  // the second [t, t + 1) is above when the value held at t is, the last entry lasts no time
+  for (int32_t second = from; second < to; second++) {
+    while (next < entriesCount && entries[next].timestamp <= second) {
+      if (entries[next].rawTemperature != TEST_MARKER) held = &entries[next];
+      next++;
+    }
+
+    if (held == NULL || next == entriesCount || temperatureOf(held) <= threshold) continue;
+
+    if (expected.secondsAbove == 0) expected.firstExcursion = second;
+    expected.lastExcursion = second + 1;
+    expected.secondsAbove++;
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(expected.count, result.count);
+  TEST_ASSERT_EQUAL_INT32(expected.min, result.min);
+  TEST_ASSERT_EQUAL_INT32(expected.max, result.max);
+  TEST_ASSERT_EQUAL_INT32(expected.count ? (int32_t) (sum / expected.count) : 0, result.mean);
+  TEST_ASSERT_EQUAL_UINT32(expected.secondsAbove, result.secondsAbove);
+  TEST_ASSERT_EQUAL_INT32(expected.firstExcursion, result.firstExcursion);
+  TEST_ASSERT_EQUAL_INT32(expected.lastExcursion, result.lastExcursion);
+}
+
+void test_LogQuery_ReeferTrace_MatchesSecondBySecondReplay(void) {
+  loadTrace("reefer_door_unloading.csv", 1);
+  const int32_t first = entries[0].timestamp;
+  const int32_t last = entries[entriesCount - 1].timestamp;
+
+  assertReplayMatches(first, last, TEST_CELSIUS_8);
+  assertReplayMatches(first + 6400, last - 300, TEST_CELSIUS_8);
+  assertReplayMatches(first + 6517, first + 6533, TEST_CELSIUS_8); // between two entries
+  assertReplayMatches(first - 1000, first + 100, TEST_CELSIUS_8);
+}
+
+void test_LogQuery_SparseLogWithMarkers_HeldValuesCounted(void) {
+  loadTrace("reefer_door_unloading.csv", 7);
+
+  for (uint32_t i = 3; i < entriesCount; i += 5) {
+    entries[i].rawTemperature = TEST_MARKER;
+  }
+
+  const int32_t first = entries[0].timestamp;
+  const int32_t last = entries[entriesCount - 1].timestamp;
+
+  assertReplayMatches(first, last, TEST_CELSIUS_8);
+  assertReplayMatches(first + 6411, last - 177, TEST_CELSIUS_8);
+  assertReplayMatches(first + 6411, last - 177, 1400);
+}
+
+void test_LogQuery_SeekRangeStart_ReadsLogarithmicTimestamps(void) {
+  LOG_QUERY_t query;
+  uint32_t entry;
+
+  for (entriesCount = 0; entriesCount < TEST_MAX_ENTRIES; entriesCount++) {
+    entries[entriesCount] = (TestEntry_t) {.timestamp = 1000 + (int32_t) entriesCount * 30};
+  }
+
+  LOG_QUERY_Init(&query, &(LOG_QUERY_Request_t) {.from = 1000 + 500 * 30, .to = INT32_MAX});
+  TEST_ASSERT_EQUAL_INT32(0, LOG_QUERY_SeekRangeStart(&query, entriesCount, readEntryTimestamp, NULL, &entry));
+  TEST_ASSERT_EQUAL_UINT32(499, entry);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(11, timestampReads);
+
+  LOG_QUERY_Init(&query, &(LOG_QUERY_Request_t) {.from = 1000 + 500 * 30 + 1, .to = INT32_MAX});
+  LOG_QUERY_SeekRangeStart(&query, entriesCount, readEntryTimestamp, NULL, &entry);
+  TEST_ASSERT_EQUAL_UINT32(500, entry);
+
+  LOG_QUERY_Init(&query, &(LOG_QUERY_Request_t) {.from = 0, .to = INT32_MAX});
+  LOG_QUERY_SeekRangeStart(&query, entriesCount, readEntryTimestamp, NULL, &entry);
+  TEST_ASSERT_EQUAL_UINT32(0, entry);
+
+  LOG_QUERY_Init(&query, &(LOG_QUERY_Request_t) {.from = INT32_MAX, .to = INT32_MAX});
+  LOG_QUERY_SeekRangeStart(&query, entriesCount, readEntryTimestamp, NULL, &entry);
+  TEST_ASSERT_EQUAL_UINT32(entriesCount - 1, entry);
+
+  LOG_QUERY_SeekRangeStart(&query, 0, readEntryTimestamp, NULL, &entry);
+  TEST_ASSERT_EQUAL_UINT32(0, entry);
+}
+
+void test_LogQuery_LuxChannel_ComparedInLux(void) {
+  entries[0] = (TestEntry_t) {.timestamp = 100, .rawLux = 0x1064}; // 2^1 × 100 × 0.01 = 2lux
+  entries[1] = (TestEntry_t) {.timestamp = 160, .rawLux = 0x0FA0}; // 40lux
+  entries[2] = (TestEntry_t) {.timestamp = 220, .rawLux = 0x1064};
+  entriesCount = 3;
+
+  const LOG_QUERY_Result_t result = evaluate(0, 1000, LOG_QUERY_LUX, 1000);
+
+  TEST_ASSERT_EQUAL_UINT32(3, result.count);
+  TEST_ASSERT_EQUAL_INT32(200, result.min);
+  TEST_ASSERT_EQUAL_INT32(4000, result.max);
+  TEST_ASSERT_EQUAL_INT32(1466, result.mean);
+  TEST_ASSERT_EQUAL_UINT32(60, result.secondsAbove);
+  TEST_ASSERT_EQUAL_INT32(160, result.firstExcursion);
+  TEST_ASSERT_EQUAL_INT32(220, result.lastExcursion);
+}
+
+void test_LogQuery_RangeAfterTheHeldEntry_NoEntriesButTimeAbove(void) {
+  entries[0] = (TestEntry_t) {.timestamp = 100, .rawTemperature = CONVERT_CENTI_CELSIUS_TO_SHT3x_RAW(1000)};
+  entries[1] = (TestEntry_t) {.timestamp = 1000, .rawTemperature = CONVERT_CENTI_CELSIUS_TO_SHT3x_RAW(400)};
+  entriesCount = 2;
+
+  const LOG_QUERY_Result_t result = evaluate(200, 500, LOG_QUERY_TEMPERATURE, TEST_CELSIUS_8);
+
+  TEST_ASSERT_EQUAL_UINT32(0, result.count);
+  TEST_ASSERT_EQUAL_INT32(0, result.mean);
+  TEST_ASSERT_EQUAL_UINT32(300, result.secondsAbove);
+  TEST_ASSERT_EQUAL_INT32(200, result.firstExcursion);
+  TEST_ASSERT_EQUAL_INT32(500, result.lastExcursion);
+}
+
+void test_LogQuery_EntryAfterTheRange_StopsTheScan(void) {
+  LOG_QUERY_t query;
+
+  entries[0] = (TestEntry_t) {.timestamp = 100};
+  entries[1] = (TestEntry_t) {.timestamp = 200};
+  entries[2] = (TestEntry_t) {.timestamp = 300};
+
+  LOG_QUERY_Init(&query, &(LOG_QUERY_Request_t) {.from = 0, .to = 250});
+
+  TEST_ASSERT_FALSE(LOG_QUERY_Accumulate(&query, (const uint8_t *) entries, 3));
+  TEST_ASSERT_EQUAL_UINT32(2, query.result.count);
+}
+
+void test_LogQuery_InvalidRequest_Rejected(void) {
+  LOG_QUERY_t query;
+
+  TEST_ASSERT_FALSE(LOG_QUERY_Init(&query, &(LOG_QUERY_Request_t) {.from = 0, .to = 10, .channel = LOG_QUERY_CHANNELS_COUNT}));
+  TEST_ASSERT_FALSE(LOG_QUERY_Init(&query, &(LOG_QUERY_Request_t) {.from = 10, .to = 0}));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_LogQuery_ReeferTrace_MatchesSecondBySecondReplay);
+  RUN_TEST(test_LogQuery_SparseLogWithMarkers_HeldValuesCounted);
+  RUN_TEST(test_LogQuery_SeekRangeStart_ReadsLogarithmicTimestamps);
+  RUN_TEST(test_LogQuery_LuxChannel_ComparedInLux);
+  RUN_TEST(test_LogQuery_RangeAfterTheHeldEntry_NoEntriesButTimeAbove);
+  RUN_TEST(test_LogQuery_EntryAfterTheRange_StopsTheScan);
+  RUN_TEST(test_LogQuery_InvalidRequest_Rejected);
+
+  return UNITY_END();
+}
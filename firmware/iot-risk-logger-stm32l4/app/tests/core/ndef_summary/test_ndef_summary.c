@@ -0,0 +1,187 @@
+/*!
+ * @file test_ndef_summary.c
+ * @brief Unit tests for the NDEF summary record: the Type 5 area layout, the text, the material change policy and
+ * the EEPROM blocks rewritten on a refresh
+ *
+ * @date 18/10/2026
+ */
+
+#include <string.h>
+
+#include "unity.h"
+#include "ndef_summary.h"
+
+#define TEST_TIMESTAMP (1790007170) // 2026-09-21 16:12:50 UTC
+
+static NDEF_SUMMARY_t summary;
+
+void setUp(void) {
+  NDEF_SUMMARY_Init(&summary);
+}
+
+void tearDown(void) {}
+
+static void update(int32_t timestamp, int16_t temperature, uint16_t humidity, uint32_t lux) {
+  NDEF_SUMMARY_Update(&summary, &(NDEF_SUMMARY_Sample_t) {
+    .timestamp = timestamp,
+    .temperature = temperature,
+    .humidity = humidity,
+    .lux = lux,
+    .isClimateValid = true,
+    .isLuxValid = true,
+    .isComplete = true,
+  });
+}
+
+/**
+ * @brief Writes the changed runs as the NFC actor does
+ * @return EEPROM blocks written
+ */
+static uint32_t writeChangedBlocks(uint32_t *writesCount) {
+  uint16_t offset, length;
+  uint32_t blocks = 0;
+
+  *writesCount = 0;
+
+  while (NDEF_SUMMARY_NextChangedBlocks(&summary, &offset, &length)) {
+    TEST_ASSERT_EQUAL_UINT16(0, offset % NDEF_SUMMARY_EEPROM_BLOCK_SIZE);
+    TEST_ASSERT_EQUAL_UINT16(0, length % NDEF_SUMMARY_EEPROM_BLOCK_SIZE);
+    NDEF_SUMMARY_MarkWritten(&summary, offset, length);
+    blocks += length / NDEF_SUMMARY_EEPROM_BLOCK_SIZE;
+    (*writesCount)++;
+  }
+
+  return blocks;
+}
+
+void test_NdefSummary_Render_Type5AreaWithTextRecord(void) {
+  const uint8_t headers[] = {0xE1, 0x40, 0x40, 0x00, 0x03, NDEF_SUMMARY_RECORD_LENGTH, 0xD1, 0x01, NDEF_SUMMARY_PAYLOAD_LENGTH, 'T', 0x02, 'e', 'n'};
+  const char text[] = "IoT Risk Logger: OK   \n"
+                      "T +04.2C RH 082% 00012lx\n"
+                      "Tmin +03.9C Tmax +04.2C\n"
+                      "Alarms ---, 0000002 samples\n"
+                      "Updated 2026-09-21 16:12 UTC";
+
+  update(TEST_TIMESTAMP - 60, 390, 8150, 1500);
+  update(TEST_TIMESTAMP, 415, 8220, 1249);
+
+  TEST_ASSERT_TRUE(NDEF_SUMMARY_Render(&summary));
+
+  TEST_ASSERT_EQUAL_UINT32(NDEF_SUMMARY_TEXT_LENGTH, sizeof(text) - 1);
+  TEST_ASSERT_EQUAL_MEMORY(headers, summary.image, sizeof(headers));
+  TEST_ASSERT_EQUAL_MEMORY(text, &summary.image[NDEF_SUMMARY_TEXT_OFFSET], NDEF_SUMMARY_TEXT_LENGTH);
+  TEST_ASSERT_EQUAL_HEX8(0xFE, summary.image[NDEF_SUMMARY_TEXT_OFFSET + NDEF_SUMMARY_TEXT_LENGTH]);
+  // TLV length covers the record up to the terminator
+  TEST_ASSERT_EQUAL_UINT32(NDEF_SUMMARY_TEXT_OFFSET + NDEF_SUMMARY_TEXT_LENGTH, 6 + summary.image[5]);
+  TEST_ASSERT_EQUAL_UINT32(0, NDEF_SUMMARY_SIZE % NDEF_SUMMARY_EEPROM_BLOCK_SIZE);
+}
+
+void test_NdefSummary_BeforeTheFirstReading_PlaceholdersRendered(void) {
+  const char line[] = "T  --.-C RH 000% 00000lx\nTmin  --.-C Tmax  --.-C";
+
+  NDEF_SUMMARY_Update(&summary, &(NDEF_SUMMARY_Sample_t) {.timestamp = 951782400 + 3600 * 23 + 59 * 60, .isComplete = false});
+
+  TEST_ASSERT_TRUE(NDEF_SUMMARY_Render(&summary));
+  TEST_ASSERT_EQUAL_MEMORY(line, &summary.image[NDEF_SUMMARY_TEXT_OFFSET + 23], sizeof(line) - 1);
+  TEST_ASSERT_EQUAL_MEMORY("ALARM", &summary.image[NDEF_SUMMARY_TEXT_OFFSET + 17], 5);
+  TEST_ASSERT_EQUAL_MEMORY("--S", &summary.image[NDEF_SUMMARY_TEXT_OFFSET + 79], 3);
+  TEST_ASSERT_EQUAL_MEMORY("2000-02-29 23:59", &summary.image[NDEF_SUMMARY_TEXT_OFFSET + 108], 16);
+}
+
+void test_NdefSummary_ChangesWithinDeadbands_NotRendered(void) {
+  uint32_t writesCount;
+
+  update(TEST_TIMESTAMP, 500, 8000, 100000);
+  TEST_ASSERT_TRUE(NDEF_SUMMARY_Render(&summary));
+  TEST_ASSERT_EQUAL_UINT32(NDEF_SUMMARY_SIZE / NDEF_SUMMARY_EEPROM_BLOCK_SIZE, writeChangedBlocks(&writesCount));
+  TEST_ASSERT_EQUAL_UINT32(1, writesCount);
+
+  // min and max stay within the displayed 0.1°C, the rest within the deadbands and the heartbeat
+  for (int32_t i = 1; i <= 50; i++) {
+    update(TEST_TIMESTAMP + i * 60, (int16_t) (500 + (i % 2) * 4), (uint16_t) (8000 + (i % 3) * 60), 100000 + (uint32_t) (i % 2) * 20000);
+    TEST_ASSERT_FALSE(NDEF_SUMMARY_Render(&summary));
+  }
+
+  TEST_ASSERT_FALSE(NDEF_SUMMARY_NextChangedBlocks(&summary, &(uint16_t){0}, &(uint16_t){0}));
+  TEST_ASSERT_EQUAL_UINT32(51, summary.values.samplesCount);
+}
+
+void test_NdefSummary_MaterialChange_RewritesChangedBlocksOnly(void) {
+  uint32_t writesCount;
+
+  update(TEST_TIMESTAMP, 500, 8000, 1000);
+  NDEF_SUMMARY_Render(&summary);
+  writeChangedBlocks(&writesCount);
+
+  // the temperature leaves the deadband: the reading, the max, the samples count and the update minute change,
+  // one block of the 36 each
+  update(TEST_TIMESTAMP + 30, 560, 8000, 1000);
+  TEST_ASSERT_TRUE(NDEF_SUMMARY_Render(&summary));
+
+  const uint32_t blocks = writeChangedBlocks(&writesCount);
+  TEST_ASSERT_EQUAL_UINT32(4, writesCount);
+  TEST_ASSERT_EQUAL_UINT32(4, blocks);
+  TEST_ASSERT_EQUAL_MEMORY("+05.6", &summary.eeprom[NDEF_SUMMARY_TEXT_OFFSET + 25], 5);
+  TEST_ASSERT_EQUAL_MEMORY(summary.image, summary.eeprom, NDEF_SUMMARY_SIZE);
+}
+
+void test_NdefSummary_Alarms_LatchedAndRendered(void) {
+  update(TEST_TIMESTAMP, 500, 8000, 0);
+  NDEF_SUMMARY_Render(&summary);
+
+  update(TEST_TIMESTAMP + 60, 801, 8000, 0);
+  TEST_ASSERT_TRUE(NDEF_SUMMARY_Render(&summary));
+  update(TEST_TIMESTAMP + 120, 199, 8000, 0);
+  TEST_ASSERT_TRUE(NDEF_SUMMARY_Render(&summary));
+  update(TEST_TIMESTAMP + 180, 500, 8000, 0);
+  TEST_ASSERT_TRUE(NDEF_SUMMARY_Render(&summary));
+
+  TEST_ASSERT_EQUAL_UINT8(NDEF_SUMMARY_ALARM_HIGH_TEMPERATURE | NDEF_SUMMARY_ALARM_LOW_TEMPERATURE, summary.values.alarms);
+  TEST_ASSERT_EQUAL_MEMORY("ALARM", &summary.image[NDEF_SUMMARY_TEXT_OFFSET + 17], 5);
+  TEST_ASSERT_EQUAL_MEMORY("Tmin +02.0C Tmax +08.0C", &summary.image[NDEF_SUMMARY_TEXT_OFFSET + 48], 23);
+  TEST_ASSERT_EQUAL_MEMORY("HL-", &summary.image[NDEF_SUMMARY_TEXT_OFFSET + 79], 3);
+}
+
+void test_NdefSummary_Heartbeat_RefreshesTheSamplesCount(void) {
+  update(TEST_TIMESTAMP, 500, 8000, 0);
+  NDEF_SUMMARY_Render(&summary);
+
+  update(TEST_TIMESTAMP + NDEF_SUMMARY_HEARTBEAT_S - 1, 500, 8000, 0);
+  TEST_ASSERT_FALSE(NDEF_SUMMARY_Render(&summary));
+  update(TEST_TIMESTAMP + NDEF_SUMMARY_HEARTBEAT_S, 500, 8000, 0);
+  TEST_ASSERT_TRUE(NDEF_SUMMARY_Render(&summary));
+
+  TEST_ASSERT_EQUAL_MEMORY("0000003", &summary.image[NDEF_SUMMARY_TEXT_OFFSET + 84], 7);
+}
+
+void test_NdefSummary_EepromAlreadyUpToDate_NothingWritten(void) {
+  uint32_t writesCount;
+
+  update(TEST_TIMESTAMP, 500, 8000, 0);
+  NDEF_SUMMARY_Render(&summary);
+  writeChangedBlocks(&writesCount);
+
+  // reboot: the EEPROM is read back, the same values render the same image
+  uint8_t eeprom[NDEF_SUMMARY_SIZE];
+  memcpy(eeprom, summary.eeprom, sizeof(eeprom));
+  NDEF_SUMMARY_Init(&summary);
+  memcpy(summary.eeprom, eeprom, sizeof(eeprom));
+
+  update(TEST_TIMESTAMP, 500, 8000, 0);
+  TEST_ASSERT_TRUE(NDEF_SUMMARY_Render(&summary));
+  TEST_ASSERT_EQUAL_UINT32(0, writeChangedBlocks(&writesCount));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_NdefSummary_Render_Type5AreaWithTextRecord);
+  RUN_TEST(test_NdefSummary_BeforeTheFirstReading_PlaceholdersRendered);
+  RUN_TEST(test_NdefSummary_ChangesWithinDeadbands_NotRendered);
+  RUN_TEST(test_NdefSummary_MaterialChange_RewritesChangedBlocksOnly);
+  RUN_TEST(test_NdefSummary_Alarms_LatchedAndRendered);
+  RUN_TEST(test_NdefSummary_Heartbeat_RefreshesTheSamplesCount);
+  RUN_TEST(test_NdefSummary_EepromAlreadyUpToDate_NothingWritten);
+
+  return UNITY_END();
+}
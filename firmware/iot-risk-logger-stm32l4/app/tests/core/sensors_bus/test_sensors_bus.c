@@ -0,0 +1,585 @@
+/*!
+ * @file test_sensors_bus.c
+ * @brief Unit tests for the sensors bus: the MPMC transactions queue, the bus ownership and the stalled bus recovery
+ *
+ * The I2C1 peripheral is modelled by the HAL interrupt transfer functions: a started transfer is recorded and stays
+ * on the bus until the test calls its completion callback, as the I2C interrupt would. The kernel is modelled by the
+ * tick counter, the thread flags and the actors queues.
+ *
+ * The concurrent submitters test runs the producers and the completing "interrupt" on pthreads, under ThreadSanitizer.
+ *
+ * @date 18/10/2026
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#include "unity.h"
+#include "sensors_bus.h"
+
+#define TEST_QUEUE_SIZE           (256U)
+#define TEST_STARTED_MAX          (1024U)
+#define TEST_PRODUCERS_COUNT      (4U)
+#define TEST_PRODUCER_TRANSACTIONS (200U)
+
+typedef enum {
+  TEST_MEM_WRITE = 0,
+  TEST_MEM_READ,
+  TEST_TRANSMIT,
+  TEST_RECEIVE,
+} TEST_Transfer_t;
+
+typedef struct {
+  TEST_Transfer_t transfer;
+  uint16_t devAddr;
+  uint16_t memAddress;
+  uint16_t memAddSize;
+  uint8_t *pData;
+  uint16_t size;
+} TEST_StartedTransfer_t;
+
+typedef struct {
+  message_t messages[TEST_QUEUE_SIZE];
+  uint32_t count;
+} TEST_Queue_t;
+
+I2C_HandleTypeDef hi2c1;
+uint32_t SystemCoreClock = 4000000U;
+GPIO_TypeDef MOCK_GPIOA;
+actor_t* ACTORS_LOOKUP_SystemRegistry[MAX_ACTORS];
+
+static TEST_StartedTransfer_t started[TEST_STARTED_MAX];
+static uint32_t startedCount;
+static uint32_t inFlight;         ///< Transfers on the bus, never above 1
+static uint32_t inFlightMax;
+static HAL_StatusTypeDef startResult;
+static uint32_t i2cError;
+static uint32_t peripheralInits;
+static uint32_t sclPulses;
+static GPIO_PinState sdaState;
+static uint32_t sclMode;
+static uint32_t pollingCalls;
+
+static uint32_t tick;
+static osKernelState_t kernelState;
+static uint32_t threadHandle;
+static uint32_t threadFlags;
+static void (*onFlagsWait)(void); ///< The "interrupt" running while the thread sleeps, NULL for the stalled bus
+
+static TEST_Queue_t queues[MAX_ACTORS];
+static actor_t actors[MAX_ACTORS];
+static pthread_mutex_t queuesMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t criticalMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void startTransfer(TEST_Transfer_t transfer, uint16_t devAddr, uint16_t memAddress, uint16_t memAddSize, uint8_t *pData, uint16_t size) {
+  const uint32_t index = __atomic_fetch_add(&startedCount, 1, __ATOMIC_RELAXED);
+
+  if (index < TEST_STARTED_MAX) {
+    started[index] = (TEST_StartedTransfer_t) {transfer, devAddr, memAddress, memAddSize, pData, size};
+  }
+
+  const uint32_t transfers = __atomic_add_fetch(&inFlight, 1, __ATOMIC_RELEASE);
+  if (transfers > inFlightMax) inFlightMax = transfers;
+}
+
+static HAL_StatusTypeDef startTransferOrFail(TEST_Transfer_t transfer, uint16_t devAddr, uint16_t memAddress, uint16_t memAddSize, uint8_t *pData, uint16_t size) {
+  if (startResult != HAL_OK) {
+    startResult = HAL_OK; // the next one starts
+    return HAL_ERROR;
+  }
+
+  startTransfer(transfer, devAddr, memAddress, memAddSize, pData, size);
+
+  return HAL_OK;
+}
+
+/**
+ * @brief The I2C interrupt of the transfer on the bus
+ */
+static void completeTransfer(void (*callback)(I2C_HandleTypeDef *hi2c)) {
+  TEST_ASSERT_EQUAL_UINT32(1, __atomic_load_n(&inFlight, __ATOMIC_ACQUIRE));
+
+  __atomic_sub_fetch(&inFlight, 1, __ATOMIC_RELEASE);
+  callback(&hi2c1);
+}
+
+static void completeReceive(void) {
+  completeTransfer(HAL_I2C_MemRxCpltCallback);
+}
+
+static message_t takeMessage(ACTOR_ID actorId) {
+  TEST_Queue_t *queue = &queues[actorId];
+  message_t message = queue->messages[0];
+
+  TEST_ASSERT_TRUE(queue->count > 0);
+  memmove(&queue->messages[0], &queue->messages[1], (queue->count - 1) * sizeof(message_t));
+  queue->count--;
+
+  return message;
+}
+
+static SensorsBus_Transaction_t readTransaction(uint8_t *buffer, uint16_t reg, ACTOR_ID actorId, event_t event) {
+  return (SensorsBus_Transaction_t) {
+    .operation = SENSORS_BUS_READ_REG,
+    .devAddr = 0x88,
+    .reg = reg,
+    .pData = buffer,
+    .length = 2,
+    .actorId = actorId,
+    .completionEvent = event,
+  };
+}
+
+/**
+ * HAL
+ */
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c) {
+  (void) hi2c;
+  peripheralInits++;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c) {
+  (void) hi2c;
+  // the transfer is aborted with the peripheral
+  __atomic_store_n(&inFlight, 0, __ATOMIC_RELEASE);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size) {
+  (void) hi2c;
+  return startTransferOrFail(TEST_MEM_WRITE, DevAddress, MemAddress, MemAddSize, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size) {
+  (void) hi2c;
+  return startTransferOrFail(TEST_MEM_READ, DevAddress, MemAddress, MemAddSize, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size) {
+  (void) hi2c;
+  return startTransferOrFail(TEST_TRANSMIT, DevAddress, 0, 0, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size) {
+  (void) hi2c;
+  return startTransferOrFail(TEST_RECEIVE, DevAddress, 0, 0, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_I2CEx_ConfigAnalogFilter(I2C_HandleTypeDef *hi2c, uint32_t AnalogFilter) {
+  (void) hi2c;
+  (void) AnalogFilter;
+  return HAL_OK;
+}
+
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef *hi2c) {
+  (void) hi2c;
+  return i2cError;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init) {
+  (void) GPIOx;
+  if (GPIO_Init->Pin == BUS_I2C1_SCL_GPIO_PIN) sclMode = GPIO_Init->Mode;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState) {
+  (void) GPIOx;
+  if (GPIO_Pin == BUS_I2C1_SCL_GPIO_PIN && PinState == GPIO_PIN_RESET) sclPulses++;
+  if (GPIO_Pin == BUS_I2C1_SDA_GPIO_PIN) sdaState = PinState;
+}
+
+int32_t BSP_I2C1_ReadReg(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+  (void) DevAddr;
+  (void) Reg;
+  (void) pData;
+  (void) Length;
+  pollingCalls++;
+  return BSP_ERROR_NONE;
+}
+
+int32_t BSP_I2C1_WriteReg(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+  return BSP_I2C1_ReadReg(DevAddr, Reg, pData, Length);
+}
+
+int32_t BSP_I2C1_WriteReg16(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+  return BSP_I2C1_ReadReg(DevAddr, Reg, pData, Length);
+}
+
+int32_t BSP_I2C1_ReadReg16(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+  return BSP_I2C1_ReadReg(DevAddr, Reg, pData, Length);
+}
+
+int32_t BSP_I2C1_Send(uint16_t DevAddr, uint8_t *pData, uint16_t Length) {
+  return BSP_I2C1_ReadReg(DevAddr, 0, pData, Length);
+}
+
+int32_t BSP_I2C1_Recv(uint16_t DevAddr, uint8_t *pData, uint16_t Length) {
+  return BSP_I2C1_ReadReg(DevAddr, 0, pData, Length);
+}
+
+/**
+ * Kernel
+ */
+uint32_t osKernelGetTickCount(void) {
+  return __atomic_load_n(&tick, __ATOMIC_RELAXED);
+}
+
+osKernelState_t osKernelGetState(void) {
+  return kernelState;
+}
+
+osThreadId_t osThreadGetId(void) {
+  return &threadHandle;
+}
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags) {
+  (void) thread_id;
+  threadFlags |= flags;
+  return threadFlags;
+}
+
+uint32_t osThreadFlagsClear(uint32_t flags) {
+  const uint32_t previous = threadFlags;
+  threadFlags &= ~flags;
+  return previous;
+}
+
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout) {
+  (void) options;
+
+  if ((threadFlags & flags) == 0 && onFlagsWait != NULL) onFlagsWait();
+
+  const uint32_t set = threadFlags & flags;
+
+  if (set == 0) {
+    tick += timeout;
+    return osFlagsErrorTimeout;
+  }
+
+  threadFlags &= ~set;
+  return set;
+}
+
+osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout) {
+  (void) msg_prio;
+  (void) timeout;
+  TEST_Queue_t *queue = (TEST_Queue_t *) mq_id;
+  osStatus_t status = osErrorResource;
+
+  pthread_mutex_lock(&queuesMutex);
+  if (queue->count < TEST_QUEUE_SIZE) {
+    queue->messages[queue->count++] = *(const message_t *) msg_ptr;
+    status = osOK;
+  }
+  pthread_mutex_unlock(&queuesMutex);
+
+  return status;
+}
+
+void vPortEnterCritical(void) {
+  pthread_mutex_lock(&criticalMutex);
+}
+
+void vPortExitCritical(void) {
+  pthread_mutex_unlock(&criticalMutex);
+}
+
+void setUp(void) {
+  memset(started, 0, sizeof(started));
+  startedCount = 0;
+  inFlight = 0;
+  inFlightMax = 0;
+  startResult = HAL_OK;
+  i2cError = HAL_I2C_ERROR_NONE;
+  peripheralInits = 0;
+  sclPulses = 0;
+  sdaState = GPIO_PIN_RESET;
+  sclMode = 0;
+  pollingCalls = 0;
+
+  tick = 1000;
+  kernelState = osKernelRunning;
+  threadFlags = 0;
+  onFlagsWait = NULL;
+
+  memset(queues, 0, sizeof(queues));
+  for (uint8_t id = 0; id < MAX_ACTORS; id++) {
+    actors[id] = (actor_t) {.actorId = id, .osMessageQueueId = &queues[id]};
+    ACTORS_LOOKUP_SystemRegistry[id] = &actors[id];
+  }
+}
+
+void tearDown(void) {
+  // the queue and the bus state outlive the test, the next one starts on the idle bus
+  for (uint32_t i = 0; i <= SENSORS_BUS_QUEUE_SIZE && __atomic_load_n(&inFlight, __ATOMIC_ACQUIRE) > 0; i++) {
+    completeReceive();
+  }
+}
+
+void test_SensorsBus_SubmitOnIdleBus_StartsTransferAtOnce(void) {
+  uint8_t buffer[2];
+  SensorsBus_Transaction_t transaction = readTransaction(buffer, 0x7E, LIGHT_SENSOR_ACTOR_ID, ACQUISITION_LUX_READ_DONE);
+
+  TEST_ASSERT_EQUAL_INT32(BSP_ERROR_NONE, SensorsBus_Submit(&transaction));
+
+  TEST_ASSERT_EQUAL_UINT32(1, startedCount);
+  TEST_ASSERT_EQUAL(TEST_MEM_READ, started[0].transfer);
+  TEST_ASSERT_EQUAL_HEX16(0x88, started[0].devAddr);
+  TEST_ASSERT_EQUAL_HEX16(0x7E, started[0].memAddress);
+  TEST_ASSERT_EQUAL_UINT16(I2C_MEMADD_SIZE_8BIT, started[0].memAddSize);
+  TEST_ASSERT_EQUAL_PTR(buffer, started[0].pData);
+
+  completeReceive();
+
+  message_t completion = takeMessage(LIGHT_SENSOR_ACTOR_ID);
+  TEST_ASSERT_EQUAL(ACQUISITION_LUX_READ_DONE, completion.event);
+  TEST_ASSERT_EQUAL_INT32(BSP_ERROR_NONE, (int32_t) completion.payload.value);
+}
+
+void test_SensorsBus_SubmitWhileBusy_ServedInSubmissionOrder(void) {
+  uint8_t buffers[3][2];
+
+  for (uint16_t i = 0; i < 3; i++) {
+    SensorsBus_Transaction_t transaction = readTransaction(buffers[i], i, ACQUISITION_ACTOR_ID, ACQUISITION_TH_READ_DONE + i);
+    SensorsBus_Submit(&transaction);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(1, startedCount);
+
+  for (uint16_t i = 0; i < 3; i++) {
+    TEST_ASSERT_EQUAL_PTR(buffers[i], started[i].pData);
+    completeReceive();
+    TEST_ASSERT_EQUAL(ACQUISITION_TH_READ_DONE + i, takeMessage(ACQUISITION_ACTOR_ID).event);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(3, startedCount);
+  TEST_ASSERT_EQUAL_UINT32(1, inFlightMax);
+}
+
+void test_SensorsBus_FullQueue_SubmitBusyUntilSlotFreed(void) {
+  uint8_t buffer[2];
+  SensorsBus_Transaction_t transaction = readTransaction(buffer, 0, ACQUISITION_ACTOR_ID, ACQUISITION_TH_READ_DONE);
+
+  // one on the bus, the rest fill the queue
+  for (uint32_t i = 0; i < SENSORS_BUS_QUEUE_SIZE + 1; i++) {
+    TEST_ASSERT_EQUAL_INT32(BSP_ERROR_NONE, SensorsBus_Submit(&transaction));
+  }
+  TEST_ASSERT_EQUAL_INT32(BSP_ERROR_BUSY, SensorsBus_Submit(&transaction));
+
+  completeReceive();
+  TEST_ASSERT_EQUAL_INT32(BSP_ERROR_NONE, SensorsBus_Submit(&transaction));
+  TEST_ASSERT_EQUAL_INT32(BSP_ERROR_BUSY, SensorsBus_Submit(&transaction));
+}
+
+void test_SensorsBus_QueuePositionsWrapAround_KeepOrder(void) {
+  static uint8_t buffers[5 * SENSORS_BUS_QUEUE_SIZE][2];
+  uint32_t submitted = 0;
+  uint32_t completed = 0;
+
+  // bursts of 5 leave the positions misaligned with the ring
+  while (completed < 5 * SENSORS_BUS_QUEUE_SIZE) {
+    for (uint32_t i = 0; i < 5; i++, submitted++) {
+      SensorsBus_Transaction_t transaction = readTransaction(buffers[submitted], 0, ACQUISITION_ACTOR_ID, ACQUISITION_TH_READ_DONE);
+      TEST_ASSERT_EQUAL_INT32(BSP_ERROR_NONE, SensorsBus_Submit(&transaction));
+    }
+    for (uint32_t i = 0; i < 5; i++, completed++) {
+      TEST_ASSERT_EQUAL_PTR(buffers[completed], started[completed].pData);
+      completeReceive();
+    }
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(5 * SENSORS_BUS_QUEUE_SIZE, startedCount);
+}
+
+void test_SensorsBus_TransferNotStarted_FailedAndNextStarted(void) {
+  uint8_t buffers[2][2];
+  SensorsBus_Transaction_t first = readTransaction(buffers[0], 0, ACQUISITION_ACTOR_ID, ACQUISITION_TH_READ_DONE);
+  SensorsBus_Transaction_t second = readTransaction(buffers[1], 0, ACQUISITION_ACTOR_ID, ACQUISITION_LUX_READ_DONE);
+
+  SensorsBus_Submit(&first);
+  startResult = HAL_ERROR;
+  SensorsBus_Submit(&second);
+  SensorsBus_Submit(&first);
+
+  completeReceive();
+
+  TEST_ASSERT_EQUAL(ACQUISITION_TH_READ_DONE, takeMessage(ACQUISITION_ACTOR_ID).event);
+  message_t failed = takeMessage(ACQUISITION_ACTOR_ID);
+  TEST_ASSERT_EQUAL(ACQUISITION_LUX_READ_DONE, failed.event);
+  TEST_ASSERT_EQUAL_INT32(BSP_ERROR_PERIPH_FAILURE, (int32_t) failed.payload.value);
+
+  // the third one is on the bus
+  TEST_ASSERT_EQUAL_UINT32(2, startedCount);
+  TEST_ASSERT_EQUAL_UINT32(1, inFlight);
+}
+
+void test_SensorsBus_TransferErrors_MappedToBspStatus(void) {
+  uint8_t buffer[2];
+  SensorsBus_Transaction_t transaction = readTransaction(buffer, 0, IMU_ACTOR_ID, ACQUISITION_FIFO_READ_DONE);
+
+  SensorsBus_Submit(&transaction);
+  i2cError = HAL_I2C_ERROR_AF;
+  completeTransfer(HAL_I2C_ErrorCallback);
+  TEST_ASSERT_EQUAL_INT32(BSP_ERROR_BUS_ACKNOWLEDGE_FAILURE, (int32_t) takeMessage(IMU_ACTOR_ID).payload.value);
+
+  SensorsBus_Submit(&transaction);
+  i2cError = HAL_I2C_ERROR_ARLO;
+  completeTransfer(HAL_I2C_ErrorCallback);
+  TEST_ASSERT_EQUAL_INT32(BSP_ERROR_PERIPH_FAILURE, (int32_t) takeMessage(IMU_ACTOR_ID).payload.value);
+}
+
+void test_SensorsBus_RecoverBeforeTimeout_TransferKept(void) {
+  uint8_t buffer[2];
+  SensorsBus_Transaction_t transaction = readTransaction(buffer, 0, ACQUISITION_ACTOR_ID, ACQUISITION_TH_READ_DONE);
+
+  SensorsBus_Submit(&transaction);
+  tick += SENSORS_BUS_TRANSACTION_TIMEOUT_MS - 1;
+  SensorsBus_RecoverStalled();
+
+  TEST_ASSERT_EQUAL_UINT32(0, peripheralInits);
+  TEST_ASSERT_EQUAL_UINT32(1, inFlight);
+  TEST_ASSERT_EQUAL_UINT32(0, queues[ACQUISITION_ACTOR_ID].count);
+}
+
+void test_SensorsBus_StalledTransfer_BusClearedFailedAndNextStarted(void) {
+  uint8_t buffers[2][2];
+  SensorsBus_Transaction_t stalled = readTransaction(buffers[0], 0, ACQUISITION_ACTOR_ID, ACQUISITION_TH_READ_DONE);
+  SensorsBus_Transaction_t next = readTransaction(buffers[1], 0, ACQUISITION_ACTOR_ID, ACQUISITION_LUX_READ_DONE);
+
+  SensorsBus_Submit(&stalled);
+  SensorsBus_Submit(&next);
+  tick += SENSORS_BUS_TRANSACTION_TIMEOUT_MS;
+  SensorsBus_RecoverStalled();
+
+  // the byte and its ACK are clocked out, then the STOP, the pins are back to I2C1
+  TEST_ASSERT_EQUAL_UINT32(SENSORS_BUS_CLEAR_PULSES + 1, sclPulses);
+  TEST_ASSERT_EQUAL(GPIO_PIN_SET, sdaState);
+  TEST_ASSERT_EQUAL_UINT32(GPIO_MODE_AF_OD, sclMode);
+  TEST_ASSERT_EQUAL_UINT32(1, peripheralInits);
+
+  message_t failed = takeMessage(ACQUISITION_ACTOR_ID);
+  TEST_ASSERT_EQUAL(ACQUISITION_TH_READ_DONE, failed.event);
+  TEST_ASSERT_EQUAL_INT32(BSP_ERROR_BUS_FAILURE, (int32_t) failed.payload.value);
+
+  TEST_ASSERT_EQUAL_UINT32(2, startedCount);
+  TEST_ASSERT_EQUAL_PTR(buffers[1], started[1].pData);
+}
+
+void test_SensorsBus_BlockingReadBeforeScheduler_Polled(void) {
+  uint8_t buffer[2];
+  kernelState = osKernelInactive;
+
+  TEST_ASSERT_EQUAL_INT32(BSP_ERROR_NONE, SensorsBus_ReadReg(0x88, 0x01, buffer, sizeof(buffer)));
+
+  TEST_ASSERT_EQUAL_UINT32(1, pollingCalls);
+  TEST_ASSERT_EQUAL_UINT32(0, startedCount);
+}
+
+void test_SensorsBus_BlockingRead_SleepsUntilCompletion(void) {
+  uint8_t buffer[2];
+  onFlagsWait = completeReceive;
+
+  TEST_ASSERT_EQUAL_INT32(BSP_ERROR_NONE, SensorsBus_ReadReg(0x88, 0x01, buffer, sizeof(buffer)));
+
+  TEST_ASSERT_EQUAL_UINT32(1, startedCount);
+  TEST_ASSERT_EQUAL_UINT32(0, inFlight);
+}
+
+void test_SensorsBus_BlockingReadOnStalledBus_FailedOnWaitTimeout(void) {
+  uint8_t buffer[2];
+
+  TEST_ASSERT_EQUAL_INT32(BSP_ERROR_BUS_FAILURE, SensorsBus_ReadReg(0x88, 0x01, buffer, sizeof(buffer)));
+
+  TEST_ASSERT_EQUAL_UINT32(1, peripheralInits);
+}
+
+static uint8_t producerBuffers[TEST_PRODUCERS_COUNT][TEST_PRODUCER_TRANSACTIONS];
+static volatile bool isProducing;
+
+static void *produceTransactions(void *argument) {
+  const uint32_t producer = (uint32_t) (uintptr_t) argument;
+
+  for (uint32_t i = 0; i < TEST_PRODUCER_TRANSACTIONS; i++) {
+    SensorsBus_Transaction_t transaction = readTransaction(&producerBuffers[producer][i], 0, (ACTOR_ID) (IMU_ACTOR_ID + producer), ACQUISITION_FIFO_READ_DONE);
+
+    while (SensorsBus_Submit(&transaction) == BSP_ERROR_BUSY) {
+      sched_yield();
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief The I2C interrupt: completes the transfer on the bus as soon as there is one
+ */
+static void *completeTransfers(void *argument) {
+  (void) argument;
+  uint32_t completed = 0;
+
+  while (completed < TEST_PRODUCERS_COUNT * TEST_PRODUCER_TRANSACTIONS) {
+    if (__atomic_load_n(&inFlight, __ATOMIC_ACQUIRE) == 0) {
+      sched_yield();
+      continue;
+    }
+
+    __atomic_sub_fetch(&inFlight, 1, __ATOMIC_RELEASE);
+    HAL_I2C_MemRxCpltCallback(&hi2c1);
+    completed++;
+  }
+
+  return NULL;
+}
+
+void test_SensorsBus_ConcurrentSubmitters_EveryTransactionOnceInProducerOrder(void) {
+  pthread_t producers[TEST_PRODUCERS_COUNT];
+  pthread_t interrupt;
+
+  pthread_create(&interrupt, NULL, completeTransfers, NULL);
+  for (uint32_t p = 0; p < TEST_PRODUCERS_COUNT; p++) {
+    pthread_create(&producers[p], NULL, produceTransactions, (void *) (uintptr_t) p);
+  }
+  for (uint32_t p = 0; p < TEST_PRODUCERS_COUNT; p++) {
+    pthread_join(producers[p], NULL);
+  }
+  pthread_join(interrupt, NULL);
+
+  TEST_ASSERT_EQUAL_UINT32(TEST_PRODUCERS_COUNT * TEST_PRODUCER_TRANSACTIONS, startedCount);
+  TEST_ASSERT_EQUAL_UINT32(1, inFlightMax);
+
+  // every buffer once, each producer's in its submission order
+  uint32_t nextIndex[TEST_PRODUCERS_COUNT] = {0};
+
+  for (uint32_t i = 0; i < startedCount; i++) {
+    const uint32_t offset = (uint32_t) (started[i].pData - &producerBuffers[0][0]);
+    const uint32_t producer = offset / TEST_PRODUCER_TRANSACTIONS;
+
+    TEST_ASSERT_TRUE(producer < TEST_PRODUCERS_COUNT);
+    TEST_ASSERT_EQUAL_UINT32(nextIndex[producer], offset % TEST_PRODUCER_TRANSACTIONS);
+    nextIndex[producer]++;
+  }
+
+  for (uint32_t p = 0; p < TEST_PRODUCERS_COUNT; p++) {
+    TEST_ASSERT_EQUAL_UINT32(TEST_PRODUCER_TRANSACTIONS, queues[IMU_ACTOR_ID + p].count);
+  }
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_SensorsBus_SubmitOnIdleBus_StartsTransferAtOnce);
+  RUN_TEST(test_SensorsBus_SubmitWhileBusy_ServedInSubmissionOrder);
+  RUN_TEST(test_SensorsBus_FullQueue_SubmitBusyUntilSlotFreed);
+  RUN_TEST(test_SensorsBus_QueuePositionsWrapAround_KeepOrder);
+  RUN_TEST(test_SensorsBus_TransferNotStarted_FailedAndNextStarted);
+  RUN_TEST(test_SensorsBus_TransferErrors_MappedToBspStatus);
+  RUN_TEST(test_SensorsBus_RecoverBeforeTimeout_TransferKept);
+  RUN_TEST(test_SensorsBus_StalledTransfer_BusClearedFailedAndNextStarted);
+  RUN_TEST(test_SensorsBus_BlockingReadBeforeScheduler_Polled);
+  RUN_TEST(test_SensorsBus_BlockingRead_SleepsUntilCompletion);
+  RUN_TEST(test_SensorsBus_BlockingReadOnStalledBus_FailedOnWaitTimeout);
+  RUN_TEST(test_SensorsBus_ConcurrentSubmitters_EveryTransactionOnceInProducerOrder);
+
+  return UNITY_END();
+}
@@ -0,0 +1,58 @@
+/*!
+ * @file bench_vibration_features.c
+ * @brief Host benchmark of the vibration features kernels over full FIFO windows
+ *
+ * Prints the time per window and, on x86, the TSC cycles per window. On the target the cycles of every
+ * window are traced by the acquisition scheduler (DWT cycle counter), see app/tasks/acquisition/README.md.
+ *
+ * @date 18/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "vibration_features.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYCLES() __rdtsc()
+#else
+#define BENCH_CYCLES() 0ULL
+#endif
+
+#define BENCH_WINDOWS (64)
+#define BENCH_ITERATIONS (20000)
+
+static int16_t windows[BENCH_WINDOWS][VIBRATION_MAX_SAMPLES * VIBRATION_AXES_COUNT];
+
+int main(void) {
+  VIBRATION_Features_t features;
+  volatile uint32_t sink = 0;
+  struct timespec start, end;
+
+  srand(1);
+  for (uint16_t w = 0; w < BENCH_WINDOWS; w++) {
+    for (uint16_t i = 0; i < VIBRATION_MAX_SAMPLES * VIBRATION_AXES_COUNT; i++) {
+      windows[w][i] = (int16_t) (rand() - RAND_MAX / 2);
+    }
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  unsigned long long startCycles = BENCH_CYCLES();
+
+  for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+    VIBRATION_ExtractFeatures(windows[i % BENCH_WINDOWS], VIBRATION_MAX_SAMPLES, &features);
+    sink += features.magnitudeMax;
+  }
+
+  unsigned long long cycles = BENCH_CYCLES() - startCycles;
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  double nanoseconds = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+
+  printf("vibration features, %d samples window: %.1f ns, %llu cycles per window\n",
+         VIBRATION_MAX_SAMPLES, nanoseconds / BENCH_ITERATIONS, cycles / BENCH_ITERATIONS);
+
+  return (sink == 0);
+}
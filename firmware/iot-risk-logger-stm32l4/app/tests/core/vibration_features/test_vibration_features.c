@@ -0,0 +1,175 @@
+/*!
+ * @file test_vibration_features.c
+ * @brief Unit tests for the fixed-point vibration features, checked against a straightforward 64 bit reference
+ *
+ * @date 18/10/2026
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "unity.h"
+#include "vibration_features.h"
+
+#define TEST_RANDOM_WINDOWS (500)
+
+static int16_t window[VIBRATION_MAX_SAMPLES * VIBRATION_AXES_COUNT];
+static VIBRATION_Features_t features;
+
+void setUp(void) {
+  srand(42);
+}
+
+void tearDown(void) {}
+
+static int16_t sampleAt(uint8_t i, uint8_t axis) {
+  return window[i * VIBRATION_AXES_COUNT + axis];
+}
+
+static int16_t saturate(int32_t value) {
+  if (value > INT16_MAX) return INT16_MAX;
+  if (value < INT16_MIN) return INT16_MIN;
+  return (int16_t) value;
+}
+
+static void assertMatchesReference(uint8_t count) {
+  double magnitudeMax = 0;
+
+  for (uint8_t i = 0; i < count; i++) {
+    double x = sampleAt(i, 0), y = sampleAt(i, 1), z = sampleAt(i, 2);
+    double magnitude = sqrt(x * x + y * y + z * z);
+    if (magnitude > magnitudeMax) magnitudeMax = magnitude;
+  }
+  TEST_ASSERT_EQUAL_UINT16((uint16_t) floor(magnitudeMax), features.magnitudeMax);
+
+  for (uint8_t axis = 0; axis < VIBRATION_AXES_COUNT; axis++) {
+    int64_t sum = 0;
+    int16_t min = INT16_MAX, max = INT16_MIN;
+
+    for (uint8_t i = 0; i < count; i++) {
+      sum += sampleAt(i, axis);
+      if (sampleAt(i, axis) < min) min = sampleAt(i, axis);
+      if (sampleAt(i, axis) > max) max = sampleAt(i, axis);
+    }
+    int16_t mean = (int16_t) (sum / count);
+
+    uint64_t squares = 0;
+    int8_t side = 0;
+    uint8_t crossings = 0;
+    for (uint8_t i = 0; i < count; i++) {
+      int32_t deviation = sampleAt(i, axis) - mean;
+      squares += (uint64_t) ((int64_t) saturate(deviation) * saturate(deviation));
+
+      if (deviation > VIBRATION_ZERO_CROSSING_HYSTERESIS) {
+        crossings += (side < 0);
+        side = 1;
+      } else if (deviation < -VIBRATION_ZERO_CROSSING_HYSTERESIS) {
+        crossings += (side > 0);
+        side = -1;
+      }
+    }
+
+    TEST_ASSERT_EQUAL_INT16(mean, features.mean[axis]);
+    TEST_ASSERT_EQUAL_UINT16((uint16_t) floor(sqrt((double) (squares / count))), features.rms[axis]);
+    TEST_ASSERT_EQUAL_UINT16((uint16_t) (max - min), features.peakToPeak[axis]);
+    TEST_ASSERT_EQUAL_UINT8(crossings, features.zeroCrossings[axis]);
+  }
+}
+
+void test_VibrationFeatures_EmptyWindow_ZeroFeatures(void) {
+  features.magnitudeMax = 1;
+
+  VIBRATION_ExtractFeatures(window, 0, &features);
+
+  TEST_ASSERT_EQUAL_UINT16(0, features.magnitudeMax);
+  TEST_ASSERT_EQUAL_UINT16(0, features.rms[0]);
+}
+
+void test_VibrationFeatures_ConstantWindow_NoVibration(void) {
+  for (uint8_t i = 0; i < VIBRATION_MAX_SAMPLES; i++) {
+    window[i * 3 + 0] = 0;
+    window[i * 3 + 1] = 0;
+    window[i * 3 + 2] = 16384; // 1g at ±2g
+  }
+
+  VIBRATION_ExtractFeatures(window, VIBRATION_MAX_SAMPLES, &features);
+
+  TEST_ASSERT_EQUAL_INT16(16384, features.mean[2]);
+  TEST_ASSERT_EQUAL_UINT16(0, features.rms[2]);
+  TEST_ASSERT_EQUAL_UINT16(0, features.peakToPeak[2]);
+  TEST_ASSERT_EQUAL_UINT8(0, features.zeroCrossings[2]);
+  TEST_ASSERT_EQUAL_UINT16(16384, features.magnitudeMax);
+}
+
+void test_VibrationFeatures_SquareWave_CountsCrossings(void) {
+  for (uint8_t i = 0; i < VIBRATION_MAX_SAMPLES; i++) {
+    window[i * 3 + 0] = (i & 1) ? 4096 : -4096;
+    window[i * 3 + 1] = 0;
+    window[i * 3 + 2] = 0;
+  }
+
+  VIBRATION_ExtractFeatures(window, VIBRATION_MAX_SAMPLES, &features);
+
+  TEST_ASSERT_EQUAL_INT16(0, features.mean[0]);
+  TEST_ASSERT_EQUAL_UINT16(4096, features.rms[0]);
+  TEST_ASSERT_EQUAL_UINT16(8192, features.peakToPeak[0]);
+  TEST_ASSERT_EQUAL_UINT8(VIBRATION_MAX_SAMPLES - 1, features.zeroCrossings[0]);
+}
+
+void test_VibrationFeatures_FullScale_NoOverflow(void) {
+  for (uint8_t i = 0; i < VIBRATION_MAX_SAMPLES; i++) {
+    int16_t value = (i & 1) ? INT16_MAX : INT16_MIN;
+    window[i * 3 + 0] = value;
+    window[i * 3 + 1] = value;
+    window[i * 3 + 2] = value;
+  }
+
+  VIBRATION_ExtractFeatures(window, VIBRATION_MAX_SAMPLES, &features);
+
+  assertMatchesReference(VIBRATION_MAX_SAMPLES);
+  TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, features.peakToPeak[0]);
+}
+
+void test_VibrationFeatures_RandomWindows_MatchReference(void) {
+  for (uint16_t run = 0; run < TEST_RANDOM_WINDOWS; run++) {
+    uint8_t count = 1 + rand() % VIBRATION_MAX_SAMPLES; // odd counts exercise the scalar tail
+    int32_t amplitude = 1 + rand() % 32768;
+
+    for (uint16_t i = 0; i < count * VIBRATION_AXES_COUNT; i++) {
+      window[i] = saturate((rand() % (2 * amplitude + 1)) - amplitude);
+    }
+
+    VIBRATION_ExtractFeatures(window, count, &features);
+    assertMatchesReference(count);
+  }
+}
+
+void test_VibrationFeatures_Summarize_DominantAxis(void) {
+  VIBRATION_Summary_t summary;
+  features = (VIBRATION_Features_t) {
+    .rms = {256, 1024, 512},
+    .peakToPeak = {8192, 4096, 65535},
+    .zeroCrossings = {1, 7, 3},
+    .magnitudeMax = 56755,
+  };
+
+  VIBRATION_Summarize(&features, &summary);
+
+  TEST_ASSERT_EQUAL_UINT8(4, summary.rms);
+  TEST_ASSERT_EQUAL_UINT8(255, summary.peakToPeak);
+  TEST_ASSERT_EQUAL_UINT8(221, summary.magnitudeMax);
+  TEST_ASSERT_EQUAL_UINT8(7, summary.zeroCrossings);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_VibrationFeatures_EmptyWindow_ZeroFeatures);
+  RUN_TEST(test_VibrationFeatures_ConstantWindow_NoVibration);
+  RUN_TEST(test_VibrationFeatures_SquareWave_CountsCrossings);
+  RUN_TEST(test_VibrationFeatures_FullScale_NoOverflow);
+  RUN_TEST(test_VibrationFeatures_RandomWindows_MatchReference);
+  RUN_TEST(test_VibrationFeatures_Summarize_DominantAxis);
+
+  return UNITY_END();
+}
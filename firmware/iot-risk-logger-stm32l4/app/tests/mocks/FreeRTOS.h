@@ -0,0 +1,24 @@
+/*!
+ * @file FreeRTOS.h
+ * @brief Mock FreeRTOS header, the static allocation types and the tick rate of Core/Inc/FreeRTOSConfig.h
+ *
+ * @date 18/10/2026
+ */
+
+#ifndef MOCK_FREERTOS_H
+#define MOCK_FREERTOS_H
+
+#include <stdint.h>
+
+#define configTICK_RATE_HZ    ((uint32_t) 1000)
+#define pdMS_TO_TICKS(ms)     ((uint32_t) (((uint64_t) (ms) * configTICK_RATE_HZ) / 1000U))
+
+typedef struct {
+  uint8_t reserved[96];
+} StaticTask_t;
+
+typedef struct {
+  uint8_t reserved[48];
+} StaticTimer_t;
+
+#endif /* MOCK_FREERTOS_H */
@@ -0,0 +1,57 @@
+/*!
+ * @file cmsis_os2.h
+ * @brief Mock CMSIS-RTOS2 header, lets app modules including "cmsis_os2.h" build on host
+ *
+ * Only the prototypes are declared, a test linking an actor provides the kernel, e.g. tasks/nfc/nfc_harness.c
+ *
+ * @date 18/10/2026
+ */
+
+#ifndef MOCK_CMSIS_OS2_H
+#define MOCK_CMSIS_OS2_H
+
+#include <sys/types.h>
+
+#include "mock_hal.h"
+
+#define osWaitForever         0xFFFFFFFFU ///< Wait forever timeout value.
+
+typedef void * osTimerId_t;
+typedef void (*osTimerFunc_t)(void *argument);
+
+typedef enum {
+  osTimerOnce               = 0,          ///< One-shot timer.
+  osTimerPeriodic           = 1           ///< Repeating timer.
+} osTimerType_t;
+
+typedef struct {
+  const char *name;
+  uint32_t attr_bits;
+  void *cb_mem;
+  uint32_t cb_size;
+} osTimerAttr_t;
+
+typedef enum {
+  osKernelInactive          =  0,         ///< Inactive.
+  osKernelReady             =  1,         ///< Ready.
+  osKernelRunning           =  2,         ///< Running.
+} osKernelState_t;
+
+int32_t osKernelLock(void);
+int32_t osKernelRestoreLock(int32_t lock);
+uint32_t osKernelGetTickCount(void);
+osKernelState_t osKernelGetState(void);
+osThreadId_t osThreadGetId(void);
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags);
+uint32_t osThreadFlagsClear(uint32_t flags);
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout);
+osThreadId_t osThreadNew(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr);
+osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr);
+osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout);
+osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout);
+uint32_t osMessageQueueGetCount(osMessageQueueId_t mq_id);
+osTimerId_t osTimerNew(osTimerFunc_t func, osTimerType_t type, void *argument, const osTimerAttr_t *attr);
+osStatus_t osTimerStart(osTimerId_t timer_id, uint32_t ticks);
+osStatus_t osTimerStop(osTimerId_t timer_id);
+
+#endif /* MOCK_CMSIS_OS2_H */
@@ -0,0 +1,44 @@
+/*!
+ * @file custom_bus.h
+ * @brief Mock BSP bus header, the I2C1 functions registered as the ST25DV IO and used by the sensors bus
+ *
+ * @date 18/10/2026
+ */
+
+#ifndef MOCK_CUSTOM_BUS_H
+#define MOCK_CUSTOM_BUS_H
+
+#include <stdint.h>
+
+#include "mock_hal.h"
+
+/* BSP Common Error codes, as in Core/Inc/custom_errno.h */
+#define BSP_ERROR_NONE                    0
+#define BSP_ERROR_NO_INIT                -1
+#define BSP_ERROR_WRONG_PARAM            -2
+#define BSP_ERROR_BUSY                   -3
+#define BSP_ERROR_PERIPH_FAILURE         -4
+#define BSP_ERROR_COMPONENT_FAILURE      -5
+#define BSP_ERROR_BUS_FAILURE            -8
+#define BSP_ERROR_BUS_ACKNOWLEDGE_FAILURE    -102
+
+extern GPIO_TypeDef MOCK_GPIOA;
+
+#define BUS_I2C1_SCL_GPIO_PORT  (&MOCK_GPIOA)
+#define BUS_I2C1_SCL_GPIO_PIN   (1U << 9)
+#define BUS_I2C1_SCL_GPIO_AF    4U
+#define BUS_I2C1_SDA_GPIO_PORT  (&MOCK_GPIOA)
+#define BUS_I2C1_SDA_GPIO_PIN   (1U << 10)
+#define BUS_I2C1_SDA_GPIO_AF    4U
+
+int32_t BSP_I2C1_Init(void);
+int32_t BSP_I2C1_DeInit(void);
+int32_t BSP_I2C1_IsReady(uint16_t DevAddr, uint32_t Trials);
+int32_t BSP_I2C1_WriteReg(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint16_t Length);
+int32_t BSP_I2C1_ReadReg(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint16_t Length);
+int32_t BSP_I2C1_WriteReg16(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint16_t Length);
+int32_t BSP_I2C1_ReadReg16(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint16_t Length);
+int32_t BSP_I2C1_Send(uint16_t DevAddr, uint8_t *pData, uint16_t Length);
+int32_t BSP_I2C1_Recv(uint16_t DevAddr, uint8_t *pData, uint16_t Length);
+
+#endif /* MOCK_CUSTOM_BUS_H */
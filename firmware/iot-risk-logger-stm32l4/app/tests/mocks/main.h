@@ -0,0 +1,23 @@
+/*!
+ * @file main.h
+ * @brief Mock of Core/Inc/main.h for the host builds of the actors, the same application headers in the same order
+ * without the SEGGER and the CubeMX peripherals
+ *
+ * @date 18/10/2026
+ */
+
+#ifndef MOCK_MAIN_H
+#define MOCK_MAIN_H
+
+#include "stm32l4xx_hal.h"
+
+#include "actor.h"
+#include "actor_timer.h"
+#include "trace_log.h"
+#include "event_manager.h"
+#include "nfc.h"
+#include "memory.h"
+#include "acquisition.h"
+#include "sensors_bus.h"
+
+#endif /* MOCK_MAIN_H */
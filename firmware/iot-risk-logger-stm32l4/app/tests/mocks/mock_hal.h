@@ -40,6 +40,51 @@ typedef struct {
 #define HAL_I2C_ERROR_SIZE      0x00000040U
 #define HAL_I2C_ERROR_DMA_PARAM 0x00000080U
 
+/* I2C interrupt transfers, the completion callbacks are called by the test */
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2CEx_ConfigAnalogFilter(I2C_HandleTypeDef *hi2c, uint32_t AnalogFilter);
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+
+#define I2C_ANALOGFILTER_ENABLE 0x00000000U
+
+/* GPIO */
+typedef struct {
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+typedef enum {
+    GPIO_PIN_RESET = 0U,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct {
+    uint32_t ODR;
+} GPIO_TypeDef;
+
+#define GPIO_MODE_OUTPUT_OD         0x00000011U
+#define GPIO_MODE_AF_OD             0x00000012U
+#define GPIO_NOPULL                 0x00000000U
+#define GPIO_SPEED_FREQ_VERY_HIGH   0x00000003U
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+
+extern uint32_t SystemCoreClock;
+
 /* RTOS Status */
 typedef enum {
     osOK                    =  0,
@@ -97,4 +142,8 @@ typedef enum {
 #define osFlagsWaitAll          0x00000001U
 #define osFlagsNoClear          0x00000002U
 
+/* Flags errors */
+#define osFlagsError            0x80000000U
+#define osFlagsErrorTimeout     0xFFFFFFFEU
+
 #endif /* MOCK_HAL_H */
@@ -0,0 +1,13 @@
+/*!
+ * @file quadspi.h
+ * @brief Mock QUADSPI header, the NOR Flash is modelled by the test linking the module
+ *
+ * @date 18/10/2026
+ */
+
+#ifndef MOCK_QUADSPI_H
+#define MOCK_QUADSPI_H
+
+#include "mock_hal.h"
+
+#endif /* MOCK_QUADSPI_H */
@@ -0,0 +1,32 @@
+/*!
+ * @file stm32l4xx_hal.h
+ * @brief Mock STM32L4 HAL header: the HAL tick, the DWT cycle counter and the QUADSPI memory-mapped window
+ *
+ * A test linking the module provides the MOCK_DWT and HAL_GetTick() definitions.
+ *
+ * @date 18/10/2026
+ */
+
+#ifndef MOCK_STM32L4XX_HAL_H
+#define MOCK_STM32L4XX_HAL_H
+
+#include <assert.h>
+
+#include "mock_hal.h"
+
+#define QSPI_BASE             (0x90000000UL)
+
+#define assert_param(expr)    assert(expr)
+#define UNUSED(X)             (void)X ///< As in stm32l4xx_hal_def.h
+
+typedef struct {
+  volatile uint32_t CTRL;
+  volatile uint32_t CYCCNT;
+} DWT_Type;
+
+extern DWT_Type MOCK_DWT;
+#define DWT                   (&MOCK_DWT)
+
+uint32_t HAL_GetTick(void);
+
+#endif /* MOCK_STM32L4XX_HAL_H */
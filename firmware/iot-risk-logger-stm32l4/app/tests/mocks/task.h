@@ -0,0 +1,21 @@
+/*!
+ * @file task.h
+ * @brief Mock FreeRTOS task header, the app modules use the CMSIS-RTOS2 API and the critical sections only
+ *
+ * A test linking a module with the critical sections provides vPortEnterCritical() and vPortExitCritical()
+ *
+ * @date 18/10/2026
+ */
+
+#ifndef MOCK_TASK_H
+#define MOCK_TASK_H
+
+#include "FreeRTOS.h"
+
+void vPortEnterCritical(void);
+void vPortExitCritical(void);
+
+#define taskENTER_CRITICAL()  vPortEnterCritical()
+#define taskEXIT_CRITICAL()   vPortExitCritical()
+
+#endif /* MOCK_TASK_H */
@@ -0,0 +1,13 @@
+/*!
+ * @file w25q.h
+ * @brief Mock W25Q NOR Flash driver header, the NOR Flash is modelled by the test linking the module
+ *
+ * @date 18/10/2026
+ */
+
+#ifndef MOCK_W25Q_H
+#define MOCK_W25Q_H
+
+#include "mock_hal.h"
+
+#endif /* MOCK_W25Q_H */
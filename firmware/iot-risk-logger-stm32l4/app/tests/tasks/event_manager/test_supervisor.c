@@ -0,0 +1,143 @@
+/*!
+ * @file test_supervisor.c
+ * @brief Tests of the supervisor restart backoff through the Event Manager, on the NFC actor harness kernel
+ *
+ * The supervised actor is the MEMORY model of the harness: it has a task and ignores GLOBAL_CMD_RESTART, so the
+ * restarts are counted without side effects.
+ *
+ * @date 18/10/2026
+ */
+
+#include "unity.h"
+#include "nfc_harness.h"
+#include "supervisor.h"
+
+#define TEST_LOG_ENTRIES       (16U)
+#define TEST_MEMORY_LATENCY_MS (10U)
+#define TEST_BACKOFF_MAX_MS    (SUPERVISOR_BACKOFF_BASE_MS << SUPERVISOR_BACKOFF_MAX_SHIFT)
+
+static void failActor(ACTOR_ID actorId) {
+  osMessageQueuePut(EV_MANAGER_Actor.super.osMessageQueueId, &(message_t){GLOBAL_ERROR, .payload.value = actorId}, 0, 0);
+  NFC_HARNESS_Run();
+}
+
+/**
+ * @brief Checks the restart is sent exactly after the backoff
+ */
+static void expectRestartAfter(ACTOR_ID actorId, uint32_t backoffMs) {
+  const uint32_t restartsCount = SUPERVISOR_GetRestartsCount(actorId);
+
+  NFC_HARNESS_Advance(backoffMs - 1);
+  TEST_ASSERT_EQUAL_UINT32(restartsCount, SUPERVISOR_GetRestartsCount(actorId));
+
+  NFC_HARNESS_Advance(1);
+  TEST_ASSERT_EQUAL_UINT32(restartsCount + 1, SUPERVISOR_GetRestartsCount(actorId));
+}
+
+void setUp(void) {
+  NFC_HARNESS_Init(TEST_LOG_ENTRIES, TEST_MEMORY_LATENCY_MS);
+
+  // the errors of the previous test are forgotten, the backoff starts from the base
+  NFC_HARNESS_Advance(SUPERVISOR_BACKOFF_RESET_MS + TEST_BACKOFF_MAX_MS);
+}
+
+void tearDown(void) {}
+
+void test_Supervisor_FirstError_RestartedAfterBaseBackoff(void) {
+  failActor(MEMORY_ACTOR_ID);
+
+  expectRestartAfter(MEMORY_ACTOR_ID, SUPERVISOR_BACKOFF_BASE_MS);
+}
+
+void test_Supervisor_ConsecutiveErrors_BackoffDoubles(void) {
+  for (uint32_t shift = 0; shift < 4; shift++) {
+    failActor(MEMORY_ACTOR_ID);
+    expectRestartAfter(MEMORY_ACTOR_ID, SUPERVISOR_BACKOFF_BASE_MS << shift);
+  }
+}
+
+void test_Supervisor_ManyConsecutiveErrors_BackoffCapped(void) {
+  for (uint32_t shift = 0; shift < SUPERVISOR_BACKOFF_MAX_SHIFT; shift++) {
+    failActor(MEMORY_ACTOR_ID);
+    NFC_HARNESS_Advance(SUPERVISOR_BACKOFF_BASE_MS << shift);
+  }
+
+  failActor(MEMORY_ACTOR_ID);
+  expectRestartAfter(MEMORY_ACTOR_ID, TEST_BACKOFF_MAX_MS);
+
+  failActor(MEMORY_ACTOR_ID);
+  expectRestartAfter(MEMORY_ACTOR_ID, TEST_BACKOFF_MAX_MS);
+}
+
+void test_Supervisor_QuietPeriod_BackoffStartsFromBase(void) {
+  failActor(MEMORY_ACTOR_ID);
+  expectRestartAfter(MEMORY_ACTOR_ID, SUPERVISOR_BACKOFF_BASE_MS);
+  failActor(MEMORY_ACTOR_ID);
+  expectRestartAfter(MEMORY_ACTOR_ID, 2 * SUPERVISOR_BACKOFF_BASE_MS);
+
+  NFC_HARNESS_Advance(SUPERVISOR_BACKOFF_RESET_MS + 1);
+
+  failActor(MEMORY_ACTOR_ID);
+  expectRestartAfter(MEMORY_ACTOR_ID, SUPERVISOR_BACKOFF_BASE_MS);
+}
+
+void test_Supervisor_ErrorsWhileRestartPending_Ignored(void) {
+  failActor(MEMORY_ACTOR_ID);
+  NFC_HARNESS_Advance(SUPERVISOR_BACKOFF_BASE_MS / 2);
+  failActor(MEMORY_ACTOR_ID);
+  failActor(MEMORY_ACTOR_ID);
+
+  // the pending restart keeps its deadline and is sent once
+  expectRestartAfter(MEMORY_ACTOR_ID, SUPERVISOR_BACKOFF_BASE_MS / 2);
+  const uint32_t restartsCount = SUPERVISOR_GetRestartsCount(MEMORY_ACTOR_ID);
+  NFC_HARNESS_Advance(TEST_BACKOFF_MAX_MS);
+  TEST_ASSERT_EQUAL_UINT32(restartsCount, SUPERVISOR_GetRestartsCount(MEMORY_ACTOR_ID));
+
+  // the ignored errors aren't counted in the backoff
+  failActor(MEMORY_ACTOR_ID);
+  expectRestartAfter(MEMORY_ACTOR_ID, 2 * SUPERVISOR_BACKOFF_BASE_MS);
+}
+
+void test_Supervisor_ActorsWithoutTaskOrEventManager_NotRestarted(void) {
+  // the light sensor is a sink without a task in the harness, as the Cron actor on the target
+  failActor(LIGHT_SENSOR_ACTOR_ID);
+  failActor(EV_MANAGER_ACTOR_ID);
+  failActor(MAX_ACTORS);
+
+  NFC_HARNESS_Advance(TEST_BACKOFF_MAX_MS);
+
+  TEST_ASSERT_EQUAL_UINT32(0, SUPERVISOR_GetRestartsCount(LIGHT_SENSOR_ACTOR_ID));
+  TEST_ASSERT_EQUAL_UINT32(0, SUPERVISOR_GetRestartsCount(EV_MANAGER_ACTOR_ID));
+  TEST_ASSERT_EQUAL_UINT32(0, SUPERVISOR_GetRestartsCount(MAX_ACTORS));
+}
+
+void test_Supervisor_ActorsBackoffs_Independent(void) {
+  failActor(MEMORY_ACTOR_ID);
+  expectRestartAfter(MEMORY_ACTOR_ID, SUPERVISOR_BACKOFF_BASE_MS);
+  failActor(MEMORY_ACTOR_ID);
+
+  // NFC's first error has the base backoff while MEMORY waits for the doubled one
+  const uint32_t memoryRestartsCount = SUPERVISOR_GetRestartsCount(MEMORY_ACTOR_ID);
+  NFC_Actor.state = NFC_STATE_ERROR;
+  failActor(NFC_ACTOR_ID);
+
+  expectRestartAfter(NFC_ACTOR_ID, SUPERVISOR_BACKOFF_BASE_MS);
+  TEST_ASSERT_NOT_EQUAL(NFC_STATE_ERROR, NFC_Actor.state);
+  TEST_ASSERT_EQUAL_UINT32(memoryRestartsCount, SUPERVISOR_GetRestartsCount(MEMORY_ACTOR_ID));
+
+  expectRestartAfter(MEMORY_ACTOR_ID, SUPERVISOR_BACKOFF_BASE_MS);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_Supervisor_FirstError_RestartedAfterBaseBackoff);
+  RUN_TEST(test_Supervisor_ConsecutiveErrors_BackoffDoubles);
+  RUN_TEST(test_Supervisor_ManyConsecutiveErrors_BackoffCapped);
+  RUN_TEST(test_Supervisor_QuietPeriod_BackoffStartsFromBase);
+  RUN_TEST(test_Supervisor_ErrorsWhileRestartPending_Ignored);
+  RUN_TEST(test_Supervisor_ActorsWithoutTaskOrEventManager_NotRestarted);
+  RUN_TEST(test_Supervisor_ActorsBackoffs_Independent);
+
+  return UNITY_END();
+}
@@ -0,0 +1,146 @@
+/*!
+ * @file bench_nfc.c
+ * @brief Host benchmark of the NFC mailbox protocol through the full actor path
+ *
+ * The phone drives the real NFC actor over the simulated ST25DV (see nfc_harness.h), the numbers are the host
+ * throughput of the firmware code path: the commands per second pipelined and one at a time, the log chunks stream
+ * and the FTM export in entries and raw log bytes per second. The I2C traffic per command is the target cost that
+ * doesn't depend on the host, the protocol changes are compared by it.
+ *
+ * @date 18/10/2026
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "nfc_harness.h"
+#include "log_codec.h"
+
+#define BENCH_COMMANDS_COUNT     (200000U)
+#define BENCH_LOG_ENTRIES        (NFC_HARNESS_LOG_ENTRIES_MAX)
+#define BENCH_STREAMS_COUNT      (20U)
+#define BENCH_MEMORY_LATENCY_MS  (1U)
+
+static uint8_t frame[ST25DV_MAX_MAILBOX_LENGTH];
+static uint8_t response[ST25DV_MAX_MAILBOX_LENGTH];
+
+static double elapsedSeconds(const struct timespec *start) {
+  struct timespec end;
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  return (end.tv_sec - start->tv_sec) + (end.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+static void expectResponse(uint8_t sequence) {
+  const uint16_t size = NFC_HARNESS_PhoneRead(response);
+
+  if (!NFC_HARNESS_IsValidResponse(response, size) || response[NFC_MAILBOX_PROTOCOL_SEQ_ADDR] != sequence) {
+    fprintf(stderr, "unexpected response to %u\n", sequence);
+  }
+}
+
+/**
+ * @brief READ_SETTINGS round trips, the phone writes up to the depth commands before reading the responses
+ */
+static void benchCommands(const char *name, uint8_t depth) {
+  struct timespec start;
+  uint8_t sequence = 0;
+
+  NFC_HARNESS_Init(0, BENCH_MEMORY_LATENCY_MS);
+  const SIM_ST25DV_Stats_t before = *SIM_ST25DV_GetStats();
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (uint32_t i = 0; i < BENCH_COMMANDS_COUNT; i += depth) {
+    for (uint8_t j = 0; j < depth; j++) {
+      const uint16_t size = NFC_HARNESS_BuildFrame(frame, GLOBAL_CMD_READ_SETTINGS, (uint8_t) (sequence + j), NULL, 0);
+      NFC_HARNESS_PhoneWrite(frame, size);
+    }
+
+    NFC_HARNESS_Advance(BENCH_MEMORY_LATENCY_MS);
+
+    for (uint8_t j = 0; j < depth; j++) {
+      expectResponse(sequence++);
+    }
+  }
+
+  const double seconds = elapsedSeconds(&start);
+  const SIM_ST25DV_Stats_t *after = SIM_ST25DV_GetStats();
+
+  printf("%-28s %10.0f commands/s %8.2f MB/s RF, I2C per command: %.1f transactions, %.1f bytes\n",
+         name, BENCH_COMMANDS_COUNT / seconds, (after->rfBytes - before.rfBytes) / seconds / 1e6,
+         (double) (after->hostTransactions - before.hostTransactions) / BENCH_COMMANDS_COUNT,
+         (double) (after->hostBytes - before.hostBytes) / BENCH_COMMANDS_COUNT);
+}
+
+static void benchLogChunks(void) {
+  const NFC_LogExportRange_t range = {.firstEntry = 0, .entriesCount = 0};
+  struct timespec start;
+  uint32_t framesCount = 0;
+
+  NFC_HARNESS_Init(BENCH_LOG_ENTRIES, BENCH_MEMORY_LATENCY_MS);
+  const SIM_ST25DV_Stats_t before = *SIM_ST25DV_GetStats();
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (uint32_t i = 0; i < BENCH_STREAMS_COUNT; i++) {
+    const uint16_t size = NFC_HARNESS_BuildFrame(frame, GLOBAL_CMD_READ_LOG_CHUNK, (uint8_t) i, &range, sizeof(range));
+    NFC_HARNESS_PhoneWrite(frame, size);
+
+    for (;;) {
+      while (!SIM_ST25DV_HasHostMessage()) {
+        NFC_HARNESS_Advance(BENCH_MEMORY_LATENCY_MS);
+      }
+
+      NFC_HARNESS_PhoneRead(response);
+      framesCount++;
+
+      if (response[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR] == 0) break;
+    }
+  }
+
+  const double seconds = elapsedSeconds(&start);
+  const double entries = (double) BENCH_LOG_ENTRIES * BENCH_STREAMS_COUNT;
+  const SIM_ST25DV_Stats_t *after = SIM_ST25DV_GetStats();
+
+  printf("%-28s %10.0f entries/s %8.2f MB/s raw log, %.1f entries per frame, I2C per frame: %.1f bytes\n",
+         "log chunks stream", entries / seconds, entries * MEMORY_LOG_ENTRY_SIZE / seconds / 1e6,
+         entries / framesCount, (double) (after->hostBytes - before.hostBytes) / framesCount);
+}
+
+static void benchLogExport(void) {
+  const NFC_LogExportRange_t range = {.firstEntry = 0, .entriesCount = 0};
+  struct timespec start;
+  uint32_t length;
+
+  NFC_HARNESS_Init(BENCH_LOG_ENTRIES, BENCH_MEMORY_LATENCY_MS);
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (uint32_t i = 0; i < BENCH_STREAMS_COUNT; i++) {
+    const uint16_t size = NFC_HARNESS_BuildFrame(frame, GLOBAL_CMD_EXPORT_LOG, (uint8_t) i, &range, sizeof(range));
+    NFC_HARNESS_PhoneWrite(frame, size);
+
+    do {
+      NFC_HARNESS_Advance(NFC_LOG_EXPORT_POLL_PERIOD_MS);
+    } while (!NFC_HARNESS_IsIdle());
+  }
+
+  const double seconds = elapsedSeconds(&start);
+  const double entries = (double) BENCH_LOG_ENTRIES * BENCH_STREAMS_COUNT;
+
+  NFC_HARNESS_GetFTMReceived(&length);
+  if (NFC_HARNESS_GetStats()->ftmTransfers != BENCH_STREAMS_COUNT || length != BENCH_LOG_ENTRIES * MEMORY_LOG_ENTRY_SIZE) {
+    fprintf(stderr, "log export incomplete\n");
+  }
+
+  printf("%-28s %10.0f entries/s %8.2f MB/s raw log\n",
+         "log export (FTM)", entries / seconds, entries * MEMORY_LOG_ENTRY_SIZE / seconds / 1e6);
+}
+
+int main(void) {
+  benchCommands("settings read, one at a time", 1);
+  benchCommands("settings read, pipelined", NFC_COMMANDS_IN_FLIGHT);
+  benchLogChunks();
+  benchLogExport();
+
+  return 0;
+}
@@ -0,0 +1,308 @@
+/*!
+ * @file fuzz_nfc.c
+ * @brief Fuzzing of the NFC actor through the mailbox
+ *
+ * The input is the script of a phone session: the raw and the well-formed frames written to the mailbox, the reads,
+ * the time passing, the RF session holding the tag, the phone leaving and coming back, and the measurements frames.
+ * Every response the phone reads should be well-formed and answer a sequence the phone has sent; once the session is
+ * over the device should drain to idle and answer the next command. The sanitizers catch the rest.
+ *
+ * Built as the libFuzzer target with -DNFC_FUZZ_LIBFUZZER, otherwise main() replays the files given, the stdin
+ * (AFL) or the seeded random inputs:
+ * @code
+ * ./fuzz_nfc crash-file...
+ * ./fuzz_nfc < input
+ * ./fuzz_nfc --random 20000 [seed]
+ * @endcode
+ *
+ * @date 18/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nfc_harness.h"
+#include "supervisor.h"
+
+#define FUZZ_NFC_LOG_ENTRIES_STEP  (50U)
+#define FUZZ_NFC_DRAIN_STEP_MS     (20U)
+#define FUZZ_NFC_DRAIN_STEPS_MAX   (2U * (SUPERVISOR_BACKOFF_BASE_MS << SUPERVISOR_BACKOFF_MAX_SHIFT) / FUZZ_NFC_DRAIN_STEP_MS) ///< NFC failed in the session may wait for the longest restart backoff
+#define FUZZ_NFC_RANDOM_INPUT_MAX  (512U)
+
+typedef enum {
+  FUZZ_NFC_RAW_FRAME = 0,
+  FUZZ_NFC_COMMAND,
+  FUZZ_NFC_PHONE_READ,
+  FUZZ_NFC_ADVANCE,
+  FUZZ_NFC_RF_BUSY,
+  FUZZ_NFC_RF_BUSY_AFTER,
+  FUZZ_NFC_MEASUREMENTS_FRAME,
+  FUZZ_NFC_FIELD,
+  FUZZ_NFC_ACTIONS_COUNT
+} FUZZ_NFC_Action_t;
+
+typedef struct {
+  const uint8_t *data;
+  size_t size;
+} FUZZ_NFC_Input_t;
+
+static bool sentSequences[256];
+static uint8_t frame[ST25DV_MAX_MAILBOX_LENGTH];
+static uint8_t response[ST25DV_MAX_MAILBOX_LENGTH];
+static ACQUISITION_Frame_t measurementsFrames[2]; ///< Stays valid until delivered, as the ACQUISITION ones
+static uint32_t measurementsFrameIndex;
+
+static void check(bool condition, const char *message) {
+  if (condition) return;
+
+  fprintf(stderr, "fuzz_nfc: %s\n", message);
+  abort();
+}
+
+static uint8_t take(FUZZ_NFC_Input_t *input) {
+  if (input->size == 0) return 0;
+
+  input->size--;
+  return *input->data++;
+}
+
+static void phoneRead(void) {
+  const uint16_t size = NFC_HARNESS_PhoneRead(response);
+
+  if (size == 0) return;
+
+  check(NFC_HARNESS_IsValidResponse(response, size), "malformed response");
+  check(sentSequences[response[NFC_MAILBOX_PROTOCOL_SEQ_ADDR]], "response to a sequence never sent");
+}
+
+static void writeRawFrame(FUZZ_NFC_Input_t *input) {
+  const uint16_t size = (uint16_t) (take(input) + 1U);
+  const uint16_t available = (input->size < size) ? (uint16_t) input->size : size;
+
+  if (available == 0) return;
+
+  memcpy(frame, input->data, available);
+  input->data += available;
+  input->size -= available;
+
+  // a frame shorter than the header is answered with the SEQ 0, sent at the power up
+  if (available > NFC_MAILBOX_PROTOCOL_SEQ_ADDR) {
+    sentSequences[frame[NFC_MAILBOX_PROTOCOL_SEQ_ADDR]] = true;
+  }
+
+  NFC_HARNESS_PhoneWrite(frame, available);
+}
+
+/**
+ * @brief Frame passing the CRC, the payload is the input as is, the log ranges and the queries are mostly valid
+ */
+static void writeCommand(FUZZ_NFC_Input_t *input) {
+  const uint8_t command = (uint8_t) (GLOBAL_CMD_START_LOGGING + take(input) % 8U); // 0xC7 is out of the range
+  const uint8_t sequence = take(input);
+  uint8_t payload[ST25DV_MAX_MAILBOX_LENGTH - NFC_MAILBOX_PROTOCOL_HEADER_SIZE] = {0};
+  uint8_t payloadSize = take(input);
+
+  switch (command) {
+    case GLOBAL_CMD_WRITE_SETTINGS:
+      payloadSize = (payloadSize & 0x01U) ? payloadSize % sizeof(payload) : SETTINGS_DATA_SIZE;
+      break;
+    case GLOBAL_CMD_READ_LOG_CHUNK:
+    case GLOBAL_CMD_EXPORT_LOG: {
+      const NFC_LogExportRange_t range = {.firstEntry = take(input), .entriesCount = take(input)};
+      memcpy(payload, &range, sizeof(range));
+      payloadSize = (payloadSize & 0x01U) ? payloadSize % sizeof(payload) : sizeof(range);
+      break;
+    }
+    case GLOBAL_CMD_QUERY_LOG: {
+      const LOG_QUERY_Request_t request = {
+        .from = NFC_HARNESS_LOG_START_TIMESTAMP + (int32_t) take(input) * NFC_HARNESS_LOG_PERIOD_S,
+        .to = NFC_HARNESS_LOG_START_TIMESTAMP + (int32_t) take(input) * 2 * NFC_HARNESS_LOG_PERIOD_S,
+        .channel = (uint8_t) (take(input) % (LOG_QUERY_CHANNELS_COUNT + 1U)),
+        .threshold = (int32_t) take(input) * 40,
+      };
+      memcpy(payload, &request, sizeof(request));
+      payloadSize = (payloadSize & 0x01U) ? payloadSize % sizeof(payload) : sizeof(request);
+      break;
+    }
+    default:
+      payloadSize = payloadSize % sizeof(payload);
+      break;
+  }
+
+  for (uint8_t i = 0; i < payloadSize && command == GLOBAL_CMD_WRITE_SETTINGS; i++) {
+    payload[i] = take(input);
+  }
+
+  sentSequences[sequence] = true;
+  const uint16_t size = NFC_HARNESS_BuildFrame(frame, command, sequence, payload, payloadSize);
+  NFC_HARNESS_PhoneWrite(frame, size);
+}
+
+static void postMeasurementsFrame(FUZZ_NFC_Input_t *input) {
+  ACQUISITION_Frame_t *measurements = &measurementsFrames[measurementsFrameIndex++ % 2U];
+  const uint8_t minute = take(input);
+  const uint8_t temperature = take(input);
+  const uint8_t humidity = take(input);
+  const uint8_t lux = take(input);
+  const uint8_t validMask = take(input);
+
+  *measurements = (ACQUISITION_Frame_t) {
+    .timestamp = NFC_HARNESS_LOG_START_TIMESTAMP + (int32_t) minute * NFC_HARNESS_LOG_PERIOD_S,
+    .rawTemperature = (int16_t) (temperature << 8),
+    .rawHumidity = (uint16_t) (humidity << 8),
+    .rawLux = (uint16_t) (lux << 7),
+    .validMask = (uint8_t) (validMask % (ACQUISITION_ALL_VALID + 1U)),
+  };
+
+  NFC_HARNESS_PostMeasurementsFrame(measurements);
+}
+
+/**
+ * @brief Phone reads the mailbox until the device is idle, then a fresh command is answered
+ */
+static void checkRecovered(void) {
+  uint32_t sequence = 0;
+  uint32_t steps = 0;
+
+  NFC_HARNESS_SetRfBusy(false);
+
+  for (; steps < FUZZ_NFC_DRAIN_STEPS_MAX && (!NFC_HARNESS_IsIdle() || SIM_ST25DV_HasHostMessage()); steps++) {
+    phoneRead();
+    NFC_HARNESS_Advance(FUZZ_NFC_DRAIN_STEP_MS);
+  }
+
+  check(steps < FUZZ_NFC_DRAIN_STEPS_MAX, "device never idle");
+
+  // the command is told apart from the session's ones by a fresh sequence
+  while (sequence < sizeof(sentSequences) && sentSequences[sequence]) {
+    sequence++;
+  }
+
+  if (sequence == sizeof(sentSequences)) return;
+
+  sentSequences[sequence] = true;
+  const uint16_t size = NFC_HARNESS_BuildFrame(frame, GLOBAL_CMD_READ_SETTINGS, (uint8_t) sequence, NULL, 0);
+  check(NFC_HARNESS_PhoneWrite(frame, size), "mailbox not free after the session");
+
+  // the responses refused by the RF session are written before, the phone skips them by the sequence
+  for (steps = 0; steps < FUZZ_NFC_DRAIN_STEPS_MAX; steps++) {
+    NFC_HARNESS_Advance(FUZZ_NFC_DRAIN_STEP_MS);
+
+    const uint16_t responseSize = NFC_HARNESS_PhoneRead(response);
+    if (responseSize == 0) continue;
+
+    check(NFC_HARNESS_IsValidResponse(response, responseSize), "malformed response");
+
+    if (response[NFC_MAILBOX_PROTOCOL_SEQ_ADDR] == sequence) break;
+  }
+
+  check(steps < FUZZ_NFC_DRAIN_STEPS_MAX, "command after the session never answered");
+  check(response[NFC_MAILBOX_PROTOCOL_CMD_ADDR] == NFC_RESPONSE_ACK_OK, "command after the session failed");
+  check(memcmp(&response[NFC_MAILBOX_PROTOCOL_PAYLOAD_ADDR], NFC_HARNESS_GetSettings(), SETTINGS_DATA_SIZE) == 0, "settings mismatch");
+
+  for (steps = 0; steps < FUZZ_NFC_DRAIN_STEPS_MAX && !NFC_HARNESS_IsIdle(); steps++) {
+    NFC_HARNESS_Advance(FUZZ_NFC_DRAIN_STEP_MS);
+  }
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  FUZZ_NFC_Input_t input = {.data = data, .size = size};
+
+  memset(sentSequences, 0, sizeof(sentSequences));
+  sentSequences[0] = true; // the mailbox RAM is zeroed on the power up
+
+  NFC_HARNESS_Init((take(&input) % 8U) * FUZZ_NFC_LOG_ENTRIES_STEP, take(&input) % 16U);
+
+  while (input.size > 0) {
+    switch ((FUZZ_NFC_Action_t) (take(&input) % FUZZ_NFC_ACTIONS_COUNT)) {
+      case FUZZ_NFC_RAW_FRAME:
+        writeRawFrame(&input);
+        break;
+      case FUZZ_NFC_COMMAND:
+        writeCommand(&input);
+        break;
+      case FUZZ_NFC_PHONE_READ:
+        phoneRead();
+        break;
+      case FUZZ_NFC_ADVANCE:
+        NFC_HARNESS_Advance(take(&input) * 4U);
+        break;
+      case FUZZ_NFC_RF_BUSY:
+        NFC_HARNESS_SetRfBusy(take(&input) & 0x01U);
+        break;
+      case FUZZ_NFC_RF_BUSY_AFTER:
+        SIM_ST25DV_SetRfBusyAfter(take(&input) % 8U);
+        break;
+      case FUZZ_NFC_MEASUREMENTS_FRAME:
+        postMeasurementsFrame(&input);
+        break;
+      case FUZZ_NFC_FIELD:
+        NFC_HARNESS_SetField(take(&input) & 0x01U);
+        break;
+      default:
+        break;
+    }
+  }
+
+  checkRecovered();
+
+  return 0;
+}
+
+#ifndef NFC_FUZZ_LIBFUZZER
+static void runFile(FILE *file) {
+  static uint8_t data[1U << 16];
+  const size_t size = fread(data, 1, sizeof(data), file);
+
+  LLVMFuzzerTestOneInput(data, size);
+}
+
+/**
+ * @brief xorshift32 inputs, the same seed replays the same sessions
+ */
+static void runRandom(uint32_t inputsCount, uint32_t seed) {
+  static uint8_t data[FUZZ_NFC_RANDOM_INPUT_MAX];
+  uint32_t state = seed ? seed : 1U;
+
+  for (uint32_t n = 0; n < inputsCount; n++) {
+    const size_t size = 2U + state % (FUZZ_NFC_RANDOM_INPUT_MAX - 2U);
+
+    for (size_t i = 0; i < size; i++) {
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+      data[i] = (uint8_t) state;
+    }
+
+    LLVMFuzzerTestOneInput(data, size);
+  }
+
+  printf("fuzz_nfc: %lu random inputs passed, seed %lu\n", (unsigned long) inputsCount, (unsigned long) seed);
+}
+
+int main(int argc, char **argv) {
+  if (argc >= 3 && strcmp(argv[1], "--random") == 0) {
+    runRandom((uint32_t) strtoul(argv[2], NULL, 0), (argc >= 4) ? (uint32_t) strtoul(argv[3], NULL, 0) : 1U);
+    return 0;
+  }
+
+  if (argc == 1) {
+    runFile(stdin);
+    return 0;
+  }
+
+  for (int i = 1; i < argc; i++) {
+    FILE *file = fopen(argv[i], "rb");
+    if (file == NULL) {
+      perror(argv[i]);
+      return 1;
+    }
+
+    runFile(file);
+    fclose(file);
+  }
+
+  return 0;
+}
+#endif
@@ -0,0 +1,711 @@
+/*!
+ * @file nfc_harness.c
+ * @brief implementation of the NFC actor host harness
+ *
+ * @date 18/10/2026
+ */
+
+#include <string.h>
+
+#include "nfc_harness.h"
+#include "event_manager.h"
+#include "crc_service.h"
+#include "log_query.h"
+#include "sensors_bus.h"
+
+#define NFC_HARNESS_QUEUES_COUNT          (3U)      ///< EV_MANAGER, MEMORY and NFC
+#define NFC_HARNESS_MEMORY_PENDING_MAX    (32U)
+#define NFC_HARNESS_RUN_DELIVERIES_MAX    (100000U) ///< More messages without the time passing is a livelock
+#define NFC_HARNESS_WAKE_UP_MARKER_PERIOD (97U)     ///< Every this entry records the wake up period change
+
+typedef struct {
+  message_t messages[DEFAULT_QUEUE_SIZE];
+  uint32_t head;
+  uint32_t count;
+} NFC_HARNESS_Queue_t;
+
+/**
+ * @brief Kernel timer of the actor timers, the only one in the system
+ */
+typedef struct {
+  osTimerFunc_t callback;
+  void *argument;
+  uint32_t deadline;
+  bool isArmed;
+} NFC_HARNESS_KernelTimer_t;
+
+typedef struct {
+  message_t message;
+  uint32_t dueTick;
+} NFC_HARNESS_MemoryRequest_t;
+
+/**
+ * @brief MEMORY model: the requests are served in the arrival order, each one the latency after its arrival
+ */
+typedef struct {
+  NFC_HARNESS_MemoryRequest_t pending[NFC_HARNESS_MEMORY_PENDING_MAX];
+  uint32_t head;
+  uint32_t count;
+  uint32_t latencyMs;
+  uint32_t entriesCount;
+  uint8_t settings[SETTINGS_DATA_SIZE];
+  uint8_t log[NFC_HARNESS_LOG_ENTRIES_MAX * MEMORY_LOG_ENTRY_SIZE];
+} NFC_HARNESS_Memory_t;
+
+/**
+ * @brief Fast Transfer Mode model: the phone acknowledges every segment once its last packet is sent
+ */
+typedef struct {
+  uint8_t *data;
+  uint32_t length;
+  uint32_t offset;
+  uint32_t segmentDataSize;
+  ftm_data_cb supplyData;
+  bool isSending;
+  bool isComplete;
+} NFC_HARNESS_FTM_t;
+
+static osStatus_t handleMemoryMessage(actor_t *actor, message_t *message);
+static osStatus_t handleSinkMessage(actor_t *actor, message_t *message);
+static void serveMemoryRequests(void);
+static void serveMemoryRequest(message_t *message);
+static int32_t readLogEntryTimestamp(uint32_t entry, int32_t *timestamp, void *context);
+static bool deliverMessage(actor_t *actor);
+static void deliverToNFC(message_t *message);
+static void postGPOInterrupt(void);
+static void generateLog(uint32_t entriesCount);
+
+extern actor_t* ACTORS_LOOKUP_SystemRegistry[MAX_ACTORS];
+
+DWT_Type MOCK_DWT;
+
+static NFC_HARNESS_Queue_t queues[NFC_HARNESS_QUEUES_COUNT];
+static uint32_t queuesCount;
+static uint32_t threadHandle; ///< Actors with a task are told apart by a non-NULL thread ID only
+static uint32_t tick;
+static NFC_HARNESS_KernelTimer_t kernelTimer;
+static NFC_HARNESS_Memory_t memory;
+static NFC_HARNESS_FTM_t ftm;
+static uint8_t ftmReceived[NFC_HARNESS_LOG_ENTRIES_MAX * MEMORY_LOG_ENTRY_SIZE]; ///< Data of the last transfer as the phone got it
+static NFC_HARNESS_Stats_t stats;
+static bool isStarted;
+
+static actor_t memoryActor = {
+  .actorId = MEMORY_ACTOR_ID,
+  .messageHandler = handleMemoryMessage,
+};
+
+static actor_t sinkActors[MAX_ACTORS]; ///< The rest of the subscribers, without a task the events are dropped at once
+static NFC_HARNESS_SinkMessage_t sinkMessages[MAX_ACTORS];
+
+/**
+ * @brief Powers the tag up and initializes NFC with the fresh log, the rest of the system is started once
+ * @note The NFC actor keeps its in-flight commands and the summary across the calls as across the restarts, the
+ * previous session should end idle
+ */
+void NFC_HARNESS_Init(uint32_t logEntriesCount, uint32_t memoryLatencyMs) {
+  assert_param(logEntriesCount <= NFC_HARNESS_LOG_ENTRIES_MAX);
+
+  if (!isStarted) {
+    ACTOR_TIMER_Init();
+
+    EV_MANAGER_Actor.super.osMessageQueueId = osMessageQueueNew(DEFAULT_QUEUE_SIZE, DEFAULT_QUEUE_MESSAGE_SIZE, NULL);
+    EV_MANAGER_Actor.super.osThreadId = &threadHandle;
+    memoryActor.osMessageQueueId = osMessageQueueNew(DEFAULT_QUEUE_SIZE, DEFAULT_QUEUE_MESSAGE_SIZE, NULL);
+    memoryActor.osThreadId = &threadHandle;
+
+    ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID] = &EV_MANAGER_Actor.super;
+    ACTORS_LOOKUP_SystemRegistry[MEMORY_ACTOR_ID] = &memoryActor;
+    ACTORS_LOOKUP_SystemRegistry[NFC_ACTOR_ID] = NFC_TaskInit();
+
+    for (uint32_t id = 0; id < MAX_ACTORS; id++) {
+      if (ACTORS_LOOKUP_SystemRegistry[id] != NULL) continue;
+
+      sinkActors[id] = (actor_t) {.actorId = (ACTOR_ID) id, .messageHandler = handleSinkMessage};
+      ACTORS_LOOKUP_SystemRegistry[id] = &sinkActors[id];
+    }
+
+    isStarted = true;
+  }
+
+  for (uint32_t i = 0; i < queuesCount; i++) {
+    queues[i].count = 0;
+  }
+
+  memset(&stats, 0, sizeof(stats));
+  memset(sinkMessages, 0, sizeof(sinkMessages));
+  memset(&ftm, 0, sizeof(ftm));
+  memory.count = 0;
+  memory.latencyMs = memoryLatencyMs;
+  generateLog(logEntriesCount);
+
+  SIM_ST25DV_Reset(postGPOInterrupt);
+
+  NFC_Actor.state = NFC_NO_STATE;
+  osMessageQueuePut(NFC_Actor.super.osMessageQueueId, &(message_t) {.event = GLOBAL_CMD_INITIALIZE}, 0, 0);
+  NFC_HARNESS_Run();
+
+  // the phone is on the tag, its session has started
+  NFC_HARNESS_SetField(true);
+  NFC_HARNESS_Advance(NFC_FIELD_DEBOUNCE_MS);
+}
+
+/**
+ * @brief Delivers the messages, one per actor in turn, until all the queues are empty
+ * @return Messages delivered
+ */
+uint32_t NFC_HARNESS_Run(void) {
+  uint32_t delivered = 0;
+  bool isDelivered;
+
+  do {
+    serveMemoryRequests();
+
+    isDelivered = deliverMessage(&EV_MANAGER_Actor.super);
+    isDelivered |= deliverMessage(&memoryActor);
+    isDelivered |= deliverMessage(&NFC_Actor.super);
+
+    delivered += isDelivered;
+    assert_param(delivered < NFC_HARNESS_RUN_DELIVERIES_MAX);
+  } while (isDelivered);
+
+  stats.messagesDelivered += delivered;
+
+  return delivered;
+}
+
+/**
+ * @brief Passes the time: the expired actor timers and the due MEMORY answers are delivered at their ticks
+ */
+void NFC_HARNESS_Advance(uint32_t ms) {
+  const uint32_t target = tick + ACTOR_TIMER_MS_TO_TICKS(ms);
+
+  NFC_HARNESS_Run();
+
+  for (;;) {
+    uint32_t next = target;
+
+    if (kernelTimer.isArmed && (int32_t) (kernelTimer.deadline - next) < 0) {
+      next = kernelTimer.deadline;
+    }
+
+    if (memory.count > 0 && (int32_t) (memory.pending[memory.head].dueTick - next) < 0) {
+      next = memory.pending[memory.head].dueTick;
+    }
+
+    tick = next;
+
+    if (kernelTimer.isArmed && (int32_t) (tick - kernelTimer.deadline) >= 0) {
+      kernelTimer.isArmed = false;
+      kernelTimer.callback(kernelTimer.argument);
+    }
+
+    NFC_HARNESS_Run();
+
+    if (tick == target) break;
+  }
+}
+
+/**
+ * @return true if nothing happens until the phone acts: no messages, MEMORY requests or armed timers
+ */
+bool NFC_HARNESS_IsIdle(void) {
+  for (uint32_t i = 0; i < queuesCount; i++) {
+    if (queues[i].count > 0) return false;
+  }
+
+  return memory.count == 0 && !kernelTimer.isArmed;
+}
+
+/**
+ * @brief Phone approaching or leaving the tag, the actors run on the GPO pulse
+ */
+void NFC_HARNESS_SetField(bool isOn) {
+  SIM_ST25DV_SetField(isOn);
+  NFC_HARNESS_Run();
+}
+
+/**
+ * @brief Phone writes the frame to the mailbox, the actors run on the GPO pulse
+ * @note The phone away is brought to the tag first
+ * @return false if the mailbox isn't free
+ */
+bool NFC_HARNESS_PhoneWrite(const uint8_t *frame, uint16_t size) {
+  SIM_ST25DV_SetField(true);
+
+  const bool isWritten = SIM_ST25DV_RfWriteMessage(frame, size);
+
+  NFC_HARNESS_Run();
+
+  return isWritten;
+}
+
+/**
+ * @brief Phone reads the device message, the actors run on the GPO pulse
+ * @return Frame size, 0 if there is no message
+ */
+uint16_t NFC_HARNESS_PhoneRead(uint8_t frame[ST25DV_MAX_MAILBOX_LENGTH]) {
+  SIM_ST25DV_SetField(true);
+
+  const uint16_t size = SIM_ST25DV_RfReadMessage(frame);
+
+  NFC_HARNESS_Run();
+
+  return size;
+}
+
+void NFC_HARNESS_SetRfBusy(bool isBusy) {
+  SIM_ST25DV_SetRfBusy(isBusy);
+}
+
+/**
+ * @brief ACQUISITION publishes the frame, NFC gets it from the Event Manager
+ * @note The frame should stay valid until it's delivered, as ACQUISITION keeps it until the next wake up
+ */
+void NFC_HARNESS_PostMeasurementsFrame(const ACQUISITION_Frame_t *frame) {
+  osMessageQueuePut(NFC_Actor.super.osMessageQueueId, &(message_t) {GLOBAL_MEASUREMENTS_FRAME_READY, .payload.ptr = (void *) frame}, 0, 0);
+  NFC_HARNESS_Run();
+}
+
+/**
+ * @return Frame size, the header and the payload
+ */
+uint16_t NFC_HARNESS_BuildFrame(uint8_t frame[ST25DV_MAX_MAILBOX_LENGTH], uint8_t command, uint8_t sequence,
+                                const void *payload, uint8_t payloadSize) {
+  assert_param(NFC_MAILBOX_PROTOCOL_HEADER_SIZE + payloadSize <= ST25DV_MAX_MAILBOX_LENGTH);
+
+  frame[NFC_MAILBOX_PROTOCOL_CMD_ADDR] = command;
+  frame[NFC_MAILBOX_PROTOCOL_SEQ_ADDR] = sequence;
+  frame[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR] = payloadSize;
+
+  if (payloadSize > 0) {
+    memcpy(&frame[NFC_MAILBOX_PROTOCOL_PAYLOAD_ADDR], payload, payloadSize);
+  }
+
+  frame[NFC_MAILBOX_PROTOCOL_CRC8_ADDR] = CRC_SERVICE_Crc8(&frame[NFC_MAILBOX_PROTOCOL_CMD_ADDR],
+                                                           NFC_MAILBOX_PROTOCOL_HEADER_SIZE - NFC_MAILBOX_PROTOCOL_CRC8_SIZE + payloadSize);
+
+  return NFC_MAILBOX_PROTOCOL_HEADER_SIZE + payloadSize;
+}
+
+/**
+ * @return true if the device frame is well-formed: the size matches the header, the CRC and the response code are valid
+ */
+bool NFC_HARNESS_IsValidResponse(const uint8_t *frame, uint16_t size) {
+  if (size < NFC_MAILBOX_PROTOCOL_HEADER_SIZE || size != NFC_MAILBOX_PROTOCOL_HEADER_SIZE + frame[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR])
+    return false;
+
+  const uint8_t crc = CRC_SERVICE_Crc8(&frame[NFC_MAILBOX_PROTOCOL_CMD_ADDR], size - NFC_MAILBOX_PROTOCOL_CRC8_SIZE);
+
+  switch (frame[NFC_MAILBOX_PROTOCOL_CMD_ADDR]) {
+    case NFC_RESPONSE_ACK_OK:
+      return crc == frame[NFC_MAILBOX_PROTOCOL_CRC8_ADDR];
+    case NFC_RESPONSE_NACK_ERROR:
+    case NFC_RESPONSE_NACK_CRC_ERROR:
+    case NFC_RESPONSE_NACK_BUSY:
+      return crc == frame[NFC_MAILBOX_PROTOCOL_CRC8_ADDR] && size == NFC_MAILBOX_PROTOCOL_HEADER_SIZE;
+    default:
+      return false;
+  }
+}
+
+const uint8_t *NFC_HARNESS_GetLogEntry(uint32_t entry) {
+  assert_param(entry < memory.entriesCount);
+
+  return &memory.log[entry * MEMORY_LOG_ENTRY_SIZE];
+}
+
+const uint8_t *NFC_HARNESS_GetSettings(void) {
+  return memory.settings;
+}
+
+/**
+ * @return Data received by the phone in the last FTM transfer, its length is the sent one
+ */
+const uint8_t *NFC_HARNESS_GetFTMReceived(uint32_t *length) {
+  *length = ftm.offset;
+
+  return ftmReceived;
+}
+
+const NFC_HARNESS_Stats_t *NFC_HARNESS_GetStats(void) {
+  return &stats;
+}
+
+const NFC_HARNESS_SinkMessage_t *NFC_HARNESS_GetSinkMessage(ACTOR_ID actorId) {
+  return &sinkMessages[actorId];
+}
+
+/**
+ * Kernel
+ */
+uint32_t HAL_GetTick(void) {
+  return tick;
+}
+
+uint32_t osKernelGetTickCount(void) {
+  return tick;
+}
+
+int32_t osKernelLock(void) {
+  return 0;
+}
+
+int32_t osKernelRestoreLock(int32_t lock) {
+  return lock;
+}
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr) {
+  (void) func;
+  (void) argument;
+  (void) attr;
+
+  return &threadHandle; // the task loop is replaced by the harness delivery
+}
+
+osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr) {
+  (void) attr;
+
+  assert_param(queuesCount < NFC_HARNESS_QUEUES_COUNT && msg_count <= DEFAULT_QUEUE_SIZE && msg_size == sizeof(message_t));
+
+  return &queues[queuesCount++];
+}
+
+osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout) {
+  NFC_HARNESS_Queue_t *queue = (NFC_HARNESS_Queue_t *) mq_id;
+  (void) msg_prio;
+  (void) timeout;
+
+  if (queue->count == DEFAULT_QUEUE_SIZE) {
+    stats.queueOverflows++;
+    return osErrorResource;
+  }
+
+  memcpy(&queue->messages[(queue->head + queue->count) % DEFAULT_QUEUE_SIZE], msg_ptr, sizeof(message_t));
+  queue->count++;
+
+  return osOK;
+}
+
+osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout) {
+  NFC_HARNESS_Queue_t *queue = (NFC_HARNESS_Queue_t *) mq_id;
+  (void) msg_prio;
+  (void) timeout;
+
+  if (queue->count == 0)
+    return osErrorResource;
+
+  memcpy(msg_ptr, &queue->messages[queue->head], sizeof(message_t));
+  queue->head = (queue->head + 1) % DEFAULT_QUEUE_SIZE;
+  queue->count--;
+
+  return osOK;
+}
+
+uint32_t osMessageQueueGetCount(osMessageQueueId_t mq_id) {
+  return ((NFC_HARNESS_Queue_t *) mq_id)->count;
+}
+
+osTimerId_t osTimerNew(osTimerFunc_t func, osTimerType_t type, void *argument, const osTimerAttr_t *attr) {
+  (void) attr;
+
+  assert_param(type == osTimerOnce && kernelTimer.callback == NULL);
+
+  kernelTimer.callback = func;
+  kernelTimer.argument = argument;
+
+  return &kernelTimer;
+}
+
+osStatus_t osTimerStart(osTimerId_t timer_id, uint32_t ticks) {
+  NFC_HARNESS_KernelTimer_t *timer = (NFC_HARNESS_KernelTimer_t *) timer_id;
+
+  timer->deadline = tick + ticks;
+  timer->isArmed = true;
+
+  return osOK;
+}
+
+osStatus_t osTimerStop(osTimerId_t timer_id) {
+  NFC_HARNESS_KernelTimer_t *timer = (NFC_HARNESS_KernelTimer_t *) timer_id;
+
+  // as the FreeRTOS wrapper, stopping the timer which isn't running fails
+  if (!timer->isArmed) return osErrorResource;
+
+  timer->isArmed = false;
+
+  return osOK;
+}
+
+/**
+ * ST25 Fast Transfer Mode
+ */
+void ST25FTM_Init(void) {
+  memset(&ftm, 0, sizeof(ftm));
+}
+
+void ST25FTM_SendCommand(uint8_t *data, uint32_t length, ST25FTM_Send_Ack_t ack, ftm_data_cb data_cb) {
+  (void) ack;
+
+  ftm.data = data;
+  ftm.length = length;
+  ftm.offset = 0;
+  ftm.supplyData = data_cb;
+  ftm.isSending = true;
+  ftm.isComplete = false;
+}
+
+/**
+ * @brief Sends one packet, the packets never cross the segments
+ */
+void ST25FTM_Runner(void) {
+  uint8_t mailboxControl = 0;
+  uint8_t message[ST25DV_MAX_MAILBOX_LENGTH];
+
+  if (!ftm.isSending || ftm.isComplete)
+    return;
+
+  // the receiver polls the mailbox for the acknowledges, the phone's other messages are read and dropped
+  SensorsBus_ReadReg16(ST25DV_ADDR_DATA_I2C, ST25DV_MB_CTRL_DYN_REG, &mailboxControl, sizeof(mailboxControl));
+
+  if (mailboxControl & ST25DV_MB_CTRL_DYN_RFPUTMSG_MASK) {
+    SensorsBus_ReadReg16(ST25DV_ADDR_DATA_I2C, ST25DV_MAILBOX_RAM_REG, message, sizeof(message));
+  }
+
+  const uint32_t segmentEnd = (ftm.offset / ftm.segmentDataSize + 1) * ftm.segmentDataSize;
+  const uint32_t end = (segmentEnd < ftm.length) ? segmentEnd : ftm.length;
+  const uint32_t length = (end - ftm.offset < NFC_HARNESS_FTM_PACKET_SIZE) ? end - ftm.offset : NFC_HARNESS_FTM_PACKET_SIZE;
+
+  assert_param(ftm.offset + length <= sizeof(ftmReceived));
+
+  ftm.supplyData(&ftmReceived[ftm.offset], ftm.data + ftm.offset, length);
+  ftm.offset += length;
+  stats.ftmBytesSent += length;
+
+  if (ftm.offset == ftm.length) {
+    ftm.isComplete = true;
+    stats.ftmTransfers++;
+  }
+}
+
+ST25FTM_Field_State_t ST25FTM_GetFieldState(void) {
+  return SIM_ST25DV_IsFieldOn() ? ST25FTM_FIELD_ON : ST25FTM_FIELD_OFF;
+}
+
+uint8_t ST25FTM_IsTransmissionComplete(void) {
+  return ftm.isComplete;
+}
+
+uint8_t ST25FTM_CheckError(void) {
+  return 0;
+}
+
+void ST25FTM_Reset(void) {
+  ftm.isSending = false;
+  ftm.isComplete = false;
+}
+
+uint32_t ST25FTM_GetRetryLength(void) {
+  return 0;
+}
+
+void ST25FTM_SetTxSegmentMaxLength(uint32_t length) {
+  ftm.segmentDataSize = length - sizeof(ST25FTM_Crc_t);
+}
+
+/**
+ * MEMORY
+ */
+static osStatus_t handleMemoryMessage(actor_t *actor, message_t *message) {
+  (void) actor;
+
+  switch (message->event) {
+    case GLOBAL_CMD_READ_SETTINGS:
+    case GLOBAL_CMD_WRITE_SETTINGS:
+    case GLOBAL_CMD_READ_LOG_CHUNK:
+    case GLOBAL_CMD_QUERY_LOG:
+      break;
+    default:
+      return osOK; // e.g. its own GLOBAL_SETTINGS_WRITE_SUCCESS
+  }
+
+  assert_param(memory.count < NFC_HARNESS_MEMORY_PENDING_MAX);
+
+  NFC_HARNESS_MemoryRequest_t *request = &memory.pending[(memory.head + memory.count) % NFC_HARNESS_MEMORY_PENDING_MAX];
+  request->message = *message;
+  request->dueTick = tick + ACTOR_TIMER_MS_TO_TICKS(memory.latencyMs);
+  memory.count++;
+  stats.memoryRequests++;
+
+  return osOK;
+}
+
+static osStatus_t handleSinkMessage(actor_t *actor, message_t *message) {
+  NFC_HARNESS_SinkMessage_t *sinkMessage = &sinkMessages[actor->actorId];
+
+  // the payload pointer is valid during the call only, e.g. the NFC command slot
+  sinkMessage->event = message->event;
+  sinkMessage->payloadSize = message->payload_size;
+  if (message->payload_size > 0 && message->payload.ptr != NULL) {
+    const uint16_t size = (message->payload_size < NFC_HARNESS_SINK_PAYLOAD_MAX) ? message->payload_size : NFC_HARNESS_SINK_PAYLOAD_MAX;
+    memcpy(sinkMessage->payload, message->payload.ptr, size);
+  }
+
+  return osOK;
+}
+
+static void serveMemoryRequests(void) {
+  while (memory.count > 0 && (int32_t) (tick - memory.pending[memory.head].dueTick) >= 0) {
+    message_t message = memory.pending[memory.head].message;
+
+    memory.head = (memory.head + 1) % NFC_HARNESS_MEMORY_PENDING_MAX;
+    memory.count--;
+
+    serveMemoryRequest(&message);
+  }
+}
+
+/**
+ * @brief Answers as memory.c does: the settings results through the Event Manager, the log results directly to NFC
+ */
+static void serveMemoryRequest(message_t *message) {
+  osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
+  osMessageQueueId_t nfcQueue = ACTORS_LOOKUP_SystemRegistry[NFC_ACTOR_ID]->osMessageQueueId;
+  const uint32_t logTailAddress = INITIAL_LOG_START_ADDR + memory.entriesCount * MEMORY_LOG_ENTRY_SIZE;
+
+  if (message->event == GLOBAL_CMD_READ_SETTINGS) {
+    memcpy(message->payload.ptr, memory.settings, SETTINGS_DATA_SIZE);
+    osMessageQueuePut(evManagerQueue, &(message_t) {GLOBAL_SETTINGS_READ_SUCCESS, .payload.value = osOK}, 0, 0);
+    return;
+  }
+
+  if (message->event == GLOBAL_CMD_WRITE_SETTINGS) {
+    assert_param(message->payload_size == SETTINGS_DATA_SIZE);
+
+    memcpy(memory.settings, message->payload.ptr, SETTINGS_DATA_SIZE);
+    osMessageQueuePut(evManagerQueue, &(message_t) {GLOBAL_SETTINGS_WRITE_SUCCESS, .payload.value = osOK}, 0, 0);
+    return;
+  }
+
+  if (message->event == GLOBAL_CMD_READ_LOG_CHUNK) {
+    MEMORY_LogReadRequest_t *request = (MEMORY_LogReadRequest_t *) message->payload.ptr;
+
+    request->logTailAddress = logTailAddress;
+
+    if (request->size > 0) {
+      // NFC reads within the written log only, into its transfer buffers
+      assert_param(request->address >= INITIAL_LOG_START_ADDR && request->address + request->size <= logTailAddress);
+      assert_param(request->size <= NFC_LOG_EXPORT_SEGMENT_SIZE);
+
+      memcpy(request->buffer, &memory.log[request->address - INITIAL_LOG_START_ADDR], request->size);
+      stats.memoryBytesRead += request->size;
+    }
+
+    osMessageQueuePut(nfcQueue, &(message_t) {GLOBAL_LOG_CHUNK_READ_SUCCESS, .payload.value = osOK}, 0, 0);
+    return;
+  }
+
+  LOG_QUERY_t *query = (LOG_QUERY_t *) message->payload.ptr;
+  uint32_t entry = 0;
+
+  LOG_QUERY_SeekRangeStart(query, memory.entriesCount, readLogEntryTimestamp, NULL, &entry);
+
+  while (entry < memory.entriesCount) {
+    const uint32_t remainingEntries = memory.entriesCount - entry;
+    const uint32_t blockEntries = (remainingEntries < MEMORY_LOG_QUERY_BLOCK_ENTRIES) ? remainingEntries : MEMORY_LOG_QUERY_BLOCK_ENTRIES;
+
+    if (!LOG_QUERY_Accumulate(query, &memory.log[entry * MEMORY_LOG_ENTRY_SIZE], blockEntries))
+      break;
+
+    entry += blockEntries;
+  }
+
+  LOG_QUERY_Finish(query);
+
+  osMessageQueuePut(nfcQueue, &(message_t) {GLOBAL_LOG_QUERY_SUCCESS, .payload.value = osOK}, 0, 0);
+}
+
+static int32_t readLogEntryTimestamp(uint32_t entry, int32_t *timestamp, void *context) {
+  (void) context;
+
+  memcpy(timestamp, &memory.log[entry * MEMORY_LOG_ENTRY_SIZE], sizeof(*timestamp));
+
+  return 0;
+}
+
+/**
+ * Delivery
+ */
+static bool deliverMessage(actor_t *actor) {
+  message_t message;
+
+  if (osMessageQueueGet(actor->osMessageQueueId, &message, NULL, 0) != osOK)
+    return false;
+
+  if (actor == &NFC_Actor.super) {
+    deliverToNFC(&message);
+  } else {
+    actor->messageHandler(actor, &message);
+  }
+
+  return true;
+}
+
+/**
+ * @brief Loop body of NFC_Task()
+ */
+static void deliverToNFC(message_t *message) {
+  osMessageQueueId_t evManagerQueue = ACTORS_LOOKUP_SystemRegistry[EV_MANAGER_ACTOR_ID]->osMessageQueueId;
+  osStatus_t status = NFC_Actor.super.messageHandler((actor_t *) &NFC_Actor, message);
+
+  if (status != osOK) {
+    stats.actorErrors++;
+    osMessageQueuePut(evManagerQueue, &(message_t){GLOBAL_ERROR, .payload.value = NFC_ACTOR_ID}, 0, 0);
+    TO_STATE(&NFC_Actor, NFC_STATE_ERROR);
+  }
+}
+
+static void postGPOInterrupt(void) {
+  osMessageQueuePut(NFC_Actor.super.osMessageQueueId, &(message_t){.event = NFC_GPO_INTERRUPT}, 0, 0);
+}
+
+/**
+ * @brief Minute entries of a slow cold chain trace, with a wake up period marker every NFC_HARNESS_WAKE_UP_MARKER_PERIOD
+ */
+static void generateLog(uint32_t entriesCount) {
+  memory.entriesCount = entriesCount;
+
+  for (uint32_t i = 0; i < entriesCount; i++) {
+    uint8_t *entry = &memory.log[i * MEMORY_LOG_ENTRY_SIZE];
+    const int32_t timestamp = NFC_HARNESS_LOG_START_TIMESTAMP + (int32_t) i * NFC_HARNESS_LOG_PERIOD_S;
+
+    if (i % NFC_HARNESS_WAKE_UP_MARKER_PERIOD == NFC_HARNESS_WAKE_UP_MARKER_PERIOD - 1) {
+      const MEMORY_WakeUpPeriodEntry_t marker = {
+        .timestamp = timestamp,
+        .marker = MEMORY_WAKE_UP_PERIOD_MARKER,
+        .periodSeconds = NFC_HARNESS_LOG_PERIOD_S,
+        .previousPeriodSeconds = NFC_HARNESS_LOG_PERIOD_S,
+      };
+
+      memcpy(entry, &marker, sizeof(marker));
+      continue;
+    }
+
+    const MEMORY_SensorsMeasurementEntry_t measurement = {
+      .timestamp = timestamp,
+      .rawTemperature = (uint16_t) (0x6400 + (i * 37) % 0x400),
+      .rawHumidity = (uint16_t) (0xC000 + (i * 11) % 0x100),
+      .rawLux = (uint16_t) (0x3000 | (i * 29) % 0x800),
+      .accelX = (int16_t) (i % 7) - 3,
+      .accelY = (int16_t) (i % 5) - 2,
+      .accelZ = 1000,
+      .suppressedCount = (uint16_t) (i % 3),
+    };
+
+    memcpy(entry, &measurement, sizeof(measurement));
+  }
+
+  for (uint32_t i = 0; i < SETTINGS_DATA_SIZE; i++) {
+    memory.settings[i] = (uint8_t) i;
+  }
+}
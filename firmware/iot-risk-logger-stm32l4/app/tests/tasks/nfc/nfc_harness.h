@@ -0,0 +1,72 @@
+/*!
+ * @file nfc_harness.h
+ * @brief Host harness running the real NFC actor against the simulated ST25DV and a phone
+ *
+ * Linked together: nfc.c, nfc_handlers.c, the ST25DV driver, the FSM engine, the actor timers, the Event Manager
+ * with the supervisor and the actors registry, the CRC service, the log codec, query and summary. The harness
+ * provides the rest of the device:
+ * - the kernel: the message queues, the tick and the one kernel timer of the actor timers, the messages are
+ *   delivered as the actors tasks loops do, one per actor in turn until all the queues are empty;
+ * - MEMORY: the settings and a synthetic log of the NOR Flash, answering with the configured latency;
+ * - the ST25 Fast Transfer Mode library: one packet per run, the segments acknowledged at once;
+ * - the GPO line: the tag pulse posts NFC_GPO_INTERRUPT as the EXTI callback does.
+ *
+ * The phone writes and reads the mailbox between the runs, time passes only on NFC_HARNESS_Advance(). The phone is on
+ * the tag after the init, and is brought back by its mailbox access after NFC_HARNESS_SetField(false).
+ *
+ * @date 18/10/2026
+ */
+
+#ifndef NFC_HARNESS_H
+#define NFC_HARNESS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "nfc.h"
+#include "sim_st25dv.h"
+
+#define NFC_HARNESS_LOG_ENTRIES_MAX     (4096U)
+#define NFC_HARNESS_LOG_START_TIMESTAMP (1790000000) // 2026-09-21 14:13:20 UTC
+#define NFC_HARNESS_LOG_PERIOD_S        (60)
+#define NFC_HARNESS_FTM_PACKET_SIZE     (240U)       ///< FTM packet data, the mailbox less the packet headers
+#define NFC_HARNESS_SINK_PAYLOAD_MAX    (8U)         ///< Payload bytes kept of the last message of a sink actor
+
+typedef struct {
+  uint32_t messagesDelivered;
+  uint32_t queueOverflows;
+  uint32_t actorErrors;         ///< NFC handler failures reported to the supervisor
+  uint32_t memoryRequests;
+  uint32_t memoryBytesRead;     ///< Log bytes served to NFC
+  uint32_t ftmBytesSent;
+  uint32_t ftmTransfers;        ///< Completed FTM transfers
+} NFC_HARNESS_Stats_t;
+
+/**
+ * @brief Last message delivered to an actor without a model, e.g. the command dispatched to CRON
+ */
+typedef struct {
+  event_t event;
+  uint16_t payloadSize;
+  uint8_t payload[NFC_HARNESS_SINK_PAYLOAD_MAX]; ///< Copy of the payload pointer data, up to the max
+} NFC_HARNESS_SinkMessage_t;
+
+void NFC_HARNESS_Init(uint32_t logEntriesCount, uint32_t memoryLatencyMs);
+uint32_t NFC_HARNESS_Run(void);
+void NFC_HARNESS_Advance(uint32_t ms);
+bool NFC_HARNESS_IsIdle(void);
+bool NFC_HARNESS_PhoneWrite(const uint8_t *frame, uint16_t size);
+uint16_t NFC_HARNESS_PhoneRead(uint8_t frame[ST25DV_MAX_MAILBOX_LENGTH]);
+void NFC_HARNESS_SetField(bool isOn);
+void NFC_HARNESS_SetRfBusy(bool isBusy);
+void NFC_HARNESS_PostMeasurementsFrame(const ACQUISITION_Frame_t *frame);
+uint16_t NFC_HARNESS_BuildFrame(uint8_t frame[ST25DV_MAX_MAILBOX_LENGTH], uint8_t command, uint8_t sequence,
+                                const void *payload, uint8_t payloadSize);
+bool NFC_HARNESS_IsValidResponse(const uint8_t *frame, uint16_t size);
+const uint8_t *NFC_HARNESS_GetLogEntry(uint32_t entry);
+const uint8_t *NFC_HARNESS_GetSettings(void);
+const uint8_t *NFC_HARNESS_GetFTMReceived(uint32_t *length);
+const NFC_HARNESS_Stats_t *NFC_HARNESS_GetStats(void);
+const NFC_HARNESS_SinkMessage_t *NFC_HARNESS_GetSinkMessage(ACTOR_ID actorId);
+
+#endif //NFC_HARNESS_H
@@ -0,0 +1,371 @@
+/*!
+ * @file replay_nfc.c
+ * @brief Replays a recorded event stream session through the NFC actor harness in virtual time
+ *
+ * The input is one boot session of the event recorder (app/core/event_recorder), the 32 bytes records oldest
+ * first, as scripts/replay_event_stream.py orders them from the NOR Flash dump. The records are taken in their
+ * tick order and the harness time is advanced to every record, so hours of the field session run in milliseconds:
+ *
+ * - The publishes the harness can't produce (wake ups, the measurements frames, the other actors' results and
+ *   errors) are injected into the Event Manager queue, the real Event Manager and supervisor deliver them.
+ * - The NFC commands are written to the mailbox as the phone did, rebuilt from the recorded publish: the command
+ *   code, the payload copy and its size. The real NFC actor dispatches them again.
+ * - The rest is regenerated by the harness: the NFC deliveries (MEMORY results, timers expiries, restarts), the
+ *   Event Manager START after the initialization, the MEMORY settings results.
+ *
+ * The replay records the regenerated stream with the same recorder API and compares its global events with the
+ * recorded ones in order, the first divergence fails the replay. The local events (GPO pulses, status polls) depend
+ * on the RF timing the recorder doesn't see, they are counted only.
+ *
+ * @note The payload copy is 15 bytes: the longer command payloads are rebuilt padded with 0xFF, as the recorder pads
+ * the copy, and the replayed measurements frames are valid for all the channels, their valid mask isn't recorded.
+ * The log served by the MEMORY model is the harness one, not the device log.
+ *
+ * @code
+ * ./replay_nfc session.bin [--log-entries N] [--memory-latency MS]
+ * @endcode
+ *
+ * @date 18/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nfc_harness.h"
+#include "event_manager.h"
+#include "event_recorder.h"
+
+#define REPLAY_RECORDS_MAX            (EVENT_RECORDER_AREA_SIZE / EVENT_RECORDER_RECORD_SIZE)
+#define REPLAY_PAYLOAD_BUFFERS_COUNT  (2U * DEFAULT_QUEUE_SIZE)
+#define REPLAY_PAYLOAD_BUFFER_SIZE    (256U)
+#define REPLAY_PHONE_POLL_MS          (10U)   ///< Phone reads the device messages this often while NFC is busy
+#define REPLAY_PHONE_WRITE_RETRIES    (100U)
+#define REPLAY_SETTLE_MS              (60000U) ///< Time after the last record, e.g. for the supervisor backoff
+
+typedef struct {
+  EVENT_RECORDER_Record_t records[REPLAY_RECORDS_MAX];
+  uint32_t count;
+} REPLAY_Stream_t;
+
+static osStatus_t replayRecord(const EVENT_RECORDER_Record_t *record);
+static void advancePhone(uint32_t ms);
+static void drainDeviceMessages(void);
+static bool writeCommand(const EVENT_RECORDER_Record_t *record);
+static void injectPublish(const EVENT_RECORDER_Record_t *record);
+static bool isRegenerated(const EVENT_RECORDER_Record_t *record);
+static bool isCompared(const EVENT_RECORDER_Record_t *record);
+static bool isSameRecord(const EVENT_RECORDER_Record_t *recorded, const EVENT_RECORDER_Record_t *replayed);
+static void printRecord(const char *mark, const EVENT_RECORDER_Record_t *record);
+static uint32_t compareStreams(void);
+
+static REPLAY_Stream_t recorded;
+static REPLAY_Stream_t replayed;
+static bool isCapturing;
+static uint32_t replayedSequence;
+static uint32_t localEventsCount[2]; ///< recorded, replayed
+static uint8_t payloadBuffers[REPLAY_PAYLOAD_BUFFERS_COUNT][REPLAY_PAYLOAD_BUFFER_SIZE];
+static uint32_t payloadBufferIndex;
+static uint8_t frame[ST25DV_MAX_MAILBOX_LENGTH];
+static uint8_t response[ST25DV_MAX_MAILBOX_LENGTH];
+static uint32_t elapsedMs;
+static uint32_t firstTick;
+
+int main(int argc, char **argv) {
+  uint32_t logEntriesCount = NFC_HARNESS_LOG_ENTRIES_MAX;
+  uint32_t memoryLatencyMs = 10;
+  const char *path = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--log-entries") == 0 && i + 1 < argc) {
+      logEntriesCount = (uint32_t) strtoul(argv[++i], NULL, 0);
+    } else if (strcmp(argv[i], "--memory-latency") == 0 && i + 1 < argc) {
+      memoryLatencyMs = (uint32_t) strtoul(argv[++i], NULL, 0);
+    } else {
+      path = argv[i];
+    }
+  }
+
+  if (path == NULL || logEntriesCount > NFC_HARNESS_LOG_ENTRIES_MAX) {
+    fprintf(stderr, "usage: %s session.bin [--log-entries N<=%u] [--memory-latency MS]\n", argv[0], NFC_HARNESS_LOG_ENTRIES_MAX);
+    return 2;
+  }
+
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    perror(path);
+    return 2;
+  }
+  recorded.count = (uint32_t) fread(recorded.records, EVENT_RECORDER_RECORD_SIZE, REPLAY_RECORDS_MAX, file);
+  fclose(file);
+
+  if (recorded.count == 0) {
+    fprintf(stderr, "%s: no records\n", path);
+    return 2;
+  }
+
+  // the harness initializes NFC as the boot did, the regenerated stream starts after it
+  NFC_HARNESS_Init(logEntriesCount, memoryLatencyMs);
+  isCapturing = true;
+
+  firstTick = recorded.records[0].tick;
+
+  for (uint32_t i = 0; i < recorded.count; i++) {
+    const EVENT_RECORDER_Record_t *record = &recorded.records[i];
+    const uint32_t dueMs = record->tick - firstTick; // 1ms kernel tick
+
+    if (dueMs > elapsedMs) advancePhone(dueMs - elapsedMs);
+
+    if (i > 0 && record->sequence != recorded.records[i - 1].sequence + 1) {
+      printf("[%10u] <%u records dropped>\n", record->tick, record->sequence - recorded.records[i - 1].sequence - 1);
+    }
+
+    if (replayRecord(record) != osOK) return 1;
+  }
+
+  advancePhone(REPLAY_SETTLE_MS);
+  drainDeviceMessages();
+
+  return (compareStreams() == 0) ? 0 : 1;
+}
+
+/**
+ * @brief Event Manager publish of the replay, its own recorder
+ */
+void EVENT_RECORDER_Record(const message_t *message) {
+  if (!isCapturing || replayed.count == REPLAY_RECORDS_MAX) return;
+
+  EVENT_RECORDER_Record_t *record = &replayed.records[replayed.count++];
+  const bool hasPayload = message->payload_size > 0 && message->payload.ptr != NULL;
+  const size_t copySize = hasPayload
+    ? ((message->payload_size < EVENT_RECORDER_PAYLOAD_COPY_SIZE) ? (size_t) message->payload_size : EVENT_RECORDER_PAYLOAD_COPY_SIZE)
+    : 0;
+
+  *record = (EVENT_RECORDER_Record_t) {
+    .sequence = replayedSequence++,
+    .tick = firstTick + elapsedMs,
+    .event = message->event,
+    .payloadSize = (int16_t) message->payload_size,
+    .value = message->payload.value,
+    .receiver = EVENT_RECORDER_PUBLISHED,
+  };
+  memset(record->payload, 0xFF, sizeof(record->payload));
+  if (copySize > 0) memcpy(record->payload, message->payload.ptr, copySize);
+}
+
+/**
+ * @brief Message delivered to the FSM actor of the replay, the NFC actor only
+ */
+void EVENT_RECORDER_RecordDelivery(ACTOR_ID receiver, const message_t *message) {
+  if (EV_MANAGER_IsSubscribed(receiver, message->event)) return;
+
+  EVENT_RECORDER_Record(message);
+
+  if (isCapturing && replayed.count > 0) replayed.records[replayed.count - 1].receiver = (uint8_t) receiver;
+}
+
+void EVENT_RECORDER_ReleasePage(const void *page) {
+  (void) page;
+}
+
+static osStatus_t replayRecord(const EVENT_RECORDER_Record_t *record) {
+  if (record->receiver != EVENT_RECORDER_PUBLISHED && record->receiver != NFC_ACTOR_ID) {
+    // the other actors don't run in the harness, their direct messages are shown only
+    printRecord("  ", record);
+    return osOK;
+  }
+
+  if (isRegenerated(record)) {
+    const bool isCommand = record->receiver == EVENT_RECORDER_PUBLISHED
+      && record->event >= GLOBAL_CMD_START_LOGGING && record->event < GLOBAL_CMD_MAX;
+
+    printRecord("= ", record);
+
+    if (isCommand && !writeCommand(record)) {
+      printf("replay_nfc: the mailbox isn't released for the command #%u\n", record->sequence);
+      return osError;
+    }
+
+    return osOK;
+  }
+
+  printRecord("> ", record);
+  injectPublish(record);
+
+  return osOK;
+}
+
+/**
+ * @brief Passes the time, the phone reads the device messages as they come while NFC is busy
+ */
+static void advancePhone(uint32_t ms) {
+  const uint32_t target = elapsedMs + ms;
+
+  while (elapsedMs < target) {
+    drainDeviceMessages();
+
+    const uint32_t step = NFC_HARNESS_IsIdle()
+      ? target - elapsedMs
+      : ((target - elapsedMs < REPLAY_PHONE_POLL_MS) ? target - elapsedMs : REPLAY_PHONE_POLL_MS);
+
+    NFC_HARNESS_Advance(step);
+    elapsedMs += step;
+  }
+}
+
+static void drainDeviceMessages(void) {
+  while (SIM_ST25DV_HasHostMessage()) {
+    NFC_HARNESS_PhoneRead(response);
+  }
+}
+
+/**
+ * @brief Writes the recorded command as the phone did, the truncated payload is padded as the recorder pads the copy
+ * @return false if the mailbox isn't released, e.g. by a log stream
+ */
+static bool writeCommand(const EVENT_RECORDER_Record_t *record) {
+  uint8_t payload[ST25DV_MAX_MAILBOX_LENGTH - NFC_MAILBOX_PROTOCOL_HEADER_SIZE];
+  const uint8_t payloadSize = (record->payloadSize > 0) ? (uint8_t) record->payloadSize : 0;
+
+  memset(payload, 0xFF, sizeof(payload));
+  memcpy(payload, record->payload, (payloadSize < EVENT_RECORDER_PAYLOAD_COPY_SIZE) ? payloadSize : EVENT_RECORDER_PAYLOAD_COPY_SIZE);
+
+  const uint16_t size = NFC_HARNESS_BuildFrame(frame, (uint8_t) record->event, (uint8_t) record->sequence, payload, payloadSize);
+
+  for (uint32_t i = 0; i < REPLAY_PHONE_WRITE_RETRIES; i++) {
+    drainDeviceMessages();
+
+    if (NFC_HARNESS_PhoneWrite(frame, size)) return true;
+
+    advancePhone(REPLAY_PHONE_POLL_MS);
+  }
+
+  return false;
+}
+
+/**
+ * @brief Publishes the record through the Event Manager, the pointed payload is the copy in a buffer outliving the
+ * delivery
+ */
+static void injectPublish(const EVENT_RECORDER_Record_t *record) {
+  message_t message = {.event = record->event, .payload.value = record->value, .payload_size = record->payloadSize};
+
+  if (record->payloadSize > 0) {
+    uint8_t *buffer = payloadBuffers[payloadBufferIndex];
+    payloadBufferIndex = (payloadBufferIndex + 1) % REPLAY_PAYLOAD_BUFFERS_COUNT;
+
+    memset(buffer, 0, REPLAY_PAYLOAD_BUFFER_SIZE);
+    memcpy(buffer, record->payload, EVENT_RECORDER_PAYLOAD_COPY_SIZE);
+
+    if (record->event == GLOBAL_MEASUREMENTS_FRAME_READY) {
+      ((ACQUISITION_Frame_t *) buffer)->validMask = ACQUISITION_TEMPERATURE_HUMIDITY_VALID | ACQUISITION_LUX_VALID | ACQUISITION_ACCELERATION_VALID;
+    }
+
+    message.payload.ptr = buffer;
+  }
+
+  osMessageQueuePut(EV_MANAGER_Actor.super.osMessageQueueId, &message, 0, 0);
+  NFC_HARNESS_Run();
+}
+
+/**
+ * @return true if the harness produces the record itself, it isn't injected but compared
+ */
+static bool isRegenerated(const EVENT_RECORDER_Record_t *record) {
+  if (record->receiver == NFC_ACTOR_ID) return true;
+
+  if (record->event >= GLOBAL_CMD_START_LOGGING && record->event < GLOBAL_CMD_MAX) return true;
+
+  switch (record->event) {
+    case GLOBAL_CMD_START_CONTINUOUS_SENSING: // posted by the Event Manager after every initialization
+    case GLOBAL_SETTINGS_WRITE_SUCCESS:       // MEMORY model
+    case GLOBAL_SETTINGS_READ_SUCCESS:
+      return true;
+    case GLOBAL_INITIALIZE_SUCCESS:           // posted by the Event Manager itself without the actor ID, or by NFC
+    case GLOBAL_ERROR:
+      return record->value == NO_ACTOR_ID || record->value == NFC_ACTOR_ID;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @return true if the record is compared, the local events and the boot initialization done by the harness aren't
+ */
+static bool isCompared(const EVENT_RECORDER_Record_t *record) {
+  if (!isRegenerated(record)) return false;
+  if (record->event == GLOBAL_CMD_INITIALIZE) return false;
+
+  return record->event < GLOBAL_EVENTS_MAX;
+}
+
+static bool isSameRecord(const EVENT_RECORDER_Record_t *recorded, const EVENT_RECORDER_Record_t *replayed) {
+  if (recorded->event != replayed->event || recorded->receiver != replayed->receiver) return false;
+
+  // the direct results values are the IO statuses, the publishes payloads are the commands
+  if (recorded->receiver == NFC_ACTOR_ID) return recorded->value == replayed->value;
+
+  return recorded->payloadSize == replayed->payloadSize
+    && memcmp(recorded->payload, replayed->payload, EVENT_RECORDER_PAYLOAD_COPY_SIZE) == 0;
+}
+
+static void printRecord(const char *mark, const EVENT_RECORDER_Record_t *record) {
+  const uint8_t copySize = (record->payloadSize > 0)
+    ? ((record->payloadSize < EVENT_RECORDER_PAYLOAD_COPY_SIZE) ? (uint8_t) record->payloadSize : EVENT_RECORDER_PAYLOAD_COPY_SIZE)
+    : 0;
+
+  printf("[%10u] %s#%-6u actor=%-3u event=0x%04x value=0x%08x", record->tick, mark, record->sequence,
+         record->receiver, record->event, record->value);
+
+  if (copySize > 0) {
+    printf(" payload[%d]=", record->payloadSize);
+    for (uint8_t i = 0; i < copySize; i++) printf("%02x", record->payload[i]);
+  }
+
+  printf("\n");
+}
+
+/**
+ * @brief Matches the compared records of both streams in order
+ * @return Divergences count, 0 or 1 as the replay stops comparing on the first one
+ */
+static uint32_t compareStreams(void) {
+  uint32_t recordedIndex = 0;
+  uint32_t replayedIndex = 0;
+  uint32_t matched = 0;
+
+  for (uint32_t i = 0; i < recorded.count; i++) {
+    if (isRegenerated(&recorded.records[i]) && recorded.records[i].event >= GLOBAL_EVENTS_MAX) localEventsCount[0]++;
+  }
+  for (uint32_t i = 0; i < replayed.count; i++) {
+    if (replayed.records[i].event >= GLOBAL_EVENTS_MAX) localEventsCount[1]++;
+  }
+
+  for (;;) {
+    while (recordedIndex < recorded.count && !isCompared(&recorded.records[recordedIndex])) recordedIndex++;
+    while (replayedIndex < replayed.count && !isCompared(&replayed.records[replayedIndex])) replayedIndex++;
+
+    const bool isRecordedOver = recordedIndex == recorded.count;
+    const bool isReplayedOver = replayedIndex == replayed.count;
+
+    if (isRecordedOver && isReplayedOver) break;
+
+    if (isRecordedOver || isReplayedOver || !isSameRecord(&recorded.records[recordedIndex], &replayed.records[replayedIndex])) {
+      printf("--- diverged after %u matched records\n", matched);
+      if (!isRecordedOver) printRecord("- ", &recorded.records[recordedIndex]);
+      if (!isReplayedOver) printRecord("+ ", &replayed.records[replayedIndex]);
+      return 1;
+    }
+
+    matched++;
+    recordedIndex++;
+    replayedIndex++;
+  }
+
+  const NFC_HARNESS_Stats_t *stats = NFC_HARNESS_GetStats();
+
+  printf("--- replayed: %u records matched, local events %u recorded / %u replayed, %u NFC errors, %u ms\n",
+         matched, localEventsCount[0], localEventsCount[1], stats->actorErrors, elapsedMs);
+
+  return 0;
+}
@@ -0,0 +1,341 @@
+/*!
+ * @file sim_st25dv.c
+ * @brief implementation of the ST25DV04K model
+ *
+ * @date 18/10/2026
+ */
+
+#include <string.h>
+
+#include "sim_st25dv.h"
+#include "st25dv.h"
+#include "sensors_bus.h"
+
+#define SIM_ST25DV_SYSTEM_REGS_SIZE   (0x0020U)   ///< GPO up to the UID
+#define SIM_ST25DV_UID_SIZE           (8U)
+#define SIM_ST25DV_PASSWORD_SIZE      (17U)       ///< Password, validation code and the password again
+#define SIM_ST25DV_PRESENT_PASSWORD   (0x09U)
+
+typedef struct {
+  uint8_t eeprom[SIM_ST25DV_EEPROM_SIZE];
+  uint8_t systemRegs[SIM_ST25DV_SYSTEM_REGS_SIZE];
+  uint8_t mailbox[SIM_ST25DV_MAILBOX_SIZE];
+  uint16_t messageLength; ///< Of the message in the mailbox, 0 if it's empty
+  uint8_t mbCtrl;
+  uint8_t itStatus; ///< Latched interrupts, cleared on read
+  bool isSecuritySessionOpen;
+  bool isFieldOn;
+  bool isRfBusy;
+  bool isRfBusyArmed;
+  uint32_t rfBusyAfter; ///< Host transactions passing before the armed RF session starts
+  SIM_ST25DV_GPOPulse_t onGPOPulse;
+  SIM_ST25DV_Stats_t stats;
+} SIM_ST25DV_t;
+
+static SIM_ST25DV_t tag;
+
+static uint8_t readDynamicRegister(uint16_t reg);
+static int32_t writeMailbox(const uint8_t *pData, uint16_t length);
+static void presentPassword(const uint8_t *pData, uint16_t length);
+static void pulseGPO(uint8_t gpoMask);
+static bool isMailboxFree(void);
+static bool isHostRefused(void);
+
+/**
+ * @brief Power-on state: mailbox mode enabled in the EEPROM configuration, the GPO isn't configured yet
+ */
+void SIM_ST25DV_Reset(SIM_ST25DV_GPOPulse_t onGPOPulse) {
+  static const uint8_t uid[SIM_ST25DV_UID_SIZE] = {0x5A, 0x24, 0x35, 0x8C, 0x26, 0x02, 0x02, 0xE0};
+
+  memset(&tag, 0, sizeof(tag));
+  memcpy(&tag.systemRegs[ST25DV_UID_REG], uid, sizeof(uid));
+  tag.systemRegs[ST25DV_ICREF_REG] = I_AM_ST25DV04;
+  tag.systemRegs[ST25DV_MB_MODE_REG] = ST25DV_MB_MODE_RW_MASK;
+  tag.mbCtrl = ST25DV_MB_CTRL_DYN_MBEN_MASK;
+  tag.onGPOPulse = onGPOPulse;
+}
+
+/**
+ * @brief Phone writes the message to the mailbox
+ * @return false if the mailbox isn't free, as the tag answers the RF write message command
+ */
+bool SIM_ST25DV_RfWriteMessage(const uint8_t *data, uint16_t length) {
+  if (!tag.isFieldOn || length == 0 || length > SIM_ST25DV_MAILBOX_SIZE || !isMailboxFree())
+    return false;
+
+  memcpy(tag.mailbox, data, length);
+  tag.messageLength = length;
+  tag.mbCtrl |= ST25DV_MB_CTRL_DYN_RFPUTMSG_MASK;
+  tag.itStatus |= ST25DV_ITSTS_DYN_RFPUTMSG_MASK;
+  tag.stats.rfMessagesWritten++;
+  tag.stats.rfBytes += length;
+
+  pulseGPO(ST25DV_GPO_RFPUTMSG_MASK);
+
+  return true;
+}
+
+/**
+ * @brief Phone reads the whole host message, the mailbox is free afterwards
+ * @return Message length, 0 if there is no host message
+ */
+uint16_t SIM_ST25DV_RfReadMessage(uint8_t data[SIM_ST25DV_MAILBOX_SIZE]) {
+  if (!tag.isFieldOn || !SIM_ST25DV_HasHostMessage())
+    return 0;
+
+  const uint16_t length = tag.messageLength;
+
+  memcpy(data, tag.mailbox, length);
+  tag.messageLength = 0;
+  tag.mbCtrl &= (uint8_t) ~ST25DV_MB_CTRL_DYN_HOSTPUTMSG_MASK;
+  tag.itStatus |= ST25DV_ITSTS_DYN_RFGETMSG_MASK;
+  tag.stats.rfMessagesRead++;
+  tag.stats.rfBytes += length;
+
+  pulseGPO(ST25DV_GPO_RFGETMSG_MASK);
+
+  return length;
+}
+
+bool SIM_ST25DV_HasHostMessage(void) {
+  return (tag.mbCtrl & ST25DV_MB_CTRL_DYN_HOSTPUTMSG_MASK) != 0;
+}
+
+/**
+ * @brief Phone approaching or leaving, the RF session is over without the field
+ */
+void SIM_ST25DV_SetField(bool isOn) {
+  if (tag.isFieldOn == isOn)
+    return;
+
+  tag.isFieldOn = isOn;
+  tag.itStatus |= isOn ? ST25DV_ITSTS_DYN_FIELDRISING_MASK : ST25DV_ITSTS_DYN_FIELDFALLING_MASK;
+
+  if (!isOn) {
+    tag.isRfBusy = false;
+    tag.isRfBusyArmed = false;
+  }
+
+  pulseGPO(ST25DV_GPO_FIELDCHANGE_MASK);
+}
+
+bool SIM_ST25DV_IsFieldOn(void) {
+  return tag.isFieldOn;
+}
+
+/**
+ * @brief RF session holding the tag: the I2C is NACKed until it's over
+ */
+void SIM_ST25DV_SetRfBusy(bool isBusy) {
+  if (isBusy) SIM_ST25DV_SetField(true);
+
+  tag.isRfBusy = isBusy;
+  tag.isRfBusyArmed = false;
+}
+
+/**
+ * @brief RF session starting in the middle of the host exchange, e.g. between the command read and the response write
+ */
+void SIM_ST25DV_SetRfBusyAfter(uint32_t hostTransactions) {
+  SIM_ST25DV_SetField(true);
+
+  tag.rfBusyAfter = hostTransactions;
+  tag.isRfBusyArmed = true;
+}
+
+const uint8_t *SIM_ST25DV_GetEEPROM(void) {
+  return tag.eeprom;
+}
+
+const SIM_ST25DV_Stats_t *SIM_ST25DV_GetStats(void) {
+  return &tag.stats;
+}
+
+int32_t SensorsBus_ReadReg16(uint16_t Addr, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+  if (isHostRefused())
+    return NFCTAG_NACK;
+
+  tag.stats.hostBytes += Length;
+
+  if (Addr == ST25DV_ADDR_SYST_I2C) {
+    if ((uint32_t) Reg + Length > SIM_ST25DV_SYSTEM_REGS_SIZE)
+      return NFCTAG_ERROR;
+
+    memcpy(pData, &tag.systemRegs[Reg], Length);
+    return NFCTAG_OK;
+  }
+
+  if (Addr != ST25DV_ADDR_DATA_I2C)
+    return NFCTAG_NACK;
+
+  if ((Reg & ST25DV_IS_DYNAMIC_REGISTER) == 0) {
+    if ((uint32_t) Reg + Length > SIM_ST25DV_EEPROM_SIZE)
+      return NFCTAG_ERROR;
+
+    memcpy(pData, &tag.eeprom[Reg], Length);
+    return NFCTAG_OK;
+  }
+
+  if ((uint32_t) Reg + Length > ST25DV_MAILBOX_RAM_REG + SIM_ST25DV_MAILBOX_SIZE)
+    return NFCTAG_ERROR;
+
+  for (uint16_t i = 0; i < Length; i++) {
+    pData[i] = readDynamicRegister(Reg + i);
+  }
+
+  // the host has read the end of the RF message
+  const bool isMessageEndRead = Reg + Length >= ST25DV_MAILBOX_RAM_REG + tag.messageLength && Reg + Length > ST25DV_MAILBOX_RAM_REG;
+
+  if ((tag.mbCtrl & ST25DV_MB_CTRL_DYN_RFPUTMSG_MASK) && isMessageEndRead) {
+    tag.mbCtrl &= (uint8_t) ~ST25DV_MB_CTRL_DYN_RFPUTMSG_MASK;
+    tag.messageLength = 0;
+  }
+
+  return NFCTAG_OK;
+}
+
+int32_t SensorsBus_WriteReg16(uint16_t Addr, uint16_t Reg, uint8_t *pData, uint16_t Length) {
+  if (isHostRefused())
+    return NFCTAG_NACK;
+
+  tag.stats.hostBytes += Length;
+
+  if (Addr == ST25DV_ADDR_SYST_I2C) {
+    if (Reg == ST25DV_I2CPASSWD_REG) {
+      presentPassword(pData, Length);
+      return NFCTAG_OK;
+    }
+
+    // the system configuration is written in the I2C security session only, the identification is read-only
+    if (!tag.isSecuritySessionOpen || (uint32_t) Reg + Length > ST25DV_ICREF_REG) {
+      tag.stats.hostNacks++;
+      return NFCTAG_NACK;
+    }
+
+    memcpy(&tag.systemRegs[Reg], pData, Length);
+    return NFCTAG_OK;
+  }
+
+  if (Addr != ST25DV_ADDR_DATA_I2C)
+    return NFCTAG_NACK;
+
+  if ((Reg & ST25DV_IS_DYNAMIC_REGISTER) == 0) {
+    if ((uint32_t) Reg + Length > SIM_ST25DV_EEPROM_SIZE)
+      return NFCTAG_ERROR;
+
+    memcpy(&tag.eeprom[Reg], pData, Length);
+    tag.stats.eepromBytesWritten += Length;
+    return NFCTAG_OK;
+  }
+
+  if (Reg == ST25DV_MAILBOX_RAM_REG)
+    return writeMailbox(pData, Length);
+
+  if (Reg == ST25DV_MB_CTRL_DYN_REG && Length == 1) {
+    // disabling the mailbox drops its message
+    tag.mbCtrl = (pData[0] & ST25DV_MB_CTRL_DYN_MBEN_MASK) ? (tag.mbCtrl | ST25DV_MB_CTRL_DYN_MBEN_MASK) : 0;
+    tag.messageLength = (tag.mbCtrl != 0) ? tag.messageLength : 0;
+    return NFCTAG_OK;
+  }
+
+  return NFCTAG_OK; // the rest of the dynamic registers are read-only, the tag ignores the write
+}
+
+int32_t BSP_I2C1_Init(void) {
+  return NFCTAG_OK;
+}
+
+int32_t BSP_I2C1_DeInit(void) {
+  return NFCTAG_OK;
+}
+
+int32_t BSP_I2C1_IsReady(uint16_t DevAddr, uint32_t Trials) {
+  (void) DevAddr;
+  (void) Trials;
+
+  return tag.isRfBusy ? NFCTAG_NACK : NFCTAG_OK;
+}
+
+static uint8_t readDynamicRegister(uint16_t reg) {
+  uint8_t value;
+
+  switch (reg) {
+    case ST25DV_GPO_DYN_REG:
+      return tag.systemRegs[ST25DV_GPO_REG];
+    case ST25DV_EH_CTRL_DYN_REG:
+      return tag.isFieldOn ? ST25DV_EH_CTRL_DYN_FIELD_ON_MASK : 0;
+    case ST25DV_I2C_SSO_DYN_REG:
+      return tag.isSecuritySessionOpen ? ST25DV_I2C_SSO_DYN_I2CSSO_MASK : 0;
+    case ST25DV_ITSTS_DYN_REG:
+      value = tag.itStatus;
+      tag.itStatus = 0;
+      return value;
+    case ST25DV_MB_CTRL_DYN_REG:
+      return tag.mbCtrl;
+    case ST25DV_MBLEN_DYN_REG:
+      return (tag.messageLength > 0) ? (uint8_t) (tag.messageLength - 1) : 0;
+    default:
+      break;
+  }
+
+  if (reg >= ST25DV_MAILBOX_RAM_REG)
+    return tag.mailbox[reg - ST25DV_MAILBOX_RAM_REG];
+
+  return 0;
+}
+
+static int32_t writeMailbox(const uint8_t *pData, uint16_t length) {
+  if (length == 0 || length > SIM_ST25DV_MAILBOX_SIZE || !isMailboxFree()) {
+    tag.stats.hostNacks++;
+    return NFCTAG_NACK;
+  }
+
+  memcpy(tag.mailbox, pData, length);
+  tag.messageLength = length;
+  tag.mbCtrl |= ST25DV_MB_CTRL_DYN_HOSTPUTMSG_MASK;
+  tag.stats.hostMessagesWritten++;
+
+  return NFCTAG_OK;
+}
+
+/**
+ * @brief Opens the I2C security session on the right password, the default one is all zeros
+ */
+static void presentPassword(const uint8_t *pData, uint16_t length) {
+  static const uint8_t password[8] = {0};
+
+  tag.isSecuritySessionOpen = length == SIM_ST25DV_PASSWORD_SIZE
+    && pData[8] == SIM_ST25DV_PRESENT_PASSWORD
+    && memcmp(pData, password, sizeof(password)) == 0
+    && memcmp(&pData[9], password, sizeof(password)) == 0;
+}
+
+static void pulseGPO(uint8_t gpoMask) {
+  const uint8_t gpoConfig = tag.systemRegs[ST25DV_GPO_REG];
+
+  if ((gpoConfig & ST25DV_GPO_ENABLE_MASK) && (gpoConfig & gpoMask)) {
+    tag.stats.gpoPulses++;
+
+    if (tag.onGPOPulse != NULL) tag.onGPOPulse();
+  }
+}
+
+static bool isHostRefused(void) {
+  tag.stats.hostTransactions++;
+
+  if (tag.isRfBusyArmed && tag.rfBusyAfter-- == 0) {
+    tag.isRfBusy = true;
+    tag.isRfBusyArmed = false;
+  }
+
+  if (tag.isRfBusy) {
+    tag.stats.hostNacks++;
+  }
+
+  return tag.isRfBusy;
+}
+
+static bool isMailboxFree(void) {
+  return (tag.mbCtrl & ST25DV_MB_CTRL_DYN_MBEN_MASK)
+    && !(tag.mbCtrl & (ST25DV_MB_CTRL_DYN_HOSTPUTMSG_MASK | ST25DV_MB_CTRL_DYN_RFPUTMSG_MASK));
+}
@@ -0,0 +1,56 @@
+/*!
+ * @file sim_st25dv.h
+ * @brief Register-level ST25DV04K model behind the SensorsBus and BSP I2C1 functions, for the host builds linking
+ * the real ST25DV driver and the NFC actor
+ *
+ * The model keeps the 512 bytes user EEPROM, the system registers the NFC actor touches (GPO, ICREF, UID,
+ * I2C password) and the dynamic registers with the 256 bytes mailbox:
+ * - the host (I2C) write of the mailbox is refused while it holds a message not read by its reader;
+ * - the host read covering the end of the RF message releases it, the RF read of the whole host message releases it
+ *   and raises RFGETMSG;
+ * - the RF put and get of a message and the RF field change latch the interrupt status, cleared on read, and pulse
+ *   the GPO when enabled, the field level is in EH_CTRL_Dyn;
+ * - the phone writes and reads the mailbox in the field only;
+ * - the busy RF NACKs every I2C transaction, as the tag does while the RF is talking to it.
+ *
+ * @date 18/10/2026
+ */
+
+#ifndef SIM_ST25DV_H
+#define SIM_ST25DV_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SIM_ST25DV_EEPROM_SIZE        (512U)
+#define SIM_ST25DV_MAILBOX_SIZE       (256U)
+
+/**
+ * @brief I2C traffic and the RF mailbox exchanges since the reset
+ */
+typedef struct {
+  uint32_t hostTransactions;
+  uint32_t hostNacks;            ///< Refused by the busy RF or the mailbox holding a message
+  uint32_t hostBytes;            ///< Data bytes on the I2C, without the addresses
+  uint32_t hostMessagesWritten;
+  uint32_t rfMessagesWritten;
+  uint32_t rfMessagesRead;
+  uint32_t rfBytes;
+  uint32_t eepromBytesWritten;
+  uint32_t gpoPulses;
+} SIM_ST25DV_Stats_t;
+
+typedef void (*SIM_ST25DV_GPOPulse_t)(void);
+
+void SIM_ST25DV_Reset(SIM_ST25DV_GPOPulse_t onGPOPulse);
+bool SIM_ST25DV_RfWriteMessage(const uint8_t *data, uint16_t length);
+uint16_t SIM_ST25DV_RfReadMessage(uint8_t data[SIM_ST25DV_MAILBOX_SIZE]);
+bool SIM_ST25DV_HasHostMessage(void);
+void SIM_ST25DV_SetField(bool isOn);
+bool SIM_ST25DV_IsFieldOn(void);
+void SIM_ST25DV_SetRfBusy(bool isBusy);
+void SIM_ST25DV_SetRfBusyAfter(uint32_t hostTransactions);
+const uint8_t *SIM_ST25DV_GetEEPROM(void);
+const SIM_ST25DV_Stats_t *SIM_ST25DV_GetStats(void);
+
+#endif //SIM_ST25DV_H
@@ -0,0 +1,446 @@
+/*!
+ * @file test_nfc.c
+ * @brief Tests of the NFC actor through the mailbox: the pipelined commands, the immediate responses, the log
+ * transfers and the recovery from the RF session holding the tag
+ *
+ * @date 18/10/2026
+ */
+
+#include <string.h>
+
+#include "unity.h"
+#include "nfc_harness.h"
+#include "log_codec.h"
+#include "log_query.h"
+#include "supervisor.h"
+
+#define TEST_LOG_ENTRIES       (500U)
+#define TEST_MEMORY_LATENCY_MS (10U)
+
+typedef struct {
+  uint8_t entries[TEST_LOG_ENTRIES * MEMORY_LOG_ENTRY_SIZE];
+  uint32_t entriesCount;
+} TEST_DecodedLog_t;
+
+static uint8_t frame[ST25DV_MAX_MAILBOX_LENGTH];
+static uint8_t response[ST25DV_MAX_MAILBOX_LENGTH];
+
+void setUp(void) {
+  NFC_HARNESS_Init(TEST_LOG_ENTRIES, TEST_MEMORY_LATENCY_MS);
+}
+
+void tearDown(void) {
+  // the next test starts with the NFC actor idle, as the in-flight commands outlive the init
+  for (uint32_t i = 0; i < 100 && (!NFC_HARNESS_IsIdle() || SIM_ST25DV_HasHostMessage()); i++) {
+    NFC_HARNESS_PhoneRead(response);
+    NFC_HARNESS_Advance(TEST_MEMORY_LATENCY_MS);
+  }
+}
+
+static void sendCommand(uint8_t command, uint8_t sequence, const void *payload, uint8_t payloadSize) {
+  const uint16_t size = NFC_HARNESS_BuildFrame(frame, command, sequence, payload, payloadSize);
+
+  TEST_ASSERT_TRUE(NFC_HARNESS_PhoneWrite(frame, size));
+}
+
+/**
+ * @brief Passes the time until the device writes the mailbox, e.g. MEMORY has answered
+ */
+static void waitForResponse(void) {
+  for (uint32_t i = 0; i < 100 && !SIM_ST25DV_HasHostMessage(); i++) {
+    NFC_HARNESS_Advance(TEST_MEMORY_LATENCY_MS);
+  }
+}
+
+/**
+ * @brief Reads the next response and checks its framing
+ * @return Payload size
+ */
+static uint8_t readResponse(uint8_t code, uint8_t sequence) {
+  const uint16_t size = NFC_HARNESS_PhoneRead(response);
+
+  TEST_ASSERT_TRUE(NFC_HARNESS_IsValidResponse(response, size));
+  TEST_ASSERT_EQUAL_HEX8(code, response[NFC_MAILBOX_PROTOCOL_CMD_ADDR]);
+  TEST_ASSERT_EQUAL_UINT8(sequence, response[NFC_MAILBOX_PROTOCOL_SEQ_ADDR]);
+
+  return response[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR];
+}
+
+static void collectRecord(const uint8_t record[LOG_CODEC_RECORD_SIZE], void *context) {
+  TEST_DecodedLog_t *log = (TEST_DecodedLog_t *) context;
+
+  TEST_ASSERT_LESS_THAN_UINT32(TEST_LOG_ENTRIES, log->entriesCount);
+  memcpy(&log->entries[log->entriesCount++ * MEMORY_LOG_ENTRY_SIZE], record, LOG_CODEC_RECORD_SIZE);
+}
+
+void test_Nfc_PipelinedCommands_AnsweredWithTheirSequences(void) {
+  for (uint8_t sequence = 1; sequence <= NFC_COMMANDS_IN_FLIGHT; sequence++) {
+    sendCommand(GLOBAL_CMD_READ_SETTINGS, sequence, NULL, 0);
+  }
+
+  // all the commands are in MEMORY, no response yet
+  TEST_ASSERT_FALSE(SIM_ST25DV_HasHostMessage());
+  NFC_HARNESS_Advance(TEST_MEMORY_LATENCY_MS);
+
+  for (uint8_t sequence = 1; sequence <= NFC_COMMANDS_IN_FLIGHT; sequence++) {
+    TEST_ASSERT_EQUAL_UINT8(SETTINGS_DATA_SIZE, readResponse(NFC_RESPONSE_ACK_OK, sequence));
+    TEST_ASSERT_EQUAL_MEMORY(NFC_HARNESS_GetSettings(), &response[NFC_MAILBOX_PROTOCOL_PAYLOAD_ADDR], SETTINGS_DATA_SIZE);
+  }
+
+  TEST_ASSERT_TRUE(NFC_HARNESS_IsIdle());
+  TEST_ASSERT_EQUAL_UINT32(0, NFC_HARNESS_GetStats()->queueOverflows);
+}
+
+void test_Nfc_ImmediateCommand_AnsweredBeforeTheExecutingOne(void) {
+  sendCommand(GLOBAL_CMD_READ_SETTINGS, 0x21, NULL, 0);
+  sendCommand(GLOBAL_CMD_STOP_LOGGING, 0x22, NULL, 0);
+
+  readResponse(NFC_RESPONSE_ACK_OK, 0x22);
+  NFC_HARNESS_Advance(TEST_MEMORY_LATENCY_MS);
+  readResponse(NFC_RESPONSE_ACK_OK, 0x21);
+}
+
+void test_Nfc_CorruptedFrame_NackCRCWithItsSequence(void) {
+  const uint16_t size = NFC_HARNESS_BuildFrame(frame, GLOBAL_CMD_READ_SETTINGS, 0x5A, NULL, 0);
+  frame[NFC_MAILBOX_PROTOCOL_CRC8_ADDR] ^= 0x01;
+
+  TEST_ASSERT_TRUE(NFC_HARNESS_PhoneWrite(frame, size));
+
+  TEST_ASSERT_EQUAL_UINT8(0, readResponse(NFC_RESPONSE_NACK_CRC_ERROR, 0x5A));
+}
+
+void test_Nfc_PayloadSizeBeyondTheMailbox_NackCRC(void) {
+  NFC_HARNESS_BuildFrame(frame, GLOBAL_CMD_WRITE_SETTINGS, 0x5B, NULL, 0);
+  frame[NFC_MAILBOX_PROTOCOL_PAYLOAD_SIZE_ADDR] = 0xFF;
+
+  TEST_ASSERT_TRUE(NFC_HARNESS_PhoneWrite(frame, NFC_MAILBOX_PROTOCOL_HEADER_SIZE));
+
+  readResponse(NFC_RESPONSE_NACK_CRC_ERROR, 0x5B);
+}
+
+void test_Nfc_UnknownCommand_Nack(void) {
+  sendCommand(GLOBAL_CMD_MAX, 0x30, NULL, 0);
+  readResponse(NFC_RESPONSE_NACK_ERROR, 0x30);
+
+  sendCommand(GLOBAL_CMD_INITIALIZE, 0x31, NULL, 0);
+  readResponse(NFC_RESPONSE_NACK_ERROR, 0x31);
+}
+
+void test_Nfc_AllSlotsExecuting_NackBusy(void) {
+  for (uint8_t sequence = 1; sequence <= NFC_COMMANDS_IN_FLIGHT; sequence++) {
+    sendCommand(GLOBAL_CMD_READ_SETTINGS, sequence, NULL, 0);
+  }
+
+  sendCommand(GLOBAL_CMD_READ_SETTINGS, 0x40, NULL, 0);
+  readResponse(NFC_RESPONSE_NACK_BUSY, 0x40);
+
+  NFC_HARNESS_Advance(TEST_MEMORY_LATENCY_MS);
+  readResponse(NFC_RESPONSE_ACK_OK, 1);
+}
+
+void test_Nfc_WriteSettings_WrongSizeRejectedRightSizeWritten(void) {
+  uint8_t settings[SETTINGS_DATA_SIZE];
+  memset(settings, 0xA5, sizeof(settings));
+
+  sendCommand(GLOBAL_CMD_WRITE_SETTINGS, 0x50, settings, SETTINGS_DATA_SIZE - 1);
+  readResponse(NFC_RESPONSE_NACK_ERROR, 0x50);
+
+  sendCommand(GLOBAL_CMD_WRITE_SETTINGS, 0x51, settings, SETTINGS_DATA_SIZE);
+  NFC_HARNESS_Advance(TEST_MEMORY_LATENCY_MS);
+  readResponse(NFC_RESPONSE_ACK_OK, 0x51);
+
+  TEST_ASSERT_EQUAL_MEMORY(settings, NFC_HARNESS_GetSettings(), SETTINGS_DATA_SIZE);
+}
+
+void test_Nfc_WakeUpPeriodCommands_WrongSizeRejectedRightSizeDispatchedToCron(void) {
+  const NFC_WakeUpPeriodBounds_t bounds = {.minPeriodSeconds = 60, .maxPeriodSeconds = 900};
+  const uint16_t periodSeconds = 120;
+
+  sendCommand(GLOBAL_CMD_SET_WAKE_UP_PERIOD_BOUNDS, 0x52, &bounds, sizeof(bounds) - 1);
+  readResponse(NFC_RESPONSE_NACK_ERROR, 0x52);
+  TEST_ASSERT_NOT_EQUAL(GLOBAL_CMD_SET_WAKE_UP_PERIOD_BOUNDS, NFC_HARNESS_GetSinkMessage(CRON_ACTOR_ID)->event);
+
+  sendCommand(GLOBAL_CMD_SET_WAKE_UP_PERIOD_BOUNDS, 0x53, &bounds, sizeof(bounds));
+  readResponse(NFC_RESPONSE_ACK_OK, 0x53);
+
+  const NFC_HARNESS_SinkMessage_t *cronMessage = NFC_HARNESS_GetSinkMessage(CRON_ACTOR_ID);
+  TEST_ASSERT_EQUAL(GLOBAL_CMD_SET_WAKE_UP_PERIOD_BOUNDS, cronMessage->event);
+  TEST_ASSERT_EQUAL_UINT16(sizeof(bounds), cronMessage->payloadSize);
+  TEST_ASSERT_EQUAL_MEMORY(&bounds, cronMessage->payload, sizeof(bounds));
+
+  sendCommand(GLOBAL_CMD_SET_WAKE_UP_PERIOD, 0x54, &periodSeconds, sizeof(periodSeconds));
+  readResponse(NFC_RESPONSE_ACK_OK, 0x54);
+
+  TEST_ASSERT_EQUAL(GLOBAL_CMD_SET_WAKE_UP_PERIOD, cronMessage->event);
+  TEST_ASSERT_EQUAL_MEMORY(&periodSeconds, cronMessage->payload, sizeof(periodSeconds));
+}
+
+void test_Nfc_QueryLog_CountsTheMeasurementsWithinTheRange(void) {
+  const LOG_QUERY_Request_t request = {
+    .from = NFC_HARNESS_LOG_START_TIMESTAMP,
+    .to = NFC_HARNESS_LOG_START_TIMESTAMP + (int32_t) (TEST_LOG_ENTRIES - 1) * NFC_HARNESS_LOG_PERIOD_S,
+    .channel = LOG_QUERY_TEMPERATURE,
+    .threshold = 10000,
+  };
+  LOG_QUERY_Result_t result;
+
+  sendCommand(GLOBAL_CMD_QUERY_LOG, 0x60, &request, sizeof(request));
+  NFC_HARNESS_Advance(TEST_MEMORY_LATENCY_MS);
+
+  TEST_ASSERT_EQUAL_UINT8(sizeof(result), readResponse(NFC_RESPONSE_ACK_OK, 0x60));
+  memcpy(&result, &response[NFC_MAILBOX_PROTOCOL_PAYLOAD_ADDR], sizeof(result));
+
+  // every 97th entry is the wake up period marker
+  TEST_ASSERT_EQUAL_UINT32(TEST_LOG_ENTRIES - TEST_LOG_ENTRIES / 97, result.count);
+  TEST_ASSERT_EQUAL_UINT32(0, result.secondsAbove);
+}
+
+void test_Nfc_LogChunks_DecodeToTheLog(void) {
+  static TEST_DecodedLog_t decoded;
+  const NFC_LogExportRange_t range = {.firstEntry = 0, .entriesCount = 0};
+  LOG_CODEC_State_t codec;
+  uint32_t framesCount = 0;
+
+  decoded.entriesCount = 0;
+  LOG_CODEC_Init(&codec);
+
+  sendCommand(GLOBAL_CMD_READ_LOG_CHUNK, 0x70, &range, sizeof(range));
+
+  for (;;) {
+    waitForResponse();
+
+    const uint8_t payloadSize = readResponse(NFC_RESPONSE_ACK_OK, 0x70);
+    if (payloadSize == 0) break;
+
+    TEST_ASSERT_NOT_EQUAL(LOG_CODEC_ERROR, LOG_CODEC_Decode(&codec, &response[NFC_MAILBOX_PROTOCOL_PAYLOAD_ADDR], payloadSize, collectRecord, &decoded));
+    TEST_ASSERT_LESS_THAN_UINT32(TEST_LOG_ENTRIES, ++framesCount);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(TEST_LOG_ENTRIES, decoded.entriesCount);
+  TEST_ASSERT_EQUAL_MEMORY(NFC_HARNESS_GetLogEntry(0), decoded.entries, TEST_LOG_ENTRIES * MEMORY_LOG_ENTRY_SIZE);
+  // compressed: fewer frames than the raw entries take
+  TEST_ASSERT_LESS_THAN_UINT32(TEST_LOG_ENTRIES * MEMORY_LOG_ENTRY_SIZE / (ST25DV_MAX_MAILBOX_LENGTH - NFC_MAILBOX_PROTOCOL_HEADER_SIZE), framesCount);
+}
+
+void test_Nfc_LogChunksOutOfTheLog_Nack(void) {
+  const NFC_LogExportRange_t range = {.firstEntry = TEST_LOG_ENTRIES, .entriesCount = 1};
+
+  sendCommand(GLOBAL_CMD_READ_LOG_CHUNK, 0x71, &range, sizeof(range));
+  waitForResponse();
+
+  readResponse(NFC_RESPONSE_NACK_ERROR, 0x71);
+}
+
+void test_Nfc_LogExport_SendsTheRangeOverFTM(void) {
+  const NFC_LogExportRange_t range = {.firstEntry = 10, .entriesCount = 300};
+  uint32_t length;
+
+  sendCommand(GLOBAL_CMD_EXPORT_LOG, 0x72, &range, sizeof(range));
+
+  for (uint32_t i = 0; i < 1000 && !NFC_HARNESS_IsIdle(); i++) {
+    NFC_HARNESS_Advance(NFC_LOG_EXPORT_POLL_PERIOD_MS);
+  }
+
+  const uint8_t *received = NFC_HARNESS_GetFTMReceived(&length);
+
+  TEST_ASSERT_TRUE(NFC_HARNESS_IsIdle());
+  TEST_ASSERT_EQUAL_UINT32(1, NFC_HARNESS_GetStats()->ftmTransfers);
+  TEST_ASSERT_EQUAL_UINT32(range.entriesCount * MEMORY_LOG_ENTRY_SIZE, length);
+  TEST_ASSERT_EQUAL_MEMORY(NFC_HARNESS_GetLogEntry(range.firstEntry), received, length);
+
+  // the actor is back in standby
+  sendCommand(GLOBAL_CMD_STOP_LOGGING, 0x73, NULL, 0);
+  readResponse(NFC_RESPONSE_ACK_OK, 0x73);
+}
+
+void test_Nfc_LogChunks_WhileTheUSBExportOwnsTheBuffers_NackThenReleasedAfterTheStream(void) {
+  const NFC_LogExportRange_t range = {.firstEntry = 0, .entriesCount = 10};
+
+  TEST_ASSERT_NOT_NULL(LOG_TRANSFER_POOL_Claim(USB_STREAM_ACTOR_ID));
+
+  sendCommand(GLOBAL_CMD_READ_LOG_CHUNK, 0x74, &range, sizeof(range));
+  waitForResponse();
+  readResponse(NFC_RESPONSE_NACK_ERROR, 0x74);
+
+  LOG_TRANSFER_POOL_Release(USB_STREAM_ACTOR_ID);
+
+  sendCommand(GLOBAL_CMD_READ_LOG_CHUNK, 0x75, &range, sizeof(range));
+  for (;;) {
+    waitForResponse();
+    if (readResponse(NFC_RESPONSE_ACK_OK, 0x75) == 0) break;
+    TEST_ASSERT_NULL(LOG_TRANSFER_POOL_Claim(USB_STREAM_ACTOR_ID));
+  }
+
+  // the stream is over, the USB export can claim the buffers
+  TEST_ASSERT_NOT_NULL(LOG_TRANSFER_POOL_Claim(USB_STREAM_ACTOR_ID));
+  LOG_TRANSFER_POOL_Release(USB_STREAM_ACTOR_ID);
+}
+
+void test_Nfc_ResponseRefusedByTheRfSession_RestartedBySupervisor(void) {
+  const uint32_t restartsCount = SUPERVISOR_GetRestartsCount(NFC_ACTOR_ID);
+
+  // the tag status and the message are read, the NACK write is refused
+  SIM_ST25DV_SetRfBusyAfter(2);
+  sendCommand(GLOBAL_CMD_MAX, 0x80, NULL, 0);
+
+  TEST_ASSERT_EQUAL_UINT32(1, NFC_HARNESS_GetStats()->actorErrors);
+  TEST_ASSERT_EQUAL(NFC_STATE_ERROR, NFC_Actor.state);
+  TEST_ASSERT_FALSE(SIM_ST25DV_HasHostMessage());
+
+  // the restarted NFC reads the tag status after the debounce
+  NFC_HARNESS_SetRfBusy(false);
+  NFC_HARNESS_Advance(SUPERVISOR_BACKOFF_BASE_MS + NFC_FIELD_DEBOUNCE_MS);
+
+  TEST_ASSERT_EQUAL_UINT32(restartsCount + 1, SUPERVISOR_GetRestartsCount(NFC_ACTOR_ID));
+  TEST_ASSERT_EQUAL(NFC_STANDBY_STATE, NFC_Actor.state);
+
+  // the phone resends the command
+  sendCommand(GLOBAL_CMD_MAX, 0x81, NULL, 0);
+  readResponse(NFC_RESPONSE_NACK_ERROR, 0x81);
+}
+
+/**
+ * @brief Phone leaves the tag, the session ends on the field falling pulse
+ */
+static void endSession(void) {
+  NFC_HARNESS_SetField(false);
+  NFC_HARNESS_Advance(NFC_FIELD_DEBOUNCE_MS);
+
+  TEST_ASSERT_FALSE(NFC_Actor.isFieldOn);
+  TEST_ASSERT_TRUE(NFC_HARNESS_IsIdle());
+}
+
+void test_Nfc_ShortTap_OneStatusReadAfterTheDebounce(void) {
+  endSession();
+  const uint32_t transactions = SIM_ST25DV_GetStats()->hostTransactions;
+
+  // e.g. the NDEF summary read without the app
+  NFC_HARNESS_SetField(true);
+  NFC_HARNESS_Advance(NFC_FIELD_DEBOUNCE_MS / 2);
+  NFC_HARNESS_SetField(false);
+
+  TEST_ASSERT_EQUAL_UINT32(transactions, SIM_ST25DV_GetStats()->hostTransactions);
+
+  NFC_HARNESS_Advance(NFC_FIELD_DEBOUNCE_MS);
+
+  TEST_ASSERT_EQUAL_UINT32(transactions + 1, SIM_ST25DV_GetStats()->hostTransactions);
+  TEST_ASSERT_EQUAL(NFC_STANDBY_STATE, NFC_Actor.state);
+  TEST_ASSERT_FALSE(NFC_Actor.isFieldOn);
+}
+
+void test_Nfc_FirstCommandOfTheTap_StatusAndMessageRead(void) {
+  endSession();
+  const uint32_t transactions = SIM_ST25DV_GetStats()->hostTransactions;
+
+  // the field rising and the command pulses are merged
+  sendCommand(GLOBAL_CMD_STOP_LOGGING, 0x90, NULL, 0);
+  TEST_ASSERT_EQUAL_UINT32(transactions, SIM_ST25DV_GetStats()->hostTransactions);
+
+  NFC_HARNESS_Advance(NFC_FIELD_DEBOUNCE_MS);
+
+  // the tag status, the message and the response write
+  TEST_ASSERT_EQUAL_UINT32(transactions + 3, SIM_ST25DV_GetStats()->hostTransactions);
+  TEST_ASSERT_TRUE(NFC_Actor.isFieldOn);
+  readResponse(NFC_RESPONSE_ACK_OK, 0x90);
+
+  // in the session the command is received at once
+  sendCommand(GLOBAL_CMD_STOP_LOGGING, 0x91, NULL, 0);
+  readResponse(NFC_RESPONSE_ACK_OK, 0x91);
+}
+
+void test_Nfc_SummaryWrite_DeferredToTheSessionEnd(void) {
+  const ACQUISITION_Frame_t measurements = {
+    .timestamp = NFC_HARNESS_LOG_START_TIMESTAMP,
+    .rawTemperature = 0x6000,
+    .rawHumidity = 0x8000,
+    .rawLux = 0x1000,
+    .validMask = ACQUISITION_ALL_VALID,
+  };
+  const uint32_t eepromBytesWritten = SIM_ST25DV_GetStats()->eepromBytesWritten;
+
+  NFC_HARNESS_PostMeasurementsFrame(&measurements);
+  TEST_ASSERT_EQUAL_UINT32(eepromBytesWritten, SIM_ST25DV_GetStats()->eepromBytesWritten);
+
+  // in the session the falling pulse is handled at once
+  NFC_HARNESS_SetField(false);
+
+  TEST_ASSERT_GREATER_THAN_UINT32(eepromBytesWritten, SIM_ST25DV_GetStats()->eepromBytesWritten);
+}
+
+void test_Nfc_SummaryOfTheFramesInTheSession_WrittenOnTheFieldOff(void) {
+  const ACQUISITION_Frame_t measurements = {
+    .timestamp = NFC_HARNESS_LOG_START_TIMESTAMP + 60,
+    .rawTemperature = 0x7000,
+    .rawHumidity = 0x9000,
+    .rawLux = 0x2000,
+    .validMask = ACQUISITION_ALL_VALID,
+  };
+  endSession();
+  const uint32_t eepromBytesWritten = SIM_ST25DV_GetStats()->eepromBytesWritten;
+
+  // the frame arrives between the field rising and the status read
+  NFC_HARNESS_SetField(true);
+  NFC_HARNESS_PostMeasurementsFrame(&measurements);
+  TEST_ASSERT_EQUAL(NFC_MAILBOX_RECEIVE_CMD_STATE, NFC_Actor.state);
+
+  NFC_HARNESS_Advance(NFC_FIELD_DEBOUNCE_MS);
+  TEST_ASSERT_EQUAL_UINT32(eepromBytesWritten, SIM_ST25DV_GetStats()->eepromBytesWritten);
+
+  NFC_HARNESS_SetField(false);
+
+  TEST_ASSERT_GREATER_THAN_UINT32(eepromBytesWritten, SIM_ST25DV_GetStats()->eepromBytesWritten);
+  TEST_ASSERT_EQUAL(NFC_STANDBY_STATE, NFC_Actor.state);
+}
+
+void test_Nfc_LogExport_PhoneAway_NotPolledResumedThenAborted(void) {
+  const NFC_LogExportRange_t range = {.firstEntry = 0, .entriesCount = 0};
+
+  sendCommand(GLOBAL_CMD_EXPORT_LOG, 0x92, &range, sizeof(range));
+  NFC_HARNESS_Advance(NFC_LOG_EXPORT_POLL_PERIOD_MS * 4);
+
+  // the bus is released at once, the phone back in time resumes the export
+  NFC_HARNESS_SetField(false);
+  uint32_t transactions = SIM_ST25DV_GetStats()->hostTransactions;
+  NFC_HARNESS_Advance(NFC_LOG_EXPORT_FIELD_LOST_TIMEOUT_MS / 2);
+
+  TEST_ASSERT_EQUAL_UINT32(transactions, SIM_ST25DV_GetStats()->hostTransactions);
+  TEST_ASSERT_EQUAL(NFC_LOG_EXPORT_STATE, NFC_Actor.state);
+
+  NFC_HARNESS_SetField(true);
+  NFC_HARNESS_Advance(NFC_LOG_EXPORT_POLL_PERIOD_MS * 4);
+  TEST_ASSERT_GREATER_THAN_UINT32(transactions, SIM_ST25DV_GetStats()->hostTransactions);
+
+  // the phone away for too long aborts it
+  NFC_HARNESS_SetField(false);
+  NFC_HARNESS_Advance(NFC_LOG_EXPORT_FIELD_LOST_TIMEOUT_MS + NFC_FIELD_DEBOUNCE_MS);
+
+  TEST_ASSERT_EQUAL(NFC_STANDBY_STATE, NFC_Actor.state);
+  TEST_ASSERT_EQUAL_UINT32(0, NFC_HARNESS_GetStats()->ftmTransfers);
+  TEST_ASSERT_TRUE(NFC_HARNESS_IsIdle());
+}
+
+int main(void) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_Nfc_PipelinedCommands_AnsweredWithTheirSequences);
+  RUN_TEST(test_Nfc_ImmediateCommand_AnsweredBeforeTheExecutingOne);
+  RUN_TEST(test_Nfc_CorruptedFrame_NackCRCWithItsSequence);
+  RUN_TEST(test_Nfc_PayloadSizeBeyondTheMailbox_NackCRC);
+  RUN_TEST(test_Nfc_UnknownCommand_Nack);
+  RUN_TEST(test_Nfc_AllSlotsExecuting_NackBusy);
+  RUN_TEST(test_Nfc_WriteSettings_WrongSizeRejectedRightSizeWritten);
+  RUN_TEST(test_Nfc_WakeUpPeriodCommands_WrongSizeRejectedRightSizeDispatchedToCron);
+  RUN_TEST(test_Nfc_QueryLog_CountsTheMeasurementsWithinTheRange);
+  RUN_TEST(test_Nfc_LogChunks_DecodeToTheLog);
+  RUN_TEST(test_Nfc_LogChunksOutOfTheLog_Nack);
+  RUN_TEST(test_Nfc_LogExport_SendsTheRangeOverFTM);
+  RUN_TEST(test_Nfc_LogChunks_WhileTheUSBExportOwnsTheBuffers_NackThenReleasedAfterTheStream);
+  RUN_TEST(test_Nfc_ResponseRefusedByTheRfSession_RestartedBySupervisor);
+  RUN_TEST(test_Nfc_ShortTap_OneStatusReadAfterTheDebounce);
+  RUN_TEST(test_Nfc_FirstCommandOfTheTap_StatusAndMessageRead);
+  RUN_TEST(test_Nfc_SummaryWrite_DeferredToTheSessionEnd);
+  RUN_TEST(test_Nfc_SummaryOfTheFramesInTheSession_WrittenOnTheFieldOff);
+  RUN_TEST(test_Nfc_LogExport_PhoneAway_NotPolledResumedThenAborted);
+
+  return UNITY_END();
+}
@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""
+Decodes the compressed log chunks stream (see app/core/log_codec/log_codec.h) to the log entries.
+
+The NFC actor answers GLOBAL_CMD_READ_LOG_CHUNK with the mailbox frames carrying the log codec stream,
+the frame without payload ends it. The input is either the frames as read from the mailbox one after another
+(CRC-8 is checked) or the concatenated frame payloads (--payloads).
+
+The entries are printed as CSV in the log entry format of app/tests/core/log_policy/traces,
+the shock pointer and the wake up period entries as comments. --raw writes the 22 bytes entries instead,
+e.g. to compare with the NOR Flash image.
+
+Usage:
+    ./scripts/decode_log_stream.py frames.bin > log.csv
+    ./scripts/decode_log_stream.py payloads.bin --payloads --raw log.bin
+"""
+
+import argparse
+import struct
+import sys
+
+RECORD_SIZE = 22
+WORDS_COUNT = RECORD_SIZE // 2
+FIELDS_COUNT = WORDS_COUNT - 1
+RECORD_TOKEN = 0x80
+MASK_HIGH_BITS = 0x03
+
+FRAME_HEADER_SIZE = 4
+RESPONSE_ACK_OK = 0x00
+CRC8_POLYNOMIAL = 0x31
+CRC8_INIT = 0xFF
+
+SHOCK_POINTER_MARKER = 0xFFFF
+WAKE_UP_PERIOD_MARKER = 0xFFFE
+
+MEASUREMENT = struct.Struct("<iHHHhhhBBBBH")
+SHOCK_POINTER = struct.Struct("<iHHIIIH")
+WAKE_UP_PERIOD = struct.Struct("<iHHHB11s")
+
+
+class DecodeError(Exception):
+    pass
+
+
+class LogCodecDecoder:
+    """Mirror of LOG_CODEC_Decode(), the state is carried across the chunks"""
+
+    def __init__(self):
+        self.previous = [0] * WORDS_COUNT
+        self.timestamp_delta = 0
+
+    def decode(self, chunk):
+        """Yields the 22 bytes entries of the chunk"""
+        position = 0
+        while position < len(chunk):
+            token = chunk[position]
+            position += 1
+            residuals = [0] * FIELDS_COUNT
+            count = 1
+
+            if token < RECORD_TOKEN:
+                count = token + 1
+            else:
+                if token > (RECORD_TOKEN | MASK_HIGH_BITS) or position >= len(chunk):
+                    raise DecodeError(f"bad token 0x{token:02x} at {position - 1}")
+                mask = ((token & MASK_HIGH_BITS) << 8) | chunk[position]
+                position += 1
+                if mask == 0:
+                    raise DecodeError(f"empty mask at {position - 2}")
+                for field in range(FIELDS_COUNT):
+                    if mask & (1 << field):
+                        residuals[field], position = read_varint(chunk, position, 5 if field == 0 else 3)
+
+            for _ in range(count):
+                yield self.next_record(residuals)
+
+    def next_record(self, residuals):
+        previous_timestamp = self.previous[0] | (self.previous[1] << 16)
+        timestamp = (previous_timestamp + self.timestamp_delta + unzigzag(residuals[0])) & 0xFFFFFFFF
+        words = [timestamp & 0xFFFF, timestamp >> 16]
+        words += [(self.previous[field + 1] + unzigzag(residuals[field])) & 0xFFFF for field in range(1, FIELDS_COUNT)]
+
+        self.timestamp_delta = (timestamp - previous_timestamp) & 0xFFFFFFFF
+        self.previous = words
+
+        return struct.pack(f"<{WORDS_COUNT}H", *words)
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def read_varint(data, position, max_bytes):
+    value = 0
+    for i in range(max_bytes):
+        if position >= len(data):
+            break
+        byte = data[position]
+        position += 1
+        value |= (byte & 0x7F) << (7 * i)
+        if not byte & 0x80:
+            return value, position
+    raise DecodeError(f"truncated varint at {position}")
+
+
+def crc8(data):
+    """CRC-8/NRSC-5 of the mailbox frame"""
+    crc = CRC8_INIT
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ CRC8_POLYNOMIAL) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def split_frames(data):
+    """Yields the payloads of the mailbox frames up to the end of the stream frame"""
+    position = 0
+    while position + FRAME_HEADER_SIZE <= len(data):
+        crc, code, _sequence, size = data[position:position + FRAME_HEADER_SIZE]
+        frame = data[position:position + FRAME_HEADER_SIZE + size]
+        if len(frame) < FRAME_HEADER_SIZE + size or crc != crc8(frame[1:]):
+            raise DecodeError(f"bad frame at {position}")
+        if code != RESPONSE_ACK_OK:
+            raise DecodeError(f"response code 0x{code:02x} at {position}")
+        if size == 0:
+            return
+        yield frame[FRAME_HEADER_SIZE:]
+        position += len(frame)
+    raise DecodeError("no end of stream frame")
+
+
+def format_record(record):
+    marker, = struct.unpack_from("<H", record, 4)
+    if marker == SHOCK_POINTER_MARKER:
+        timestamp, _, samples, address, sequence, tick, _ = SHOCK_POINTER.unpack(record)
+        return f"# {timestamp} shock capture #{sequence}: {samples} samples at 0x{address:06x}, tick {tick}"
+    if marker == WAKE_UP_PERIOD_MARKER:
+        timestamp, _, period, previous, reason, _ = WAKE_UP_PERIOD.unpack(record)
+        return f"# {timestamp} wake up period {previous}s -> {period}s, reason {reason}"
+
+    timestamp, temperature, humidity, lux, x, y, z, rms, _, magnitude, _, suppressed = MEASUREMENT.unpack(record)
+    return f"{timestamp},{temperature},{humidity},{lux},{x},{y},{z},{rms},{magnitude},{suppressed}"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("stream", help="mailbox frames or their payloads, read one after another")
+    parser.add_argument("--payloads", action="store_true", help="the input is the concatenated frame payloads")
+    parser.add_argument("--raw", metavar="FILE", help="write the 22 bytes entries to the file instead of CSV")
+    args = parser.parse_args()
+
+    data = open(args.stream, "rb").read()
+    decoder = LogCodecDecoder()
+    records = []
+
+    try:
+        chunks = [data] if args.payloads else split_frames(data)
+        for chunk in chunks:
+            records.extend(decoder.decode(chunk))
+    except DecodeError as error:
+        print(f"{args.stream}: {error}, {len(records)} entries decoded", file=sys.stderr)
+        return 1
+
+    if args.raw:
+        with open(args.raw, "wb") as output:
+            output.write(b"".join(records))
+        return 0
+
+    print("# timestamp,rawTemperature,rawHumidity,rawLux,accelX,accelY,accelZ,vibrationRms,vibrationMagnitude,suppressedCount")
+    for record in records:
+        print(format_record(record))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""
+Decodes the binary trace log (see app/core/trace/trace_log.h) back to text.
+
+The firmware records only the format string ID (offset in the `.trace_fmt` ELF section),
+the HAL tick and integer arguments. The format strings are read from the firmware ELF.
+
+Capture the records from RTT channel 2, e.g.:
+    JLinkRTTLogger -Device STM32L412KB -If SWD -Speed 4000 -RTTChannel 2 trace.bin
+
+Usage:
+    ./scripts/decode_trace_log.py build/iot-risk-logger-stm32l4.elf trace.bin
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+TRACE_FORMAT_SECTION = ".trace_fmt"
+RECORD_HEADER = struct.Struct("<HBBI")
+FORMAT_ID_MASK = 0xFFFF
+CONVERSION_RE = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|z|j|t)?([diouxXcp%])")
+
+
+def read_trace_formats(elf_path):
+    """Returns {format ID: format string} from the ELF .trace_fmt section"""
+    data = open(elf_path, "rb").read()
+    if data[:4] != b"\x7fELF":
+        raise ValueError(f"{elf_path} is not an ELF file")
+
+    is_64bit = data[4] == 2
+    endian = "<" if data[5] == 1 else ">"
+    if is_64bit:
+        section_offset, = struct.unpack_from(endian + "Q", data, 0x28)
+        entry_size, entries, names_index = struct.unpack_from(endian + "HHH", data, 0x3A)
+        section_header = struct.Struct(endian + "IIQQQQIIQQ")
+    else:
+        section_offset, = struct.unpack_from(endian + "I", data, 0x20)
+        entry_size, entries, names_index = struct.unpack_from(endian + "HHH", data, 0x2E)
+        section_header = struct.Struct(endian + "IIIIIIIIII")
+
+    sections = [section_header.unpack_from(data, section_offset + i * entry_size) for i in range(entries)]
+    names_offset = sections[names_index][4]
+
+    for name, _, _, address, offset, size, *_ in sections:
+        section_name = data[names_offset + name:data.index(b"\0", names_offset + name)].decode()
+        if section_name != TRACE_FORMAT_SECTION:
+            continue
+
+        formats = {}
+        content = data[offset:offset + size]
+        position = 0
+        while position < len(content):
+            end = content.find(b"\0", position)
+            if end < 0:
+                end = len(content)
+            if end > position:
+                formats[(address + position) & FORMAT_ID_MASK] = content[position:end].decode(errors="replace")
+            position = end + 1
+        return formats
+
+    raise ValueError(f"{elf_path} has no {TRACE_FORMAT_SECTION} section")
+
+
+def format_record(format_string, args):
+    """printf-like formatting of 32-bit integer arguments"""
+    args = iter(args)
+
+    def convert(match):
+        flags, length, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+        value = next(args, 0)
+        if conversion in "di":
+            bits = {"hh": 8, "h": 16}.get(length, 32)
+            value &= (1 << bits) - 1
+            value = value - (1 << bits) if value >> (bits - 1) else value
+        elif conversion == "p":
+            return f"0x{value:08x}"
+        elif conversion == "u":
+            conversion = "d"
+        return ("%" + flags + conversion) % value
+
+    return CONVERSION_RE.sub(convert, format_string)
+
+
+def decode(formats, records):
+    """Yields decoded lines, reports sequence gaps (records dropped on the full RTT buffer)"""
+    position = 0
+    expected_sequence = None
+    while position + RECORD_HEADER.size <= len(records):
+        format_id, args_count, sequence, tick = RECORD_HEADER.unpack_from(records, position)
+        position += RECORD_HEADER.size
+        args = struct.unpack_from(f"<{args_count}I", records, position) if args_count else ()
+        position += 4 * args_count
+
+        if expected_sequence is not None and sequence != expected_sequence:
+            yield f"[{tick:>10}] <{(sequence - expected_sequence) & 0xFF} records dropped>"
+        expected_sequence = (sequence + 1) & 0xFF
+
+        format_string = formats.get(format_id)
+        if format_string is None:
+            yield f"[{tick:>10}] <unknown format 0x{format_id:04x}> {' '.join(hex(arg) for arg in args)}"
+            continue
+
+        for line in format_record(format_string, args).rstrip("\n").split("\n"):
+            yield f"[{tick:>10}] {line}"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="firmware ELF the records were captured from")
+    parser.add_argument("records", help="binary records captured from the TraceLog RTT channel")
+    args = parser.parse_args()
+
+    formats = read_trace_formats(args.elf)
+    with open(args.records, "rb") as records:
+        for line in decode(formats, records.read()):
+            print(line)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
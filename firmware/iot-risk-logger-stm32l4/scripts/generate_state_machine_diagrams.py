@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+"""
+Generates actors state diagrams from the FSM transition tables.
+
+Every actor keeps its behaviour in a const FSM_TRANSITION() table (see app/core/fsm/fsm.h).
+The script parses these tables and rewrites the transitions between the
+`' fsm-table-begin` / `' fsm-table-end` markers of the PlantUML block in the task README,
+so the diagrams never drift from the code. Hand-written parts of the diagram (states
+descriptions, notes, ERROR transitions) stay outside the markers and are kept as is.
+
+Usage:
+    ./scripts/generate_state_machine_diagrams.py                          # update READMEs
+    ./scripts/generate_state_machine_diagrams.py --check                  # fail if READMEs are outdated (CI)
+    ./scripts/generate_state_machine_diagrams.py --output-dir docs/diagrams  # also export .puml files
+"""
+
+import argparse
+import pathlib
+import re
+import sys
+
+ROOT = pathlib.Path(__file__).resolve().parent.parent
+TASKS_DIR = ROOT / "app" / "tasks"
+
+TRANSITION_RE = re.compile(
+    r"^\s*FSM_TRANSITION\(\s*(\w+)\s*,\s*(\w+)\s*,\s*(\w+)\s*,\s*(\w+)\s*\)\s*,?\s*(?://.*)?$"
+)
+PLANTUML_BLOCK_RE = re.compile(r"```plantuml\n(.*?)```", re.DOTALL)
+BEGIN_MARKER = "' fsm-table-begin"
+END_MARKER = "' fsm-table-end"
+NO_ACTION = "FSM_NO_ACTION"
+INITIAL_STATE = "NO"
+
+
+def parse_transitions(source):
+    transitions = []
+    for line in source.read_text().splitlines():
+        match = TRANSITION_RE.match(line)
+        if match:
+            transitions.append(match.groups())
+    return transitions
+
+
+def common_prefix(names):
+    """Common prefix of the identifiers, cut at the underscore boundary, e.g. LIGHT_SENS_"""
+    prefix = names[0]
+    for name in names[1:]:
+        while not name.startswith(prefix):
+            prefix = prefix[:-1]
+    return prefix[: prefix.rfind("_") + 1]
+
+
+def state_name(state, prefix):
+    name = state[len(prefix):]
+    name = re.sub(r"_STATE$", "", name)
+    name = re.sub(r"^STATE_", "", name)
+    return "[*]" if name == INITIAL_STATE else name
+
+
+def event_name(event, prefix):
+    return event[len(prefix):] if prefix and event.startswith(prefix) else event
+
+
+def render_transitions(transitions):
+    states = [row[0] for row in transitions] + [row[3] for row in transitions]
+    prefix = common_prefix(states)
+    lines = []
+    previous_state = None
+    for state, event, action, next_state in transitions:
+        if previous_state is not None and state != previous_state:
+            lines.append("")
+        label = event_name(event, prefix)
+        if action != NO_ACTION:
+            label += " / " + action
+        lines.append(f"{state_name(state, prefix)} --> {state_name(next_state, prefix)} : {label}")
+        previous_state = state
+    return lines
+
+
+def update_diagram(diagram, generated, source):
+    lines = diagram.split("\n")
+    try:
+        begin = next(i for i, line in enumerate(lines) if line.startswith(BEGIN_MARKER))
+        end = next(i for i, line in enumerate(lines) if line.startswith(END_MARKER))
+    except StopIteration:
+        return None
+    header = f"{BEGIN_MARKER} (generated from {source}, do not edit)"
+    return "\n".join(lines[:begin] + [header] + generated + lines[end:])
+
+
+def default_diagram(title, generated, source):
+    return "\n".join(["@startuml", f"title {title} FSM", "hide empty description", "",
+                      f"{BEGIN_MARKER} (generated from {source}, do not edit)"] + generated +
+                     [END_MARKER, "@enduml", ""])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--check", action="store_true", help="do not write, exit with 1 if a README is outdated")
+    parser.add_argument("--output-dir", type=pathlib.Path, help="directory to export .puml diagrams to")
+    args = parser.parse_args()
+
+    outdated = []
+    for source in sorted(TASKS_DIR.glob("*/*.c")):
+        transitions = parse_transitions(source)
+        if not transitions:
+            continue
+
+        generated = render_transitions(transitions)
+        relative_source = source.relative_to(ROOT).as_posix()
+        readme = source.parent / "README.md"
+        diagram = None
+
+        if readme.exists():
+            text = readme.read_text()
+            block = PLANTUML_BLOCK_RE.search(text)
+            diagram = update_diagram(block.group(1), generated, relative_source) if block else None
+            if diagram is None:
+                print(f"{readme.relative_to(ROOT)}: no '{BEGIN_MARKER}' markers, skipped", file=sys.stderr)
+            else:
+                updated = text[:block.start(1)] + diagram + text[block.end(1):]
+                if updated != text:
+                    outdated.append(readme.relative_to(ROOT).as_posix())
+                    if not args.check:
+                        readme.write_text(updated)
+
+        if args.output_dir:
+            args.output_dir.mkdir(parents=True, exist_ok=True)
+            puml = diagram or default_diagram(source.stem.upper(), generated, relative_source)
+            (args.output_dir / f"{source.stem}.puml").write_text(puml)
+
+    if args.check and outdated:
+        print("Outdated state diagrams, run scripts/generate_state_machine_diagrams.py:", file=sys.stderr)
+        for path in outdated:
+            print(f"  {path}", file=sys.stderr)
+        return 1
+
+    for path in outdated if not args.check else []:
+        print(f"updated {path}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+Replays the event stream captured by the event recorder (see app/core/event_recorder/event_recorder.h).
+
+The recorder stores every message published by the Event Manager and every message sent directly to an FSM actor
+in the circular area reserved at the end of the NOR Flash (EVENT_RECORDER_AREA_ADDR in app/core/fs_static/fs_static.h).
+The script orders the records from the erased gap, splits them into boot sessions and replays the selected session
+through the NFC actor host harness (app/tests/tasks/nfc, built as app/tests/build/replay_nfc): the real FSM, Event
+Manager, supervisor, actor timers and NFC actor run in virtual time. The phone commands are written to the simulated
+mailbox, the other actors' publishes are injected into the Event Manager, and the stream regenerated by the harness
+is compared with the recorded one, the first divergence fails the replay.
+
+Record marks: `>` injected, `=` regenerated by the harness and compared, blank - direct message to an actor which
+doesn't run in the harness, shown only.
+
+Event and actor names are read from app/config/events_list/events_list.h and app/config/actors_lookup/actors_lookup.h,
+so the replay follows the firmware sources it is run against.
+
+Dump either the whole NOR Flash image or only the recorder area, e.g. from the USB MSC disk:
+    dd if=/dev/sdX of=area.bin bs=4096 skip=2032 count=16
+
+Usage:
+    ./scripts/replay_event_stream.py area.bin
+    ./scripts/replay_event_stream.py flash.bin --session -1 --memory-latency 20
+"""
+
+import argparse
+import pathlib
+import re
+import struct
+import subprocess
+import sys
+import tempfile
+
+ROOT = pathlib.Path(__file__).resolve().parent.parent
+EVENTS_LIST = ROOT / "app/config/events_list/events_list.h"
+ACTORS_LOOKUP = ROOT / "app/config/actors_lookup/actors_lookup.h"
+HOST_TESTS = ROOT / "app/tests"
+REPLAY_NFC = HOST_TESTS / "build/replay_nfc"
+
+NOR_FLASH_SIZE = 0x800000
+AREA_SIZE = 0x10000
+AREA_ADDR = NOR_FLASH_SIZE - AREA_SIZE
+
+RECORD = struct.Struct("<IIHhIB15s")
+ERASED_SEQUENCE = 0xFFFFFFFF
+PUBLISHED = 0xFF
+
+ENUM_ENTRY_RE = re.compile(r"^\s*([A-Z][A-Z0-9_]*)\s*(?:=\s*(0x[0-9A-Fa-f]+|\d+))?\s*,?", re.MULTILINE)
+REPLAY_LINE_RE = re.compile(r"actor=(\d+)\s+event=0x([0-9a-f]{4})")
+
+
+def parse_enum(path, enum_name):
+    """Returns {value: name} of the typedef enum in the C header, comments are skipped"""
+    source = re.sub(r"/\*.*?\*/", "", re.sub(r"//.*", "", path.read_text()), flags=re.DOTALL)
+    body = re.search(r"typedef enum\s*\{(.*?)\}\s*" + enum_name + r"\s*;", source, re.DOTALL).group(1)
+
+    names, value = {}, 0
+    for match in ENUM_ENTRY_RE.finditer(body):
+        name, explicit = match.groups()
+        value = int(explicit, 0) if explicit else value
+        names[value] = name
+        value += 1
+    return names
+
+
+def read_area(path):
+    data = pathlib.Path(path).read_bytes()
+    if len(data) == NOR_FLASH_SIZE:
+        return data[AREA_ADDR:]
+    if len(data) != AREA_SIZE:
+        raise ValueError(f"{path} is neither the NOR Flash image nor the recorder area dump ({len(data)} bytes)")
+    return data
+
+
+def order_records(area):
+    """Rotates the circular area to start right after the erased gap, returns written records oldest first"""
+    slots = [area[offset:offset + RECORD.size] for offset in range(0, len(area), RECORD.size)]
+    written = [RECORD.unpack(slot)[0] != ERASED_SEQUENCE for slot in slots]
+
+    tail = next((i for i in range(len(slots)) if not written[i] and written[i - 1]), 0)
+    ordered = slots[tail:] + slots[:tail]
+    return [slot for slot in ordered if RECORD.unpack(slot)[0] != ERASED_SEQUENCE]
+
+
+def split_sessions(records):
+    """Sequence restarts from 0 on every boot"""
+    sessions = []
+    for record in records:
+        sequence = RECORD.unpack(record)[0]
+        if not sessions or sequence <= RECORD.unpack(sessions[-1][-1])[0]:
+            sessions.append([])
+        sessions[-1].append(record)
+    return sessions
+
+
+def build_replay():
+    subprocess.run(["make", "-s", "-C", str(HOST_TESTS), "build", "build/replay_nfc"], check=True)
+
+
+def name_line(line, events, actors):
+    """Replaces the numeric actor and event of the replay line with their names"""
+    def replace(match):
+        actor = int(match.group(1))
+        event = int(match.group(2), 16)
+        actor_name = "EV_MANAGER publish" if actor == PUBLISHED else actors.get(actor, f"ACTOR_{actor}")
+        return f"{actor_name:<36} {events.get(event, f'EVENT_0x{event:04x}'):<40}"
+    return REPLAY_LINE_RE.sub(replace, line)
+
+
+def replay(session, events, actors, args):
+    """Runs the session through the NFC harness, returns its exit status"""
+    with tempfile.NamedTemporaryFile(suffix=".bin") as stream:
+        stream.write(b"".join(session))
+        stream.flush()
+
+        command = [str(REPLAY_NFC), stream.name, "--log-entries", str(args.log_entries),
+                   "--memory-latency", str(args.memory_latency)]
+        process = subprocess.Popen(command, stdout=subprocess.PIPE, text=True)
+        for line in process.stdout:
+            print(name_line(line.rstrip("\n"), events, actors))
+        return process.wait()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("dump", help="NOR Flash image or the event recorder area dump")
+    parser.add_argument("--session", type=int, help="replay only the session with the index, -1 for the last one")
+    parser.add_argument("--log-entries", type=int, default=4096, help="entries of the log served by the MEMORY model")
+    parser.add_argument("--memory-latency", type=int, default=10, help="MEMORY model answer latency, ms")
+    parser.add_argument("--no-build", action="store_true", help="use the existing app/tests/build/replay_nfc")
+    args = parser.parse_args()
+
+    events = parse_enum(EVENTS_LIST, "event_t")
+    actors = parse_enum(ACTORS_LOOKUP, "ACTOR_ID")
+    sessions = split_sessions(order_records(read_area(args.dump)))
+
+    if not sessions:
+        print("no records", file=sys.stderr)
+        return 1
+
+    if not args.no_build:
+        build_replay()
+
+    status = 0
+    selected = range(len(sessions)) if args.session is None else [range(len(sessions))[args.session]]
+    for index in selected:
+        session = sessions[index]
+        ticks = [RECORD.unpack(record)[1] for record in (session[0], session[-1])]
+        print(f"--- session {index}: {len(session)} records, ticks {ticks[0]}..{ticks[1]}")
+        status |= replay(session, events, actors, args)
+    return 1 if status else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+"""
+Host client of the USB stream (see app/tasks/usb_stream/README.md): the log export and the live measurements frames
+over the CDC-ACM serial port of the logger, next to its MSC disk.
+
+The export is acknowledged with the clamped range and followed by the raw 22 bytes log entries as they are in the
+NOR Flash, written to the file as is (the same as --raw of decode_log_stream.py) or printed as CSV. The live frames
+are printed as CSV while the device measures, the dropped ones (e.g. during the export) are reported by the SEQ gap.
+
+Requires pyserial. The baud rate is ignored by the device, the pipe runs at the USB FS speed.
+
+Usage:
+    ./scripts/usb_stream_client.py /dev/ttyACM0 export -o log.bin
+    ./scripts/usb_stream_client.py /dev/ttyACM0 export --first 1000 --count 500 --csv > log.csv
+    ./scripts/usb_stream_client.py /dev/ttyACM0 live
+    ./scripts/usb_stream_client.py /dev/ttyACM0 period --min 30 --max 600
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+from decode_log_stream import RECORD_SIZE, crc8, format_record
+
+FRAME_HEADER_SIZE = 4
+RESPONSE_ACK_OK = 0x00
+RESPONSE_NACK_CRC_ERROR = 0xFE
+CMD_EXPORT_LOG = 0xC5
+CMD_SET_WAKE_UP_PERIOD = 0xC7
+CMD_SET_WAKE_UP_PERIOD_BOUNDS = 0xC8
+CMD_SET_LIVE = 0xE0
+LIVE_FRAME = 0xE1
+
+EXPORT_RANGE = struct.Struct("<II")
+WAKE_UP_PERIOD = struct.Struct("<H")
+WAKE_UP_PERIOD_BOUNDS = struct.Struct("<HH")
+CSV_HEADER = "# timestamp,rawTemperature,rawHumidity,rawLux,accelX,accelY,accelZ,vibrationRms,vibrationMagnitude,suppressedCount"
+
+
+class StreamError(Exception):
+    pass
+
+
+class UsbStream:
+    def __init__(self, port, timeout):
+        try:
+            import serial
+        except ImportError:
+            raise StreamError("pyserial is required: pip install pyserial")
+
+        # DTR opens the stream on the device, it's cleared on close
+        self.serial = serial.Serial(port, timeout=timeout)
+        self.serial.dtr = True
+        self.sequence = 0
+
+    def close(self):
+        self.serial.close()
+
+    def send(self, command, payload=b""):
+        self.sequence = (self.sequence + 1) & 0xFF
+        body = bytes([command, self.sequence, len(payload)]) + payload
+        self.serial.write(bytes([crc8(body)]) + body)
+        return self.sequence
+
+    def read_exact(self, size):
+        data = self.serial.read(size)
+        if len(data) != size:
+            raise StreamError(f"timeout, {len(data)} of {size} bytes received")
+        return data
+
+    def read_frame(self):
+        """Returns (code, sequence, payload) of the next frame"""
+        header = self.read_exact(FRAME_HEADER_SIZE)
+        crc, code, sequence, size = header
+        payload = self.read_exact(size)
+        if crc != crc8(header[1:] + payload):
+            raise StreamError("frame CRC mismatch")
+        return code, sequence, payload
+
+    def read_response(self, sequence):
+        """Skips the live frames in flight before the response"""
+        while True:
+            code, response_sequence, payload = self.read_frame()
+            if code == LIVE_FRAME:
+                continue
+            if response_sequence != sequence:
+                raise StreamError(f"response to SEQ {response_sequence}, expected {sequence}")
+            if code != RESPONSE_ACK_OK:
+                raise StreamError("CRC error" if code == RESPONSE_NACK_CRC_ERROR else f"NACK 0x{code:02x}")
+            return payload
+
+    def set_live(self, is_on):
+        self.read_response(self.send(CMD_SET_LIVE, bytes([1 if is_on else 0])))
+
+    def set_wake_up_period(self, min_seconds, max_seconds):
+        """Equal bounds pin the period, the device adapts it between the bounds otherwise"""
+        if min_seconds == max_seconds:
+            self.read_response(self.send(CMD_SET_WAKE_UP_PERIOD, WAKE_UP_PERIOD.pack(min_seconds)))
+        else:
+            self.read_response(self.send(CMD_SET_WAKE_UP_PERIOD_BOUNDS, WAKE_UP_PERIOD_BOUNDS.pack(min_seconds, max_seconds)))
+
+    def export(self, first_entry, entries_count, output):
+        """Writes the exported entries to the output, returns the acknowledged range"""
+        self.set_live(False)
+        self.serial.reset_input_buffer()
+
+        sequence = self.send(CMD_EXPORT_LOG, EXPORT_RANGE.pack(first_entry, entries_count))
+        first_entry, entries_count = EXPORT_RANGE.unpack(self.read_response(sequence))
+
+        remaining = entries_count * RECORD_SIZE
+        while remaining:
+            data = self.serial.read(min(remaining, 64 * 1024))
+            if not data:
+                raise StreamError(f"timeout, {remaining} bytes of the export missing")
+            output(data)
+            remaining -= len(data)
+
+        return first_entry, entries_count
+
+
+def export(stream, args):
+    csv = bytearray()
+    output = open(args.output, "wb") if args.output else None
+
+    def write(data):
+        if output:
+            output.write(data)
+        if args.csv:
+            csv.extend(data)
+            while len(csv) >= RECORD_SIZE:
+                print(format_record(bytes(csv[:RECORD_SIZE])))
+                del csv[:RECORD_SIZE]
+
+    if args.csv:
+        print(CSV_HEADER)
+
+    started = time.monotonic()
+    try:
+        first_entry, entries_count = stream.export(args.first, args.count, write)
+    finally:
+        if output:
+            output.close()
+    elapsed = time.monotonic() - started
+
+    size = entries_count * RECORD_SIZE
+    print(f"entries {first_entry}..{first_entry + entries_count - 1}: {size} bytes in {elapsed:.2f} s, "
+          f"{size / elapsed / 1024:.0f} KiB/s", file=sys.stderr)
+
+
+def live(stream, args):
+    stream.set_live(True)
+    print(CSV_HEADER)
+
+    expected = None
+    try:
+        while True:
+            try:
+                code, sequence, payload = stream.read_frame()
+            except StreamError:
+                continue  # no frame within the timeout, the device sleeps between the measurements
+            if code != LIVE_FRAME or len(payload) != RECORD_SIZE:
+                continue
+            if expected is not None and sequence != expected:
+                print(f"# {(sequence - expected) & 0xFF} frames dropped", file=sys.stderr)
+            expected = (sequence + 1) & 0xFF
+            print(format_record(payload), flush=True)
+    except KeyboardInterrupt:
+        stream.set_live(False)
+
+
+def period(stream, args):
+    maximum = args.max if args.max is not None else args.min
+    if not 0 < args.min <= maximum <= 0xFFFF:
+        raise StreamError(f"invalid period bounds {args.min}..{maximum} s")
+
+    stream.set_wake_up_period(args.min, maximum)
+    print(f"wake up period {args.min}..{maximum} s", file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="CDC-ACM serial port of the logger, e.g. /dev/ttyACM0 or COM5")
+    parser.add_argument("--timeout", type=float, default=2.0, help="read timeout in seconds")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    export_parser = commands.add_parser("export", help="export the log entries range")
+    export_parser.add_argument("--first", type=int, default=0, help="first entry index")
+    export_parser.add_argument("--count", type=int, default=0, help="entries count, 0 - up to the log tail")
+    export_parser.add_argument("-o", "--output", metavar="FILE", help="write the raw 22 bytes entries to the file")
+    export_parser.add_argument("--csv", action="store_true", help="print the entries as CSV")
+
+    commands.add_parser("live", help="print the live measurements frames until Ctrl+C")
+
+    period_parser = commands.add_parser("period", help="set the RTC wake up period bounds, pinned without --max")
+    period_parser.add_argument("--min", type=int, required=True, help="min period in seconds")
+    period_parser.add_argument("--max", type=int, help="max period in seconds of the adaptive period")
+    args = parser.parse_args()
+
+    try:
+        stream = UsbStream(args.port, args.timeout)
+        try:
+            {"export": export, "live": live, "period": period}[args.command](stream, args)
+        finally:
+            stream.close()
+    except StreamError as error:
+        print(f"{args.port}: {error}", file=sys.stderr)
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())